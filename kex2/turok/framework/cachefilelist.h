@@ -23,41 +23,52 @@
 #ifndef __CACHEFILELIST_H__
 #define __CACHEFILELIST_H__
 
+//
+// kexHashList - named objects allocated from a heap block. the objects
+// themselves never move, only the name -> object table is rehashed.
+// the table is kept in the same heap block as the objects
+//
+
 template<class type>
 class kexHashList {
 public:
     type                *Add(const char *tname, kexHeapBlock &hb = hb_static);
     type                *Find(const char *tname) const;
-    type                *GetData(const int index);
+    type                *First(void);
     type                *Next(void);
-    char                *GetName(const int index);
+    const char          *GetName(void) const;
+    void                Reserve(const unsigned int size) { hashMap.Reserve(size); }
+    void                Clear(void) { hashMap.Clear(); }    // the objects are left to their heap block
 
-    typedef struct hashKey_s {
-        type            data;
-        filepath_t      name;
-        hashKey_s       *next;
-    } hashKey_t;
+    const unsigned int  Length(void) const { return hashMap.Length(); }
 
-    hashKey_t           *hashlist[MAX_HASH];
-    hashKey_t           *rover;
+private:
+    kexHashMap<kexName, type*> hashMap;
+    int                 rover;
 };
 
 //
 // kexHashList::Add
 //
+//
+// Names are unique. Adding one that's already in the list hands back
+// the object that's there, since replacing it would lose the old one
+// from First/Next and anything still pointing at it
+//
 template<class type>
 type *kexHashList<type>::Add(const char *tname, kexHeapBlock &hb) {
-    unsigned int hash;
+    type *data;
 
-    hashKey_t *o = (hashKey_t*)Mem_Calloc(sizeof(hashKey_t), hb);
-    strncpy(o->name, tname, MAX_FILEPATH);
+    if((data = Find(tname))) {
+        common.Warning("kexHashList::Add: %s was already added\n", tname);
+        return data;
+    }
 
-    // add to hash for future reference
-    hash = kexStr::Hash(o->name);
-    o->next = hashlist[hash];
-    hashlist[hash] = o;
+    data = (type*)Mem_Calloc(sizeof(type), hb);
 
-    return &o->data;
+    hashMap.SetHeapBlock(hb);
+    hashMap.Add(kexName(tname), data);
+    return data;
 }
 
 //
@@ -65,27 +76,31 @@ type *kexHashList<type>::Add(const char *tname, kexHeapBlock &hb) {
 //
 template<class type>
 type *kexHashList<type>::Find(const char *tname) const {
-    hashKey_t *t;
-    unsigned int hash;
+    kexName name;
+    type **data;
 
-    hash = kexStr::Hash(tname);
+    // a string that was never interned can't be in the list
+    if((name = kexName::Find(tname)).IsEmpty()) {
+        return NULL;
+    }
 
-    for(t = hashlist[hash]; t; t = t->next) {
-        if(!strcmp(tname, t->name)) {
-            return &t->data;
-        }
+    if(!(data = hashMap.Find(name))) {
+        return NULL;
     }
 
-    return NULL;
+    return *data;
 }
 
 //
-// kexHashList::GetData
+// kexHashList::First
 //
 template<class type>
-type *kexHashList<type>::GetData(const int index) {
-    rover = hashlist[index];
-    return &rover->data;
+type *kexHashList<type>::First(void) {
+    if((rover = hashMap.First()) == -1) {
+        return NULL;
+    }
+
+    return hashMap.ValueAt(rover);
 }
 
 //
@@ -93,20 +108,19 @@ type *kexHashList<type>::GetData(const int index) {
 //
 template<class type>
 type *kexHashList<type>::Next(void) {
-    if(rover->next) {
-        rover = rover->next;
-        return &rover->data;
+    if(rover == -1 || (rover = hashMap.Next(rover)) == -1) {
+        return NULL;
     }
 
-    return NULL;
+    return hashMap.ValueAt(rover);
 }
 
 //
 // kexHashList::GetName
 //
 template<class type>
-char *kexHashList<type>::GetName(const int index) {
-    return rover->name;
+const char *kexHashList<type>::GetName(void) const {
+    return hashMap.KeyAt(rover).c_str();
 }
 
 #endif
@@ -31,6 +31,7 @@
 #include "system.h"
 #include "console.h"
 #include "gameManager.h"
+#include "world.h"
 #include "server.h"
 #include "gui.h"
 
@@ -42,10 +43,277 @@ kexCvar cvarMSensitivityY("cl_msensitivityy", CVF_FLOAT|CVF_CONFIG, "5", "Mouse-
 kexCvar cvarMAcceleration("cl_macceleration", CVF_FLOAT|CVF_CONFIG, "0", "Mouse acceleration");
 kexCvar cvarInvertLook("cl_mlookinvert", CVF_BOOL|CVF_CONFIG, "0", "Invert mouse-look");
 kexCvar cvarClientPort("cl_port", CVF_INT|CVF_CONFIG, "58304", "Client's forwarding port");
-kexCvar cvarClientFPS("cl_maxfps", CVF_INT|CVF_CONFIG, "60", 1, 60, "Game render FPS");
+kexCvar cvarClientFPS("cl_maxfps", CVF_INT|CVF_CONFIG, "60", 1, 300, "Game render FPS");
+kexCvar cvarClientTickRate("cl_tickrate", CVF_INT|CVF_CONFIG, "60", 10, 240, "Game simulation ticks per second");
 
 kexClient client;
 
+//
+// FramePacing_Run
+//
+// Runs the frame clock as a loop polling at rate fps would see it,
+// capped at maxFPS, and pushes a physics body through every tick
+// it hands out with the same scripted force. The body's state after
+// each tick goes into origins and velocities, for as many ticks as
+// they have room for. Returns the number of frames drawn
+//
+
+static int FramePacing_Run(const int rate, const int maxFPS, const int seconds,
+                           const kexVec3 &start, kexArray<kexVec3> &origins,
+                           kexArray<kexVec3> &velocities, int &ticks, int &gameTime) {
+    kexFrameClock clock;
+    kexActor *body;
+    kexPhysics *p;
+    float stepTime = 1000.0f / (float)cvarClientTickRate.GetInt();
+    int stepMsec;
+    int frames = 0;
+    int prev = 0;
+
+    body = localWorld.ConstructActor("kexActor");
+    body->bStatic = false;
+    body->SetOrigin(start);
+    body->Spawn();
+
+    p = body->Physics();
+    p->bEnabled = true;
+    p->friction = 0.1f;
+    p->airFriction = 0;
+
+    ticks = 0;
+    gameTime = 0;
+
+    clock.Reset();
+
+    // whole ms frame times, rounded from the ideal frame start
+    for(int f = 1; f <= seconds * rate; f++) {
+        int now = (int)((double)f * 1000.0 / (double)rate + 0.5);
+        int msec = now - prev;
+
+        // a held back frame's time is kept by the clock itself
+        prev = now;
+
+        if(!clock.Frame(msec, maxFPS)) {
+            continue;
+        }
+
+        frames++;
+
+        while(clock.Step(stepTime, stepMsec)) {
+            // steer in a slow figure eight, hopping now and then
+            if((ticks % 180) < 120) {
+                p->SetForce(kexVec3(kexMath::Sin((float)ticks * 0.05f) * 8, 0,
+                                    kexMath::Cos((float)ticks * 0.03f) * 8));
+            }
+            else {
+                p->SetForce(kexVec3(0, 0, 0));
+            }
+
+            if((ticks % 90) == 45) {
+                p->velocity.y += 90;
+            }
+
+            p->Think(stepTime / 1000.0f);
+
+            if(ticks < (int)origins.Length()) {
+                origins[ticks] = body->GetOrigin();
+                velocities[ticks] = p->velocity;
+            }
+
+            gameTime += stepMsec;
+            ticks++;
+        }
+    }
+
+    // never added to the world, so freed the way kexObject allocated it
+    body->UnlinkArea();
+    body->~kexActor();
+    kexObject::operator delete(body);
+
+    return frames;
+}
+
+//
+// testframepacing
+//
+// Feeds the frame clock the frame times a 30, 60 and 144 fps loop
+// would see over the same stretch of time, plus a 300 fps loop capped
+// at 144 so that frames get held back. A physics body on the loaded
+// map is pushed through the ticks with the same input each time, and
+// has to end up in bit-identical states after every tick at every rate
+//
+
+COMMAND(testframepacing) {
+    const int rates[4] = { 30, 60, 144, 300 };
+    const int caps[4] = { 30, 60, 144, 144 };
+    kexArray<kexVec3> refOrigins;
+    kexArray<kexVec3> refVelocities;
+    kexArray<kexVec3> origins;
+    kexArray<kexVec3> velocities;
+    kexPlayerPuppet *puppet;
+    kexVec3 start;
+    kexVec3 end;
+    int seconds = 10;
+    int expected;
+    int frames;
+    int ticks;
+    int time;
+    int refTicks = 0;
+    int refTime = 0;
+    bool bOk = true;
+
+    if(!localWorld.IsLoaded() || localWorld.CollisionMap().numSectors <= 0) {
+        common.Warning("testframepacing: no map loaded\n");
+        return;
+    }
+
+    if(command.GetArgc() >= 2) {
+        seconds = atoi(command.GetArgv(1));
+    }
+
+    if(seconds <= 0) {
+        seconds = 10;
+    }
+
+    expected = seconds * cvarClientTickRate.GetInt();
+
+    refOrigins.Resize(expected);
+    refVelocities.Resize(expected);
+    origins.Resize(expected);
+    velocities.Resize(expected);
+
+    // start where the player is, or failing that on the first sector
+    if((puppet = gameManager.localPlayer.Puppet())) {
+        start = puppet->GetOrigin();
+    }
+    else {
+        kexTri *tri = &localWorld.CollisionMap().sectors[0].lowerTri;
+
+        start = (*tri->point[0] + *tri->point[1] + *tri->point[2]) / 3;
+        start.y += 32;
+    }
+
+    for(int r = 0; r < 4; r++) {
+        if(r == 0) {
+            frames = FramePacing_Run(rates[r], caps[r], seconds, start,
+                refOrigins, refVelocities, refTicks, refTime);
+
+            ticks = refTicks;
+            time = refTime;
+            end = refOrigins[MIN(ticks, expected) - 1];
+        }
+        else {
+            frames = FramePacing_Run(rates[r], caps[r], seconds, start,
+                origins, velocities, ticks, time);
+
+            for(int t = 0; t < ticks && t < refTicks && t < expected; t++) {
+                if( memcmp(&origins[t], &refOrigins[t], sizeof(kexVec3)) ||
+                    memcmp(&velocities[t], &refVelocities[t], sizeof(kexVec3))) {
+                    common.Warning("testframepacing: %i fps diverged on tick %i\n",
+                        rates[r], t);
+                    bOk = false;
+                    break;
+                }
+            }
+
+            if(ticks != refTicks || time != refTime) {
+                bOk = false;
+            }
+
+            end = origins[MIN(ticks, expected) - 1];
+        }
+
+        common.Printf("%3i fps (max %i): %i frames, %i ticks, %i ms game time, ended at %f %f %f\n",
+            rates[r], caps[r], frames, ticks, time, end.x, end.y, end.z);
+
+        // the last tick may still be sitting in the accumulator
+        if(ticks < expected - 1 || ticks > expected) {
+            bOk = false;
+        }
+
+        // every frame is drawn unless the loop outruns the cap, in
+        // which case some have to have been held back
+        if(rates[r] <= caps[r]) {
+            if(frames != seconds * rates[r]) {
+                bOk = false;
+            }
+        }
+        else if(frames >= seconds * rates[r]) {
+            bOk = false;
+        }
+    }
+
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testframepacing %s\n",
+        bOk ? "passed" : "failed");
+}
+
+//
+// kexFrameClock::Reset
+//
+
+void kexFrameClock::Reset(void) {
+    curtime = 0;
+    fps = 0;
+    steps = 0;
+    accumTime = 0;
+    stepRemainder = 0;
+}
+
+//
+// kexFrameClock::Frame
+//
+// Returns true once enough time has passed for a new frame
+//
+
+bool kexFrameClock::Frame(const int msec, const int maxFPS) {
+    curtime += msec;
+
+    if(curtime < (1000 / maxFPS)) {
+        return false;
+    }
+
+    fps = 1000 / curtime;
+    accumTime += (float)curtime;
+    curtime = 0;
+    steps = 0;
+    return true;
+}
+
+//
+// kexFrameClock::Step
+//
+// Returns true while another fixed tick is due this frame. msec is
+// how far the game time moves for it, carrying the fraction of a ms
+// over to the next tick
+//
+
+bool kexFrameClock::Step(const float stepTime, int &msec) {
+    if(accumTime < stepTime) {
+        return false;
+    }
+
+    if(steps >= CL_MAX_STEPS) {
+        // too far behind to catch up (map load, debugger, etc)
+        accumTime = 0;
+        return false;
+    }
+
+    stepRemainder += stepTime;
+    msec = (int)stepRemainder;
+    stepRemainder -= (float)msec;
+
+    accumTime -= stepTime;
+    steps++;
+    return true;
+}
+
+//
+// kexFrameClock::TimeToNextFrame
+//
+
+int kexFrameClock::TimeToNextFrame(const int maxFPS) const {
+    return (1000 / maxFPS) - curtime;
+}
+
 //
 // kexClient::Destroy
 //
@@ -138,17 +406,13 @@ void kexClient::OnDisconnect(void) {
 //
 
 void kexClient::Run(const int msec) {
+    float stepTime;
+    int stepMsec;
 
-    curtime += msec;
-
-    if(curtime < (1000 / cvarClientFPS.GetInt()))
+    if(!clock.Frame(msec, cvarClientFPS.GetInt()))
         return;
 
-    SetRunTime((float)curtime / 1000.0f);
-    SetTime(GetTime() + curtime);
-
-    fps = (int)(1000.0f / (GetRunTime() * 1000.0f));
-    curtime = 0;
+    fps = clock.FPS();
 
     // check for new packets
     CheckMessages();
@@ -159,10 +423,30 @@ void kexClient::Run(const int msec) {
     // handle input events
     ProcessEvents();
 
-    // run client-side ticks
-    gameManager.OnLocalTick();
+    // run client-side ticks in fixed steps so the simulation plays
+    // out the same way regardless of the frame rate
+    stepTime = 1000.0f / (float)cvarClientTickRate.GetInt();
+    SetRunTime(stepTime / 1000.0f);
+
+    while(clock.Step(stepTime, stepMsec)) {
+        SetTime(GetTime() + stepMsec);
+
+        gameManager.OnLocalTick();
+        UpdateTicks();
+    }
+
+    // draw the leftover time as a blend between the last two steps
+    gameManager.OnDrawFrame(clock.Blend(stepTime));
+}
+
+//
+// kexClient::TimeToNextFrame
+//
+// Milliseconds until Run will start another frame
+//
 
-    UpdateTicks();
+int kexClient::TimeToNextFrame(void) {
+    return clock.TimeToNextFrame(cvarClientFPS.GetInt());
 }
 
 //
@@ -373,9 +657,9 @@ void kexClient::Init(void) {
     Destroy();
     CreateHost();
 
-    curtime = 0;
     fps = 0;
     id = -1;
+    clock.Reset();
     bLocal = (sysMain.CheckParam("-client") == 0);
     
     SetTime(0);
@@ -35,6 +35,11 @@ extern kexCvar cvarMSensitivityX;
 extern kexCvar cvarMSensitivityY;
 extern kexCvar cvarMAcceleration;
 extern kexCvar cvarClientFPS;
+extern kexCvar cvarClientTickRate;
+
+// most fixed steps a single frame is allowed to run before the
+// remaining time is dropped
+#define CL_MAX_STEPS    8
 
 typedef enum
 {
@@ -47,6 +52,29 @@ typedef enum
     CL_STATE_CHANGINGLEVEL
 } client_state_e;
 
+//
+// kexFrameClock - decides when a frame is due and splits the time
+// between frames into fixed ticks. kept apart from the client so the
+// pacing can be run without a game
+//
+class kexFrameClock {
+public:
+    void                Reset(void);
+    bool                Frame(const int msec, const int maxFPS);
+    bool                Step(const float stepTime, int &msec);
+    int                 TimeToNextFrame(const int maxFPS) const;
+
+    float               Blend(const float stepTime) const { return accumTime / stepTime; }
+    const int           FPS(void) const { return fps; }
+
+private:
+    int                 curtime;        // ms since the last frame
+    int                 fps;
+    int                 steps;          // ticks run since the last frame
+    float               accumTime;      // frame time not yet simulated, in ms
+    float               stepRemainder;  // fraction of a ms left over from the game time
+};
+
 //
 // CLIENT PACKET TYPES
 //
@@ -75,19 +103,20 @@ public:
     void                PostEvent(event_t *ev);
     event_t             *GetEvent(void);
     void                ProcessEvents(void);
+    int                 TimeToNextFrame(void);
 
     void                SetPeer(ENetPeer *_peer) { peer = _peer; }
     ENetPeer            *GetPeer(void) { return peer; }
     bool                IsLocal(void) { return bLocal; }
 
     unsigned int        id;
-    int                 curtime;
     int                 fps;
 
     static void         InitObject(void);
 
 private:
     bool                bLocal;
+    kexFrameClock       clock;
     ENetPeer            *peer;
     event_t             events[MAXEVENTS];
     int                 eventhead;
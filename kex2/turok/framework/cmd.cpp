@@ -47,8 +47,10 @@ kexCommandItem::kexCommandItem(const char *commandName, cmd_t commandFunc) {
 
 void kexCommandItem::Setup(const char *commandName, cmd_t commandFunc) {
     this->name          = commandName;
+    this->key           = kexCommand::KeyName(commandName, true);
     this->function      = commandFunc;
     this->next          = NULL;
+    this->hashNext      = NULL;
     this->bAllocated    = false;
 
     command.RegisterCommand(this);
@@ -78,6 +80,8 @@ kexCommand::~kexCommand(void) {
 //
 
 void kexCommand::RegisterCommand(kexCommandItem *commandItem) {
+    int hash;
+
     if(first == NULL) {
         first = commandItem;
     }
@@ -87,6 +91,50 @@ void kexCommand::RegisterCommand(kexCommandItem *commandItem) {
     }
 
     next = commandItem;
+
+    hash = commandItem->key.Hash() & (CMD_HASH_SIZE-1);
+    commandItem->hashNext = hashList[hash];
+    hashList[hash] = commandItem;
+}
+
+//
+// kexCommand::KeyName
+//
+// Commands are matched regardless of case, so they're
+// keyed by the lowercase version of their name
+//
+
+kexName kexCommand::KeyName(const char *name, bool bCreate) {
+    char lower[CMD_BUFFER_LEN];
+    int i;
+
+    for(i = 0; name[i] && i < CMD_BUFFER_LEN-1; i++) {
+        lower[i] = tolower(name[i]);
+    }
+
+    lower[i] = 0;
+
+    return bCreate ? kexName(lower) : kexName::Find(lower);
+}
+
+//
+// kexCommand::Find
+//
+
+kexCommandItem *kexCommand::Find(const char *name) {
+    kexName key = KeyName(name, false);
+
+    if(key.IsEmpty()) {
+        return NULL;
+    }
+
+    for(kexCommandItem *cmd = hashList[key.Hash() & (CMD_HASH_SIZE-1)]; cmd; cmd = cmd->hashNext) {
+        if(cmd->key == key) {
+            return cmd;
+        }
+    }
+
+    return NULL;
 }
 
 //
@@ -100,16 +148,15 @@ bool kexCommand::Run(void) {
         return false;
     }
 
-    for(cmd = first; cmd; cmd = cmd->GetNext()) {
-        if(!kexStr::Compare(cmd_argv[0], cmd->GetName())) {
-            if(cmd->function) {
-                cmd->function();
-            }
-            return true;
-        }
+    if(!(cmd = Find(cmd_argv[0]))) {
+        return false;
+    }
+
+    if(cmd->function) {
+        cmd->function();
     }
 
-    return false;
+    return true;
 }
 
 //
@@ -296,8 +343,6 @@ bool kexCommand::AutoComplete(const char *partial) {
 //
 
 bool kexCommand::Verify(const char *name) {
-    kexCommandItem *cmd;
-
     // fail if the command is a variable name
     if(cvarManager.Get(name)) {
         common.Warning("Cmd_AddCommand: %s already defined as a var\n", name);
@@ -305,11 +350,9 @@ bool kexCommand::Verify(const char *name) {
     }
     
     // fail if the command already exists
-    for(cmd = first; cmd; cmd = cmd->GetNext()) {
-        if(!strcmp(name, cmd->GetName())) {
-            common.Warning("Cmd_AddCommand: %s already defined\n", name);
-            return false;
-        }
+    if(Find(name)) {
+        common.Warning("Cmd_AddCommand: %s already defined\n", name);
+        return false;
     }
 
     return true;
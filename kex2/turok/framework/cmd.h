@@ -47,7 +47,9 @@ private:
     void                Setup(const char *commandName, cmd_t commandFunc);
 
     const char          *name;
+    kexName             key;
     kexCommandItem      *next;
+    kexCommandItem      *hashNext;
     cmd_t               function;
     bool                bAllocated;
 };
@@ -70,14 +72,20 @@ private:
     const static int    CMD_MAX_ARGV    = 32;
     const static int    CMD_BUFFER_LEN  = 256;
 
+    const static int    CMD_HASH_SIZE   = 256;
+
     void                ClearArgv(void);
     bool                Run(void);
+    kexCommandItem      *Find(const char *name);
+
+    static kexName      KeyName(const char *name, bool bCreate);
 
     int                 cmd_argc;
     char                cmd_argv[CMD_MAX_ARGV][CMD_BUFFER_LEN];
 
     kexCommandItem      *first;
     kexCommandItem      *next;
+    kexCommandItem      *hashList[CMD_HASH_SIZE];
 };
 
 extern kexCommand command;
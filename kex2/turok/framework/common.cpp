@@ -42,19 +42,30 @@ void kexCommon::Printf(const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_GENERAL, LS_INFO, COLOR_WHITE, 0, string, va);
     va_end(va);
+}
+
+//
+// kexCommon::Printf
+//
 
-    console.Print(COLOR_WHITE, buffer);
-    sysMain.Log(buffer);
+void kexCommon::Printf(const logChannel_t channel, const char *string, ...) {
+    va_list	va;
+    
+    va_start(va, string);
+    logger.VPrintf(channel, LS_INFO, COLOR_WHITE, 0, string, va);
+    va_end(va);
 }
 
 //
 // kexCommon::Printf
 //
+// Only scripts print kexStrs
+//
 
 void kexCommon::Printf(const kexStr &str) {
-    Printf(kva("%s\n", str.c_str()));
+    logger.Printf(LC_SCRIPT, LS_INFO, COLOR_WHITE, "%s\n", str.c_str());
 }
 
 //
@@ -65,11 +76,20 @@ void kexCommon::CPrintf(rcolor color, const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_GENERAL, LS_INFO, color, 0, string, va);
     va_end(va);
+}
+
+//
+// kexCommon::CPrintf
+//
 
-    console.Print(color, buffer);
-    sysMain.Log(buffer);
+void kexCommon::CPrintf(const logChannel_t channel, rcolor color, const char *string, ...) {
+    va_list	va;
+    
+    va_start(va, string);
+    logger.VPrintf(channel, LS_INFO, color, 0, string, va);
+    va_end(va);
 }
 
 //
@@ -80,19 +100,30 @@ void kexCommon::Warning(const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_GENERAL, LS_WARNING, COLOR_YELLOW, 0, string, va);
     va_end(va);
+}
 
-    console.Print(COLOR_YELLOW, buffer);
-    sysMain.Log(buffer);
+//
+// kexCommon::Warning
+//
+
+void kexCommon::Warning(const logChannel_t channel, const char *string, ...) {
+    va_list	va;
+    
+    va_start(va, string);
+    logger.VPrintf(channel, LS_WARNING, COLOR_YELLOW, 0, string, va);
+    va_end(va);
 }
 
 //
 // kexCommon::Warning
 //
+// Only scripts warn with kexStrs
+//
 
 void kexCommon::Warning(const kexStr &str) {
-    Warning(str.c_str());
+    logger.Post(LC_SCRIPT, LS_WARNING, COLOR_YELLOW, 0, str.c_str());
 }
 
 //
@@ -101,14 +132,25 @@ void kexCommon::Warning(const kexStr &str) {
 
 void kexCommon::DPrintf(const char *string, ...) {
     if(cvarDeveloper.GetBool()) {
-        static char buffer[1024];
         va_list	va;
         
         va_start(va, string);
-        vsprintf(buffer, string, va);
+        logger.VPrintf(LC_GENERAL, LS_DEBUG, RGBA(0xE0, 0xE0, 0xE0, 0xff), 0, string, va);
         va_end(va);
+    }
+}
+
+//
+// kexCommon::DPrintf
+//
 
-        CPrintf(RGBA(0xE0, 0xE0, 0xE0, 0xff), buffer);
+void kexCommon::DPrintf(const logChannel_t channel, const char *string, ...) {
+    if(cvarDeveloper.GetBool()) {
+        va_list	va;
+        
+        va_start(va, string);
+        logger.VPrintf(channel, LS_DEBUG, RGBA(0xE0, 0xE0, 0xE0, 0xff), 0, string, va);
+        va_end(va);
     }
 }
 
@@ -117,16 +159,18 @@ void kexCommon::DPrintf(const char *string, ...) {
 //
 
 void kexCommon::Error(const char* string, ...) {
+    char buffer[LOG_MAX_LENGTH];
     va_list	va;
 
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    SDL_vsnprintf(buffer, LOG_MAX_LENGTH, string, va);
     va_end(va);
     
     fprintf(stderr, "Error - %s\n", buffer);
     fflush(stderr);
 
-    sysMain.Log(buffer);
+    logger.Post(LC_GENERAL, LS_ERROR, COLOR_RED, LRF_NOCONSOLE, buffer);
+    logger.Shutdown();
 
 #ifdef _WIN32
     Sys_Error(buffer);
@@ -120,9 +120,11 @@ typedef union {
 
 #include "mathlib.h"
 #include "system.h"
+#include "name.h"
+#include "logger.h"
 #include "object.h"
 #include "memHeap.h"
-#include "resourceManager.h"
+#include "hashMap.h"
 
 #define RGBA(r,g,b,a) ((rcolor)((((a)&0xff)<<24)|(((b)&0xff)<<16)|(((g)&0xff)<<8)|((r)&0xff)))
 
@@ -146,11 +148,15 @@ kbool fcmp(float f1, float f2);
 class kexCommon {
 public:
     void            Printf(const char *string, ...);
+    void            Printf(const logChannel_t channel, const char *string, ...);
     void            Printf(const kexStr &str);
     void            CPrintf(rcolor color, const char *string, ...);
+    void            CPrintf(const logChannel_t channel, rcolor color, const char *string, ...);
     void            Warning(const char *string, ...);
+    void            Warning(const logChannel_t channel, const char *string, ...);
     void            Warning(const kexStr &str);
     void            DPrintf(const char *string, ...);
+    void            DPrintf(const logChannel_t channel, const char *string, ...);
     void            Error(const char *string, ...);
     void            Shutdown(void);
     void            WriteConfigFile(void);
@@ -162,13 +168,11 @@ public:
     bool            GetCvarBool(const kexStr &name);
 
     static void     InitObject(void);
-
-private:
-    char            buffer[4096];
 };
 
 extern kexCommon common;
 
+#include "resourceManager.h"
 #include "cmd.h"
 #include "cvar.h"
 
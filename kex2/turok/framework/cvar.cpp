@@ -131,10 +131,22 @@ void kexCvar::Set(int value) {
 //
 
 kexCvar *kexCvarManager::Get(const char *name) {
+    return Get(kexName::Find(name));
+}
+
+//
+// kexCvarManager::Get
+//
+
+kexCvar *kexCvarManager::Get(const kexName &name) {
     kexCvar *var;
+
+    if(name.IsEmpty()) {
+        return NULL;
+    }
     
-    for(var = first; var; var = var->GetNext()) {
-        if(!strcmp(name, var->GetName()))
+    for(var = hashList[name.Hash() & (CVAR_HASH_SIZE-1)]; var; var = var->hashNext) {
+        if(var->key == name)
             return var;
     }
     
@@ -213,6 +225,8 @@ void kexCvarManager::AutoComplete(const char *partial) {
 //
 
 void kexCvarManager::Register(kexCvar *variable) {
+    int hash;
+
     if(first == NULL) {
         first = variable;
     }
@@ -222,6 +236,10 @@ void kexCvarManager::Register(kexCvar *variable) {
     }
 
     next = variable;
+
+    hash = variable->key.Hash() & (CVAR_HASH_SIZE-1);
+    variable->hashNext = hashList[hash];
+    hashList[hash] = variable;
 }
 
 //
@@ -254,20 +272,18 @@ void kexCvarManager::InitCustomCvars(void) {
         kexStr value;
         int flags;
 
-        for(int i = 0; i < MAX_HASH; i++) {
+        for(key = def->entries.First(); key; key = def->entries.Next()) {
             desc = "";
             value = "";
             flags = 0;
 
-            for(key = def->entries.GetData(i); key; key = def->entries.Next()) {
-                key->GetString("defaultValue", value);
-                key->GetString("description", desc);
-                key->GetInt("flags", flags);
+            key->GetString("defaultValue", value);
+            key->GetString("description", desc);
+            key->GetInt("flags", flags);
 
-                name = def->entries.GetName(i);
+            name = def->entries.GetName();
 
-                common.AddCvar(name, value, desc, flags);
-            }
+            common.AddCvar(name, value, desc, flags);
         }
     }*/
 }
@@ -329,6 +345,7 @@ void kexCvarManager::Shutdown(void) {
 void kexCvar::Setup(const char *name, const char *value,
                     const char *description, int flags, float min, float max) {
     this->name          = name;
+    this->key           = kexName(name);
     this->value         = (char*)value;
     this->flags         = flags;
     this->description   = description;
@@ -337,6 +354,7 @@ void kexCvar::Setup(const char *name, const char *value,
     this->max           = max;
     this->bModified     = false;
     this->next          = NULL;
+    this->hashNext      = NULL;
 
     cvarManager.Register(this);
 }
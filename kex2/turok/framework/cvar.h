@@ -56,6 +56,7 @@ public:
     float           GetFloat(void) const { return (float)atof(value); }
     void            SetNext(kexCvar *cvar) { next = cvar; }
     kexCvar         *GetNext(void) const { return next; }
+    const kexName   &GetKey(void) const { return key; }
     bool            IsModified(void) const { return bModified; }
     void            FreeStringValue(void);
     void            SetNewStringValue(const char *string);
@@ -67,7 +68,10 @@ private:
     void            Setup(const char *name, const char *value, const char *description,
                         int flags, float min, float max);
 protected:
+    friend class    kexCvarManager;
+
     const char      *name;
+    kexName         key;
     char            *value;
     const char      *description;
     const char      *defaultValue;
@@ -76,6 +80,7 @@ protected:
     float           max;
     bool            bModified;
     kexCvar         *next;
+    kexCvar         *hashNext;
 };
 
 class kexCvarManager {
@@ -83,6 +88,7 @@ public:
     void            Init(void);
     void            Register(kexCvar *variable);
     kexCvar         *Get(const char *name);
+    kexCvar         *Get(const kexName &name);
     void            Set(const char *var_name, const char *value);
     void            Set(const char *var_name, float value);
     void            Set(const char *var_name, int value);
@@ -93,8 +99,11 @@ public:
     void            InitCustomCvars(void);
 
 private:
+    static const int CVAR_HASH_SIZE = 256;
+
     kexCvar         *first;
     kexCvar         *next;
+    kexCvar         *hashList[CVAR_HASH_SIZE];
 };
 
 extern kexCvarManager cvarManager;
@@ -142,14 +142,22 @@ kexDefinition *kexDefManager::LoadDefinition(const char *file) {
 // The name should be <path of def file>@<entry name>
 // Example: defs/damage.def@MeleeBlunt
 //
+// Resolved entries are cached by their full name so
+// repeated lookups only cost a single hash probe
+//
 
 kexKeyMap *kexDefManager::FindDefEntry(const char *name) {
     kexDefinition *def;
     kexKeyMap *defEntry;
+    kexKeyMap **ref;
     filepath_t tStr;
     int pos;
     int len;
 
+    if((ref = entryRefs.Find(name))) {
+        return *ref;
+    }
+
     pos = kexStr::IndexOf(name, "@");
 
     if(pos == -1) {
@@ -165,6 +173,7 @@ kexKeyMap *kexDefManager::FindDefEntry(const char *name) {
         tStr[len - pos] = 0;
 
         if((defEntry = def->entries.Find(tStr))) {
+            *entryRefs.Add(name) = defEntry;
             return defEntry;
         }
 
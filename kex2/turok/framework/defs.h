@@ -48,6 +48,9 @@ public:
     kexKeyMap                       *FindDefEntry(const char *name);
                                     
     kexHashList<kexDefinition>      defs;
+
+private:
+    kexHashList<kexKeyMap*>         entryRefs;
 };
 
 extern kexDefManager defManager;
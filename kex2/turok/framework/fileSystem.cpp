@@ -36,8 +36,6 @@
 #include <unistd.h>
 #endif
 
-#define FILE_MAX_HASH_SIZE  32768
-
 kexCvar cvarBasePath("kf_basepath", CVF_STRING|CVF_CONFIG, "", "Base file path to look for files");
 
 kexFileSystem fileSystem;
@@ -47,6 +45,8 @@ kexFileSystem fileSystem;
 //
 
 kexFileSystem::kexFileSystem() {
+    this->root = NULL;
+    this->packLock = NULL;
 }
 
 //
@@ -67,25 +67,15 @@ void kexFileSystem::Shutdown(void) {
 
     for(pack = root; pack; pack = pack->next) {
         unzClose(pack->filehandle);
+        pack->fileMap.Clear();
     }
 
     Mem_Purge(hb_file);
-}
-
-//
-// kexFileSystem::HashFileName
-//
-
-long kexFileSystem::HashFileName(const char *fname, int hashSize) const {
-    unsigned int hash   = 0;
-    char *str           = (char*)fname;
-    char c;
 
-    while((c = *str++)) {
-        hash = c + (hash << 6) + (hash << 16) - hash;
+    if(packLock) {
+        SDL_DestroyMutex(packLock);
+        packLock = NULL;
     }
-
-    return hash & (hashSize-1);
 }
 
 //
@@ -99,8 +89,6 @@ void kexFileSystem::LoadZipFile(const char *file) {
     char filename[MAX_FILEPATH];
     kpf_t *pack;
     unsigned int i;
-    unsigned int entries;
-    long hash;
     const char *filepath;
     kexStr fPath;
 
@@ -133,18 +121,10 @@ void kexFileSystem::LoadZipFile(const char *file) {
     // point to start of zip files
     unzGoToFirstFile(pack->filehandle);
 
-    // setup hash entires
-    for(entries = 1; entries < FILE_MAX_HASH_SIZE; entries <<= 1) {
-        if(entries > pack->numfiles) {
-            break;
-        }
-    }
-
-    // allocate file/hash list
-    pack->hashentries = entries;
+    // allocate file list and size the lookup table up front
     pack->files = (file_t*)Mem_Calloc(sizeof(file_t) * pack->numfiles, hb_file);
-    pack->hashes = (file_t***)Mem_Calloc(sizeof(file_t**) * pack->hashentries, hb_file);
-    pack->hashcount = (unsigned int*)Mem_Calloc(sizeof(int) * pack->hashentries, hb_file);
+    pack->fileMap.SetHeapBlock(hb_file);
+    pack->fileMap.Reserve(pack->numfiles);
 
     // fill in file lookup lists
     for(i = 0; i < pack->numfiles; i++) {
@@ -156,21 +136,15 @@ void kexFileSystem::LoadZipFile(const char *file) {
         }
 
         pack->files[i].cache = NULL;
+        pack->files[i].bStaged = false;
         fp = &pack->files[i];
 
         unzGetCurrentFileInfoPosition(pack->filehandle, &fp->position);
         strcpy(fp->name, filename);
         fp->info = fi;
 
-        // get hash number
-        hash = HashFileName(filename, pack->hashentries);
-
-        // resize hash table if needed
-        pack->hashes[hash] = (file_t**)Mem_Realloc(
-            pack->hashes[hash],
-            sizeof(file_t*) * (pack->hashcount[hash]+1), hb_file);
-
-        pack->hashes[hash][pack->hashcount[hash]++] = fp;
+        // key points at the name stored in the file list
+        pack->fileMap.Add(fp->name, fp);
 
         unzGoToNextFile(pack->filehandle);
     }
@@ -181,7 +155,8 @@ void kexFileSystem::LoadZipFile(const char *file) {
 //
 
 int kexFileSystem::OpenFile(const char *filename, byte **data, kexHeapBlock &hb) const {
-    long hash;
+    kpf_t *pack;
+    file_t *file;
     
     if(cvarDeveloper.GetBool()) {
         int len = OpenExternalFile(filename, data);
@@ -191,37 +166,172 @@ int kexFileSystem::OpenFile(const char *filename, byte **data, kexHeapBlock &hb)
         }
     }
     
+    if(!(file = FindFile(filename, &pack))) {
+        return 0;
+    }
+
+    if(!file->cache) {
+        file->cache = Mem_Malloc(file->info.uncompressed_size+1, hb);
+        // automatically set cache to NULL when freed so we can
+        // recache it later
+        Mem_CacheRef(&file->cache);
+
+        SDL_LockMutex(packLock);
+        unzSetCurrentFileInfoPosition(pack->filehandle, file->position);
+        unzOpenCurrentFile(pack->filehandle);
+        unzReadCurrentFile(pack->filehandle, file->cache,
+            file->info.uncompressed_size);
+        unzCloseCurrentFile(pack->filehandle);
+        SDL_UnlockMutex(packLock);
+    }
+
+    file->bStaged = false;
+
+    *data = (byte*)file->cache;
+    return file->info.uncompressed_size;
+}
+
+//
+// kexFileSystem::FindFile
+//
+
+kexFileSystem::file_t *kexFileSystem::FindFile(const char *filename, kpf_t **filePack) const {
+    file_t **fileRef;
+
     for(kpf_t *pack = root; pack; pack = pack->next) {
-        hash = HashFileName(filename, pack->hashentries);
-
-        if(pack->hashes[hash]) {
-            unsigned int i;
-
-            for(i = 0; i < pack->hashcount[hash]; i++) {
-                file_t *file = pack->hashes[hash][i];
-
-                if(!strcmp(file->name, filename)) {
-                    if(!file->cache) {
-                        file->cache = Mem_Malloc(file->info.uncompressed_size+1, hb);
-                        // automatically set cache to NULL when freed so we can
-                        // recache it later
-                        Mem_CacheRef(&file->cache);
-
-                        unzSetCurrentFileInfoPosition(pack->filehandle, file->position);
-                        unzOpenCurrentFile(pack->filehandle);
-                        unzReadCurrentFile(pack->filehandle, file->cache,
-                            file->info.uncompressed_size);
-                        unzCloseCurrentFile(pack->filehandle);
-                    }
-
-                    *data = (byte*)file->cache;
-                    return file->info.uncompressed_size;
-                }
+        if(!(fileRef = pack->fileMap.Find(filename))) {
+            continue;
+        }
+
+        if(filePack) {
+            *filePack = pack;
+        }
+
+        return *fileRef;
+    }
+
+    return NULL;
+}
+
+//
+// kexFileSystem::FileExists
+//
+// Only looks in the packs. Safe to call from any thread
+//
+
+bool kexFileSystem::FileExists(const char *filename) const {
+    return FindFile(filename, NULL) != NULL;
+}
+
+//
+// kexFileSystem::ReadFile
+//
+// Reads a file into a new buffer from hb, which the caller frees.
+// Looks for loose files the same way OpenFile does. Unlike OpenFile
+// nothing is cached, so other threads can read files while the main
+// thread uses the packs
+//
+
+int kexFileSystem::ReadFile(const char *filename, byte **data, kexHeapBlock &hb) {
+    kpf_t *pack;
+    file_t *file;
+    int size;
+    int read;
+
+    *data = NULL;
+
+    if(cvarDeveloper.GetBool()) {
+        int len = OpenExternalFile(filename, data, hb);
+
+        if(len != -1) {
+            return len;
+        }
+    }
+
+    if(!(file = FindFile(filename, &pack))) {
+        return 0;
+    }
+
+    size = file->info.uncompressed_size;
+    *data = (byte*)Mem_Malloc(size+1, hb);
+
+    SDL_LockMutex(packLock);
+    unzSetCurrentFileInfoPosition(pack->filehandle, file->position);
+
+    if(unzOpenCurrentFile(pack->filehandle) != UNZ_OK) {
+        read = -1;
+    }
+    else {
+        read = unzReadCurrentFile(pack->filehandle, *data, size);
+        unzCloseCurrentFile(pack->filehandle);
+    }
+
+    SDL_UnlockMutex(packLock);
+
+    if(read != size) {
+        Mem_Free(*data);
+        *data = NULL;
+        return 0;
+    }
+
+    (*data)[size] = 0;
+    return size;
+}
+
+//
+// kexFileSystem::StageFile
+//
+// Fills the cache of a packed file with data that was read ahead
+// of time so the next OpenFile on it doesn't touch the pack
+//
+
+bool kexFileSystem::StageFile(const char *filename, byte *data, const int size, kexHeapBlock &hb) {
+    file_t *file;
+
+    if(!(file = FindFile(filename, NULL)) || file->cache) {
+        return false;
+    }
+
+    if(size != (int)file->info.uncompressed_size) {
+        return false;
+    }
+
+    file->cache = Mem_Malloc(size+1, hb);
+    Mem_CacheRef(&file->cache);
+
+    memcpy(file->cache, data, size);
+    file->bStaged = true;
+    return true;
+}
+
+//
+// kexFileSystem::DropStagedFiles
+//
+// Frees read ahead data that nothing has opened. Returns the
+// number of files that were dropped
+//
+
+int kexFileSystem::DropStagedFiles(void) {
+    int count = 0;
+
+    for(kpf_t *pack = root; pack; pack = pack->next) {
+        for(unsigned int i = 0; i < pack->numfiles; i++) {
+            file_t *file = &pack->files[i];
+
+            if(!file->bStaged) {
+                continue;
+            }
+
+            file->bStaged = false;
+
+            if(file->cache) {
+                Mem_Free(file->cache);
+                count++;
             }
         }
     }
 
-    return 0;
+    return count;
 }
 
 //
@@ -264,27 +374,36 @@ void kexFileSystem::GetMatchingFiles(kexStrList &list, const char *search) {
 }
 
 //
-// kexFileSystem::OpenExternalFile
+// kexFileSystem::OpenExternal
 //
 
-int kexFileSystem::OpenExternalFile(const char *name, byte **buffer) const {
-    static char filepath[1024];
+FILE *kexFileSystem::OpenExternal(const char *name) const {
+    char filepath[1024];
     kexStr fPath;
-    FILE *fp;
 
     sprintf(filepath, "%s\\%s", cvarBasePath.GetValue(), name);
     
     fPath = filepath;
     fPath.NormalizeSlashes();
-    
-    if((fp = fopen(fPath.c_str(), "rb"))) {
+
+    return fopen(fPath.c_str(), "rb");
+}
+
+//
+// kexFileSystem::OpenExternalFile
+//
+
+int kexFileSystem::OpenExternalFile(const char *name, byte **buffer, kexHeapBlock &hb) const {
+    FILE *fp;
+
+    if((fp = OpenExternal(name))) {
         size_t length;
 
         fseek(fp, 0, SEEK_END);
         length = ftell(fp);
         fseek(fp, 0, SEEK_SET);
 
-        *buffer = (byte*)Mem_Calloc(length+1, hb_file);
+        *buffer = (byte*)Mem_Calloc(length+1, hb);
 
         if(fread(*buffer, 1, length, fp) == length) {
             fclose(fp);
@@ -299,6 +418,174 @@ int kexFileSystem::OpenExternalFile(const char *name, byte **buffer) const {
    return -1;
 }
 
+//
+// kexFileSystem::GetFileSize
+//
+// Size of a file without reading it, 0 if it doesn't exist
+//
+
+int kexFileSystem::GetFileSize(const char *filename) const {
+    file_t *file;
+
+    if(cvarDeveloper.GetBool()) {
+        FILE *fp;
+
+        if((fp = OpenExternal(filename))) {
+            int length;
+
+            fseek(fp, 0, SEEK_END);
+            length = (int)ftell(fp);
+            fclose(fp);
+            return length;
+        }
+    }
+
+    if(!(file = FindFile(filename, NULL))) {
+        return 0;
+    }
+
+    return file->info.uncompressed_size;
+}
+
+//
+// kexFileSystem::OpenStream
+//
+
+bool kexFileSystem::OpenStream(const char *filename, fileStream_t *stream) const {
+    kpf_t *pack;
+    file_t *file;
+
+    stream->zip = NULL;
+    stream->fp = NULL;
+    stream->size = 0;
+    stream->position = 0;
+
+    if(cvarDeveloper.GetBool() && (stream->fp = OpenExternal(filename))) {
+        fseek(stream->fp, 0, SEEK_END);
+        stream->size = (int)ftell(stream->fp);
+        fseek(stream->fp, 0, SEEK_SET);
+        return true;
+    }
+
+    if(!(file = FindFile(filename, &pack))) {
+        return false;
+    }
+
+    if(!(stream->zip = unzOpen(pack->filename))) {
+        return false;
+    }
+
+    unzSetCurrentFileInfoPosition(stream->zip, file->position);
+
+    if(unzOpenCurrentFile(stream->zip) != UNZ_OK) {
+        unzClose(stream->zip);
+        stream->zip = NULL;
+        return false;
+    }
+
+    stream->size = file->info.uncompressed_size;
+    return true;
+}
+
+//
+// kexFileSystem::ReadStream
+//
+
+int kexFileSystem::ReadStream(fileStream_t *stream, byte *buffer, const int size) const {
+    int count = size;
+    int read;
+
+    if(count > stream->size - stream->position) {
+        count = stream->size - stream->position;
+    }
+
+    if(count <= 0) {
+        return 0;
+    }
+
+    if(stream->fp) {
+        read = (int)fread(buffer, 1, count, stream->fp);
+    }
+    else if(stream->zip) {
+        read = unzReadCurrentFile(stream->zip, buffer, count);
+    }
+    else {
+        return 0;
+    }
+
+    if(read <= 0) {
+        return 0;
+    }
+
+    stream->position += read;
+    return read;
+}
+
+//
+// kexFileSystem::SeekStream
+//
+// Packed files are compressed, so seeking back starts the file over
+// and seeking forward reads up to the new position
+//
+
+bool kexFileSystem::SeekStream(fileStream_t *stream, const int position) const {
+    byte skip[4096];
+
+    if(position < 0 || position > stream->size) {
+        return false;
+    }
+
+    if(stream->fp) {
+        stream->position = position;
+        return (fseek(stream->fp, position, SEEK_SET) == 0);
+    }
+
+    if(stream->zip == NULL) {
+        return false;
+    }
+
+    if(position < stream->position) {
+        unzCloseCurrentFile(stream->zip);
+
+        if(unzOpenCurrentFile(stream->zip) != UNZ_OK) {
+            return false;
+        }
+
+        stream->position = 0;
+    }
+
+    while(stream->position < position) {
+        int count = position - stream->position;
+
+        if(count > (int)sizeof(skip)) {
+            count = sizeof(skip);
+        }
+
+        if(ReadStream(stream, skip, count) <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// kexFileSystem::CloseStream
+//
+
+void kexFileSystem::CloseStream(fileStream_t *stream) const {
+    if(stream->fp) {
+        fclose(stream->fp);
+        stream->fp = NULL;
+    }
+
+    if(stream->zip) {
+        unzCloseCurrentFile(stream->zip);
+        unzClose(stream->zip);
+        stream->zip = NULL;
+    }
+}
+
 //
 // kexFileSystem::Init
 //
@@ -308,6 +595,8 @@ void kexFileSystem::Init(void) {
         cvarBasePath.Set(sysMain.GetBaseDirectory());
     }
 
+    packLock = SDL_CreateMutex();
+
     LoadZipFile("game.kpf");
     common.Printf("File System Initialized\n");
 }
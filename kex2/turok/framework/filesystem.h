@@ -26,6 +26,19 @@
 #include "unzip.h"
 #include "array.h"
 #include "kstring.h"
+#include "hashMap.h"
+
+//
+// fileStream_t - a file read a piece at a time. streams over packed files
+// open their own handle on the pack, so each can be read from any one
+// thread without taking the pack lock
+//
+typedef struct {
+    unzFile             zip;
+    FILE                *fp;        // loose file in developer mode
+    int                 size;
+    int                 position;
+} fileStream_t;
 
 class kexFileSystem {
 public:
@@ -35,18 +48,26 @@ public:
     void                Shutdown(void);
     void                LoadZipFile(const char *file);
     int                 OpenFile(const char *filename, byte **data, kexHeapBlock &hb) const;
-    int                 OpenExternalFile(const char *name, byte **buffer) const;
+    int                 OpenExternalFile(const char *name, byte **buffer, kexHeapBlock &hb = hb_file) const;
+    bool                FileExists(const char *filename) const;
+    int                 ReadFile(const char *filename, byte **data, kexHeapBlock &hb);
+    bool                StageFile(const char *filename, byte *data, const int size, kexHeapBlock &hb);
+    int                 DropStagedFiles(void);
+    int                 GetFileSize(const char *filename) const;
+    bool                OpenStream(const char *filename, fileStream_t *stream) const;
+    int                 ReadStream(fileStream_t *stream, byte *buffer, const int size) const;
+    bool                SeekStream(fileStream_t *stream, const int position) const;
+    void                CloseStream(fileStream_t *stream) const;
     void                GetMatchingFiles(kexStrList &list, const char *search);
     void                Init(void);
 
 private:
-    long                HashFileName(const char *fname, int hashSize) const;
-
     typedef struct {
         char            name[MAX_FILEPATH];
         unsigned long   position;
         unz_file_info   info;
         void*           cache;
+        bool            bStaged;    // cache was read ahead and hasn't been opened yet
     } file_t;
 
     typedef struct kpf_s {
@@ -54,14 +75,16 @@ private:
         unsigned int    numfiles;
         char            filename[MAX_FILEPATH];
         file_t          *files;
-        file_t          ***hashes;
-        unsigned int    *hashcount;
-        unsigned int    hashentries;
+        kexHashMap<const char*, file_t*> fileMap;
         struct kpf_s    *next;
     } kpf_t;
 
+    file_t              *FindFile(const char *filename, kpf_t **filePack) const;
+    FILE                *OpenExternal(const char *name) const;
+
     kpf_t               *root;
     char                *base;
+    SDL_mutex           *packLock;  // unzip handles are shared with the map streaming thread
 };
 
 extern kexFileSystem fileSystem;
@@ -0,0 +1,225 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Handle table tests
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "linkedlist.h"
+#include "handleTable.h"
+
+typedef struct {
+    kexVec3     origin;
+    float       radius;
+} testHot_t;
+
+class kexHandleTestObject {
+public:
+    kexHandleTestObject(void) { link.SetData(this); }
+
+    kexVec3                             origin;
+    float                               radius;
+    int                                 id;
+    byte                                pad[192];   // about the size of what's in front of an actor's origin
+    kexLinklist<kexHandleTestObject>    link;
+};
+
+typedef kexHandleTable<kexHandleTestObject, testHot_t> testTable_t;
+
+//
+// testhandles
+//
+
+COMMAND(testhandles) {
+    kexHandleTestObject objs[8];
+    objHandle_t handles[8];
+    objHandle_t reused;
+    testTable_t table;
+    bool bOk = true;
+    int n;
+
+    for(int i = 0; i < 8; i++) {
+        objs[i].id = i;
+        handles[i] = table.Add(&objs[i]);
+        table.Hot(handles[i])->radius = (float)i;
+
+        if(handles[i] == 0 || table.Get(handles[i]) != &objs[i]) {
+            bOk = false;
+        }
+    }
+
+    // removal leaves a hole and stales the handle
+    table.Remove(handles[2]);
+    table.Remove(handles[5]);
+
+    if(table.Get(handles[2]) || table.Hot(handles[5]) || table.Remove(handles[2])) {
+        bOk = false;
+    }
+    if(table.Length() != 8 || table.Count() != 6 || table[2] != NULL) {
+        bOk = false;
+    }
+
+    // the first freed slot comes back with a new generation
+    reused = table.Add(&objs[2]);
+
+    if((reused & HANDLE_INDEX_MASK) != (handles[2] & HANDLE_INDEX_MASK) ||
+        reused == handles[2] || table.Get(handles[2]) || table.Get(reused) != &objs[2]) {
+        bOk = false;
+    }
+
+    handles[2] = reused;
+    table.Hot(reused)->radius = 2;
+
+    // compacting keeps the order and every live handle still resolves
+    table.Compact();
+
+    if(table.Length() != 7 || table.Count() != 7) {
+        bOk = false;
+    }
+
+    n = -1;
+    for(unsigned int i = 0; i < table.Length(); i++) {
+        if(i < 6 && table[i]->id <= n) {
+            bOk = false;
+        }
+
+        n = table[i]->id;
+
+        if(table.HotAt(i).radius != (float)table[i]->id ||
+            table.Get(table.HandleAt(i)) != table[i]) {
+            bOk = false;
+        }
+    }
+
+    for(int i = 0; i < 8; i++) {
+        if(i != 5 && table.Get(handles[i]) != &objs[i]) {
+            bOk = false;
+        }
+    }
+
+    // garbage and out of range handles
+    if(table.Get(0) || table.Get(HANDLE_INDEX_MASK) || table.Get(0xFFFFFFFF)) {
+        bOk = false;
+    }
+
+    table.Clear();
+
+    for(int i = 0; i < 8; i++) {
+        if(table.Get(handles[i])) {
+            bOk = false;
+        }
+    }
+
+    if(table.Length() != 0 || table.Count() != 0) {
+        bOk = false;
+    }
+
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testhandles %s\n",
+        bOk ? "passed" : "failed");
+}
+
+//
+// benchhandles
+//
+// Culls objects against a sphere walking a linked list of objects
+// scattered through the heap, then again walking the table's hot array
+//
+
+COMMAND(benchhandles) {
+    kexLinklist<kexHandleTestObject> list;
+    kexHandleTestObject **objs;
+    kexHandleTestObject *obj;
+    testTable_t table;
+    kexVec3 center(0, 0, 0);
+    double freq = (double)SDL_GetPerformanceFrequency();
+    uint64_t start;
+    double linked;
+    double packed;
+    int count = 10000;
+    int hitsA = 0;
+    int hitsB = 0;
+
+    if(command.GetArgc() >= 2) {
+        count = atoi(command.GetArgv(1));
+    }
+
+    if(count <= 0) {
+        return;
+    }
+
+    objs = new kexHandleTestObject*[count];
+
+    for(int i = 0; i < count; i++) {
+        objs[i] = new kexHandleTestObject;
+        objs[i]->origin.Set(kexRand::CFloat() * 4096, kexRand::CFloat() * 4096, kexRand::CFloat() * 4096);
+        objs[i]->radius = 32;
+    }
+
+    // link in a shuffled order so the walk jumps around like it would
+    // after a few maps worth of spawning and freeing
+    for(int i = count - 1; i > 0; i--) {
+        int j = kexRand::Max(i + 1);
+
+        obj = objs[i];
+        objs[i] = objs[j];
+        objs[j] = obj;
+    }
+
+    for(int i = 0; i < count; i++) {
+        testHot_t *hot;
+
+        objs[i]->link.Add(list);
+        hot = table.Hot(table.Add(objs[i]));
+        hot->origin = objs[i]->origin;
+        hot->radius = objs[i]->radius;
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(obj = list.Next(); obj != NULL; obj = obj->link.Next()) {
+        if(obj->origin.DistanceSq(center) <= (2048 + obj->radius) * (2048 + obj->radius)) {
+            hitsA++;
+        }
+    }
+    linked = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(unsigned int i = 0; i < table.Length(); i++) {
+        const testHot_t &hot = table.HotAt(i);
+
+        if(hot.origin.DistanceSq(center) <= (2048 + hot.radius) * (2048 + hot.radius)) {
+            hitsB++;
+        }
+    }
+    packed = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    common.Printf("%i objects, %i/%i inside\n", count, hitsA, hitsB);
+    common.Printf("linked list: %8.2f ns/object\n", linked * 1e9 / count);
+    common.Printf("hot array:   %8.2f ns/object\n", packed * 1e9 / count);
+
+    for(int i = 0; i < count; i++) {
+        objs[i]->link.Remove();
+        delete objs[i];
+    }
+
+    delete[] objs;
+}
@@ -0,0 +1,352 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __HANDLETABLE_H__
+#define __HANDLETABLE_H__
+
+//
+// a handle is a slot index in the low bits and the slot's generation in
+// the high bits. removing an object bumps the generation of its slot, so
+// any handle still held to it stops resolving. zero is never a handle
+//
+typedef unsigned int objHandle_t;
+
+#define HANDLE_INDEX_BITS   18
+#define HANDLE_INDEX_MASK   ((1 << HANDLE_INDEX_BITS) - 1)
+#define HANDLE_MAX_GEN      ((1 << (32 - HANDLE_INDEX_BITS)) - 1)
+
+//-----------------------------------------------------------------------------
+//
+// kexHandleTable - objects are kept in a packed array alongside a copy of
+// whatever data the hot loops need, so those loops can run down the
+// arrays without touching the objects themselves. removing an object
+// only leaves a NULL behind, Compact closes the gaps in order, so both
+// are safe to do while walking the table. freed
+// slots are reused oldest first so generations wrap as slowly as possible
+//
+//-----------------------------------------------------------------------------
+
+template<class type, class hotType>
+class kexHandleTable {
+public:
+                        kexHandleTable(void);
+                        ~kexHandleTable(void);
+
+    objHandle_t         Add(type *object);
+    bool                Remove(const objHandle_t handle);
+    type                *Get(const objHandle_t handle) const;
+    hotType             *Hot(const objHandle_t handle);
+    void                Compact(void);
+    void                Clear(void);
+
+    const unsigned int  Length(void) const { return length; }
+    const unsigned int  Count(void) const { return length - numHoles; }
+    type                *operator[](const unsigned int index) const { return objects[index]; }
+    hotType             &HotAt(const unsigned int index) { return hot[index]; }
+    const objHandle_t   HandleAt(const unsigned int index) const { return handles[index]; }
+
+private:
+    typedef struct {
+        unsigned int    generation;
+        int             index;          // into the packed arrays, -1 while free
+        int             nextFree;
+    } handleSlot_t;
+
+    int                 AllocSlot(void);
+    void                GrowSlots(void);
+    void                GrowPacked(void);
+
+    handleSlot_t        *slots;
+    unsigned int        numSlots;
+    unsigned int        maxSlots;
+    int                 freeHead;
+    int                 freeTail;
+
+    type                **objects;
+    hotType             *hot;
+    objHandle_t         *handles;
+    unsigned int        length;
+    unsigned int        maxLength;
+    unsigned int        numHoles;
+};
+
+//
+// kexHandleTable::kexHandleTable
+//
+template<class type, class hotType>
+kexHandleTable<type, hotType>::kexHandleTable(void) {
+    slots       = NULL;
+    numSlots    = 0;
+    maxSlots    = 0;
+    freeHead    = -1;
+    freeTail    = -1;
+    objects     = NULL;
+    hot         = NULL;
+    handles     = NULL;
+    length      = 0;
+    maxLength   = 0;
+    numHoles    = 0;
+}
+
+//
+// kexHandleTable::~kexHandleTable
+//
+template<class type, class hotType>
+kexHandleTable<type, hotType>::~kexHandleTable(void) {
+    delete[] slots;
+    delete[] objects;
+    delete[] hot;
+    delete[] handles;
+}
+
+//
+// kexHandleTable::GrowSlots
+//
+template<class type, class hotType>
+void kexHandleTable<type, hotType>::GrowSlots(void) {
+    handleSlot_t *tmp = slots;
+
+    maxSlots = maxSlots ? maxSlots * 2 : 64;
+
+    if(maxSlots > HANDLE_INDEX_MASK + 1) {
+        maxSlots = HANDLE_INDEX_MASK + 1;
+    }
+
+    slots = new handleSlot_t[maxSlots];
+
+    for(unsigned int i = 0; i < numSlots; i++) {
+        slots[i] = tmp[i];
+    }
+
+    delete[] tmp;
+}
+
+//
+// kexHandleTable::GrowPacked
+//
+template<class type, class hotType>
+void kexHandleTable<type, hotType>::GrowPacked(void) {
+    type **tmpObjects = objects;
+    hotType *tmpHot = hot;
+    objHandle_t *tmpHandles = handles;
+
+    maxLength = maxLength ? maxLength * 2 : 64;
+
+    objects = new type*[maxLength];
+    hot = new hotType[maxLength];
+    handles = new objHandle_t[maxLength];
+
+    for(unsigned int i = 0; i < length; i++) {
+        objects[i] = tmpObjects[i];
+        hot[i] = tmpHot[i];
+        handles[i] = tmpHandles[i];
+    }
+
+    delete[] tmpObjects;
+    delete[] tmpHot;
+    delete[] tmpHandles;
+}
+
+//
+// kexHandleTable::AllocSlot
+//
+template<class type, class hotType>
+int kexHandleTable<type, hotType>::AllocSlot(void) {
+    int slot;
+
+    if(freeHead != -1) {
+        slot = freeHead;
+
+        if((freeHead = slots[slot].nextFree) == -1) {
+            freeTail = -1;
+        }
+
+        return slot;
+    }
+
+    if(numSlots == HANDLE_INDEX_MASK + 1) {
+        common.Error("kexHandleTable::Add: out of handles (%i)", numSlots);
+    }
+
+    if(numSlots == maxSlots) {
+        GrowSlots();
+    }
+
+    slot = numSlots++;
+    slots[slot].generation = 1;
+
+    return slot;
+}
+
+//
+// kexHandleTable::Add
+//
+template<class type, class hotType>
+objHandle_t kexHandleTable<type, hotType>::Add(type *object) {
+    objHandle_t handle;
+    int slot;
+
+    // never compacts here, objects get added while the table is being
+    // walked
+    if(length == maxLength) {
+        GrowPacked();
+    }
+
+    slot = AllocSlot();
+    handle = (slots[slot].generation << HANDLE_INDEX_BITS) | slot;
+
+    slots[slot].index = length;
+    slots[slot].nextFree = -1;
+
+    objects[length] = object;
+    hot[length] = hotType();
+    handles[length] = handle;
+    length++;
+
+    return handle;
+}
+
+//
+// kexHandleTable::Remove
+//
+// The object's entry stays behind as a NULL until the next Compact, so
+// this is safe to call while iterating
+//
+template<class type, class hotType>
+bool kexHandleTable<type, hotType>::Remove(const objHandle_t handle) {
+    unsigned int s = handle & HANDLE_INDEX_MASK;
+    handleSlot_t *slot;
+
+    if(s >= numSlots) {
+        return false;
+    }
+
+    slot = &slots[s];
+
+    if(slot->index == -1 || slot->generation != (handle >> HANDLE_INDEX_BITS)) {
+        return false;
+    }
+
+    objects[slot->index] = NULL;
+    handles[slot->index] = 0;
+    numHoles++;
+
+    slot->index = -1;
+    slot->nextFree = -1;
+
+    if(++slot->generation > HANDLE_MAX_GEN) {
+        slot->generation = 1;
+    }
+
+    if(freeTail == -1) {
+        freeHead = s;
+    }
+    else {
+        slots[freeTail].nextFree = s;
+    }
+
+    freeTail = s;
+    return true;
+}
+
+//
+// kexHandleTable::Get
+//
+// Returns NULL for stale handles
+//
+template<class type, class hotType>
+type *kexHandleTable<type, hotType>::Get(const objHandle_t handle) const {
+    unsigned int s = handle & HANDLE_INDEX_MASK;
+
+    if(s >= numSlots || slots[s].index == -1 ||
+        slots[s].generation != (handle >> HANDLE_INDEX_BITS)) {
+        return NULL;
+    }
+
+    return objects[slots[s].index];
+}
+
+//
+// kexHandleTable::Hot
+//
+template<class type, class hotType>
+hotType *kexHandleTable<type, hotType>::Hot(const objHandle_t handle) {
+    unsigned int s = handle & HANDLE_INDEX_MASK;
+
+    if(s >= numSlots || slots[s].index == -1 ||
+        slots[s].generation != (handle >> HANDLE_INDEX_BITS)) {
+        return NULL;
+    }
+
+    return &hot[slots[s].index];
+}
+
+//
+// kexHandleTable::Compact
+//
+// Closes the gaps left by removed objects, keeping everything in order
+//
+template<class type, class hotType>
+void kexHandleTable<type, hotType>::Compact(void) {
+    unsigned int count = 0;
+
+    if(numHoles == 0) {
+        return;
+    }
+
+    for(unsigned int i = 0; i < length; i++) {
+        if(objects[i] == NULL) {
+            continue;
+        }
+
+        if(count != i) {
+            objects[count] = objects[i];
+            hot[count] = hot[i];
+            handles[count] = handles[i];
+            slots[handles[count] & HANDLE_INDEX_MASK].index = count;
+        }
+
+        count++;
+    }
+
+    length = count;
+    numHoles = 0;
+}
+
+//
+// kexHandleTable::Clear
+//
+// Removes everything. Every outstanding handle goes stale
+//
+template<class type, class hotType>
+void kexHandleTable<type, hotType>::Clear(void) {
+    for(unsigned int i = 0; i < length; i++) {
+        if(objects[i] != NULL) {
+            Remove(handles[i]);
+        }
+    }
+
+    length = 0;
+    numHoles = 0;
+}
+
+#endif
@@ -0,0 +1,349 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Hash map tests
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+
+static kexHeapBlock hb_hashTest("hash test", false, NULL, NULL);
+
+typedef struct {
+    int                         id;
+    kexHashList<int>            list;   // like the entries of a kexDefinition
+} hashTestOwner_t;
+
+//
+// HashMap_TestInts
+//
+// Adds, replaces and removes random keys, checking the map against
+// a plain array of what it should hold after every step
+//
+
+static bool HashMap_TestInts(void) {
+    static kexHashMap<int, int> map;
+    const int range = 4096;
+    int *expect;
+    bool bOk = true;
+    unsigned int visited;
+    int *value;
+    int i;
+
+    expect = new int[range];
+
+    for(i = 0; i < range; i++) {
+        expect[i] = -1;
+    }
+
+    for(int step = 0; step < 20000 && bOk; step++) {
+        int key = kexRand::Max(range);
+
+        if(kexRand::Max(3) == 0) {
+            if(map.Remove(key) != (expect[key] != -1)) {
+                bOk = false;
+            }
+
+            expect[key] = -1;
+        }
+        else {
+            // existing keys get their value replaced
+            if(*map.Add(key, step) != step) {
+                bOk = false;
+            }
+
+            expect[key] = step;
+        }
+
+        // spot check a few keys every step, all of them now and then
+        for(i = ((step & 1023) ? key : 0); i < ((step & 1023) ? key + 1 : range); i++) {
+            value = map.Find(i);
+
+            if(expect[i] == -1 ? value != NULL : (value == NULL || *value != expect[i])) {
+                bOk = false;
+            }
+        }
+    }
+
+    // iteration visits every key once
+    visited = 0;
+    for(int index = map.First(); index != -1; index = map.Next(index)) {
+        if(expect[map.KeyAt(index)] != map.ValueAt(index)) {
+            bOk = false;
+        }
+
+        visited++;
+    }
+
+    if(visited != map.Length()) {
+        bOk = false;
+    }
+
+    for(i = 0; i < range; i++) {
+        if(expect[i] != -1) {
+            map.Remove(i);
+        }
+    }
+
+    if(map.Length() != 0 || map.First() != -1) {
+        bOk = false;
+    }
+
+    map.Clear();
+    delete[] expect;
+
+    return bOk;
+}
+
+//
+// HashMap_TestReserve
+//
+
+static bool HashMap_TestReserve(void) {
+    static kexHashMap<const char*, int> map;
+    char names[100][16];
+    unsigned int capacity;
+    bool bOk = true;
+
+    map.Reserve(100);
+    capacity = map.Capacity();
+
+    for(int i = 0; i < 100; i++) {
+        sprintf(names[i], "file%i.tga", i);
+        map.Add(names[i], i);
+    }
+
+    // sized up front, so filling it never rehashed
+    if(map.Capacity() != capacity || map.Length() != 100) {
+        bOk = false;
+    }
+
+    for(int i = 0; i < 100; i++) {
+        char name[16];
+        int *value;
+
+        // compared by contents, not by pointer
+        sprintf(name, "file%i.tga", i);
+
+        if(!(value = map.Find(name)) || *value != i) {
+            bOk = false;
+        }
+    }
+
+    if(map.Find("file100.tga")) {
+        bOk = false;
+    }
+
+    map.Clear();
+
+    if(map.Capacity() != 0 || map.Find("file1.tga")) {
+        bOk = false;
+    }
+
+    return bOk;
+}
+
+//
+// HashMap_TestList
+//
+
+static bool HashMap_TestList(void) {
+    hashTestOwner_t *owner;
+    int staticUsage = kexHeap::Usage(hb_static);
+    unsigned int count;
+    bool bOk = true;
+    int *first;
+    int *data;
+
+    // a list inside a zone allocated object, like a kexDefinition
+    owner = (hashTestOwner_t*)Mem_Calloc(sizeof(hashTestOwner_t), hb_hashTest);
+
+    for(int i = 0; i < 500; i++) {
+        *owner->list.Add(kva("hashtest/entry%i", i), hb_hashTest) = i;
+    }
+
+    // a name that's already there keeps its object
+    first = owner->list.Find("hashtest/entry0");
+    data = owner->list.Add("hashtest/entry0", hb_hashTest);
+
+    if(data != first || *data != 0 || owner->list.Length() != 500) {
+        bOk = false;
+    }
+
+    count = 0;
+    for(data = owner->list.First(); data; data = owner->list.Next()) {
+        if(strcmp(owner->list.GetName(), kva("hashtest/entry%i", *data))) {
+            bOk = false;
+        }
+
+        count++;
+    }
+
+    if(count != 500 || owner->list.Find("hashtest/entry500")) {
+        bOk = false;
+    }
+
+    // the table went into the same block, so purging the block
+    // leaves nothing behind anywhere
+    if(kexHeap::Usage(hb_static) != staticUsage) {
+        bOk = false;
+    }
+
+    Mem_Purge(hb_hashTest);
+
+    if(kexHeap::Usage(hb_hashTest) != 0) {
+        bOk = false;
+    }
+
+    return bOk;
+}
+
+//
+// testhashmap
+//
+
+COMMAND(testhashmap) {
+    bool bOk = true;
+
+    if(!HashMap_TestInts()) {
+        common.Printf("testhashmap: add/find/remove mismatch\n");
+        bOk = false;
+    }
+    if(!HashMap_TestReserve()) {
+        common.Printf("testhashmap: reserve/string keys failed\n");
+        bOk = false;
+    }
+    if(!HashMap_TestList()) {
+        common.Printf("testhashmap: hash list failed\n");
+        bOk = false;
+    }
+
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testhashmap %s\n", bOk ? "passed" : "failed");
+}
+
+//
+// chained list the way kexHashList used to be, kept for the benchmark
+//
+
+typedef struct chainedEntry_s {
+    int                         data;
+    filepath_t                  name;
+    struct chainedEntry_s       *next;
+} chainedEntry_t;
+
+//
+// HashMap_Bench
+//
+
+static void HashMap_Bench(const int count) {
+    static chainedEntry_t *chains[MAX_HASH];
+    static kexHashList<int> list;
+    double freq = (double)SDL_GetPerformanceFrequency();
+    char (*names)[32];
+    uint64_t start;
+    double addChained, addMap;
+    double findChained, findMap;
+    const int passes = 10;
+    int sumA = 0;
+    int sumB = 0;
+
+    names = new char[count][32];
+
+    for(int i = 0; i < count; i++) {
+        sprintf(names[i], "textures/bench/%i.tga", i);
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < count; i++) {
+        chainedEntry_t *e = (chainedEntry_t*)Mem_Calloc(sizeof(chainedEntry_t), hb_hashTest);
+        unsigned int hash;
+
+        strncpy(e->name, names[i], MAX_FILEPATH);
+        e->data = i;
+
+        hash = kexStr::Hash(e->name);
+        e->next = chains[hash];
+        chains[hash] = e;
+    }
+    addChained = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < count; i++) {
+        *list.Add(names[i], hb_hashTest) = i;
+    }
+    addMap = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(int i = 0; i < count; i++) {
+            for(chainedEntry_t *e = chains[kexStr::Hash(names[i])]; e; e = e->next) {
+                if(!strcmp(names[i], e->name)) {
+                    sumA += e->data;
+                    break;
+                }
+            }
+        }
+    }
+    findChained = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(int i = 0; i < count; i++) {
+            sumB += *list.Find(names[i]);
+        }
+    }
+    findMap = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    common.Printf("%i names%s\n", count, sumA == sumB ? "" : " (lookups disagree)");
+    common.Printf("chained add:  %8.2f ns   find: %8.2f ns\n",
+        addChained * 1e9 / count, findChained * 1e9 / (count * passes));
+    common.Printf("hash map add: %8.2f ns   find: %8.2f ns\n",
+        addMap * 1e9 / count, findMap * 1e9 / (count * passes));
+
+    memset(chains, 0, sizeof(chains));
+    list.Clear();
+    Mem_Purge(hb_hashTest);
+
+    delete[] names;
+}
+
+//
+// benchhashmap
+//
+// Fills the old chained list and the hash map with the same names and
+// times adding and looking them all up. Runs 10k and 100k names
+// unless given a count
+//
+
+COMMAND(benchhashmap) {
+    if(command.GetArgc() >= 2) {
+        int count = atoi(command.GetArgv(1));
+
+        if(count > 0) {
+            HashMap_Bench(count);
+        }
+        return;
+    }
+
+    HashMap_Bench(10000);
+    HashMap_Bench(100000);
+}
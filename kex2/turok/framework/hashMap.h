@@ -0,0 +1,367 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __HASHMAP_H__
+#define __HASHMAP_H__
+
+//
+// kexHashTraits - how a key type is hashed and compared. the default
+// works for integers and pointers, strings and names are specialized
+//
+
+template<class type>
+class kexHashTraits {
+public:
+    static unsigned int Hash(const type &key) {
+        return (unsigned int)((size_t)key * 2654435761U);
+    }
+    static bool Compare(const type &a, const type &b) { return a == b; }
+};
+
+template<>
+class kexHashTraits<const char*> {
+public:
+    static unsigned int Hash(const char *const &key) { return kexName::HashString(key); }
+    static bool Compare(const char *const &a, const char *const &b) { return !strcmp(a, b); }
+};
+
+template<>
+class kexHashTraits<kexName> {
+public:
+    static unsigned int Hash(const kexName &key) { return key.Hash(); }
+    static bool Compare(const kexName &a, const kexName &b) { return a == b; }
+};
+
+//
+// kexHashMap - open addressing hash map using robin hood probing.
+// the full hash is stored with every slot so probing rarely has to
+// compare keys, and removal shifts the following run back instead of
+// leaving tombstones. there's no constructor or destructor, a zeroed
+// map is a valid empty map, so global maps need no static init and a
+// map can live inside Mem_Calloc'd structures. the table comes from
+// the map's heap block (hb_static unless set), so purging that block
+// frees it along with whatever the map was in. pointers returned by
+// Find and Add are only valid until the next Add, Remove or Reserve
+//
+
+template<class keyType, class valueType, class traits = kexHashTraits<keyType> >
+class kexHashMap {
+public:
+    valueType           *Add(const keyType &key, const valueType &value);
+    valueType           *Find(const keyType &key) const;
+    bool                Remove(const keyType &key);
+    void                Reserve(const unsigned int size);
+    void                Clear(void);
+    void                SetHeapBlock(kexHeapBlock &hb) { heapBlock = &hb; }
+
+    int                 First(void) const;
+    int                 Next(const int index) const;
+    const keyType       &KeyAt(const int index) const { return slots[index].key; }
+    valueType           &ValueAt(const int index) { return slots[index].value; }
+
+    const unsigned int  Length(void) const { return count; }
+    const unsigned int  Capacity(void) const { return capacity; }
+
+private:
+    typedef struct {
+        unsigned int    hash;
+        keyType         key;
+        valueType       value;
+    } slot_t;
+
+    static unsigned int HashKey(const keyType &key);
+    int                 FindSlot(const keyType &key, const unsigned int hash) const;
+    unsigned int        Distance(const unsigned int index) const;
+    valueType           *Insert(unsigned int hash, keyType key, valueType value);
+    void                Rehash(const unsigned int size);
+
+    slot_t              *slots;
+    unsigned int        capacity;
+    unsigned int        count;
+    kexHeapBlock        *heapBlock;
+};
+
+//
+// kexHashMap::HashKey
+//
+// Zero marks an empty slot so the top bit is always set
+//
+template<class keyType, class valueType, class traits>
+unsigned int kexHashMap<keyType, valueType, traits>::HashKey(const keyType &key) {
+    return traits::Hash(key) | 0x80000000;
+}
+
+//
+// kexHashMap::Distance
+//
+// How far the slot at index sits from where its hash wanted it
+//
+template<class keyType, class valueType, class traits>
+unsigned int kexHashMap<keyType, valueType, traits>::Distance(const unsigned int index) const {
+    return (index - slots[index].hash) & (capacity-1);
+}
+
+//
+// kexHashMap::FindSlot
+//
+template<class keyType, class valueType, class traits>
+int kexHashMap<keyType, valueType, traits>::FindSlot(const keyType &key,
+                                                     const unsigned int hash) const {
+    unsigned int mask;
+    unsigned int index;
+    unsigned int dist;
+
+    if(count == 0) {
+        return -1;
+    }
+
+    mask = capacity-1;
+    index = hash & mask;
+
+    for(dist = 0;; dist++) {
+        const slot_t *slot = &slots[index];
+
+        // a richer slot means the key would have displaced it
+        if(slot->hash == 0 || Distance(index) < dist) {
+            return -1;
+        }
+
+        if(slot->hash == hash && traits::Compare(slot->key, key)) {
+            return index;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return -1;
+}
+
+//
+// kexHashMap::Find
+//
+template<class keyType, class valueType, class traits>
+valueType *kexHashMap<keyType, valueType, traits>::Find(const keyType &key) const {
+    int index;
+
+    if((index = FindSlot(key, HashKey(key))) == -1) {
+        return NULL;
+    }
+
+    return &slots[index].value;
+}
+
+//
+// kexHashMap::Insert
+//
+// Places a key that is known not to be in the map. Whenever the
+// incoming entry is further from home than the resident one, they
+// swap and the resident continues probing
+//
+template<class keyType, class valueType, class traits>
+valueType *kexHashMap<keyType, valueType, traits>::Insert(unsigned int hash,
+                                                          keyType key,
+                                                          valueType value) {
+    unsigned int mask = capacity-1;
+    unsigned int index = hash & mask;
+    unsigned int dist = 0;
+    valueType *result = NULL;
+
+    for(;;) {
+        slot_t *slot = &slots[index];
+
+        if(slot->hash == 0) {
+            slot->hash = hash;
+            slot->key = key;
+            slot->value = value;
+            count++;
+
+            return result ? result : &slot->value;
+        }
+
+        if(Distance(index) < dist) {
+            unsigned int tHash = slot->hash;
+            keyType tKey = slot->key;
+            valueType tValue = slot->value;
+
+            dist = Distance(index);
+
+            slot->hash = hash;
+            slot->key = key;
+            slot->value = value;
+
+            if(result == NULL) {
+                result = &slot->value;
+            }
+
+            hash = tHash;
+            key = tKey;
+            value = tValue;
+        }
+
+        index = (index + 1) & mask;
+        dist++;
+    }
+
+    return NULL;
+}
+
+//
+// kexHashMap::Rehash
+//
+template<class keyType, class valueType, class traits>
+void kexHashMap<keyType, valueType, traits>::Rehash(const unsigned int size) {
+    slot_t *oldSlots = slots;
+    unsigned int oldCapacity = capacity;
+    unsigned int i;
+
+    // zeroed slots are empty
+    slots = (slot_t*)Mem_Calloc(sizeof(slot_t) * size, heapBlock ? *heapBlock : hb_static);
+    capacity = size;
+    count = 0;
+
+    for(i = 0; i < oldCapacity; i++) {
+        if(oldSlots[i].hash != 0) {
+            Insert(oldSlots[i].hash, oldSlots[i].key, oldSlots[i].value);
+        }
+    }
+
+    if(oldSlots) {
+        Mem_Free(oldSlots);
+    }
+}
+
+//
+// kexHashMap::Reserve
+//
+// Sizes the table so that size entries fit without growing
+//
+template<class keyType, class valueType, class traits>
+void kexHashMap<keyType, valueType, traits>::Reserve(const unsigned int size) {
+    unsigned int newCapacity;
+
+    for(newCapacity = 16; newCapacity - (newCapacity >> 3) < size; newCapacity <<= 1);
+
+    if(newCapacity > capacity) {
+        Rehash(newCapacity);
+    }
+}
+
+//
+// kexHashMap::Add
+//
+// Inserts or replaces the value stored for key
+//
+template<class keyType, class valueType, class traits>
+valueType *kexHashMap<keyType, valueType, traits>::Add(const keyType &key,
+                                                       const valueType &value) {
+    unsigned int hash = HashKey(key);
+    int index;
+
+    if((index = FindSlot(key, hash)) != -1) {
+        slots[index].value = value;
+        return &slots[index].value;
+    }
+
+    // keep the load under 7/8
+    if(count + 1 > capacity - (capacity >> 3)) {
+        Reserve(count + 1);
+    }
+
+    return Insert(hash, key, value);
+}
+
+//
+// kexHashMap::Remove
+//
+template<class keyType, class valueType, class traits>
+bool kexHashMap<keyType, valueType, traits>::Remove(const keyType &key) {
+    unsigned int mask;
+    unsigned int index;
+    unsigned int next;
+    int slot;
+
+    if((slot = FindSlot(key, HashKey(key))) == -1) {
+        return false;
+    }
+
+    mask = capacity-1;
+    index = (unsigned int)slot;
+
+    // pull the rest of the run back one slot
+    for(;;) {
+        next = (index + 1) & mask;
+
+        if(slots[next].hash == 0 || Distance(next) == 0) {
+            break;
+        }
+
+        slots[index] = slots[next];
+        index = next;
+    }
+
+    slots[index].hash = 0;
+    slots[index].key = keyType();
+    slots[index].value = valueType();
+    count--;
+
+    return true;
+}
+
+//
+// kexHashMap::Clear
+//
+template<class keyType, class valueType, class traits>
+void kexHashMap<keyType, valueType, traits>::Clear(void) {
+    if(slots) {
+        Mem_Free(slots);
+    }
+
+    slots = NULL;
+    capacity = 0;
+    count = 0;
+}
+
+//
+// kexHashMap::First
+//
+// Returns the first occupied slot, or -1 if the map is empty
+//
+template<class keyType, class valueType, class traits>
+int kexHashMap<keyType, valueType, traits>::First(void) const {
+    return Next(-1);
+}
+
+//
+// kexHashMap::Next
+//
+template<class keyType, class valueType, class traits>
+int kexHashMap<keyType, valueType, traits>::Next(const int index) const {
+    for(unsigned int i = (unsigned int)(index + 1); i < capacity; i++) {
+        if(slots[i].hash != 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+#endif
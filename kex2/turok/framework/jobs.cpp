@@ -0,0 +1,722 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Job system
+//
+// Each thread's queue is a Chase-Lev deque: the owner works at the
+// bottom like a stack, so it keeps running the jobs it just made while
+// they're still warm, and thieves take the oldest job from the top.
+// Only taking the last job needs the owner and a thief to agree, which
+// they do with a CAS on top.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "jobs.h"
+
+kexCvar cvarJobWorkers("sys_jobworkers", CVF_INT|CVF_CONFIG, "-1", -1, JOB_MAX_THREADS-1,
+                       "Number of job worker threads. 0 runs every job on the thread that submits it, -1 picks one less than the number of cores. The thread count changes on restart");
+
+kexHeapBlock hb_jobs("jobs", false, NULL, NULL);
+
+kexJobSystem jobSystem;
+
+//
+// testjobs
+//
+
+COMMAND(testjobs) {
+    int numJobs = 4096;
+
+    if(command.GetArgc() >= 2) {
+        numJobs = atoi(command.GetArgv(1));
+    }
+
+    kexJobSystem::Test(numJobs);
+}
+
+//
+// benchjobs
+//
+
+COMMAND(benchjobs) {
+    int numJobs = 100000;
+
+    if(command.GetArgc() >= 2) {
+        numJobs = atoi(command.GetArgv(1));
+    }
+
+    kexJobSystem::Benchmark(numJobs);
+}
+
+//
+// kexJobQueue::Push
+//
+// Owner only. Returns false if the queue is full
+//
+
+bool kexJobQueue::Push(job_t *job) {
+    int b = SDL_AtomicGet(&bottom);
+    int t = SDL_AtomicGet(&top);
+
+    if(b - t >= JOB_QUEUE_SIZE) {
+        return false;
+    }
+
+    jobs[b & (JOB_QUEUE_SIZE-1)] = job;
+
+    // the job has to be visible before the new bottom is
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&bottom, b + 1);
+    return true;
+}
+
+//
+// kexJobQueue::Pop
+//
+// Owner only
+//
+
+job_t *kexJobQueue::Pop(void) {
+    int b;
+    int t;
+    job_t *job;
+
+    // the store to bottom has to be visible to thieves before top is
+    // read back. a plain atomic store doesn't order against the load
+    // that follows it, the read-modify-write is a full barrier
+    b = SDL_AtomicAdd(&bottom, -1) - 1;
+    t = SDL_AtomicGet(&top);
+
+    if(t > b) {
+        // empty
+        SDL_AtomicSet(&bottom, t);
+        return NULL;
+    }
+
+    job = jobs[b & (JOB_QUEUE_SIZE-1)];
+
+    if(t != b) {
+        return job;
+    }
+
+    // last job, race any thieves for it
+    if(!SDL_AtomicCAS(&top, t, t + 1)) {
+        job = NULL;
+    }
+
+    SDL_AtomicSet(&bottom, t + 1);
+    return job;
+}
+
+//
+// kexJobQueue::Steal
+//
+// Any thread
+//
+
+job_t *kexJobQueue::Steal(void) {
+    int t = SDL_AtomicGet(&top);
+    int b;
+    job_t *job;
+
+    SDL_MemoryBarrierAcquire();
+    b = SDL_AtomicGet(&bottom);
+
+    if(t >= b) {
+        return NULL;
+    }
+
+    job = jobs[t & (JOB_QUEUE_SIZE-1)];
+
+    if(!SDL_AtomicCAS(&top, t, t + 1)) {
+        // lost it to the owner or another thief
+        return NULL;
+    }
+
+    return job;
+}
+
+//
+// kexJobSystem::Init
+//
+
+void kexJobSystem::Init(void) {
+    int numWorkers;
+
+    if(bInitialized) {
+        return;
+    }
+
+    numWorkers = cvarJobWorkers.GetInt();
+
+    if(numWorkers < 0) {
+        numWorkers = SDL_GetCPUCount() - 1;
+    }
+
+    kexMath::Clamp(numWorkers, 0, JOB_MAX_THREADS-1);
+
+    tlsIndex = SDL_TLSCreate();
+    SDL_TLSSet(tlsIndex, (void*)1, NULL);
+
+    SDL_AtomicSet(&bQuit, 0);
+    wake = SDL_CreateSemaphore(0);
+
+    for(int i = 0; i < numWorkers + 1; i++) {
+        threads[i].scratch = (byte*)Mem_Malloc(JOB_SCRATCH_SIZE, hb_jobs);
+        threads[i].scratchUsed = 0;
+        threads[i].poolIndex = 0;
+    }
+
+    numThreads = 1;
+    bInitialized = true;
+
+    for(int i = 1; i < numWorkers + 1; i++) {
+        // bump the count first, the new thread reads it
+        numThreads = i + 1;
+
+        if(!(handles[i] = SDL_CreateThread(WorkerThread, "jobWorker", &threads[i]))) {
+            numThreads = i;
+            break;
+        }
+    }
+
+    common.Printf("Job system: %i worker threads\n", numThreads - 1);
+}
+
+//
+// kexJobSystem::Shutdown
+//
+
+void kexJobSystem::Shutdown(void) {
+    if(!bInitialized) {
+        return;
+    }
+
+    // finish off anything that's still queued
+    while(RunOne(0));
+
+    SDL_AtomicSet(&bQuit, 1);
+
+    for(int i = 1; i < numThreads; i++) {
+        SDL_SemPost(wake);
+    }
+
+    for(int i = 1; i < numThreads; i++) {
+        SDL_WaitThread(handles[i], NULL);
+        handles[i] = NULL;
+    }
+
+    SDL_DestroySemaphore(wake);
+    wake = NULL;
+
+    Mem_Purge(hb_jobs);
+
+    numThreads = 0;
+    bInitialized = false;
+}
+
+//
+// kexJobSystem::IsSerial
+//
+
+const bool kexJobSystem::IsSerial(void) {
+    return (!bInitialized || numThreads <= 1 || cvarJobWorkers.GetInt() == 0);
+}
+
+//
+// kexJobSystem::ThreadIndex
+//
+// Index of the calling thread, or -1 if it isn't one of ours
+//
+
+int kexJobSystem::ThreadIndex(void) {
+    if(!bInitialized) {
+        return -1;
+    }
+
+    return (int)((intptr_t)SDL_TLSGet(tlsIndex)) - 1;
+}
+
+//
+// kexJobSystem::Scratch
+//
+// Memory that's good for the rest of the job that asked for it.
+// Returns NULL once the thread's arena runs out
+//
+
+void *kexJobSystem::Scratch(const int thread, const int size) {
+    jobThread_t *t;
+    void *ptr;
+
+    if(thread < 0 || thread >= numThreads) {
+        return NULL;
+    }
+
+    t = &threads[thread];
+
+    if(t->scratchUsed + size > JOB_SCRATCH_SIZE) {
+        return NULL;
+    }
+
+    ptr = t->scratch + t->scratchUsed;
+    t->scratchUsed += (size + 15) & ~15;
+
+    return ptr;
+}
+
+//
+// kexJobSystem::AllocJob
+//
+// Takes the next record from the thread's pool. Returns NULL if
+// that record is still out, in which case the caller runs the job
+// in place
+//
+
+job_t *kexJobSystem::AllocJob(const int thread) {
+    jobThread_t *t = &threads[thread];
+    job_t *job = &t->pool[t->poolIndex & (JOB_QUEUE_SIZE-1)];
+
+    if(SDL_AtomicGet(&job->busy)) {
+        return NULL;
+    }
+
+    t->poolIndex++;
+    SDL_AtomicSet(&job->busy, 1);
+    return job;
+}
+
+//
+// kexJobSystem::Execute
+//
+
+void kexJobSystem::Execute(const int thread, job_t *job) {
+    jobThread_t *t = &threads[thread];
+    jobCounter_t *counter = job->counter;
+    int scratchMark = t->scratchUsed;
+
+    job->func(job->data, job->start, job->end, thread);
+
+    // the job may have waited on others, which ran on this thread too
+    t->scratchUsed = scratchMark;
+
+    SDL_AtomicSet(&job->busy, 0);
+
+    if(counter) {
+        SDL_AtomicAdd(&counter->pending, -1);
+    }
+}
+
+//
+// kexJobSystem::RunInPlace
+//
+
+void kexJobSystem::RunInPlace(const int thread, jobFunc_t func, void *data,
+                              const int start, const int end) {
+    int scratchMark;
+
+    if(thread < 0) {
+        func(data, start, end, thread);
+        return;
+    }
+
+    scratchMark = threads[thread].scratchUsed;
+    func(data, start, end, thread);
+    threads[thread].scratchUsed = scratchMark;
+}
+
+//
+// kexJobSystem::Push
+//
+
+void kexJobSystem::Push(const int thread, job_t *job) {
+    if(!threads[thread].queue.Push(job)) {
+        Execute(thread, job);
+        return;
+    }
+
+    // don't let the wake count pile up past the number of workers
+    if((int)SDL_SemValue(wake) < numThreads - 1) {
+        SDL_SemPost(wake);
+    }
+}
+
+//
+// kexJobSystem::RunOne
+//
+// Runs a job from the thread's own queue, or failing that one
+// stolen from another thread. Returns false if there was nothing
+//
+
+bool kexJobSystem::RunOne(const int thread) {
+    job_t *job;
+
+    if(!(job = threads[thread].queue.Pop())) {
+        for(int i = 1; i < numThreads && !job; i++) {
+            job = threads[(thread + i) % numThreads].queue.Steal();
+        }
+    }
+
+    if(!job) {
+        return false;
+    }
+
+    Execute(thread, job);
+    return true;
+}
+
+//
+// kexJobSystem::Submit
+//
+
+void kexJobSystem::Submit(jobFunc_t func, void *data, jobCounter_t *counter) {
+    ParallelFor(func, data, 1, 1, counter);
+}
+
+//
+// kexJobSystem::ParallelFor
+//
+// Splits [0, count) into jobs of grain indices each. A grain of
+// zero or less picks one that gives every thread a few jobs
+//
+
+void kexJobSystem::ParallelFor(jobFunc_t func, void *data, const int count,
+                               const int grain, jobCounter_t *counter) {
+    int thread = ThreadIndex();
+    int size = grain;
+    int numJobs;
+    job_t *job;
+
+    if(count <= 0) {
+        return;
+    }
+
+    if(thread < 0 || IsSerial()) {
+        RunInPlace(thread, func, data, 0, count);
+        return;
+    }
+
+    if(size <= 0) {
+        size = count / (numThreads * 4);
+
+        if(size < 1) {
+            size = 1;
+        }
+    }
+
+    numJobs = (count + size - 1) / size;
+
+    // count everything up front so a waiter can't see zero early
+    if(counter) {
+        SDL_AtomicAdd(&counter->pending, numJobs);
+    }
+
+    for(int i = 0; i < numJobs; i++) {
+        int start = i * size;
+        int end = (start + size < count) ? start + size : count;
+
+        if(!(job = AllocJob(thread))) {
+            RunInPlace(thread, func, data, start, end);
+
+            if(counter) {
+                SDL_AtomicAdd(&counter->pending, -1);
+            }
+            continue;
+        }
+
+        job->func = func;
+        job->data = data;
+        job->start = start;
+        job->end = end;
+        job->counter = counter;
+
+        Push(thread, job);
+    }
+}
+
+//
+// kexJobSystem::Wait
+//
+// Runs jobs until the counter reaches zero
+//
+
+void kexJobSystem::Wait(jobCounter_t *counter) {
+    int thread = ThreadIndex();
+
+    while(SDL_AtomicGet(&counter->pending) > 0) {
+        if(thread < 0 || !RunOne(thread)) {
+            SDL_Delay(0);
+        }
+    }
+}
+
+//
+// kexJobSystem::WorkerThread
+//
+
+int kexJobSystem::WorkerThread(void *data) {
+    kexJobSystem *js = &jobSystem;
+    int thread = (int)(static_cast<jobThread_t*>(data) - js->threads);
+
+    SDL_TLSSet(js->tlsIndex, (void*)(intptr_t)(thread + 1), NULL);
+
+    while(!SDL_AtomicGet(&js->bQuit)) {
+        if(js->RunOne(thread)) {
+            continue;
+        }
+
+        // sleep until Push or Shutdown posts. the semaphore keeps its
+        // count, so a post that lands before the wait isn't lost
+        SDL_SemWait(js->wake);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Tests
+//
+//-----------------------------------------------------------------------------
+
+typedef struct {
+    int                     *hits;
+    SDL_atomic_t            total;
+    SDL_atomic_t            leaves;
+    SDL_atomic_t            badScratch;
+    SDL_atomic_t            threadsSeen[JOB_MAX_THREADS];
+    int                     fanOut;
+} jobTest_t;
+
+//
+// JobTest_Range
+//
+
+static void JobTest_Range(void *data, const int start, const int end, const int thread) {
+    jobTest_t *test = static_cast<jobTest_t*>(data);
+    int *scratch;
+    int count = end - start;
+
+    // fill this job's scratch and make sure nothing else wrote to it
+    if((scratch = (int*)jobSystem.Scratch(thread, sizeof(int) * count))) {
+        for(int i = 0; i < count; i++) {
+            scratch[i] = start + i;
+        }
+    }
+
+    for(int i = start; i < end; i++) {
+        test->hits[i]++;
+        SDL_AtomicAdd(&test->total, 1);
+    }
+
+    if(scratch) {
+        for(int i = 0; i < count; i++) {
+            if(scratch[i] != start + i) {
+                SDL_AtomicAdd(&test->badScratch, 1);
+                break;
+            }
+        }
+    }
+
+    if(thread >= 0) {
+        SDL_AtomicSet(&test->threadsSeen[thread], 1);
+    }
+}
+
+//
+// JobTest_Leaf
+//
+
+static void JobTest_Leaf(void *data, const int start, const int end, const int thread) {
+    SDL_AtomicAdd(&static_cast<jobTest_t*>(data)->leaves, 1);
+}
+
+//
+// JobTest_Branch
+//
+// Submits more jobs from inside a job and waits on them there
+//
+
+static void JobTest_Branch(void *data, const int start, const int end, const int thread) {
+    jobTest_t *test = static_cast<jobTest_t*>(data);
+    jobCounter_t counter;
+
+    SDL_AtomicSet(&counter.pending, 0);
+
+    for(int i = 0; i < test->fanOut; i++) {
+        jobSystem.Submit(JobTest_Leaf, test, &counter);
+    }
+
+    jobSystem.Wait(&counter);
+}
+
+//
+// JobTest_Empty
+//
+
+static void JobTest_Empty(void *data, const int start, const int end, const int thread) {
+}
+
+//
+// kexJobSystem::Test
+//
+// Hammers the queues with small jobs, nested submits and waits from
+// inside jobs, and checks that every index ran exactly once
+//
+
+bool kexJobSystem::Test(const int numJobs) {
+    jobTest_t test;
+    jobCounter_t counter;
+    int count = numJobs * 16;
+    int grains[3] = { 1, 7, 0 };
+    int numSeen;
+    bool bOk = true;
+
+    if(numJobs <= 0) {
+        return false;
+    }
+
+    memset(&test, 0, sizeof(jobTest_t));
+    test.hits = (int*)Mem_Calloc(sizeof(int) * count, hb_jobs);
+
+    for(int pass = 0; pass < 3; pass++) {
+        memset(test.hits, 0, sizeof(int) * count);
+        SDL_AtomicSet(&test.total, 0);
+        SDL_AtomicSet(&counter.pending, 0);
+
+        jobSystem.ParallelFor(JobTest_Range, &test, count, grains[pass], &counter);
+        jobSystem.Wait(&counter);
+
+        for(int i = 0; i < count; i++) {
+            if(test.hits[i] != 1) {
+                common.Printf("parallel for (grain %i): index %i ran %i times\n",
+                    grains[pass], i, test.hits[i]);
+                bOk = false;
+                break;
+            }
+        }
+
+        if(SDL_AtomicGet(&test.total) != count) {
+            common.Printf("parallel for (grain %i): %i of %i indices ran\n",
+                grains[pass], SDL_AtomicGet(&test.total), count);
+            bOk = false;
+        }
+    }
+
+    if(SDL_AtomicGet(&test.badScratch) != 0) {
+        common.Printf("%i jobs had their scratch memory overwritten\n",
+            SDL_AtomicGet(&test.badScratch));
+        bOk = false;
+    }
+
+    // nested submits and waits
+    test.fanOut = 16;
+    SDL_AtomicSet(&test.leaves, 0);
+    SDL_AtomicSet(&counter.pending, 0);
+
+    for(int i = 0; i < numJobs / 16; i++) {
+        jobSystem.Submit(JobTest_Branch, &test, &counter);
+    }
+
+    jobSystem.Wait(&counter);
+
+    if(SDL_AtomicGet(&test.leaves) != (numJobs / 16) * test.fanOut) {
+        common.Printf("nested jobs: %i of %i ran\n",
+            SDL_AtomicGet(&test.leaves), (numJobs / 16) * test.fanOut);
+        bOk = false;
+    }
+
+    // more jobs than there are records to hold them
+    SDL_AtomicSet(&test.leaves, 0);
+    SDL_AtomicSet(&counter.pending, 0);
+
+    for(int i = 0; i < JOB_QUEUE_SIZE * 2; i++) {
+        jobSystem.Submit(JobTest_Leaf, &test, &counter);
+    }
+
+    jobSystem.Wait(&counter);
+
+    if(SDL_AtomicGet(&test.leaves) != JOB_QUEUE_SIZE * 2) {
+        common.Printf("overflow: %i of %i jobs ran\n",
+            SDL_AtomicGet(&test.leaves), JOB_QUEUE_SIZE * 2);
+        bOk = false;
+    }
+
+    Mem_Free(test.hits);
+
+    numSeen = 0;
+    for(int i = 0; i < JOB_MAX_THREADS; i++) {
+        numSeen += SDL_AtomicGet(&test.threadsSeen[i]);
+    }
+
+    common.Printf("%i threads, %i took part\n", jobSystem.IsSerial() ? 1 : jobSystem.NumThreads(),
+        numSeen);
+
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testjobs %s\n", bOk ? "passed" : "failed");
+    return bOk;
+}
+
+//
+// kexJobSystem::Benchmark
+//
+// Time per job for empty jobs, which is all scheduling overhead
+//
+
+void kexJobSystem::Benchmark(const int numJobs) {
+    jobCounter_t counter;
+    jobFunc_t volatile emptyFunc = JobTest_Empty;   // keeps the direct calls from being optimized out
+    uint64_t start;
+    double freq = (double)SDL_GetPerformanceFrequency();
+    double direct;
+    double submit;
+    double range;
+
+    if(numJobs <= 0) {
+        return;
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < numJobs; i++) {
+        emptyFunc(NULL, i, i + 1, 0);
+    }
+    direct = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    SDL_AtomicSet(&counter.pending, 0);
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < numJobs; i++) {
+        jobSystem.Submit(JobTest_Empty, NULL, &counter);
+    }
+    jobSystem.Wait(&counter);
+    submit = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    SDL_AtomicSet(&counter.pending, 0);
+    start = sysMain.GetPerformanceCounter();
+    jobSystem.ParallelFor(JobTest_Empty, NULL, numJobs, 1, &counter);
+    jobSystem.Wait(&counter);
+    range = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    common.Printf("%i jobs on %i threads\n", numJobs,
+        jobSystem.IsSerial() ? 1 : jobSystem.NumThreads());
+    common.Printf("direct call:       %8.1f ns/job\n", direct * 1e9 / numJobs);
+    common.Printf("submit + wait:     %8.1f ns/job\n", submit * 1e9 / numJobs);
+    common.Printf("parallel for (1):  %8.1f ns/job\n", range * 1e9 / numJobs);
+}
@@ -0,0 +1,125 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __JOBS_H__
+#define __JOBS_H__
+
+#define JOB_MAX_THREADS     16          // including the main thread
+#define JOB_QUEUE_SIZE      4096        // must be a power of two
+#define JOB_SCRATCH_SIZE    (256*1024)
+
+//
+// runs over [start, end). a single job is the range [0, 1). thread is
+// 0 for the main thread, 1 and up for the workers and -1 if the job
+// was run in place on a thread the job system doesn't own
+//
+typedef void (*jobFunc_t)(void *data, const int start, const int end, const int thread);
+
+//
+// jobCounter_t - counts jobs that haven't finished yet. zero it before
+// handing it to Submit or ParallelFor, then Wait on it
+//
+typedef struct {
+    SDL_atomic_t            pending;
+} jobCounter_t;
+
+typedef struct {
+    jobFunc_t               func;
+    void                    *data;
+    int                     start;
+    int                     end;
+    jobCounter_t            *counter;
+    SDL_atomic_t            busy;
+} job_t;
+
+//
+// kexJobQueue - work stealing deque. only the owning thread pushes
+// and pops, at the bottom. other threads steal from the top
+//
+
+class kexJobQueue {
+public:
+    bool                    Push(job_t *job);
+    job_t                   *Pop(void);
+    job_t                   *Steal(void);
+
+private:
+    job_t                   *jobs[JOB_QUEUE_SIZE];
+    SDL_atomic_t            top;
+    SDL_atomic_t            bottom;
+};
+
+//
+// kexJobSystem - every thread, the main thread included, owns a queue
+// and a pool of job records. new jobs go on the submitting thread's
+// queue and idle threads steal from the others. a thread waiting on a
+// counter runs jobs instead of blocking. with no workers everything
+// runs on the calling thread as it's submitted
+//
+
+class kexJobSystem {
+public:
+    void                    Init(void);
+    void                    Shutdown(void);
+    void                    Submit(jobFunc_t func, void *data, jobCounter_t *counter);
+    void                    ParallelFor(jobFunc_t func, void *data, const int count,
+                                        const int grain, jobCounter_t *counter);
+    void                    Wait(jobCounter_t *counter);
+    void                    *Scratch(const int thread, const int size);
+    int                     ThreadIndex(void);
+
+    const int               NumThreads(void) const { return numThreads; }
+    const bool              IsSerial(void);
+
+    static bool             Test(const int numJobs);
+    static void             Benchmark(const int numJobs);
+
+private:
+    typedef struct {
+        job_t               pool[JOB_QUEUE_SIZE];
+        unsigned int        poolIndex;
+        byte                *scratch;
+        int                 scratchUsed;
+        kexJobQueue         queue;
+    } jobThread_t;
+
+    static int              WorkerThread(void *data);
+
+    job_t                   *AllocJob(const int thread);
+    void                    Push(const int thread, job_t *job);
+    bool                    RunOne(const int thread);
+    void                    Execute(const int thread, job_t *job);
+    void                    RunInPlace(const int thread, jobFunc_t func, void *data,
+                                       const int start, const int end);
+
+    jobThread_t             threads[JOB_MAX_THREADS];
+    SDL_Thread              *handles[JOB_MAX_THREADS];
+    int                     numThreads;
+    SDL_TLSID               tlsIndex;
+    SDL_sem                 *wake;
+    SDL_atomic_t            bQuit;
+    bool                    bInitialized;
+};
+
+extern kexJobSystem jobSystem;
+
+#endif
@@ -39,6 +39,8 @@
 kexHashKey::kexHashKey(const char *key, const char *value) {
     this->key = key;
     this->value = value;
+
+    Compile();
 }
 
 //
@@ -48,6 +50,8 @@ kexHashKey::kexHashKey(const char *key, const char *value) {
 kexHashKey::kexHashKey(void) {
     this->key = "";
     this->value = "";
+    this->iValue = 0;
+    this->fValue = 0;
 }
 
 //
@@ -64,6 +68,23 @@ kexHashKey::~kexHashKey(void) {
 void kexHashKey::operator=(kexHashKey &hashKey) {
     this->key = hashKey.key;
     this->value = hashKey.value;
+    this->iValue = hashKey.iValue;
+    this->fValue = hashKey.fValue;
+    this->vValue = hashKey.vValue;
+}
+
+//
+// kexHashKey::Compile
+//
+
+void kexHashKey::Compile(void) {
+    const char *str = value.c_str();
+
+    iValue = atoi(str);
+    fValue = (float)atof(str);
+
+    vValue.Clear();
+    sscanf(str, "%f %f %f", &vValue.x, &vValue.y, &vValue.z);
 }
 
 //
@@ -185,7 +206,7 @@ bool kexKeyMap::GetFloat(const char *key, float &out, const float defaultValue)
         return false;
     }
 
-    out = (float)atof(k->GetString());
+    out = k->GetFloat();
     return true;
 }
 
@@ -210,7 +231,7 @@ bool kexKeyMap::GetInt(const char *key, int &out, const int defaultValue) {
         return false;
     }
 
-    out = atoi(k->GetString());
+    out = k->GetInt();
     return true;
 }
 
@@ -235,7 +256,7 @@ bool kexKeyMap::GetBool(const char *key, bool &out, const bool defaultValue) {
         return false;
     }
 
-    out = (atoi(k->GetString()) != 0);
+    out = (k->GetInt() != 0);
     return true;
 }
 
@@ -283,7 +304,7 @@ bool kexKeyMap::GetVector(const char *key, kexVec3 &out) {
         return false;
     }
 
-    sscanf(k->GetString(), "%f %f %f", &out.x, &out.y, &out.z);
+    out = k->GetVector();
     return true;
 }
 
@@ -33,10 +33,21 @@ public:
 
     const char                  *GetName(void) { return key.c_str(); }
     const char                  *GetString(void) { return value.c_str(); }
+    const int                   GetInt(void) const { return iValue; }
+    const float                 GetFloat(void) const { return fValue; }
+    const kexVec3               &GetVector(void) const { return vValue; }
 
 private:
+    void                        Compile(void);
+
     kexStr                      key;
     kexStr                      value;
+
+    // values are parsed once when the key is added so lookups
+    // don't need to go through atoi/atof/sscanf every time
+    int                         iValue;
+    float                       fValue;
+    kexVec3                     vValue;
 };
 
 class kexKeyMap {
@@ -0,0 +1,633 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Log record ring
+//
+// Producers claim a slot by advancing the head with a compare and swap,
+// fill it in and then publish it by storing its ring position in the
+// slot's sequence. Each reader owns a tail and only ever moves its own,
+// so readers never contend with each other, and a producer only has to
+// check that the oldest unread record is less than a full ring behind.
+//
+//-----------------------------------------------------------------------------
+
+#include <time.h>
+#include "common.h"
+#include "console.h"
+#include "logger.h"
+
+kexLogger logger;
+
+const char *kexLogger::channelNames[LC_NUMCHANNELS] = {
+    "general",
+    "system",
+    "script",
+    "game",
+    "render",
+    "sound"
+};
+
+const char *kexLogger::severityNames[LS_NUMSEVERITIES] = {
+    "debug",
+    "info",
+    "warning",
+    "error"
+};
+
+//
+// logstresstest
+//
+
+COMMAND(logstresstest) {
+    int numThreads = 8;
+    int numMessages = 20000;
+
+    if(command.GetArgc() >= 2) {
+        numThreads = atoi(command.GetArgv(1));
+    }
+    if(command.GetArgc() >= 3) {
+        numMessages = atoi(command.GetArgv(2));
+    }
+
+    kexLogger::StressTest(numThreads, numMessages);
+}
+
+//
+// FillRecord
+//
+
+static void FillRecord(logRecord_t *record, const logChannel_t channel,
+                       const logSeverity_t severity, const rcolor color,
+                       const int flags, const char *text) {
+    record->time = (unsigned int)time(0);
+    record->severity = (byte)severity;
+    record->channel = (byte)channel;
+    record->flags = (byte)flags;
+    record->color = color;
+
+    strncpy(record->text, text, LOG_MAX_LENGTH-1);
+    record->text[LOG_MAX_LENGTH-1] = 0;
+}
+
+//
+// kexLogger::Init
+//
+// Starts the writer thread. If it can't be started the logger just
+// keeps writing synchronously
+//
+
+void kexLogger::Init(void) {
+    if(SDL_AtomicGet(&state) != LOG_OFF) {
+        return;
+    }
+
+    mainThread = SDL_ThreadID();
+    SDL_AtomicSet(&bQuit, 0);
+
+    if(!(sem = SDL_CreateSemaphore(0))) {
+        return;
+    }
+
+    SDL_AtomicSet(&state, LOG_RUNNING);
+
+    if(!(thread = SDL_CreateThread(WriterThread, "logWriter", this))) {
+        SDL_AtomicSet(&state, LOG_OFF);
+        SDL_DestroySemaphore(sem);
+        sem = NULL;
+    }
+}
+
+//
+// kexLogger::Shutdown
+//
+// Stops the writer thread and flushes whatever is left in the ring.
+// Anything posted afterwards is written synchronously
+//
+
+void kexLogger::Shutdown(void) {
+    if(SDL_AtomicGet(&state) != LOG_RUNNING) {
+        return;
+    }
+
+    if(!bTest) {
+        SDL_AtomicSet(&bQuit, 1);
+        SDL_SemPost(sem);
+        SDL_WaitThread(thread, NULL);
+        thread = NULL;
+    }
+
+    SDL_AtomicSet(&state, LOG_STOPPED);
+
+    WriteFile();
+
+    if(IsMainThread()) {
+        DrainConsole();
+    }
+
+    if(sem) {
+        SDL_DestroySemaphore(sem);
+        sem = NULL;
+    }
+}
+
+//
+// kexLogger::IsMainThread
+//
+
+bool kexLogger::IsMainThread(void) {
+    return SDL_ThreadID() == mainThread;
+}
+
+//
+// kexLogger::Post
+//
+// Returns false if the ring was full and the message was dropped
+//
+
+bool kexLogger::Post(const logChannel_t channel, const logSeverity_t severity,
+                     const rcolor color, const int flags, const char *text) {
+    logRecord_t *record;
+    unsigned int pos;
+    unsigned int tail;
+    unsigned int fTail;
+
+    if(SDL_AtomicGet(&state) != LOG_RUNNING) {
+        logRecord_t local;
+
+        FillRecord(&local, channel, severity, color, flags, text);
+        WriteSync(&local);
+        return true;
+    }
+
+    do {
+        // read the tails before the head so the tail can never be ahead
+        tail = (unsigned int)SDL_AtomicGet(&consoleTail);
+        fTail = (unsigned int)SDL_AtomicGet(&fileTail);
+        pos = (unsigned int)SDL_AtomicGet(&head);
+
+        if((int)(fTail - tail) < 0) {
+            tail = fTail;
+        }
+
+        if(pos - tail >= LOG_MAX_RECORDS) {
+            SDL_AtomicAdd(&dropped, 1);
+            return false;
+        }
+    } while(!SDL_AtomicCAS(&head, (int)pos, (int)(pos + 1)));
+
+    record = &records[pos & (LOG_MAX_RECORDS-1)];
+    FillRecord(record, channel, severity, color, flags, text);
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&record->sequence, (int)(pos + 1));
+
+    if(bTest) {
+        return true;
+    }
+
+    // keep the console in step with the caller when it can be
+    if(IsMainThread()) {
+        DrainConsole();
+    }
+
+    if(SDL_SemValue(sem) == 0) {
+        SDL_SemPost(sem);
+    }
+
+    return true;
+}
+
+//
+// kexLogger::VPrintf
+//
+
+bool kexLogger::VPrintf(const logChannel_t channel, const logSeverity_t severity,
+                        const rcolor color, const int flags,
+                        const char *string, va_list va) {
+    char buffer[LOG_MAX_LENGTH];
+
+    SDL_vsnprintf(buffer, LOG_MAX_LENGTH, string, va);
+    return Post(channel, severity, color, flags, buffer);
+}
+
+//
+// kexLogger::Printf
+//
+
+bool kexLogger::Printf(const logChannel_t channel, const logSeverity_t severity,
+                       const rcolor color, const char *string, ...) {
+    va_list va;
+    bool bPosted;
+
+    va_start(va, string);
+    bPosted = VPrintf(channel, severity, color, 0, string, va);
+    va_end(va);
+
+    return bPosted;
+}
+
+//
+// kexLogger::Consume
+//
+// Hands every published record past tail to func in order and
+// advances the tail behind it. Only one thread may consume a tail
+//
+
+int kexLogger::Consume(SDL_atomic_t *tail, recordFunc_t func, void *data) {
+    unsigned int pos = (unsigned int)SDL_AtomicGet(tail);
+    int count = 0;
+
+    for(;;) {
+        logRecord_t *record = &records[pos & (LOG_MAX_RECORDS-1)];
+
+        if((unsigned int)SDL_AtomicGet(&record->sequence) != pos + 1) {
+            break;
+        }
+
+        SDL_MemoryBarrierAcquire();
+        func(this, record, data);
+
+        SDL_AtomicSet(tail, (int)++pos);
+        count++;
+    }
+
+    return count;
+}
+
+//
+// kexLogger::DrainConsole
+//
+// Main thread only
+//
+
+void kexLogger::DrainConsole(void) {
+    int numDropped;
+
+    if(bDrainingConsole || SDL_AtomicGet(&state) == LOG_OFF) {
+        return;
+    }
+
+    bDrainingConsole = true;
+
+    Consume(&consoleTail, ConsoleRecord, NULL);
+
+    numDropped = SDL_AtomicGet(&dropped);
+
+    if(numDropped != consoleDropped) {
+        console.Print(COLOR_YELLOW, kva("%i log messages dropped\n", numDropped - consoleDropped));
+        consoleDropped = numDropped;
+    }
+
+    bDrainingConsole = false;
+}
+
+//
+// kexLogger::WriteFile
+//
+// Writer thread only, unless the thread has been stopped
+//
+
+void kexLogger::WriteFile(void) {
+    int numDropped;
+    int count;
+
+    count = Consume(&fileTail, FileRecord, NULL);
+    numDropped = SDL_AtomicGet(&dropped);
+
+    if(numDropped != fileDropped) {
+        fprintf(stdout, "%i log messages dropped\n", numDropped - fileDropped);
+        fileDropped = numDropped;
+        count++;
+    }
+
+    if(count) {
+        fflush(stdout);
+    }
+}
+
+//
+// kexLogger::WriteSync
+//
+
+void kexLogger::WriteSync(logRecord_t *record) {
+    WriteFileRecord(record);
+    ConsoleRecord(this, record, NULL);
+}
+
+//
+// kexLogger::WriterThread
+//
+
+int kexLogger::WriterThread(void *data) {
+    kexLogger *log = static_cast<kexLogger*>(data);
+
+    while(!SDL_AtomicGet(&log->bQuit)) {
+        SDL_SemWaitTimeout(log->sem, 100);
+        log->WriteFile();
+    }
+
+    log->WriteFile();
+    return 0;
+}
+
+//
+// kexLogger::ConsoleRecord
+//
+
+void kexLogger::ConsoleRecord(kexLogger *logger, logRecord_t *record, void *data) {
+    if(!(record->flags & LRF_NOCONSOLE)) {
+        console.Print(record->color, record->text);
+    }
+
+#ifdef _WIN32
+    Sys_Printf(record->text);
+#endif
+}
+
+//
+// kexLogger::FileRecord
+//
+
+void kexLogger::FileRecord(kexLogger *logger, logRecord_t *record, void *data) {
+    WriteFileRecord(record);
+}
+
+//
+// kexLogger::WriteFileRecord
+//
+
+void kexLogger::WriteFileRecord(logRecord_t *record) {
+    char timeStamp[64];
+    time_t copy;
+    struct tm *local;
+
+    copy = (time_t)record->time;
+    local = localtime(&copy);
+    strftime(timeStamp, sizeof(timeStamp), "%X", local);
+
+    fprintf(stdout, "%s: [%s/%s] %s", timeStamp,
+        severityNames[record->severity],
+        channelNames[record->channel],
+        record->text);
+}
+
+//
+// STRESS TEST
+//
+// A private logger with no outputs is hammered from several threads
+// while the test reads both tails itself. Every message carries its
+// thread and sequence number plus a payload derived from both, so a
+// torn, reordered or lost record is caught on either reader
+//
+
+#define LOG_TEST_MAX_THREADS    64
+
+typedef struct {
+    kexLogger       *log;
+    SDL_atomic_t    *start;
+    SDL_atomic_t    *finished;
+    int             thread;
+    int             numMessages;
+    int             accepted;
+} logTestThread_t;
+
+typedef struct {
+    int             numThreads;
+    int             lastSeq[LOG_TEST_MAX_THREADS];
+    int             received[LOG_TEST_MAX_THREADS];
+    int             errors;
+} logTestReader_t;
+
+//
+// LogTest_Payload
+//
+
+static char LogTest_Payload(const int thread, const int seq, const int i) {
+    return 'a' + ((thread * 7 + seq + i) % 26);
+}
+
+//
+// LogTest_Producer
+//
+
+static int LogTest_Producer(void *data) {
+    logTestThread_t *t = static_cast<logTestThread_t*>(data);
+    char text[LOG_MAX_LENGTH];
+
+    while(!SDL_AtomicGet(t->start)) {
+        SDL_Delay(0);
+    }
+
+    for(int seq = 0; seq < t->numMessages; seq++) {
+        int len = sprintf(text, "%03d %08d ", t->thread, seq);
+        int payload = (seq * 13 + t->thread) % 200;
+
+        for(int i = 0; i < payload; i++) {
+            text[len++] = LogTest_Payload(t->thread, seq, i);
+        }
+
+        text[len++] = '\n';
+        text[len] = 0;
+
+        if(t->log->Post((logChannel_t)(t->thread % LC_NUMCHANNELS), LS_DEBUG,
+                        COLOR_WHITE, 0, text)) {
+            t->accepted++;
+        }
+
+        // give the reader a chance to keep up now and then
+        if((seq & 63) == 63) {
+            SDL_Delay(0);
+        }
+    }
+
+    SDL_AtomicIncRef(t->finished);
+    return 0;
+}
+
+//
+// LogTest_Check
+//
+
+static void LogTest_Check(kexLogger *logger, logRecord_t *record, void *data) {
+    logTestReader_t *reader = static_cast<logTestReader_t*>(data);
+    int thread;
+    int seq;
+    int payload;
+    int len;
+    int i;
+
+    if(sscanf(record->text, "%d %d ", &thread, &seq) != 2 ||
+        thread < 0 || thread >= reader->numThreads) {
+        reader->errors++;
+        return;
+    }
+
+    // a thread's messages must arrive in the order they were posted
+    if(seq <= reader->lastSeq[thread] || record->channel != thread % LC_NUMCHANNELS) {
+        reader->errors++;
+    }
+
+    reader->lastSeq[thread] = seq;
+    reader->received[thread]++;
+
+    payload = (seq * 13 + thread) % 200;
+    len = 13;
+
+    for(i = 0; i < payload; i++) {
+        if(record->text[len + i] != LogTest_Payload(thread, seq, i)) {
+            reader->errors++;
+            return;
+        }
+    }
+
+    if(record->text[len + i] != '\n' || record->text[len + i + 1] != 0) {
+        reader->errors++;
+    }
+}
+
+//
+// kexLogger::StressTest
+//
+// Runs three passes: filling the ring exactly, overfilling it with no
+// reader running, and posting with both readers running concurrently
+//
+
+bool kexLogger::StressTest(const int numThreads, const int numMessages) {
+    logTestThread_t threads[LOG_TEST_MAX_THREADS];
+    SDL_Thread *handles[LOG_TEST_MAX_THREADS];
+    logTestReader_t readers[2];
+    SDL_atomic_t start;
+    SDL_atomic_t finished;
+    kexLogger *log;
+    bool bOk = true;
+    int pass;
+    int i;
+
+    if(numThreads <= 0 || numThreads > LOG_TEST_MAX_THREADS || numMessages <= 0) {
+        common.Warning("logstresstest: 1 to %i threads\n", LOG_TEST_MAX_THREADS);
+        return false;
+    }
+
+    log = (kexLogger*)Mem_Calloc(sizeof(kexLogger), hb_static);
+
+    for(pass = 0; pass < 3; pass++) {
+        int perThread;
+        int total = 0;
+        int accepted = 0;
+        int failed = 0;
+        int numDropped;
+
+        switch(pass) {
+        case 0:
+            perThread = LOG_MAX_RECORDS / numThreads;
+            break;
+        case 1:
+            perThread = (LOG_MAX_RECORDS * 2) / numThreads + 1;
+            break;
+        default:
+            perThread = numMessages;
+            break;
+        }
+
+        memset(log, 0, sizeof(kexLogger));
+        log->bTest = true;
+        log->mainThread = SDL_ThreadID();
+        SDL_AtomicSet(&log->state, LOG_RUNNING);
+
+        memset(readers, 0, sizeof(readers));
+        SDL_AtomicSet(&start, 0);
+        SDL_AtomicSet(&finished, 0);
+
+        for(i = 0; i < 2; i++) {
+            readers[i].numThreads = numThreads;
+
+            for(int j = 0; j < numThreads; j++) {
+                readers[i].lastSeq[j] = -1;
+            }
+        }
+
+        for(i = 0; i < numThreads; i++) {
+            threads[i].log = log;
+            threads[i].start = &start;
+            threads[i].finished = &finished;
+            threads[i].thread = i;
+            threads[i].numMessages = perThread;
+            threads[i].accepted = 0;
+
+            handles[i] = SDL_CreateThread(LogTest_Producer, "logTest", &threads[i]);
+            total += perThread;
+        }
+
+        SDL_AtomicSet(&start, 1);
+
+        // only the last pass reads while the producers are running
+        if(pass == 2) {
+            while(SDL_AtomicGet(&finished) < numThreads) {
+                log->Consume(&log->consoleTail, LogTest_Check, &readers[0]);
+                log->Consume(&log->fileTail, LogTest_Check, &readers[1]);
+            }
+        }
+
+        for(i = 0; i < numThreads; i++) {
+            SDL_WaitThread(handles[i], NULL);
+            accepted += threads[i].accepted;
+        }
+
+        log->Consume(&log->consoleTail, LogTest_Check, &readers[0]);
+        log->Consume(&log->fileTail, LogTest_Check, &readers[1]);
+
+        numDropped = log->Dropped();
+
+        for(i = 0; i < 2; i++) {
+            failed += readers[i].errors;
+
+            for(int j = 0; j < numThreads; j++) {
+                if(readers[i].received[j] != threads[j].accepted) {
+                    failed++;
+                }
+            }
+        }
+
+        if(accepted + numDropped != total) {
+            failed++;
+        }
+
+        // nothing may be dropped until the ring is actually full
+        if(pass == 0 && numDropped != 0) {
+            failed++;
+        }
+        if(pass == 1 && accepted != LOG_MAX_RECORDS) {
+            failed++;
+        }
+
+        common.CPrintf(failed ? COLOR_RED : COLOR_GREEN,
+            "logstresstest pass %i: %i posted, %i accepted, %i dropped, %i errors\n",
+            pass, total, accepted, numDropped, failed);
+
+        if(failed) {
+            bOk = false;
+        }
+    }
+
+    Mem_Free(log);
+    return bOk;
+}
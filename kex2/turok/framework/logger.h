@@ -0,0 +1,129 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __LOGGER_H__
+#define __LOGGER_H__
+
+#define LOG_MAX_RECORDS     512     // must be a power of two
+#define LOG_MAX_LENGTH      2048
+
+typedef enum {
+    LS_DEBUG    = 0,
+    LS_INFO,
+    LS_WARNING,
+    LS_ERROR,
+    LS_NUMSEVERITIES
+} logSeverity_t;
+
+typedef enum {
+    LC_GENERAL  = 0,
+    LC_SYSTEM,
+    LC_SCRIPT,
+    LC_GAME,
+    LC_RENDER,
+    LC_SOUND,
+    LC_NUMCHANNELS
+} logChannel_t;
+
+typedef enum {
+    LRF_NOCONSOLE   = 1     // only goes to the log file
+} logRecordFlags_t;
+
+typedef struct {
+    SDL_atomic_t    sequence;   // ring position + 1 once published
+    unsigned int    time;
+    byte            severity;
+    byte            channel;
+    byte            flags;
+    rcolor          color;
+    char            text[LOG_MAX_LENGTH];
+} logRecord_t;
+
+//
+// kexLogger - every message is formatted by the thread that posts it
+// and copied whole into a fixed ring of records, so producers never
+// share a format buffer. the ring has two readers: a background thread
+// that writes the log file and the main thread which feeds the console.
+// a record is only recycled once both have read it. when the ring is
+// full the message is dropped and counted instead of blocking the
+// caller. a zeroed logger is valid and writes synchronously until Init
+//
+
+class kexLogger {
+public:
+    void                    Init(void);
+    void                    Shutdown(void);
+    bool                    Post(const logChannel_t channel, const logSeverity_t severity,
+                                 const rcolor color, const int flags, const char *text);
+    bool                    Printf(const logChannel_t channel, const logSeverity_t severity,
+                                   const rcolor color, const char *string, ...);
+    bool                    VPrintf(const logChannel_t channel, const logSeverity_t severity,
+                                    const rcolor color, const int flags,
+                                    const char *string, va_list va);
+    void                    DrainConsole(void);
+
+    const int               Dropped(void) { return SDL_AtomicGet(&dropped); }
+    const bool              IsRunning(void) { return SDL_AtomicGet(&state) == LOG_RUNNING; }
+
+    static const char       *channelNames[LC_NUMCHANNELS];
+    static const char       *severityNames[LS_NUMSEVERITIES];
+
+    static bool             StressTest(const int numThreads, const int numMessages);
+
+private:
+    enum {
+        LOG_OFF     = 0,
+        LOG_RUNNING,
+        LOG_STOPPED
+    };
+
+    typedef void            (*recordFunc_t)(kexLogger *logger, logRecord_t *record, void *data);
+
+    int                     Consume(SDL_atomic_t *tail, recordFunc_t func, void *data);
+    void                    WriteFile(void);
+    void                    WriteSync(logRecord_t *record);
+    bool                    IsMainThread(void);
+
+    static int              WriterThread(void *data);
+    static void             ConsoleRecord(kexLogger *logger, logRecord_t *record, void *data);
+    static void             FileRecord(kexLogger *logger, logRecord_t *record, void *data);
+    static void             WriteFileRecord(logRecord_t *record);
+
+    logRecord_t             records[LOG_MAX_RECORDS];
+    SDL_atomic_t            head;
+    SDL_atomic_t            consoleTail;
+    SDL_atomic_t            fileTail;
+    SDL_atomic_t            dropped;
+    SDL_atomic_t            state;
+    SDL_atomic_t            bQuit;
+    int                     consoleDropped;
+    int                     fileDropped;
+    bool                    bDrainingConsole;
+    bool                    bTest;
+    SDL_threadID            mainThread;
+    SDL_Thread              *thread;
+    SDL_sem                 *sem;
+};
+
+extern kexLogger logger;
+
+#endif
@@ -22,6 +22,17 @@
 //
 // DESCRIPTION: Memory Heap Management
 //
+// Any thread may allocate and free. Each heap block's list is guarded
+// by its own lock, which is only held while a block is linked in or
+// out. Small blocks are rounded up to a size class and recycled through
+// a cache owned by the thread that first allocated them. A thread that
+// frees another thread's block pushes it onto the owner's remote list
+// without locking, and the owner takes it back on its next allocation.
+//
+// While profiling, every block also holds the index of the record for
+// the call site that allocated it, which keeps live and peak totals per
+// site. The index fills what was padding, so the header doesn't grow.
+//
 //-----------------------------------------------------------------------------
 
 #include <assert.h>
@@ -37,10 +48,27 @@
 int kexHeap::numHeapBlocks = 0;
 int kexHeap::currentHeapBlockID = -1;
 bool kexHeap::bDrawHeapInfo = false;
+bool kexHeap::bProfiling = false;
 
 kexHeapBlock *kexHeap::currentHeapBlock = NULL;
 kexHeapBlock *kexHeap::blockList = NULL;
 
+SDL_atomic_t kexHeap::cacheTLS = { 0 };
+SDL_SpinLock kexHeap::cacheLock = 0;
+heapCache_t *kexHeap::cacheList = NULL;
+SDL_atomic_t kexHeap::cachedBytes = { 0 };
+SDL_SpinLock kexHeap::siteLock = 0;
+memSite_t *kexHeap::siteHash[HEAP_SITE_HASH];
+memSite_t *kexHeap::siteList[HEAP_MAX_SITES];
+int kexHeap::numSites = 0;
+
+// keeps the data 16 byte aligned whatever the header holds
+#define HEAP_HEADER_SIZE    ((sizeof(memBlock_t) + 15) & ~15)
+
+#define HEAP_CLASS_SIZE(c)  (1 << (HEAP_MIN_CLASS + (c)))
+#define HEAP_TEST_SLOTS     256
+#define HEAP_TEST_THREADS   32
+
 //
 // common heap block types
 //
@@ -57,6 +85,131 @@ COMMAND(statheap) {
     kexHeap::bDrawHeapInfo ^= 1;
 }
 
+//
+// heapstresstest
+//
+
+COMMAND(heapstresstest) {
+    int numThreads = 8;
+    int numIterations = 100000;
+
+    if(command.GetArgc() >= 2) {
+        numThreads = atoi(command.GetArgv(1));
+    }
+    if(command.GetArgc() >= 3) {
+        numIterations = atoi(command.GetArgv(2));
+    }
+
+    kexHeap::StressTest(numThreads, numIterations);
+}
+
+//
+// memprofile
+//
+
+COMMAND(memprofile) {
+    if(command.GetArgc() >= 2) {
+        kexHeap::bProfiling = (atoi(command.GetArgv(1)) != 0);
+    }
+    else {
+        kexHeap::bProfiling ^= 1;
+    }
+
+    common.Printf("allocation profiling %s\n", kexHeap::bProfiling ? "on" : "off");
+}
+
+//
+// memreport
+//
+
+COMMAND(memreport) {
+    kexHeapBlock *heapBlock = NULL;
+    int top = 20;
+    int arg = 1;
+
+    if(!kexHeap::bProfiling) {
+        common.Printf("allocation profiling is off, turn it on with memprofile\n");
+    }
+
+    if(command.GetArgc() > arg && !isdigit(command.GetArgv(arg)[0])) {
+        for(heapBlock = kexHeap::blockList; heapBlock; heapBlock = heapBlock->next) {
+            if(!strcmp(heapBlock->name, command.GetArgv(arg))) {
+                break;
+            }
+        }
+
+        if(heapBlock == NULL) {
+            common.Warning("memreport: no heap block named %s\n", command.GetArgv(arg));
+            return;
+        }
+
+        arg++;
+    }
+
+    if(command.GetArgc() > arg) {
+        top = atoi(command.GetArgv(arg));
+    }
+
+    if(!kexHeap::PrintSites(heapBlock, top, -1)) {
+        common.Printf("no live allocations recorded\n");
+    }
+}
+
+//
+// memdiff
+//
+
+COMMAND(memdiff) {
+    int top = 20;
+
+    if(command.GetArgc() < 2) {
+        common.Printf("memdiff <begin | end> [top N]\n");
+        return;
+    }
+
+    if(!strcmp(command.GetArgv(1), "begin")) {
+        if(!kexHeap::bProfiling) {
+            common.Printf("allocation profiling is off, turn it on with memprofile\n");
+        }
+
+        kexHeap::MarkSites(HM_DIFF);
+        return;
+    }
+
+    if(command.GetArgc() >= 3) {
+        top = atoi(command.GetArgv(2));
+    }
+
+    if(!kexHeap::PrintSites(NULL, top, HM_DIFF)) {
+        common.Printf("no change since memdiff begin\n");
+    }
+}
+
+//
+// testmemprofile
+//
+
+COMMAND(testmemprofile) {
+    bool bOk = kexHeap::TestProfile();
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testmemprofile %s\n", bOk ? "passed" : "failed");
+}
+
+//
+// Heap_SizeClass
+//
+// Returns -1 for sizes too large to be cached
+//
+
+static int Heap_SizeClass(const int size) {
+    for(int i = 0; i < HEAP_NUM_CLASSES; i++) {
+        if(size <= HEAP_CLASS_SIZE(i)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 //
 // kexHeapBlock::kexHeapBlock
 //
@@ -70,6 +223,9 @@ kexHeapBlock::kexHeapBlock(const char *name, bool bGarbageCollect,
     this->bGC           = bGarbageCollect;
     this->purgeID       = kexHeap::numHeapBlocks++;
     this->numAllocated  = 0;
+    this->numBlocks     = 0;
+    this->usage         = 0;
+    this->lock          = 0;
 
     // add heap block to main block list
     if(kexHeap::blockList) {
@@ -130,6 +286,8 @@ kexHeapBlock *kexHeapBlock::operator[](int index) {
 //
 // kexHeap::AddBlock
 //
+// The heap block's lock must be held
+//
 
 void kexHeap::AddBlock(memBlock_t *block, kexHeapBlock *heapBlock) {
     block->prev = NULL;
@@ -143,13 +301,28 @@ void kexHeap::AddBlock(memBlock_t *block, kexHeapBlock *heapBlock) {
     }
 
     heapBlock->numAllocated++;
+    heapBlock->numBlocks++;
+    heapBlock->usage += block->size;
+
+    if(block->site) {
+        kexHeap::ProfileAdd(block);
+    }
 }
 
 //
 // kexHeap::RemoveBlock
 //
+// The heap block's lock must be held
+//
 
 void kexHeap::RemoveBlock(memBlock_t *block) {
+    block->heapBlock->numBlocks--;
+    block->heapBlock->usage -= block->size;
+
+    if(block->site) {
+        kexHeap::ProfileRemove(block);
+    }
+
     if(block->prev == NULL) {
         block->heapBlock->blocks = block->next;
     }
@@ -171,7 +344,7 @@ void kexHeap::RemoveBlock(memBlock_t *block) {
 memBlock_t *kexHeap::GetBlock(void *ptr, const char *file, int line) {
     memBlock_t* block;
 
-    block = (memBlock_t*)((byte*)ptr - sizeof(memBlock_t));
+    block = (memBlock_t*)((byte*)ptr - HEAP_HEADER_SIZE);
 
     if(block->heapTag != kexHeap::HeapTag) {
         common.Error("kexHeap::GetBlock: found a pointer without heap tag (%s:%d)", file, line);
@@ -180,32 +353,244 @@ memBlock_t *kexHeap::GetBlock(void *ptr, const char *file, int line) {
     return block;
 }
 
+//
+// kexHeap::ThreadCache
+//
+// Returns the calling thread's cache, handing it one on the first call.
+// Returns NULL if thread local storage isn't available, in which case
+// nothing is cached
+//
+
+heapCache_t *kexHeap::ThreadCache(void) {
+    heapCache_t *cache;
+    SDL_TLSID id;
+
+    if((id = SDL_AtomicGet(&cacheTLS)) == 0) {
+        SDL_AtomicLock(&cacheLock);
+        if((id = SDL_AtomicGet(&cacheTLS)) == 0) {
+            id = SDL_TLSCreate();
+            SDL_AtomicSet(&cacheTLS, id);
+        }
+        SDL_AtomicUnlock(&cacheLock);
+
+        if(id == 0) {
+            return NULL;
+        }
+    }
+
+    if((cache = (heapCache_t*)SDL_TLSGet(id))) {
+        return cache;
+    }
+
+    SDL_AtomicLock(&cacheLock);
+
+    // take over one left behind by a thread that has exited
+    for(cache = cacheList; cache != NULL; cache = cache->next) {
+        if(!cache->bInUse) {
+            break;
+        }
+    }
+
+    if(cache == NULL && (cache = (heapCache_t*)calloc(1, sizeof(heapCache_t)))) {
+        cache->next = cacheList;
+        cacheList = cache;
+    }
+
+    if(cache) {
+        cache->bInUse = true;
+    }
+
+    SDL_AtomicUnlock(&cacheLock);
+
+    if(cache) {
+        SDL_TLSSet(id, cache, kexHeap::ReleaseCache);
+    }
+
+    return cache;
+}
+
+//
+// kexHeap::CollectRemote
+//
+// Takes back the blocks other threads have freed
+//
+
+void kexHeap::CollectRemote(heapCache_t *cache) {
+    memBlock_t *block;
+    memBlock_t *next;
+    int c;
+
+    if(SDL_AtomicGetPtr(&cache->remote) == NULL) {
+        return;
+    }
+
+    block = (memBlock_t*)SDL_AtomicSetPtr(&cache->remote, (void*)NULL);
+
+    for(; block != NULL; block = next) {
+        next = block->next;
+        c = block->sizeClass;
+
+        if(cache->numFree[c] >= HEAP_CACHE_DEPTH) {
+            SDL_AtomicAdd(&cachedBytes, -HEAP_CLASS_SIZE(c));
+            free(block);
+            continue;
+        }
+
+        block->next = cache->freeBlocks[c];
+        cache->freeBlocks[c] = block;
+        cache->numFree[c]++;
+    }
+}
+
+//
+// kexHeap::FlushCache
+//
+// Gives every free block in a cache back to the system
+//
+
+void kexHeap::FlushCache(heapCache_t *cache) {
+    memBlock_t *block;
+    memBlock_t *next;
+
+    for(int i = 0; i < HEAP_NUM_CLASSES; i++) {
+        for(block = cache->freeBlocks[i]; block != NULL; block = next) {
+            next = block->next;
+            free(block);
+        }
+
+        SDL_AtomicAdd(&cachedBytes, -(cache->numFree[i] * HEAP_CLASS_SIZE(i)));
+
+        cache->freeBlocks[i] = NULL;
+        cache->numFree[i] = 0;
+    }
+}
+
+//
+// kexHeap::ReleaseCache
+//
+// Called when a thread exits. Anything freed into the cache after this
+// waits on the remote list for the next thread that takes it over
+//
+
+void kexHeap::ReleaseCache(void *data) {
+    heapCache_t *cache = (heapCache_t*)data;
+
+    kexHeap::CollectRemote(cache);
+    kexHeap::FlushCache(cache);
+
+    SDL_AtomicLock(&cacheLock);
+    cache->bInUse = false;
+    SDL_AtomicUnlock(&cacheLock);
+}
+
+//
+// kexHeap::AllocBlock
+//
+
+memBlock_t *kexHeap::AllocBlock(int size, const char *file, int line) {
+    heapCache_t *cache;
+    memBlock_t *block;
+    int c;
+
+    cache = NULL;
+
+    if((c = Heap_SizeClass(size)) != -1 && (cache = kexHeap::ThreadCache())) {
+        kexHeap::CollectRemote(cache);
+
+        if((block = cache->freeBlocks[c])) {
+            cache->freeBlocks[c] = block->next;
+            cache->numFree[c]--;
+            SDL_AtomicAdd(&cachedBytes, -HEAP_CLASS_SIZE(c));
+            return block;
+        }
+
+        size = HEAP_CLASS_SIZE(c);
+    }
+
+    if(!(block = (memBlock_t*)malloc(HEAP_HEADER_SIZE + size))) {
+        common.Error("kexHeap::Malloc: failed on allocation of %u bytes (%s:%d)", size, file, line);
+    }
+
+    block->sizeClass = cache ? c : -1;
+    block->owner = cache;
+
+    return block;
+}
+
+//
+// kexHeap::ReleaseBlock
+//
+// The block must already be unlinked from its heap block
+//
+
+void kexHeap::ReleaseBlock(memBlock_t *block) {
+    heapCache_t *owner;
+    heapCache_t *cache;
+    void *head;
+    int c;
+
+    // catches the block being freed again
+    block->heapTag = 0;
+
+    if(!(owner = block->owner)) {
+        free(block);
+        return;
+    }
+
+    c = block->sizeClass;
+    cache = kexHeap::ThreadCache();
+
+    if(owner == cache) {
+        if(cache->numFree[c] >= HEAP_CACHE_DEPTH) {
+            free(block);
+            return;
+        }
+
+        block->next = cache->freeBlocks[c];
+        cache->freeBlocks[c] = block;
+        cache->numFree[c]++;
+        SDL_AtomicAdd(&cachedBytes, HEAP_CLASS_SIZE(c));
+        return;
+    }
+
+    SDL_AtomicAdd(&cachedBytes, HEAP_CLASS_SIZE(c));
+
+    do {
+        head = SDL_AtomicGetPtr(&owner->remote);
+        block->next = (memBlock_t*)head;
+    } while(!SDL_AtomicCASPtr(&owner->remote, head, block));
+}
+
 //
 // kexHeap::Malloc
 //
 
 void *kexHeap::Malloc(int size, kexHeapBlock &heapBlock, const char *file, int line) {
     memBlock_t *newblock;
+    memSite_t *site;
 
     assert(size > 0);
 
-    newblock = NULL;
-
-    if(!(newblock = (memBlock_t*)malloc(sizeof(memBlock_t) + size))) {
-        common.Error("kexHeap::Malloc: failed on allocation of %u bytes (%s:%d)", size, file, line);
-    }
+    newblock = kexHeap::AllocBlock(size, file, line);
 
     newblock->purgeID = heapBlock.purgeID;
     newblock->heapTag = kexHeap::HeapTag;
     newblock->size = size;
     newblock->ptrRef = NULL;
+    newblock->site = 0;
+
+    if(bProfiling && (site = kexHeap::FindSite(file, line, &heapBlock, true))) {
+        newblock->site = site->index;
+    }
 #if 0
     newblock->ms = sysMain.GetMS();
 #endif
 
+    SDL_AtomicLock(&heapBlock.lock);
     kexHeap::AddBlock(newblock, &heapBlock);
+    SDL_AtomicUnlock(&heapBlock.lock);
 
-    return ((byte*)newblock) + sizeof(memBlock_t);
+    return ((byte*)newblock) + HEAP_HEADER_SIZE;
 }
 
 //
@@ -223,6 +608,9 @@ void *kexHeap::Calloc(int size, kexHeapBlock &heapBlock, const char *file, int l
 void *kexHeap::Realloc(void *ptr, int size, kexHeapBlock &heapBlock, const char *file, int line) {
     memBlock_t *block;
     memBlock_t *newblock;
+    kexHeapBlock *oldHeapBlock;
+    memSite_t *site;
+    int c;
 
     if(!ptr) {
         return kexHeap::Malloc(size, heapBlock, file, line);
@@ -237,6 +625,9 @@ void *kexHeap::Realloc(void *ptr, int size, kexHeapBlock &heapBlock, const char
 
     block = kexHeap::GetBlock(ptr, file, line);
     newblock = NULL;
+    oldHeapBlock = block->heapBlock;
+
+    SDL_AtomicLock(&oldHeapBlock->lock);
 
     kexHeap::RemoveBlock(block);
 
@@ -247,21 +638,43 @@ void *kexHeap::Realloc(void *ptr, int size, kexHeapBlock &heapBlock, const char
         *block->ptrRef = NULL;
     }
 
-    if(!(newblock = (memBlock_t*)realloc(block, sizeof(memBlock_t) + size))) {
-        common.Error("kexHeap::Realloc: failed on allocation of %u bytes (%s:%d)", size, file, line);
+    SDL_AtomicUnlock(&oldHeapBlock->lock);
+
+    c = Heap_SizeClass(size);
+
+    if(block->owner == NULL && c == -1) {
+        if(!(newblock = (memBlock_t*)realloc(block, HEAP_HEADER_SIZE + size))) {
+            common.Error("kexHeap::Realloc: failed on allocation of %u bytes (%s:%d)", size, file, line);
+        }
+    }
+    else if(block->owner != NULL && c == block->sizeClass) {
+        // still fits its size class
+        newblock = block;
+    }
+    else {
+        newblock = kexHeap::AllocBlock(size, file, line);
+        memcpy((byte*)newblock + HEAP_HEADER_SIZE, ptr, block->size < size ? block->size : size);
+        kexHeap::ReleaseBlock(block);
     }
 
     newblock->purgeID = heapBlock.purgeID;
     newblock->heapTag = kexHeap::HeapTag;
     newblock->size = size;
     newblock->ptrRef = NULL;
+    newblock->site = 0;
+
+    if(bProfiling && (site = kexHeap::FindSite(file, line, &heapBlock, true))) {
+        newblock->site = site->index;
+    }
 #if 0
     newblock->ms = sysMain.GetMS();
 #endif
 
+    SDL_AtomicLock(&heapBlock.lock);
     kexHeap::AddBlock(newblock, &heapBlock);
+    SDL_AtomicUnlock(&heapBlock.lock);
 
-    return ((byte*)newblock) + sizeof(memBlock_t);
+    return ((byte*)newblock) + HEAP_HEADER_SIZE;
 }
 
 //
@@ -278,6 +691,7 @@ void *kexHeap::Alloca(int size, const char *file, int line) {
 
 void kexHeap::Free(void *ptr, const char *file, int line) {
     memBlock_t* block;
+    kexHeapBlock *heapBlock;
 
     block = kexHeap::GetBlock(ptr, file, line);
 
@@ -285,14 +699,19 @@ void kexHeap::Free(void *ptr, const char *file, int line) {
         common.Error("kexHeap::Free: Freeing without heap tag (%s:%d)", file, line);
     }
 
+    heapBlock = block->heapBlock;
+    SDL_AtomicLock(&heapBlock->lock);
+
     if(block->ptrRef) {
         *block->ptrRef = NULL;
     }
 
     kexHeap::RemoveBlock(block);
 
-    // free back to system
-    free(block);
+    SDL_AtomicUnlock(&heapBlock->lock);
+
+    // back to the thread cache or the system
+    kexHeap::ReleaseBlock(block);
 }
 
 //
@@ -303,9 +722,9 @@ void kexHeap::Purge(kexHeapBlock &heapBlock, const char *file, int line) {
     memBlock_t *block;
     memBlock_t *next;
 
-    for(block = heapBlock.blocks; block != NULL;) {
-        next = block->next;
+    SDL_AtomicLock(&heapBlock.lock);
 
+    for(block = heapBlock.blocks; block != NULL; block = block->next) {
         if(block->heapTag != kexHeap::HeapTag) {
             common.Error("kexHeap::Purge: Purging without heap tag (%s:%d)", file, line);
         }
@@ -314,11 +733,25 @@ void kexHeap::Purge(kexHeapBlock &heapBlock, const char *file, int line) {
             *block->ptrRef = NULL;
         }
 
-        free(block);
-        block = next;
+        if(block->site) {
+            kexHeap::ProfileRemove(block);
+        }
+
+        block->heapBlock = NULL;
     }
 
+    block = heapBlock.blocks;
+
     heapBlock.blocks = NULL;
+    heapBlock.numBlocks = 0;
+    heapBlock.usage = 0;
+
+    SDL_AtomicUnlock(&heapBlock.lock);
+
+    for(; block != NULL; block = next) {
+        next = block->next;
+        kexHeap::ReleaseBlock(block);
+    }
 }
 
 //
@@ -326,7 +759,12 @@ void kexHeap::Purge(kexHeapBlock &heapBlock, const char *file, int line) {
 //
 
 void kexHeap::SetCacheRef(void **ptr, const char *file, int line) {
-    kexHeap::GetBlock(*ptr, file, line)->ptrRef = ptr;
+    memBlock_t *block = kexHeap::GetBlock(*ptr, file, line);
+    kexHeapBlock *heapBlock = block->heapBlock;
+
+    SDL_AtomicLock(&heapBlock->lock);
+    block->ptrRef = ptr;
+    SDL_AtomicUnlock(&heapBlock->lock);
 }
 
 //
@@ -351,7 +789,7 @@ void kexHeap::GarbageCollect(const char *file, int line) {
 
                 kexHeap::RemoveBlock(block);
                 if(heapBlock->gcFunc) {
-                    heapBlock->gcFunc((byte*)block + sizeof(memBlock_t));
+                    heapBlock->gcFunc((byte*)block + HEAP_HEADER_SIZE);
                 }
 
                 if(block->ptrRef) {
@@ -378,9 +816,15 @@ void kexHeap::CheckBlocks(const char *file, int line) {
     memBlock_t *block;
     memBlock_t *prev;
     kexHeapBlock *heapBlock;
+    int numBlocks;
+    int usage;
 
     for(heapBlock = kexHeap::blockList; heapBlock; heapBlock = heapBlock->next) {
         prev = NULL;
+        numBlocks = 0;
+        usage = 0;
+
+        SDL_AtomicLock(&heapBlock->lock);
 
         for(block = heapBlock->blocks; block != NULL; block = block->next) {
             if(block->heapTag != kexHeap::HeapTag) {
@@ -391,7 +835,16 @@ void kexHeap::CheckBlocks(const char *file, int line) {
             }
             
             prev = block;
+            numBlocks++;
+            usage += block->size;
         }
+
+        if(numBlocks != heapBlock->numBlocks || usage != heapBlock->usage) {
+            common.Error("kexHeap::CheckBlocks: totals for %s are off (%s:%d)",
+                heapBlock->name, file, line);
+        }
+
+        SDL_AtomicUnlock(&heapBlock->lock);
     }
 }
 
@@ -413,12 +866,12 @@ void kexHeap::Touch(void *ptr, const char *file, int line) {
 //
 
 int kexHeap::Usage(const kexHeapBlock &heapBlock) {
-    int bytes = 0;
-    memBlock_t *block;
+    SDL_SpinLock *lock = const_cast<SDL_SpinLock*>(&heapBlock.lock);
+    int bytes;
 
-    for(block = heapBlock.blocks; block != NULL; block = block->next) {
-        bytes += block->size;
-    }
+    SDL_AtomicLock(lock);
+    bytes = heapBlock.usage;
+    SDL_AtomicUnlock(lock);
 
     return bytes;
 }
@@ -428,8 +881,9 @@ int kexHeap::Usage(const kexHeapBlock &heapBlock) {
 //
 
 void kexHeap::DrawHeapInfo(void) {
-    memBlock_t *block;
+    int numAllocated;
     int numBlocks;
+    int usage;
     unsigned int c;
     byte *cb;
     float y;
@@ -447,23 +901,583 @@ void kexHeap::DrawHeapInfo(void) {
         c = RGBA(0, 255, 0, 255);
         PRINT_HEAP(kva("%s", heapBlock->name), 32, y, 1, false, cb, cb);
         
-        c = RGBA(255, 255, 0, 255);
-        PRINT_HEAP(kva(": %ikb", kexHeap::Usage(*heapBlock) >> 10), 128, y, 1, false, cb, cb);
-        PRINT_HEAP(kva(" allocated: %i", heapBlock->numAllocated), 192, y, 1, false, cb, cb);
-
-        numBlocks = 0;
-        for(block = heapBlock->blocks; block != NULL; block = block->next) {
-            numBlocks++;
-        }
+        // take a consistent snapshot, other threads may be allocating
+        SDL_AtomicLock(&heapBlock->lock);
+        numAllocated = heapBlock->numAllocated;
+        numBlocks = heapBlock->numBlocks;
+        usage = heapBlock->usage;
+        heapBlock->numAllocated = numBlocks;
+        SDL_AtomicUnlock(&heapBlock->lock);
 
-        PRINT_HEAP(kva(" freed: %i", heapBlock->numAllocated - numBlocks), 320, y, 1, false, cb, cb);
+        c = RGBA(255, 255, 0, 255);
+        PRINT_HEAP(kva(": %ikb", usage >> 10), 128, y, 1, false, cb, cb);
+        PRINT_HEAP(kva(" allocated: %i", numAllocated), 192, y, 1, false, cb, cb);
+        PRINT_HEAP(kva(" freed: %i", numAllocated - numBlocks), 320, y, 1, false, cb, cb);
 
-        heapBlock->numAllocated = numBlocks;
         y += 16;
     }
+
+    c = RGBA(0, 255, 0, 255);
+    PRINT_HEAP("thread caches", 32, y, 1, false, cb, cb);
+    c = RGBA(255, 255, 0, 255);
+    PRINT_HEAP(kva(": %ikb", SDL_AtomicGet(&cachedBytes) >> 10), 128, y, 1, false, cb, cb);
+    y += 16;
     
     kexRenderUtils::debugLineNum = y;
     kexRenderUtils::AddDebugLineSpacing();
     
 #undef PRINT_HEAP
 }
+
+//
+// kexHeap::FindSite
+//
+
+memSite_t *kexHeap::FindSite(const char *file, const int line, kexHeapBlock *heapBlock,
+                             const bool bCreate) {
+    memSite_t *site;
+    unsigned int hash;
+
+    // the same header can be compiled into more than one file, so
+    // hash the name rather than the pointer
+    hash = line + heapBlock->purgeID * 31;
+
+    for(const char *c = file; *c; c++) {
+        hash = hash * 33 + *c;
+    }
+
+    hash &= (HEAP_SITE_HASH-1);
+
+    SDL_AtomicLock(&siteLock);
+
+    for(site = siteHash[hash]; site != NULL; site = site->next) {
+        if(site->line == line && site->heapBlock == heapBlock &&
+            (site->file == file || !strcmp(site->file, file))) {
+            break;
+        }
+    }
+
+    // comes from the system so it doesn't show up in its own totals.
+    // index 0 is left for blocks that have no site
+    if(site == NULL && bCreate && numSites < HEAP_MAX_SITES-1 &&
+        (site = (memSite_t*)calloc(1, sizeof(memSite_t)))) {
+        site->file = file;
+        site->line = line;
+        site->heapBlock = heapBlock;
+        site->index = ++numSites;
+        site->next = siteHash[hash];
+        siteHash[hash] = site;
+        siteList[site->index] = site;
+    }
+
+    SDL_AtomicUnlock(&siteLock);
+    return site;
+}
+
+//
+// kexHeap::ProfileAdd
+//
+
+void kexHeap::ProfileAdd(memBlock_t *block) {
+    memSite_t *site;
+
+    SDL_AtomicLock(&siteLock);
+    site = siteList[block->site];
+
+    site->liveBytes += block->size;
+    site->liveCount++;
+    site->numAllocs++;
+
+    if(site->liveBytes > site->peakBytes) {
+        site->peakBytes = site->liveBytes;
+    }
+
+    SDL_AtomicUnlock(&siteLock);
+}
+
+//
+// kexHeap::ProfileRemove
+//
+
+void kexHeap::ProfileRemove(memBlock_t *block) {
+    memSite_t *site;
+
+    SDL_AtomicLock(&siteLock);
+    site = siteList[block->site];
+
+    site->liveBytes -= block->size;
+    site->liveCount--;
+
+    SDL_AtomicUnlock(&siteLock);
+}
+
+//
+// kexHeap::MarkSites
+//
+
+void kexHeap::MarkSites(const heapMark_t mark) {
+    memSite_t *site;
+
+    SDL_AtomicLock(&siteLock);
+
+    for(int i = 0; i < HEAP_SITE_HASH; i++) {
+        for(site = siteHash[i]; site != NULL; site = site->next) {
+            site->markBytes[mark] = site->liveBytes;
+            site->markCount[mark] = site->liveCount;
+        }
+    }
+
+    SDL_AtomicUnlock(&siteLock);
+}
+
+//
+// kexHeap::GetSite
+//
+
+bool kexHeap::GetSite(const char *file, const int line, const kexHeapBlock &heapBlock,
+                      memSite_t &site) {
+    memSite_t *s;
+
+    if(!(s = kexHeap::FindSite(file, line, const_cast<kexHeapBlock*>(&heapBlock), false))) {
+        return false;
+    }
+
+    SDL_AtomicLock(&siteLock);
+    site = *s;
+    SDL_AtomicUnlock(&siteLock);
+
+    return true;
+}
+
+//
+// kexHeap::SortSites
+//
+
+int kexHeap::SortSites(const void *a, const void *b) {
+    const memSite_t *siteA = (const memSite_t*)a;
+    const memSite_t *siteB = (const memSite_t*)b;
+
+    if(siteA->liveBytes != siteB->liveBytes) {
+        return siteA->liveBytes > siteB->liveBytes ? -1 : 1;
+    }
+
+    return siteB->liveCount - siteA->liveCount;
+}
+
+//
+// kexHeap::PrintSites
+//
+// Prints the top sites of a heap block, or of every block if heapBlock
+// is NULL, by live bytes. Given a mark, only what changed since the mark
+// is shown. Returns the number of sites that had anything to show
+//
+
+int kexHeap::PrintSites(const kexHeapBlock *heapBlock, const int top, const int mark) {
+    memSite_t *sites;
+    memSite_t *site;
+    int count;
+    int max;
+
+    // copy them out first, printing allocates
+    SDL_AtomicLock(&siteLock);
+    max = numSites;
+    SDL_AtomicUnlock(&siteLock);
+
+    if(max == 0 || !(sites = (memSite_t*)malloc(sizeof(memSite_t) * max))) {
+        return 0;
+    }
+
+    count = 0;
+    SDL_AtomicLock(&siteLock);
+
+    for(int i = 0; i < HEAP_SITE_HASH; i++) {
+        for(site = siteHash[i]; site != NULL && count < max; site = site->next) {
+            if(heapBlock && site->heapBlock != heapBlock) {
+                continue;
+            }
+
+            sites[count] = *site;
+
+            if(mark >= 0) {
+                sites[count].liveBytes -= site->markBytes[mark];
+                sites[count].liveCount -= site->markCount[mark];
+
+                if(sites[count].liveBytes == 0 && sites[count].liveCount == 0) {
+                    continue;
+                }
+            }
+            else if(site->liveCount == 0) {
+                continue;
+            }
+
+            count++;
+        }
+    }
+
+    SDL_AtomicUnlock(&siteLock);
+
+    if(count > 0) {
+        qsort(sites, count, sizeof(memSite_t), kexHeap::SortSites);
+
+        common.Printf("%10s %7s %8s %10s  %-12s %s\n", mark >= 0 ? "bytes +/-" : "bytes",
+            mark >= 0 ? "+/-" : "live", "allocs", "peak", "block", "site");
+
+        for(int i = 0; i < count && i < top; i++) {
+            site = &sites[i];
+            common.Printf("%10i %7i %8i %10i  %-12s %s:%i\n", site->liveBytes, site->liveCount,
+                site->numAllocs, site->peakBytes, site->heapBlock->name, site->file, site->line);
+        }
+
+        if(count > top) {
+            common.Printf("...and %i more\n", count - top);
+        }
+    }
+
+    free(sites);
+    return count;
+}
+
+//
+// kexHeap::TestProfile
+//
+// Runs a fixed sequence of allocations from made up call sites and
+// checks the totals recorded for each of them
+//
+
+static kexHeapBlock hb_profileTest("profile test", false, NULL, NULL);
+
+#define PROFILE_TEST_FILE   "profileTest"
+
+typedef struct {
+    int             line;
+    int             liveBytes;
+    int             liveCount;
+    int             numAllocs;
+    int             peakBytes;
+    int             diffBytes;
+} profileTestSite_t;
+
+bool kexHeap::TestProfile(void) {
+    static const profileTestSite_t expected[4] = {
+        // line     live    count   allocs  peak    diff
+        {  1,       600,    6,      10,     1000,   -400    },
+        {  2,       3000,   3,      5,      5000,   -2000   },
+        {  3,       4000,   2,      2,      4000,   4000    },
+        {  4,       0,      0,      20,     64,     0       }
+    };
+    int numAllocs[4];
+    void *a[10];
+    void *b[5];
+    memSite_t site;
+    bool bWasProfiling;
+    bool bOk = true;
+    int i;
+
+    // sites are kept for good, so allow for an earlier run
+    for(i = 0; i < 4; i++) {
+        numAllocs[i] = 0;
+
+        if(kexHeap::GetSite(PROFILE_TEST_FILE, expected[i].line, hb_profileTest, site)) {
+            numAllocs[i] = site.numAllocs;
+        }
+    }
+
+    bWasProfiling = bProfiling;
+    bProfiling = true;
+
+    for(i = 0; i < 10; i++) {
+        a[i] = kexHeap::Malloc(100, hb_profileTest, PROFILE_TEST_FILE, 1);
+    }
+    for(i = 0; i < 5; i++) {
+        b[i] = kexHeap::Calloc(1000, hb_profileTest, PROFILE_TEST_FILE, 2);
+    }
+    for(i = 0; i < 20; i++) {
+        Mem_Free(kexHeap::Malloc(64, hb_profileTest, PROFILE_TEST_FILE, 4));
+    }
+
+    kexHeap::MarkSites(HM_DIFF);
+
+    for(i = 0; i < 4; i++) {
+        Mem_Free(a[i]);
+    }
+
+    // a realloc counts against the site that did it
+    b[0] = kexHeap::Realloc(b[0], 2000, hb_profileTest, PROFILE_TEST_FILE, 3);
+    b[1] = kexHeap::Realloc(b[1], 2000, hb_profileTest, PROFILE_TEST_FILE, 3);
+
+    bProfiling = bWasProfiling;
+
+    for(i = 0; i < 4; i++) {
+        const profileTestSite_t *e = &expected[i];
+
+        if(!kexHeap::GetSite(PROFILE_TEST_FILE, e->line, hb_profileTest, site)) {
+            common.Warning("testmemprofile: site %i wasn't recorded\n", e->line);
+            bOk = false;
+            continue;
+        }
+
+        if(site.liveBytes != e->liveBytes || site.liveCount != e->liveCount ||
+            site.numAllocs - numAllocs[i] != e->numAllocs || site.peakBytes != e->peakBytes ||
+            site.liveBytes - site.markBytes[HM_DIFF] != e->diffBytes) {
+            common.Warning("testmemprofile: site %i has %i bytes in %i blocks, %i allocs, %i peak, %i since mark\n",
+                e->line, site.liveBytes, site.liveCount, site.numAllocs - numAllocs[i], site.peakBytes,
+                site.liveBytes - site.markBytes[HM_DIFF]);
+            bOk = false;
+        }
+    }
+
+    if(kexHeap::Usage(hb_profileTest) != 600 + 3000 + 4000) {
+        bOk = false;
+    }
+
+    kexHeap::PrintSites(&hb_profileTest, 4, HM_DIFF);
+
+    // profiling may be off by now, the purge still has to clear the totals
+    Mem_Purge(hb_profileTest);
+
+    for(i = 0; i < 4; i++) {
+        if(!kexHeap::GetSite(PROFILE_TEST_FILE, expected[i].line, hb_profileTest, site) ||
+            site.liveBytes != 0 || site.liveCount != 0) {
+            bOk = false;
+        }
+    }
+
+    return bOk;
+}
+
+//
+// heap stress test
+//
+
+static kexHeapBlock hb_stressA("stress a", false, NULL, NULL);
+static kexHeapBlock hb_stressB("stress b", false, NULL, NULL);
+
+typedef struct {
+    int             size;
+    int             heap;
+} heapTestHeader_t;
+
+typedef struct {
+    SDL_atomic_t    *start;
+    void            **slots;
+    unsigned int    seed;
+    int             numIterations;
+    int             errors;
+} heapTestThread_t;
+
+//
+// HeapTest_Fill
+//
+
+static void *HeapTest_Fill(void *ptr, const int size, const int heap) {
+    heapTestHeader_t *header = (heapTestHeader_t*)ptr;
+
+    memset(header + 1, size & 0xff, size - sizeof(heapTestHeader_t));
+    header->size = size;
+    header->heap = heap;
+
+    return ptr;
+}
+
+//
+// HeapTest_Check
+//
+// Checks the first length bytes of a block, or all of it if length is 0
+//
+
+static bool HeapTest_Check(void *ptr, int length) {
+    heapTestHeader_t *header = (heapTestHeader_t*)ptr;
+    byte *data = (byte*)(header + 1);
+
+    if(length == 0 || length > header->size) {
+        length = header->size;
+    }
+
+    for(int i = 0; i < length - (int)sizeof(heapTestHeader_t); i++) {
+        if(data[i] != (header->size & 0xff)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// HeapTest_Thread
+//
+// Blocks pass between threads through the shared slots, so most of
+// them end up freed or reallocated by a thread that didn't allocate them
+//
+
+static int HeapTest_Thread(void *data) {
+    heapTestThread_t *thread = (heapTestThread_t*)data;
+    kexHeapBlock *heaps[2] = { &hb_stressA, &hb_stressB };
+    unsigned int r;
+    void *ptr;
+    void *old;
+    int size;
+    int newSize;
+    int heap;
+    int slot;
+
+    while(SDL_AtomicGet(thread->start) == 0) {
+        SDL_Delay(0);
+    }
+
+    for(int i = 0; i < thread->numIterations; i++) {
+        thread->seed = thread->seed * 1103515245 + 12345;
+        r = thread->seed >> 8;
+
+        // mostly cached sizes, with the odd large one
+        size = sizeof(heapTestHeader_t) + ((r & 7) == 0 ? (r >> 3) % 16384 : (r >> 3) % 2048);
+        heap = (r >> 4) & 1;
+        slot = (r >> 5) % HEAP_TEST_SLOTS;
+        old = NULL;
+
+        switch((r >> 16) & 7) {
+        case 0:
+            // allocated and freed on the same thread
+            ptr = HeapTest_Fill(Mem_Malloc(size, *heaps[heap]), size, heap);
+            if(!HeapTest_Check(ptr, 0)) {
+                thread->errors++;
+            }
+            Mem_Free(ptr);
+            break;
+        case 1:
+        case 2:
+            // take a block and free it
+            old = SDL_AtomicSetPtr(&thread->slots[slot], (void*)NULL);
+            break;
+        case 3:
+            // take a block, grow or shrink it, possibly into the other heap
+            if(!(ptr = SDL_AtomicSetPtr(&thread->slots[slot], (void*)NULL))) {
+                break;
+            }
+            if(!HeapTest_Check(ptr, 0)) {
+                thread->errors++;
+            }
+            size = ((heapTestHeader_t*)ptr)->size;
+            newSize = (r >> 3) & 1 ? size + 64 :
+                sizeof(heapTestHeader_t) + (size - sizeof(heapTestHeader_t)) / 2;
+            ptr = Mem_Realloc(ptr, newSize, *heaps[heap]);
+            // the contents have to survive up to the smaller size
+            if(!HeapTest_Check(ptr, newSize < size ? newSize : size)) {
+                thread->errors++;
+            }
+            size = newSize;
+            old = SDL_AtomicSetPtr(&thread->slots[slot], HeapTest_Fill(ptr, size, heap));
+            break;
+        default:
+            // hand a new block to whichever thread finds it
+            ptr = HeapTest_Fill(Mem_Calloc(size, *heaps[heap]), size, heap);
+            old = SDL_AtomicSetPtr(&thread->slots[slot], ptr);
+            break;
+        }
+
+        if(old) {
+            if(!HeapTest_Check(old, 0)) {
+                thread->errors++;
+            }
+            Mem_Free(old);
+        }
+    }
+
+    return 0;
+}
+
+//
+// kexHeap::StressTest
+//
+// Runs the threads, then checks that each heap block's totals match the
+// blocks left in the slots and that purging leaves nothing behind
+//
+
+bool kexHeap::StressTest(const int numThreads, const int numIterations) {
+    heapTestThread_t threads[HEAP_TEST_THREADS];
+    SDL_Thread *handles[HEAP_TEST_THREADS];
+    kexHeapBlock *heaps[2] = { &hb_stressA, &hb_stressB };
+    void *slots[HEAP_TEST_SLOTS];
+    int usage[2] = { 0, 0 };
+    int count[2] = { 0, 0 };
+    SDL_atomic_t start;
+    int errors = 0;
+    int time;
+    bool bOk = true;
+    int i;
+
+    if(numThreads <= 0 || numThreads > HEAP_TEST_THREADS || numIterations <= 0) {
+        common.Warning("heapstresstest: 1 to %i threads\n", HEAP_TEST_THREADS);
+        return false;
+    }
+
+    memset(slots, 0, sizeof(slots));
+    SDL_AtomicSet(&start, 0);
+
+    for(i = 0; i < numThreads; i++) {
+        threads[i].start = &start;
+        threads[i].slots = slots;
+        threads[i].seed = 0x9e3779b9 * (i + 1);
+        threads[i].numIterations = numIterations;
+        threads[i].errors = 0;
+
+        handles[i] = SDL_CreateThread(HeapTest_Thread, "heapTest", &threads[i]);
+    }
+
+    time = sysMain.GetMS();
+    SDL_AtomicSet(&start, 1);
+
+    for(i = 0; i < numThreads; i++) {
+        if(handles[i]) {
+            SDL_WaitThread(handles[i], NULL);
+        }
+        else {
+            HeapTest_Thread(&threads[i]);
+        }
+        errors += threads[i].errors;
+    }
+
+    time = sysMain.GetMS() - time;
+
+    for(i = 0; i < HEAP_TEST_SLOTS; i++) {
+        heapTestHeader_t *header = (heapTestHeader_t*)slots[i];
+
+        if(header == NULL) {
+            continue;
+        }
+        if(!HeapTest_Check(header, 0)) {
+            errors++;
+        }
+
+        usage[header->heap] += header->size;
+        count[header->heap]++;
+    }
+
+    for(i = 0; i < 2; i++) {
+        if(kexHeap::Usage(*heaps[i]) != usage[i] || heaps[i]->numBlocks != count[i]) {
+            common.Warning("heapstresstest: %s holds %i bytes in %i blocks, expected %i in %i\n",
+                heaps[i]->name, kexHeap::Usage(*heaps[i]), heaps[i]->numBlocks, usage[i], count[i]);
+            bOk = false;
+        }
+    }
+
+    kexHeap::CheckBlocks(__FILE__, __LINE__);
+
+    for(i = 0; i < 2; i++) {
+        Mem_Purge(*heaps[i]);
+
+        if(kexHeap::Usage(*heaps[i]) != 0 || heaps[i]->blocks != NULL) {
+            bOk = false;
+        }
+    }
+
+    if(errors) {
+        common.Warning("heapstresstest: %i corrupted blocks\n", errors);
+        bOk = false;
+    }
+
+    common.Printf("%i threads, %i iterations each in %ims, %ikb left in thread caches\n",
+        numThreads, numIterations, time, SDL_AtomicGet(&cachedBytes) >> 10);
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "heapstresstest %s\n", bOk ? "passed" : "failed");
+
+    return bOk;
+}
@@ -23,21 +23,72 @@
 #ifndef __MEM_HEAP_H__
 #define __MEM_HEAP_H__
 
+#include "SDL.h"
+
+#define HEAP_NUM_CLASSES    8       // 32 bytes up to 4kb
+#define HEAP_MIN_CLASS      5       // log2 of the smallest class
+#define HEAP_CACHE_DEPTH    64      // free blocks kept per class per thread
+#define HEAP_SITE_HASH      1024    // must be a power of two
+#define HEAP_MAX_SITES      8192    // sites past this aren't profiled
+
 typedef void (*blockFunc_t)(void*);
 
 class kexHeapBlock;
+struct heapCache_s;
+
+typedef enum {
+    HM_DIFF     = 0,    // memdiff
+    HM_MAP,             // taken when a map starts loading
+    HM_NUMMARKS
+} heapMark_t;
+
+//
+// memSite_t - totals for one Mem_* call site in one heap block. marks
+// hold the live totals at some earlier point so growth can be reported
+//
+typedef struct memSite_s {
+    const char              *file;
+    int                     line;
+    kexHeapBlock            *heapBlock;
+    int                     liveBytes;
+    int                     liveCount;
+    int                     numAllocs;
+    int                     peakBytes;
+    int                     markBytes[HM_NUMMARKS];
+    int                     markCount[HM_NUMMARKS];
+    int                     index;      // into the site list, blocks keep this
+    struct memSite_s        *next;
+} memSite_t;
 
 typedef struct memBlock_s {
     int                     heapTag;
     int                     purgeID;
     int                     size;
     int                     ms;
+    int                     sizeClass;  // -1 if it came straight from the system
+    int                     site;       // 0 unless allocated while profiling. an index
+                                        // rather than a pointer so it fits in the padding
+    struct heapCache_s      *owner;     // thread cache the block goes back to
     kexHeapBlock            *heapBlock;
     void                    **ptrRef;
     struct memBlock_s       *prev;
     struct memBlock_s       *next;
 } memBlock_t;
 
+//
+// heapCache_t - free blocks of one thread, by size class. only the
+// owning thread touches the free lists. other threads hand blocks back
+// through the remote list, which the owner empties the next time it
+// allocates. caches outlive their threads and are reused by new ones
+//
+typedef struct heapCache_s {
+    memBlock_t              *freeBlocks[HEAP_NUM_CLASSES];
+    int                     numFree[HEAP_NUM_CLASSES];
+    void                    *remote;
+    bool                    bInUse;     // guarded by the cache lock
+    struct heapCache_s      *next;
+} heapCache_t;
+
 class kexHeapBlock {
 public:
                             kexHeapBlock(const char *name, bool bGarbageCollect,
@@ -53,6 +104,9 @@ public:
     blockFunc_t             gcFunc;
     int                     purgeID;
     int                     numAllocated;
+    int                     numBlocks;
+    int                     usage;
+    SDL_SpinLock            lock;       // guards the block list and the totals
     kexHeapBlock            *prev;
     kexHeapBlock            *next;
 };
@@ -71,17 +125,44 @@ public:
     static int              Usage(const kexHeapBlock &heapBlock);
     static void             SetCacheRef(void **ptr, const char *file, int line);
     static void             DrawHeapInfo(void);
+    static bool             StressTest(const int numThreads, const int numIterations);
+    static void             MarkSites(const heapMark_t mark);
+    static int              PrintSites(const kexHeapBlock *heapBlock, const int top, const int mark);
+    static bool             GetSite(const char *file, const int line, const kexHeapBlock &heapBlock,
+                                    memSite_t &site);
+    static bool             TestProfile(void);
 
     static int              numHeapBlocks;
     static kexHeapBlock     *currentHeapBlock;
     static int              currentHeapBlockID;
     static kexHeapBlock     *blockList;
     static bool             bDrawHeapInfo;
+    static bool             bProfiling;
 
 private:
     static void             AddBlock(memBlock_t *block, kexHeapBlock *heapBlock);
     static void             RemoveBlock(memBlock_t *block);
     static memBlock_t       *GetBlock(void *ptr, const char *file, int line);
+    static memBlock_t       *AllocBlock(int size, const char *file, int line);
+    static void             ReleaseBlock(memBlock_t *block);
+    static heapCache_t      *ThreadCache(void);
+    static void             CollectRemote(heapCache_t *cache);
+    static void             FlushCache(heapCache_t *cache);
+    static void             ReleaseCache(void *data);
+    static memSite_t        *FindSite(const char *file, const int line, kexHeapBlock *heapBlock,
+                                      const bool bCreate);
+    static void             ProfileAdd(memBlock_t *block);
+    static void             ProfileRemove(memBlock_t *block);
+    static int              SortSites(const void *a, const void *b);
+
+    static SDL_atomic_t     cacheTLS;
+    static SDL_SpinLock     cacheLock;
+    static heapCache_t      *cacheList;
+    static SDL_atomic_t     cachedBytes;
+    static SDL_SpinLock     siteLock;
+    static memSite_t        *siteHash[HEAP_SITE_HASH];
+    static memSite_t        *siteList[HEAP_MAX_SITES];
+    static int              numSites;
     
     static const int        HeapTag = 0x03151983;
 };
@@ -0,0 +1,281 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Interned names
+//
+// Entries are never freed and are fully written before being linked
+// into the table, so lookups can walk the hash chains without taking
+// the lock. Only inserting a new name is serialized.
+//
+// Names are commonly interned during static initialization (RTTI,
+// cvars and commands), before any heap block is guaranteed to be
+// constructed, so the string pool is allocated straight from the system.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "name.h"
+
+nameEntry_t *kexName::hashList[kexName::NAME_HASH_SIZE];
+SDL_SpinLock kexName::lock = 0;
+int kexName::numNames = 0;
+char *kexName::pool = NULL;
+int kexName::poolUsed = 0;
+
+//
+// kexName::kexName
+//
+
+kexName::kexName(const char *string) {
+    entry = Intern(string, true);
+}
+
+//
+// kexName::Find
+//
+// Looks up a name without adding it to the table. Returns an empty
+// name if the string was never interned
+//
+
+kexName kexName::Find(const char *string) {
+    kexName name;
+
+    name.entry = Intern(string, false);
+    return name;
+}
+
+//
+// kexName::HashString
+//
+// Same function as kexStr::Hash but keeps all 32 bits
+//
+
+unsigned int kexName::HashString(const char *string) {
+    unsigned int hash = 0;
+    const char *str = string;
+    char c;
+
+    while((c = *str++)) {
+        hash = c + (hash << 6) + (hash << 16) - hash;
+    }
+
+    return hash;
+}
+
+//
+// kexName::AllocString
+//
+
+char *kexName::AllocString(int size) {
+    char *mem;
+
+    // keep entries pointer aligned
+    size = (size + (sizeof(void*) - 1)) & ~(sizeof(void*) - 1);
+
+    if(size > NAME_POOL_SIZE / 4) {
+        if(!(mem = (char*)malloc(size))) {
+            common.Error("kexName::AllocString: failed on allocation of %i bytes", size);
+        }
+        return mem;
+    }
+
+    if(pool == NULL || poolUsed + size > NAME_POOL_SIZE) {
+        if(!(pool = (char*)malloc(NAME_POOL_SIZE))) {
+            common.Error("kexName::AllocString: failed to allocate name pool");
+        }
+        poolUsed = 0;
+    }
+
+    mem = pool + poolUsed;
+    poolUsed += size;
+
+    return mem;
+}
+
+//
+// kexName::Intern
+//
+
+const nameEntry_t *kexName::Intern(const char *string, bool bCreate) {
+    nameEntry_t *entry;
+    unsigned int hash;
+    int bucket;
+    int len;
+
+    if(string == NULL || string[0] == 0) {
+        return NULL;
+    }
+
+    hash = HashString(string);
+    bucket = hash & (NAME_HASH_SIZE-1);
+
+    entry = hashList[bucket];
+    SDL_MemoryBarrierAcquire();
+
+    for(; entry; entry = entry->next) {
+        if(entry->hash == hash && !strcmp(entry->string, string)) {
+            return entry;
+        }
+    }
+
+    if(bCreate == false) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&lock);
+
+    // another thread may have added it while we were waiting
+    for(entry = hashList[bucket]; entry; entry = entry->next) {
+        if(entry->hash == hash && !strcmp(entry->string, string)) {
+            SDL_AtomicUnlock(&lock);
+            return entry;
+        }
+    }
+
+    len = strlen(string);
+
+    entry = (nameEntry_t*)AllocString(sizeof(nameEntry_t) + len);
+    entry->hash = hash;
+    entry->length = len;
+    entry->next = hashList[bucket];
+    memcpy(entry->string, string, len + 1);
+
+    // entry must be visible before it's linked in
+    SDL_MemoryBarrierRelease();
+    hashList[bucket] = entry;
+    numNames++;
+
+    SDL_AtomicUnlock(&lock);
+    return entry;
+}
+
+//
+// benchnames
+//
+// Looks up every registered class and cvar by name. First walks their
+// lists with strcmp, the way Get used to, then goes through Get with a
+// string and with a name that's already interned
+//
+
+COMMAND(benchnames) {
+    double freq = (double)SDL_GetPerformanceFrequency();
+    kexArray<kexRTTI*> classes;
+    kexArray<kexCvar*> cvars;
+    uint64_t start;
+    double walk, byString, byName;
+    int passes = 1000;
+    unsigned int found = 0;
+
+    if(command.GetArgc() >= 2) {
+        passes = atoi(command.GetArgv(1));
+    }
+
+    if(passes <= 0) {
+        return;
+    }
+
+    for(kexRTTI *oi = kexObject::root; oi != NULL; oi = oi->next) {
+        classes.Push(oi);
+    }
+
+    for(kexCvar *var = cvarManager.GetFirst(); var != NULL; var = var->GetNext()) {
+        cvars.Push(var);
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < classes.Length(); i++) {
+            for(kexRTTI *oi = kexObject::root; oi != NULL; oi = oi->next) {
+                if(!strcmp(oi->classname, classes[i]->classname)) {
+                    found++;
+                    break;
+                }
+            }
+        }
+    }
+    walk = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < classes.Length(); i++) {
+            found += (kexObject::Get(classes[i]->classname) != NULL);
+        }
+    }
+    byString = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < classes.Length(); i++) {
+            found += (kexObject::Get(classes[i]->name) != NULL);
+        }
+    }
+    byName = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    if(classes.Length()) {
+        common.Printf("%i classes\n", classes.Length());
+        common.Printf("strcmp walk: %8.2f ns   by string: %8.2f ns   by name: %8.2f ns\n",
+            walk * 1e9 / (passes * classes.Length()),
+            byString * 1e9 / (passes * classes.Length()),
+            byName * 1e9 / (passes * classes.Length()));
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < cvars.Length(); i++) {
+            for(kexCvar *var = cvarManager.GetFirst(); var != NULL; var = var->GetNext()) {
+                if(!strcmp(var->GetName(), cvars[i]->GetName())) {
+                    found++;
+                    break;
+                }
+            }
+        }
+    }
+    walk = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < cvars.Length(); i++) {
+            found += (cvarManager.Get(cvars[i]->GetName()) != NULL);
+        }
+    }
+    byString = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(unsigned int i = 0; i < cvars.Length(); i++) {
+            found += (cvarManager.Get(cvars[i]->GetKey()) != NULL);
+        }
+    }
+    byName = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    if(cvars.Length()) {
+        common.Printf("%i cvars\n", cvars.Length());
+        common.Printf("strcmp walk: %8.2f ns   by string: %8.2f ns   by name: %8.2f ns\n",
+            walk * 1e9 / (passes * cvars.Length()),
+            byString * 1e9 / (passes * cvars.Length()),
+            byName * 1e9 / (passes * cvars.Length()));
+    }
+
+    if(found != passes * 3 * (classes.Length() + cvars.Length())) {
+        common.Warning("benchnames: some lookups failed\n");
+    }
+}
@@ -0,0 +1,73 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __NAME_H__
+#define __NAME_H__
+
+typedef struct nameEntry_s {
+    unsigned int            hash;
+    int                     length;
+    struct nameEntry_s      *next;
+    char                    string[1];
+} nameEntry_t;
+
+//
+// kexName - interned string. every unique string maps to exactly one
+// entry in a global table, so two names can be compared by pointer and
+// the hash never has to be recomputed. an all-zero kexName is the empty
+// name, which makes it safe to embed in Mem_Calloc'd structures
+//
+
+class kexName {
+public:
+                            kexName(void) : entry(NULL) {}
+                            kexName(const char *string);
+
+    const char              *c_str(void) const { return entry ? entry->string : ""; }
+    const unsigned int      Hash(void) const { return entry ? entry->hash : 0; }
+    const int               Length(void) const { return entry ? entry->length : 0; }
+    const bool              IsEmpty(void) const { return entry == NULL; }
+
+    bool                    operator==(const kexName &name) const { return entry == name.entry; }
+    bool                    operator!=(const kexName &name) const { return entry != name.entry; }
+
+    static kexName          Find(const char *string);
+    static unsigned int     HashString(const char *string);
+    static int              NumNames(void) { return numNames; }
+
+private:
+    static const nameEntry_t *Intern(const char *string, bool bCreate);
+    static char             *AllocString(int size);
+
+    static const int        NAME_HASH_SIZE = 4096;
+    static const int        NAME_POOL_SIZE = 16384;
+
+    static nameEntry_t      *hashList[NAME_HASH_SIZE];
+    static SDL_SpinLock     lock;
+    static int              numNames;
+    static char             *pool;
+    static int              poolUsed;
+
+    const nameEntry_t       *entry;
+};
+
+#endif
@@ -40,16 +40,18 @@ kexRTTI::kexRTTI(const char *classname, const char *supername,
     void(kexObject::*Save)(kexBinFile*), void(kexObject::*Load)(kexBinFile*)) {
         this->classname     = classname;
         this->supername     = supername;
+        this->name          = kexName(classname);
+        this->superName     = kexName(supername);
         this->Create        = Create;
         this->Spawn         = Spawn;
         this->Save          = Save;
         this->Load          = Load;
         this->type_id       = ++kexObject::roverID;
-        this->super         = kexObject::Get(supername);
+        this->super         = kexObject::Get(superName);
 
         // link all classes with supers to this class if not referenced yet
         for(kexRTTI *rtti = kexObject::root; rtti != NULL; rtti = rtti->next) {
-            if(rtti->super == NULL && !strcmp(rtti->supername, this->classname) &&
+            if(rtti->super == NULL && rtti->superName == this->name &&
                 strcmp(rtti->classname, "kexObject")) {
                     rtti->super = this;
             }
@@ -63,6 +65,11 @@ kexRTTI::kexRTTI(const char *classname, const char *supername,
             this->next = kexObject::root;
             kexObject::root = this;
         }
+
+        int hash = name.Hash() & (MAX_HASH-1);
+
+        this->hashNext = kexObject::hashList[hash];
+        kexObject::hashList[hash] = this;
 }
 
 //
@@ -98,6 +105,7 @@ bool kexRTTI::InstanceOf(const kexRTTI *objInfo) const {
 DECLARE_ABSTRACT_CLASS(kexObject, NULL)
 
 kexRTTI *kexObject::root = NULL;
+kexRTTI *kexObject::hashList[MAX_HASH];
 bool kexObject::bInitialized = false;
 int kexObject::roverID = 0;
 
@@ -275,8 +283,20 @@ kexRTTI *kexObject::Get(const char *classname) {
         return NULL;
     }
 
-    for(kexRTTI *oi = kexObject::root; oi != NULL; oi = oi->next) {
-        if(!strcmp(oi->classname, classname)) {
+    return Get(kexName::Find(classname));
+}
+
+//
+// kexObject::Get
+//
+
+kexRTTI *kexObject::Get(const kexName &classname) {
+    if(classname.IsEmpty()) {
+        return NULL;
+    }
+
+    for(kexRTTI *oi = hashList[classname.Hash() & (MAX_HASH-1)]; oi; oi = oi->hashNext) {
+        if(oi->name == classname) {
             return oi;
         }
     }
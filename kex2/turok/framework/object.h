@@ -101,7 +101,10 @@ public:
     int                     type_id;
     const char              *classname;
     const char              *supername;
+    kexName                 name;
+    kexName                 superName;
     kexRTTI                 *next;
+    kexRTTI                 *hashNext;
     kexRTTI                 *super;
 };
 
@@ -129,11 +132,13 @@ BEGIN_CLASS(kexObject);
     static void             Init(void);
     static void             Shutdown(void);
     static kexRTTI          *Get(const char *classname);
+    static kexRTTI          *Get(const kexName &classname);
     static kexObject        *Create(const char *name);
     static void             ListClasses(void);
     
     static int              roverID;
     static kexRTTI          *root;
+    static kexRTTI          *hashList[MAX_HASH];
     
 private:
     static bool             bInitialized;
@@ -0,0 +1,403 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Asset residency
+//
+// Every map load starts a new map generation. Assets that are loaded or
+// looked up while the map loads are stamped with it, as are textures and
+// sounds that are used during the first few frames, which picks up the
+// hud and anything else that doesn't go through the map. Anything still
+// carrying an older stamp after that is released.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "world.h"
+#include "residency.h"
+
+#define RES_RELEASE_FRAMES  4
+
+kexCvar cvarAssetBudget("sys_assetbudget", CVF_INT|CVF_CONFIG, "0", 0, 4095,
+                        "Megabytes of assets to keep resident before assets unused by the current map are evicted");
+
+kexResidency residency;
+
+const char *kexResidency::typeNames[RT_NUMTYPES] = {
+    "models",
+    "textures",
+    "sounds"
+};
+
+//
+// Residency_Budget
+//
+// The cvar is in megabytes and can go past what a signed int
+// holds once it's shifted to bytes
+//
+
+static unsigned int Residency_Budget(void) {
+    return (unsigned int)cvarAssetBudget.GetInt() << 20;
+}
+
+//
+// assetstats
+//
+
+COMMAND(assetstats) {
+    residency.PrintStats();
+}
+
+//
+// Residency_LoadMap
+//
+
+static bool Residency_LoadMap(const int id, const unsigned int budget) {
+    localWorld.Unload();
+
+    if(!localWorld.Load(kva("maps/map%02d/map%02d", id, id))) {
+        common.Warning("testresidency: couldn't load map %i\n", id);
+        return false;
+    }
+
+    residency.Release(budget);
+    return true;
+}
+
+//
+// testresidency
+//
+// Loads map A, then B, then A again. With no budget the second visit to
+// A must reload exactly what B evicted and end up with the same resident
+// set as the first visit. With an unlimited budget nothing is reloaded
+//
+
+COMMAND(testresidency) {
+    unsigned int bytes;
+    int mapA;
+    int mapB;
+    int loads;
+    int markedResident;
+    int markedEvicted;
+    int unmarkedResident;
+    int numEvicted;
+    bool bOk = true;
+
+    if(command.GetArgc() < 3) {
+        common.Printf("testresidency <map id A> <map id B>\n");
+        return;
+    }
+
+    mapA = atoi(command.GetArgv(1));
+    mapB = atoi(command.GetArgv(2));
+
+    // nothing cached, everything outside the map gets evicted
+    if(!Residency_LoadMap(mapA, 0)) {
+        return;
+    }
+
+    bytes = residency.ResidentBytes();
+    residency.Mark();
+
+    if(!Residency_LoadMap(mapB, 0)) {
+        return;
+    }
+
+    residency.CountMarks(markedResident, markedEvicted, unmarkedResident);
+    numEvicted = markedEvicted;
+    loads = residency.Loads();
+
+    if(!Residency_LoadMap(mapA, 0)) {
+        return;
+    }
+
+    loads = residency.Loads() - loads;
+    residency.CountMarks(markedResident, markedEvicted, unmarkedResident);
+
+    common.Printf("no budget: %i bytes then %i bytes, %i reloads for %i evicted\n",
+        bytes, residency.ResidentBytes(), loads, numEvicted);
+
+    if(residency.ResidentBytes() != bytes || loads != numEvicted ||
+        markedEvicted != 0 || unmarkedResident != 0) {
+        bOk = false;
+    }
+
+    // unlimited budget, returning to A must not load anything
+    if(!Residency_LoadMap(mapB, 0xFFFFFFFF)) {
+        return;
+    }
+
+    bytes = residency.ResidentBytes();
+    loads = residency.Loads();
+
+    if(!Residency_LoadMap(mapA, 0xFFFFFFFF)) {
+        return;
+    }
+
+    loads = residency.Loads() - loads;
+
+    common.Printf("unlimited budget: %i bytes then %i bytes, %i reloads\n",
+        bytes, residency.ResidentBytes(), loads);
+
+    if(loads != 0 || residency.ResidentBytes() != bytes) {
+        bOk = false;
+    }
+
+    residency.Release(Residency_Budget());
+
+    common.CPrintf(bOk ? COLOR_GREEN : COLOR_RED, "testresidency %s\n",
+        bOk ? "passed" : "failed");
+}
+
+//
+// kexResidency::Register
+//
+// Called whenever an asset's data is loaded, whether for the first time
+// or again after being evicted
+//
+
+void kexResidency::Register(resident_t *res, const residentType_t type, void *data,
+                            const unsigned int size, residentFunc_t evictFunc) {
+    if(!res->bTracked) {
+        residents.Push(res);
+        res->bTracked = true;
+        res->bPinned = (mapID == 0);
+    }
+
+    if(res->bResident) {
+        residentBytes[res->type] -= res->size;
+        numResident[res->type]--;
+    }
+
+    res->data = data;
+    res->evictFunc = evictFunc;
+    res->type = type;
+    res->size = size;
+    res->bResident = true;
+    res->loadCount++;
+
+    residentBytes[type] += size;
+    numResident[type]++;
+    numLoads[type]++;
+
+    Touch(res);
+
+    // loads in the middle of a map are held to the budget right away
+    if(!bLoadingMap && releaseFrames == 0 && mapID != 0) {
+        unsigned int budget = Residency_Budget();
+
+        if(ResidentBytes() > budget) {
+            Release(budget);
+        }
+    }
+}
+
+//
+// kexResidency::Touch
+//
+
+void kexResidency::Touch(resident_t *res) {
+    res->mapID = mapID;
+    res->lastUse = ++useClock;
+}
+
+//
+// kexResidency::Evict
+//
+
+void kexResidency::Evict(resident_t *res) {
+    if(!res->bResident || res->bPinned) {
+        return;
+    }
+
+    res->evictFunc(res->data);
+    res->bResident = false;
+
+    residentBytes[res->type] -= res->size;
+    numResident[res->type]--;
+    numEvictions[res->type]++;
+}
+
+//
+// kexResidency::BeginMap
+//
+
+void kexResidency::BeginMap(void) {
+    mapID++;
+    bLoadingMap = true;
+    releaseFrames = 0;
+}
+
+//
+// kexResidency::EndMap
+//
+
+void kexResidency::EndMap(void) {
+    bLoadingMap = false;
+    releaseFrames = RES_RELEASE_FRAMES;
+}
+
+//
+// kexResidency::Update
+//
+
+void kexResidency::Update(void) {
+    if(releaseFrames > 0 && --releaseFrames == 0) {
+        Release(Residency_Budget());
+    }
+}
+
+//
+// kexResidency::SortByUse
+//
+
+int kexResidency::SortByUse(resident_t *const *a, resident_t *const *b) {
+    if((*a)->lastUse < (*b)->lastUse) {
+        return -1;
+    }
+
+    return (*a)->lastUse > (*b)->lastUse ? 1 : 0;
+}
+
+//
+// kexResidency::Release
+//
+// Evicts assets the current map doesn't reference, least recently used
+// first, until everything fits in budget bytes
+//
+
+void kexResidency::Release(const unsigned int budget) {
+    kexArray<resident_t*> candidates;
+    unsigned int i;
+
+    releaseFrames = 0;
+
+    if(ResidentBytes() <= budget) {
+        return;
+    }
+
+    for(i = 0; i < residents.Length(); i++) {
+        resident_t *res = residents[i];
+
+        if(res->bResident && !res->bPinned && res->mapID != mapID) {
+            candidates.Push(res);
+        }
+    }
+
+    candidates.Sort(SortByUse);
+
+    for(i = 0; i < candidates.Length() && ResidentBytes() > budget; i++) {
+        Evict(candidates[i]);
+    }
+}
+
+//
+// kexResidency::Shutdown
+//
+// The managers purge their assets wholesale on shutdown
+//
+
+void kexResidency::Shutdown(void) {
+    residents.Empty();
+}
+
+//
+// kexResidency::Mark
+//
+
+void kexResidency::Mark(void) {
+    for(unsigned int i = 0; i < residents.Length(); i++) {
+        resident_t *res = residents[i];
+        res->bMark = (res->bResident && !res->bPinned);
+    }
+}
+
+//
+// kexResidency::CountMarks
+//
+
+void kexResidency::CountMarks(int &markedResident, int &markedEvicted, int &unmarkedResident) {
+    markedResident = 0;
+    markedEvicted = 0;
+    unmarkedResident = 0;
+
+    for(unsigned int i = 0; i < residents.Length(); i++) {
+        resident_t *res = residents[i];
+
+        if(res->bPinned) {
+            continue;
+        }
+
+        if(res->bMark) {
+            if(res->bResident) {
+                markedResident++;
+            }
+            else {
+                markedEvicted++;
+            }
+        }
+        else if(res->bResident) {
+            unmarkedResident++;
+        }
+    }
+}
+
+//
+// kexResidency::ResidentBytes
+//
+
+const unsigned int kexResidency::ResidentBytes(void) const {
+    unsigned int bytes = 0;
+
+    for(int i = 0; i < RT_NUMTYPES; i++) {
+        bytes += residentBytes[i];
+    }
+
+    return bytes;
+}
+
+//
+// kexResidency::Loads
+//
+
+const int kexResidency::Loads(void) const {
+    int loads = 0;
+
+    for(int i = 0; i < RT_NUMTYPES; i++) {
+        loads += numLoads[i];
+    }
+
+    return loads;
+}
+
+//
+// kexResidency::PrintStats
+//
+
+void kexResidency::PrintStats(void) {
+    common.Printf("map generation %i, budget %iMB\n", mapID, cvarAssetBudget.GetInt());
+
+    for(int i = 0; i < RT_NUMTYPES; i++) {
+        common.Printf("%-8s: %4i resident (%ikb), %i loads, %i evictions\n",
+            typeNames[i], numResident[i], residentBytes[i] >> 10,
+            numLoads[i], numEvictions[i]);
+    }
+}
@@ -0,0 +1,103 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __RESIDENCY_H__
+#define __RESIDENCY_H__
+
+#include "array.h"
+
+typedef enum {
+    RT_MODEL    = 0,
+    RT_TEXTURE,
+    RT_SOUND,
+    RT_NUMTYPES
+} residentType_t;
+
+typedef void (*residentFunc_t)(void *data);
+
+//
+// resident_t - embedded in every cached asset. the asset itself is never
+// freed, only the data it holds, so pointers to it stay valid and it is
+// loaded again the next time something asks for it. a zeroed record is
+// an asset that was never loaded
+//
+
+typedef struct {
+    void                    *data;
+    residentFunc_t          evictFunc;
+    unsigned int            size;
+    unsigned int            mapID;      // last map that referenced the asset
+    unsigned int            lastUse;
+    int                     loadCount;
+    byte                    type;
+    bool                    bTracked;
+    bool                    bResident;
+    bool                    bPinned;    // loaded before any map, never evicted
+    bool                    bMark;
+} resident_t;
+
+//
+// kexResidency - keeps track of which cached assets are referenced by the
+// current map. assets the map never touched are evicted a few frames
+// after it loads, least recently used first, until the resident total
+// fits the asset budget
+//
+
+class kexResidency {
+public:
+    void                    Register(resident_t *res, const residentType_t type, void *data,
+                                     const unsigned int size, residentFunc_t evictFunc);
+    void                    Touch(resident_t *res);
+    void                    Evict(resident_t *res);
+    void                    BeginMap(void);
+    void                    EndMap(void);
+    void                    Update(void);
+    void                    Release(const unsigned int budget);
+    void                    Shutdown(void);
+    void                    Mark(void);
+    void                    CountMarks(int &markedResident, int &markedEvicted, int &unmarkedResident);
+    void                    PrintStats(void);
+
+    const unsigned int      ResidentBytes(void) const;
+    const unsigned int      ResidentBytes(const residentType_t type) const { return residentBytes[type]; }
+    const int               Loads(void) const;
+    const int               Loads(const residentType_t type) const { return numLoads[type]; }
+
+    static const char       *typeNames[RT_NUMTYPES];
+
+private:
+    static int              SortByUse(resident_t *const *a, resident_t *const *b);
+
+    kexArray<resident_t*>   residents;
+    unsigned int            residentBytes[RT_NUMTYPES];
+    int                     numResident[RT_NUMTYPES];
+    int                     numLoads[RT_NUMTYPES];
+    int                     numEvictions[RT_NUMTYPES];
+    unsigned int            mapID;
+    unsigned int            useClock;
+    int                     releaseFrames;
+    bool                    bLoadingMap;
+};
+
+extern kexResidency residency;
+
+#endif
@@ -35,6 +35,7 @@ public:
     type                    *Load(const char *file);
 
     virtual type            *OnLoad(const char *file) = 0;
+    virtual void            OnReuse(type *obj);
 
     kexHashList<type>       dataList;
 };
@@ -58,11 +59,18 @@ void kexResourceManager<type>::Update(void) {
 //
 template<class type>
 void kexResourceManager<type>::Shutdown(void) {
-     for(int i = 0; i < MAX_HASH; i++) {
-        for(type *obj = dataList.GetData(i); obj; obj = dataList.Next()) {
-            obj->Delete();
-        }
-     }
+    for(type *obj = dataList.First(); obj; obj = dataList.Next()) {
+        obj->Delete();
+    }
+}
+
+//
+// kexResourceManager::OnReuse
+//
+// Called when Load hands out an object that was already cached
+//
+template<class type>
+void kexResourceManager<type>::OnReuse(type *obj) {
 }
 
 //
@@ -82,6 +90,9 @@ type *kexResourceManager<type>::Load(const char *file) {
     if(!(obj = dataList.Find(file))) {
         obj = OnLoad(file);
     }
+    else {
+        OnReuse(obj);
+    }
 
     return obj;
 }
@@ -43,9 +43,13 @@
 #include "scriptAPI/scriptSystem.h"
 #include "gameManager.h"
 #include "gui.h"
+#include "residency.h"
+#include "jobs.h"
 
 kexCvar cvarDeveloper("developer", CVF_BOOL|CVF_CONFIG, "0", "Developer mode");
 kexCvar cvarFixedTime("fixedtime", CVF_INT|CVF_CONFIG, "0", "TODO");
+kexCvar cvarFramePacing("sys_framepacing", CVF_INT|CVF_CONFIG, "1", 0, 2,
+                        "Wait between frames by 0 = spinning, 1 = sleeping, 2 = yielding");
 kexCvar cvarVidWidth("v_width", CVF_INT|CVF_CONFIG, "640", "TODO");
 kexCvar cvarVidHeight("v_height", CVF_INT|CVF_CONFIG, "480", "TODO");
 kexCvar cvarVidWindowed("v_windowed", CVF_BOOL|CVF_CONFIG, "1", "TODO");
@@ -56,7 +60,6 @@ kexCvar cvarVidBuffSize("v_buffersize", CVF_INT|CVF_CONFIG, "32", "TODO");
 
 kexSystem sysMain;
 
-static char buffer[4096];
 
 //
 // showinternalconsole
@@ -143,6 +146,9 @@ void kexSystem::Shutdown(void) {
     gameManager.OnShutdown();
 
     localWorld.Unload();
+    localWorld.StopStreaming();
+    residency.Shutdown();
+    jobSystem.Shutdown();
 
     soundSystem.Shutdown();
     
@@ -174,6 +180,8 @@ void kexSystem::Shutdown(void) {
 
     common.Printf("Shutting down\n");
 
+    logger.Shutdown();
+
     SDL_Quit();
 
     fclose(f_stdout);
@@ -240,28 +248,11 @@ void kexSystem::Init(void) {
 //
 
 void kexSystem::Log(const char *fmt, ...) {
-#define MAX_LOGMESSAGE_LENGTH   3584
     va_list list;
-    time_t copy;
-    static char buffer[64];
-    struct tm *local;
-    char logMessage[MAX_LOGMESSAGE_LENGTH];
 
-    SDL_memset(logMessage, 0, MAX_LOGMESSAGE_LENGTH);
     va_start(list, fmt);
-    SDL_vsnprintf(logMessage, MAX_LOGMESSAGE_LENGTH - 1, fmt, list);
+    logger.VPrintf(LC_SYSTEM, LS_INFO, COLOR_WHITE, LRF_NOCONSOLE, fmt, list);
     va_end(list);
-
-#ifdef _WIN32
-    Sys_Printf(logMessage);
-#endif
-
-    SDL_memset(buffer, 0, sizeof(buffer));
-    copy = time(0);
-    local = localtime(&copy);
-    strftime(buffer, sizeof(buffer), "%X", local);
-
-    printf("%s: %s", buffer, logMessage);
 }
 
 //
@@ -269,7 +260,9 @@ void kexSystem::Log(const char *fmt, ...) {
 //
 
 void kexSystem::SwapBuffers(void) {
+#ifndef USE_MOCK_GLFUNCS
     SDL_GL_SwapWindow(window);
+#endif
 }
 
 //
@@ -375,11 +368,8 @@ void kexSystem::Printf(const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_SYSTEM, LS_INFO, COLOR_WHITE, 0, string, va);
     va_end(va);
-    
-    console.Print(COLOR_WHITE, buffer);
-    Log(buffer);
 }
 
 //
@@ -390,11 +380,8 @@ void kexSystem::CPrintf(rcolor color, const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_SYSTEM, LS_INFO, color, 0, string, va);
     va_end(va);
-    
-    console.Print(color, buffer);
-    Log(buffer);
 }
 
 //
@@ -405,11 +392,8 @@ void kexSystem::Warning(const char *string, ...) {
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    logger.VPrintf(LC_SYSTEM, LS_WARNING, COLOR_YELLOW, 0, string, va);
     va_end(va);
-    
-    console.Print(COLOR_YELLOW, buffer);
-    Log(buffer);
 }
 
 //
@@ -418,14 +402,11 @@ void kexSystem::Warning(const char *string, ...) {
 
 void kexSystem::DPrintf(const char *string, ...) {
     if(cvarDeveloper.GetBool()) {
-        static char buffer[1024];
         va_list	va;
         
         va_start(va, string);
-        vsprintf(buffer, string, va);
+        logger.VPrintf(LC_SYSTEM, LS_DEBUG, RGBA(0xE0, 0xE0, 0xE0, 0xff), 0, string, va);
         va_end(va);
-        
-        CPrintf(RGBA(0xE0, 0xE0, 0xE0, 0xff), buffer);
     }
 }
 
@@ -434,16 +415,18 @@ void kexSystem::DPrintf(const char *string, ...) {
 //
 
 void kexSystem::Error(const char* string, ...) {
+    char buffer[LOG_MAX_LENGTH];
     va_list	va;
     
     va_start(va, string);
-    vsprintf(buffer, string, va);
+    SDL_vsnprintf(buffer, LOG_MAX_LENGTH, string, va);
     va_end(va);
     
     fprintf(stderr, "Error - %s\n", buffer);
     fflush(stderr);
     
-    Log(buffer);
+    logger.Post(LC_SYSTEM, LS_ERROR, COLOR_RED, LRF_NOCONSOLE, buffer);
+    logger.Shutdown();
     
 #ifdef _WIN32
     Sys_Error(buffer);
@@ -579,7 +562,13 @@ void kexSystem::InitVideo(void) {
     SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, cvarVidStencilSize.GetInt());
     SDL_GL_SetSwapInterval(cvarVidVSync.GetBool());
     
+#ifdef USE_MOCK_GLFUNCS
+    // nothing is drawn, the window is only there for input
+    flags |= SDL_WINDOW_HIDDEN;
+    bWindowed = true;
+#else
     flags |= SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_MOUSE_FOCUS;
+#endif
     
     if(!bWindowed)
         flags |= SDL_WINDOW_FULLSCREEN;
@@ -593,14 +582,37 @@ void kexSystem::InitVideo(void) {
         common.Error("kexSystem::InitVideo: Failed to create window");
     }
 
+#ifndef USE_MOCK_GLFUNCS
     if((glContext = SDL_GL_CreateContext(window)) == NULL) {
         common.Error("kexSystem::InitVideo: Failed to create opengl context");
     }
+#endif
 
     gameManager.SetTitle();
     common.Printf("Video Initialized\n");
 }
 
+//
+// kexSystem::WaitForFrame
+//
+// Hands the time left until the next frame back to the OS. Sleeping
+// tends to overshoot so the last millisecond is always yielded away
+// in small pieces by the main loop instead
+//
+
+void kexSystem::WaitForFrame(const int msec) {
+    switch(cvarFramePacing.GetInt()) {
+    case 1:
+        Sleep(msec > 1 ? msec - 1 : 0);
+        break;
+    case 2:
+        Sleep(0);
+        break;
+    default:
+        break;
+    }
+}
+
 //
 // kexSystem::MainLoop
 //
@@ -621,6 +633,10 @@ void kexSystem::MainLoop(void) {
         do {
             nextmsec = GetMS();
             msec = nextmsec - prevmsec;
+
+            if(msec < 1) {
+                WaitForFrame(0);
+            }
         }
         while(msec < 1);
 
@@ -633,6 +649,10 @@ void kexSystem::MainLoop(void) {
         prevmsec = nextmsec;
 
         Mem_GC();
+
+        logger.DrainConsole();
+
+        WaitForFrame(client.TimeToNextFrame());
     }
 }
 
@@ -647,6 +667,8 @@ void kexSystem::Main(int argc, char **argv) {
     f_stdout = freopen("stdout.txt", "wt", stdout);
     f_stderr = freopen("stderr.txt", "wt", stderr);
 
+    logger.Init();
+
     SpawnInternalConsole();
 
     Init();
@@ -668,6 +690,9 @@ void kexSystem::Main(int argc, char **argv) {
     common.ReadConfigFile("config.cfg");
     common.ReadConfigFile("autoexec.cfg");
 
+    // worker count comes from the config
+    jobSystem.Init();
+
     InitVideo();
 
     renderBackend.Init();
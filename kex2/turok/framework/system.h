@@ -88,6 +88,7 @@ public:
 
 private:
     void                    InitVideo(void);
+    void                    WaitForFrame(const int msec);
     void                    MainLoop(void);
 
     SDL_Window              *window;
@@ -98,6 +98,185 @@ DECLARE_CLASS(kexActor, kexWorldObject)
 
 unsigned int kexActor::id = 0;
 
+//
+// Actor_RandomVec
+//
+
+static kexVec3 Actor_RandomVec(const float scale) {
+    return kexVec3(kexRand::CFloat() * scale, kexRand::CFloat() * scale, kexRand::CFloat() * scale);
+}
+
+//
+// Actor_Free
+//
+// Test actors never go through the world, so they're freed the
+// way kexObject allocated them. The type is exact here, which
+// delete can't know without a virtual destructor
+//
+
+static void Actor_Free(kexActor *actor) {
+    actor->~kexActor();
+    kexObject::operator delete(actor);
+}
+
+//
+// Actor_TransformMatches
+//
+// Rebuilds ref from scratch with actor's current transform and checks
+// that the two came out identical
+//
+
+static bool Actor_TransformMatches(kexActor *actor, kexActor *ref) {
+    ref->SetOrigin(actor->GetOrigin());
+    ref->SetAngles(actor->GetAngles());
+    ref->SetScale(actor->GetScale());
+    ref->SetRotation(actor->GetRotation());
+    ref->MarkTransformDirty();
+    ref->UpdateTransform();
+
+    return !memcmp(&actor->Matrix(), &ref->Matrix(), sizeof(kexMatrix)) &&
+           !memcmp(&actor->RotationMatrix(), &ref->RotationMatrix(), sizeof(kexMatrix)) &&
+           !memcmp(&actor->Bounds(), &ref->Bounds(), sizeof(kexBBox));
+}
+
+//
+// testtransformcache
+//
+// Moves actors around through the setters, through the references and
+// through an attachment, checking the cached transform against one
+// built eagerly after every update
+//
+
+COMMAND(testtransformcache) {
+    kexActor *parent = new kexActor;
+    kexActor *child = new kexActor;
+    kexActor *ref = new kexActor;
+    kexActor *childRef = new kexActor;
+    kexVec3 min;
+    kexVec3 max;
+    int iterations = 10000;
+    int mismatches = 0;
+
+    if(command.GetArgc() >= 2) {
+        iterations = atoi(command.GetArgv(1));
+    }
+
+    child->Attachment().SetAttachOffset(kexVec3(0, 32, 0));
+    child->Attachment().AttachToObject(parent);
+
+    for(int i = 0; i < iterations; i++) {
+        // every kind of change in turn, followed by a few frames of none
+        switch(i % 8) {
+        case 0:
+            parent->SetOrigin(Actor_RandomVec(4096));
+            break;
+        case 1:
+            parent->GetOrigin().y += kexRand::CFloat() * 64;
+            break;
+        case 2:
+            parent->SetAngles(kexAngle(kexRand::CFloat() * M_PI, kexRand::CFloat() * M_PI, 0));
+            break;
+        case 3:
+            parent->GetAngles().yaw += kexRand::CFloat();
+            break;
+        case 4:
+            parent->SetScale(kexVec3(1, 1, 1) + Actor_RandomVec(0.5f));
+            break;
+        case 5:
+            min = Actor_RandomVec(16) - kexVec3(32, 32, 32);
+            max = Actor_RandomVec(16) + kexVec3(32, 32, 32);
+            parent->SetBoundingBox(min, max);
+            ref->SetBoundingBox(min, max);
+            break;
+        default:
+            // left alone, the cached transform has to still be right
+            break;
+        }
+
+        parent->UpdateTransform();
+        child->UpdateTransform();
+
+        if(!Actor_TransformMatches(parent, ref)) {
+            mismatches++;
+        }
+        if(!Actor_TransformMatches(child, childRef)) {
+            mismatches++;
+        }
+    }
+
+    child->Attachment().DettachObject();
+
+    Actor_Free(childRef);
+    Actor_Free(ref);
+    Actor_Free(child);
+    Actor_Free(parent);
+
+    common.Printf(LC_GAME, "%i updates, %i mismatches\n", iterations * 2, mismatches);
+    common.CPrintf(LC_GAME, mismatches == 0 ? COLOR_GREEN : COLOR_RED, "testtransformcache %s\n",
+        mismatches == 0 ? "passed" : "failed");
+}
+
+//
+// benchtransforms
+//
+// Times a frame's worth of transform updates over idle actors, cached
+// and then forced to rebuild
+//
+
+COMMAND(benchtransforms) {
+    kexActor **actors;
+    double freq = (double)SDL_GetPerformanceFrequency();
+    uint64_t start;
+    double cached;
+    double eager;
+    int count = 5000;
+    const int passes = 100;
+
+    if(command.GetArgc() >= 2) {
+        count = atoi(command.GetArgv(1));
+    }
+
+    if(count <= 0) {
+        return;
+    }
+
+    actors = new kexActor*[count];
+
+    for(int i = 0; i < count; i++) {
+        actors[i] = new kexActor;
+        actors[i]->SetOrigin(Actor_RandomVec(4096));
+        actors[i]->SetAngles(kexAngle(kexRand::CFloat() * M_PI, 0, 0));
+        actors[i]->UpdateTransform();
+    }
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(int i = 0; i < count; i++) {
+            actors[i]->UpdateTransform();
+        }
+    }
+    cached = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int p = 0; p < passes; p++) {
+        for(int i = 0; i < count; i++) {
+            actors[i]->MarkTransformDirty();
+            actors[i]->UpdateTransform();
+        }
+    }
+    eager = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    common.Printf(LC_GAME, "%i idle actors, %i frames\n", count, passes);
+    common.Printf(LC_GAME, "cached:  %8.2f ns/actor\n", cached * 1e9 / (count * passes));
+    common.Printf(LC_GAME, "rebuilt: %8.2f ns/actor\n", eager * 1e9 / (count * passes));
+
+    for(int i = 0; i < count; i++) {
+        Actor_Free(actors[i]);
+    }
+
+    delete[] actors;
+}
+
 //
 // kexActor::kexActor
 //
@@ -106,7 +285,6 @@ kexActor::kexActor(void) {
     this->baseBBox.min.Set(-32, -32, -32);
     this->baseBBox.max.Set(32, 32, 32);
 
-    this->worldLink.SetData(this);
     this->scriptComponent.SetOwner(this);
     this->AnimState()->SetOwner(this);
 
@@ -406,6 +584,10 @@ void kexActor::Parse(kexLexer *lexer) {
 //
 // kexActor::UpdateTransform
 //
+// Only rebuilds the matrix and bounds when something they depend on has
+// changed. Attached actors pick up their parent's movement through the
+// origin the attachment hands them
+//
 
 void kexActor::UpdateTransform(void) {
     attachment.Transform();
@@ -418,6 +600,10 @@ void kexActor::UpdateTransform(void) {
         angles.roll     += (physics.rotorVector.z * physics.rotorSpeed * delta);
     }
 
+    if(!bTransformDirty && !TransformChanged()) {
+        return;
+    }
+
     if(!bStatic || physics.bRotor) {
         angles.Clamp180();
         rotation = angles.ToQuat();
@@ -442,6 +628,8 @@ void kexActor::UpdateTransform(void) {
 
     bbox.min += origin;
     bbox.max += origin;
+
+    StoreTransformKey();
 }
 
 //
@@ -524,6 +712,18 @@ void kexActor::SetModel(const kexStr &modelFile) {
     SetModel(modelFile.c_str());
 }
 
+//
+// kexActor::StoreHot
+//
+
+void kexActor::StoreHot(objectHot_t &hot) {
+    kexWorldObject::StoreHot(hot);
+
+    if(bNoCull) {
+        hot.flags |= OHF_NOCULL;
+    }
+}
+
 //
 // kexActor::PlayFootStepSound
 //
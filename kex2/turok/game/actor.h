@@ -63,6 +63,7 @@ public:
     bool                        CallFunction(const kexStr &function, const frameAction_t *actions);
     void                        SetRotationOffset(const int node, const float angle,
                                                   const float x, const float y, const float z);
+    void                        StoreHot(objectHot_t &hot);
 
     kexStr                      &GetName(void) { return name; }
     void                        SetName(kexStr &str) { name = str; }
@@ -77,7 +78,6 @@ public:
 
     static void                 InitObject(void);
 
-    kexLinklist<kexActor>       worldLink;
     kexActorComponent           scriptComponent;
     kexKeyMap                   args;
     kexKeyMap                   *definition;
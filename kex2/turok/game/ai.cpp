@@ -77,14 +77,15 @@ COMMAND(aidebug) {
     trace.bbox.min += trace.start;
     trace.bbox.max += trace.start;
 
-    for(kexActor *actor = localWorld.actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-            if(actor->InstanceOf(&kexAI::info)) {
-                bool bSolid = actor->bCollision;
-                actor->bCollision = true;
-                actor->Trace(&trace);
-                actor->bCollision = bSolid;
-            }
+    for(unsigned int i = 0; i < localWorld.actors.Length(); i++) {
+        kexActor *actor = localWorld.actors[i];
+
+        if(actor && actor->InstanceOf(&kexAI::info)) {
+            bool bSolid = actor->bCollision;
+            actor->bCollision = true;
+            actor->Trace(&trace);
+            actor->bCollision = bSolid;
+        }
     }
 
     if(trace.hitActor) {
@@ -141,13 +141,21 @@ kexVec3 kexAnimState::GetTranslation(kexAnim_t *anim, int nodeNum, int frame) {
 //
 
 kexAnim_t *kexAnimState::GetAnim(const kexModel_t *model, const char *name) {
+    return GetAnim(model, kexName::Find(name));
+}
+
+//
+// kexAnimState::GetAnim
+//
+
+kexAnim_t *kexAnimState::GetAnim(const kexModel_t *model, const kexName &name) {
     unsigned int i;
 
-    if(model->anims == NULL || model->numAnimations <= 0)
+    if(model->anims == NULL || model->numAnimations <= 0 || name.IsEmpty())
         return NULL;
 
     for(i = 0; i < model->numAnimations; i++) {
-        if(!strcmp(model->anims[i].alias, name)) {
+        if(model->anims[i].aliasName == name) {
             return &model->anims[i];
         }
     }
@@ -351,7 +359,7 @@ void kexAnimState::Blend(const kexStr &animName, float animTime, float animBlend
         Blend(anim, animTime, animBlendTime, animFlags);
     }
     else {
-        common.Warning("kexAnimState::Blend: %s not found for %s\n", animName.c_str(), owner->Model()->filePath);
+        common.Warning(LC_GAME, "kexAnimState::Blend: %s not found for %s\n", animName.c_str(), owner->Model()->filePath);
     }
 }
 
@@ -370,7 +378,7 @@ void kexAnimState::Blend(const int id, float animTime, float animBlendTime, int
         Blend(anim, animTime, animBlendTime, animFlags);
     }
     else {
-        common.Warning("kexAnimState::Blend: ID %i not found for %s\n", id, owner->Model()->filePath);
+        common.Warning(LC_GAME, "kexAnimState::Blend: ID %i not found for %s\n", id, owner->Model()->filePath);
     }
 }
 
@@ -645,7 +653,7 @@ void kexAnimState::ExecuteFrameActions(void) {
 
                 case AA_CALLFUNCTION:
                     if(!owner->CallFunction(action->argStrings[0], action)) {
-                        common.DPrintf("kexAnimState::ExecuteFrameActions: Couldn't execute \"%s\":%i\n",
+                        common.DPrintf(LC_GAME, "kexAnimState::ExecuteFrameActions: Couldn't execute \"%s\":%i\n",
                             action->argStrings[0], action->frame);
                     }
                     break;
@@ -818,14 +826,14 @@ void kexAnimState::ParseKAnim(const kexModel_t *model, kexAnim_t *anim, kexLexer
                     parser.Error("numactions is 0 or has not been set yet for %s",
                         anim->alias);
                 }
-                anim->actions = (frameAction_t*)Mem_Malloc(sizeof(frameAction_t) *
+                anim->actions = (frameAction_t*)Mem_Calloc(sizeof(frameAction_t) *
                     anim->numActions, hb_animation);
                 lexer->ExpectNextToken(TK_EQUAL);
                 lexer->ExpectNextToken(TK_LBRACK);
                 for(i = 0; i < anim->numActions; i++) {
                     anim->actions[i].frame = lexer->GetNumber();
                     if(anim->actions[i].frame == 0) {
-                        common.Warning("Kanim_ParseAnimScript: Frame 0 set on %i (%s)\n",
+                        common.Warning(LC_GAME, "Kanim_ParseAnimScript: Frame 0 set on %i (%s)\n",
                             i, anim->animFile);
                     }
                     anim->actions[i].function = (animActions_t)lexer->GetNumber();
@@ -842,9 +850,9 @@ void kexAnimState::ParseKAnim(const kexModel_t *model, kexAnim_t *anim, kexLexer
                             anim->actions[i].args[j] = (float)atof(lexer->Token());
                             break;
                         default:
-                            common.Warning("Kanim_ParseAnimScript: Action Argument #%i ", j);
-                            common.Warning("is not a number nor a string\n");
-                            common.Warning("line=%i, pos=%i\n\n", lexer->LinePos(), lexer->RowPos());
+                            common.Warning(LC_GAME, "Kanim_ParseAnimScript: Action Argument #%i ", j);
+                            common.Warning(LC_GAME, "is not a number nor a string\n");
+                            common.Warning(LC_GAME, "line=%i, pos=%i\n\n", lexer->LinePos(), lexer->RowPos());
                             break;
                         }
 
@@ -905,7 +913,7 @@ void kexAnimState::ParseKAnim(const kexModel_t *model, kexAnim_t *anim, kexLexer
                 break;
             default:
                 if(lexer->TokenType() == TK_IDENIFIER) {
-                    common.DPrintf("Kanim_ParseAnimScript: Unknown token: %s\n",
+                    common.DPrintf(LC_GAME, "Kanim_ParseAnimScript: Unknown token: %s\n",
                         lexer->Token());
                 }
                 break;
@@ -942,6 +950,87 @@ void kexAnimState::LoadKAnim(const kexModel_t *model) {
     }
 }
 
+//
+// kexAnimState::FreeKAnim
+//
+
+void kexAnimState::FreeKAnim(kexAnim_t *anim) {
+    unsigned int i;
+
+    if(anim->translations) {
+        for(i = 0; i < anim->numTranslations; i++) {
+            Mem_Free(anim->translations[i]);
+        }
+        Mem_Free(anim->translations);
+    }
+
+    if(anim->rotations) {
+        for(i = 0; i < anim->numRotations; i++) {
+            Mem_Free(anim->rotations[i]);
+        }
+        Mem_Free(anim->rotations);
+    }
+
+    if(anim->actions) {
+        for(i = 0; i < anim->numActions; i++) {
+            for(int j = 0; j < NUMFRAMEACTIONS; j++) {
+                if(anim->actions[i].argStrings[j]) {
+                    Mem_Free(anim->actions[i].argStrings[j]);
+                }
+            }
+        }
+        Mem_Free(anim->actions);
+    }
+
+    if(anim->frameSet) {
+        Mem_Free(anim->frameSet);
+    }
+    if(anim->initialFrame.translations) {
+        Mem_Free(anim->initialFrame.translations);
+    }
+    if(anim->initialFrame.rotations) {
+        Mem_Free(anim->initialFrame.rotations);
+    }
+    if(anim->yawOffsets) {
+        Mem_Free(anim->yawOffsets);
+    }
+    if(anim->alias) {
+        Mem_Free(anim->alias);
+    }
+}
+
+//
+// kexAnimState::KAnimSize
+//
+
+unsigned int kexAnimState::KAnimSize(const kexModel_t *model, const kexAnim_t *anim) {
+    unsigned int size = 0;
+
+    if(anim->translations) {
+        size += (sizeof(kexVec3*) + sizeof(kexVec3) * anim->numFrames) * anim->numTranslations;
+    }
+    if(anim->rotations) {
+        size += (sizeof(kexQuat*) + sizeof(kexQuat) * anim->numFrames) * anim->numRotations;
+    }
+    if(anim->actions) {
+        size += sizeof(frameAction_t) * anim->numActions;
+    }
+    if(anim->frameSet) {
+        size += sizeof(frameSet_t) * model->numNodes;
+    }
+    if(anim->initialFrame.translations) {
+        size += sizeof(kexVec3) * model->numNodes;
+    }
+    if(anim->initialFrame.rotations) {
+        size += sizeof(kexQuat) * model->numNodes;
+    }
+    if(anim->yawOffsets) {
+        size += sizeof(float) * anim->numFrames;
+    }
+
+    return size;
+}
+
 //
 // kexAnimState::InitObject
 //
@@ -64,6 +64,7 @@ typedef struct {
 
 typedef struct kexAnim_s {
     char                    *alias;
+    kexName                 aliasName;
     filepath_t              animFile;
     unsigned int            numFrames;
     unsigned int            numAnimsets;
@@ -109,9 +110,12 @@ public:
     static kexQuat          GetRotation(kexAnim_t *anim, int nodeNum, int frame);
     static kexVec3          GetTranslation(kexAnim_t *anim, int nodeNum, int frame);
     static kexAnim_t        *GetAnim(const kexModel_t *model, const char *name);
+    static kexAnim_t        *GetAnim(const kexModel_t *model, const kexName &name);
     static kexAnim_t        *GetAnim(const kexModel_t *model, const int id);
     static bool             CheckAnimID(const kexModel_t *model, const int id);
     static void             LoadKAnim(const kexModel_t *model);
+    static void             FreeKAnim(kexAnim_t *anim);
+    static unsigned int     KAnimSize(const kexModel_t *model, const kexAnim_t *anim);
 
     void                    SetOwner(kexActor *actor) { owner = actor; }
     const int               CurrentFrame(void) const { return currentFrame; }
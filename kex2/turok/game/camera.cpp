@@ -66,6 +66,30 @@ void kexCamera::UpdateAspect(void) {
 //
 
 void kexCamera::SetupMatrices(void) {
+    SetupMatrices(ViewRotation());
+}
+
+//
+// kexCamera::ViewRotation
+//
+
+kexQuat kexCamera::ViewRotation(void) {
+    kexQuat yaw(-(angles.yaw + offsetAngle.yaw) + M_PI, kexVec3::vecUp);
+    kexQuat pitch(angles.pitch + offsetAngle.pitch, kexVec3::vecRight);
+    kexQuat roll(angles.roll + offsetAngle.roll,
+        kexVec3(0, kexMath::Sin(angles.pitch), kexMath::Cos(angles.pitch)));
+
+    return (yaw * roll) * pitch;
+}
+
+//
+// kexCamera::SetupMatrices
+//
+// Builds the view from the given orientation rather than the
+// camera's angles, so the renderer can hand it a blended one
+//
+
+void kexCamera::SetupMatrices(const kexQuat &view) {
     UpdateAspect();
 
     // projection
@@ -80,12 +104,7 @@ void kexCamera::SetupMatrices(void) {
     // model
     modelMatrix.Identity();
 
-    kexQuat yaw(-(angles.yaw + offsetAngle.yaw) + M_PI, kexVec3::vecUp);
-    kexQuat pitch(angles.pitch + offsetAngle.pitch, kexVec3::vecRight);
-    kexQuat roll(angles.roll + offsetAngle.roll,
-        kexVec3(0, kexMath::Sin(angles.pitch), kexMath::Cos(angles.pitch)));
-
-    modelMatrix = kexMatrix((yaw * roll) * pitch);
+    modelMatrix = kexMatrix(view);
     rotMatrix = modelMatrix;
     modelMatrix.AddTranslation(-(origin * modelMatrix));
 
@@ -39,6 +39,8 @@ public:
     virtual void        Remove(void);
 
     void                SetupMatrices(void);
+    void                SetupMatrices(const kexQuat &view);
+    kexQuat             ViewRotation(void);
     void                UpdateAspect(void);
     kexVec3             ProjectPoint(kexVec3 &point,
                                      const int offsetX, const int offsetY);
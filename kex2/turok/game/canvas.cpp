@@ -187,6 +187,7 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
     float w;
     float h;
     byte a[4];
+    kexVec3 corners[4];
 
     if(bVisible == false) {
         return;
@@ -221,10 +222,21 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
     max[0] = w - (regX * 0.5f);
     max[1] = h - (regY * 0.5f);
 
+    // transformed here rather than on the matrix stack so images
+    // that share a texture end up in the same draw
+    corners[0].Set(min[0], min[1], 0);
+    corners[1].Set(max[0], min[1], 0);
+    corners[2].Set(min[0], max[1], 0);
+    corners[3].Set(max[0], max[1], 0);
+
+    for(i = 0; i < 4; i++) {
+        corners[i] *= matrix;
+    }
+
     cpuVertList.AddVertex(
-        min[0],
-        min[1],
-        0,
+        corners[0].x,
+        corners[0].y,
+        corners[0].z,
         0,
         0,
         rgba[0 * 4 + 0],
@@ -232,9 +244,9 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
         rgba[0 * 4 + 2],
         a[0]);
     cpuVertList.AddVertex(
-        max[0],
-        min[1],
-        0,
+        corners[1].x,
+        corners[1].y,
+        corners[1].z,
         1,
         0,
         rgba[1 * 4 + 0],
@@ -242,9 +254,9 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
         rgba[1 * 4 + 2],
         a[1]);
     cpuVertList.AddVertex(
-        min[0],
-        max[1],
-        0,
+        corners[2].x,
+        corners[2].y,
+        corners[2].z,
         0,
         1,
         rgba[2 * 4 + 0],
@@ -252,9 +264,9 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
         rgba[2 * 4 + 2],
         a[2]);
     cpuVertList.AddVertex(
-        max[0],
-        max[1],
-        0,
+        corners[3].x,
+        corners[3].y,
+        corners[3].z,
         1,
         1,
         rgba[3 * 4 + 0],
@@ -262,14 +274,10 @@ void kexCanvasImage::Draw(kexMatrix &curMatrix, const float &curAlpha) {
         rgba[3 * 4 + 2],
         a[3]);
 
-    dglPushMatrix();
-    dglMultMatrixf(matrix.ToFloatPtr());
-
     cpuVertList.AddTriangle(0, 1, 2);
     cpuVertList.AddTriangle(2, 1, 3);
 
     cpuVertList.DrawElementsNoShader();
-    dglPopMatrix();
 
     min *= matrix;
     max *= matrix;
@@ -471,6 +479,7 @@ void kexCanvasText::Draw(kexMatrix &curMatrix, const float &curAlpha) {
 
     matrix = mtx * curMatrix;
 
+    cpuVertList.Flush();
     dglPushMatrix();
     dglMultMatrixf(matrix.ToFloatPtr());
 
@@ -478,6 +487,7 @@ void kexCanvasText::Draw(kexMatrix &curMatrix, const float &curAlpha) {
     font->DrawString(text.c_str(), x, y, 0.5f, bCentered, (byte*)&color[0 * 4], (byte*)&color[2 * 4]);
     renderBackend.SetState(GLSTATE_BLEND, false);
 
+    cpuVertList.Flush();
     dglPopMatrix();
     
     float w = font->StringWidth(text.c_str(), 0.5f, 0);
@@ -799,6 +809,7 @@ void kexCanvas::Draw(void) {
     kexMatrix matrix;
     float _alpha = this->alpha;
 
+    cpuVertList.Flush();
     dglPushMatrix();
     matrix.SetOrtho(0, (float)FIXED_WIDTH, (float)FIXED_HEIGHT, 0, -1, 1);
     dglLoadMatrixf(matrix.ToFloatPtr());
@@ -809,6 +820,7 @@ void kexCanvas::Draw(void) {
         obj->Draw(matrix, _alpha);
     }
 
+    cpuVertList.Flush();
     dglPopMatrix();
 }
 
@@ -40,6 +40,7 @@ kexDisplayObject::kexDisplayObject(void) {
     this->bCulled       = false;
     this->displayType   = ODT_NORMAL;
     this->queryIndex    = -1;
+    this->bTransformDirty = true;
     
     this->attachment.SetOwner(this);
     this->scale.Set(1, 1, 1);
@@ -101,6 +102,42 @@ kexVec3 kexDisplayObject::TransformPoint(const float x, const float y, const flo
     return kexVec3(x, y, z) * matrix;
 }
 
+//
+// kexDisplayObject::TransformChanged
+//
+// Compares the transform against what it was last built from. Exact
+// compares are intended, any change at all has to rebuild
+//
+
+bool kexDisplayObject::TransformChanged(void) const {
+    return (
+        origin.x        != keyOrigin.x      ||
+        origin.y        != keyOrigin.y      ||
+        origin.z        != keyOrigin.z      ||
+        angles.yaw      != keyAngles.yaw    ||
+        angles.pitch    != keyAngles.pitch  ||
+        angles.roll     != keyAngles.roll   ||
+        rotation.x      != keyRotation.x    ||
+        rotation.y      != keyRotation.y    ||
+        rotation.z      != keyRotation.z    ||
+        rotation.w      != keyRotation.w    ||
+        scale.x         != keyScale.x       ||
+        scale.y         != keyScale.y       ||
+        scale.z         != keyScale.z);
+}
+
+//
+// kexDisplayObject::StoreTransformKey
+//
+
+void kexDisplayObject::StoreTransformKey(void) {
+    keyOrigin       = origin;
+    keyAngles       = angles;
+    keyRotation     = rotation;
+    keyScale        = scale;
+    bTransformDirty = false;
+}
+
 //
 // kexDisplayObject::UpdateTransform
 //
@@ -54,11 +54,14 @@ public:
     kexVec3                     TransformPoint(const float x, const float y, const float z);
 
     kexQuat                     &GetRotation(void) { return rotation; }
-    void                        SetRotation(const kexQuat &rot) { rotation = rot; }
+    void                        SetRotation(const kexQuat &rot) { rotation = rot; bTransformDirty = true; }
     kexVec3                     &GetScale(void) { return scale; }
-    void                        SetScale(const kexVec3 &s) { scale = s; }
+    void                        SetScale(const kexVec3 &s) { scale = s; bTransformDirty = true; }
+    void                        MarkTransformDirty(void) { bTransformDirty = true; }
     kexMatrix                   &Matrix(void) { return matrix; }
     kexMatrix                   &RotationMatrix(void) { return rotMatrix; }
+    kexVec3                     &PrevOrigin(void) { return prevOrigin; }
+    kexQuat                     &PrevRotation(void) { return prevRotation; }
     kexAttachment               &Attachment(void) { return attachment; }
     float                       &CullDistance(void) { return cullDistance; }
     int                         &DisplayType(void) { return displayType; }
@@ -109,13 +112,27 @@ public:
 protected:
     virtual void                EmitSound(const char *name);
 
+    bool                        TransformChanged(void) const;
+    void                        StoreTransformKey(void);
+
     kexQuat                     rotation;       // rotations in quaternions
     kexAttachment               attachment;     // attachment object
     float                       cullDistance;
     kexMatrix                   matrix;         // modelview matrix
     kexMatrix                   rotMatrix;
     kexVec3                     scale;
+    kexVec3                     prevOrigin;     // origin before the last client tick
+    kexQuat                     prevRotation;   // rotation before the last client tick
     int                         displayType;
+
+    // origin, angles and scale can be written through references from
+    // anywhere, so rather than trusting the setters the transform keeps
+    // a copy of what the matrix was last built from
+    bool                        bTransformDirty;
+    kexVec3                     keyOrigin;
+    kexAngle                    keyAngles;
+    kexQuat                     keyRotation;
+    kexVec3                     keyScale;
 END_CLASS();
 
 #endif
@@ -72,7 +72,6 @@ kexFx::kexFx(void) {
     this->attachment.SetOwner(this);
     this->physics.SetOwner(this);
     this->scale.Set(1, 1, 1);
-    this->worldLink.SetData(this);
 }
 
 //
@@ -692,21 +691,25 @@ void kexFxManager::Init(void) {
 //
 
 void kexFxManager::UpdateWorld(kexWorld *world) {
-    kexFx *tmpFx;
-
-    for(world->fxRover = world->fxList.Next(); world->fxRover != NULL; world->fxRover = tmpFx) {
-        tmpFx = world->fxRover->worldLink.Next();
+    // fx spawned during the loop are appended and ticked this frame
+    for(unsigned int i = 0; i < world->fxList.Length(); i++) {
+        if(!(world->fxRover = world->fxList[i])) {
+            continue;
+        }
 
         world->fxRover->LocalTick();
 
         if(world->fxRover->Removing()) {
             // unlink from world and free fx
-            world->fxRover->worldLink.Remove();
+            world->fxList.Remove(world->fxRover->Handle());
+            world->fxRover->Handle() = 0;
             world->fxRover->SetParent(NULL);
             world->fxRover->UnlinkArea();
             delete world->fxRover;
         }
     }
+
+    world->fxList.Compact();
 }
 
 //
@@ -733,7 +736,7 @@ void kexFxManager::ParseEvent(fxEvent_t *fxEvent, kexLexer *lexer) {
         else if(lexer->Matches("damageDef")) {
             lexer->ExpectNextToken(TK_EQUAL);
             lexer->GetString();
-            currentEvent->damageDef = defManager.FindDefEntry(lexer->StringToken());
+            currentEvent->damageDef = kexWorldObject::FindDamageDef(lexer->StringToken());
         }
         else if(lexer->TokenType() == TK_LSQBRACK) {
             int iType = lexer->GetNumber();
@@ -913,7 +916,8 @@ fxfile_t *kexFxManager::LoadKFX(const char *file) {
                         lexer->GetString();
                         info->textures[j] = renderBackend.CacheTexture(lexer->StringToken(),
                                                                       TC_CLAMP,
-                                                                      TF_LINEAR);
+                                                                      TF_LINEAR,
+                                                                      true);
                     }
                     lexer->ExpectNextToken(TK_RBRACK);
                     break;
@@ -70,7 +70,7 @@ typedef enum {
 typedef struct {
     char                        *fx;
     char                        *snd;
-    kexKeyMap                   *damageDef;
+    damageDef_t                 *damageDef;
 } fxEvent_t;
 
 class kexShaderObj;
@@ -186,7 +186,6 @@ public:
     kexFxPhysics                *Physics(void) { return &physics; }
     kexFx                       *GetParent(void) { return parent; }
 
-    kexLinklist<kexFx>          worldLink;
     fxinfo_t                    *fxInfo;
     fxfile_t                    *fxFile;
     bool                        bAnimate;
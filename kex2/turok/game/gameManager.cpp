@@ -38,8 +38,13 @@
 #include "renderBackend.h"
 #include "renderMain.h"
 #include "renderUtils.h"
+#include "renderWorld.h"
 #include "ai.h"
 #include "gui.h"
+#include "residency.h"
+
+kexCvar cvarLoadBudget("cl_loadbudget", CVF_INT|CVF_CONFIG, "8", 1, 100,
+                       "Milliseconds per frame spent loading a map during a level change");
 
 kexGameManager gameManager;
 
@@ -61,7 +66,7 @@ COMMAND(statgame) {
 
 COMMAND(startgame) {
     if(command.GetArgc() < 2) {
-        common.Printf("usage: startgame <map>\n");
+        common.Printf(LC_GAME, "usage: startgame <map>\n");
         return;
     }
 
@@ -80,6 +85,81 @@ COMMAND(pausegame) {
     gameManager.TogglePause(gameManager.IsPaused() ^ 1);
 }
 
+//
+// teststreamload
+//
+// Streams a map in the same slices a level change uses, without
+// drawing anything, and fails if any slice kept the main thread
+// for longer than the budget
+//
+
+COMMAND(teststreamload) {
+    kexStr mapFile;
+    uint64_t start;
+    double freq;
+    double ms;
+    double longest = 0;
+    int budget;
+    int frames = 0;
+    int overruns = 0;
+    bool bOk = true;
+
+    if(command.GetArgc() < 2) {
+        common.Printf(LC_GAME, "teststreamload <map id> <budget ms (optional)>\n");
+        return;
+    }
+
+    budget = cvarLoadBudget.GetInt();
+
+    if(command.GetArgc() >= 3) {
+        budget = atoi(command.GetArgv(2));
+    }
+
+    freq = (double)SDL_GetPerformanceFrequency();
+    mapFile = kva("maps/map%02d/map%02d", atoi(command.GetArgv(1)), atoi(command.GetArgv(1)));
+
+    localWorld.Unload();
+
+    // read ahead the way an exit trigger would
+    localWorld.StreamMap(mapFile.c_str());
+
+    if(!localWorld.BeginLoad(mapFile.c_str())) {
+        common.Warning(LC_GAME, "teststreamload: couldn't start loading %s\n", mapFile.c_str());
+        return;
+    }
+
+    while(localWorld.IsLoading()) {
+        start = sysMain.GetPerformanceCounter();
+
+        if(!localWorld.UpdateLoad(budget)) {
+            bOk = false;
+            break;
+        }
+
+        ms = (double)(sysMain.GetPerformanceCounter() - start) * 1000.0 / freq;
+
+        if(ms > longest) {
+            longest = ms;
+        }
+
+        if(ms > (double)budget) {
+            overruns++;
+        }
+
+        frames++;
+    }
+
+    common.Printf(LC_GAME, "%i frames, longest %.2fms, %i over the %ims budget\n",
+        frames, longest, overruns, budget);
+
+    if(overruns > 0) {
+        bOk = false;
+    }
+
+    common.CPrintf(LC_GAME, bOk ? COLOR_GREEN : COLOR_RED, "teststreamload %s\n",
+        bOk ? "passed" : "failed");
+}
+
 //
 // kexGameManager:: kexGameManager
 //
@@ -152,6 +232,14 @@ void kexGameManager::InitObject(void) {
                                                             void),
                                                  asCALL_THISCALL);
     
+    scriptManager.Engine()->RegisterObjectMethod("kGame",
+                                                 "void StreamMap(const int)",
+                                                 asMETHODPR(kexGameManager,
+                                                            StreamMap,
+                                                            (const int mapID),
+                                                            void),
+                                                 asCALL_THISCALL);
+
     scriptManager.Engine()->RegisterObjectMethod("kGame",
                                                  "void SetMainGui(const kStr &in)",
                                                  asMETHODPR(kexGameManager,
@@ -419,6 +507,8 @@ void kexGameManager::OnTick(void) {
 //
 // kexGameManager::OnLocalTick
 //
+// Runs one fixed step of the client-side simulation
+//
 
 void kexGameManager::OnLocalTick(void) {
     if(onLocalTick) {
@@ -432,6 +522,9 @@ void kexGameManager::OnLocalTick(void) {
     }
 
     if(!bPaused) {
+        // keep where everything was for interpolating
+        localWorld.SavePrevOrigins();
+
         // prep and send input information to server
         localPlayer.BuildCommands();
 
@@ -445,7 +538,25 @@ void kexGameManager::OnLocalTick(void) {
     if(bPrintStats) {
         gameTimeMS = sysMain.GetPerformanceCounter() - gameTimeMS;
     }
-    
+}
+
+//
+// kexGameManager::OnDrawFrame
+//
+// Called once per frame after the simulation has caught up. lerpFrac
+// is how far along the frame is between the last two steps
+//
+
+void kexGameManager::OnDrawFrame(const float lerpFrac) {
+    if(localWorld.IsLoading()) {
+        // the map draws once it's done loading
+        UpdateMapLoad();
+        return;
+    }
+
+    // nothing is moving while paused
+    renderWorld.SetLerpFraction(bPaused ? 1.0f : lerpFrac);
+
     // draw
     renderer.Draw();
     
@@ -453,6 +564,9 @@ void kexGameManager::OnLocalTick(void) {
     
     // update all sound sources
     soundSystem.UpdateListener();
+
+    // release whatever the new map didn't pick up once it has drawn a few frames
+    residency.Update();
 }
 
 //
@@ -531,7 +645,7 @@ void kexGameManager::ServerEvent(const int type, const ENetPacket *packet) {
             break;
             
         default:
-            common.Warning("Recieved unknown packet type: %i\n", type);
+            common.Warning(LC_GAME, "Recieved unknown packet type: %i\n", type);
             break;
     }
 }
@@ -555,7 +669,7 @@ void kexGameManager::ClientEvent(const int type, const ENetPacket *packet) {
             break;
             
         default:
-            common.Warning("Recieved unknown packet type: %i\n", type);
+            common.Warning(LC_GAME, "Recieved unknown packet type: %i\n", type);
             break;
     }
 }
@@ -584,7 +698,7 @@ bool kexGameManager::ConnectPlayer(ENetEvent *sev) {
             player->SetID(sev->peer->connectID);
             player->ResetTicCommand();
             
-            common.Printf("%s connected...\n", server.GetPeerAddress(sev));
+            common.Printf(LC_GAME, "%s connected...\n", server.GetPeerAddress(sev));
             
             // send the data to the local client
             packetManager.Write8(packet, sp_clientinfo);
@@ -683,12 +797,33 @@ void kexGameManager::PrepareMapChange(const ENetPacket *packet) {
     DrawWipe();
     
     localWorld.Unload();
-    if(!localWorld.Load(kva("maps/map%02d/map%02d", mapID, mapID))) {
+    if(!localWorld.BeginLoad(kva("maps/map%02d/map%02d", mapID, mapID))) {
         client.SetState(CL_STATE_READY);
         inputSystem->MouseActivate(true);
         return;
     }
-    
+
+    // the rest of the load is spread over the next frames by UpdateMapLoad
+}
+
+//
+// kexGameManager::UpdateMapLoad
+//
+// Gives the map that's being loaded its slice of the frame
+//
+
+void kexGameManager::UpdateMapLoad(void) {
+    if(!localWorld.UpdateLoad(cvarLoadBudget.GetInt())) {
+        client.SetState(CL_STATE_READY);
+        inputSystem->MouseActivate(true);
+        return;
+    }
+
+    if(localWorld.IsLoading()) {
+        renderBackend.DrawLoadingScreen(localWorld.LoadStatus());
+        return;
+    }
+
     client.SetState(CL_STATE_INGAME);
 
     inputSystem->MouseActivate(true);
@@ -697,6 +832,21 @@ void kexGameManager::PrepareMapChange(const ENetPacket *packet) {
     inputKey.Controls()->mousey = 0;
 }
 
+//
+// kexGameManager::StreamMap
+//
+// Starts reading a map ahead of time, such as when the player
+// walks into a level exit
+//
+
+void kexGameManager::StreamMap(const int mapID) {
+    if(mapID == localWorld.MapID()) {
+        return;
+    }
+
+    localWorld.StreamMap(kva("maps/map%02d/map%02d", mapID, mapID));
+}
+
 //
 // kexGameManager::ClientRequestMapChange
 //
@@ -736,7 +886,7 @@ void kexGameManager::SetupClientInfo(const ENetPacket *packet) {
     localPlayer.SetID(id);
 
     client.SetState(CL_STATE_READY);
-    common.DPrintf("kexGameManager::SetupClientInfo: ID is %i\n", id);
+    common.DPrintf(LC_GAME, "kexGameManager::SetupClientInfo: ID is %i\n", id);
     
     // load the initial map if playing a local/singleplayer game
     if(client.IsLocal() && gameManager.GameDef()) {
@@ -58,12 +58,14 @@ public:
     bool                    ProcessInput(const event_t *ev);
     void                    OnTick(void);
     void                    OnLocalTick(void);
+    void                    OnDrawFrame(const float lerpFrac);
     void                    ClientEvent(const int type, const ENetPacket *packet);
     void                    ServerEvent(const int type, const ENetPacket *packet);
     int                     GetPlayerID(ENetPeer *peer) const;
     bool                    ConnectPlayer(ENetEvent *sev);
     void                    NotifyMapChange(ENetEvent *sev, const int mapID);
     void                    ClientRequestMapChange(const int mapID);
+    void                    StreamMap(const int mapID);
     void                    PrintDebugStats(void);
     
     // screen wipe functions
@@ -95,6 +97,7 @@ public:
 private:
     void                    HandleMapChangeRequest(const ENetPacket *packet);
     void                    PrepareMapChange(const ENetPacket *packet);
+    void                    UpdateMapLoad(void);
     void                    SetupClientInfo(const ENetPacket *packet);
     
     asIScriptFunction       *onTick;
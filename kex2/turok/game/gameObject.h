@@ -25,6 +25,7 @@
 
 #include "common.h"
 #include "scriptAPI/component.h"
+#include "handleTable.h"
 
 //-----------------------------------------------------------------------------
 //
@@ -60,6 +61,7 @@ public:
     kexGameObject               *GetOwner(void) { return owner; }
     kexGameObject               *GetTarget(void) { return target; }
     unsigned int                &TargetID(void) { return targetID; }
+    objHandle_t                 &Handle(void) { return handle; }
     float                       &TimeStamp(void) { return timeStamp; }
     float                       &OldTimeStamp(void) { return oldTimeStamp; }
     float                       &FracTime(void) { return fracTime; }
@@ -119,6 +121,7 @@ protected:
     kexVec3                     origin;         // (xyz) position
     kexAngle                    angles;         // yaw, pitch, roll
     unsigned int                targetID;
+    objHandle_t                 handle;         // in the world's tables, 0 if not in the world
     kexGameObject               *owner;
     kexGameObject               *target;
     float                       timeStamp;
@@ -124,7 +124,7 @@ kexGui *kexGuiManager::LoadGui(const char *guiFile) {
     buffsize = fileSystem.OpenFile(guiFile, (byte**)(&buffer), hb_static);
     
     if(buffsize <= 0) {
-        common.Warning("kexGuiManager::LoadGui: %s not found\n", guiFile);
+        common.Warning(LC_GAME, "kexGuiManager::LoadGui: %s not found\n", guiFile);
         return NULL;
     }
     
@@ -142,7 +142,7 @@ kexGui *kexGuiManager::LoadGui(const char *guiFile) {
     XMLElement *root = xmldoc.RootElement();
     
     if(kexStr::Compare(root->Value(), "gui")) {
-        common.Warning("kexGuiManager::LoadGui: found root element '%s', expected 'gui'\n",
+        common.Warning(LC_GAME, "kexGuiManager::LoadGui: found root element '%s', expected 'gui'\n",
                        root->Value());
         return NULL;
     }
@@ -405,7 +405,7 @@ void kexGuiManager::ParseObject(XMLNode *node, kexGui *gui, kexContainer *contai
         kexCanvasScriptObject *cso = gui->canvas.CreateScriptObject(attrib->Value());
         
         if(cso == NULL) {
-            common.Warning("kexGuiManager::ParseNode: script class %s not found\n",
+            common.Warning(LC_GAME, "kexGuiManager::ParseNode: script class %s not found\n",
                            attrib->Value());
             return;
         }
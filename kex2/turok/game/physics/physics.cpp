@@ -61,6 +61,118 @@ static const sctokens_t physicsTokens[scPhysics_end+1] = {
 
 DECLARE_CLASS(kexPhysics, kexObject)
 
+bool kexPhysics::bFullThink = false;
+unsigned int kexPhysics::traceCount = 0;
+
+//
+// testphysics
+//
+// Runs every plain physics body on the loaded map through the same
+// ticks twice, once with the old trace pattern and once with the
+// slide early-out, ground reuse and sleeping, and checks that both
+// runs produce bit-identical origins and velocities on every tick.
+// Trace counts for both runs are printed
+//
+
+COMMAND(testphysics) {
+    kexArray<kexVec3> path;
+    kexArray<kexVec3> pathVelocity;
+    kexPhysics saved;
+    kexActor *actor;
+    kexPhysics *p;
+    kexVec3 origin;
+    unsigned int fullTraces = 0;
+    unsigned int traces = 0;
+    int bodies = 0;
+    int mismatches = 0;
+    int ticks = 60;
+    const float step = 1.0f / 60.0f;
+
+    if(!localWorld.IsLoaded()) {
+        common.Warning(LC_GAME, "testphysics: no map loaded\n");
+        return;
+    }
+
+    if(command.GetArgc() >= 2) {
+        ticks = atoi(command.GetArgv(1));
+    }
+
+    if(ticks <= 0) {
+        ticks = 60;
+    }
+
+    path.Resize(ticks);
+    pathVelocity.Resize(ticks);
+
+    for(unsigned int i = 0; i < localWorld.actors.Length(); i++) {
+        if(!(actor = localWorld.actors[i]) || actor->bStatic) {
+            continue;
+        }
+
+        p = actor->Physics();
+
+        // AI, player and fx bodies have their own Think
+        if(p == NULL || !p->bEnabled || p->GetInfo() != &kexPhysics::info) {
+            continue;
+        }
+
+        saved = *p;
+        origin = actor->GetOrigin();
+
+        kexPhysics::bFullThink = true;
+        kexPhysics::traceCount = 0;
+
+        for(int t = 0; t < ticks; t++) {
+            p->Think(step);
+            path[t] = actor->GetOrigin();
+            pathVelocity[t] = p->velocity;
+        }
+
+        fullTraces += kexPhysics::traceCount;
+
+        *p = saved;
+        actor->SetOrigin(origin);
+        actor->LinkArea();
+
+        kexPhysics::bFullThink = false;
+        kexPhysics::traceCount = 0;
+
+        for(int t = 0; t < ticks; t++) {
+            p->Think(step);
+
+            if( memcmp(&actor->GetOrigin(), &path[t], sizeof(kexVec3)) ||
+                memcmp(&p->velocity, &pathVelocity[t], sizeof(kexVec3))) {
+                common.Warning(LC_GAME, "testphysics: %s drifted on tick %i\n",
+                    actor->ClassName(), t);
+                mismatches++;
+                break;
+            }
+        }
+
+        traces += kexPhysics::traceCount;
+
+        *p = saved;
+        actor->SetOrigin(origin);
+        actor->LinkArea();
+
+        bodies++;
+    }
+
+    kexPhysics::bFullThink = false;
+
+    if(bodies == 0) {
+        common.Printf(LC_GAME, "testphysics: no physics bodies on this map\n");
+        return;
+    }
+
+    common.Printf(LC_GAME, "%i bodies, %i ticks\n", bodies, ticks);
+    common.Printf(LC_GAME, "old traces: %.2f per tick\n", (float)fullTraces / (float)ticks);
+    common.Printf(LC_GAME, "new traces: %.2f per tick\n", (float)traces / (float)ticks);
+
+    common.CPrintf(LC_GAME, mismatches == 0 ? COLOR_GREEN : COLOR_RED,
+        "testphysics %s\n", mismatches == 0 ? "passed" : "failed");
+}
+
 //
 // kexPhysics::kexPhysics
 //
@@ -82,14 +194,20 @@ kexPhysics::kexPhysics(void) {
     this->bInWater              = false;
     this->bClimbing             = false;
     this->bEnabled              = true;
+    this->bSleeping             = false;
     this->waterLevel            = WLT_INVALID;
     this->groundGeom            = NULL;
     this->groundMesh            = NULL;
     this->sector                = NULL;
+    this->groundSector          = NULL;
+    this->sleepSector           = NULL;
+    this->restTicks             = 0;
+    this->sleepChangeCount      = 0;
     this->clipFlags             = (PF_CLIPEDGES|PF_DROPOFF);
 
     this->rotorVector.Clear();
     this->velocity.Clear();
+    this->sleepOrigin.Clear();
 }
 
 //
@@ -449,6 +567,55 @@ float kexPhysics::GetWaterDepth(void) {
     return dist * 4;
 }
 
+//
+// kexPhysics::Wake
+//
+
+void kexPhysics::Wake(void) {
+    bSleeping = false;
+    restTicks = 0;
+}
+
+//
+// kexPhysics::Sleep
+//
+// Called once a body has been at rest for a few ticks. Only bodies
+// resting on a sector floor are put to sleep since a clip mesh could
+// belong to something that moves without telling us
+//
+
+void kexPhysics::Sleep(void) {
+    if(sector == NULL || groundMesh != NULL) {
+        return;
+    }
+
+    bSleeping = true;
+    sleepOrigin = owner->GetOrigin();
+    sleepSector = sector;
+    sleepChangeCount = localWorld.CollisionMap().ChangeCount();
+}
+
+//
+// kexPhysics::CanReuseGround
+//
+// The ground trace can be skipped if the last one landed on the floor
+// of the sector we're still standing in. Nothing can fit between the
+// body and the floor while it's on the ground, so the trace would just
+// find the same triangle again
+//
+
+bool kexPhysics::CanReuseGround(void) {
+    if(groundSector == NULL || groundSector != sector || groundMesh != NULL) {
+        return false;
+    }
+
+    if(!bOnGround || groundGeom != &sector->lowerTri) {
+        return false;
+    }
+
+    return sector->InRange(owner->GetOrigin());
+}
+
 //
 // kexPhysics::Think
 //
@@ -481,13 +648,33 @@ void kexPhysics::Think(const float timeDelta) {
 
     velocity += force;
 
+    if(bSleeping && !bFullThink) {
+        kexVec3 &org = owner->GetOrigin();
+
+        // stay asleep until pushed, moved or the floor changes
+        if( velocity.UnitSq() == 0 && force.UnitSq() == 0 &&
+            org.x == sleepOrigin.x && org.y == sleepOrigin.y && org.z == sleepOrigin.z &&
+            sector == sleepSector &&
+            localWorld.CollisionMap().ChangeCount() == sleepChangeCount) {
+            return;
+        }
+
+        Wake();
+    }
+
     if(velocity.UnitSq() <= 1 && OnGround()) {
         velocity.Clear();
         force.Clear();
         CorrectSectorPosition();
+
+        if(!bFullThink && ++restTicks >= SLEEP_TICKS) {
+            Sleep();
+        }
         return;
     }
 
+    restTicks = 0;
+
     currentMass = (bInWater && waterLevel >= WLT_BETWEEN) ? 0 : mass;
     start       = owner->GetOrigin();
     time        = timeDelta;
@@ -512,10 +699,20 @@ void kexPhysics::Think(const float timeDelta) {
     trace.dir = gravity;
 
     // need to determine if we're standing on the ground or not
-    localWorld.Trace(&trace, clipFlags);
-    if(trace.hitTri) {
-        groundGeom = trace.hitTri;
-        groundMesh = trace.hitMesh;
+    if(bFullThink || !CanReuseGround()) {
+        localWorld.Trace(&trace, clipFlags);
+        traceCount++;
+        if(trace.hitTri) {
+            groundGeom = trace.hitTri;
+            groundMesh = trace.hitMesh;
+        }
+
+        groundSector = NULL;
+
+        if( sector && trace.hitTri == &sector->lowerTri &&
+            trace.hitMesh == NULL && trace.hitActor == NULL) {
+            groundSector = sector;
+        }
     }
 
     if(bInWater && waterLevel >= WLT_BETWEEN) {
@@ -548,9 +745,15 @@ void kexPhysics::Think(const float timeDelta) {
 
         // trace through world
         localWorld.Trace(&trace, clipFlags);
+        traceCount++;
         time -= (time * trace.fraction);
         kexMath::Clamp(time, 0, timeDelta);
 
+        // brushed against something that isn't the floor
+        if(trace.hitMesh || trace.hitActor) {
+            groundSector = NULL;
+        }
+
         // project velocity
         if(trace.fraction != 1) {
             ImpactVelocity(velocity, trace.hitNormal, 1.024f);
@@ -569,6 +772,7 @@ void kexPhysics::Think(const float timeDelta) {
             trace.start = start - (gravity * (stepHeight * 0.5f));
             trace.end = start;
             localWorld.Trace(&trace, clipFlags);
+            traceCount++;
         
             if(trace.fraction != 1 && !trace.hitActor) {
                 start = trace.hitVector - (gravity * 1.024f);
@@ -576,6 +780,12 @@ void kexPhysics::Think(const float timeDelta) {
                 owner->LinkArea();
             }
         }
+
+        // the whole move was made, the remaining passes would
+        // only trace a zero length segment
+        if(time == 0 && !bFullThink) {
+            break;
+        }
     }
 
     ApplyFriction();
@@ -610,6 +820,7 @@ void kexPhysics::InitObject(void) {
     OBJMETHOD("float GroundDistance(void)", GroundDistance, (void), float);
     OBJMETHOD("float GetWaterDepth(void)", GetWaterDepth, (void), float);
     OBJMETHOD("kVec3 GroundNormal(void)", GroundNormal, (void), kexVec3);
+    OBJMETHOD("void Wake(void)", Wake, (void), void);
 
 #define OBJPROPERTY(str, p)                         \
     scriptManager.Engine()->RegisterObjectProperty( \
@@ -618,6 +829,7 @@ void kexPhysics::InitObject(void) {
         asOFFSET(kexPhysics, p))
 
     OBJPROPERTY("bool bEnabled", bEnabled);
+    OBJPROPERTY("const bool bSleeping", bSleeping);
     OBJPROPERTY("bool bRotor", bRotor);
     OBJPROPERTY("bool bOrientOnSlope", bOrientOnSlope);
     OBJPROPERTY("float friction", friction);
@@ -30,6 +30,7 @@
 
 #define ONPLANE_EPSILON     0.512f
 #define VELOCITY_EPSILON    0.0001f
+#define SLEEP_TICKS         8
 
 class kexWorldObject;
 class kexClipMesh;
@@ -84,6 +85,8 @@ public:
     void                    CheckWater(float height);
     kexVec3                 GroundNormal(void);
     bool                    CorrectSectorPosition(void);
+    void                    Wake(void);
+    const bool              IsSleeping(void) const { return bSleeping; }
 
     virtual void            Think(const float timeDelta);
 
@@ -119,10 +122,22 @@ public:
     bool                    bInWater;
     bool                    bClimbing;
     bool                    bEnabled;
+    bool                    bSleeping;
     unsigned int            clipFlags;
 
+    static bool             bFullThink;         // old trace pattern, for testphysics
+    static unsigned int     traceCount;
+
 protected:
+    bool                    CanReuseGround(void);
+    void                    Sleep(void);
+
     kexWorldObject          *owner;
+    kexSector               *groundSector;      // floor the last ground trace landed on
+    int                     restTicks;
+    kexVec3                 sleepOrigin;
+    kexSector               *sleepSector;
+    unsigned int            sleepChangeCount;
 END_CLASS();
 
 #endif
@@ -68,7 +68,7 @@ bool kexComponent::Spawn(const char *className) {
     type = scriptManager.Engine()->GetObjectTypeById(mod->GetTypeIdByDecl(className));
 
     if(type == NULL) {
-        common.Warning("kexComponent::Spawn: %s not found\n", className);
+        common.Warning(LC_SCRIPT, "kexComponent::Spawn: %s not found\n", className);
         return false;
     }
 
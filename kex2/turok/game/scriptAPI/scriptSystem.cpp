@@ -46,7 +46,7 @@ static kexHeapBlock hb_script("script", false, NULL, NULL);
 
 COMMAND(call) {
     if(command.GetArgc() < 2) {
-        common.Printf("Usage: call <\"function name\">\n");
+        common.Printf(LC_SCRIPT, "Usage: call <\"function name\">\n");
         return;
     }
     scriptManager.CallCommand(kva("void %s(void)", command.GetArgv(1)));
@@ -58,7 +58,7 @@ COMMAND(call) {
 
 COMMAND(callfile) {
     if(command.GetArgc() < 3) {
-        common.Printf("Usage: callfile <\"file name\"> <\"function name\">\n");
+        common.Printf(LC_SCRIPT, "Usage: callfile <\"file name\"> <\"function name\">\n");
         return;
     }
     scriptManager.CallExternalScript(command.GetArgv(1),
@@ -70,8 +70,8 @@ COMMAND(callfile) {
 //
 
 COMMAND(scriptmem) {
-    common.CPrintf(RGBA(0, 255, 255, 255), "Script Memory Usage:\n");
-    common.CPrintf(COLOR_YELLOW, "%ikb\n", kexHeap::Usage(hb_script) >> 10);
+    common.CPrintf(LC_SCRIPT, RGBA(0, 255, 255, 255), "Script Memory Usage:\n");
+    common.CPrintf(LC_SCRIPT, COLOR_YELLOW, "%ikb\n", kexHeap::Usage(hb_script) >> 10);
 }
 
 //
@@ -123,7 +123,7 @@ void kexScriptManager::MemFree(void *ptr) {
 void kexScriptManager::MessageCallback(const asSMessageInfo *msg, void *param) {
     switch(msg->type) {
     case asMSGTYPE_INFORMATION:
-        common.Printf("%s (%d, %d) : %s\n",
+        common.Printf(LC_SCRIPT, "%s (%d, %d) : %s\n",
             msg->section,
             msg->row,
             msg->col,
@@ -199,7 +199,7 @@ void kexScriptManager::Init(void) {
         }
     }
 
-    common.Printf("Script System Initialized\n");
+    common.Printf(LC_SCRIPT, "Script System Initialized\n");
 }
 
 //
@@ -207,7 +207,7 @@ void kexScriptManager::Init(void) {
 //
 
 void kexScriptManager::Shutdown(void) {
-    common.Printf("Shutting down scripting system\n");
+    common.Printf(LC_SCRIPT, "Shutting down scripting system\n");
 
     ctx->Release();
     engine->Release();
@@ -295,7 +295,7 @@ void kexScriptManager::CallExternalScript(const char *file, const char *function
     char *data = NULL;
 
     if((size = fileSystem.OpenExternalFile(file, (byte**)&data)) == -1) {
-        common.Warning("No file named %s\n", file);
+        common.Warning(LC_SCRIPT, "No file named %s\n", file);
         return;
     }
 
@@ -317,10 +317,10 @@ void kexScriptManager::CallExternalScript(const char *file, const char *function
             return;
         }
 
-        common.Warning("Execution of %s did not finish\n", function);
+        common.Warning(LC_SCRIPT, "Execution of %s did not finish\n", function);
         return;
     }
-    common.Warning("No function declared as %s\n", function);
+    common.Warning(LC_SCRIPT, "No function declared as %s\n", function);
 }
 
 //
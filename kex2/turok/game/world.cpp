@@ -37,6 +37,7 @@
 #include "defs.h"
 #include "worldModel.h"
 #include "renderWorld.h"
+#include "residency.h"
 
 #define FOG_LERP_SPEED      0.025f
 
@@ -78,6 +79,10 @@ kexWorld::kexWorld(void) {
     this->nextMapID         = -1;
     this->bLoaded           = false;
     this->bReadyUnload      = false;
+    this->loadState         = WLS_IDLE;
+    this->loadLexer         = NULL;
+    this->loadTime          = 0;
+    this->bLoadingStatics   = false;
     this->ticks             = 0;
     this->time              = 0;
     this->deltaTime         = 0;
@@ -121,8 +126,6 @@ const char *kexWorld::GetMapFileFromID(const int id) {
 //
 
 void kexWorld::Tick(void) {
-    kexActor *next;
-
     if(bLoaded == false) {
         return;
     }
@@ -136,10 +139,15 @@ void kexWorld::Tick(void) {
         return;
     }
 
-    for(actorRover = actors.Next(); actorRover != NULL; actorRover = next) {
-        next = actorRover->worldLink.Next();
+    // newest first like the old actor list. anything spawned by a tick
+    // lands past the starting length and waits for the next one
+    for(int i = (int)actors.Length() - 1; i >= 0; i--) {
+        // skipped without touching the actor itself
+        if(actors.HotAt(i).flags & (OHF_CLIENTONLY|OHF_STATIC)) {
+            continue;
+        }
 
-        if(actorRover->bClientOnly || actorRover->bStatic) {
+        if(!(actorRover = actors[i])) {
             continue;
         }
 
@@ -147,6 +155,7 @@ void kexWorld::Tick(void) {
         actorRover->FracTime() = 0;
         actorRover->TimeStamp() = deltaTime;
         actorRover->Tick();
+        actorRover->StoreHot(actors.HotAt(i));
     }
 }
 
@@ -156,7 +165,6 @@ void kexWorld::Tick(void) {
 
 void kexWorld::LocalTick(void) {
     float cfrac;
-    kexActor *next;
 
     if(bLoaded == false) {
         return;
@@ -181,12 +189,16 @@ void kexWorld::LocalTick(void) {
         return;
     }
 
-    for(actorRover = actors.Next(); actorRover != NULL; actorRover = next) {
-        next = actorRover->worldLink.Next();
+    // newest first, see Tick
+    for(int i = (int)actors.Length() - 1; i >= 0; i--) {
+        if(!(actorRover = actors[i])) {
+            continue;
+        }
+
         actorRover->LocalTick();
 
         if(actorRover == NULL) {
-            common.Warning("kexWorld::LocalTick: actorRover went null for some odd reason\n");
+            common.Warning(LC_GAME, "kexWorld::LocalTick: actorRover went null for some odd reason\n");
             continue;
         }
 
@@ -207,7 +219,55 @@ void kexWorld::LocalTick(void) {
         }
     }
 
+    actors.Compact();
     fxManager.UpdateWorld(this);
+
+    RefreshHot();
+}
+
+//
+// kexWorld::RefreshHot
+//
+// Copies what the renderer and the next tick look at into the packed
+// arrays, after every actor has had the chance to change
+//
+
+void kexWorld::RefreshHot(void) {
+    for(unsigned int i = 0; i < actors.Length(); i++) {
+        if(actors[i]) {
+            actors[i]->StoreHot(actors.HotAt(i));
+        }
+    }
+
+    for(unsigned int i = 0; i < fxList.Length(); i++) {
+        if(fxList[i]) {
+            fxList[i]->StoreHot(fxList.HotAt(i));
+        }
+    }
+}
+
+//
+// kexWorld::SavePrevOrigins
+//
+// Called before each client tick so the renderer can blend
+// between where things were and where they are now. Rotations
+// are kept along with the origins
+//
+
+void kexWorld::SavePrevOrigins(void) {
+    if(bLoaded == false) {
+        return;
+    }
+
+    camera.PrevOrigin() = camera.GetOrigin();
+    camera.PrevRotation() = camera.ViewRotation();
+
+    for(unsigned int i = 0; i < actors.Length(); i++) {
+        if(actors[i]) {
+            actors[i]->PrevOrigin() = actors[i]->GetOrigin();
+            actors[i]->PrevRotation() = actors[i]->GetRotation();
+        }
+    }
 }
 
 //
@@ -244,7 +304,7 @@ kexActor *kexWorld::ConstructActor(const char *className) {
 //
 
 void kexWorld::AddActor(kexActor *actor) {
-    actor->worldLink.Add(actors);
+    actor->Handle() = actors.Add(actor);
 
     if(actor->GetName().Length() <= 0) {
         kexStr tmp(kva("%s_%i", actor->ClassName(), kexActor::id));
@@ -252,6 +312,9 @@ void kexWorld::AddActor(kexActor *actor) {
     }
 
     actor->CallSpawn();
+    actor->PrevOrigin() = actor->GetOrigin();
+    actor->PrevRotation() = actor->GetRotation();
+    actor->StoreHot(*actors.Hot(actor->Handle()));
 }
 
 //
@@ -261,7 +324,8 @@ void kexWorld::AddActor(kexActor *actor) {
 void kexWorld::RemoveActor(kexActor *actor) {
     actor->SetOwner(NULL);
     actor->SetTarget(NULL);
-    actor->worldLink.Remove();
+    actors.Remove(actor->Handle());
+    actor->Handle() = 0;
     actor->UnlinkArea();
     delete actor;
 }
@@ -288,6 +352,10 @@ void kexWorld::TeleportActor(kexActor *actor, const kexVec3 &position,
     actor->SetOrigin(position);
     actor->SetAngles(angle);
 
+    // don't blend across the teleport
+    actor->PrevOrigin() = position;
+    actor->PrevRotation() = actor->GetAngles().ToQuat();
+
     actor->LinkArea();
 
     if(actor->Physics()->sector) {
@@ -418,8 +486,8 @@ kexFx *kexWorld::SpawnFX(const char *name, kexGameObject *source, kexVec3 &veloc
 
         // allow only one FX instance to be spawned per actor
         if(source && info->bActorInstance) {
-            for(fxRover = fxList.Next(); fxRover != NULL; fxRover = fxRover->worldLink.Next()) {
-                if(!fxRover->GetOwner()) {
+            for(unsigned int k = 0; k < fxList.Length(); k++) {
+                if(!(fxRover = fxList[k]) || !fxRover->GetOwner()) {
                     continue;
                 }
                 if(fxRover->IsStale() || fxRover->Removing()) {
@@ -462,8 +530,9 @@ kexFx *kexWorld::SpawnFX(const char *name, kexGameObject *source, kexVec3 &veloc
                 fx->SetParent(parentFx);
             }
 
-            fx->worldLink.AddBefore(fxList);
+            fx->Handle() = fxList.Add(fx);
             fx->CallSpawn();
+            fx->StoreHot(*fxList.Hot(fx->Handle()));
         }
     }
 
@@ -484,11 +553,12 @@ void kexWorld::SpawnFX(const kexStr &str, kexGameObject *source, kexVec3 &veloci
 //
 
 void kexWorld::SpawnLocalPlayer(void) {
-    for(kexActor *actor = actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-        
+    // newest first, which is the order the old actor list was in
+    for(int i = (int)actors.Length() - 1; i >= 0; i--) {
+        kexActor *actor = actors[i];
+
         // find a kexPlayerPuppet and see if its not occupied
-        if(actor->GetOwner() != NULL || !actor->InstanceOf(&kexPlayerPuppet::info)) {
+        if(actor == NULL || actor->GetOwner() != NULL || !actor->InstanceOf(&kexPlayerPuppet::info)) {
             continue;
         }
 
@@ -676,17 +746,18 @@ void kexWorld::SetFogRGB(float r, float g, float b) {
 //
 
 void kexWorld::TriggerActor(const int targetID) {
-    for(actorRover = actors.Next(); actorRover != NULL;
-        actorRover = actorRover->worldLink.Next()) {
-            if(actorRover->bStatic) {
-                continue;
-            }
-            if(actorRover->Removing()) {
-                continue;
-            }
-            if(actorRover->TargetID() == targetID) {
-                actorRover->OnTrigger();
-            }
+    // newest first, actors spawned by a trigger aren't triggered
+    // along with it
+    for(int i = (int)actors.Length() - 1; i >= 0; i--) {
+        if(!(actorRover = actors[i]) || actorRover->bStatic) {
+            continue;
+        }
+        if(actorRover->Removing()) {
+            continue;
+        }
+        if(actorRover->TargetID() == targetID) {
+            actorRover->OnTrigger();
+        }
     }
 }
 
@@ -695,17 +766,16 @@ void kexWorld::TriggerActor(const int targetID) {
 //
 
 kexActor *kexWorld::GetActorByName(const char *name) {
-    for(actorRover = actors.Next(); actorRover != NULL;
-        actorRover = actorRover->worldLink.Next()) {
-            if(actorRover->bStatic) {
-                continue;
-            }
-            if(actorRover->Removing()) {
-                continue;
-            }
-            if(!strcmp(actorRover->GetName().c_str(), name)) {
-                return actorRover;
-            }
+    for(int i = (int)actors.Length() - 1; i >= 0; i--) {
+        if(!(actorRover = actors[i]) || actorRover->bStatic) {
+            continue;
+        }
+        if(actorRover->Removing()) {
+            continue;
+        }
+        if(!strcmp(actorRover->GetName().c_str(), name)) {
+            return actorRover;
+        }
     }
 
     return NULL;
@@ -726,44 +796,80 @@ kexActor *kexWorld::GetActorByName(const kexStr &name) {
 void kexWorld::BuildAreaNodes(void) {
     areaNodes.Init(8);
 
-    for(kexWorldModel *wm = staticActors.Next(); wm != NULL;
-        wm = wm->worldLink.Next()) {
-            if(wm->bStatic == false || wm->bCollision == false) {
-                continue;
-            }
+    for(unsigned int i = 0; i < staticActors.Length(); i++) {
+        objectHot_t &hot = staticActors.HotAt(i);
+
+        if(!(hot.flags & OHF_STATIC) || !(hot.flags & OHF_COLLISION)) {
+            continue;
+        }
 
-            areaNodes.AddBoxToRoot(wm->Bounds());
+        areaNodes.AddBoxToRoot(hot.bounds);
     }
 
     areaNodes.BuildNodes();
 
-    for(actorRover = actors.Next(); actorRover != NULL;
-        actorRover = actorRover->worldLink.Next()) {
-            actorRover->LinkArea();
+    for(unsigned int i = 0; i < actors.Length(); i++) {
+        if(actors[i]) {
+            actors[i]->LinkArea();
+        }
     }
 
-    for(kexWorldModel *wm = staticActors.Next();
-        wm != NULL; wm = wm->worldLink.Next()) {
-            if(wm->bCollision == false) {
-                continue;
-            }
+    for(unsigned int i = 0; i < staticActors.Length(); i++) {
+        if(!(staticActors.HotAt(i).flags & OHF_COLLISION)) {
+            continue;
+        }
 
-            wm->LinkArea();
+        staticActors[i]->LinkArea();
     }
 }
 
 //
 // kexWorld::Load
 //
+// Loads a map in one go
+//
 
 bool kexWorld::Load(const char *mapFile) {
-    int loadtime;
+    if(!BeginLoad(mapFile)) {
+        return false;
+    }
 
-    if(client.GetState() < CL_STATE_READY || bLoaded) {
+    while(IsLoading()) {
+        renderBackend.DrawLoadingScreen(LoadStatus());
+
+        if(!UpdateLoad(0)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// kexWorld::StreamMap
+//
+// Starts reading a map's files in the background, ahead of
+// the map change that will load it
+//
+
+void kexWorld::StreamMap(const char *mapFile) {
+    stream.Begin(mapFile);
+}
+
+//
+// kexWorld::BeginLoad
+//
+// Starts loading a map. UpdateLoad has to be called until
+// IsLoading returns false
+//
+
+bool kexWorld::BeginLoad(const char *mapFile) {
+    if(client.GetState() < CL_STATE_READY || bLoaded || loadState != WLS_IDLE) {
         return false;
     }
 
     kexRand::SetSeed(-470403613);
+    kexHeap::MarkSites(HM_MAP);
     bLoaded = false;
     bReadyUnload = false;
     ticks = 0;
@@ -771,109 +877,243 @@ bool kexWorld::Load(const char *mapFile) {
     worldLightOrigin.Set(0, 0, 0, 0);
     worldLightColor.Set(1, 1, 1, 1);
     worldLightAmbience.Set(1, 1, 1, 1);
-    
-    kexLexer *lexer;
-    kexActor *actor;
-    kexWorldModel *wm;
-    kexStr file(mapFile);
 
-    loadtime = sysMain.GetMS();
-    common.Printf("Load map: %s\n", mapFile);
+    loadFile = mapFile;
+    loadTime = sysMain.GetMS();
+    loadLexer = NULL;
+    bLoadingStatics = false;
 
-    renderBackend.DrawLoadingScreen("Loading Collision...");
-    collisionMap.Load((file + ".kclm").c_str());
-    
-    if(!(lexer = parser.Open((file + ".kmap").c_str()))) {
-        return false;
+    common.Printf(LC_GAME, "Load map: %s\n", mapFile);
+
+    residency.BeginMap();
+    stream.Begin(mapFile);
+
+    loadState = WLS_STREAMING;
+    return true;
+}
+
+//
+// kexWorld::UpdateLoad
+//
+// Carries on with the current load for up to budget milliseconds,
+// or to the end if budget is zero. The collision map and each map
+// object are loaded in one go so a step can run over. Returns
+// false if the map couldn't be loaded
+//
+
+bool kexWorld::UpdateLoad(const int budget) {
+    int deadline = 0;
+
+    if(budget > 0) {
+        deadline = sysMain.GetMS() + budget;
     }
 
-    renderBackend.DrawLoadingScreen("Loading Objects...");
+    while(loadState != WLS_IDLE) {
+        if(deadline && sysMain.GetMS() >= deadline) {
+            break;
+        }
 
-    // begin parsing
-    while(lexer->CheckState()) {
-        lexer->Find();
-        
-        switch(lexer->TokenType()) {
-        case TK_NONE:
-        case TK_EOF:
+        switch(loadState) {
+        case WLS_STREAMING:
+            if(!stream.Commit(deadline)) {
+                return true;
+            }
+
+            loadState = WLS_COLLISION;
             break;
-        case TK_IDENIFIER:
-            switch(lexer->GetIDForTokenList(maptokens, lexer->Token())) {
-            case scmap_title:
-                lexer->ExpectNextToken(TK_EQUAL);
-                lexer->GetString();
-                title = lexer->StringToken();
-                break;
-            case scmap_mapID:
-                lexer->AssignFromTokenList(maptokens, (unsigned int*)&mapID,
-                    scmap_mapID, false);
-                break;
-            case scmap_glight_origin:
-                lexer->AssignVectorFromTokenList(maptokens,
-                    worldLightOrigin.ToVec3(), scmap_glight_origin, false);
-                break;
-            case scmap_glight_color:
-                lexer->AssignVectorFromTokenList(maptokens,
-                    worldLightColor.ToVec3(), scmap_glight_color, false);
-                break;
-            case scmap_glight_ambience:
-                lexer->AssignVectorFromTokenList(maptokens,
-                    worldLightAmbience.ToVec3(), scmap_glight_ambience, false);
-                break;
-            case scmap_actor:
-                lexer->GetString();
-                actor = ConstructActor(lexer->StringToken());
-                actor->Parse(lexer);
-                AddActor(actor);
-                break;
-            case scmap_staticActors:
-                // read into nested block
-                lexer->ExpectNextToken(TK_LBRACK);
-                lexer->Find();
-                while(lexer->TokenType() != TK_RBRACK) {
-                    switch(lexer->GetIDForTokenList(maptokens, lexer->Token())) {
-                    case scmap_actor:
-                        lexer->GetString();
-                        wm = static_cast<kexWorldModel*>(ConstructObject("kexWorldModel"));
-                        wm->Parse(lexer);
-                        wm->worldLink.Add(staticActors);
-                        wm->CallSpawn();
-                        break;
-                    default:
-                        if(lexer->TokenType() == TK_IDENIFIER) {
-                            parser.Error("kexWorld::Load: unknown token: %s\n",
-                                lexer->Token());
-                        }
-                        break;
-                    }
-                    lexer->Find();
-                }
 
-                break;
-            default:
-                if(lexer->TokenType() == TK_IDENIFIER) {
-                    parser.Error("kexWorld::Load: unknown token: %s\n",
-                        lexer->Token());
-                }
+        case WLS_COLLISION:
+            collisionMap.Load((loadFile + ".kclm").c_str());
+
+            if(!(loadLexer = parser.Open((loadFile + ".kmap").c_str()))) {
+                // drop the collision map that was just loaded
+                AbortLoad();
+                bLoaded = true;
+                Unload();
+                return false;
+            }
+
+            loadState = WLS_OBJECTS;
+            break;
+
+        case WLS_OBJECTS:
+            if(!loadLexer->CheckState()) {
+                parser.Close();
+                loadLexer = NULL;
+                loadState = WLS_FINISH;
                 break;
             }
+
+            ParseMapToken(loadLexer);
+            break;
+
+        case WLS_FINISH:
+            FinishLoad();
+            break;
+
+        default:
             break;
         }
     }
 
-    parser.Close();
-    
+    return true;
+}
+
+//
+// kexWorld::LoadStatus
+//
+
+const char *kexWorld::LoadStatus(void) {
+    switch(loadState) {
+    case WLS_STREAMING:
+        return kva("Streaming... (%i files)", stream.NumFiles());
+    case WLS_COLLISION:
+        return "Loading Collision...";
+    case WLS_OBJECTS:
+    case WLS_FINISH:
+        return "Loading Objects...";
+    default:
+        break;
+    }
+
+    return "";
+}
+
+//
+// kexWorld::AbortLoad
+//
+// Stops a load part way through. Returns true if anything
+// was already spawned and has to be unloaded
+//
+
+bool kexWorld::AbortLoad(void) {
+    bool bSpawned = (loadState >= WLS_COLLISION);
+
+    if(loadState == WLS_IDLE) {
+        return false;
+    }
+
+    if(loadLexer) {
+        parser.Close();
+        loadLexer = NULL;
+    }
+
+    stream.Cancel();
+    residency.EndMap();
+
+    loadState = WLS_IDLE;
+    return bSpawned;
+}
+
+//
+// kexWorld::ParseMapToken
+//
+
+void kexWorld::ParseMapToken(kexLexer *lexer) {
+    kexActor *actor;
+    kexWorldModel *wm;
+
+    lexer->Find();
+
+    if(bLoadingStatics) {
+        // one static actor at a time until the block is closed
+        if(lexer->TokenType() == TK_RBRACK) {
+            bLoadingStatics = false;
+            return;
+        }
+
+        switch(lexer->GetIDForTokenList(maptokens, lexer->Token())) {
+        case scmap_actor:
+            lexer->GetString();
+            wm = static_cast<kexWorldModel*>(ConstructObject("kexWorldModel"));
+            wm->Parse(lexer);
+            wm->Handle() = staticActors.Add(wm);
+            wm->CallSpawn();
+            wm->StoreHot(*staticActors.Hot(wm->Handle()));
+            break;
+        default:
+            if(lexer->TokenType() == TK_IDENIFIER) {
+                parser.Error("kexWorld::Load: unknown token: %s\n",
+                    lexer->Token());
+            }
+            break;
+        }
+
+        return;
+    }
+
+    switch(lexer->TokenType()) {
+    case TK_NONE:
+    case TK_EOF:
+        break;
+    case TK_IDENIFIER:
+        switch(lexer->GetIDForTokenList(maptokens, lexer->Token())) {
+        case scmap_title:
+            lexer->ExpectNextToken(TK_EQUAL);
+            lexer->GetString();
+            title = lexer->StringToken();
+            break;
+        case scmap_mapID:
+            lexer->AssignFromTokenList(maptokens, (unsigned int*)&mapID,
+                scmap_mapID, false);
+            break;
+        case scmap_glight_origin:
+            lexer->AssignVectorFromTokenList(maptokens,
+                worldLightOrigin.ToVec3(), scmap_glight_origin, false);
+            break;
+        case scmap_glight_color:
+            lexer->AssignVectorFromTokenList(maptokens,
+                worldLightColor.ToVec3(), scmap_glight_color, false);
+            break;
+        case scmap_glight_ambience:
+            lexer->AssignVectorFromTokenList(maptokens,
+                worldLightAmbience.ToVec3(), scmap_glight_ambience, false);
+            break;
+        case scmap_actor:
+            lexer->GetString();
+            actor = ConstructActor(lexer->StringToken());
+            actor->Parse(lexer);
+            AddActor(actor);
+            break;
+        case scmap_staticActors:
+            // read into nested block
+            lexer->ExpectNextToken(TK_LBRACK);
+            bLoadingStatics = true;
+            break;
+        default:
+            if(lexer->TokenType() == TK_IDENIFIER) {
+                parser.Error("kexWorld::Load: unknown token: %s\n",
+                    lexer->Token());
+            }
+            break;
+        }
+        break;
+    }
+}
+
+//
+// kexWorld::FinishLoad
+//
+
+void kexWorld::FinishLoad(void) {
     nextMapID = -1;
     bLoaded = true;
+    loadState = WLS_IDLE;
 
-    common.Printf("Load time: %f seconds\n",
-        ((float)sysMain.GetMS() - (float)loadtime) / 1000.0f);
+    common.Printf(LC_GAME, "Load time: %f seconds\n",
+        ((float)sysMain.GetMS() - (float)loadTime) / 1000.0f);
 
     BuildAreaNodes();
     renderWorld.BuildNodes();
     
     SpawnLocalPlayer();
-    return true;
+
+    stream.CacheSounds();
+    stream.DropUnopened();
+
+    // the map's textures have to be up before its first frame
+    textureLoader.Finish();
+    residency.EndMap();
 }
 
 //
@@ -884,16 +1124,18 @@ void kexWorld::Unload(void) {
     kexLocalPlayer *localPlayer;
     kexActor *actor;
     kexWorldModel *wm;
-    kexActor *next;
-    kexWorldModel *nextWm;
-    kexFx *nextFx;
+
+    if(AbortLoad()) {
+        // clean up whatever the load got to
+        bLoaded = true;
+    }
 
     if(bLoaded == false) {
         // nothing is currently loaded
         return;
     }
 
-    common.Printf("Unloading %s\n", title.c_str());
+    common.Printf(LC_GAME, "Unloading %s\n", title.c_str());
     
     bLoaded = false;
     
@@ -910,34 +1152,54 @@ void kexWorld::Unload(void) {
         collisionMap.Unload();
     }
     
-    // remove all fx
-    for(fxRover = fxList.Next(); fxRover != NULL; fxRover = nextFx) {
-        nextFx = fxRover->worldLink.Prev();
+    // remove all fx, newest first
+    for(int i = (int)fxList.Length() - 1; i >= 0; i--) {
+        if(!(fxRover = fxList[i])) {
+            continue;
+        }
 
         fxRover->SetParent(NULL);
-        fxRover->worldLink.Remove();
+        fxList.Remove(fxRover->Handle());
+        fxRover->Handle() = 0;
         fxRover->UnlinkArea();
 
         delete fxRover;
     }
 
     // remove all actors
-    for(actor = actors.Next(); actor != NULL; actor = next) {
-        next = actor->worldLink.Next();
-        RemoveActor(actor);
+    for(unsigned int i = 0; i < actors.Length(); i++) {
+        if((actor = actors[i])) {
+            RemoveActor(actor);
+        }
     }
     
     // remove all static actors
-    for(wm = staticActors.Next(); wm != NULL; wm = nextWm) {
-        nextWm = wm->worldLink.Next();
+    for(unsigned int i = 0; i < staticActors.Length(); i++) {
+        if(!(wm = staticActors[i])) {
+            continue;
+        }
 
-        wm->worldLink.Remove();
+        staticActors.Remove(wm->Handle());
+        wm->Handle() = 0;
         delete wm;
     }
 
     fxList.Clear();
     actors.Clear();
     staticActors.Clear();
+
+    if(kexHeap::bProfiling) {
+        // objects should all be gone by now and anything left in the
+        // world block is only being cleaned up by the purge
+        common.Printf(LC_GAME, "allocations outliving %s:\n", title.c_str());
+
+        int numSites = kexHeap::PrintSites(&hb_object, 16, HM_MAP);
+        numSites += kexHeap::PrintSites(&hb_world, 16, HM_MAP);
+
+        if(numSites == 0) {
+            common.Printf(LC_GAME, "none\n");
+        }
+    }
     
     Mem_Purge(hb_world);
 
@@ -30,6 +30,15 @@
 #include "fx.h"
 #include "collisionMap.h"
 #include "sdNodes.h"
+#include "worldStream.h"
+
+typedef enum {
+    WLS_IDLE    = 0,
+    WLS_STREAMING,
+    WLS_COLLISION,
+    WLS_OBJECTS,
+    WLS_FINISH
+} worldLoadState_t;
 
 //-----------------------------------------------------------------------------
 //
@@ -45,7 +54,13 @@ public:
     void                                Init(void);
     void                                Tick(void);
     void                                LocalTick(void);
+    void                                SavePrevOrigins(void);
     bool                                Load(const char *mapFile);
+    void                                StreamMap(const char *mapFile);
+    bool                                BeginLoad(const char *mapFile);
+    bool                                UpdateLoad(const int budget);
+    const char                          *LoadStatus(void);
+    void                                StopStreaming(void) { stream.Cancel(); }
     void                                Unload(void);
     const char                          *GetMapFileFromID(const int id);
     kexObject                           *ConstructObject(const char *className);
@@ -74,8 +89,11 @@ public:
     void                                TriggerActor(const int targetID);
     kexActor                            *GetActorByName(const char *name);
     kexActor                            *GetActorByName(const kexStr &name);
+    kexActor                            *GetActor(const objHandle_t handle) { return actors.Get(handle); }
+    void                                RefreshHot(void);
 
     bool                                IsLoaded(void) const { return bLoaded; }
+    bool                                IsLoading(void) const { return loadState != WLS_IDLE; }
     float                               DeltaTime(void) { return deltaTime; }
     kexCamera                           *Camera(void) { return &camera; };
     kexCollisionMap                     &CollisionMap(void) { return collisionMap; }
@@ -95,9 +113,10 @@ public:
     const int                           MapID(void) const { return mapID; }
     int                                 &NextMapID(void) { return nextMapID; }
 
-    kexLinklist<kexActor>               actors;
-    kexLinklist<kexWorldModel>          staticActors;
-    kexLinklist<kexFx>                  fxList;
+    // dense, may contain NULL holes until the next compact
+    kexHandleTable<kexActor, objectHot_t>       actors;
+    kexHandleTable<kexWorldModel, objectHot_t>  staticActors;
+    kexHandleTable<kexFx, objectHot_t>          fxList;
 
     kexActor                            *actorRover;
     kexFx                               *fxRover;
@@ -115,10 +134,19 @@ public:
 
 private:
     void                                BuildAreaNodes(void);
+    void                                ParseMapToken(kexLexer *lexer);
+    void                                FinishLoad(void);
+    bool                                AbortLoad(void);
     void                                TraverseAreaNodes(traceInfo_t *trace, kexSDNodeObj<kexWorldObject> *areaNode);
 
     bool                                bLoaded;
     bool                                bReadyUnload;
+    worldLoadState_t                    loadState;
+    kexStr                              loadFile;
+    kexLexer                            *loadLexer;
+    int                                 loadTime;
+    bool                                bLoadingStatics;
+    kexWorldStream                      stream;
     int                                 mapID;
     int                                 nextMapID;
     kexStr                              title;
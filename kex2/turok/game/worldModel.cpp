@@ -81,12 +81,12 @@ kexWorldModel::kexWorldModel(void) {
     this->baseBBox.min.Set(-32, -32, -32);
     this->baseBBox.max.Set(32, 32, 32);
 
-    this->worldLink.SetData(this);
     this->renderNode.link.SetData(this);
     this->clipMesh.SetOwner(this);
 
     this->bbox              = baseBBox;
     this->bTraced           = false;
+    this->bBatched          = false;
     this->validcount        = 0;
     this->materials         = NULL;
     this->wireframeColor    = RGBA(0, 224, 224, 255);
@@ -56,9 +56,9 @@ public:
     // TODO - need some sort of skin system
     kexMaterial                     **materials;
     bool                            bTraced;
+    bool                            bBatched;       // drawn as part of a static batch
     int                             validcount;
 
-    kexLinklist<kexWorldModel>      worldLink;
     kexSDNodeRef<kexWorldModel>     renderNode;
 
 protected:
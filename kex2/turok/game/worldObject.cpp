@@ -26,11 +26,14 @@
 
 #include "common.h"
 #include "worldObject.h"
+#include "worldModel.h"
 #include "world.h"
 #include "defs.h"
 
 DECLARE_ABSTRACT_CLASS(kexWorldObject, kexDisplayObject)
 
+kexHashList<damageDef_t> kexWorldObject::damageDefs;
+
 //
 // kexWorldObject::kexWorldObject
 //
@@ -72,6 +75,7 @@ kexWorldObject::~kexWorldObject(void) {
 void kexWorldObject::SetBoundingBox(const kexVec3 &min, const kexVec3 &max) {
     baseBBox.min = min;
     baseBBox.max = max;
+    bTransformDirty = true;
 }
 
 //
@@ -233,7 +237,34 @@ bool kexWorldObject::TryMove(const kexVec3 &position, kexVec3 &dest, kexSector *
 void kexWorldObject::SetShaderParam(const int index, const float value) {
     assert(index >= 0 && index < 4);
 
+    if(shaderParams[index] == value) {
+        return;
+    }
+
     shaderParams[index] = value;
+
+    // a static batch draws with the params its objects had when it was
+    // built, so this one has to be drawn on its own from now on
+    if(InstanceOf(&kexWorldModel::info)) {
+        static_cast<kexWorldModel*>(this)->bBatched = false;
+    }
+}
+
+//
+// kexWorldObject::StoreHot
+//
+
+void kexWorldObject::StoreHot(objectHot_t &hot) {
+    hot.bounds = bbox;
+    hot.origin = origin;
+    hot.cullDistance = cullDistance;
+    hot.displayType = displayType;
+    hot.flags =
+        (bStatic        ? OHF_STATIC : 0)       |
+        (bClientOnly    ? OHF_CLIENTONLY : 0)   |
+        (bHidden        ? OHF_HIDDEN : 0)       |
+        (bCollision     ? OHF_COLLISION : 0)    |
+        (bTouch         ? OHF_TOUCH : 0);
 }
 
 //
@@ -266,46 +297,285 @@ float kexWorldObject::ObjectDistance(kexWorldObject *obj, const kexVec3 &offset)
 // kexWorldObject::InflictDamage
 //
 
-void kexWorldObject::InflictDamage(kexWorldObject *target, kexKeyMap *damageDef) {
+void kexWorldObject::InflictDamage(kexWorldObject *target, damageDef_t *damageDef) {
     int dmgAmount;
-    bool bImpact;
-    kexStr dmgSound;
 
     if(damageDef == NULL || target->bAllowDamage == false) {
         return;
     }
 
-    dmgAmount = 0;
-    bImpact = false;
+    dmgAmount = damageDef->damage;
+
+    if(damageDef->bImpact == true && dmgAmount > 0) {
+        dmgAmount = ImpactDamage(damageDef, physicsRef->velocity.Unit());
+    }
+
+    target->StartSound(damageDef->sound);
+    target->OnDamage(this, dmgAmount, damageDef->def);
+
+    target->Health() -= dmgAmount;
+    if(target->Health() <= 0) {
+        target->OnDeath(this, damageDef->def);
+    }
+}
+
+//
+// kexWorldObject::ImpactDamage
+//
+// Damage from an impact def at the given speed. Only called with
+// a positive damage amount
+//
+
+int kexWorldObject::ImpactDamage(const damageDef_t *damageDef, const float velocity) {
+    float det = 1.0f / (float)damageDef->damage;
+    float dmgFactor = (velocity * det) * damageDef->impactScale;
+
+    return (int)dmgFactor;
+}
+
+//
+// kexWorldObject::CompileDamageDef
+//
+
+void kexWorldObject::CompileDamageDef(damageDef_t *damageDef, kexKeyMap *def) {
+    float impactFalloff;
+    kexStr str;
+
+    damageDef->def = def;
+
+    def->GetInt("damage", damageDef->damage);
+    def->GetBool("bImpact", damageDef->bImpact);
+    def->GetFloat("impactFalloff", impactFalloff);
+
+    if(impactFalloff < 1) {
+        impactFalloff = 1;
+    }
+
+    damageDef->impactScale = 1.0f / impactFalloff;
+    damageDef->sound[0] = 0;
+
+    if(def->GetString("sound", str)) {
+        strncpy(damageDef->sound, str.c_str(), MAX_FILEPATH-1);
+        damageDef->sound[MAX_FILEPATH-1] = 0;
+    }
+}
+
+//
+// kexWorldObject::FindDamageDef
+//
+
+damageDef_t *kexWorldObject::FindDamageDef(const char *name) {
+    damageDef_t *damageDef;
+    kexKeyMap *def;
+
+    if(name == NULL || name[0] == 0) {
+        return NULL;
+    }
+
+    if((damageDef = damageDefs.Find(name))) {
+        return damageDef;
+    }
+
+    if(!(def = defManager.FindDefEntry(name))) {
+        return NULL;
+    }
+
+    damageDef = damageDefs.Add(name);
+    CompileDamageDef(damageDef, def);
+
+    return damageDef;
+}
+
+//
+// WorldObject_ParsedDamage
+//
+// Damage the way InflictDamage worked it out before defs were
+// compiled, with every value parsed from the key strings
+//
 
-    damageDef->GetInt("damage", dmgAmount);
-    damageDef->GetBool("bImpact", bImpact);
-    damageDef->GetString("sound", dmgSound);
+static int WorldObject_ParsedDamage(kexKeyMap *def, const float velocity, kexStr &sound) {
+    kexHashKey *k;
+    int dmgAmount = 0;
+    bool bImpact = false;
+
+    if((k = def->Find("damage"))) {
+        dmgAmount = atoi(k->GetString());
+    }
+    if((k = def->Find("bImpact"))) {
+        bImpact = (atoi(k->GetString()) != 0);
+    }
+
+    def->GetString("sound", sound);
 
     if(bImpact == true && dmgAmount > 0) {
-        float impactFalloff;
+        float impactFalloff = 0;
 
-        damageDef->GetFloat("impactFalloff", impactFalloff);
+        if((k = def->Find("impactFalloff"))) {
+            impactFalloff = (float)atof(k->GetString());
+        }
         if(impactFalloff < 1) {
             impactFalloff = 1;
         }
 
         impactFalloff = 1.0f / impactFalloff;
 
-        float velocity = physicsRef->velocity.Unit();
         float det = 1.0f / (float)dmgAmount;
         float dmgFactor = (velocity * det) * impactFalloff;
 
         dmgAmount = (int)dmgFactor;
     }
 
-    target->StartSound(dmgSound.c_str());
-    target->OnDamage(this, dmgAmount, damageDef);
+    return dmgAmount;
+}
 
-    target->Health() -= dmgAmount;
-    if(target->Health() <= 0) {
-        target->OnDeath(this, damageDef);
+//
+// WorldObject_CompiledDamage
+//
+
+static int WorldObject_CompiledDamage(const damageDef_t *damageDef, const float velocity) {
+    if(damageDef->bImpact == true && damageDef->damage > 0) {
+        return kexWorldObject::ImpactDamage(damageDef, velocity);
     }
+
+    return damageDef->damage;
+}
+
+//
+// testdamagedefs
+//
+// Checks that the values keys compile to and the damage worked out
+// from a compiled def match what parsing the strings gives
+//
+
+COMMAND(testdamagedefs) {
+    static const char *values[] = {
+        "0", "12", "-7", "3.75", "1e2", " 42abc", "abc", "",
+        "1 2 3", "4.5 -6", "0.0001 2e3 -0", "  8  9  10  11", NULL
+    };
+    static const char *defs[][4] = {
+        // damage, bImpact, impactFalloff, sound
+        { "10",  "0", NULL,  "sounds/shaders/generic_hit.ksnd" },
+        { "25",  "1", "4",   "sounds/shaders/impact.ksnd" },
+        { "25",  "1", "0.5", NULL },
+        { "25",  "1", NULL,  NULL },
+        { "0",   "1", "3",   NULL },
+        { "-5",  "1", "2",   NULL },
+        { "7.9", "2", "1.5", "" },
+        { NULL,  NULL, NULL, NULL }
+    };
+    static const float velocities[] = { 0, 1, 50, 333.3f, 1000, 4096.5f };
+    bool bOk = true;
+
+    for(int i = 0; values[i]; i++) {
+        kexKeyMap keys;
+        kexVec3 vec;
+        kexVec3 parsed;
+        float f;
+        int n;
+        bool b;
+
+        keys.Add("key", values[i]);
+
+        keys.GetInt("key", n);
+        keys.GetFloat("key", f);
+        keys.GetBool("key", b);
+        keys.GetVector("key", vec);
+
+        // GetVector has always cleared the vector first, so missing
+        // components come back as zero either way
+        parsed.Clear();
+        sscanf(values[i], "%f %f %f", &parsed.x, &parsed.y, &parsed.z);
+
+        if(n != atoi(values[i]) || f != (float)atof(values[i]) || b != (atoi(values[i]) != 0) ||
+            vec.x != parsed.x || vec.y != parsed.y || vec.z != parsed.z) {
+            common.Printf(LC_GAME, "testdamagedefs: \"%s\" compiled differently\n", values[i]);
+            bOk = false;
+        }
+    }
+
+    for(int i = 0; defs[i][0]; i++) {
+        static const char *keyNames[4] = { "damage", "bImpact", "impactFalloff", "sound" };
+        damageDef_t damageDef;
+        kexKeyMap def;
+
+        for(int k = 0; k < 4; k++) {
+            if(defs[i][k]) {
+                def.Add(keyNames[k], defs[i][k]);
+            }
+        }
+
+        kexWorldObject::CompileDamageDef(&damageDef, &def);
+
+        for(unsigned int v = 0; v < sizeof(velocities) / sizeof(velocities[0]); v++) {
+            kexStr sound;
+            int parsed = WorldObject_ParsedDamage(&def, velocities[v], sound);
+
+            if(parsed != WorldObject_CompiledDamage(&damageDef, velocities[v]) ||
+                strcmp(sound.c_str(), damageDef.sound)) {
+                common.Printf(LC_GAME, "testdamagedefs: def %i at %f compiled differently\n", i, velocities[v]);
+                bOk = false;
+            }
+        }
+    }
+
+    common.CPrintf(LC_GAME, bOk ? COLOR_GREEN : COLOR_RED, "testdamagedefs %s\n", bOk ? "passed" : "failed");
+}
+
+//
+// benchdamage
+//
+// Works out the damage and sound of an impact def a million times
+// by looking up and parsing its keys, the way InflictDamage used to,
+// then from the compiled def. The StartSound and script callbacks
+// that follow are the same either way and are left out
+//
+
+COMMAND(benchdamage) {
+    double freq = (double)SDL_GetPerformanceFrequency();
+    damageDef_t damageDef;
+    kexKeyMap def;
+    uint64_t start;
+    double parsed;
+    double compiled;
+    int count = 1000000;
+    int sumA = 0;
+    int sumB = 0;
+    int sounds = 0;
+
+    if(command.GetArgc() >= 2) {
+        count = atoi(command.GetArgv(1));
+    }
+
+    if(count <= 0) {
+        return;
+    }
+
+    def.Add("damage", "30");
+    def.Add("bImpact", "1");
+    def.Add("impactFalloff", "4");
+    def.Add("sound", "sounds/shaders/generic_impact.ksnd");
+
+    kexWorldObject::CompileDamageDef(&damageDef, &def);
+
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < count; i++) {
+        kexStr sound;
+
+        sumA += WorldObject_ParsedDamage(&def, (float)(i & 1023), sound);
+        sounds += (sound.Length() > 0);
+    }
+    parsed = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    start = sysMain.GetPerformanceCounter();
+    for(int i = 0; i < count; i++) {
+        sumB += WorldObject_CompiledDamage(&damageDef, (float)(i & 1023));
+        sounds -= (damageDef.sound[0] != 0);
+    }
+    compiled = (double)(sysMain.GetPerformanceCounter() - start) / freq;
+
+    common.Printf(LC_GAME, "%i damage calls%s\n", count, (sumA == sumB && sounds == 0) ? "" : " (results differ)");
+    common.Printf(LC_GAME, "parsed keys: %8.2f ns/call\n", parsed * 1e9 / count);
+    common.Printf(LC_GAME, "compiled:    %8.2f ns/call\n", compiled * 1e9 / count);
 }
 
 //
@@ -332,7 +602,7 @@ bool kexWorldObject::RangeDamage(const char *damageDef,
                     dist = ObjectDistance(obj, dmgOrigin);
 
                     if(kexMath::Sqrt(dist) * 0.5f < radius + dmgRadius) {
-                        InflictDamage(obj, defManager.FindDefEntry(damageDef));
+                        InflictDamage(obj, FindDamageDef(damageDef));
                         return true;
                     }
             }
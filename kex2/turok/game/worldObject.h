@@ -30,6 +30,40 @@
 #include "physics/physics.h"
 #include "keymap.h"
 #include "sdNodes.h"
+#include "cachefilelist.h"
+
+//
+// damage definitions are compiled from their def entries the first time
+// they're referenced so inflicting damage doesn't need any key lookups
+//
+typedef struct {
+    kexKeyMap                       *def;
+    int                             damage;
+    bool                            bImpact;
+    float                           impactScale;
+    filepath_t                      sound;
+} damageDef_t;
+
+typedef enum {
+    OHF_STATIC      = 0x1,
+    OHF_CLIENTONLY  = 0x2,
+    OHF_HIDDEN      = 0x4,
+    OHF_NOCULL      = 0x8,
+    OHF_COLLISION   = 0x10,
+    OHF_TOUCH       = 0x20
+} objectHotFlags_t;
+
+//
+// the part of a world object the per-frame loops look at, kept packed
+// in the world's handle tables. refreshed by the world after each tick
+//
+typedef struct {
+    kexBBox                         bounds;
+    kexVec3                         origin;
+    float                           cullDistance;
+    int                             displayType;
+    unsigned int                    flags;
+} objectHot_t;
 
 //-----------------------------------------------------------------------------
 //
@@ -55,8 +89,9 @@ public:
     void                            LinkArea(void);
     void                            UnlinkArea(void);
     void                            SetShaderParam(const int index, const float value);
+    void                            StoreHot(objectHot_t &hot);
     float                           ObjectDistance(kexWorldObject *obj, const kexVec3 &offset);
-    void                            InflictDamage(kexWorldObject *target, kexKeyMap *damageDef);
+    void                            InflictDamage(kexWorldObject *target, damageDef_t *damageDef);
     bool                            RangeDamage(const char *damageDef,
                                                 const float dmgRadius,
                                                 const kexVec3 &dmgOrigin);
@@ -79,6 +114,10 @@ public:
     const rcolor                    WireFrameColor(void) const { return wireframeColor; }
     const float                     *ShaderParams(void) const { return shaderParams; }
 
+    static damageDef_t              *FindDamageDef(const char *name);
+    static void                     CompileDamageDef(damageDef_t *damageDef, kexKeyMap *def);
+    static int                      ImpactDamage(const damageDef_t *damageDef, const float velocity);
+
     kexSDNodeRef<kexWorldObject>    areaLink;
 
     bool                            bStatic;        // no tick/think behavior
@@ -150,6 +189,9 @@ protected:
     impactType_t                    impactType;
     rcolor                          wireframeColor;
     float                           shaderParams[4];
+
+private:
+    static kexHashList<damageDef_t> damageDefs;
 END_CLASS();
 
 #endif
@@ -0,0 +1,359 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Background map streaming
+//
+// The stream thread only ever touches the packs and its own buffers.
+// The zone allocator, the parser and the resource managers all belong
+// to the main thread, so everything that turns the files into objects
+// still happens there, in small slices, while the map is loading.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "filesystem.h"
+#include "sound.h"
+#include "worldStream.h"
+
+// packed files a map can refer to. textures aren't read here, the
+// texture loader decodes them on the job threads straight from the
+// packs and never looks at the file cache
+static const char *streamExtensions[] = {
+    ".kclm",
+    ".kmesh",
+    ".kanim",
+    ".kmat",
+    ".ksnd",
+    ".kfx",
+    ".def",
+    ".wav",
+    NULL
+};
+
+static const char *waveExtensions[] = {
+    ".wav",
+    NULL
+};
+
+static const char *soundExtensions[] = {
+    ".ksnd",
+    NULL
+};
+
+// text files that are scanned for more references
+static const char *scanExtensions[] = {
+    ".kmap",
+    ".kmesh",
+    ".kmat",
+    ".ksnd",
+    ".kfx",
+    ".def",
+    NULL
+};
+
+//
+// WorldStream_HasExtension
+//
+
+static bool WorldStream_HasExtension(const char *name, const char **extensions) {
+    const char *ext;
+
+    if(!(ext = strrchr(name, '.'))) {
+        return false;
+    }
+
+    for(int i = 0; extensions[i]; i++) {
+        if(!strcmp(ext, extensions[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// kexWorldStream::Begin
+//
+// Starts reading ahead for a map. Does nothing if that map
+// is already being streamed
+//
+
+void kexWorldStream::Begin(const char *mapFile) {
+    if(IsStreaming(mapFile)) {
+        return;
+    }
+
+    Cancel();
+
+    // leave room for the extensions
+    strncpy(this->mapFile, mapFile, MAX_FILEPATH-8);
+    this->mapFile[MAX_FILEPATH-8] = 0;
+
+    numQueued = 0;
+    numCommitted = 0;
+    SDL_AtomicSet(&numRead, 0);
+    SDL_AtomicSet(&bDone, 0);
+    SDL_AtomicSet(&bQuit, 0);
+    bActive = true;
+
+    if(!(thread = SDL_CreateThread(StreamThread, "worldStream", this))) {
+        // everything will be read from the packs as it's parsed instead
+        SDL_AtomicSet(&bDone, 1);
+    }
+}
+
+//
+// kexWorldStream::IsStreaming
+//
+
+bool kexWorldStream::IsStreaming(const char *mapFile) const {
+    return bActive && !strcmp(this->mapFile, mapFile);
+}
+
+//
+// kexWorldStream::Commit
+//
+// Moves files the stream thread has finished into the file cache
+// until the deadline passes. A deadline of zero waits for the
+// whole map. Returns true once everything has been handed over
+//
+
+bool kexWorldStream::Commit(const int deadline) {
+    streamFile_t *file;
+    int count;
+
+    if(!bActive) {
+        return true;
+    }
+
+    while(1) {
+        count = SDL_AtomicGet(&numRead);
+
+        while(numCommitted < count) {
+            if(deadline && sysMain.GetMS() >= deadline) {
+                return false;
+            }
+
+            file = &files[numCommitted++];
+
+            if(file->data) {
+                // waves keep their file data around so cache them where
+                // the sound system would have
+                fileSystem.StageFile(file->name, file->data, file->size,
+                    strstr(file->name, ".wav") ? kexSoundSystem::hb_sound : hb_static);
+
+                Mem_Free(file->data);
+                file->data = NULL;
+            }
+        }
+
+        if(SDL_AtomicGet(&bDone) && numCommitted == SDL_AtomicGet(&numRead)) {
+            break;
+        }
+
+        if(deadline) {
+            return false;
+        }
+
+        SDL_Delay(1);
+    }
+
+    Finish();
+    return true;
+}
+
+//
+// kexWorldStream::CacheSounds
+//
+// Sound shaders are otherwise only looked up when they first play.
+// Looking up the ones the map refers to while it's still loading
+// marks their waves as used, so they aren't evicted along with
+// the last map's
+//
+
+void kexWorldStream::CacheSounds(void) {
+    for(int i = 0; i < numCommitted; i++) {
+        if(WorldStream_HasExtension(files[i].name, soundExtensions)) {
+            soundSystem.CacheShaderFile(files[i].name);
+        }
+    }
+}
+
+//
+// kexWorldStream::DropUnopened
+//
+// Called once the map has finished loading. Anything that was
+// read ahead but never opened isn't going to be, so it's freed
+// rather than left sitting in the cache
+//
+
+void kexWorldStream::DropUnopened(void) {
+    int count;
+
+    if((count = fileSystem.DropStagedFiles()) > 0) {
+        common.DPrintf(LC_GAME, "kexWorldStream: dropped %i unused files\n", count);
+    }
+}
+
+//
+// kexWorldStream::Cancel
+//
+
+void kexWorldStream::Cancel(void) {
+    if(!bActive) {
+        return;
+    }
+
+    SDL_AtomicSet(&bQuit, 1);
+    Finish();
+}
+
+//
+// kexWorldStream::Finish
+//
+
+void kexWorldStream::Finish(void) {
+    int count;
+
+    if(thread) {
+        SDL_WaitThread(thread, NULL);
+        thread = NULL;
+    }
+
+    count = SDL_AtomicGet(&numRead);
+
+    // free anything that was read but never committed
+    for(int i = numCommitted; i < count; i++) {
+        if(files[i].data) {
+            Mem_Free(files[i].data);
+            files[i].data = NULL;
+        }
+    }
+
+    numCommitted = count;
+    bActive = false;
+}
+
+//
+// kexWorldStream::StreamThread
+//
+
+int kexWorldStream::StreamThread(void *data) {
+    static_cast<kexWorldStream*>(data)->Run();
+    return 0;
+}
+
+//
+// kexWorldStream::Run
+//
+
+void kexWorldStream::Run(void) {
+    streamFile_t *file;
+    filepath_t name;
+
+    // kva isn't safe to use off the main thread
+    sprintf(name, "%s.kclm", mapFile);
+    Queue(name);
+    sprintf(name, "%s.kmap", mapFile);
+    Queue(name);
+
+    for(int i = 0; i < numQueued; i++) {
+        if(SDL_AtomicGet(&bQuit)) {
+            break;
+        }
+
+        file = &files[i];
+        file->size = fileSystem.ReadFile(file->name, &file->data, hb_file);
+
+        if(file->data && WorldStream_HasExtension(file->name, scanExtensions)) {
+            ScanReferences((char*)file->data, file->size);
+        }
+
+        // publishes the file to the main thread
+        SDL_AtomicSet(&numRead, i + 1);
+    }
+
+    SDL_AtomicSet(&bDone, 1);
+}
+
+//
+// kexWorldStream::Queue
+//
+
+void kexWorldStream::Queue(const char *name) {
+    if(numQueued >= WS_MAX_FILES || !fileSystem.FileExists(name)) {
+        return;
+    }
+
+    // long waves are streamed as they play, reading them here
+    // would only put the whole thing in the cache
+    if(WorldStream_HasExtension(name, waveExtensions) &&
+        kexSoundSystem::ShouldStream(fileSystem.GetFileSize(name))) {
+        return;
+    }
+
+    for(int i = 0; i < numQueued; i++) {
+        if(!strcmp(files[i].name, name)) {
+            return;
+        }
+    }
+
+    strcpy(files[numQueued].name, name);
+    files[numQueued].data = NULL;
+    files[numQueued].size = 0;
+    numQueued++;
+}
+
+//
+// kexWorldStream::ScanReferences
+//
+// Queues every quoted string that names a packed file. Material
+// references carry the material name after a '@', which is dropped
+//
+
+void kexWorldStream::ScanReferences(const char *text, const int size) {
+    filepath_t name;
+    char *at;
+    int len;
+
+    for(int i = 0; i < size; i++) {
+        if(text[i] != '"') {
+            continue;
+        }
+
+        for(len = 0, i++; i < size && text[i] != '"'; i++) {
+            if(len < MAX_FILEPATH-1) {
+                name[len++] = text[i];
+            }
+        }
+
+        name[len] = 0;
+
+        if((at = strchr(name, '@'))) {
+            *at = 0;
+        }
+
+        if(WorldStream_HasExtension(name, streamExtensions)) {
+            Queue(name);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __WORLDSTREAM_H__
+#define __WORLDSTREAM_H__
+
+#define WS_MAX_FILES    1024
+
+typedef struct {
+    char            name[MAX_FILEPATH];
+    byte            *data;      // from the system allocator, owned by the stream
+    int             size;
+} streamFile_t;
+
+//
+// kexWorldStream - reads a map and everything it references out of the
+// packs on a background thread. the thread starts with the collision
+// and map files, scans every text file it reads for quoted paths to
+// other packed files and reads those as well. the main thread copies
+// the finished files into the file cache a few at a time, so by the
+// time the map is parsed nothing has to be decompressed
+//
+
+class kexWorldStream {
+public:
+    void                    Begin(const char *mapFile);
+    bool                    Commit(const int deadline);
+    void                    Cancel(void);
+    void                    CacheSounds(void);
+    void                    DropUnopened(void);
+
+    bool                    IsStreaming(const char *mapFile) const;
+    const int               NumFiles(void) const { return numCommitted; }
+
+private:
+    static int              StreamThread(void *data);
+
+    void                    Run(void);
+    void                    Queue(const char *name);
+    void                    ScanReferences(const char *text, const int size);
+    void                    Finish(void);
+
+    filepath_t              mapFile;
+    streamFile_t            files[WS_MAX_FILES];
+    int                     numQueued;      // only touched by the stream thread
+    int                     numCommitted;   // only touched by the main thread
+    SDL_atomic_t            numRead;
+    SDL_atomic_t            bDone;
+    SDL_atomic_t            bQuit;
+    SDL_Thread              *thread;
+    bool                    bActive;
+};
+
+#endif
@@ -30,9 +30,50 @@
 #include "renderBackend.h"
 #include "renderWorld.h"
 #include "stanHull.h"
+#include "world.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CM_USE_SSE
+#endif
+
+// triangles per BVH leaf (one packet)
+#define CM_LEAF_TRIS        4
+#define CM_MAX_DEPTH        64
+// PointInRange expands triangles by 0.1, more than that near sharp
+// corners, so nodes are padded generously
+#define CM_NODE_EPSILON     1.0f
 
 kexHeapBlock kexClipMesh::hb_clipMesh("clip mesh", false, NULL, NULL);
 
+//
+// testclipmeshtraces
+//
+
+COMMAND(testclipmeshtraces) {
+    int count = 1000;
+    int meshes = 0;
+    int mismatches = 0;
+
+    if(command.GetArgc() >= 2) {
+        count = atoi(command.GetArgv(1));
+    }
+
+    for(unsigned int i = 0; i < localWorld.staticActors.Length(); i++) {
+        kexWorldModel *wm = localWorld.staticActors[i];
+
+        if(wm->ClipMesh().GetType() == CMT_NONE) {
+            continue;
+        }
+
+        mismatches += wm->ClipMesh().TestTraces(count);
+        meshes++;
+    }
+
+    common.Printf(LC_GAME, "%i clip meshes, %i traces each, %i mismatches\n",
+        meshes, count, mismatches);
+}
+
 enum {
     scClipMesh_type = 0,
     scClipMesh_end
@@ -52,6 +93,10 @@ kexClipMesh::kexClipMesh(void) {
     this->owner     = NULL;
     this->cmGroups  = NULL;
     this->type      = CMT_NONE;
+    this->numNodes  = 0;
+    this->nodes     = NULL;
+    this->numPackets= 0;
+    this->packets   = NULL;
 
     this->origin.Set(0, 0, 0);
 }
@@ -83,6 +128,8 @@ kexClipMesh::~kexClipMesh(void) {
         this->numGroups = 0;
         Mem_Free(this->cmGroups);
     }
+
+    FreeTree();
 }
 
 //
@@ -444,9 +491,9 @@ void kexClipMesh::CreateMeshFromModel(void) {
         }
 
         for(unsigned int v = 0; v < cmGroup->numPoints; v++) {
-            cmGroup->points[v].x = surface->vertices[v][0];
-            cmGroup->points[v].y = surface->vertices[v][1];
-            cmGroup->points[v].z = surface->vertices[v][2];
+            cmGroup->points[v].x = surface->verts[v].xyz[0];
+            cmGroup->points[v].y = surface->verts[v].xyz[1];
+            cmGroup->points[v].z = surface->verts[v].xyz[2];
         }
     }
 }
@@ -496,10 +543,12 @@ void kexClipMesh::CreateConvexHull(void) {
 
         for(i = 0; i < numSurfaces; i++) {
             surface = &model->nodes[0].surfaces[i];
-            memcpy(&verts[totalCopyVerts], reinterpret_cast<PxF32*>(surface->vertices),
-                (sizeof(PxF32) * 3) * surface->numVerts);
 
-            totalCopyVerts += (surface->numVerts * 3);
+            for(unsigned int v = 0; v < surface->numVerts; v++) {
+                verts[totalCopyVerts++] = surface->verts[v].xyz.x;
+                verts[totalCopyVerts++] = surface->verts[v].xyz.y;
+                verts[totalCopyVerts++] = surface->verts[v].xyz.z;
+            }
         }
 
         HullDesc desc(QF_TRIANGLES, totalVerts, verts ,sizeof(PxF32) * 3);
@@ -509,7 +558,7 @@ void kexClipMesh::CreateConvexHull(void) {
     }
     else {
         HullDesc desc(QF_TRIANGLES, model->nodes[0].surfaces[0].numVerts,
-            reinterpret_cast<PxF32*>(model->nodes[0].surfaces[0].vertices) ,sizeof(PxF32) * 3);
+            reinterpret_cast<PxF32*>(model->nodes[0].surfaces[0].verts), sizeof(surfaceVertex_t));
         err = hl.CreateConvexHull(desc, result);
     }
 
@@ -563,27 +612,222 @@ void kexClipMesh::Transform(void) {
     for(unsigned int g = 0; g < numGroups; g++) {
         cmGroup_t *cmGroup = &cmGroups[g];
 
-        for(unsigned int i = 0; i < cmGroup->numPoints; i++) {
-            if(type != CMT_BOX) {
+        if(type != CMT_BOX) {
+            for(unsigned int i = 0; i < cmGroup->numPoints; i++) {
                 cmGroup->points[i] *= mtx;
             }
+        }
+
+        for(unsigned int i = 0; i < cmGroup->numTriangles; i++) {
+            kexTri *tri = &cmGroup->triangles[i];
+            
+            tri->plane.SetNormal(
+                *tri->point[0],
+                *tri->point[1],
+                *tri->point[2]);
+
+            tri->plane.SetDistance(*tri->point[0]);
+            tri->SetBounds();
+            tri->SetPlueckerEdges();
+        }
+    }
+
+    // planes are final now
+    BuildTree();
+}
+
+//
+// kexClipMesh::IsConvex
+//
+
+bool kexClipMesh::IsConvex(void) const {
+    switch(type) {
+    case CMT_BOX:
+    case CMT_TETRAHEDRON:
+    case CMT_OCTAHEDRON:
+    case CMT_DODECAHEDRON:
+    case CMT_CYLINDER:
+    case CMT_CONVEXHULL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//
+// kexClipMesh::FreeTree
+//
+
+void kexClipMesh::FreeTree(void) {
+    if(nodes) {
+        Mem_Free(nodes);
+        nodes = NULL;
+    }
+    if(packets) {
+        Mem_Free(packets);
+        packets = NULL;
+    }
+
+    numNodes = 0;
+    numPackets = 0;
+}
+
+//
+// kexClipMesh::FillPackets
+//
+// Packs triangles four at a time. Unused lanes get a zero plane,
+// which never faces the trace so they are always rejected
+//
+
+void kexClipMesh::FillPackets(cmNode_t *node, cmBuildTri_t *tris, const int count) {
+    node->child = -1;
+    node->firstPacket = numPackets;
+    node->numPackets = (count + 3) / 4;
 
-            for(unsigned int i = 0; i < cmGroup->numTriangles; i++) {
-                kexTri *tri = &cmGroup->triangles[i];
-                
-                tri->plane.SetNormal(
-                    *tri->point[0],
-                    *tri->point[1],
-                    *tri->point[2]);
-
-                tri->plane.SetDistance(*tri->point[0]);
-                tri->SetBounds();
-                tri->SetPlueckerEdges();
+    for(int i = 0; i < node->numPackets; i++) {
+        cmPacket_t *packet = &packets[numPackets++];
+
+        for(int j = 0; j < 4; j++) {
+            int t = i * 4 + j;
+
+            if(t >= count) {
+                packet->a[j] = packet->b[j] = packet->c[j] = packet->d[j] = 0;
+                packet->tris[j] = NULL;
+                packet->order[j] = -1;
+                continue;
             }
+
+            kexPlane &plane = tris[t].tri->plane;
+
+            packet->a[j] = plane.a;
+            packet->b[j] = plane.b;
+            packet->c[j] = plane.c;
+            packet->d[j] = plane.d;
+            packet->tris[j] = tris[t].tri;
+            packet->order[j] = tris[t].order;
         }
     }
 }
 
+//
+// kexClipMesh::GetTriBounds
+//
+
+void kexClipMesh::GetTriBounds(const cmBuildTri_t *tris, const int count,
+                               kexBBox &bounds, kexBBox &centers) const {
+    bounds = tris[0].tri->bounds;
+    centers.min = centers.max = tris[0].center;
+
+    for(int i = 1; i < count; i++) {
+        const kexBBox &b = tris[i].tri->bounds;
+        const kexVec3 &c = tris[i].center;
+
+        for(int j = 0; j < 3; j++) {
+            if(b.min[j] < bounds.min[j]) bounds.min[j] = b.min[j];
+            if(b.max[j] > bounds.max[j]) bounds.max[j] = b.max[j];
+            if(c[j] < centers.min[j]) centers.min[j] = c[j];
+            if(c[j] > centers.max[j]) centers.max[j] = c[j];
+        }
+    }
+}
+
+//
+// kexClipMesh::BuildNode
+//
+
+static int cmSortAxis;
+
+static int SortBuildTris(const void *a, const void *b) {
+    float c1 = ((const cmBuildTri_t*)a)->center[cmSortAxis];
+    float c2 = ((const cmBuildTri_t*)b)->center[cmSortAxis];
+
+    if(c1 < c2) return -1;
+    if(c1 > c2) return 1;
+    return 0;
+}
+
+void kexClipMesh::BuildNode(const int nodeNum, cmBuildTri_t *tris, const int count) {
+    cmNode_t *node = &nodes[nodeNum];
+    kexBBox centers;
+    kexVec3 size;
+    int axis;
+
+    GetTriBounds(tris, count, node->bounds, centers);
+
+    if(count <= CM_LEAF_TRIS) {
+        FillPackets(node, tris, count);
+        return;
+    }
+
+    // split at the median along the longest axis
+    size = centers.max - centers.min;
+    axis = 0;
+
+    if(size.y > size[axis]) axis = 1;
+    if(size.z > size[axis]) axis = 2;
+
+    cmSortAxis = axis;
+    qsort(tris, count, sizeof(cmBuildTri_t), SortBuildTris);
+
+    node->child = numNodes;
+    node->firstPacket = 0;
+    node->numPackets = 0;
+    numNodes += 2;
+
+    BuildNode(node->child + 0, tris, count / 2);
+    BuildNode(node->child + 1, tris + count / 2, count - count / 2);
+}
+
+//
+// kexClipMesh::BuildTree
+//
+// Convex shapes are small enough that a single leaf holding every
+// packet beats walking a tree. Meshes get a median split BVH
+//
+
+void kexClipMesh::BuildTree(void) {
+    cmBuildTri_t *tris;
+    int numTris = 0;
+    int n = 0;
+
+    FreeTree();
+
+    for(unsigned int g = 0; g < numGroups; g++) {
+        numTris += cmGroups[g].numTriangles;
+    }
+
+    if(numTris <= 0) {
+        return;
+    }
+
+    tris = (cmBuildTri_t*)Mem_Malloc(sizeof(cmBuildTri_t) * numTris, hb_static);
+
+    for(unsigned int g = 0; g < numGroups; g++) {
+        for(unsigned int i = 0; i < cmGroups[g].numTriangles; i++) {
+            tris[n].tri = &cmGroups[g].triangles[i];
+            tris[n].center = tris[n].tri->GetCenterPoint();
+            tris[n].order = n;
+            n++;
+        }
+    }
+
+    nodes = (cmNode_t*)Mem_Malloc(sizeof(cmNode_t) * numTris * 2, hb_clipMesh);
+    packets = (cmPacket_t*)Mem_Malloc(sizeof(cmPacket_t) * (numTris + 3), hb_clipMesh);
+    numNodes = 1;
+
+    if(IsConvex()) {
+        kexBBox centers;
+
+        GetTriBounds(tris, numTris, nodes[0].bounds, centers);
+        FillPackets(&nodes[0], tris, numTris);
+    }
+    else {
+        BuildNode(0, tris, numTris);
+    }
+
+    Mem_Free(tris);
+}
+
 //
 // kexClipMesh::CreateShape
 //
@@ -673,105 +917,175 @@ void kexClipMesh::CreateShape(void) {
 }
 
 //
-// kexClipMesh::Trace
+// SegmentInBox
+//
+// Slab test for start + t * delta, tMin <= t <= tMax
 //
 
-bool kexClipMesh::Trace(traceInfo_t *trace) {
-    float frac = 1;
+static bool SegmentInBox(const kexVec3 &start, const kexVec3 &delta,
+                         float tMin, float tMax,
+                         const kexVec3 &bMin, const kexVec3 &bMax) {
+    for(int i = 0; i < 3; i++) {
+        if(delta[i] == 0) {
+            if(start[i] < bMin[i] || start[i] > bMax[i]) {
+                return false;
+            }
+            continue;
+        }
+
+        float inv = 1.0f / delta[i];
+        float t1 = (bMin[i] - start[i]) * inv;
+        float t2 = (bMax[i] - start[i]) * inv;
+
+        if(t1 > t2) {
+            float t = t1;
+            t1 = t2;
+            t2 = t;
+        }
+
+        if(t1 > tMin) tMin = t1;
+        if(t2 < tMax) tMax = t2;
+
+        if(tMin > tMax) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// kexClipMesh::TestTriangle
+//
+// Returns true if the trace hits the triangle closer than maxFrac.
+// The trace is const so the hit is lerped without moving trace->start,
+// which made the result depend on the order triangles were tested in
+//
+
+bool kexClipMesh::TestTriangle(const traceInfo_t *trace, kexTri *tri, const float maxFrac,
+                               float &frac, kexVec3 &hit) {
     float r = 0;
-    kexTri *tri;
     float dist;
     float distStart;
     float distEnd;
-    kexVec3 hit;
     kexVec3 offset;
-    cmGroup_t *cmGroup;
 
-    for(unsigned int i = 0; i < numGroups; i++) {
-        cmGroup = &cmGroups[i];
+    // direction must be facing the plane
+    if(tri->plane.Distance(trace->dir) >= 0) {
+        return false;
+    }
 
-        for(unsigned int j = 0; j < cmGroup->numTriangles; j++) {
-            tri = &cmGroup->triangles[j];
+    if(trace->bUseBBox) {
+        offset.x = tri->plane.a < 0 ? trace->localBBox.max.x : trace->localBBox.min.x;
+        offset.y = tri->plane.b < 0 ? trace->localBBox.max.y : trace->localBBox.min.y;
+        offset.z = tri->plane.c < 0 ? trace->localBBox.max.z : trace->localBBox.min.z;
 
-            // direction must be facing the plane
-            if(tri->plane.Distance(trace->dir) >= 0) {
-                continue;
-            }
+        r = -offset.Dot(tri->plane.Normal());
+    }
 
-            if(trace->bUseBBox) {
-                offset.x = tri->plane.a < 0 ? trace->localBBox.max.x : trace->localBBox.min.x;
-                offset.y = tri->plane.b < 0 ? trace->localBBox.max.y : trace->localBBox.min.y;
-                offset.z = tri->plane.c < 0 ? trace->localBBox.max.z : trace->localBBox.min.z;
+    dist = tri->plane.d + r;
 
-                r = -offset.Dot(tri->plane.Normal());
-            }
+    distStart = tri->plane.Distance(trace->start) - dist;
+    distEnd = tri->plane.Distance(trace->end) - dist;
 
-            dist = tri->plane.d + r;
+    if(distStart <= distEnd || distStart < 0 || distEnd > 0) {
+        return false;
+    }
 
-            distStart = tri->plane.Distance(trace->start) - dist;
-            distEnd = tri->plane.Distance(trace->end) - dist;
+    frac = (distStart / (distStart - distEnd));
 
-            if(distStart <= distEnd || distStart < 0 || distEnd > 0) {
-                continue;
-            }
+    if(frac > 1) {
+        return false;
+    }
 
-            frac = (distStart / (distStart - distEnd));
+    if(frac < 0) {
+        if(trace->bUseBBox == false) {
+            return false;
+        }
+    }
 
-            if(frac > 1) {
-                continue;
+    // check if something closer was hit
+    if(frac >= maxFrac) {
+        return false;
+    }
+
+    hit = trace->start.Lerp(trace->end, frac);
+
+    // check if hit vector lies within the triangle's edges
+    if(!tri->PointInRange(hit, 0.1f)) {
+        if(trace->bUseBBox) {
+            kexVec3 e(0.1f, 0.1f, 0.1f);
+            kexPluecker bp[8];
+            kexVec3 bMin;
+            kexVec3 bMax;
+            int bit[3];
+
+            // the edge test below only looks at the trace direction, so
+            // on its own it accepts boxes that pass nowhere near a thin
+            // triangle. the box has to overlap the triangle's bounds at
+            // some point between the hit and the end of the trace
+            if(!SegmentInBox(hit, trace->end - hit, 0, 1,
+                tri->bounds.min - e - trace->localBBox.max,
+                tri->bounds.max + e - trace->localBBox.min)) {
+                return false;
             }
 
-            if(frac < 0) {
-                if(trace->bUseBBox == false) {
-                    continue;
+            bMin = trace->bbox.min;
+            bMax = trace->bbox.max;
+
+            bit[0] = bit[1] = bit[2] = 0;
+
+            // setup pluecker coordinates from each bounding box point
+            bp[0].SetRay(kexVec3(bMin.x, bMin.y, bMin.z), trace->dir);
+            bp[1].SetRay(kexVec3(bMin.x, bMax.y, bMin.z), trace->dir);
+            bp[2].SetRay(kexVec3(bMax.x, bMin.y, bMin.z), trace->dir);
+            bp[3].SetRay(kexVec3(bMax.x, bMax.y, bMin.z), trace->dir);
+            bp[4].SetRay(kexVec3(bMin.x, bMin.y, bMax.z), trace->dir);
+            bp[5].SetRay(kexVec3(bMin.x, bMax.y, bMax.z), trace->dir);
+            bp[6].SetRay(kexVec3(bMax.x, bMin.y, bMax.z), trace->dir);
+            bp[7].SetRay(kexVec3(bMax.x, bMax.y, bMax.z), trace->dir);
+
+            for(int k = 0; k < 3; k++) {
+                for(int l = 0; l < 8; l++) {
+                    float d = bp[l].InnerProduct(tri->plEdge[k]);
+                    bit[k] |= FLOATSIGNBIT(d) << l;
                 }
             }
 
-            // check if something closer was hit
-            if(frac >= trace->fraction) {
-                continue;
+            // abort if bounding box didn't make contact with one of the edges
+            if(bit[0] == 0xff || bit[1] == 0xff || bit[2] == 0xff) {
+                return false;
             }
+        }
+        else {
+            return false;
+        }
+    }
 
-            hit = trace->start.Lerp(trace->end, frac);
-
-            // check if hit vector lies within the triangle's edges
-            if(!tri->PointInRange(hit, 0.1f)) {
-                if(trace->bUseBBox) {
-                    kexPluecker bp[8];
-                    kexVec3 bMin;
-                    kexVec3 bMax;
-                    int bit[3];
-
-                    bMin = trace->bbox.min;
-                    bMax = trace->bbox.max;
-
-                    bit[0] = bit[1] = bit[2] = 0;
-
-                    // setup pluecker coordinates from each bounding box point
-                    bp[0].SetRay(kexVec3(bMin.x, bMin.y, bMin.z), trace->dir);
-                    bp[1].SetRay(kexVec3(bMin.x, bMax.y, bMin.z), trace->dir);
-                    bp[2].SetRay(kexVec3(bMax.x, bMin.y, bMin.z), trace->dir);
-                    bp[3].SetRay(kexVec3(bMax.x, bMax.y, bMin.z), trace->dir);
-                    bp[4].SetRay(kexVec3(bMin.x, bMin.y, bMax.z), trace->dir);
-                    bp[5].SetRay(kexVec3(bMin.x, bMax.y, bMax.z), trace->dir);
-                    bp[6].SetRay(kexVec3(bMax.x, bMin.y, bMax.z), trace->dir);
-                    bp[7].SetRay(kexVec3(bMax.x, bMax.y, bMax.z), trace->dir);
-
-                    for(int k = 0; k < 3; k++) {
-                        for(int l = 0; l < 8; l++) {
-                            float d = bp[l].InnerProduct(tri->plEdge[k]);
-                            bit[k] |= FLOATSIGNBIT(d) << l;
-                        }
-                    }
+    return true;
+}
 
-                    // abort if bounding box didn't make contact with one of the edges
-                    if(bit[0] == 0xff || bit[1] == 0xff || bit[2] == 0xff) {
-                        continue;
-                    }
-                }
-                else {
-                    continue;
-                }
+//
+// kexClipMesh::TraceBruteForce
+//
+// Tests every triangle in order. Used when there's no tree
+// and as the reference for TestTraces
+//
+
+bool kexClipMesh::TraceBruteForce(traceInfo_t *trace) {
+    kexTri *tri;
+    kexVec3 hit;
+    float frac;
+    bool bHit = false;
+
+    for(unsigned int i = 0; i < numGroups; i++) {
+        cmGroup_t *cmGroup = &cmGroups[i];
+
+        for(unsigned int j = 0; j < cmGroup->numTriangles; j++) {
+            tri = &cmGroup->triangles[j];
+
+            if(!TestTriangle(trace, tri, trace->fraction, frac, hit)) {
+                continue;
             }
 
             trace->fraction = frac;
@@ -779,10 +1093,265 @@ bool kexClipMesh::Trace(traceInfo_t *trace) {
             trace->hitMesh = this;
             trace->hitTri = tri;
             trace->hitVector = hit;
+            bHit = true;
         }
     }
 
-    return (frac != 1);
+    return bHit;
+}
+
+//
+// kexClipMesh::NodeInRange
+//
+// Conservative test for whether any triangle under the node could
+// be accepted by TestTriangle. Every accepted hit lies on the trace
+// segment within radius of the triangle's bounds
+//
+
+bool kexClipMesh::NodeInRange(const traceInfo_t *trace, const cmNode_t *node,
+                              const float radius) const {
+    kexVec3 expand(radius, radius, radius);
+
+    return SegmentInBox(trace->start, trace->end - trace->start, 0, 1,
+        node->bounds.min - expand, node->bounds.max + expand);
+}
+
+//
+// kexClipMesh::PacketMask
+//
+// Runs the plane tests from TestTriangle on four triangles at once
+// and returns a bit for each one that's still worth a full test
+//
+
+unsigned int kexClipMesh::PacketMask(const traceInfo_t *trace, const cmPacket_t *packet) const {
+#ifdef CM_USE_SSE
+    __m128 zero = _mm_setzero_ps();
+    __m128 a = _mm_loadu_ps(packet->a);
+    __m128 b = _mm_loadu_ps(packet->b);
+    __m128 c = _mm_loadu_ps(packet->c);
+    __m128 dist = _mm_loadu_ps(packet->d);
+    __m128 facing;
+    __m128 distStart;
+    __m128 distEnd;
+    __m128 reject;
+
+    facing = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(trace->dir.x), a),
+        _mm_mul_ps(_mm_set1_ps(trace->dir.y), b)),
+        _mm_mul_ps(_mm_set1_ps(trace->dir.z), c));
+
+    if(trace->bUseBBox) {
+        const kexBBox &box = trace->localBBox;
+        __m128 ma = _mm_cmplt_ps(a, zero);
+        __m128 mb = _mm_cmplt_ps(b, zero);
+        __m128 mc = _mm_cmplt_ps(c, zero);
+        __m128 ox = _mm_or_ps(_mm_and_ps(ma, _mm_set1_ps(box.max.x)),
+                              _mm_andnot_ps(ma, _mm_set1_ps(box.min.x)));
+        __m128 oy = _mm_or_ps(_mm_and_ps(mb, _mm_set1_ps(box.max.y)),
+                              _mm_andnot_ps(mb, _mm_set1_ps(box.min.y)));
+        __m128 oz = _mm_or_ps(_mm_and_ps(mc, _mm_set1_ps(box.max.z)),
+                              _mm_andnot_ps(mc, _mm_set1_ps(box.min.z)));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, a), _mm_mul_ps(oy, b)), _mm_mul_ps(oz, c));
+
+        // negate by flipping the sign bit, same as -offset.Dot(normal)
+        dist = _mm_add_ps(dist, _mm_xor_ps(r, _mm_set1_ps(-0.0f)));
+    }
+
+    distStart = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(trace->start.x), a),
+        _mm_mul_ps(_mm_set1_ps(trace->start.y), b)),
+        _mm_mul_ps(_mm_set1_ps(trace->start.z), c)), dist);
+
+    distEnd = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(trace->end.x), a),
+        _mm_mul_ps(_mm_set1_ps(trace->end.y), b)),
+        _mm_mul_ps(_mm_set1_ps(trace->end.z), c)), dist);
+
+    reject = _mm_or_ps(_mm_cmpge_ps(facing, zero), _mm_cmple_ps(distStart, distEnd));
+    reject = _mm_or_ps(reject, _mm_cmplt_ps(distStart, zero));
+    reject = _mm_or_ps(reject, _mm_cmpgt_ps(distEnd, zero));
+
+    return ~_mm_movemask_ps(reject) & 0xf;
+#else
+    unsigned int mask = 0;
+
+    for(int i = 0; i < 4; i++) {
+        if(packet->tris[i] != NULL) {
+            mask |= BIT(i);
+        }
+    }
+
+    return mask;
+#endif
+}
+
+//
+// kexClipMesh::Trace
+//
+// Walks the BVH and keeps the closest hit. Ties go to the triangle
+// that comes first in the mesh so the result is the same as testing
+// every triangle in order
+//
+
+bool kexClipMesh::Trace(traceInfo_t *trace) {
+    int stack[CM_MAX_DEPTH];
+    int sp = 0;
+    float maxFrac = trace->fraction;
+    float radius = CM_NODE_EPSILON;
+    float bestFrac = 0;
+    int bestOrder = 0;
+    kexTri *bestTri = NULL;
+    kexVec3 bestHit;
+    kexVec3 hit;
+    float frac;
+
+    if(nodes == NULL) {
+        return TraceBruteForce(trace);
+    }
+
+    if(trace->bUseBBox) {
+        for(int i = 0; i < 3; i++) {
+            float m = kexMath::Fabs(trace->localBBox.min[i]);
+
+            if(kexMath::Fabs(trace->localBBox.max[i]) > m) {
+                m = kexMath::Fabs(trace->localBBox.max[i]);
+            }
+
+            // not exact but never smaller than the corner distance
+            radius += m;
+        }
+    }
+
+    stack[sp++] = 0;
+
+    while(sp > 0) {
+        const cmNode_t *node = &nodes[stack[--sp]];
+
+        if(!NodeInRange(trace, node, radius)) {
+            continue;
+        }
+
+        if(node->child != -1) {
+            stack[sp++] = node->child + 1;
+            stack[sp++] = node->child;
+            continue;
+        }
+
+        for(int p = 0; p < node->numPackets; p++) {
+            const cmPacket_t *packet = &packets[node->firstPacket + p];
+            unsigned int mask = PacketMask(trace, packet);
+
+            for(int i = 0; i < 4 && mask; i++, mask >>= 1) {
+                if(!(mask & 1)) {
+                    continue;
+                }
+
+                if(!TestTriangle(trace, packet->tris[i], maxFrac, frac, hit)) {
+                    continue;
+                }
+
+                if(bestTri == NULL || frac < bestFrac ||
+                    (frac == bestFrac && packet->order[i] < bestOrder)) {
+                    bestTri = packet->tris[i];
+                    bestFrac = frac;
+                    bestOrder = packet->order[i];
+                    bestHit = hit;
+                }
+            }
+        }
+    }
+
+    if(bestTri == NULL) {
+        return false;
+    }
+
+    trace->fraction = bestFrac;
+    trace->hitNormal = bestTri->plane.Normal();
+    trace->hitMesh = this;
+    trace->hitTri = bestTri;
+    trace->hitVector = bestHit;
+
+    return true;
+}
+
+//
+// kexClipMesh::TestTraces
+//
+// Fuzzes the accelerated trace against the brute force one with
+// random rays and boxes around the mesh. Returns the number of
+// traces that gave different results
+//
+
+int kexClipMesh::TestTraces(const int count) {
+    traceInfo_t t1;
+    traceInfo_t t2;
+    kexBBox bounds;
+    kexVec3 size;
+    kexVec3 center;
+    int mismatches = 0;
+
+    if(nodes == NULL) {
+        return 0;
+    }
+
+    // don't touch the game's random seed
+#define CM_RAND()   ((float)kexRand::SysRand() / (float)RAND_MAX)
+#define CM_CRAND()  (CM_RAND() * 2.0f - 1.0f)
+
+    bounds = nodes[0].bounds;
+    center = bounds.Center();
+    size = (bounds.max - bounds.min) * 0.75f + kexVec3(8, 8, 8);
+
+    for(int i = 0; i < count; i++) {
+        t1.hitMesh = NULL;
+        t1.hitTri = NULL;
+        t1.hitActor = NULL;
+        t1.owner = NULL;
+        t1.sector = NULL;
+        t1.hitNormal.Clear();
+        t1.bbox.Clear();
+        t1.localBBox.Clear();
+
+        t1.start = center + kexVec3(size.x * CM_CRAND(),
+                                    size.y * CM_CRAND(),
+                                    size.z * CM_CRAND());
+        t1.end   = center + kexVec3(size.x * CM_CRAND(),
+                                    size.y * CM_CRAND(),
+                                    size.z * CM_CRAND());
+        t1.dir = t1.end - t1.start;
+        t1.dir.Normalize();
+        t1.fraction = 1.0f;
+        t1.hitVector = t1.end;
+        t1.bUseBBox = (i & 1) != 0;
+
+        if(t1.bUseBBox) {
+            float r = 2.0f + CM_RAND() * 32.0f;
+
+            t1.localBBox.min.Set(-r, 0, -r);
+            t1.localBBox.max.Set(r, r * 2, r);
+            t1.bbox = t1.localBBox;
+            t1.bbox.min += t1.start;
+            t1.bbox.max += t1.start;
+        }
+
+        t2 = t1;
+
+        TraceBruteForce(&t1);
+        Trace(&t2);
+
+        if( t1.hitTri != t2.hitTri ||
+            t1.fraction != t2.fraction ||
+            t1.hitVector.x != t2.hitVector.x ||
+            t1.hitVector.y != t2.hitVector.y ||
+            t1.hitVector.z != t2.hitVector.z) {
+                mismatches++;
+        }
+    }
+
+#undef CM_RAND
+#undef CM_CRAND
+
+    return mismatches;
 }
 
 //
@@ -806,6 +1375,7 @@ void kexClipMesh::DebugDraw(void) {
     renderBackend.SetState(GLSTATE_BLEND, true);
     renderBackend.SetState(GLSTATE_ALPHATEST, true);
 
+    cpuVertList.Flush();
     dglDisableClientState(GL_NORMAL_ARRAY);
     dglDisableClientState(GL_TEXTURE_COORD_ARRAY);
 
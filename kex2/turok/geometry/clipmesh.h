@@ -42,6 +42,32 @@ typedef enum {
 
 class kexWorldModel;
 
+//
+// four triangle planes packed together so they can be
+// tested against a trace in one go
+//
+typedef struct {
+    float                   a[4];
+    float                   b[4];
+    float                   c[4];
+    float                   d[4];
+    kexTri                  *tris[4];
+    int                     order[4];
+} cmPacket_t;
+
+typedef struct {
+    kexTri                  *tri;
+    kexVec3                 center;
+    int                     order;
+} cmBuildTri_t;
+
+typedef struct {
+    kexBBox                 bounds;
+    int                     child;      // second child is child+1, -1 if leaf
+    int                     firstPacket;
+    int                     numPackets;
+} cmNode_t;
+
 class kexClipMesh {
 public:
                             kexClipMesh(void);
@@ -52,6 +78,8 @@ public:
     void                    CreateShape(void);
     void                    Transform(void);
     bool                    Trace(traceInfo_t *trace);
+    bool                    TraceBruteForce(traceInfo_t *trace);
+    int                     TestTraces(const int count);
 
     const clipMeshType_t    GetType(void) const { return type; }
     void                    SetType(const clipMeshType_t _type) { type = _type; }
@@ -79,9 +107,26 @@ private:
     } cmGroup_t;
 
     void                    AllocateCmGroup(cmGroup_t *group, const int numPoints, const int numIndices);
+    void                    FreeTree(void);
+    void                    BuildTree(void);
+    void                    BuildNode(const int nodeNum, cmBuildTri_t *tris, const int count);
+    void                    GetTriBounds(const cmBuildTri_t *tris, const int count,
+                                         kexBBox &bounds, kexBBox &centers) const;
+    void                    FillPackets(cmNode_t *node, cmBuildTri_t *tris, const int count);
+    bool                    NodeInRange(const traceInfo_t *trace, const cmNode_t *node,
+                                        const float radius) const;
+    unsigned int            PacketMask(const traceInfo_t *trace, const cmPacket_t *packet) const;
+    bool                    IsConvex(void) const;
+
+    static bool             TestTriangle(const traceInfo_t *trace, kexTri *tri, const float maxFrac,
+                                         float &frac, kexVec3 &hit);
 
     unsigned int            numGroups;
     cmGroup_t               *cmGroups;
+    int                     numNodes;
+    cmNode_t                *nodes;
+    int                     numPackets;
+    cmPacket_t              *packets;
     kexVec3                 origin;
     clipMeshType_t          type;
     kexWorldModel           *owner;
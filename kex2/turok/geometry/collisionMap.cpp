@@ -46,6 +46,24 @@
 
 kexHeapBlock kexCollisionMap::hb_collisionMap("collision map", false, NULL, NULL);
 
+#ifndef EDITOR
+
+//
+// testcollisiontraces
+//
+
+COMMAND(testcollisiontraces) {
+    int count = 10000;
+
+    if(command.GetArgc() >= 2) {
+        count = atoi(command.GetArgv(1));
+    }
+
+    localWorld.CollisionMap().TestTraces(count);
+}
+
+#endif
+
 //
 // kexSector::kexSector
 //
@@ -284,6 +302,7 @@ kexSector *kexSector::CrossEdge(cMapTrace_t *trace, const int edge) {
 
 kexCollisionMap::kexCollisionMap(void) {
     this->bLoaded       = false;
+    this->changeCount   = 0;
     this->points[0]     = NULL;
     this->points[1]     = NULL;
     this->sectors       = NULL;
@@ -291,6 +310,8 @@ kexCollisionMap::kexCollisionMap(void) {
     this->numSectors    = 0;
     this->numAreas      = 0;
 
+    memset(&this->compiled, 0, sizeof(cMapCompiled_t));
+
     this->areas.Empty();
 }
 
@@ -321,7 +342,7 @@ void kexCollisionMap::Load(const char *name) {
     int numKeys;
 
     if(!binFile.Open(name)) {
-        common.Warning("kexCollisionMap::Load: %s not found\n", name);
+        common.Warning(LC_GAME, "kexCollisionMap::Load: %s not found\n", name);
         return;
     }
 
@@ -329,7 +350,7 @@ void kexCollisionMap::Load(const char *name) {
 
     if(numAreas <= 0) {
         binFile.Close();
-        common.Warning("kexCollisionMap::Load: couldn't load %s\n", name);
+        common.Warning(LC_GAME, "kexCollisionMap::Load: couldn't load %s\n", name);
         return;
     }
 
@@ -451,6 +472,7 @@ void kexCollisionMap::Load(const char *name) {
 
     renderBackend.DrawLoadingScreen("Setting Up Sector Stacks...");
     SetupSectorStackList();
+    CompileSectors();
 }
 
 //
@@ -480,6 +502,8 @@ void kexCollisionMap::Unload(void) {
 
     areas.Empty();
     Mem_Purge(kexCollisionMap::hb_collisionMap);
+
+    memset(&compiled, 0, sizeof(cMapCompiled_t));
 }
 
 //
@@ -583,6 +607,9 @@ void kexCollisionMap::RecursiveChangeHeight(kexSector *sector, float destHeight,
         return;
     }
 
+    // lets sleeping physics bodies know the floor may have moved
+    changeCount++;
+
     sec = sector;
 
     for(i = 0; i < 3; i++) {
@@ -594,6 +621,7 @@ void kexCollisionMap::RecursiveChangeHeight(kexSector *sector, float destHeight,
             sec->link[i]->lowerTri.point[0],
             sec->link[i]->lowerTri.point[1],
             sec->link[i]->lowerTri.point[2]);
+        SyncSector(sec->link[i]);
     }
 
     while(sec->area->WorldID() == areaID) {
@@ -607,6 +635,8 @@ void kexCollisionMap::RecursiveChangeHeight(kexSector *sector, float destHeight,
             sec->lowerTri.point[i]->y = destHeight;
         }
 
+        SyncSector(sec);
+
         if(sec->link[0]) {
             RecursiveChangeHeight(sec->link[0], destHeight, areaID);
         }
@@ -630,6 +660,7 @@ void kexCollisionMap::RecursiveChangeHeight(kexSector *sector, float destHeight,
                 sec->link[i]->lowerTri.point[0],
                 sec->link[i]->lowerTri.point[1],
                 sec->link[i]->lowerTri.point[2]);
+            SyncSector(sec->link[i]);
         }
     }
 }
@@ -672,6 +703,80 @@ void kexCollisionMap::TraverseSectors(cMapTrace_t *trace, kexSector *sector) {
     }
 }
 
+//
+// kexCollisionMap::SetupTrace
+//
+
+bool kexCollisionMap::SetupTrace(cMapTrace_t *trace, cMapTraceResult_t *result,
+                                 const kexVec3 &start, const kexVec3 &end,
+                                 kexSector *sector, const int flags,
+                                 const float height) {
+    trace->result = result;
+
+    trace->result->position      = end;
+    trace->result->fraction      = 1.0f;
+    trace->result->sector        = sector;
+    trace->result->contactSector = NULL;
+    trace->result->bClippedEdge  = false;
+
+    if(bLoaded == false || sector == NULL) {
+        return false;
+    }
+
+    trace->start     = start;
+    trace->end       = end;
+    trace->sector    = sector;
+    trace->flags     = flags;
+    trace->height    = height;
+    trace->direction = (end - start).Normalize();
+
+    trace->result->normal = trace->direction;
+    return true;
+}
+
+//
+// kexCollisionMap::CheckSectorStacks
+//
+
+void kexCollisionMap::CheckSectorStacks(cMapTrace_t *trace) {
+    kexVec3 pos;
+    kexSector *s;
+
+    for(unsigned int i = 0; i < trace->result->sector->stacks.Length(); i++) {
+        s = trace->result->sector->stacks[i];
+        pos = trace->result->position;
+        
+        if((pos[1] - s->lowerTri.GetDistance(pos)) >= 0 && s->InRange(pos)) {
+            trace->result->sector = s;
+        }
+    }
+}
+
+//
+// kexCollisionMap::TraceSectors
+//
+// Reference trace that walks the kexSector/kexTri objects directly.
+// Kept around to validate the compiled trace against
+//
+
+void kexCollisionMap::TraceSectors(cMapTraceResult_t *result,
+                                   const kexVec3 &start, const kexVec3 &end,
+                                   kexSector *sector,
+                                   const int flags,
+                                   const float height) {
+    cMapTrace_t trace;
+
+    if(!SetupTrace(&trace, result, start, end, sector, flags, height)) {
+        return;
+    }
+
+    if(!sector->Trace(&trace, false)) {
+        TraverseSectors(&trace, sector);
+    }
+
+    CheckSectorStacks(&trace);
+}
+
 //
 // kexCollisionMap::Trace
 //
@@ -682,42 +787,512 @@ void kexCollisionMap::Trace(cMapTraceResult_t *result,
                             const int flags,
                             const float height) {
     cMapTrace_t trace;
-    kexVec3 pos;
-    kexSector *s;
 
-    trace.result = result;
+    if(!SetupTrace(&trace, result, start, end, sector, flags, height)) {
+        return;
+    }
 
-    trace.result->position      = end;
-    trace.result->fraction      = 1.0f;
-    trace.result->sector        = sector;
-    trace.result->contactSector = NULL;
-    trace.result->bClippedEdge  = false;
+    TraceCompiled(&trace, sector - sectors);
+    CheckSectorStacks(&trace);
+}
 
-    if(bLoaded == false || sector == NULL) {
+//
+// kexCollisionMap::CompileSectors
+//
+// Builds the flattened sector data from the loaded sectors
+//
+
+void kexCollisionMap::CompileSectors(void) {
+    kexSector *sec;
+    kexVec3 *pt1;
+    kexVec3 *pt2;
+    int i;
+    int j;
+
+    compiled.vx     = (float*)Mem_Malloc(sizeof(float) * numPoints, hb_collisionMap);
+    compiled.vy[0]  = (float*)Mem_Malloc(sizeof(float) * numPoints, hb_collisionMap);
+    compiled.vy[1]  = (float*)Mem_Malloc(sizeof(float) * numPoints, hb_collisionMap);
+    compiled.vz     = (float*)Mem_Malloc(sizeof(float) * numPoints, hb_collisionMap);
+    compiled.verts  = (int*)Mem_Malloc(sizeof(int) * numSectors * 3, hb_collisionMap);
+    compiled.planeX = (float*)Mem_Malloc(sizeof(float) * numSectors * 2, hb_collisionMap);
+    compiled.planeY = (float*)Mem_Malloc(sizeof(float) * numSectors * 2, hb_collisionMap);
+    compiled.planeZ = (float*)Mem_Malloc(sizeof(float) * numSectors * 2, hb_collisionMap);
+    compiled.planeD = (float*)Mem_Malloc(sizeof(float) * numSectors * 2, hb_collisionMap);
+    compiled.edgeX  = (float*)Mem_Malloc(sizeof(float) * numSectors * 3, hb_collisionMap);
+    compiled.edgeZ  = (float*)Mem_Malloc(sizeof(float) * numSectors * 3, hb_collisionMap);
+    compiled.links  = (int*)Mem_Malloc(sizeof(int) * numSectors * 3, hb_collisionMap);
+    compiled.flags  = (unsigned int*)Mem_Malloc(sizeof(int) * numSectors, hb_collisionMap);
+
+    for(i = 0; i < numPoints; i++) {
+        compiled.vx[i]      = points[0][i].x;
+        compiled.vy[0][i]   = points[0][i].y;
+        compiled.vy[1][i]   = points[1][i].y;
+        compiled.vz[i]      = points[0][i].z;
+    }
+
+    for(i = 0; i < numSectors; i++) {
+        sec = &sectors[i];
+
+        for(j = 0; j < 3; j++) {
+            pt1 = sec->lowerTri.point[(j+0)%3];
+            pt2 = sec->lowerTri.point[(j+1)%3];
+
+            compiled.verts[i * 3 + j] = indices[i * 3 + j];
+            compiled.links[i * 3 + j] = sec->link[j] ? sec->link[j] - sectors : -1;
+
+            // same as kexVec2::Cross(pt1, pt2). edges never change
+            // horizontally so these are only computed once
+            compiled.edgeX[i * 3 + j] = pt2->z - pt1->z;
+            compiled.edgeZ[i * 3 + j] = pt1->x - pt2->x;
+        }
+
+        SyncSector(sec);
+    }
+}
+
+//
+// kexCollisionMap::SyncSector
+//
+// Copies the parts of a sector that can change at runtime
+// (floor heights, planes and flags) into the compiled data
+//
+
+void kexCollisionMap::SyncSector(const kexSector *sector) {
+    const kexTri *tri;
+    int id;
+
+    if(compiled.flags == NULL) {
         return;
     }
 
-    trace.start     = start;
-    trace.end       = end;
-    trace.sector    = sector;
-    trace.flags     = flags;
-    trace.height    = height;
-    trace.direction = (end - start).Normalize();
+    id = sector - sectors;
 
-    trace.result->normal = trace.direction;
+    for(int i = 0; i < 3; i++) {
+        compiled.vy[0][compiled.verts[id * 3 + i]] = sector->lowerTri.point[i]->y;
+    }
 
-    if(!sector->Trace(&trace, false)) {
-        TraverseSectors(&trace, sector);
+    for(int i = 0; i < 2; i++) {
+        tri = (i == 0) ? &sector->lowerTri : &sector->upperTri;
+
+        compiled.planeX[id * 2 + i] = tri->plane.a;
+        compiled.planeY[id * 2 + i] = tri->plane.b;
+        compiled.planeZ[id * 2 + i] = tri->plane.c;
+        compiled.planeD[id * 2 + i] = tri->plane.d;
     }
 
-    for(unsigned int i = 0; i < trace.result->sector->stacks.Length(); i++) {
-        s = trace.result->sector->stacks[i];
-        pos = trace.result->position;
-        
-        if((pos[1] - s->lowerTri.GetDistance(pos)) >= 0 && s->InRange(pos)) {
-            trace.result->sector = s;
+    compiled.flags[id] = sector->flags;
+}
+
+//
+// kexCollisionMap::GetCompiledPoints
+//
+// Ceiling points are stored in reverse order, same as upperTri
+//
+
+void kexCollisionMap::GetCompiledPoints(const int sector, const int bCeiling,
+                                        kexVec3 *out) const {
+    int v;
+
+    for(int i = 0; i < 3; i++) {
+        v = compiled.verts[sector * 3 + (bCeiling ? 2 - i : i)];
+        out[i].Set(compiled.vx[v], compiled.vy[bCeiling][v], compiled.vz[v]);
+    }
+}
+
+//
+// kexCollisionMap::GetCompiledNormal
+//
+
+const kexVec3 kexCollisionMap::GetCompiledNormal(const int plane) const {
+    return kexVec3(compiled.planeX[plane], compiled.planeY[plane], compiled.planeZ[plane]);
+}
+
+//
+// kexCollisionMap::CompiledWall
+//
+// Same as kexSector::Wall
+//
+
+bool kexCollisionMap::CompiledWall(const int sector) const {
+    unsigned int flags = compiled.flags[sector];
+
+    if(!(flags & CLF_SLOPETEST)) {
+        return (flags & CLF_FRONTNOCLIP) != 0;
+    }
+
+    return (compiled.planeY[sector * 2] <= 0.5f);
+}
+
+//
+// kexCollisionMap::CompiledCheckHeight
+//
+// Same as kexSector::CheckHeight
+//
+
+bool kexCollisionMap::CompiledCheckHeight(const int sector, const kexVec3 &pos) const {
+    if(CompiledWall(sector)) {
+        const int *v = &compiled.verts[sector * 3];
+        float y = pos[1] + 16.384f;
+
+        if( y > compiled.vy[0][v[0]] &&
+            y > compiled.vy[0][v[1]] &&
+            y > compiled.vy[0][v[2]]) {
+                return false;
+        }
+    }
+    return true;
+}
+
+//
+// kexCollisionMap::CompiledIntersectEdge
+//
+// Same as kexSector::IntersectEdge
+//
+
+bool kexCollisionMap::CompiledIntersectEdge(cMapTrace_t *trace, const int sector,
+                                            const int edge) const {
+    int v = compiled.verts[sector * 3 + edge];
+    kexVec2 cp(compiled.edgeX[sector * 3 + edge], compiled.edgeZ[sector * 3 + edge]);
+    kexVec2 pt1(compiled.vx[v], compiled.vz[v]);
+    kexVec2 tStart;
+    kexVec2 tEnd;
+    float d;
+
+    tStart = trace->start;
+    tEnd = trace->end;
+
+    d = cp.Dot(tEnd - tStart);
+
+    if(d < 0) {
+        d = 1.0f + (cp.Dot(pt1 - tEnd) / d);
+
+        if(d < 1 && d < trace->result->fraction) {
+            trace->result->fraction = d;
+            trace->result->position = trace->start.Lerp(trace->end, d);
+            trace->result->normal.Set(cp[0], 0, cp[1]);
+            trace->result->normal.Normalize();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// kexCollisionMap::CompiledTrace
+//
+// Same as kexSector::Trace
+//
+
+bool kexCollisionMap::CompiledTrace(cMapTrace_t *trace, const int sector,
+                                    const bool bTestCeiling) {
+    int p = sector * 2 + (bTestCeiling ? 1 : 0);
+    kexPlane plane(compiled.planeX[p], compiled.planeY[p], compiled.planeZ[p], compiled.planeD[p]);
+    float distStart;
+    float distEnd;
+    float dist;
+
+    if(plane.Distance(trace->direction) >= 0) {
+        return false;
+    }
+
+    dist = plane.d;
+
+    if(bTestCeiling) {
+        dist -= (trace->height * plane.Normal().y);
+    }
+
+    distStart = plane.Distance(trace->start) - dist;
+    distEnd   = plane.Distance(trace->end) - dist;
+
+    if(!(distStart <= distEnd || distStart < 0 || distEnd > 0)) {
+        float frac = (distStart / (distStart - distEnd));
+
+        if(frac >= 0 && frac <= 1 && frac < trace->result->fraction) {
+            kexVec3 hit = trace->start.Lerp(trace->end, frac);
+            kexVec3 pts[3];
+            float expand = 0;
+
+            if(bTestCeiling) {
+                expand = CEILING_EXPAND;
+            }
+
+            GetCompiledPoints(sector, bTestCeiling, pts);
+
+            if(kexTri::PointInRange(pts, plane.Normal(), hit, expand)) {
+                trace->result->position = hit;
+                trace->result->fraction = frac;
+                trace->result->normal = plane.Normal();
+                trace->result->contactSector = &sectors[sector];
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+//
+// kexCollisionMap::CompiledCrossEdge
+//
+// Same as kexSector::CrossEdge. Returns -1 if the edge can't be crossed
+//
+
+int kexCollisionMap::CompiledCrossEdge(cMapTrace_t *trace, const int sector, const int edge) {
+    int next = compiled.links[sector * 3 + edge];
+
+    if(next == -1) {
+        return -1;
+    }
+
+    cMapTraceResult_t *result = trace->result;
+    unsigned int curFlags = compiled.flags[sector];
+    unsigned int nextFlags = compiled.flags[next];
+    bool bCurWall;
+    bool bNextWall;
+
+    // don't cross blocking sectors
+    if(nextFlags & CLF_BLOCK && !(nextFlags & CLF_TOGGLE)) {
+        result->contactSector = &sectors[next];
+        return -1;
+    }
+
+    if(nextFlags & CLF_CHECKHEIGHT) {
+        kexVec3 upperPts[3];
+
+        GetCompiledPoints(next, 1, upperPts);
+
+        if((kexTri::GetDistance(upperPts, GetCompiledNormal(next * 2 + 1), result->position) -
+            trace->height) < result->position[1]) {
+            return -1;
+        }
+    }
+
+    bCurWall = CompiledWall(sector);
+    bNextWall = CompiledWall(next);
+
+    if(bCurWall) {
+        if(nextFlags & CLF_CLIMB) {
+            return next;
+        }
+
+        if(!bNextWall) {
+            return next;
+        }
+
+        if(curFlags & CLF_CLIMB && !(nextFlags & CLF_CLIMB)) {
+            kexVec3 curPts[3];
+
+            GetCompiledPoints(sector, 0, curPts);
+
+            if(kexTri::GetDistance(curPts, GetCompiledNormal(sector * 2),
+                result->position) + 1.024f > result->position[1]) {
+                    return -1;
+            }
+        }
+    }
+
+    // moving in and out of water
+    if(curFlags & CLF_WATER && !(nextFlags & CLF_WATER) &&
+        trace->flags & PF_NOEXITWATER) {
+            return -1;
+    }
+
+    if(!(curFlags & CLF_WATER) && nextFlags & CLF_WATER &&
+        trace->flags & PF_NOENTERWATER) {
+            return -1;
+    }
+
+    // crossing into a wall or a very steep slope
+    if(bNextWall && !bCurWall && !(nextFlags & CLF_CLIMB)) {
+        kexVec3 curPts[3];
+        kexVec3 nextPts[3];
+        float dist1;
+        float dist2;
+
+        GetCompiledPoints(sector, 0, curPts);
+        GetCompiledPoints(next, 0, nextPts);
+
+        dist1 = kexTri::GetDistance(nextPts, GetCompiledNormal(next * 2), trace->end);
+        dist2 = kexTri::GetDistance(curPts, GetCompiledNormal(sector * 2), trace->start);
+
+        // handle steps and drop-offs
+        if(dist1 <= dist2) {
+            float len = (nextPts[0].y +
+                nextPts[1].y +
+                nextPts[2].y) / 3;
+
+            if(len < 0) {
+                len = -len;
+            }
+
+            if(!CompiledCheckHeight(next, trace->end) && len >= STEPHEIGHT &&
+                !(trace->flags & PF_DROPOFF)) {
+                return -1;
+            }
+
+            // able to step off into this plane
+            return next;
+        }
+
+        // special case for planes flagged to block
+        // from the front side
+        kexPlane plane(compiled.planeX[next * 2], compiled.planeY[next * 2],
+                       compiled.planeZ[next * 2], compiled.planeD[next * 2]);
+
+        if(CompiledCheckHeight(next, result->position) &&
+            plane.IsFacing(trace->direction.ToYaw())) {
+                return -1;
         }
     }
+
+    return next;
+}
+
+//
+// kexCollisionMap::TraceCompiled
+//
+// Same walk as TraverseSectors but over the compiled data. The
+// recursion there is a tail call so this is just a loop
+//
+
+void kexCollisionMap::TraceCompiled(cMapTrace_t *trace, int sector) {
+    cMapTraceResult_t *result = trace->result;
+    int next;
+    int i;
+
+    if(CompiledTrace(trace, sector, false)) {
+        return;
+    }
+
+    for(;;) {
+        result->sector = &sectors[sector];
+        result->fraction = 1;
+
+        if(compiled.flags[sector] & CLF_CHECKHEIGHT && CompiledTrace(trace, sector, true)) {
+            // made contact
+            return;
+        }
+        if(CompiledTrace(trace, sector, false)) {
+            // made contact
+            return;
+        }
+
+        next = -1;
+
+        for(i = 0; i < 3; i++) {
+            if(CompiledIntersectEdge(trace, sector, i)) {
+                next = CompiledCrossEdge(trace, sector, i);
+            }
+        }
+
+        if(next == -1) {
+            result->bClippedEdge = true;
+            return;
+        }
+
+        sector = next;
+    }
+}
+
+//
+// kexCollisionMap::TestTraces
+//
+// Fires a set of random traces through both the reference and the
+// compiled trace, reports any results that differ and how many
+// traces per second each one manages
+//
+
+void kexCollisionMap::TestTraces(const int count) {
+    typedef struct {
+        kexVec3     start;
+        kexVec3     end;
+        kexSector   *sector;
+        int         flags;
+        float       height;
+    } testTrace_t;
+
+    static const int testFlags[4] = {
+        0, PF_CLIPEDGES, PF_DROPOFF, PF_NOENTERWATER|PF_NOEXITWATER
+    };
+
+    testTrace_t *traces;
+    cMapTraceResult_t r1;
+    cMapTraceResult_t r2;
+    kexVec3 dir;
+    int mismatches;
+    int time1;
+    int time2;
+    int i;
+
+    if(bLoaded == false || numSectors <= 0 || count <= 0) {
+        common.Warning(LC_GAME, "kexCollisionMap::TestTraces: no collision map loaded\n");
+        return;
+    }
+
+    traces = (testTrace_t*)Mem_Malloc(sizeof(testTrace_t) * count, hb_collisionMap);
+
+    for(i = 0; i < count; i++) {
+        testTrace_t *t = &traces[i];
+
+        // rand() may only give 15 bits
+        t->sector = &sectors[(((unsigned int)kexRand::SysRand() << 15) ^
+            (unsigned int)kexRand::SysRand()) % numSectors];
+        t->start = t->sector->lowerTri.GetCenterPoint();
+        t->start.y += 1.0f;
+
+        dir.Set((float)(kexRand::SysRand() % 2049 - 1024),
+                (float)(kexRand::SysRand() % 257 - 128),
+                (float)(kexRand::SysRand() % 2049 - 1024));
+
+        t->end = t->start + dir;
+        t->flags = testFlags[kexRand::SysRand() & 3];
+        t->height = (kexRand::SysRand() & 1) ? 51.2f : 0;
+    }
+
+    mismatches = 0;
+
+    for(i = 0; i < count; i++) {
+        testTrace_t *t = &traces[i];
+
+        TraceSectors(&r1, t->start, t->end, t->sector, t->flags, t->height);
+        Trace(&r2, t->start, t->end, t->sector, t->flags, t->height);
+
+        if( r1.sector != r2.sector ||
+            r1.contactSector != r2.contactSector ||
+            r1.position.x != r2.position.x ||
+            r1.position.y != r2.position.y ||
+            r1.position.z != r2.position.z ||
+            r1.normal.x != r2.normal.x ||
+            r1.normal.y != r2.normal.y ||
+            r1.normal.z != r2.normal.z ||
+            r1.fraction != r2.fraction ||
+            r1.bClippedEdge != r2.bClippedEdge) {
+                mismatches++;
+        }
+    }
+
+    time1 = sysMain.GetMS();
+    for(i = 0; i < count; i++) {
+        TraceSectors(&r1, traces[i].start, traces[i].end, traces[i].sector,
+            traces[i].flags, traces[i].height);
+    }
+    time1 = sysMain.GetMS() - time1;
+
+    time2 = sysMain.GetMS();
+    for(i = 0; i < count; i++) {
+        Trace(&r2, traces[i].start, traces[i].end, traces[i].sector,
+            traces[i].flags, traces[i].height);
+    }
+    time2 = sysMain.GetMS() - time2;
+
+    Mem_Free(traces);
+
+    common.Printf(LC_GAME, "%i traces, %i mismatches\n", count, mismatches);
+    common.Printf(LC_GAME, "reference: %ims (%.0f traces/sec)\n", time1,
+        time1 > 0 ? (float)count * 1000.0f / (float)time1 : 0.0f);
+    common.Printf(LC_GAME, "compiled: %ims (%.0f traces/sec)\n", time2,
+        time2 > 0 ? (float)count * 1000.0f / (float)time2 : 0.0f);
 }
 
 //
@@ -764,6 +1339,7 @@ void kexCollisionMap::RecursiveToggleBlock(kexSector *sector, bool bToggle,
             }
 
             sec->flags |= CLF_TOGGLE;
+            SyncSector(sec);
         }
         else {
             if(!(sec->flags & CLF_TOGGLE)) {
@@ -771,6 +1347,7 @@ void kexCollisionMap::RecursiveToggleBlock(kexSector *sector, bool bToggle,
             }
 
             sec->flags &= ~CLF_TOGGLE;
+            SyncSector(sec);
         }
 
         if(sec->link[0] != NULL) {
@@ -804,5 +1381,8 @@ void kexCollisionMap::ToggleBlock(const kexVec3 pos, bool bToggle) {
         return;
     }
 
+    // blocking sectors changed, so wake anything sleeping on them
+    changeCount++;
+
     RecursiveToggleBlock(sector, bToggle, sector->area->WorldID());
 }
@@ -78,6 +78,28 @@ typedef struct {
     cMapTraceResult_t               *result;
 } cMapTrace_t;
 
+//
+// flattened copy of the sector data that traces read. everything is kept
+// in parallel arrays so walking from sector to sector touches a handful of
+// contiguous cache lines instead of chasing kexTri/kexVec3 pointers.
+// planes are indexed by (sector * 2 + bCeiling), edges and vertex indices
+// by (sector * 3 + edge)
+//
+typedef struct {
+    float                           *vx;
+    float                           *vy[2];
+    float                           *vz;
+    int                             *verts;
+    float                           *planeX;
+    float                           *planeY;
+    float                           *planeZ;
+    float                           *planeD;
+    float                           *edgeX;
+    float                           *edgeZ;
+    int                             *links;
+    unsigned int                    *flags;
+} cMapCompiled_t;
+
 class kexSector {
 public:
                                     kexSector(void);
@@ -112,12 +134,18 @@ public:
                                           kexSector *sector,
                                           const int flags,
                                           const float height = 0);
+    void                            TraceSectors(cMapTraceResult_t *result,
+                                                 const kexVec3 &start, const kexVec3 &end,
+                                                 kexSector *sector,
+                                                 const int flags,
+                                                 const float height = 0);
     void                            TraverseSectors(cMapTrace_t *trace, kexSector *sector);
     kexSector                       *PointInSector(const kexVec3 &origin);
     void                            PlayerCrossAreas(kexSector *enter, kexSector *exit);
     void                            RecursiveChangeHeight(kexSector *sector, float destHeight,
                                         unsigned int areaID);
     void                            ToggleBlock(const kexVec3 pos, bool bToggle);
+    void                            TestTraces(const int count);
 
     kexVec3                         *points[2];
     word                            *indices;
@@ -128,15 +156,38 @@ public:
     kexArray<kexArea*>              areas;
 
     const bool                      IsLoaded(void) const { return bLoaded; }
+    const unsigned int              ChangeCount(void) const { return changeCount; }
 
     static kexHeapBlock             hb_collisionMap;
 
 private:
     void                            SetupSectorStackList(void);
+    void                            CompileSectors(void);
+    void                            SyncSector(const kexSector *sector);
+    void                            GetCompiledPoints(const int sector, const int bCeiling,
+                                                      kexVec3 *out) const;
+    const kexVec3                   GetCompiledNormal(const int plane) const;
+    bool                            CompiledWall(const int sector) const;
+    bool                            CompiledCheckHeight(const int sector, const kexVec3 &pos) const;
+    bool                            CompiledIntersectEdge(cMapTrace_t *trace, const int sector,
+                                                          const int edge) const;
+    bool                            CompiledTrace(cMapTrace_t *trace, const int sector,
+                                                  const bool bTestCeiling);
+    int                             CompiledCrossEdge(cMapTrace_t *trace, const int sector,
+                                                      const int edge);
+    void                            TraceCompiled(cMapTrace_t *trace, int sector);
+    bool                            SetupTrace(cMapTrace_t *trace, cMapTraceResult_t *result,
+                                               const kexVec3 &start, const kexVec3 &end,
+                                               kexSector *sector, const int flags,
+                                               const float height);
+    void                            CheckSectorStacks(cMapTrace_t *trace);
+
+    cMapCompiled_t                  compiled;
     void                            RecursiveToggleBlock(kexSector *sector, bool bToggle,
                                         unsigned int areaID);
 
     bool                            bLoaded;
+    unsigned int                    changeCount;
 };
 
 #endif
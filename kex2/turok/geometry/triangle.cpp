@@ -119,6 +119,24 @@ void kexTri::SetPlueckerEdges(void) {
 //
 
 bool kexTri::PointInRange(const kexVec3 &pt, const float expand) {
+    kexVec3 points[3];
+
+    points[0] = *point[0];
+    points[1] = *point[1];
+    points[2] = *point[2];
+
+    return PointInRange(points, plane.Normal(), pt, expand);
+}
+
+//
+// kexTri::PointInRange
+//
+// Also used by the compiled collision map, which doesn't
+// keep kexTri objects around
+//
+
+bool kexTri::PointInRange(const kexVec3 *points, const kexVec3 &normal,
+                          const kexVec3 &pt, const float expand) {
     float rSq = expand * expand;
     float eSq;
     kexVec3 cp;
@@ -130,16 +148,16 @@ bool kexTri::PointInRange(const kexVec3 &pt, const float expand) {
     kexVec3 edge;
 
     for(int i = 0; i < 3; i++) {
-        pt1 = *point[(i+0)%3];
-        pt2 = *point[(i+1)%3];
-        pt3 = *point[(i+2)%3];
+        pt1 = points[(i+0)%3];
+        pt2 = points[(i+1)%3];
+        pt3 = points[(i+2)%3];
 
         dp1 = pt1 - pt;
         dp2 = pt2 - pt;
 
         cp = dp1.Cross(dp2);
 
-        if(plane.Normal().Dot(cp) >= 0) {
+        if(normal.Dot(cp) >= 0) {
             continue;
         }
 
@@ -178,24 +196,38 @@ bool kexTri::PointInRange(const kexVec3 &pt, const float expand) {
 //
 
 const float kexTri::GetDistance(const kexVec3 &pos) const {
+    kexVec3 points[3];
+
+    points[0] = *point[0];
+    points[1] = *point[1];
+    points[2] = *point[2];
+
+    return GetDistance(points, plane.Normal(), pos);
+}
+
+//
+// kexTri::GetDistance
+//
+
+float kexTri::GetDistance(const kexVec3 *points, const kexVec3 &normal,
+                          const kexVec3 &pos) {
     float dist = 0;
-    kexVec3 n = plane.Normal();
     
     //
     // if the plane is standing straight up (aka its a wall) then
     // get the sum of the height from all 3 points
     //
-    if(n.y == 0) {
+    if(normal.y == 0) {
         dist = (
-            point[0]->y +
-            point[1]->y +
-            point[2]->y) / 3;
+            points[0].y +
+            points[1].y +
+            points[2].y) / 3;
     }
     else {
         dist = kexVec3::Dot(kexVec3(
-            point[0]->x - pos.x,
-            point[0]->y,
-            point[0]->z - pos.z), n) / n.y;
+            points[0].x - pos.x,
+            points[0].y,
+            points[0].z - pos.z), normal) / normal.y;
     }
     
     return dist;
@@ -44,6 +44,11 @@ public:
     const float     GetEdgeYaw(const int idx) const;
     const kexVec3   GetCenterPoint(void) const;
 
+    static bool     PointInRange(const kexVec3 *points, const kexVec3 &normal,
+                                 const kexVec3 &pt, const float expand);
+    static float    GetDistance(const kexVec3 *points, const kexVec3 &normal,
+                                const kexVec3 &pos);
+
     // debugging
     int             id;
     bool            bTraced;
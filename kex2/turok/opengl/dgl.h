@@ -27,6 +27,7 @@
 
 //#define LOG_GLFUNC_CALLS
 //#define USE_DEBUG_GLFUNCS
+//#define USE_MOCK_GLFUNCS
 
 #ifdef USE_DEBUG_GLFUNCS
 void dglLogError(const char *message, const char *file, int line);
@@ -5915,6 +5916,149 @@ has_GL_EXT_texture_array = GL_CheckExtension("GL_EXT_texture_array");
 #define GL_EXT_texture_array_Init() has_GL_EXT_texture_array = true;
 #endif // __IPHONEOS__
 
+//
+// GL_ARB_texture_compression
+//
+extern bool has_GL_ARB_texture_compression;
+
+#ifndef __IPHONEOS__
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXIMAGE3DARBPROC) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXIMAGE2DARBPROC) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXIMAGE1DARBPROC) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXSUBIMAGE3DARBPROC) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLCOMPRESSEDTEXSUBIMAGE1DARBPROC) (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid* data);
+typedef void (APIENTRYP PFNGLGETCOMPRESSEDTEXIMAGEARBPROC) (GLenum target, GLint level, GLvoid* img);
+#endif // __IPHONEOS__
+
+#ifndef __IPHONEOS__
+extern PFNGLCOMPRESSEDTEXIMAGE3DARBPROC _glCompressedTexImage3DARB;
+extern PFNGLCOMPRESSEDTEXIMAGE2DARBPROC _glCompressedTexImage2DARB;
+extern PFNGLCOMPRESSEDTEXIMAGE1DARBPROC _glCompressedTexImage1DARB;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE3DARBPROC _glCompressedTexSubImage3DARB;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC _glCompressedTexSubImage2DARB;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE1DARBPROC _glCompressedTexSubImage1DARB;
+extern PFNGLGETCOMPRESSEDTEXIMAGEARBPROC _glGetCompressedTexImageARB;
+#endif // __IPHONEOS__
+
+#ifndef __IPHONEOS__
+#define GL_ARB_texture_compression_Define() \
+bool has_GL_ARB_texture_compression = false; \
+PFNGLCOMPRESSEDTEXIMAGE3DARBPROC _glCompressedTexImage3DARB = NULL; \
+PFNGLCOMPRESSEDTEXIMAGE2DARBPROC _glCompressedTexImage2DARB = NULL; \
+PFNGLCOMPRESSEDTEXIMAGE1DARBPROC _glCompressedTexImage1DARB = NULL; \
+PFNGLCOMPRESSEDTEXSUBIMAGE3DARBPROC _glCompressedTexSubImage3DARB = NULL; \
+PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC _glCompressedTexSubImage2DARB = NULL; \
+PFNGLCOMPRESSEDTEXSUBIMAGE1DARBPROC _glCompressedTexSubImage1DARB = NULL; \
+PFNGLGETCOMPRESSEDTEXIMAGEARBPROC _glGetCompressedTexImageARB = NULL
+#else
+#define GL_ARB_texture_compression_Define() bool has_GL_ARB_texture_compression = false;
+#endif // __IPHONEOS__
+
+#ifndef __IPHONEOS__
+#define GL_ARB_texture_compression_Init() \
+has_GL_ARB_texture_compression = GL_CheckExtension("GL_ARB_texture_compression"); \
+_glCompressedTexImage3DARB = (PFNGLCOMPRESSEDTEXIMAGE3DARBPROC)GL_RegisterProc("glCompressedTexImage3DARB"); \
+_glCompressedTexImage2DARB = (PFNGLCOMPRESSEDTEXIMAGE2DARBPROC)GL_RegisterProc("glCompressedTexImage2DARB"); \
+_glCompressedTexImage1DARB = (PFNGLCOMPRESSEDTEXIMAGE1DARBPROC)GL_RegisterProc("glCompressedTexImage1DARB"); \
+_glCompressedTexSubImage3DARB = (PFNGLCOMPRESSEDTEXSUBIMAGE3DARBPROC)GL_RegisterProc("glCompressedTexSubImage3DARB"); \
+_glCompressedTexSubImage2DARB = (PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC)GL_RegisterProc("glCompressedTexSubImage2DARB"); \
+_glCompressedTexSubImage1DARB = (PFNGLCOMPRESSEDTEXSUBIMAGE1DARBPROC)GL_RegisterProc("glCompressedTexSubImage1DARB"); \
+_glGetCompressedTexImageARB = (PFNGLGETCOMPRESSEDTEXIMAGEARBPROC)GL_RegisterProc("glGetCompressedTexImageARB")
+#else
+#define GL_ARB_texture_compression_Init() has_GL_ARB_texture_compression = true;
+#endif // __IPHONEOS__
+
+#ifndef USE_DEBUG_GLFUNCS
+
+#define dglCompressedTexImage3DARB(target, level, internalformat, width, height, depth, border, imageSize, data) _glCompressedTexImage3DARB(target, level, internalformat, width, height, depth, border, imageSize, data)
+#define dglCompressedTexImage2DARB(target, level, internalformat, width, height, border, imageSize, data) _glCompressedTexImage2DARB(target, level, internalformat, width, height, border, imageSize, data)
+#define dglCompressedTexImage1DARB(target, level, internalformat, width, border, imageSize, data) _glCompressedTexImage1DARB(target, level, internalformat, width, border, imageSize, data)
+#define dglCompressedTexSubImage3DARB(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data) _glCompressedTexSubImage3DARB(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data)
+#define dglCompressedTexSubImage2DARB(target, level, xoffset, yoffset, width, height, format, imageSize, data) _glCompressedTexSubImage2DARB(target, level, xoffset, yoffset, width, height, format, imageSize, data)
+#define dglCompressedTexSubImage1DARB(target, level, xoffset, width, format, imageSize, data) _glCompressedTexSubImage1DARB(target, level, xoffset, width, format, imageSize, data)
+#define dglGetCompressedTexImageARB(target, level, img) _glGetCompressedTexImageARB(target, level, img)
+
+#else
+
+d_inline static void glCompressedTexImage3DARB_DEBUG (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexImage3DARB(target=0x%x, level=%i, internalformat=0x%x, width=0x%x, height=0x%x, depth=0x%x, border=%i, imageSize=0x%x, data=%p)\n", file, line, target, level, internalformat, width, height, depth, border, imageSize, data);
+#endif
+    _glCompressedTexImage3DARB(target, level, internalformat, width, height, depth, border, imageSize, data);
+    dglLogError("glCompressedTexImage3DARB", file, line);
+}
+
+d_inline static void glCompressedTexImage2DARB_DEBUG (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexImage2DARB(target=0x%x, level=%i, internalformat=0x%x, width=0x%x, height=0x%x, border=%i, imageSize=0x%x, data=%p)\n", file, line, target, level, internalformat, width, height, border, imageSize, data);
+#endif
+    _glCompressedTexImage2DARB(target, level, internalformat, width, height, border, imageSize, data);
+    dglLogError("glCompressedTexImage2DARB", file, line);
+}
+
+d_inline static void glCompressedTexImage1DARB_DEBUG (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexImage1DARB(target=0x%x, level=%i, internalformat=0x%x, width=0x%x, border=%i, imageSize=0x%x, data=%p)\n", file, line, target, level, internalformat, width, border, imageSize, data);
+#endif
+    _glCompressedTexImage1DARB(target, level, internalformat, width, border, imageSize, data);
+    dglLogError("glCompressedTexImage1DARB", file, line);
+}
+
+d_inline static void glCompressedTexSubImage3DARB_DEBUG (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexSubImage3DARB(target=0x%x, level=%i, xoffset=%i, yoffset=%i, zoffset=%i, width=0x%x, height=0x%x, depth=0x%x, format=0x%x, imageSize=0x%x, data=%p)\n", file, line, target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+#endif
+    _glCompressedTexSubImage3DARB(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+    dglLogError("glCompressedTexSubImage3DARB", file, line);
+}
+
+d_inline static void glCompressedTexSubImage2DARB_DEBUG (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexSubImage2DARB(target=0x%x, level=%i, xoffset=%i, yoffset=%i, width=0x%x, height=0x%x, format=0x%x, imageSize=0x%x, data=%p)\n", file, line, target, level, xoffset, yoffset, width, height, format, imageSize, data);
+#endif
+    _glCompressedTexSubImage2DARB(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+    dglLogError("glCompressedTexSubImage2DARB", file, line);
+}
+
+d_inline static void glCompressedTexSubImage1DARB_DEBUG (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, GLvoid* data, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glCompressedTexSubImage1DARB(target=0x%x, level=%i, xoffset=%i, width=0x%x, format=0x%x, imageSize=0x%x, data=%p)\n", file, line, target, level, xoffset, width, format, imageSize, data);
+#endif
+    _glCompressedTexSubImage1DARB(target, level, xoffset, width, format, imageSize, data);
+    dglLogError("glCompressedTexSubImage1DARB", file, line);
+}
+
+d_inline static void glGetCompressedTexImageARB_DEBUG (GLenum target, GLint level, GLvoid* img, const char* file, int line)
+{
+#ifdef LOG_GLFUNC_CALLS
+    I_Printf("file = %s, line = %i, glGetCompressedTexImageARB(target=0x%x, level=%i, img=%p)\n", file, line, target, level, img);
+#endif
+    _glGetCompressedTexImageARB(target, level, img);
+    dglLogError("glGetCompressedTexImageARB", file, line);
+}
+
+
+#define dglCompressedTexImage3DARB(target, level, internalformat, width, height, depth, border, imageSize, data) glCompressedTexImage3DARB_DEBUG(target, level, internalformat, width, height, depth, border, imageSize, data, __FILE__, __LINE__)
+#define dglCompressedTexImage2DARB(target, level, internalformat, width, height, border, imageSize, data) glCompressedTexImage2DARB_DEBUG(target, level, internalformat, width, height, border, imageSize, data, __FILE__, __LINE__)
+#define dglCompressedTexImage1DARB(target, level, internalformat, width, border, imageSize, data) glCompressedTexImage1DARB_DEBUG(target, level, internalformat, width, border, imageSize, data, __FILE__, __LINE__)
+#define dglCompressedTexSubImage3DARB(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data) glCompressedTexSubImage3DARB_DEBUG(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data, __FILE__, __LINE__)
+#define dglCompressedTexSubImage2DARB(target, level, xoffset, yoffset, width, height, format, imageSize, data) glCompressedTexSubImage2DARB_DEBUG(target, level, xoffset, yoffset, width, height, format, imageSize, data, __FILE__, __LINE__)
+#define dglCompressedTexSubImage1DARB(target, level, xoffset, width, format, imageSize, data) glCompressedTexSubImage1DARB_DEBUG(target, level, xoffset, width, format, imageSize, data, __FILE__, __LINE__)
+#define dglGetCompressedTexImageARB(target, level, img) glGetCompressedTexImageARB_DEBUG(target, level, img, __FILE__, __LINE__)
+
+#endif // USE_DEBUG_GLFUNCS
+
+#ifdef USE_MOCK_GLFUNCS
+#include "dglmock.h"
+#endif
+
 #ifdef __cplusplus
 }
 #endif
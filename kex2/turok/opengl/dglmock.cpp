@@ -0,0 +1,4963 @@
+// Emacs style mode select   -*- C++ -*- 
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2007-2012 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+//
+// Generated by dglmake
+//
+#include "common.h"
+#include "glMock.h"
+
+#ifdef USE_MOCK_GLFUNCS
+
+const GLubyte* APIENTRY mglGetString (GLenum name)
+{
+    return glMock.GetString(name);
+}
+
+void APIENTRY mglAccum (GLenum op, GLfloat value)
+{
+    glMockCall_t* call = glMock.Record(0);
+
+    glMock.ArgInt(call, (int64_t)op);
+    glMock.ArgFloat(call, (double)value);
+}
+
+void APIENTRY mglAlphaFunc (GLenum func, GLclampf ref)
+{
+    glMockCall_t* call = glMock.Record(1);
+
+    glMock.ArgInt(call, (int64_t)func);
+    glMock.ArgFloat(call, (double)ref);
+}
+
+GLboolean APIENTRY mglAreTexturesResident (GLsizei n, const GLuint* textures, GLboolean* residences)
+{
+    glMockCall_t* call = glMock.Record(2);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, textures);
+    glMock.ArgPtr(call, residences);
+    return (GLboolean)0;
+}
+
+void APIENTRY mglArrayElement (GLint i)
+{
+    glMockCall_t* call = glMock.Record(3);
+
+    glMock.ArgInt(call, (int64_t)i);
+}
+
+void APIENTRY mglBegin (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(4);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglBindTexture (GLenum target, GLuint texture)
+{
+    glMockCall_t* call = glMock.Record(5);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.Bind(target, texture);
+}
+
+void APIENTRY mglBitmap (GLsizei width, GLsizei height, GLfloat xorig, GLfloat yorig, GLfloat xmove, GLfloat ymove, const GLubyte* bitmap)
+{
+    glMockCall_t* call = glMock.Record(6);
+
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgFloat(call, (double)xorig);
+    glMock.ArgFloat(call, (double)yorig);
+    glMock.ArgFloat(call, (double)xmove);
+    glMock.ArgFloat(call, (double)ymove);
+    glMock.ArgPtr(call, bitmap);
+}
+
+void APIENTRY mglBlendFunc (GLenum sfactor, GLenum dfactor)
+{
+    glMockCall_t* call = glMock.Record(7);
+
+    glMock.ArgInt(call, (int64_t)sfactor);
+    glMock.ArgInt(call, (int64_t)dfactor);
+}
+
+void APIENTRY mglCallList (GLuint list)
+{
+    glMockCall_t* call = glMock.Record(8);
+
+    glMock.ArgInt(call, (int64_t)list);
+}
+
+void APIENTRY mglCallLists (GLsizei n, GLenum type, const GLvoid* lists)
+{
+    glMockCall_t* call = glMock.Record(9);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, lists);
+}
+
+void APIENTRY mglClear (GLbitfield mask)
+{
+    glMockCall_t* call = glMock.Record(10);
+
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglClearAccum (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    glMockCall_t* call = glMock.Record(11);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+    glMock.ArgFloat(call, (double)alpha);
+}
+
+void APIENTRY mglClearColor (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    glMockCall_t* call = glMock.Record(12);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+    glMock.ArgFloat(call, (double)alpha);
+}
+
+void APIENTRY mglClearDepth (GLclampd depth)
+{
+    glMockCall_t* call = glMock.Record(13);
+
+    glMock.ArgFloat(call, (double)depth);
+}
+
+void APIENTRY mglClearIndex (GLfloat c)
+{
+    glMockCall_t* call = glMock.Record(14);
+
+    glMock.ArgFloat(call, (double)c);
+}
+
+void APIENTRY mglClearStencil (GLint s)
+{
+    glMockCall_t* call = glMock.Record(15);
+
+    glMock.ArgInt(call, (int64_t)s);
+}
+
+void APIENTRY mglClipPlane (GLenum plane, const GLdouble* equation)
+{
+    glMockCall_t* call = glMock.Record(16);
+
+    glMock.ArgInt(call, (int64_t)plane);
+    glMock.ArgPtr(call, equation);
+}
+
+void APIENTRY mglColor3b (GLbyte red, GLbyte green, GLbyte blue)
+{
+    glMockCall_t* call = glMock.Record(17);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3bv (const GLbyte* v)
+{
+    glMockCall_t* call = glMock.Record(18);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3d (GLdouble red, GLdouble green, GLdouble blue)
+{
+    glMockCall_t* call = glMock.Record(19);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+}
+
+void APIENTRY mglColor3dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(20);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3f (GLfloat red, GLfloat green, GLfloat blue)
+{
+    glMockCall_t* call = glMock.Record(21);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+}
+
+void APIENTRY mglColor3fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(22);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3i (GLint red, GLint green, GLint blue)
+{
+    glMockCall_t* call = glMock.Record(23);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(24);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3s (GLshort red, GLshort green, GLshort blue)
+{
+    glMockCall_t* call = glMock.Record(25);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(26);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3ub (GLubyte red, GLubyte green, GLubyte blue)
+{
+    glMockCall_t* call = glMock.Record(27);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3ubv (const GLubyte* v)
+{
+    glMockCall_t* call = glMock.Record(28);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3ui (GLuint red, GLuint green, GLuint blue)
+{
+    glMockCall_t* call = glMock.Record(29);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3uiv (const GLuint* v)
+{
+    glMockCall_t* call = glMock.Record(30);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor3us (GLushort red, GLushort green, GLushort blue)
+{
+    glMockCall_t* call = glMock.Record(31);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+}
+
+void APIENTRY mglColor3usv (const GLushort* v)
+{
+    glMockCall_t* call = glMock.Record(32);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4b (GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha)
+{
+    glMockCall_t* call = glMock.Record(33);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4bv (const GLbyte* v)
+{
+    glMockCall_t* call = glMock.Record(34);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4d (GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha)
+{
+    glMockCall_t* call = glMock.Record(35);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+    glMock.ArgFloat(call, (double)alpha);
+}
+
+void APIENTRY mglColor4dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(36);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4f (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    glMockCall_t* call = glMock.Record(37);
+
+    glMock.ArgFloat(call, (double)red);
+    glMock.ArgFloat(call, (double)green);
+    glMock.ArgFloat(call, (double)blue);
+    glMock.ArgFloat(call, (double)alpha);
+}
+
+void APIENTRY mglColor4fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(38);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4i (GLint red, GLint green, GLint blue, GLint alpha)
+{
+    glMockCall_t* call = glMock.Record(39);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(40);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4s (GLshort red, GLshort green, GLshort blue, GLshort alpha)
+{
+    glMockCall_t* call = glMock.Record(41);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(42);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4ub (GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha)
+{
+    glMockCall_t* call = glMock.Record(43);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4ubv (const GLubyte* v)
+{
+    glMockCall_t* call = glMock.Record(44);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4ui (GLuint red, GLuint green, GLuint blue, GLuint alpha)
+{
+    glMockCall_t* call = glMock.Record(45);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4uiv (const GLuint* v)
+{
+    glMockCall_t* call = glMock.Record(46);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColor4us (GLushort red, GLushort green, GLushort blue, GLushort alpha)
+{
+    glMockCall_t* call = glMock.Record(47);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColor4usv (const GLushort* v)
+{
+    glMockCall_t* call = glMock.Record(48);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    glMockCall_t* call = glMock.Record(49);
+
+    glMock.ArgInt(call, (int64_t)red);
+    glMock.ArgInt(call, (int64_t)green);
+    glMock.ArgInt(call, (int64_t)blue);
+    glMock.ArgInt(call, (int64_t)alpha);
+}
+
+void APIENTRY mglColorMaterial (GLenum face, GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(50);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglColorPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(51);
+
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglCopyPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum type)
+{
+    glMockCall_t* call = glMock.Record(52);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)type);
+}
+
+void APIENTRY mglCopyTexImage1D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLint border)
+{
+    glMockCall_t* call = glMock.Record(53);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalFormat);
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)border);
+}
+
+void APIENTRY mglCopyTexImage2D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
+{
+    glMockCall_t* call = glMock.Record(54);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalFormat);
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)border);
+}
+
+void APIENTRY mglCopyTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width)
+{
+    glMockCall_t* call = glMock.Record(55);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+}
+
+void APIENTRY mglCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    glMockCall_t* call = glMock.Record(56);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)yoffset);
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+}
+
+void APIENTRY mglCullFace (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(57);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglDeleteLists (GLuint list, GLsizei range)
+{
+    glMockCall_t* call = glMock.Record(58);
+
+    glMock.ArgInt(call, (int64_t)list);
+    glMock.ArgInt(call, (int64_t)range);
+}
+
+void APIENTRY mglDeleteTextures (GLsizei n, const GLuint* textures)
+{
+    glMockCall_t* call = glMock.Record(59);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, textures);
+    glMock.DeleteNames(n, textures);
+}
+
+void APIENTRY mglDepthFunc (GLenum func)
+{
+    glMockCall_t* call = glMock.Record(60);
+
+    glMock.ArgInt(call, (int64_t)func);
+}
+
+void APIENTRY mglDepthMask (GLboolean flag)
+{
+    glMockCall_t* call = glMock.Record(61);
+
+    glMock.ArgInt(call, (int64_t)flag);
+}
+
+void APIENTRY mglDepthRange (GLclampd zNear, GLclampd zFar)
+{
+    glMockCall_t* call = glMock.Record(62);
+
+    glMock.ArgFloat(call, (double)zNear);
+    glMock.ArgFloat(call, (double)zFar);
+}
+
+void APIENTRY mglDisable (GLenum cap)
+{
+    glMockCall_t* call = glMock.Record(63);
+
+    glMock.ArgInt(call, (int64_t)cap);
+    glMock.SetCap(cap, false);
+}
+
+void APIENTRY mglDisableClientState (GLenum array)
+{
+    glMockCall_t* call = glMock.Record(64);
+
+    glMock.ArgInt(call, (int64_t)array);
+}
+
+void APIENTRY mglDrawArrays (GLenum mode, GLint first, GLsizei count)
+{
+    glMockCall_t* call = glMock.Record(65);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgInt(call, (int64_t)first);
+    glMock.ArgInt(call, (int64_t)count);
+}
+
+void APIENTRY mglDrawBuffer (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(66);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglDrawElements (GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+    glMockCall_t* call = glMock.Record(67);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, indices);
+}
+
+void APIENTRY mglDrawPixels (GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(68);
+
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglEdgeFlag (GLboolean flag)
+{
+    glMockCall_t* call = glMock.Record(69);
+
+    glMock.ArgInt(call, (int64_t)flag);
+}
+
+void APIENTRY mglEdgeFlagPointer (GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(70);
+
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglEdgeFlagv (const GLboolean* flag)
+{
+    glMockCall_t* call = glMock.Record(71);
+
+    glMock.ArgPtr(call, flag);
+}
+
+void APIENTRY mglEnable (GLenum cap)
+{
+    glMockCall_t* call = glMock.Record(72);
+
+    glMock.ArgInt(call, (int64_t)cap);
+    glMock.SetCap(cap, true);
+}
+
+void APIENTRY mglEnableClientState (GLenum array)
+{
+    glMockCall_t* call = glMock.Record(73);
+
+    glMock.ArgInt(call, (int64_t)array);
+}
+
+void APIENTRY mglEnd (void)
+{
+    glMockCall_t* call = glMock.Record(74);
+}
+
+void APIENTRY mglEndList (void)
+{
+    glMockCall_t* call = glMock.Record(75);
+}
+
+void APIENTRY mglEvalCoord1d (GLdouble u)
+{
+    glMockCall_t* call = glMock.Record(76);
+
+    glMock.ArgFloat(call, (double)u);
+}
+
+void APIENTRY mglEvalCoord1dv (const GLdouble* u)
+{
+    glMockCall_t* call = glMock.Record(77);
+
+    glMock.ArgPtr(call, u);
+}
+
+void APIENTRY mglEvalCoord1f (GLfloat u)
+{
+    glMockCall_t* call = glMock.Record(78);
+
+    glMock.ArgFloat(call, (double)u);
+}
+
+void APIENTRY mglEvalCoord1fv (const GLfloat* u)
+{
+    glMockCall_t* call = glMock.Record(79);
+
+    glMock.ArgPtr(call, u);
+}
+
+void APIENTRY mglEvalCoord2d (GLdouble u, GLdouble v)
+{
+    glMockCall_t* call = glMock.Record(80);
+
+    glMock.ArgFloat(call, (double)u);
+    glMock.ArgFloat(call, (double)v);
+}
+
+void APIENTRY mglEvalCoord2dv (const GLdouble* u)
+{
+    glMockCall_t* call = glMock.Record(81);
+
+    glMock.ArgPtr(call, u);
+}
+
+void APIENTRY mglEvalCoord2f (GLfloat u, GLfloat v)
+{
+    glMockCall_t* call = glMock.Record(82);
+
+    glMock.ArgFloat(call, (double)u);
+    glMock.ArgFloat(call, (double)v);
+}
+
+void APIENTRY mglEvalCoord2fv (const GLfloat* u)
+{
+    glMockCall_t* call = glMock.Record(83);
+
+    glMock.ArgPtr(call, u);
+}
+
+void APIENTRY mglEvalMesh1 (GLenum mode, GLint i1, GLint i2)
+{
+    glMockCall_t* call = glMock.Record(84);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgInt(call, (int64_t)i1);
+    glMock.ArgInt(call, (int64_t)i2);
+}
+
+void APIENTRY mglEvalMesh2 (GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2)
+{
+    glMockCall_t* call = glMock.Record(85);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgInt(call, (int64_t)i1);
+    glMock.ArgInt(call, (int64_t)i2);
+    glMock.ArgInt(call, (int64_t)j1);
+    glMock.ArgInt(call, (int64_t)j2);
+}
+
+void APIENTRY mglEvalPoint1 (GLint i)
+{
+    glMockCall_t* call = glMock.Record(86);
+
+    glMock.ArgInt(call, (int64_t)i);
+}
+
+void APIENTRY mglEvalPoint2 (GLint i, GLint j)
+{
+    glMockCall_t* call = glMock.Record(87);
+
+    glMock.ArgInt(call, (int64_t)i);
+    glMock.ArgInt(call, (int64_t)j);
+}
+
+void APIENTRY mglFeedbackBuffer (GLsizei size, GLenum type, GLfloat* buffer)
+{
+    glMockCall_t* call = glMock.Record(88);
+
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, buffer);
+}
+
+void APIENTRY mglFinish (void)
+{
+    glMockCall_t* call = glMock.Record(89);
+}
+
+void APIENTRY mglFlush (void)
+{
+    glMockCall_t* call = glMock.Record(90);
+}
+
+void APIENTRY mglFogf (GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(91);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglFogfv (GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(92);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglFogi (GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(93);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglFogiv (GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(94);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglFrontFace (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(95);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglFrustum (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar)
+{
+    glMockCall_t* call = glMock.Record(96);
+
+    glMock.ArgFloat(call, (double)left);
+    glMock.ArgFloat(call, (double)right);
+    glMock.ArgFloat(call, (double)bottom);
+    glMock.ArgFloat(call, (double)top);
+    glMock.ArgFloat(call, (double)zNear);
+    glMock.ArgFloat(call, (double)zFar);
+}
+
+GLuint APIENTRY mglGenLists (GLsizei range)
+{
+    glMockCall_t* call = glMock.Record(97);
+
+    glMock.ArgInt(call, (int64_t)range);
+    return glMock.NewName(range);
+}
+
+void APIENTRY mglGenTextures (GLsizei n, GLuint* textures)
+{
+    glMockCall_t* call = glMock.Record(98);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, textures);
+    glMock.GenNames(n, textures);
+}
+
+void APIENTRY mglGetBooleanv (GLenum pname, GLboolean* params)
+{
+    glMockCall_t* call = glMock.Record(99);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetClipPlane (GLenum plane, GLdouble* equation)
+{
+    glMockCall_t* call = glMock.Record(100);
+
+    glMock.ArgInt(call, (int64_t)plane);
+    glMock.ArgPtr(call, equation);
+}
+
+void APIENTRY mglGetDoublev (GLenum pname, GLdouble* params)
+{
+    glMockCall_t* call = glMock.Record(101);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+GLenum APIENTRY mglGetError (void)
+{
+    glMockCall_t* call = glMock.Record(102);
+    return (GLenum)0;
+}
+
+void APIENTRY mglGetFloatv (GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(103);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+    glMock.GetFloatv(pname, params);
+}
+
+void APIENTRY mglGetIntegerv (GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(104);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+    glMock.GetIntegerv(pname, params);
+}
+
+void APIENTRY mglGetLightfv (GLenum light, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(105);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetLightiv (GLenum light, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(106);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetMapdv (GLenum target, GLenum query, GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(107);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)query);
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglGetMapfv (GLenum target, GLenum query, GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(108);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)query);
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglGetMapiv (GLenum target, GLenum query, GLint* v)
+{
+    glMockCall_t* call = glMock.Record(109);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)query);
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglGetMaterialfv (GLenum face, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(110);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetMaterialiv (GLenum face, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(111);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetPixelMapfv (GLenum map, GLfloat* values)
+{
+    glMockCall_t* call = glMock.Record(112);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglGetPixelMapuiv (GLenum map, GLuint* values)
+{
+    glMockCall_t* call = glMock.Record(113);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglGetPixelMapusv (GLenum map, GLushort* values)
+{
+    glMockCall_t* call = glMock.Record(114);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglGetPointerv (GLenum pname, void* params)
+{
+    glMockCall_t* call = glMock.Record(115);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetPolygonStipple (GLubyte* mask)
+{
+    glMockCall_t* call = glMock.Record(116);
+
+    glMock.ArgPtr(call, mask);
+}
+
+void APIENTRY mglGetTexEnvfv (GLenum target, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(117);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexEnviv (GLenum target, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(118);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexGendv (GLenum coord, GLenum pname, GLdouble* params)
+{
+    glMockCall_t* call = glMock.Record(119);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexGenfv (GLenum coord, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(120);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexGeniv (GLenum coord, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(121);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexImage (GLenum target, GLint level, GLenum format, GLenum type, GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(122);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglGetTexLevelParameterfv (GLenum target, GLint level, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(123);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexLevelParameteriv (GLenum target, GLint level, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(124);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexParameterfv (GLenum target, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(125);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglGetTexParameteriv (GLenum target, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(126);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglHint (GLenum target, GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(127);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglIndexMask (GLuint mask)
+{
+    glMockCall_t* call = glMock.Record(128);
+
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglIndexPointer (GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(129);
+
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglIndexd (GLdouble c)
+{
+    glMockCall_t* call = glMock.Record(130);
+
+    glMock.ArgFloat(call, (double)c);
+}
+
+void APIENTRY mglIndexdv (const GLdouble* c)
+{
+    glMockCall_t* call = glMock.Record(131);
+
+    glMock.ArgPtr(call, c);
+}
+
+void APIENTRY mglIndexf (GLfloat c)
+{
+    glMockCall_t* call = glMock.Record(132);
+
+    glMock.ArgFloat(call, (double)c);
+}
+
+void APIENTRY mglIndexfv (const GLfloat* c)
+{
+    glMockCall_t* call = glMock.Record(133);
+
+    glMock.ArgPtr(call, c);
+}
+
+void APIENTRY mglIndexi (GLint c)
+{
+    glMockCall_t* call = glMock.Record(134);
+
+    glMock.ArgInt(call, (int64_t)c);
+}
+
+void APIENTRY mglIndexiv (const GLint* c)
+{
+    glMockCall_t* call = glMock.Record(135);
+
+    glMock.ArgPtr(call, c);
+}
+
+void APIENTRY mglIndexs (GLshort c)
+{
+    glMockCall_t* call = glMock.Record(136);
+
+    glMock.ArgInt(call, (int64_t)c);
+}
+
+void APIENTRY mglIndexsv (const GLshort* c)
+{
+    glMockCall_t* call = glMock.Record(137);
+
+    glMock.ArgPtr(call, c);
+}
+
+void APIENTRY mglIndexub (GLubyte c)
+{
+    glMockCall_t* call = glMock.Record(138);
+
+    glMock.ArgInt(call, (int64_t)c);
+}
+
+void APIENTRY mglIndexubv (const GLubyte* c)
+{
+    glMockCall_t* call = glMock.Record(139);
+
+    glMock.ArgPtr(call, c);
+}
+
+void APIENTRY mglInitNames (void)
+{
+    glMockCall_t* call = glMock.Record(140);
+}
+
+void APIENTRY mglInterleavedArrays (GLenum format, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(141);
+
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+GLboolean APIENTRY mglIsEnabled (GLenum cap)
+{
+    glMockCall_t* call = glMock.Record(142);
+
+    glMock.ArgInt(call, (int64_t)cap);
+    return glMock.IsEnabled(cap);
+}
+
+GLboolean APIENTRY mglIsList (GLuint list)
+{
+    glMockCall_t* call = glMock.Record(143);
+
+    glMock.ArgInt(call, (int64_t)list);
+    return (GLboolean)0;
+}
+
+GLboolean APIENTRY mglIsTexture (GLuint texture)
+{
+    glMockCall_t* call = glMock.Record(144);
+
+    glMock.ArgInt(call, (int64_t)texture);
+    return (GLboolean)0;
+}
+
+void APIENTRY mglLightModelf (GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(145);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglLightModelfv (GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(146);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglLightModeli (GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(147);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglLightModeliv (GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(148);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglLightf (GLenum light, GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(149);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglLightfv (GLenum light, GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(150);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglLighti (GLenum light, GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(151);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglLightiv (GLenum light, GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(152);
+
+    glMock.ArgInt(call, (int64_t)light);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglLineStipple (GLint factor, GLushort pattern)
+{
+    glMockCall_t* call = glMock.Record(153);
+
+    glMock.ArgInt(call, (int64_t)factor);
+    glMock.ArgInt(call, (int64_t)pattern);
+}
+
+void APIENTRY mglLineWidth (GLfloat width)
+{
+    glMockCall_t* call = glMock.Record(154);
+
+    glMock.ArgFloat(call, (double)width);
+}
+
+void APIENTRY mglListBase (GLuint base)
+{
+    glMockCall_t* call = glMock.Record(155);
+
+    glMock.ArgInt(call, (int64_t)base);
+}
+
+void APIENTRY mglLoadIdentity (void)
+{
+    glMockCall_t* call = glMock.Record(156);
+}
+
+void APIENTRY mglLoadMatrixd (const GLdouble* m)
+{
+    glMockCall_t* call = glMock.Record(157);
+
+    glMock.ArgPtr(call, m);
+}
+
+void APIENTRY mglLoadMatrixf (const GLfloat* m)
+{
+    glMockCall_t* call = glMock.Record(158);
+
+    glMock.ArgPtr(call, m);
+}
+
+void APIENTRY mglLoadName (GLuint name)
+{
+    glMockCall_t* call = glMock.Record(159);
+
+    glMock.ArgInt(call, (int64_t)name);
+}
+
+void APIENTRY mglLogicOp (GLenum opcode)
+{
+    glMockCall_t* call = glMock.Record(160);
+
+    glMock.ArgInt(call, (int64_t)opcode);
+}
+
+void APIENTRY mglMap1d (GLenum target, GLdouble u1, GLdouble u2, GLint stride, GLint order, const GLdouble* points)
+{
+    glMockCall_t* call = glMock.Record(161);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgInt(call, (int64_t)order);
+    glMock.ArgPtr(call, points);
+}
+
+void APIENTRY mglMap1f (GLenum target, GLfloat u1, GLfloat u2, GLint stride, GLint order, const GLfloat* points)
+{
+    glMockCall_t* call = glMock.Record(162);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgInt(call, (int64_t)order);
+    glMock.ArgPtr(call, points);
+}
+
+void APIENTRY mglMap2d (GLenum target, GLdouble u1, GLdouble u2, GLint ustride, GLint uorder, GLdouble v1, GLdouble v2, GLint vstride, GLint vorder, const GLdouble* points)
+{
+    glMockCall_t* call = glMock.Record(163);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)ustride);
+    glMock.ArgInt(call, (int64_t)uorder);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+    glMock.ArgInt(call, (int64_t)vstride);
+    glMock.ArgInt(call, (int64_t)vorder);
+    glMock.ArgPtr(call, points);
+}
+
+void APIENTRY mglMap2f (GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat* points)
+{
+    glMockCall_t* call = glMock.Record(164);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)ustride);
+    glMock.ArgInt(call, (int64_t)uorder);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+    glMock.ArgInt(call, (int64_t)vstride);
+    glMock.ArgInt(call, (int64_t)vorder);
+    glMock.ArgPtr(call, points);
+}
+
+void APIENTRY mglMapGrid1d (GLint un, GLdouble u1, GLdouble u2)
+{
+    glMockCall_t* call = glMock.Record(165);
+
+    glMock.ArgInt(call, (int64_t)un);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+}
+
+void APIENTRY mglMapGrid1f (GLint un, GLfloat u1, GLfloat u2)
+{
+    glMockCall_t* call = glMock.Record(166);
+
+    glMock.ArgInt(call, (int64_t)un);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+}
+
+void APIENTRY mglMapGrid2d (GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2)
+{
+    glMockCall_t* call = glMock.Record(167);
+
+    glMock.ArgInt(call, (int64_t)un);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)vn);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+}
+
+void APIENTRY mglMapGrid2f (GLint un, GLfloat u1, GLfloat u2, GLint vn, GLfloat v1, GLfloat v2)
+{
+    glMockCall_t* call = glMock.Record(168);
+
+    glMock.ArgInt(call, (int64_t)un);
+    glMock.ArgFloat(call, (double)u1);
+    glMock.ArgFloat(call, (double)u2);
+    glMock.ArgInt(call, (int64_t)vn);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+}
+
+void APIENTRY mglMaterialf (GLenum face, GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(169);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglMaterialfv (GLenum face, GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(170);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglMateriali (GLenum face, GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(171);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglMaterialiv (GLenum face, GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(172);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglMatrixMode (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(173);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglMultMatrixd (const GLdouble* m)
+{
+    glMockCall_t* call = glMock.Record(174);
+
+    glMock.ArgPtr(call, m);
+}
+
+void APIENTRY mglMultMatrixf (const GLfloat* m)
+{
+    glMockCall_t* call = glMock.Record(175);
+
+    glMock.ArgPtr(call, m);
+}
+
+void APIENTRY mglNewList (GLuint list, GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(176);
+
+    glMock.ArgInt(call, (int64_t)list);
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglNormal3b (GLbyte nx, GLbyte ny, GLbyte nz)
+{
+    glMockCall_t* call = glMock.Record(177);
+
+    glMock.ArgInt(call, (int64_t)nx);
+    glMock.ArgInt(call, (int64_t)ny);
+    glMock.ArgInt(call, (int64_t)nz);
+}
+
+void APIENTRY mglNormal3bv (const GLbyte* v)
+{
+    glMockCall_t* call = glMock.Record(178);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglNormal3d (GLdouble nx, GLdouble ny, GLdouble nz)
+{
+    glMockCall_t* call = glMock.Record(179);
+
+    glMock.ArgFloat(call, (double)nx);
+    glMock.ArgFloat(call, (double)ny);
+    glMock.ArgFloat(call, (double)nz);
+}
+
+void APIENTRY mglNormal3dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(180);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglNormal3f (GLfloat nx, GLfloat ny, GLfloat nz)
+{
+    glMockCall_t* call = glMock.Record(181);
+
+    glMock.ArgFloat(call, (double)nx);
+    glMock.ArgFloat(call, (double)ny);
+    glMock.ArgFloat(call, (double)nz);
+}
+
+void APIENTRY mglNormal3fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(182);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglNormal3i (GLint nx, GLint ny, GLint nz)
+{
+    glMockCall_t* call = glMock.Record(183);
+
+    glMock.ArgInt(call, (int64_t)nx);
+    glMock.ArgInt(call, (int64_t)ny);
+    glMock.ArgInt(call, (int64_t)nz);
+}
+
+void APIENTRY mglNormal3iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(184);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglNormal3s (GLshort nx, GLshort ny, GLshort nz)
+{
+    glMockCall_t* call = glMock.Record(185);
+
+    glMock.ArgInt(call, (int64_t)nx);
+    glMock.ArgInt(call, (int64_t)ny);
+    glMock.ArgInt(call, (int64_t)nz);
+}
+
+void APIENTRY mglNormal3sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(186);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglNormalPointer (GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(187);
+
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglOrtho (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar)
+{
+    glMockCall_t* call = glMock.Record(188);
+
+    glMock.ArgFloat(call, (double)left);
+    glMock.ArgFloat(call, (double)right);
+    glMock.ArgFloat(call, (double)bottom);
+    glMock.ArgFloat(call, (double)top);
+    glMock.ArgFloat(call, (double)zNear);
+    glMock.ArgFloat(call, (double)zFar);
+}
+
+void APIENTRY mglPassThrough (GLfloat token)
+{
+    glMockCall_t* call = glMock.Record(189);
+
+    glMock.ArgFloat(call, (double)token);
+}
+
+void APIENTRY mglPixelMapfv (GLenum map, GLsizei mapsize, const GLfloat* values)
+{
+    glMockCall_t* call = glMock.Record(190);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgInt(call, (int64_t)mapsize);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglPixelMapuiv (GLenum map, GLsizei mapsize, const GLuint* values)
+{
+    glMockCall_t* call = glMock.Record(191);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgInt(call, (int64_t)mapsize);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglPixelMapusv (GLenum map, GLsizei mapsize, const GLushort* values)
+{
+    glMockCall_t* call = glMock.Record(192);
+
+    glMock.ArgInt(call, (int64_t)map);
+    glMock.ArgInt(call, (int64_t)mapsize);
+    glMock.ArgPtr(call, values);
+}
+
+void APIENTRY mglPixelStoref (GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(193);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglPixelStorei (GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(194);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglPixelTransferf (GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(195);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglPixelTransferi (GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(196);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglPixelZoom (GLfloat xfactor, GLfloat yfactor)
+{
+    glMockCall_t* call = glMock.Record(197);
+
+    glMock.ArgFloat(call, (double)xfactor);
+    glMock.ArgFloat(call, (double)yfactor);
+}
+
+void APIENTRY mglPointSize (GLfloat size)
+{
+    glMockCall_t* call = glMock.Record(198);
+
+    glMock.ArgFloat(call, (double)size);
+}
+
+void APIENTRY mglPolygonMode (GLenum face, GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(199);
+
+    glMock.ArgInt(call, (int64_t)face);
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglPolygonOffset (GLfloat factor, GLfloat units)
+{
+    glMockCall_t* call = glMock.Record(200);
+
+    glMock.ArgFloat(call, (double)factor);
+    glMock.ArgFloat(call, (double)units);
+}
+
+void APIENTRY mglPolygonStipple (const GLubyte* mask)
+{
+    glMockCall_t* call = glMock.Record(201);
+
+    glMock.ArgPtr(call, mask);
+}
+
+void APIENTRY mglPopAttrib (void)
+{
+    glMockCall_t* call = glMock.Record(202);
+}
+
+void APIENTRY mglPopClientAttrib (void)
+{
+    glMockCall_t* call = glMock.Record(203);
+}
+
+void APIENTRY mglPopMatrix (void)
+{
+    glMockCall_t* call = glMock.Record(204);
+}
+
+void APIENTRY mglPopName (void)
+{
+    glMockCall_t* call = glMock.Record(205);
+}
+
+void APIENTRY mglPrioritizeTextures (GLsizei n, const GLuint* textures, const GLclampf* priorities)
+{
+    glMockCall_t* call = glMock.Record(206);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, textures);
+    glMock.ArgPtr(call, priorities);
+}
+
+void APIENTRY mglPushAttrib (GLbitfield mask)
+{
+    glMockCall_t* call = glMock.Record(207);
+
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglPushClientAttrib (GLbitfield mask)
+{
+    glMockCall_t* call = glMock.Record(208);
+
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglPushMatrix (void)
+{
+    glMockCall_t* call = glMock.Record(209);
+}
+
+void APIENTRY mglPushName (GLuint name)
+{
+    glMockCall_t* call = glMock.Record(210);
+
+    glMock.ArgInt(call, (int64_t)name);
+}
+
+void APIENTRY mglRasterPos2d (GLdouble x, GLdouble y)
+{
+    glMockCall_t* call = glMock.Record(211);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+}
+
+void APIENTRY mglRasterPos2dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(212);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos2f (GLfloat x, GLfloat y)
+{
+    glMockCall_t* call = glMock.Record(213);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+}
+
+void APIENTRY mglRasterPos2fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(214);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos2i (GLint x, GLint y)
+{
+    glMockCall_t* call = glMock.Record(215);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+}
+
+void APIENTRY mglRasterPos2iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(216);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos2s (GLshort x, GLshort y)
+{
+    glMockCall_t* call = glMock.Record(217);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+}
+
+void APIENTRY mglRasterPos2sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(218);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos3d (GLdouble x, GLdouble y, GLdouble z)
+{
+    glMockCall_t* call = glMock.Record(219);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglRasterPos3dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(220);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos3f (GLfloat x, GLfloat y, GLfloat z)
+{
+    glMockCall_t* call = glMock.Record(221);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglRasterPos3fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(222);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos3i (GLint x, GLint y, GLint z)
+{
+    glMockCall_t* call = glMock.Record(223);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+}
+
+void APIENTRY mglRasterPos3iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(224);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos3s (GLshort x, GLshort y, GLshort z)
+{
+    glMockCall_t* call = glMock.Record(225);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+}
+
+void APIENTRY mglRasterPos3sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(226);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w)
+{
+    glMockCall_t* call = glMock.Record(227);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+    glMock.ArgFloat(call, (double)w);
+}
+
+void APIENTRY mglRasterPos4dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(228);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+    glMockCall_t* call = glMock.Record(229);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+    glMock.ArgFloat(call, (double)w);
+}
+
+void APIENTRY mglRasterPos4fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(230);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos4i (GLint x, GLint y, GLint z, GLint w)
+{
+    glMockCall_t* call = glMock.Record(231);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+    glMock.ArgInt(call, (int64_t)w);
+}
+
+void APIENTRY mglRasterPos4iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(232);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglRasterPos4s (GLshort x, GLshort y, GLshort z, GLshort w)
+{
+    glMockCall_t* call = glMock.Record(233);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+    glMock.ArgInt(call, (int64_t)w);
+}
+
+void APIENTRY mglRasterPos4sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(234);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglReadBuffer (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(235);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(236);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglRectd (GLdouble x1, GLdouble y1, GLdouble x2, GLdouble y2)
+{
+    glMockCall_t* call = glMock.Record(237);
+
+    glMock.ArgFloat(call, (double)x1);
+    glMock.ArgFloat(call, (double)y1);
+    glMock.ArgFloat(call, (double)x2);
+    glMock.ArgFloat(call, (double)y2);
+}
+
+void APIENTRY mglRectdv (const GLdouble* v1, const GLdouble* v2)
+{
+    glMockCall_t* call = glMock.Record(238);
+
+    glMock.ArgPtr(call, v1);
+    glMock.ArgPtr(call, v2);
+}
+
+void APIENTRY mglRectf (GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2)
+{
+    glMockCall_t* call = glMock.Record(239);
+
+    glMock.ArgFloat(call, (double)x1);
+    glMock.ArgFloat(call, (double)y1);
+    glMock.ArgFloat(call, (double)x2);
+    glMock.ArgFloat(call, (double)y2);
+}
+
+void APIENTRY mglRectfv (const GLfloat* v1, const GLfloat* v2)
+{
+    glMockCall_t* call = glMock.Record(240);
+
+    glMock.ArgPtr(call, v1);
+    glMock.ArgPtr(call, v2);
+}
+
+void APIENTRY mglRecti (GLint x1, GLint y1, GLint x2, GLint y2)
+{
+    glMockCall_t* call = glMock.Record(241);
+
+    glMock.ArgInt(call, (int64_t)x1);
+    glMock.ArgInt(call, (int64_t)y1);
+    glMock.ArgInt(call, (int64_t)x2);
+    glMock.ArgInt(call, (int64_t)y2);
+}
+
+void APIENTRY mglRectiv (const GLint* v1, const GLint* v2)
+{
+    glMockCall_t* call = glMock.Record(242);
+
+    glMock.ArgPtr(call, v1);
+    glMock.ArgPtr(call, v2);
+}
+
+void APIENTRY mglRects (GLshort x1, GLshort y1, GLshort x2, GLshort y2)
+{
+    glMockCall_t* call = glMock.Record(243);
+
+    glMock.ArgInt(call, (int64_t)x1);
+    glMock.ArgInt(call, (int64_t)y1);
+    glMock.ArgInt(call, (int64_t)x2);
+    glMock.ArgInt(call, (int64_t)y2);
+}
+
+void APIENTRY mglRectsv (const GLshort* v1, const GLshort* v2)
+{
+    glMockCall_t* call = glMock.Record(244);
+
+    glMock.ArgPtr(call, v1);
+    glMock.ArgPtr(call, v2);
+}
+
+GLint APIENTRY mglRenderMode (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(245);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    return (GLint)0;
+}
+
+void APIENTRY mglRotated (GLdouble angle, GLdouble x, GLdouble y, GLdouble z)
+{
+    glMockCall_t* call = glMock.Record(246);
+
+    glMock.ArgFloat(call, (double)angle);
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglRotatef (GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+{
+    glMockCall_t* call = glMock.Record(247);
+
+    glMock.ArgFloat(call, (double)angle);
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglScaled (GLdouble x, GLdouble y, GLdouble z)
+{
+    glMockCall_t* call = glMock.Record(248);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglScalef (GLfloat x, GLfloat y, GLfloat z)
+{
+    glMockCall_t* call = glMock.Record(249);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglScissor (GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    glMockCall_t* call = glMock.Record(250);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+}
+
+void APIENTRY mglSelectBuffer (GLsizei size, GLuint* buffer)
+{
+    glMockCall_t* call = glMock.Record(251);
+
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgPtr(call, buffer);
+}
+
+void APIENTRY mglShadeModel (GLenum mode)
+{
+    glMockCall_t* call = glMock.Record(252);
+
+    glMock.ArgInt(call, (int64_t)mode);
+}
+
+void APIENTRY mglStencilFunc (GLenum func, GLint ref, GLuint mask)
+{
+    glMockCall_t* call = glMock.Record(253);
+
+    glMock.ArgInt(call, (int64_t)func);
+    glMock.ArgInt(call, (int64_t)ref);
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglStencilMask (GLuint mask)
+{
+    glMockCall_t* call = glMock.Record(254);
+
+    glMock.ArgInt(call, (int64_t)mask);
+}
+
+void APIENTRY mglStencilOp (GLenum fail, GLenum zfail, GLenum zpass)
+{
+    glMockCall_t* call = glMock.Record(255);
+
+    glMock.ArgInt(call, (int64_t)fail);
+    glMock.ArgInt(call, (int64_t)zfail);
+    glMock.ArgInt(call, (int64_t)zpass);
+}
+
+void APIENTRY mglTexCoord1d (GLdouble s)
+{
+    glMockCall_t* call = glMock.Record(256);
+
+    glMock.ArgFloat(call, (double)s);
+}
+
+void APIENTRY mglTexCoord1dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(257);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord1f (GLfloat s)
+{
+    glMockCall_t* call = glMock.Record(258);
+
+    glMock.ArgFloat(call, (double)s);
+}
+
+void APIENTRY mglTexCoord1fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(259);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord1i (GLint s)
+{
+    glMockCall_t* call = glMock.Record(260);
+
+    glMock.ArgInt(call, (int64_t)s);
+}
+
+void APIENTRY mglTexCoord1iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(261);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord1s (GLshort s)
+{
+    glMockCall_t* call = glMock.Record(262);
+
+    glMock.ArgInt(call, (int64_t)s);
+}
+
+void APIENTRY mglTexCoord1sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(263);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord2d (GLdouble s, GLdouble t)
+{
+    glMockCall_t* call = glMock.Record(264);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+}
+
+void APIENTRY mglTexCoord2dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(265);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord2f (GLfloat s, GLfloat t)
+{
+    glMockCall_t* call = glMock.Record(266);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+}
+
+void APIENTRY mglTexCoord2fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(267);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord2i (GLint s, GLint t)
+{
+    glMockCall_t* call = glMock.Record(268);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+}
+
+void APIENTRY mglTexCoord2iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(269);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord2s (GLshort s, GLshort t)
+{
+    glMockCall_t* call = glMock.Record(270);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+}
+
+void APIENTRY mglTexCoord2sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(271);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord3d (GLdouble s, GLdouble t, GLdouble r)
+{
+    glMockCall_t* call = glMock.Record(272);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+}
+
+void APIENTRY mglTexCoord3dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(273);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord3f (GLfloat s, GLfloat t, GLfloat r)
+{
+    glMockCall_t* call = glMock.Record(274);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+}
+
+void APIENTRY mglTexCoord3fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(275);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord3i (GLint s, GLint t, GLint r)
+{
+    glMockCall_t* call = glMock.Record(276);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+}
+
+void APIENTRY mglTexCoord3iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(277);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord3s (GLshort s, GLshort t, GLshort r)
+{
+    glMockCall_t* call = glMock.Record(278);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+}
+
+void APIENTRY mglTexCoord3sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(279);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord4d (GLdouble s, GLdouble t, GLdouble r, GLdouble q)
+{
+    glMockCall_t* call = glMock.Record(280);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+    glMock.ArgFloat(call, (double)q);
+}
+
+void APIENTRY mglTexCoord4dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(281);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord4f (GLfloat s, GLfloat t, GLfloat r, GLfloat q)
+{
+    glMockCall_t* call = glMock.Record(282);
+
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+    glMock.ArgFloat(call, (double)q);
+}
+
+void APIENTRY mglTexCoord4fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(283);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord4i (GLint s, GLint t, GLint r, GLint q)
+{
+    glMockCall_t* call = glMock.Record(284);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+    glMock.ArgInt(call, (int64_t)q);
+}
+
+void APIENTRY mglTexCoord4iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(285);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoord4s (GLshort s, GLshort t, GLshort r, GLshort q)
+{
+    glMockCall_t* call = glMock.Record(286);
+
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+    glMock.ArgInt(call, (int64_t)q);
+}
+
+void APIENTRY mglTexCoord4sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(287);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglTexCoordPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(288);
+
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglTexEnvf (GLenum target, GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(289);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglTexEnvfv (GLenum target, GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(290);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexEnvi (GLenum target, GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(291);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglTexEnviv (GLenum target, GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(292);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexGend (GLenum coord, GLenum pname, GLdouble param)
+{
+    glMockCall_t* call = glMock.Record(293);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglTexGendv (GLenum coord, GLenum pname, const GLdouble* params)
+{
+    glMockCall_t* call = glMock.Record(294);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexGenf (GLenum coord, GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(295);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglTexGenfv (GLenum coord, GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(296);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexGeni (GLenum coord, GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(297);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglTexGeniv (GLenum coord, GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(298);
+
+    glMock.ArgInt(call, (int64_t)coord);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexImage1D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(299);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)border);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(300);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)border);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglTexParameterf (GLenum target, GLenum pname, GLfloat param)
+{
+    glMockCall_t* call = glMock.Record(301);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgFloat(call, (double)param);
+}
+
+void APIENTRY mglTexParameterfv (GLenum target, GLenum pname, const GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(302);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexParameteri (GLenum target, GLenum pname, GLint param)
+{
+    glMockCall_t* call = glMock.Record(303);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgInt(call, (int64_t)param);
+}
+
+void APIENTRY mglTexParameteriv (GLenum target, GLenum pname, const GLint* params)
+{
+    glMockCall_t* call = glMock.Record(304);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+void APIENTRY mglTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(305);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    glMockCall_t* call = glMock.Record(306);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)yoffset);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, pixels);
+}
+
+void APIENTRY mglTranslated (GLdouble x, GLdouble y, GLdouble z)
+{
+    glMockCall_t* call = glMock.Record(307);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglTranslatef (GLfloat x, GLfloat y, GLfloat z)
+{
+    glMockCall_t* call = glMock.Record(308);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglVertex2d (GLdouble x, GLdouble y)
+{
+    glMockCall_t* call = glMock.Record(309);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+}
+
+void APIENTRY mglVertex2dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(310);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex2f (GLfloat x, GLfloat y)
+{
+    glMockCall_t* call = glMock.Record(311);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+}
+
+void APIENTRY mglVertex2fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(312);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex2i (GLint x, GLint y)
+{
+    glMockCall_t* call = glMock.Record(313);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+}
+
+void APIENTRY mglVertex2iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(314);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex2s (GLshort x, GLshort y)
+{
+    glMockCall_t* call = glMock.Record(315);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+}
+
+void APIENTRY mglVertex2sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(316);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex3d (GLdouble x, GLdouble y, GLdouble z)
+{
+    glMockCall_t* call = glMock.Record(317);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglVertex3dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(318);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex3f (GLfloat x, GLfloat y, GLfloat z)
+{
+    glMockCall_t* call = glMock.Record(319);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+}
+
+void APIENTRY mglVertex3fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(320);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex3i (GLint x, GLint y, GLint z)
+{
+    glMockCall_t* call = glMock.Record(321);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+}
+
+void APIENTRY mglVertex3iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(322);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex3s (GLshort x, GLshort y, GLshort z)
+{
+    glMockCall_t* call = glMock.Record(323);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+}
+
+void APIENTRY mglVertex3sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(324);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w)
+{
+    glMockCall_t* call = glMock.Record(325);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+    glMock.ArgFloat(call, (double)w);
+}
+
+void APIENTRY mglVertex4dv (const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(326);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+    glMockCall_t* call = glMock.Record(327);
+
+    glMock.ArgFloat(call, (double)x);
+    glMock.ArgFloat(call, (double)y);
+    glMock.ArgFloat(call, (double)z);
+    glMock.ArgFloat(call, (double)w);
+}
+
+void APIENTRY mglVertex4fv (const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(328);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex4i (GLint x, GLint y, GLint z, GLint w)
+{
+    glMockCall_t* call = glMock.Record(329);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+    glMock.ArgInt(call, (int64_t)w);
+}
+
+void APIENTRY mglVertex4iv (const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(330);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertex4s (GLshort x, GLshort y, GLshort z, GLshort w)
+{
+    glMockCall_t* call = glMock.Record(331);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)z);
+    glMock.ArgInt(call, (int64_t)w);
+}
+
+void APIENTRY mglVertex4sv (const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(332);
+
+    glMock.ArgPtr(call, v);
+}
+
+void APIENTRY mglVertexPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(333);
+
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+void APIENTRY mglViewport (GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    glMockCall_t* call = glMock.Record(334);
+
+    glMock.ArgInt(call, (int64_t)x);
+    glMock.ArgInt(call, (int64_t)y);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.Viewport(x, y, width, height);
+}
+
+static void APIENTRY mglActiveTextureARB (GLenum texture)
+{
+    glMockCall_t* call = glMock.Record(335);
+
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.ActiveTexture(texture);
+}
+
+static void APIENTRY mglClientActiveTextureARB (GLenum texture)
+{
+    glMockCall_t* call = glMock.Record(336);
+
+    glMock.ArgInt(call, (int64_t)texture);
+}
+
+static void APIENTRY mglMultiTexCoord1dARB (GLenum target, GLdouble s)
+{
+    glMockCall_t* call = glMock.Record(337);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+}
+
+static void APIENTRY mglMultiTexCoord1dvARB (GLenum target, const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(338);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord1fARB (GLenum target, GLfloat s)
+{
+    glMockCall_t* call = glMock.Record(339);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+}
+
+static void APIENTRY mglMultiTexCoord1fvARB (GLenum target, const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(340);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord1iARB (GLenum target, GLint s)
+{
+    glMockCall_t* call = glMock.Record(341);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+}
+
+static void APIENTRY mglMultiTexCoord1ivARB (GLenum target, const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(342);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord1sARB (GLenum target, GLshort s)
+{
+    glMockCall_t* call = glMock.Record(343);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+}
+
+static void APIENTRY mglMultiTexCoord1svARB (GLenum target, const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(344);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord2dARB (GLenum target, GLdouble s, GLdouble t)
+{
+    glMockCall_t* call = glMock.Record(345);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+}
+
+static void APIENTRY mglMultiTexCoord2dvARB (GLenum target, const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(346);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord2fARB (GLenum target, GLfloat s, GLfloat t)
+{
+    glMockCall_t* call = glMock.Record(347);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+}
+
+static void APIENTRY mglMultiTexCoord2fvARB (GLenum target, const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(348);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord2iARB (GLenum target, GLint s, GLint t)
+{
+    glMockCall_t* call = glMock.Record(349);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+}
+
+static void APIENTRY mglMultiTexCoord2ivARB (GLenum target, const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(350);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord2sARB (GLenum target, GLshort s, GLshort t)
+{
+    glMockCall_t* call = glMock.Record(351);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+}
+
+static void APIENTRY mglMultiTexCoord2svARB (GLenum target, const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(352);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord3dARB (GLenum target, GLdouble s, GLdouble t, GLdouble r)
+{
+    glMockCall_t* call = glMock.Record(353);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+}
+
+static void APIENTRY mglMultiTexCoord3dvARB (GLenum target, const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(354);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord3fARB (GLenum target, GLfloat s, GLfloat t, GLfloat r)
+{
+    glMockCall_t* call = glMock.Record(355);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+}
+
+static void APIENTRY mglMultiTexCoord3fvARB (GLenum target, const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(356);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord3iARB (GLenum target, GLint s, GLint t, GLint r)
+{
+    glMockCall_t* call = glMock.Record(357);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+}
+
+static void APIENTRY mglMultiTexCoord3ivARB (GLenum target, const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(358);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord3sARB (GLenum target, GLshort s, GLshort t, GLshort r)
+{
+    glMockCall_t* call = glMock.Record(359);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+}
+
+static void APIENTRY mglMultiTexCoord3svARB (GLenum target, const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(360);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord4dARB (GLenum target, GLdouble s, GLdouble t, GLdouble r, GLdouble q)
+{
+    glMockCall_t* call = glMock.Record(361);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+    glMock.ArgFloat(call, (double)q);
+}
+
+static void APIENTRY mglMultiTexCoord4dvARB (GLenum target, const GLdouble* v)
+{
+    glMockCall_t* call = glMock.Record(362);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord4fARB (GLenum target, GLfloat s, GLfloat t, GLfloat r, GLfloat q)
+{
+    glMockCall_t* call = glMock.Record(363);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgFloat(call, (double)s);
+    glMock.ArgFloat(call, (double)t);
+    glMock.ArgFloat(call, (double)r);
+    glMock.ArgFloat(call, (double)q);
+}
+
+static void APIENTRY mglMultiTexCoord4fvARB (GLenum target, const GLfloat* v)
+{
+    glMockCall_t* call = glMock.Record(364);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord4iARB (GLenum target, GLint s, GLint t, GLint r, GLint q)
+{
+    glMockCall_t* call = glMock.Record(365);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+    glMock.ArgInt(call, (int64_t)q);
+}
+
+static void APIENTRY mglMultiTexCoord4ivARB (GLenum target, const GLint* v)
+{
+    glMockCall_t* call = glMock.Record(366);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglMultiTexCoord4sARB (GLenum target, GLshort s, GLshort t, GLshort r, GLshort q)
+{
+    glMockCall_t* call = glMock.Record(367);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)s);
+    glMock.ArgInt(call, (int64_t)t);
+    glMock.ArgInt(call, (int64_t)r);
+    glMock.ArgInt(call, (int64_t)q);
+}
+
+static void APIENTRY mglMultiTexCoord4svARB (GLenum target, const GLshort* v)
+{
+    glMockCall_t* call = glMock.Record(368);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgPtr(call, v);
+}
+
+static void APIENTRY mglLockArraysEXT (GLint first, GLsizei count)
+{
+    glMockCall_t* call = glMock.Record(369);
+
+    glMock.ArgInt(call, (int64_t)first);
+    glMock.ArgInt(call, (int64_t)count);
+}
+
+static void APIENTRY mglUnlockArraysEXT (void)
+{
+    glMockCall_t* call = glMock.Record(370);
+}
+
+static void APIENTRY mglMultiDrawArraysEXT (GLenum mode, const GLint* first, const GLsizei* count, GLsizei primcount)
+{
+    glMockCall_t* call = glMock.Record(371);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgPtr(call, first);
+    glMock.ArgPtr(call, count);
+    glMock.ArgInt(call, (int64_t)primcount);
+}
+
+static void APIENTRY mglMultiDrawElementsEXT (GLenum mode, const GLsizei* count, GLenum type, const void* indices, GLsizei primcount)
+{
+    glMockCall_t* call = glMock.Record(372);
+
+    glMock.ArgInt(call, (int64_t)mode);
+    glMock.ArgPtr(call, count);
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgPtr(call, indices);
+    glMock.ArgInt(call, (int64_t)primcount);
+}
+
+static void APIENTRY mglFogCoordfEXT (GLfloat coord)
+{
+    glMockCall_t* call = glMock.Record(373);
+
+    glMock.ArgFloat(call, (double)coord);
+}
+
+static void APIENTRY mglFogCoordfvEXT (const GLfloat* coord)
+{
+    glMockCall_t* call = glMock.Record(374);
+
+    glMock.ArgPtr(call, coord);
+}
+
+static void APIENTRY mglFogCoorddEXT (GLdouble coord)
+{
+    glMockCall_t* call = glMock.Record(375);
+
+    glMock.ArgFloat(call, (double)coord);
+}
+
+static void APIENTRY mglFogCoorddvEXT (const GLdouble* coord)
+{
+    glMockCall_t* call = glMock.Record(376);
+
+    glMock.ArgPtr(call, coord);
+}
+
+static void APIENTRY mglFogCoordPointerEXT (GLenum type, GLsizei stride, const GLvoid* pointer)
+{
+    glMockCall_t* call = glMock.Record(377);
+
+    glMock.ArgInt(call, (int64_t)type);
+    glMock.ArgInt(call, (int64_t)stride);
+    glMock.ArgPtr(call, pointer);
+}
+
+static void APIENTRY mglBindBufferARB (GLenum target, GLuint buffer)
+{
+    glMockCall_t* call = glMock.Record(378);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)buffer);
+    glMock.Bind(target, buffer);
+}
+
+static void APIENTRY mglDeleteBuffersARB (GLsizei n, const GLuint* buffers)
+{
+    glMockCall_t* call = glMock.Record(379);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, buffers);
+    glMock.DeleteNames(n, buffers);
+}
+
+static void APIENTRY mglGenBuffersARB (GLsizei n, GLuint* buffers)
+{
+    glMockCall_t* call = glMock.Record(380);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, buffers);
+    glMock.GenNames(n, buffers);
+}
+
+static GLboolean APIENTRY mglIsBufferARB (GLuint buffer)
+{
+    glMockCall_t* call = glMock.Record(381);
+
+    glMock.ArgInt(call, (int64_t)buffer);
+    return (GLboolean)0;
+}
+
+static void APIENTRY mglBufferDataARB (GLenum target, GLsizeiptrARB size, const GLvoid* data, GLenum usage)
+{
+    glMockCall_t* call = glMock.Record(382);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgPtr(call, data);
+    glMock.ArgInt(call, (int64_t)usage);
+}
+
+static void APIENTRY mglBufferSubDataARB (GLenum target, GLintptrARB offset, GLsizeiptrARB size, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(383);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)offset);
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglGetBufferSubDataARB (GLenum target, GLintptrARB offset, GLsizeiptrARB size, GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(384);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)offset);
+    glMock.ArgInt(call, (int64_t)size);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglMapBufferARB (GLenum target, GLenum access)
+{
+    glMockCall_t* call = glMock.Record(385);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)access);
+}
+
+static GLboolean APIENTRY mglUnmapBufferARB (GLenum target)
+{
+    glMockCall_t* call = glMock.Record(386);
+
+    glMock.ArgInt(call, (int64_t)target);
+    return (GLboolean)0;
+}
+
+static void APIENTRY mglGetBufferParameterivARB (GLenum target, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(387);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGetBufferPointervARB (GLenum target, GLenum pname, void* params)
+{
+    glMockCall_t* call = glMock.Record(388);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglDeleteObjectARB (GLhandleARB obj)
+{
+    glMockCall_t* call = glMock.Record(389);
+
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+}
+
+static GLhandleARB APIENTRY mglGetHandleARB (GLenum pname)
+{
+    glMockCall_t* call = glMock.Record(390);
+
+    glMock.ArgInt(call, (int64_t)pname);
+    return (GLhandleARB)0;
+}
+
+static void APIENTRY mglDetachObjectARB (GLhandleARB containerObj, GLhandleARB attachedObj)
+{
+    glMockCall_t* call = glMock.Record(391);
+
+    glMock.ArgInt(call, (int64_t)(size_t)containerObj);
+    glMock.ArgInt(call, (int64_t)(size_t)attachedObj);
+}
+
+static GLhandleARB APIENTRY mglCreateShaderObjectARB (GLenum shaderType)
+{
+    glMockCall_t* call = glMock.Record(392);
+
+    glMock.ArgInt(call, (int64_t)shaderType);
+    return (GLhandleARB)(size_t)glMock.NewName(1);
+}
+
+static void APIENTRY mglShaderSourceARB (GLhandleARB shaderObj, GLsizei count, const void* string, const GLint* length)
+{
+    glMockCall_t* call = glMock.Record(393);
+
+    glMock.ArgInt(call, (int64_t)(size_t)shaderObj);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, string);
+    glMock.ArgPtr(call, length);
+}
+
+static void APIENTRY mglCompileShaderARB (GLhandleARB shaderObj)
+{
+    glMockCall_t* call = glMock.Record(394);
+
+    glMock.ArgInt(call, (int64_t)(size_t)shaderObj);
+}
+
+static GLhandleARB APIENTRY mglCreateProgramObjectARB (void)
+{
+    glMockCall_t* call = glMock.Record(395);
+    return (GLhandleARB)(size_t)glMock.NewName(1);
+}
+
+static void APIENTRY mglAttachObjectARB (GLhandleARB containerObj, GLhandleARB obj)
+{
+    glMockCall_t* call = glMock.Record(396);
+
+    glMock.ArgInt(call, (int64_t)(size_t)containerObj);
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+}
+
+static void APIENTRY mglLinkProgramARB (GLhandleARB programObj)
+{
+    glMockCall_t* call = glMock.Record(397);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+}
+
+static void APIENTRY mglUseProgramObjectARB (GLhandleARB programObj)
+{
+    glMockCall_t* call = glMock.Record(398);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+    glMock.Bind(GL_PROGRAM_OBJECT_ARB, (GLuint)(size_t)programObj);
+}
+
+static void APIENTRY mglValidateProgramARB (GLhandleARB programObj)
+{
+    glMockCall_t* call = glMock.Record(399);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+}
+
+static void APIENTRY mglUniform1fARB (GLint location, GLfloat v0)
+{
+    glMockCall_t* call = glMock.Record(400);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgFloat(call, (double)v0);
+}
+
+static void APIENTRY mglUniform2fARB (GLint location, GLfloat v0, GLfloat v1)
+{
+    glMockCall_t* call = glMock.Record(401);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgFloat(call, (double)v0);
+    glMock.ArgFloat(call, (double)v1);
+}
+
+static void APIENTRY mglUniform3fARB (GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    glMockCall_t* call = glMock.Record(402);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgFloat(call, (double)v0);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+}
+
+static void APIENTRY mglUniform4fARB (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    glMockCall_t* call = glMock.Record(403);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgFloat(call, (double)v0);
+    glMock.ArgFloat(call, (double)v1);
+    glMock.ArgFloat(call, (double)v2);
+    glMock.ArgFloat(call, (double)v3);
+}
+
+static void APIENTRY mglUniform1iARB (GLint location, GLint v0)
+{
+    glMockCall_t* call = glMock.Record(404);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)v0);
+}
+
+static void APIENTRY mglUniform2iARB (GLint location, GLint v0, GLint v1)
+{
+    glMockCall_t* call = glMock.Record(405);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)v0);
+    glMock.ArgInt(call, (int64_t)v1);
+}
+
+static void APIENTRY mglUniform3iARB (GLint location, GLint v0, GLint v1, GLint v2)
+{
+    glMockCall_t* call = glMock.Record(406);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)v0);
+    glMock.ArgInt(call, (int64_t)v1);
+    glMock.ArgInt(call, (int64_t)v2);
+}
+
+static void APIENTRY mglUniform4iARB (GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
+{
+    glMockCall_t* call = glMock.Record(407);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)v0);
+    glMock.ArgInt(call, (int64_t)v1);
+    glMock.ArgInt(call, (int64_t)v2);
+    glMock.ArgInt(call, (int64_t)v3);
+}
+
+static void APIENTRY mglUniform1fvARB (GLint location, GLsizei count, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(408);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform2fvARB (GLint location, GLsizei count, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(409);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform3fvARB (GLint location, GLsizei count, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(410);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform4fvARB (GLint location, GLsizei count, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(411);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform1ivARB (GLint location, GLsizei count, const GLint* value)
+{
+    glMockCall_t* call = glMock.Record(412);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform2ivARB (GLint location, GLsizei count, const GLint* value)
+{
+    glMockCall_t* call = glMock.Record(413);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform3ivARB (GLint location, GLsizei count, const GLint* value)
+{
+    glMockCall_t* call = glMock.Record(414);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniform4ivARB (GLint location, GLsizei count, const GLint* value)
+{
+    glMockCall_t* call = glMock.Record(415);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniformMatrix2fvARB (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(416);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgInt(call, (int64_t)transpose);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniformMatrix3fvARB (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(417);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgInt(call, (int64_t)transpose);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglUniformMatrix4fvARB (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    glMockCall_t* call = glMock.Record(418);
+
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgInt(call, (int64_t)count);
+    glMock.ArgInt(call, (int64_t)transpose);
+    glMock.ArgPtr(call, value);
+}
+
+static void APIENTRY mglGetObjectParameterfvARB (GLhandleARB obj, GLenum pname, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(419);
+
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGetObjectParameterivARB (GLhandleARB obj, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(420);
+
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+    glMock.GetObjectParameteriv(pname, params);
+}
+
+static void APIENTRY mglGetInfoLogARB (GLhandleARB obj, GLsizei maxLength, GLsizei* length, GLcharARB* infoLog)
+{
+    glMockCall_t* call = glMock.Record(421);
+
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+    glMock.ArgInt(call, (int64_t)maxLength);
+    glMock.ArgPtr(call, length);
+    glMock.ArgPtr(call, infoLog);
+    glMock.GetName(maxLength, length, infoLog);
+}
+
+static void APIENTRY mglGetAttachedObjectsARB (GLhandleARB containerObj, GLsizei maxCount, GLsizei* count, GLhandleARB* obj)
+{
+    glMockCall_t* call = glMock.Record(422);
+
+    glMock.ArgInt(call, (int64_t)(size_t)containerObj);
+    glMock.ArgInt(call, (int64_t)maxCount);
+    glMock.ArgPtr(call, count);
+    glMock.ArgPtr(call, obj);
+}
+
+static GLint APIENTRY mglGetUniformLocationARB (GLhandleARB programObj, const GLcharARB* name)
+{
+    glMockCall_t* call = glMock.Record(423);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+    glMock.ArgPtr(call, name);
+    return (GLint)glMock.NewName(1);
+}
+
+static void APIENTRY mglGetActiveUniformARB (GLhandleARB programObj, GLuint index, GLsizei maxLength, GLsizei* length, GLint* size, GLenum* type, GLcharARB* name)
+{
+    glMockCall_t* call = glMock.Record(424);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+    glMock.ArgInt(call, (int64_t)index);
+    glMock.ArgInt(call, (int64_t)maxLength);
+    glMock.ArgPtr(call, length);
+    glMock.ArgPtr(call, size);
+    glMock.ArgPtr(call, type);
+    glMock.ArgPtr(call, name);
+    glMock.GetName(maxLength, length, name);
+}
+
+static void APIENTRY mglGetUniformfvARB (GLhandleARB programObj, GLint location, GLfloat* params)
+{
+    glMockCall_t* call = glMock.Record(425);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGetUniformivARB (GLhandleARB programObj, GLint location, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(426);
+
+    glMock.ArgInt(call, (int64_t)(size_t)programObj);
+    glMock.ArgInt(call, (int64_t)location);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGetShaderSourceARB (GLhandleARB obj, GLsizei maxLength, GLsizei* length, GLcharARB* source)
+{
+    glMockCall_t* call = glMock.Record(427);
+
+    glMock.ArgInt(call, (int64_t)(size_t)obj);
+    glMock.ArgInt(call, (int64_t)maxLength);
+    glMock.ArgPtr(call, length);
+    glMock.ArgPtr(call, source);
+}
+
+static GLboolean APIENTRY mglIsRenderbuffer (GLuint renderbuffer)
+{
+    glMockCall_t* call = glMock.Record(428);
+
+    glMock.ArgInt(call, (int64_t)renderbuffer);
+    return (GLboolean)0;
+}
+
+static void APIENTRY mglBindRenderbuffer (GLenum target, GLuint renderbuffer)
+{
+    glMockCall_t* call = glMock.Record(429);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)renderbuffer);
+    glMock.Bind(target, renderbuffer);
+}
+
+static void APIENTRY mglDeleteRenderbuffers (GLsizei n, const GLuint* renderbuffers)
+{
+    glMockCall_t* call = glMock.Record(430);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, renderbuffers);
+    glMock.DeleteNames(n, renderbuffers);
+}
+
+static void APIENTRY mglGenRenderbuffers (GLsizei n, GLuint* renderbuffers)
+{
+    glMockCall_t* call = glMock.Record(431);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, renderbuffers);
+    glMock.GenNames(n, renderbuffers);
+}
+
+static void APIENTRY mglRenderbufferStorage (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    glMockCall_t* call = glMock.Record(432);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+}
+
+static void APIENTRY mglGetRenderbufferParameteriv (GLenum target, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(433);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static GLboolean APIENTRY mglIsFramebuffer (GLuint framebuffer)
+{
+    glMockCall_t* call = glMock.Record(434);
+
+    glMock.ArgInt(call, (int64_t)framebuffer);
+    return (GLboolean)0;
+}
+
+static void APIENTRY mglBindFramebuffer (GLenum target, GLuint framebuffer)
+{
+    glMockCall_t* call = glMock.Record(435);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)framebuffer);
+    glMock.Bind(target, framebuffer);
+}
+
+static void APIENTRY mglDeleteFramebuffers (GLsizei n, const GLuint* framebuffers)
+{
+    glMockCall_t* call = glMock.Record(436);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, framebuffers);
+    glMock.DeleteNames(n, framebuffers);
+}
+
+static void APIENTRY mglGenFramebuffers (GLsizei n, GLuint* framebuffers)
+{
+    glMockCall_t* call = glMock.Record(437);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, framebuffers);
+    glMock.GenNames(n, framebuffers);
+}
+
+static GLenum APIENTRY mglCheckFramebufferStatus (GLenum target)
+{
+    glMockCall_t* call = glMock.Record(438);
+
+    glMock.ArgInt(call, (int64_t)target);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void APIENTRY mglFramebufferTexture1D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    glMockCall_t* call = glMock.Record(439);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)textarget);
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.ArgInt(call, (int64_t)level);
+}
+
+static void APIENTRY mglFramebufferTexture2D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    glMockCall_t* call = glMock.Record(440);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)textarget);
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.ArgInt(call, (int64_t)level);
+}
+
+static void APIENTRY mglFramebufferTexture3D (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset)
+{
+    glMockCall_t* call = glMock.Record(441);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)textarget);
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)zoffset);
+}
+
+static void APIENTRY mglFramebufferRenderbuffer (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    glMockCall_t* call = glMock.Record(442);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)renderbuffertarget);
+    glMock.ArgInt(call, (int64_t)renderbuffer);
+}
+
+static void APIENTRY mglGetFramebufferAttachmentParameteriv (GLenum target, GLenum attachment, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(443);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGenerateMipmap (GLenum target)
+{
+    glMockCall_t* call = glMock.Record(444);
+
+    glMock.ArgInt(call, (int64_t)target);
+}
+
+static void APIENTRY mglBlitFramebuffer (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+    glMockCall_t* call = glMock.Record(445);
+
+    glMock.ArgInt(call, (int64_t)srcX0);
+    glMock.ArgInt(call, (int64_t)srcY0);
+    glMock.ArgInt(call, (int64_t)srcX1);
+    glMock.ArgInt(call, (int64_t)srcY1);
+    glMock.ArgInt(call, (int64_t)dstX0);
+    glMock.ArgInt(call, (int64_t)dstY0);
+    glMock.ArgInt(call, (int64_t)dstX1);
+    glMock.ArgInt(call, (int64_t)dstY1);
+    glMock.ArgInt(call, (int64_t)mask);
+    glMock.ArgInt(call, (int64_t)filter);
+}
+
+static void APIENTRY mglRenderbufferStorageMultisample (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    glMockCall_t* call = glMock.Record(446);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)samples);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+}
+
+static void APIENTRY mglFramebufferTextureLayer (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)
+{
+    glMockCall_t* call = glMock.Record(447);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)attachment);
+    glMock.ArgInt(call, (int64_t)texture);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)layer);
+}
+
+static void APIENTRY mglGenQueriesARB (GLsizei n, GLuint* ids)
+{
+    glMockCall_t* call = glMock.Record(448);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, ids);
+    glMock.GenNames(n, ids);
+}
+
+static void APIENTRY mglDeleteQueriesARB (GLsizei n, const GLuint* ids)
+{
+    glMockCall_t* call = glMock.Record(449);
+
+    glMock.ArgInt(call, (int64_t)n);
+    glMock.ArgPtr(call, ids);
+}
+
+static GLboolean APIENTRY mglIsQueryARB (GLuint id)
+{
+    glMockCall_t* call = glMock.Record(450);
+
+    glMock.ArgInt(call, (int64_t)id);
+    return (GLboolean)0;
+}
+
+static void APIENTRY mglBeginQueryARB (GLenum target, GLuint id)
+{
+    glMockCall_t* call = glMock.Record(451);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)id);
+}
+
+static void APIENTRY mglEndQueryARB (GLenum target)
+{
+    glMockCall_t* call = glMock.Record(452);
+
+    glMock.ArgInt(call, (int64_t)target);
+}
+
+static void APIENTRY mglGetQueryivARB (GLenum target, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(453);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+}
+
+static void APIENTRY mglGetQueryObjectivARB (GLuint id, GLenum pname, GLint* params)
+{
+    glMockCall_t* call = glMock.Record(454);
+
+    glMock.ArgInt(call, (int64_t)id);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+    *params = 1;
+}
+
+static void APIENTRY mglGetQueryObjectuivARB (GLuint id, GLenum pname, GLuint* params)
+{
+    glMockCall_t* call = glMock.Record(455);
+
+    glMock.ArgInt(call, (int64_t)id);
+    glMock.ArgInt(call, (int64_t)pname);
+    glMock.ArgPtr(call, params);
+    *params = 1;
+}
+
+static void APIENTRY mglCompressedTexImage3DARB (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(456);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)depth);
+    glMock.ArgInt(call, (int64_t)border);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglCompressedTexImage2DARB (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(457);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)border);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglCompressedTexImage1DARB (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(458);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)internalformat);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)border);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglCompressedTexSubImage3DARB (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(459);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)yoffset);
+    glMock.ArgInt(call, (int64_t)zoffset);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)depth);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglCompressedTexSubImage2DARB (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(460);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)yoffset);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)height);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglCompressedTexSubImage1DARB (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+    glMockCall_t* call = glMock.Record(461);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgInt(call, (int64_t)xoffset);
+    glMock.ArgInt(call, (int64_t)width);
+    glMock.ArgInt(call, (int64_t)format);
+    glMock.ArgInt(call, (int64_t)imageSize);
+    glMock.ArgPtr(call, data);
+}
+
+static void APIENTRY mglGetCompressedTexImageARB (GLenum target, GLint level, GLvoid* img)
+{
+    glMockCall_t* call = glMock.Record(462);
+
+    glMock.ArgInt(call, (int64_t)target);
+    glMock.ArgInt(call, (int64_t)level);
+    glMock.ArgPtr(call, img);
+}
+
+const int dglMockNumFuncs = 463;
+
+const char* dglMockNames[463] =
+{
+    "glAccum",
+    "glAlphaFunc",
+    "glAreTexturesResident",
+    "glArrayElement",
+    "glBegin",
+    "glBindTexture",
+    "glBitmap",
+    "glBlendFunc",
+    "glCallList",
+    "glCallLists",
+    "glClear",
+    "glClearAccum",
+    "glClearColor",
+    "glClearDepth",
+    "glClearIndex",
+    "glClearStencil",
+    "glClipPlane",
+    "glColor3b",
+    "glColor3bv",
+    "glColor3d",
+    "glColor3dv",
+    "glColor3f",
+    "glColor3fv",
+    "glColor3i",
+    "glColor3iv",
+    "glColor3s",
+    "glColor3sv",
+    "glColor3ub",
+    "glColor3ubv",
+    "glColor3ui",
+    "glColor3uiv",
+    "glColor3us",
+    "glColor3usv",
+    "glColor4b",
+    "glColor4bv",
+    "glColor4d",
+    "glColor4dv",
+    "glColor4f",
+    "glColor4fv",
+    "glColor4i",
+    "glColor4iv",
+    "glColor4s",
+    "glColor4sv",
+    "glColor4ub",
+    "glColor4ubv",
+    "glColor4ui",
+    "glColor4uiv",
+    "glColor4us",
+    "glColor4usv",
+    "glColorMask",
+    "glColorMaterial",
+    "glColorPointer",
+    "glCopyPixels",
+    "glCopyTexImage1D",
+    "glCopyTexImage2D",
+    "glCopyTexSubImage1D",
+    "glCopyTexSubImage2D",
+    "glCullFace",
+    "glDeleteLists",
+    "glDeleteTextures",
+    "glDepthFunc",
+    "glDepthMask",
+    "glDepthRange",
+    "glDisable",
+    "glDisableClientState",
+    "glDrawArrays",
+    "glDrawBuffer",
+    "glDrawElements",
+    "glDrawPixels",
+    "glEdgeFlag",
+    "glEdgeFlagPointer",
+    "glEdgeFlagv",
+    "glEnable",
+    "glEnableClientState",
+    "glEnd",
+    "glEndList",
+    "glEvalCoord1d",
+    "glEvalCoord1dv",
+    "glEvalCoord1f",
+    "glEvalCoord1fv",
+    "glEvalCoord2d",
+    "glEvalCoord2dv",
+    "glEvalCoord2f",
+    "glEvalCoord2fv",
+    "glEvalMesh1",
+    "glEvalMesh2",
+    "glEvalPoint1",
+    "glEvalPoint2",
+    "glFeedbackBuffer",
+    "glFinish",
+    "glFlush",
+    "glFogf",
+    "glFogfv",
+    "glFogi",
+    "glFogiv",
+    "glFrontFace",
+    "glFrustum",
+    "glGenLists",
+    "glGenTextures",
+    "glGetBooleanv",
+    "glGetClipPlane",
+    "glGetDoublev",
+    "glGetError",
+    "glGetFloatv",
+    "glGetIntegerv",
+    "glGetLightfv",
+    "glGetLightiv",
+    "glGetMapdv",
+    "glGetMapfv",
+    "glGetMapiv",
+    "glGetMaterialfv",
+    "glGetMaterialiv",
+    "glGetPixelMapfv",
+    "glGetPixelMapuiv",
+    "glGetPixelMapusv",
+    "glGetPointerv",
+    "glGetPolygonStipple",
+    "glGetTexEnvfv",
+    "glGetTexEnviv",
+    "glGetTexGendv",
+    "glGetTexGenfv",
+    "glGetTexGeniv",
+    "glGetTexImage",
+    "glGetTexLevelParameterfv",
+    "glGetTexLevelParameteriv",
+    "glGetTexParameterfv",
+    "glGetTexParameteriv",
+    "glHint",
+    "glIndexMask",
+    "glIndexPointer",
+    "glIndexd",
+    "glIndexdv",
+    "glIndexf",
+    "glIndexfv",
+    "glIndexi",
+    "glIndexiv",
+    "glIndexs",
+    "glIndexsv",
+    "glIndexub",
+    "glIndexubv",
+    "glInitNames",
+    "glInterleavedArrays",
+    "glIsEnabled",
+    "glIsList",
+    "glIsTexture",
+    "glLightModelf",
+    "glLightModelfv",
+    "glLightModeli",
+    "glLightModeliv",
+    "glLightf",
+    "glLightfv",
+    "glLighti",
+    "glLightiv",
+    "glLineStipple",
+    "glLineWidth",
+    "glListBase",
+    "glLoadIdentity",
+    "glLoadMatrixd",
+    "glLoadMatrixf",
+    "glLoadName",
+    "glLogicOp",
+    "glMap1d",
+    "glMap1f",
+    "glMap2d",
+    "glMap2f",
+    "glMapGrid1d",
+    "glMapGrid1f",
+    "glMapGrid2d",
+    "glMapGrid2f",
+    "glMaterialf",
+    "glMaterialfv",
+    "glMateriali",
+    "glMaterialiv",
+    "glMatrixMode",
+    "glMultMatrixd",
+    "glMultMatrixf",
+    "glNewList",
+    "glNormal3b",
+    "glNormal3bv",
+    "glNormal3d",
+    "glNormal3dv",
+    "glNormal3f",
+    "glNormal3fv",
+    "glNormal3i",
+    "glNormal3iv",
+    "glNormal3s",
+    "glNormal3sv",
+    "glNormalPointer",
+    "glOrtho",
+    "glPassThrough",
+    "glPixelMapfv",
+    "glPixelMapuiv",
+    "glPixelMapusv",
+    "glPixelStoref",
+    "glPixelStorei",
+    "glPixelTransferf",
+    "glPixelTransferi",
+    "glPixelZoom",
+    "glPointSize",
+    "glPolygonMode",
+    "glPolygonOffset",
+    "glPolygonStipple",
+    "glPopAttrib",
+    "glPopClientAttrib",
+    "glPopMatrix",
+    "glPopName",
+    "glPrioritizeTextures",
+    "glPushAttrib",
+    "glPushClientAttrib",
+    "glPushMatrix",
+    "glPushName",
+    "glRasterPos2d",
+    "glRasterPos2dv",
+    "glRasterPos2f",
+    "glRasterPos2fv",
+    "glRasterPos2i",
+    "glRasterPos2iv",
+    "glRasterPos2s",
+    "glRasterPos2sv",
+    "glRasterPos3d",
+    "glRasterPos3dv",
+    "glRasterPos3f",
+    "glRasterPos3fv",
+    "glRasterPos3i",
+    "glRasterPos3iv",
+    "glRasterPos3s",
+    "glRasterPos3sv",
+    "glRasterPos4d",
+    "glRasterPos4dv",
+    "glRasterPos4f",
+    "glRasterPos4fv",
+    "glRasterPos4i",
+    "glRasterPos4iv",
+    "glRasterPos4s",
+    "glRasterPos4sv",
+    "glReadBuffer",
+    "glReadPixels",
+    "glRectd",
+    "glRectdv",
+    "glRectf",
+    "glRectfv",
+    "glRecti",
+    "glRectiv",
+    "glRects",
+    "glRectsv",
+    "glRenderMode",
+    "glRotated",
+    "glRotatef",
+    "glScaled",
+    "glScalef",
+    "glScissor",
+    "glSelectBuffer",
+    "glShadeModel",
+    "glStencilFunc",
+    "glStencilMask",
+    "glStencilOp",
+    "glTexCoord1d",
+    "glTexCoord1dv",
+    "glTexCoord1f",
+    "glTexCoord1fv",
+    "glTexCoord1i",
+    "glTexCoord1iv",
+    "glTexCoord1s",
+    "glTexCoord1sv",
+    "glTexCoord2d",
+    "glTexCoord2dv",
+    "glTexCoord2f",
+    "glTexCoord2fv",
+    "glTexCoord2i",
+    "glTexCoord2iv",
+    "glTexCoord2s",
+    "glTexCoord2sv",
+    "glTexCoord3d",
+    "glTexCoord3dv",
+    "glTexCoord3f",
+    "glTexCoord3fv",
+    "glTexCoord3i",
+    "glTexCoord3iv",
+    "glTexCoord3s",
+    "glTexCoord3sv",
+    "glTexCoord4d",
+    "glTexCoord4dv",
+    "glTexCoord4f",
+    "glTexCoord4fv",
+    "glTexCoord4i",
+    "glTexCoord4iv",
+    "glTexCoord4s",
+    "glTexCoord4sv",
+    "glTexCoordPointer",
+    "glTexEnvf",
+    "glTexEnvfv",
+    "glTexEnvi",
+    "glTexEnviv",
+    "glTexGend",
+    "glTexGendv",
+    "glTexGenf",
+    "glTexGenfv",
+    "glTexGeni",
+    "glTexGeniv",
+    "glTexImage1D",
+    "glTexImage2D",
+    "glTexParameterf",
+    "glTexParameterfv",
+    "glTexParameteri",
+    "glTexParameteriv",
+    "glTexSubImage1D",
+    "glTexSubImage2D",
+    "glTranslated",
+    "glTranslatef",
+    "glVertex2d",
+    "glVertex2dv",
+    "glVertex2f",
+    "glVertex2fv",
+    "glVertex2i",
+    "glVertex2iv",
+    "glVertex2s",
+    "glVertex2sv",
+    "glVertex3d",
+    "glVertex3dv",
+    "glVertex3f",
+    "glVertex3fv",
+    "glVertex3i",
+    "glVertex3iv",
+    "glVertex3s",
+    "glVertex3sv",
+    "glVertex4d",
+    "glVertex4dv",
+    "glVertex4f",
+    "glVertex4fv",
+    "glVertex4i",
+    "glVertex4iv",
+    "glVertex4s",
+    "glVertex4sv",
+    "glVertexPointer",
+    "glViewport",
+    "glActiveTextureARB",
+    "glClientActiveTextureARB",
+    "glMultiTexCoord1dARB",
+    "glMultiTexCoord1dvARB",
+    "glMultiTexCoord1fARB",
+    "glMultiTexCoord1fvARB",
+    "glMultiTexCoord1iARB",
+    "glMultiTexCoord1ivARB",
+    "glMultiTexCoord1sARB",
+    "glMultiTexCoord1svARB",
+    "glMultiTexCoord2dARB",
+    "glMultiTexCoord2dvARB",
+    "glMultiTexCoord2fARB",
+    "glMultiTexCoord2fvARB",
+    "glMultiTexCoord2iARB",
+    "glMultiTexCoord2ivARB",
+    "glMultiTexCoord2sARB",
+    "glMultiTexCoord2svARB",
+    "glMultiTexCoord3dARB",
+    "glMultiTexCoord3dvARB",
+    "glMultiTexCoord3fARB",
+    "glMultiTexCoord3fvARB",
+    "glMultiTexCoord3iARB",
+    "glMultiTexCoord3ivARB",
+    "glMultiTexCoord3sARB",
+    "glMultiTexCoord3svARB",
+    "glMultiTexCoord4dARB",
+    "glMultiTexCoord4dvARB",
+    "glMultiTexCoord4fARB",
+    "glMultiTexCoord4fvARB",
+    "glMultiTexCoord4iARB",
+    "glMultiTexCoord4ivARB",
+    "glMultiTexCoord4sARB",
+    "glMultiTexCoord4svARB",
+    "glLockArraysEXT",
+    "glUnlockArraysEXT",
+    "glMultiDrawArraysEXT",
+    "glMultiDrawElementsEXT",
+    "glFogCoordfEXT",
+    "glFogCoordfvEXT",
+    "glFogCoorddEXT",
+    "glFogCoorddvEXT",
+    "glFogCoordPointerEXT",
+    "glBindBufferARB",
+    "glDeleteBuffersARB",
+    "glGenBuffersARB",
+    "glIsBufferARB",
+    "glBufferDataARB",
+    "glBufferSubDataARB",
+    "glGetBufferSubDataARB",
+    "glMapBufferARB",
+    "glUnmapBufferARB",
+    "glGetBufferParameterivARB",
+    "glGetBufferPointervARB",
+    "glDeleteObjectARB",
+    "glGetHandleARB",
+    "glDetachObjectARB",
+    "glCreateShaderObjectARB",
+    "glShaderSourceARB",
+    "glCompileShaderARB",
+    "glCreateProgramObjectARB",
+    "glAttachObjectARB",
+    "glLinkProgramARB",
+    "glUseProgramObjectARB",
+    "glValidateProgramARB",
+    "glUniform1fARB",
+    "glUniform2fARB",
+    "glUniform3fARB",
+    "glUniform4fARB",
+    "glUniform1iARB",
+    "glUniform2iARB",
+    "glUniform3iARB",
+    "glUniform4iARB",
+    "glUniform1fvARB",
+    "glUniform2fvARB",
+    "glUniform3fvARB",
+    "glUniform4fvARB",
+    "glUniform1ivARB",
+    "glUniform2ivARB",
+    "glUniform3ivARB",
+    "glUniform4ivARB",
+    "glUniformMatrix2fvARB",
+    "glUniformMatrix3fvARB",
+    "glUniformMatrix4fvARB",
+    "glGetObjectParameterfvARB",
+    "glGetObjectParameterivARB",
+    "glGetInfoLogARB",
+    "glGetAttachedObjectsARB",
+    "glGetUniformLocationARB",
+    "glGetActiveUniformARB",
+    "glGetUniformfvARB",
+    "glGetUniformivARB",
+    "glGetShaderSourceARB",
+    "glIsRenderbuffer",
+    "glBindRenderbuffer",
+    "glDeleteRenderbuffers",
+    "glGenRenderbuffers",
+    "glRenderbufferStorage",
+    "glGetRenderbufferParameteriv",
+    "glIsFramebuffer",
+    "glBindFramebuffer",
+    "glDeleteFramebuffers",
+    "glGenFramebuffers",
+    "glCheckFramebufferStatus",
+    "glFramebufferTexture1D",
+    "glFramebufferTexture2D",
+    "glFramebufferTexture3D",
+    "glFramebufferRenderbuffer",
+    "glGetFramebufferAttachmentParameteriv",
+    "glGenerateMipmap",
+    "glBlitFramebuffer",
+    "glRenderbufferStorageMultisample",
+    "glFramebufferTextureLayer",
+    "glGenQueriesARB",
+    "glDeleteQueriesARB",
+    "glIsQueryARB",
+    "glBeginQueryARB",
+    "glEndQueryARB",
+    "glGetQueryivARB",
+    "glGetQueryObjectivARB",
+    "glGetQueryObjectuivARB",
+    "glCompressedTexImage3DARB",
+    "glCompressedTexImage2DARB",
+    "glCompressedTexImage1DARB",
+    "glCompressedTexSubImage3DARB",
+    "glCompressedTexSubImage2DARB",
+    "glCompressedTexSubImage1DARB",
+    "glGetCompressedTexImageARB",
+};
+
+static void* dglMockProcs[463] =
+{
+    (void*)mglAccum,
+    (void*)mglAlphaFunc,
+    (void*)mglAreTexturesResident,
+    (void*)mglArrayElement,
+    (void*)mglBegin,
+    (void*)mglBindTexture,
+    (void*)mglBitmap,
+    (void*)mglBlendFunc,
+    (void*)mglCallList,
+    (void*)mglCallLists,
+    (void*)mglClear,
+    (void*)mglClearAccum,
+    (void*)mglClearColor,
+    (void*)mglClearDepth,
+    (void*)mglClearIndex,
+    (void*)mglClearStencil,
+    (void*)mglClipPlane,
+    (void*)mglColor3b,
+    (void*)mglColor3bv,
+    (void*)mglColor3d,
+    (void*)mglColor3dv,
+    (void*)mglColor3f,
+    (void*)mglColor3fv,
+    (void*)mglColor3i,
+    (void*)mglColor3iv,
+    (void*)mglColor3s,
+    (void*)mglColor3sv,
+    (void*)mglColor3ub,
+    (void*)mglColor3ubv,
+    (void*)mglColor3ui,
+    (void*)mglColor3uiv,
+    (void*)mglColor3us,
+    (void*)mglColor3usv,
+    (void*)mglColor4b,
+    (void*)mglColor4bv,
+    (void*)mglColor4d,
+    (void*)mglColor4dv,
+    (void*)mglColor4f,
+    (void*)mglColor4fv,
+    (void*)mglColor4i,
+    (void*)mglColor4iv,
+    (void*)mglColor4s,
+    (void*)mglColor4sv,
+    (void*)mglColor4ub,
+    (void*)mglColor4ubv,
+    (void*)mglColor4ui,
+    (void*)mglColor4uiv,
+    (void*)mglColor4us,
+    (void*)mglColor4usv,
+    (void*)mglColorMask,
+    (void*)mglColorMaterial,
+    (void*)mglColorPointer,
+    (void*)mglCopyPixels,
+    (void*)mglCopyTexImage1D,
+    (void*)mglCopyTexImage2D,
+    (void*)mglCopyTexSubImage1D,
+    (void*)mglCopyTexSubImage2D,
+    (void*)mglCullFace,
+    (void*)mglDeleteLists,
+    (void*)mglDeleteTextures,
+    (void*)mglDepthFunc,
+    (void*)mglDepthMask,
+    (void*)mglDepthRange,
+    (void*)mglDisable,
+    (void*)mglDisableClientState,
+    (void*)mglDrawArrays,
+    (void*)mglDrawBuffer,
+    (void*)mglDrawElements,
+    (void*)mglDrawPixels,
+    (void*)mglEdgeFlag,
+    (void*)mglEdgeFlagPointer,
+    (void*)mglEdgeFlagv,
+    (void*)mglEnable,
+    (void*)mglEnableClientState,
+    (void*)mglEnd,
+    (void*)mglEndList,
+    (void*)mglEvalCoord1d,
+    (void*)mglEvalCoord1dv,
+    (void*)mglEvalCoord1f,
+    (void*)mglEvalCoord1fv,
+    (void*)mglEvalCoord2d,
+    (void*)mglEvalCoord2dv,
+    (void*)mglEvalCoord2f,
+    (void*)mglEvalCoord2fv,
+    (void*)mglEvalMesh1,
+    (void*)mglEvalMesh2,
+    (void*)mglEvalPoint1,
+    (void*)mglEvalPoint2,
+    (void*)mglFeedbackBuffer,
+    (void*)mglFinish,
+    (void*)mglFlush,
+    (void*)mglFogf,
+    (void*)mglFogfv,
+    (void*)mglFogi,
+    (void*)mglFogiv,
+    (void*)mglFrontFace,
+    (void*)mglFrustum,
+    (void*)mglGenLists,
+    (void*)mglGenTextures,
+    (void*)mglGetBooleanv,
+    (void*)mglGetClipPlane,
+    (void*)mglGetDoublev,
+    (void*)mglGetError,
+    (void*)mglGetFloatv,
+    (void*)mglGetIntegerv,
+    (void*)mglGetLightfv,
+    (void*)mglGetLightiv,
+    (void*)mglGetMapdv,
+    (void*)mglGetMapfv,
+    (void*)mglGetMapiv,
+    (void*)mglGetMaterialfv,
+    (void*)mglGetMaterialiv,
+    (void*)mglGetPixelMapfv,
+    (void*)mglGetPixelMapuiv,
+    (void*)mglGetPixelMapusv,
+    (void*)mglGetPointerv,
+    (void*)mglGetPolygonStipple,
+    (void*)mglGetTexEnvfv,
+    (void*)mglGetTexEnviv,
+    (void*)mglGetTexGendv,
+    (void*)mglGetTexGenfv,
+    (void*)mglGetTexGeniv,
+    (void*)mglGetTexImage,
+    (void*)mglGetTexLevelParameterfv,
+    (void*)mglGetTexLevelParameteriv,
+    (void*)mglGetTexParameterfv,
+    (void*)mglGetTexParameteriv,
+    (void*)mglHint,
+    (void*)mglIndexMask,
+    (void*)mglIndexPointer,
+    (void*)mglIndexd,
+    (void*)mglIndexdv,
+    (void*)mglIndexf,
+    (void*)mglIndexfv,
+    (void*)mglIndexi,
+    (void*)mglIndexiv,
+    (void*)mglIndexs,
+    (void*)mglIndexsv,
+    (void*)mglIndexub,
+    (void*)mglIndexubv,
+    (void*)mglInitNames,
+    (void*)mglInterleavedArrays,
+    (void*)mglIsEnabled,
+    (void*)mglIsList,
+    (void*)mglIsTexture,
+    (void*)mglLightModelf,
+    (void*)mglLightModelfv,
+    (void*)mglLightModeli,
+    (void*)mglLightModeliv,
+    (void*)mglLightf,
+    (void*)mglLightfv,
+    (void*)mglLighti,
+    (void*)mglLightiv,
+    (void*)mglLineStipple,
+    (void*)mglLineWidth,
+    (void*)mglListBase,
+    (void*)mglLoadIdentity,
+    (void*)mglLoadMatrixd,
+    (void*)mglLoadMatrixf,
+    (void*)mglLoadName,
+    (void*)mglLogicOp,
+    (void*)mglMap1d,
+    (void*)mglMap1f,
+    (void*)mglMap2d,
+    (void*)mglMap2f,
+    (void*)mglMapGrid1d,
+    (void*)mglMapGrid1f,
+    (void*)mglMapGrid2d,
+    (void*)mglMapGrid2f,
+    (void*)mglMaterialf,
+    (void*)mglMaterialfv,
+    (void*)mglMateriali,
+    (void*)mglMaterialiv,
+    (void*)mglMatrixMode,
+    (void*)mglMultMatrixd,
+    (void*)mglMultMatrixf,
+    (void*)mglNewList,
+    (void*)mglNormal3b,
+    (void*)mglNormal3bv,
+    (void*)mglNormal3d,
+    (void*)mglNormal3dv,
+    (void*)mglNormal3f,
+    (void*)mglNormal3fv,
+    (void*)mglNormal3i,
+    (void*)mglNormal3iv,
+    (void*)mglNormal3s,
+    (void*)mglNormal3sv,
+    (void*)mglNormalPointer,
+    (void*)mglOrtho,
+    (void*)mglPassThrough,
+    (void*)mglPixelMapfv,
+    (void*)mglPixelMapuiv,
+    (void*)mglPixelMapusv,
+    (void*)mglPixelStoref,
+    (void*)mglPixelStorei,
+    (void*)mglPixelTransferf,
+    (void*)mglPixelTransferi,
+    (void*)mglPixelZoom,
+    (void*)mglPointSize,
+    (void*)mglPolygonMode,
+    (void*)mglPolygonOffset,
+    (void*)mglPolygonStipple,
+    (void*)mglPopAttrib,
+    (void*)mglPopClientAttrib,
+    (void*)mglPopMatrix,
+    (void*)mglPopName,
+    (void*)mglPrioritizeTextures,
+    (void*)mglPushAttrib,
+    (void*)mglPushClientAttrib,
+    (void*)mglPushMatrix,
+    (void*)mglPushName,
+    (void*)mglRasterPos2d,
+    (void*)mglRasterPos2dv,
+    (void*)mglRasterPos2f,
+    (void*)mglRasterPos2fv,
+    (void*)mglRasterPos2i,
+    (void*)mglRasterPos2iv,
+    (void*)mglRasterPos2s,
+    (void*)mglRasterPos2sv,
+    (void*)mglRasterPos3d,
+    (void*)mglRasterPos3dv,
+    (void*)mglRasterPos3f,
+    (void*)mglRasterPos3fv,
+    (void*)mglRasterPos3i,
+    (void*)mglRasterPos3iv,
+    (void*)mglRasterPos3s,
+    (void*)mglRasterPos3sv,
+    (void*)mglRasterPos4d,
+    (void*)mglRasterPos4dv,
+    (void*)mglRasterPos4f,
+    (void*)mglRasterPos4fv,
+    (void*)mglRasterPos4i,
+    (void*)mglRasterPos4iv,
+    (void*)mglRasterPos4s,
+    (void*)mglRasterPos4sv,
+    (void*)mglReadBuffer,
+    (void*)mglReadPixels,
+    (void*)mglRectd,
+    (void*)mglRectdv,
+    (void*)mglRectf,
+    (void*)mglRectfv,
+    (void*)mglRecti,
+    (void*)mglRectiv,
+    (void*)mglRects,
+    (void*)mglRectsv,
+    (void*)mglRenderMode,
+    (void*)mglRotated,
+    (void*)mglRotatef,
+    (void*)mglScaled,
+    (void*)mglScalef,
+    (void*)mglScissor,
+    (void*)mglSelectBuffer,
+    (void*)mglShadeModel,
+    (void*)mglStencilFunc,
+    (void*)mglStencilMask,
+    (void*)mglStencilOp,
+    (void*)mglTexCoord1d,
+    (void*)mglTexCoord1dv,
+    (void*)mglTexCoord1f,
+    (void*)mglTexCoord1fv,
+    (void*)mglTexCoord1i,
+    (void*)mglTexCoord1iv,
+    (void*)mglTexCoord1s,
+    (void*)mglTexCoord1sv,
+    (void*)mglTexCoord2d,
+    (void*)mglTexCoord2dv,
+    (void*)mglTexCoord2f,
+    (void*)mglTexCoord2fv,
+    (void*)mglTexCoord2i,
+    (void*)mglTexCoord2iv,
+    (void*)mglTexCoord2s,
+    (void*)mglTexCoord2sv,
+    (void*)mglTexCoord3d,
+    (void*)mglTexCoord3dv,
+    (void*)mglTexCoord3f,
+    (void*)mglTexCoord3fv,
+    (void*)mglTexCoord3i,
+    (void*)mglTexCoord3iv,
+    (void*)mglTexCoord3s,
+    (void*)mglTexCoord3sv,
+    (void*)mglTexCoord4d,
+    (void*)mglTexCoord4dv,
+    (void*)mglTexCoord4f,
+    (void*)mglTexCoord4fv,
+    (void*)mglTexCoord4i,
+    (void*)mglTexCoord4iv,
+    (void*)mglTexCoord4s,
+    (void*)mglTexCoord4sv,
+    (void*)mglTexCoordPointer,
+    (void*)mglTexEnvf,
+    (void*)mglTexEnvfv,
+    (void*)mglTexEnvi,
+    (void*)mglTexEnviv,
+    (void*)mglTexGend,
+    (void*)mglTexGendv,
+    (void*)mglTexGenf,
+    (void*)mglTexGenfv,
+    (void*)mglTexGeni,
+    (void*)mglTexGeniv,
+    (void*)mglTexImage1D,
+    (void*)mglTexImage2D,
+    (void*)mglTexParameterf,
+    (void*)mglTexParameterfv,
+    (void*)mglTexParameteri,
+    (void*)mglTexParameteriv,
+    (void*)mglTexSubImage1D,
+    (void*)mglTexSubImage2D,
+    (void*)mglTranslated,
+    (void*)mglTranslatef,
+    (void*)mglVertex2d,
+    (void*)mglVertex2dv,
+    (void*)mglVertex2f,
+    (void*)mglVertex2fv,
+    (void*)mglVertex2i,
+    (void*)mglVertex2iv,
+    (void*)mglVertex2s,
+    (void*)mglVertex2sv,
+    (void*)mglVertex3d,
+    (void*)mglVertex3dv,
+    (void*)mglVertex3f,
+    (void*)mglVertex3fv,
+    (void*)mglVertex3i,
+    (void*)mglVertex3iv,
+    (void*)mglVertex3s,
+    (void*)mglVertex3sv,
+    (void*)mglVertex4d,
+    (void*)mglVertex4dv,
+    (void*)mglVertex4f,
+    (void*)mglVertex4fv,
+    (void*)mglVertex4i,
+    (void*)mglVertex4iv,
+    (void*)mglVertex4s,
+    (void*)mglVertex4sv,
+    (void*)mglVertexPointer,
+    (void*)mglViewport,
+    (void*)mglActiveTextureARB,
+    (void*)mglClientActiveTextureARB,
+    (void*)mglMultiTexCoord1dARB,
+    (void*)mglMultiTexCoord1dvARB,
+    (void*)mglMultiTexCoord1fARB,
+    (void*)mglMultiTexCoord1fvARB,
+    (void*)mglMultiTexCoord1iARB,
+    (void*)mglMultiTexCoord1ivARB,
+    (void*)mglMultiTexCoord1sARB,
+    (void*)mglMultiTexCoord1svARB,
+    (void*)mglMultiTexCoord2dARB,
+    (void*)mglMultiTexCoord2dvARB,
+    (void*)mglMultiTexCoord2fARB,
+    (void*)mglMultiTexCoord2fvARB,
+    (void*)mglMultiTexCoord2iARB,
+    (void*)mglMultiTexCoord2ivARB,
+    (void*)mglMultiTexCoord2sARB,
+    (void*)mglMultiTexCoord2svARB,
+    (void*)mglMultiTexCoord3dARB,
+    (void*)mglMultiTexCoord3dvARB,
+    (void*)mglMultiTexCoord3fARB,
+    (void*)mglMultiTexCoord3fvARB,
+    (void*)mglMultiTexCoord3iARB,
+    (void*)mglMultiTexCoord3ivARB,
+    (void*)mglMultiTexCoord3sARB,
+    (void*)mglMultiTexCoord3svARB,
+    (void*)mglMultiTexCoord4dARB,
+    (void*)mglMultiTexCoord4dvARB,
+    (void*)mglMultiTexCoord4fARB,
+    (void*)mglMultiTexCoord4fvARB,
+    (void*)mglMultiTexCoord4iARB,
+    (void*)mglMultiTexCoord4ivARB,
+    (void*)mglMultiTexCoord4sARB,
+    (void*)mglMultiTexCoord4svARB,
+    (void*)mglLockArraysEXT,
+    (void*)mglUnlockArraysEXT,
+    (void*)mglMultiDrawArraysEXT,
+    (void*)mglMultiDrawElementsEXT,
+    (void*)mglFogCoordfEXT,
+    (void*)mglFogCoordfvEXT,
+    (void*)mglFogCoorddEXT,
+    (void*)mglFogCoorddvEXT,
+    (void*)mglFogCoordPointerEXT,
+    (void*)mglBindBufferARB,
+    (void*)mglDeleteBuffersARB,
+    (void*)mglGenBuffersARB,
+    (void*)mglIsBufferARB,
+    (void*)mglBufferDataARB,
+    (void*)mglBufferSubDataARB,
+    (void*)mglGetBufferSubDataARB,
+    (void*)mglMapBufferARB,
+    (void*)mglUnmapBufferARB,
+    (void*)mglGetBufferParameterivARB,
+    (void*)mglGetBufferPointervARB,
+    (void*)mglDeleteObjectARB,
+    (void*)mglGetHandleARB,
+    (void*)mglDetachObjectARB,
+    (void*)mglCreateShaderObjectARB,
+    (void*)mglShaderSourceARB,
+    (void*)mglCompileShaderARB,
+    (void*)mglCreateProgramObjectARB,
+    (void*)mglAttachObjectARB,
+    (void*)mglLinkProgramARB,
+    (void*)mglUseProgramObjectARB,
+    (void*)mglValidateProgramARB,
+    (void*)mglUniform1fARB,
+    (void*)mglUniform2fARB,
+    (void*)mglUniform3fARB,
+    (void*)mglUniform4fARB,
+    (void*)mglUniform1iARB,
+    (void*)mglUniform2iARB,
+    (void*)mglUniform3iARB,
+    (void*)mglUniform4iARB,
+    (void*)mglUniform1fvARB,
+    (void*)mglUniform2fvARB,
+    (void*)mglUniform3fvARB,
+    (void*)mglUniform4fvARB,
+    (void*)mglUniform1ivARB,
+    (void*)mglUniform2ivARB,
+    (void*)mglUniform3ivARB,
+    (void*)mglUniform4ivARB,
+    (void*)mglUniformMatrix2fvARB,
+    (void*)mglUniformMatrix3fvARB,
+    (void*)mglUniformMatrix4fvARB,
+    (void*)mglGetObjectParameterfvARB,
+    (void*)mglGetObjectParameterivARB,
+    (void*)mglGetInfoLogARB,
+    (void*)mglGetAttachedObjectsARB,
+    (void*)mglGetUniformLocationARB,
+    (void*)mglGetActiveUniformARB,
+    (void*)mglGetUniformfvARB,
+    (void*)mglGetUniformivARB,
+    (void*)mglGetShaderSourceARB,
+    (void*)mglIsRenderbuffer,
+    (void*)mglBindRenderbuffer,
+    (void*)mglDeleteRenderbuffers,
+    (void*)mglGenRenderbuffers,
+    (void*)mglRenderbufferStorage,
+    (void*)mglGetRenderbufferParameteriv,
+    (void*)mglIsFramebuffer,
+    (void*)mglBindFramebuffer,
+    (void*)mglDeleteFramebuffers,
+    (void*)mglGenFramebuffers,
+    (void*)mglCheckFramebufferStatus,
+    (void*)mglFramebufferTexture1D,
+    (void*)mglFramebufferTexture2D,
+    (void*)mglFramebufferTexture3D,
+    (void*)mglFramebufferRenderbuffer,
+    (void*)mglGetFramebufferAttachmentParameteriv,
+    (void*)mglGenerateMipmap,
+    (void*)mglBlitFramebuffer,
+    (void*)mglRenderbufferStorageMultisample,
+    (void*)mglFramebufferTextureLayer,
+    (void*)mglGenQueriesARB,
+    (void*)mglDeleteQueriesARB,
+    (void*)mglIsQueryARB,
+    (void*)mglBeginQueryARB,
+    (void*)mglEndQueryARB,
+    (void*)mglGetQueryivARB,
+    (void*)mglGetQueryObjectivARB,
+    (void*)mglGetQueryObjectuivARB,
+    (void*)mglCompressedTexImage3DARB,
+    (void*)mglCompressedTexImage2DARB,
+    (void*)mglCompressedTexImage1DARB,
+    (void*)mglCompressedTexSubImage3DARB,
+    (void*)mglCompressedTexSubImage2DARB,
+    (void*)mglCompressedTexSubImage1DARB,
+    (void*)mglGetCompressedTexImageARB,
+};
+
+const char* dglMockExtensions = "GL_ARB_multitexture GL_EXT_compiled_vertex_array GL_EXT_multi_draw_arrays GL_EXT_fog_coord GL_ARB_vertex_buffer_object GL_ARB_texture_non_power_of_two GL_ARB_texture_env_combine GL_EXT_texture_env_combine GL_EXT_texture_filter_anisotropic GL_ARB_shader_objects GL_ARB_framebuffer_object GL_ARB_occlusion_query GL_EXT_texture_array GL_ARB_texture_compression";
+
+void* dglMockProc(const char* name)
+{
+    int i;
+
+    for(i = 0; i < dglMockNumFuncs; i++)
+    {
+        if(!strcmp(dglMockNames[i], name))
+            return dglMockProcs[i];
+    }
+
+    return NULL;
+}
+
+#endif // USE_MOCK_GLFUNCS
@@ -0,0 +1,1041 @@
+// Emacs style mode select   -*- C++ -*- 
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2007-2012 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+//
+// Generated by dglmake
+//
+#ifndef __DGLMOCK_H__
+#define __DGLMOCK_H__
+
+void* dglMockProc(const char* name);
+
+#undef dglGetString
+#define dglGetString(name) mglGetString(name)
+const GLubyte* APIENTRY mglGetString (GLenum name);
+
+#undef dglAccum
+#define dglAccum(op, value) mglAccum(op, value)
+void APIENTRY mglAccum (GLenum op, GLfloat value);
+#undef dglAlphaFunc
+#define dglAlphaFunc(func, ref) mglAlphaFunc(func, ref)
+void APIENTRY mglAlphaFunc (GLenum func, GLclampf ref);
+#undef dglAreTexturesResident
+#define dglAreTexturesResident(n, textures, residences) mglAreTexturesResident(n, textures, residences)
+GLboolean APIENTRY mglAreTexturesResident (GLsizei n, const GLuint* textures, GLboolean* residences);
+#undef dglArrayElement
+#define dglArrayElement(i) mglArrayElement(i)
+void APIENTRY mglArrayElement (GLint i);
+#undef dglBegin
+#define dglBegin(mode) mglBegin(mode)
+void APIENTRY mglBegin (GLenum mode);
+#undef dglBindTexture
+#define dglBindTexture(target, texture) mglBindTexture(target, texture)
+void APIENTRY mglBindTexture (GLenum target, GLuint texture);
+#undef dglBitmap
+#define dglBitmap(width, height, xorig, yorig, xmove, ymove, bitmap) mglBitmap(width, height, xorig, yorig, xmove, ymove, bitmap)
+void APIENTRY mglBitmap (GLsizei width, GLsizei height, GLfloat xorig, GLfloat yorig, GLfloat xmove, GLfloat ymove, const GLubyte* bitmap);
+#undef dglBlendFunc
+#define dglBlendFunc(sfactor, dfactor) mglBlendFunc(sfactor, dfactor)
+void APIENTRY mglBlendFunc (GLenum sfactor, GLenum dfactor);
+#undef dglCallList
+#define dglCallList(list) mglCallList(list)
+void APIENTRY mglCallList (GLuint list);
+#undef dglCallLists
+#define dglCallLists(n, type, lists) mglCallLists(n, type, lists)
+void APIENTRY mglCallLists (GLsizei n, GLenum type, const GLvoid* lists);
+#undef dglClear
+#define dglClear(mask) mglClear(mask)
+void APIENTRY mglClear (GLbitfield mask);
+#undef dglClearAccum
+#define dglClearAccum(red, green, blue, alpha) mglClearAccum(red, green, blue, alpha)
+void APIENTRY mglClearAccum (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+#undef dglClearColor
+#define dglClearColor(red, green, blue, alpha) mglClearColor(red, green, blue, alpha)
+void APIENTRY mglClearColor (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+#undef dglClearDepth
+#define dglClearDepth(depth) mglClearDepth(depth)
+void APIENTRY mglClearDepth (GLclampd depth);
+#undef dglClearIndex
+#define dglClearIndex(c) mglClearIndex(c)
+void APIENTRY mglClearIndex (GLfloat c);
+#undef dglClearStencil
+#define dglClearStencil(s) mglClearStencil(s)
+void APIENTRY mglClearStencil (GLint s);
+#undef dglClipPlane
+#define dglClipPlane(plane, equation) mglClipPlane(plane, equation)
+void APIENTRY mglClipPlane (GLenum plane, const GLdouble* equation);
+#undef dglColor3b
+#define dglColor3b(red, green, blue) mglColor3b(red, green, blue)
+void APIENTRY mglColor3b (GLbyte red, GLbyte green, GLbyte blue);
+#undef dglColor3bv
+#define dglColor3bv(v) mglColor3bv(v)
+void APIENTRY mglColor3bv (const GLbyte* v);
+#undef dglColor3d
+#define dglColor3d(red, green, blue) mglColor3d(red, green, blue)
+void APIENTRY mglColor3d (GLdouble red, GLdouble green, GLdouble blue);
+#undef dglColor3dv
+#define dglColor3dv(v) mglColor3dv(v)
+void APIENTRY mglColor3dv (const GLdouble* v);
+#undef dglColor3f
+#define dglColor3f(red, green, blue) mglColor3f(red, green, blue)
+void APIENTRY mglColor3f (GLfloat red, GLfloat green, GLfloat blue);
+#undef dglColor3fv
+#define dglColor3fv(v) mglColor3fv(v)
+void APIENTRY mglColor3fv (const GLfloat* v);
+#undef dglColor3i
+#define dglColor3i(red, green, blue) mglColor3i(red, green, blue)
+void APIENTRY mglColor3i (GLint red, GLint green, GLint blue);
+#undef dglColor3iv
+#define dglColor3iv(v) mglColor3iv(v)
+void APIENTRY mglColor3iv (const GLint* v);
+#undef dglColor3s
+#define dglColor3s(red, green, blue) mglColor3s(red, green, blue)
+void APIENTRY mglColor3s (GLshort red, GLshort green, GLshort blue);
+#undef dglColor3sv
+#define dglColor3sv(v) mglColor3sv(v)
+void APIENTRY mglColor3sv (const GLshort* v);
+#undef dglColor3ub
+#define dglColor3ub(red, green, blue) mglColor3ub(red, green, blue)
+void APIENTRY mglColor3ub (GLubyte red, GLubyte green, GLubyte blue);
+#undef dglColor3ubv
+#define dglColor3ubv(v) mglColor3ubv(v)
+void APIENTRY mglColor3ubv (const GLubyte* v);
+#undef dglColor3ui
+#define dglColor3ui(red, green, blue) mglColor3ui(red, green, blue)
+void APIENTRY mglColor3ui (GLuint red, GLuint green, GLuint blue);
+#undef dglColor3uiv
+#define dglColor3uiv(v) mglColor3uiv(v)
+void APIENTRY mglColor3uiv (const GLuint* v);
+#undef dglColor3us
+#define dglColor3us(red, green, blue) mglColor3us(red, green, blue)
+void APIENTRY mglColor3us (GLushort red, GLushort green, GLushort blue);
+#undef dglColor3usv
+#define dglColor3usv(v) mglColor3usv(v)
+void APIENTRY mglColor3usv (const GLushort* v);
+#undef dglColor4b
+#define dglColor4b(red, green, blue, alpha) mglColor4b(red, green, blue, alpha)
+void APIENTRY mglColor4b (GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha);
+#undef dglColor4bv
+#define dglColor4bv(v) mglColor4bv(v)
+void APIENTRY mglColor4bv (const GLbyte* v);
+#undef dglColor4d
+#define dglColor4d(red, green, blue, alpha) mglColor4d(red, green, blue, alpha)
+void APIENTRY mglColor4d (GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha);
+#undef dglColor4dv
+#define dglColor4dv(v) mglColor4dv(v)
+void APIENTRY mglColor4dv (const GLdouble* v);
+#undef dglColor4f
+#define dglColor4f(red, green, blue, alpha) mglColor4f(red, green, blue, alpha)
+void APIENTRY mglColor4f (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+#undef dglColor4fv
+#define dglColor4fv(v) mglColor4fv(v)
+void APIENTRY mglColor4fv (const GLfloat* v);
+#undef dglColor4i
+#define dglColor4i(red, green, blue, alpha) mglColor4i(red, green, blue, alpha)
+void APIENTRY mglColor4i (GLint red, GLint green, GLint blue, GLint alpha);
+#undef dglColor4iv
+#define dglColor4iv(v) mglColor4iv(v)
+void APIENTRY mglColor4iv (const GLint* v);
+#undef dglColor4s
+#define dglColor4s(red, green, blue, alpha) mglColor4s(red, green, blue, alpha)
+void APIENTRY mglColor4s (GLshort red, GLshort green, GLshort blue, GLshort alpha);
+#undef dglColor4sv
+#define dglColor4sv(v) mglColor4sv(v)
+void APIENTRY mglColor4sv (const GLshort* v);
+#undef dglColor4ub
+#define dglColor4ub(red, green, blue, alpha) mglColor4ub(red, green, blue, alpha)
+void APIENTRY mglColor4ub (GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha);
+#undef dglColor4ubv
+#define dglColor4ubv(v) mglColor4ubv(v)
+void APIENTRY mglColor4ubv (const GLubyte* v);
+#undef dglColor4ui
+#define dglColor4ui(red, green, blue, alpha) mglColor4ui(red, green, blue, alpha)
+void APIENTRY mglColor4ui (GLuint red, GLuint green, GLuint blue, GLuint alpha);
+#undef dglColor4uiv
+#define dglColor4uiv(v) mglColor4uiv(v)
+void APIENTRY mglColor4uiv (const GLuint* v);
+#undef dglColor4us
+#define dglColor4us(red, green, blue, alpha) mglColor4us(red, green, blue, alpha)
+void APIENTRY mglColor4us (GLushort red, GLushort green, GLushort blue, GLushort alpha);
+#undef dglColor4usv
+#define dglColor4usv(v) mglColor4usv(v)
+void APIENTRY mglColor4usv (const GLushort* v);
+#undef dglColorMask
+#define dglColorMask(red, green, blue, alpha) mglColorMask(red, green, blue, alpha)
+void APIENTRY mglColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+#undef dglColorMaterial
+#define dglColorMaterial(face, mode) mglColorMaterial(face, mode)
+void APIENTRY mglColorMaterial (GLenum face, GLenum mode);
+#undef dglColorPointer
+#define dglColorPointer(size, type, stride, pointer) mglColorPointer(size, type, stride, pointer)
+void APIENTRY mglColorPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer);
+#undef dglCopyPixels
+#define dglCopyPixels(x, y, width, height, type) mglCopyPixels(x, y, width, height, type)
+void APIENTRY mglCopyPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum type);
+#undef dglCopyTexImage1D
+#define dglCopyTexImage1D(target, level, internalFormat, x, y, width, border) mglCopyTexImage1D(target, level, internalFormat, x, y, width, border)
+void APIENTRY mglCopyTexImage1D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLint border);
+#undef dglCopyTexImage2D
+#define dglCopyTexImage2D(target, level, internalFormat, x, y, width, height, border) mglCopyTexImage2D(target, level, internalFormat, x, y, width, height, border)
+void APIENTRY mglCopyTexImage2D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+#undef dglCopyTexSubImage1D
+#define dglCopyTexSubImage1D(target, level, xoffset, x, y, width) mglCopyTexSubImage1D(target, level, xoffset, x, y, width)
+void APIENTRY mglCopyTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width);
+#undef dglCopyTexSubImage2D
+#define dglCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height) mglCopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height)
+void APIENTRY mglCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+#undef dglCullFace
+#define dglCullFace(mode) mglCullFace(mode)
+void APIENTRY mglCullFace (GLenum mode);
+#undef dglDeleteLists
+#define dglDeleteLists(list, range) mglDeleteLists(list, range)
+void APIENTRY mglDeleteLists (GLuint list, GLsizei range);
+#undef dglDeleteTextures
+#define dglDeleteTextures(n, textures) mglDeleteTextures(n, textures)
+void APIENTRY mglDeleteTextures (GLsizei n, const GLuint* textures);
+#undef dglDepthFunc
+#define dglDepthFunc(func) mglDepthFunc(func)
+void APIENTRY mglDepthFunc (GLenum func);
+#undef dglDepthMask
+#define dglDepthMask(flag) mglDepthMask(flag)
+void APIENTRY mglDepthMask (GLboolean flag);
+#undef dglDepthRange
+#define dglDepthRange(zNear, zFar) mglDepthRange(zNear, zFar)
+void APIENTRY mglDepthRange (GLclampd zNear, GLclampd zFar);
+#undef dglDisable
+#define dglDisable(cap) mglDisable(cap)
+void APIENTRY mglDisable (GLenum cap);
+#undef dglDisableClientState
+#define dglDisableClientState(array) mglDisableClientState(array)
+void APIENTRY mglDisableClientState (GLenum array);
+#undef dglDrawArrays
+#define dglDrawArrays(mode, first, count) mglDrawArrays(mode, first, count)
+void APIENTRY mglDrawArrays (GLenum mode, GLint first, GLsizei count);
+#undef dglDrawBuffer
+#define dglDrawBuffer(mode) mglDrawBuffer(mode)
+void APIENTRY mglDrawBuffer (GLenum mode);
+#undef dglDrawElements
+#define dglDrawElements(mode, count, type, indices) mglDrawElements(mode, count, type, indices)
+void APIENTRY mglDrawElements (GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+#undef dglDrawPixels
+#define dglDrawPixels(width, height, format, type, pixels) mglDrawPixels(width, height, format, type, pixels)
+void APIENTRY mglDrawPixels (GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels);
+#undef dglEdgeFlag
+#define dglEdgeFlag(flag) mglEdgeFlag(flag)
+void APIENTRY mglEdgeFlag (GLboolean flag);
+#undef dglEdgeFlagPointer
+#define dglEdgeFlagPointer(stride, pointer) mglEdgeFlagPointer(stride, pointer)
+void APIENTRY mglEdgeFlagPointer (GLsizei stride, const GLvoid* pointer);
+#undef dglEdgeFlagv
+#define dglEdgeFlagv(flag) mglEdgeFlagv(flag)
+void APIENTRY mglEdgeFlagv (const GLboolean* flag);
+#undef dglEnable
+#define dglEnable(cap) mglEnable(cap)
+void APIENTRY mglEnable (GLenum cap);
+#undef dglEnableClientState
+#define dglEnableClientState(array) mglEnableClientState(array)
+void APIENTRY mglEnableClientState (GLenum array);
+#undef dglEnd
+#define dglEnd() mglEnd()
+void APIENTRY mglEnd (void);
+#undef dglEndList
+#define dglEndList() mglEndList()
+void APIENTRY mglEndList (void);
+#undef dglEvalCoord1d
+#define dglEvalCoord1d(u) mglEvalCoord1d(u)
+void APIENTRY mglEvalCoord1d (GLdouble u);
+#undef dglEvalCoord1dv
+#define dglEvalCoord1dv(u) mglEvalCoord1dv(u)
+void APIENTRY mglEvalCoord1dv (const GLdouble* u);
+#undef dglEvalCoord1f
+#define dglEvalCoord1f(u) mglEvalCoord1f(u)
+void APIENTRY mglEvalCoord1f (GLfloat u);
+#undef dglEvalCoord1fv
+#define dglEvalCoord1fv(u) mglEvalCoord1fv(u)
+void APIENTRY mglEvalCoord1fv (const GLfloat* u);
+#undef dglEvalCoord2d
+#define dglEvalCoord2d(u, v) mglEvalCoord2d(u, v)
+void APIENTRY mglEvalCoord2d (GLdouble u, GLdouble v);
+#undef dglEvalCoord2dv
+#define dglEvalCoord2dv(u) mglEvalCoord2dv(u)
+void APIENTRY mglEvalCoord2dv (const GLdouble* u);
+#undef dglEvalCoord2f
+#define dglEvalCoord2f(u, v) mglEvalCoord2f(u, v)
+void APIENTRY mglEvalCoord2f (GLfloat u, GLfloat v);
+#undef dglEvalCoord2fv
+#define dglEvalCoord2fv(u) mglEvalCoord2fv(u)
+void APIENTRY mglEvalCoord2fv (const GLfloat* u);
+#undef dglEvalMesh1
+#define dglEvalMesh1(mode, i1, i2) mglEvalMesh1(mode, i1, i2)
+void APIENTRY mglEvalMesh1 (GLenum mode, GLint i1, GLint i2);
+#undef dglEvalMesh2
+#define dglEvalMesh2(mode, i1, i2, j1, j2) mglEvalMesh2(mode, i1, i2, j1, j2)
+void APIENTRY mglEvalMesh2 (GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2);
+#undef dglEvalPoint1
+#define dglEvalPoint1(i) mglEvalPoint1(i)
+void APIENTRY mglEvalPoint1 (GLint i);
+#undef dglEvalPoint2
+#define dglEvalPoint2(i, j) mglEvalPoint2(i, j)
+void APIENTRY mglEvalPoint2 (GLint i, GLint j);
+#undef dglFeedbackBuffer
+#define dglFeedbackBuffer(size, type, buffer) mglFeedbackBuffer(size, type, buffer)
+void APIENTRY mglFeedbackBuffer (GLsizei size, GLenum type, GLfloat* buffer);
+#undef dglFinish
+#define dglFinish() mglFinish()
+void APIENTRY mglFinish (void);
+#undef dglFlush
+#define dglFlush() mglFlush()
+void APIENTRY mglFlush (void);
+#undef dglFogf
+#define dglFogf(pname, param) mglFogf(pname, param)
+void APIENTRY mglFogf (GLenum pname, GLfloat param);
+#undef dglFogfv
+#define dglFogfv(pname, params) mglFogfv(pname, params)
+void APIENTRY mglFogfv (GLenum pname, const GLfloat* params);
+#undef dglFogi
+#define dglFogi(pname, param) mglFogi(pname, param)
+void APIENTRY mglFogi (GLenum pname, GLint param);
+#undef dglFogiv
+#define dglFogiv(pname, params) mglFogiv(pname, params)
+void APIENTRY mglFogiv (GLenum pname, const GLint* params);
+#undef dglFrontFace
+#define dglFrontFace(mode) mglFrontFace(mode)
+void APIENTRY mglFrontFace (GLenum mode);
+#undef dglFrustum
+#define dglFrustum(left, right, bottom, top, zNear, zFar) mglFrustum(left, right, bottom, top, zNear, zFar)
+void APIENTRY mglFrustum (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar);
+#undef dglGenLists
+#define dglGenLists(range) mglGenLists(range)
+GLuint APIENTRY mglGenLists (GLsizei range);
+#undef dglGenTextures
+#define dglGenTextures(n, textures) mglGenTextures(n, textures)
+void APIENTRY mglGenTextures (GLsizei n, GLuint* textures);
+#undef dglGetBooleanv
+#define dglGetBooleanv(pname, params) mglGetBooleanv(pname, params)
+void APIENTRY mglGetBooleanv (GLenum pname, GLboolean* params);
+#undef dglGetClipPlane
+#define dglGetClipPlane(plane, equation) mglGetClipPlane(plane, equation)
+void APIENTRY mglGetClipPlane (GLenum plane, GLdouble* equation);
+#undef dglGetDoublev
+#define dglGetDoublev(pname, params) mglGetDoublev(pname, params)
+void APIENTRY mglGetDoublev (GLenum pname, GLdouble* params);
+#undef dglGetError
+#define dglGetError() mglGetError()
+GLenum APIENTRY mglGetError (void);
+#undef dglGetFloatv
+#define dglGetFloatv(pname, params) mglGetFloatv(pname, params)
+void APIENTRY mglGetFloatv (GLenum pname, GLfloat* params);
+#undef dglGetIntegerv
+#define dglGetIntegerv(pname, params) mglGetIntegerv(pname, params)
+void APIENTRY mglGetIntegerv (GLenum pname, GLint* params);
+#undef dglGetLightfv
+#define dglGetLightfv(light, pname, params) mglGetLightfv(light, pname, params)
+void APIENTRY mglGetLightfv (GLenum light, GLenum pname, GLfloat* params);
+#undef dglGetLightiv
+#define dglGetLightiv(light, pname, params) mglGetLightiv(light, pname, params)
+void APIENTRY mglGetLightiv (GLenum light, GLenum pname, GLint* params);
+#undef dglGetMapdv
+#define dglGetMapdv(target, query, v) mglGetMapdv(target, query, v)
+void APIENTRY mglGetMapdv (GLenum target, GLenum query, GLdouble* v);
+#undef dglGetMapfv
+#define dglGetMapfv(target, query, v) mglGetMapfv(target, query, v)
+void APIENTRY mglGetMapfv (GLenum target, GLenum query, GLfloat* v);
+#undef dglGetMapiv
+#define dglGetMapiv(target, query, v) mglGetMapiv(target, query, v)
+void APIENTRY mglGetMapiv (GLenum target, GLenum query, GLint* v);
+#undef dglGetMaterialfv
+#define dglGetMaterialfv(face, pname, params) mglGetMaterialfv(face, pname, params)
+void APIENTRY mglGetMaterialfv (GLenum face, GLenum pname, GLfloat* params);
+#undef dglGetMaterialiv
+#define dglGetMaterialiv(face, pname, params) mglGetMaterialiv(face, pname, params)
+void APIENTRY mglGetMaterialiv (GLenum face, GLenum pname, GLint* params);
+#undef dglGetPixelMapfv
+#define dglGetPixelMapfv(map, values) mglGetPixelMapfv(map, values)
+void APIENTRY mglGetPixelMapfv (GLenum map, GLfloat* values);
+#undef dglGetPixelMapuiv
+#define dglGetPixelMapuiv(map, values) mglGetPixelMapuiv(map, values)
+void APIENTRY mglGetPixelMapuiv (GLenum map, GLuint* values);
+#undef dglGetPixelMapusv
+#define dglGetPixelMapusv(map, values) mglGetPixelMapusv(map, values)
+void APIENTRY mglGetPixelMapusv (GLenum map, GLushort* values);
+#undef dglGetPointerv
+#define dglGetPointerv(pname, params) mglGetPointerv(pname, params)
+void APIENTRY mglGetPointerv (GLenum pname, void* params);
+#undef dglGetPolygonStipple
+#define dglGetPolygonStipple(mask) mglGetPolygonStipple(mask)
+void APIENTRY mglGetPolygonStipple (GLubyte* mask);
+#undef dglGetTexEnvfv
+#define dglGetTexEnvfv(target, pname, params) mglGetTexEnvfv(target, pname, params)
+void APIENTRY mglGetTexEnvfv (GLenum target, GLenum pname, GLfloat* params);
+#undef dglGetTexEnviv
+#define dglGetTexEnviv(target, pname, params) mglGetTexEnviv(target, pname, params)
+void APIENTRY mglGetTexEnviv (GLenum target, GLenum pname, GLint* params);
+#undef dglGetTexGendv
+#define dglGetTexGendv(coord, pname, params) mglGetTexGendv(coord, pname, params)
+void APIENTRY mglGetTexGendv (GLenum coord, GLenum pname, GLdouble* params);
+#undef dglGetTexGenfv
+#define dglGetTexGenfv(coord, pname, params) mglGetTexGenfv(coord, pname, params)
+void APIENTRY mglGetTexGenfv (GLenum coord, GLenum pname, GLfloat* params);
+#undef dglGetTexGeniv
+#define dglGetTexGeniv(coord, pname, params) mglGetTexGeniv(coord, pname, params)
+void APIENTRY mglGetTexGeniv (GLenum coord, GLenum pname, GLint* params);
+#undef dglGetTexImage
+#define dglGetTexImage(target, level, format, type, pixels) mglGetTexImage(target, level, format, type, pixels)
+void APIENTRY mglGetTexImage (GLenum target, GLint level, GLenum format, GLenum type, GLvoid* pixels);
+#undef dglGetTexLevelParameterfv
+#define dglGetTexLevelParameterfv(target, level, pname, params) mglGetTexLevelParameterfv(target, level, pname, params)
+void APIENTRY mglGetTexLevelParameterfv (GLenum target, GLint level, GLenum pname, GLfloat* params);
+#undef dglGetTexLevelParameteriv
+#define dglGetTexLevelParameteriv(target, level, pname, params) mglGetTexLevelParameteriv(target, level, pname, params)
+void APIENTRY mglGetTexLevelParameteriv (GLenum target, GLint level, GLenum pname, GLint* params);
+#undef dglGetTexParameterfv
+#define dglGetTexParameterfv(target, pname, params) mglGetTexParameterfv(target, pname, params)
+void APIENTRY mglGetTexParameterfv (GLenum target, GLenum pname, GLfloat* params);
+#undef dglGetTexParameteriv
+#define dglGetTexParameteriv(target, pname, params) mglGetTexParameteriv(target, pname, params)
+void APIENTRY mglGetTexParameteriv (GLenum target, GLenum pname, GLint* params);
+#undef dglHint
+#define dglHint(target, mode) mglHint(target, mode)
+void APIENTRY mglHint (GLenum target, GLenum mode);
+#undef dglIndexMask
+#define dglIndexMask(mask) mglIndexMask(mask)
+void APIENTRY mglIndexMask (GLuint mask);
+#undef dglIndexPointer
+#define dglIndexPointer(type, stride, pointer) mglIndexPointer(type, stride, pointer)
+void APIENTRY mglIndexPointer (GLenum type, GLsizei stride, const GLvoid* pointer);
+#undef dglIndexd
+#define dglIndexd(c) mglIndexd(c)
+void APIENTRY mglIndexd (GLdouble c);
+#undef dglIndexdv
+#define dglIndexdv(c) mglIndexdv(c)
+void APIENTRY mglIndexdv (const GLdouble* c);
+#undef dglIndexf
+#define dglIndexf(c) mglIndexf(c)
+void APIENTRY mglIndexf (GLfloat c);
+#undef dglIndexfv
+#define dglIndexfv(c) mglIndexfv(c)
+void APIENTRY mglIndexfv (const GLfloat* c);
+#undef dglIndexi
+#define dglIndexi(c) mglIndexi(c)
+void APIENTRY mglIndexi (GLint c);
+#undef dglIndexiv
+#define dglIndexiv(c) mglIndexiv(c)
+void APIENTRY mglIndexiv (const GLint* c);
+#undef dglIndexs
+#define dglIndexs(c) mglIndexs(c)
+void APIENTRY mglIndexs (GLshort c);
+#undef dglIndexsv
+#define dglIndexsv(c) mglIndexsv(c)
+void APIENTRY mglIndexsv (const GLshort* c);
+#undef dglIndexub
+#define dglIndexub(c) mglIndexub(c)
+void APIENTRY mglIndexub (GLubyte c);
+#undef dglIndexubv
+#define dglIndexubv(c) mglIndexubv(c)
+void APIENTRY mglIndexubv (const GLubyte* c);
+#undef dglInitNames
+#define dglInitNames() mglInitNames()
+void APIENTRY mglInitNames (void);
+#undef dglInterleavedArrays
+#define dglInterleavedArrays(format, stride, pointer) mglInterleavedArrays(format, stride, pointer)
+void APIENTRY mglInterleavedArrays (GLenum format, GLsizei stride, const GLvoid* pointer);
+#undef dglIsEnabled
+#define dglIsEnabled(cap) mglIsEnabled(cap)
+GLboolean APIENTRY mglIsEnabled (GLenum cap);
+#undef dglIsList
+#define dglIsList(list) mglIsList(list)
+GLboolean APIENTRY mglIsList (GLuint list);
+#undef dglIsTexture
+#define dglIsTexture(texture) mglIsTexture(texture)
+GLboolean APIENTRY mglIsTexture (GLuint texture);
+#undef dglLightModelf
+#define dglLightModelf(pname, param) mglLightModelf(pname, param)
+void APIENTRY mglLightModelf (GLenum pname, GLfloat param);
+#undef dglLightModelfv
+#define dglLightModelfv(pname, params) mglLightModelfv(pname, params)
+void APIENTRY mglLightModelfv (GLenum pname, const GLfloat* params);
+#undef dglLightModeli
+#define dglLightModeli(pname, param) mglLightModeli(pname, param)
+void APIENTRY mglLightModeli (GLenum pname, GLint param);
+#undef dglLightModeliv
+#define dglLightModeliv(pname, params) mglLightModeliv(pname, params)
+void APIENTRY mglLightModeliv (GLenum pname, const GLint* params);
+#undef dglLightf
+#define dglLightf(light, pname, param) mglLightf(light, pname, param)
+void APIENTRY mglLightf (GLenum light, GLenum pname, GLfloat param);
+#undef dglLightfv
+#define dglLightfv(light, pname, params) mglLightfv(light, pname, params)
+void APIENTRY mglLightfv (GLenum light, GLenum pname, const GLfloat* params);
+#undef dglLighti
+#define dglLighti(light, pname, param) mglLighti(light, pname, param)
+void APIENTRY mglLighti (GLenum light, GLenum pname, GLint param);
+#undef dglLightiv
+#define dglLightiv(light, pname, params) mglLightiv(light, pname, params)
+void APIENTRY mglLightiv (GLenum light, GLenum pname, const GLint* params);
+#undef dglLineStipple
+#define dglLineStipple(factor, pattern) mglLineStipple(factor, pattern)
+void APIENTRY mglLineStipple (GLint factor, GLushort pattern);
+#undef dglLineWidth
+#define dglLineWidth(width) mglLineWidth(width)
+void APIENTRY mglLineWidth (GLfloat width);
+#undef dglListBase
+#define dglListBase(base) mglListBase(base)
+void APIENTRY mglListBase (GLuint base);
+#undef dglLoadIdentity
+#define dglLoadIdentity() mglLoadIdentity()
+void APIENTRY mglLoadIdentity (void);
+#undef dglLoadMatrixd
+#define dglLoadMatrixd(m) mglLoadMatrixd(m)
+void APIENTRY mglLoadMatrixd (const GLdouble* m);
+#undef dglLoadMatrixf
+#define dglLoadMatrixf(m) mglLoadMatrixf(m)
+void APIENTRY mglLoadMatrixf (const GLfloat* m);
+#undef dglLoadName
+#define dglLoadName(name) mglLoadName(name)
+void APIENTRY mglLoadName (GLuint name);
+#undef dglLogicOp
+#define dglLogicOp(opcode) mglLogicOp(opcode)
+void APIENTRY mglLogicOp (GLenum opcode);
+#undef dglMap1d
+#define dglMap1d(target, u1, u2, stride, order, points) mglMap1d(target, u1, u2, stride, order, points)
+void APIENTRY mglMap1d (GLenum target, GLdouble u1, GLdouble u2, GLint stride, GLint order, const GLdouble* points);
+#undef dglMap1f
+#define dglMap1f(target, u1, u2, stride, order, points) mglMap1f(target, u1, u2, stride, order, points)
+void APIENTRY mglMap1f (GLenum target, GLfloat u1, GLfloat u2, GLint stride, GLint order, const GLfloat* points);
+#undef dglMap2d
+#define dglMap2d(target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points) mglMap2d(target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points)
+void APIENTRY mglMap2d (GLenum target, GLdouble u1, GLdouble u2, GLint ustride, GLint uorder, GLdouble v1, GLdouble v2, GLint vstride, GLint vorder, const GLdouble* points);
+#undef dglMap2f
+#define dglMap2f(target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points) mglMap2f(target, u1, u2, ustride, uorder, v1, v2, vstride, vorder, points)
+void APIENTRY mglMap2f (GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat* points);
+#undef dglMapGrid1d
+#define dglMapGrid1d(un, u1, u2) mglMapGrid1d(un, u1, u2)
+void APIENTRY mglMapGrid1d (GLint un, GLdouble u1, GLdouble u2);
+#undef dglMapGrid1f
+#define dglMapGrid1f(un, u1, u2) mglMapGrid1f(un, u1, u2)
+void APIENTRY mglMapGrid1f (GLint un, GLfloat u1, GLfloat u2);
+#undef dglMapGrid2d
+#define dglMapGrid2d(un, u1, u2, vn, v1, v2) mglMapGrid2d(un, u1, u2, vn, v1, v2)
+void APIENTRY mglMapGrid2d (GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2);
+#undef dglMapGrid2f
+#define dglMapGrid2f(un, u1, u2, vn, v1, v2) mglMapGrid2f(un, u1, u2, vn, v1, v2)
+void APIENTRY mglMapGrid2f (GLint un, GLfloat u1, GLfloat u2, GLint vn, GLfloat v1, GLfloat v2);
+#undef dglMaterialf
+#define dglMaterialf(face, pname, param) mglMaterialf(face, pname, param)
+void APIENTRY mglMaterialf (GLenum face, GLenum pname, GLfloat param);
+#undef dglMaterialfv
+#define dglMaterialfv(face, pname, params) mglMaterialfv(face, pname, params)
+void APIENTRY mglMaterialfv (GLenum face, GLenum pname, const GLfloat* params);
+#undef dglMateriali
+#define dglMateriali(face, pname, param) mglMateriali(face, pname, param)
+void APIENTRY mglMateriali (GLenum face, GLenum pname, GLint param);
+#undef dglMaterialiv
+#define dglMaterialiv(face, pname, params) mglMaterialiv(face, pname, params)
+void APIENTRY mglMaterialiv (GLenum face, GLenum pname, const GLint* params);
+#undef dglMatrixMode
+#define dglMatrixMode(mode) mglMatrixMode(mode)
+void APIENTRY mglMatrixMode (GLenum mode);
+#undef dglMultMatrixd
+#define dglMultMatrixd(m) mglMultMatrixd(m)
+void APIENTRY mglMultMatrixd (const GLdouble* m);
+#undef dglMultMatrixf
+#define dglMultMatrixf(m) mglMultMatrixf(m)
+void APIENTRY mglMultMatrixf (const GLfloat* m);
+#undef dglNewList
+#define dglNewList(list, mode) mglNewList(list, mode)
+void APIENTRY mglNewList (GLuint list, GLenum mode);
+#undef dglNormal3b
+#define dglNormal3b(nx, ny, nz) mglNormal3b(nx, ny, nz)
+void APIENTRY mglNormal3b (GLbyte nx, GLbyte ny, GLbyte nz);
+#undef dglNormal3bv
+#define dglNormal3bv(v) mglNormal3bv(v)
+void APIENTRY mglNormal3bv (const GLbyte* v);
+#undef dglNormal3d
+#define dglNormal3d(nx, ny, nz) mglNormal3d(nx, ny, nz)
+void APIENTRY mglNormal3d (GLdouble nx, GLdouble ny, GLdouble nz);
+#undef dglNormal3dv
+#define dglNormal3dv(v) mglNormal3dv(v)
+void APIENTRY mglNormal3dv (const GLdouble* v);
+#undef dglNormal3f
+#define dglNormal3f(nx, ny, nz) mglNormal3f(nx, ny, nz)
+void APIENTRY mglNormal3f (GLfloat nx, GLfloat ny, GLfloat nz);
+#undef dglNormal3fv
+#define dglNormal3fv(v) mglNormal3fv(v)
+void APIENTRY mglNormal3fv (const GLfloat* v);
+#undef dglNormal3i
+#define dglNormal3i(nx, ny, nz) mglNormal3i(nx, ny, nz)
+void APIENTRY mglNormal3i (GLint nx, GLint ny, GLint nz);
+#undef dglNormal3iv
+#define dglNormal3iv(v) mglNormal3iv(v)
+void APIENTRY mglNormal3iv (const GLint* v);
+#undef dglNormal3s
+#define dglNormal3s(nx, ny, nz) mglNormal3s(nx, ny, nz)
+void APIENTRY mglNormal3s (GLshort nx, GLshort ny, GLshort nz);
+#undef dglNormal3sv
+#define dglNormal3sv(v) mglNormal3sv(v)
+void APIENTRY mglNormal3sv (const GLshort* v);
+#undef dglNormalPointer
+#define dglNormalPointer(type, stride, pointer) mglNormalPointer(type, stride, pointer)
+void APIENTRY mglNormalPointer (GLenum type, GLsizei stride, const GLvoid* pointer);
+#undef dglOrtho
+#define dglOrtho(left, right, bottom, top, zNear, zFar) mglOrtho(left, right, bottom, top, zNear, zFar)
+void APIENTRY mglOrtho (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar);
+#undef dglPassThrough
+#define dglPassThrough(token) mglPassThrough(token)
+void APIENTRY mglPassThrough (GLfloat token);
+#undef dglPixelMapfv
+#define dglPixelMapfv(map, mapsize, values) mglPixelMapfv(map, mapsize, values)
+void APIENTRY mglPixelMapfv (GLenum map, GLsizei mapsize, const GLfloat* values);
+#undef dglPixelMapuiv
+#define dglPixelMapuiv(map, mapsize, values) mglPixelMapuiv(map, mapsize, values)
+void APIENTRY mglPixelMapuiv (GLenum map, GLsizei mapsize, const GLuint* values);
+#undef dglPixelMapusv
+#define dglPixelMapusv(map, mapsize, values) mglPixelMapusv(map, mapsize, values)
+void APIENTRY mglPixelMapusv (GLenum map, GLsizei mapsize, const GLushort* values);
+#undef dglPixelStoref
+#define dglPixelStoref(pname, param) mglPixelStoref(pname, param)
+void APIENTRY mglPixelStoref (GLenum pname, GLfloat param);
+#undef dglPixelStorei
+#define dglPixelStorei(pname, param) mglPixelStorei(pname, param)
+void APIENTRY mglPixelStorei (GLenum pname, GLint param);
+#undef dglPixelTransferf
+#define dglPixelTransferf(pname, param) mglPixelTransferf(pname, param)
+void APIENTRY mglPixelTransferf (GLenum pname, GLfloat param);
+#undef dglPixelTransferi
+#define dglPixelTransferi(pname, param) mglPixelTransferi(pname, param)
+void APIENTRY mglPixelTransferi (GLenum pname, GLint param);
+#undef dglPixelZoom
+#define dglPixelZoom(xfactor, yfactor) mglPixelZoom(xfactor, yfactor)
+void APIENTRY mglPixelZoom (GLfloat xfactor, GLfloat yfactor);
+#undef dglPointSize
+#define dglPointSize(size) mglPointSize(size)
+void APIENTRY mglPointSize (GLfloat size);
+#undef dglPolygonMode
+#define dglPolygonMode(face, mode) mglPolygonMode(face, mode)
+void APIENTRY mglPolygonMode (GLenum face, GLenum mode);
+#undef dglPolygonOffset
+#define dglPolygonOffset(factor, units) mglPolygonOffset(factor, units)
+void APIENTRY mglPolygonOffset (GLfloat factor, GLfloat units);
+#undef dglPolygonStipple
+#define dglPolygonStipple(mask) mglPolygonStipple(mask)
+void APIENTRY mglPolygonStipple (const GLubyte* mask);
+#undef dglPopAttrib
+#define dglPopAttrib() mglPopAttrib()
+void APIENTRY mglPopAttrib (void);
+#undef dglPopClientAttrib
+#define dglPopClientAttrib() mglPopClientAttrib()
+void APIENTRY mglPopClientAttrib (void);
+#undef dglPopMatrix
+#define dglPopMatrix() mglPopMatrix()
+void APIENTRY mglPopMatrix (void);
+#undef dglPopName
+#define dglPopName() mglPopName()
+void APIENTRY mglPopName (void);
+#undef dglPrioritizeTextures
+#define dglPrioritizeTextures(n, textures, priorities) mglPrioritizeTextures(n, textures, priorities)
+void APIENTRY mglPrioritizeTextures (GLsizei n, const GLuint* textures, const GLclampf* priorities);
+#undef dglPushAttrib
+#define dglPushAttrib(mask) mglPushAttrib(mask)
+void APIENTRY mglPushAttrib (GLbitfield mask);
+#undef dglPushClientAttrib
+#define dglPushClientAttrib(mask) mglPushClientAttrib(mask)
+void APIENTRY mglPushClientAttrib (GLbitfield mask);
+#undef dglPushMatrix
+#define dglPushMatrix() mglPushMatrix()
+void APIENTRY mglPushMatrix (void);
+#undef dglPushName
+#define dglPushName(name) mglPushName(name)
+void APIENTRY mglPushName (GLuint name);
+#undef dglRasterPos2d
+#define dglRasterPos2d(x, y) mglRasterPos2d(x, y)
+void APIENTRY mglRasterPos2d (GLdouble x, GLdouble y);
+#undef dglRasterPos2dv
+#define dglRasterPos2dv(v) mglRasterPos2dv(v)
+void APIENTRY mglRasterPos2dv (const GLdouble* v);
+#undef dglRasterPos2f
+#define dglRasterPos2f(x, y) mglRasterPos2f(x, y)
+void APIENTRY mglRasterPos2f (GLfloat x, GLfloat y);
+#undef dglRasterPos2fv
+#define dglRasterPos2fv(v) mglRasterPos2fv(v)
+void APIENTRY mglRasterPos2fv (const GLfloat* v);
+#undef dglRasterPos2i
+#define dglRasterPos2i(x, y) mglRasterPos2i(x, y)
+void APIENTRY mglRasterPos2i (GLint x, GLint y);
+#undef dglRasterPos2iv
+#define dglRasterPos2iv(v) mglRasterPos2iv(v)
+void APIENTRY mglRasterPos2iv (const GLint* v);
+#undef dglRasterPos2s
+#define dglRasterPos2s(x, y) mglRasterPos2s(x, y)
+void APIENTRY mglRasterPos2s (GLshort x, GLshort y);
+#undef dglRasterPos2sv
+#define dglRasterPos2sv(v) mglRasterPos2sv(v)
+void APIENTRY mglRasterPos2sv (const GLshort* v);
+#undef dglRasterPos3d
+#define dglRasterPos3d(x, y, z) mglRasterPos3d(x, y, z)
+void APIENTRY mglRasterPos3d (GLdouble x, GLdouble y, GLdouble z);
+#undef dglRasterPos3dv
+#define dglRasterPos3dv(v) mglRasterPos3dv(v)
+void APIENTRY mglRasterPos3dv (const GLdouble* v);
+#undef dglRasterPos3f
+#define dglRasterPos3f(x, y, z) mglRasterPos3f(x, y, z)
+void APIENTRY mglRasterPos3f (GLfloat x, GLfloat y, GLfloat z);
+#undef dglRasterPos3fv
+#define dglRasterPos3fv(v) mglRasterPos3fv(v)
+void APIENTRY mglRasterPos3fv (const GLfloat* v);
+#undef dglRasterPos3i
+#define dglRasterPos3i(x, y, z) mglRasterPos3i(x, y, z)
+void APIENTRY mglRasterPos3i (GLint x, GLint y, GLint z);
+#undef dglRasterPos3iv
+#define dglRasterPos3iv(v) mglRasterPos3iv(v)
+void APIENTRY mglRasterPos3iv (const GLint* v);
+#undef dglRasterPos3s
+#define dglRasterPos3s(x, y, z) mglRasterPos3s(x, y, z)
+void APIENTRY mglRasterPos3s (GLshort x, GLshort y, GLshort z);
+#undef dglRasterPos3sv
+#define dglRasterPos3sv(v) mglRasterPos3sv(v)
+void APIENTRY mglRasterPos3sv (const GLshort* v);
+#undef dglRasterPos4d
+#define dglRasterPos4d(x, y, z, w) mglRasterPos4d(x, y, z, w)
+void APIENTRY mglRasterPos4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w);
+#undef dglRasterPos4dv
+#define dglRasterPos4dv(v) mglRasterPos4dv(v)
+void APIENTRY mglRasterPos4dv (const GLdouble* v);
+#undef dglRasterPos4f
+#define dglRasterPos4f(x, y, z, w) mglRasterPos4f(x, y, z, w)
+void APIENTRY mglRasterPos4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+#undef dglRasterPos4fv
+#define dglRasterPos4fv(v) mglRasterPos4fv(v)
+void APIENTRY mglRasterPos4fv (const GLfloat* v);
+#undef dglRasterPos4i
+#define dglRasterPos4i(x, y, z, w) mglRasterPos4i(x, y, z, w)
+void APIENTRY mglRasterPos4i (GLint x, GLint y, GLint z, GLint w);
+#undef dglRasterPos4iv
+#define dglRasterPos4iv(v) mglRasterPos4iv(v)
+void APIENTRY mglRasterPos4iv (const GLint* v);
+#undef dglRasterPos4s
+#define dglRasterPos4s(x, y, z, w) mglRasterPos4s(x, y, z, w)
+void APIENTRY mglRasterPos4s (GLshort x, GLshort y, GLshort z, GLshort w);
+#undef dglRasterPos4sv
+#define dglRasterPos4sv(v) mglRasterPos4sv(v)
+void APIENTRY mglRasterPos4sv (const GLshort* v);
+#undef dglReadBuffer
+#define dglReadBuffer(mode) mglReadBuffer(mode)
+void APIENTRY mglReadBuffer (GLenum mode);
+#undef dglReadPixels
+#define dglReadPixels(x, y, width, height, format, type, pixels) mglReadPixels(x, y, width, height, format, type, pixels)
+void APIENTRY mglReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels);
+#undef dglRectd
+#define dglRectd(x1, y1, x2, y2) mglRectd(x1, y1, x2, y2)
+void APIENTRY mglRectd (GLdouble x1, GLdouble y1, GLdouble x2, GLdouble y2);
+#undef dglRectdv
+#define dglRectdv(v1, v2) mglRectdv(v1, v2)
+void APIENTRY mglRectdv (const GLdouble* v1, const GLdouble* v2);
+#undef dglRectf
+#define dglRectf(x1, y1, x2, y2) mglRectf(x1, y1, x2, y2)
+void APIENTRY mglRectf (GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
+#undef dglRectfv
+#define dglRectfv(v1, v2) mglRectfv(v1, v2)
+void APIENTRY mglRectfv (const GLfloat* v1, const GLfloat* v2);
+#undef dglRecti
+#define dglRecti(x1, y1, x2, y2) mglRecti(x1, y1, x2, y2)
+void APIENTRY mglRecti (GLint x1, GLint y1, GLint x2, GLint y2);
+#undef dglRectiv
+#define dglRectiv(v1, v2) mglRectiv(v1, v2)
+void APIENTRY mglRectiv (const GLint* v1, const GLint* v2);
+#undef dglRects
+#define dglRects(x1, y1, x2, y2) mglRects(x1, y1, x2, y2)
+void APIENTRY mglRects (GLshort x1, GLshort y1, GLshort x2, GLshort y2);
+#undef dglRectsv
+#define dglRectsv(v1, v2) mglRectsv(v1, v2)
+void APIENTRY mglRectsv (const GLshort* v1, const GLshort* v2);
+#undef dglRenderMode
+#define dglRenderMode(mode) mglRenderMode(mode)
+GLint APIENTRY mglRenderMode (GLenum mode);
+#undef dglRotated
+#define dglRotated(angle, x, y, z) mglRotated(angle, x, y, z)
+void APIENTRY mglRotated (GLdouble angle, GLdouble x, GLdouble y, GLdouble z);
+#undef dglRotatef
+#define dglRotatef(angle, x, y, z) mglRotatef(angle, x, y, z)
+void APIENTRY mglRotatef (GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+#undef dglScaled
+#define dglScaled(x, y, z) mglScaled(x, y, z)
+void APIENTRY mglScaled (GLdouble x, GLdouble y, GLdouble z);
+#undef dglScalef
+#define dglScalef(x, y, z) mglScalef(x, y, z)
+void APIENTRY mglScalef (GLfloat x, GLfloat y, GLfloat z);
+#undef dglScissor
+#define dglScissor(x, y, width, height) mglScissor(x, y, width, height)
+void APIENTRY mglScissor (GLint x, GLint y, GLsizei width, GLsizei height);
+#undef dglSelectBuffer
+#define dglSelectBuffer(size, buffer) mglSelectBuffer(size, buffer)
+void APIENTRY mglSelectBuffer (GLsizei size, GLuint* buffer);
+#undef dglShadeModel
+#define dglShadeModel(mode) mglShadeModel(mode)
+void APIENTRY mglShadeModel (GLenum mode);
+#undef dglStencilFunc
+#define dglStencilFunc(func, ref, mask) mglStencilFunc(func, ref, mask)
+void APIENTRY mglStencilFunc (GLenum func, GLint ref, GLuint mask);
+#undef dglStencilMask
+#define dglStencilMask(mask) mglStencilMask(mask)
+void APIENTRY mglStencilMask (GLuint mask);
+#undef dglStencilOp
+#define dglStencilOp(fail, zfail, zpass) mglStencilOp(fail, zfail, zpass)
+void APIENTRY mglStencilOp (GLenum fail, GLenum zfail, GLenum zpass);
+#undef dglTexCoord1d
+#define dglTexCoord1d(s) mglTexCoord1d(s)
+void APIENTRY mglTexCoord1d (GLdouble s);
+#undef dglTexCoord1dv
+#define dglTexCoord1dv(v) mglTexCoord1dv(v)
+void APIENTRY mglTexCoord1dv (const GLdouble* v);
+#undef dglTexCoord1f
+#define dglTexCoord1f(s) mglTexCoord1f(s)
+void APIENTRY mglTexCoord1f (GLfloat s);
+#undef dglTexCoord1fv
+#define dglTexCoord1fv(v) mglTexCoord1fv(v)
+void APIENTRY mglTexCoord1fv (const GLfloat* v);
+#undef dglTexCoord1i
+#define dglTexCoord1i(s) mglTexCoord1i(s)
+void APIENTRY mglTexCoord1i (GLint s);
+#undef dglTexCoord1iv
+#define dglTexCoord1iv(v) mglTexCoord1iv(v)
+void APIENTRY mglTexCoord1iv (const GLint* v);
+#undef dglTexCoord1s
+#define dglTexCoord1s(s) mglTexCoord1s(s)
+void APIENTRY mglTexCoord1s (GLshort s);
+#undef dglTexCoord1sv
+#define dglTexCoord1sv(v) mglTexCoord1sv(v)
+void APIENTRY mglTexCoord1sv (const GLshort* v);
+#undef dglTexCoord2d
+#define dglTexCoord2d(s, t) mglTexCoord2d(s, t)
+void APIENTRY mglTexCoord2d (GLdouble s, GLdouble t);
+#undef dglTexCoord2dv
+#define dglTexCoord2dv(v) mglTexCoord2dv(v)
+void APIENTRY mglTexCoord2dv (const GLdouble* v);
+#undef dglTexCoord2f
+#define dglTexCoord2f(s, t) mglTexCoord2f(s, t)
+void APIENTRY mglTexCoord2f (GLfloat s, GLfloat t);
+#undef dglTexCoord2fv
+#define dglTexCoord2fv(v) mglTexCoord2fv(v)
+void APIENTRY mglTexCoord2fv (const GLfloat* v);
+#undef dglTexCoord2i
+#define dglTexCoord2i(s, t) mglTexCoord2i(s, t)
+void APIENTRY mglTexCoord2i (GLint s, GLint t);
+#undef dglTexCoord2iv
+#define dglTexCoord2iv(v) mglTexCoord2iv(v)
+void APIENTRY mglTexCoord2iv (const GLint* v);
+#undef dglTexCoord2s
+#define dglTexCoord2s(s, t) mglTexCoord2s(s, t)
+void APIENTRY mglTexCoord2s (GLshort s, GLshort t);
+#undef dglTexCoord2sv
+#define dglTexCoord2sv(v) mglTexCoord2sv(v)
+void APIENTRY mglTexCoord2sv (const GLshort* v);
+#undef dglTexCoord3d
+#define dglTexCoord3d(s, t, r) mglTexCoord3d(s, t, r)
+void APIENTRY mglTexCoord3d (GLdouble s, GLdouble t, GLdouble r);
+#undef dglTexCoord3dv
+#define dglTexCoord3dv(v) mglTexCoord3dv(v)
+void APIENTRY mglTexCoord3dv (const GLdouble* v);
+#undef dglTexCoord3f
+#define dglTexCoord3f(s, t, r) mglTexCoord3f(s, t, r)
+void APIENTRY mglTexCoord3f (GLfloat s, GLfloat t, GLfloat r);
+#undef dglTexCoord3fv
+#define dglTexCoord3fv(v) mglTexCoord3fv(v)
+void APIENTRY mglTexCoord3fv (const GLfloat* v);
+#undef dglTexCoord3i
+#define dglTexCoord3i(s, t, r) mglTexCoord3i(s, t, r)
+void APIENTRY mglTexCoord3i (GLint s, GLint t, GLint r);
+#undef dglTexCoord3iv
+#define dglTexCoord3iv(v) mglTexCoord3iv(v)
+void APIENTRY mglTexCoord3iv (const GLint* v);
+#undef dglTexCoord3s
+#define dglTexCoord3s(s, t, r) mglTexCoord3s(s, t, r)
+void APIENTRY mglTexCoord3s (GLshort s, GLshort t, GLshort r);
+#undef dglTexCoord3sv
+#define dglTexCoord3sv(v) mglTexCoord3sv(v)
+void APIENTRY mglTexCoord3sv (const GLshort* v);
+#undef dglTexCoord4d
+#define dglTexCoord4d(s, t, r, q) mglTexCoord4d(s, t, r, q)
+void APIENTRY mglTexCoord4d (GLdouble s, GLdouble t, GLdouble r, GLdouble q);
+#undef dglTexCoord4dv
+#define dglTexCoord4dv(v) mglTexCoord4dv(v)
+void APIENTRY mglTexCoord4dv (const GLdouble* v);
+#undef dglTexCoord4f
+#define dglTexCoord4f(s, t, r, q) mglTexCoord4f(s, t, r, q)
+void APIENTRY mglTexCoord4f (GLfloat s, GLfloat t, GLfloat r, GLfloat q);
+#undef dglTexCoord4fv
+#define dglTexCoord4fv(v) mglTexCoord4fv(v)
+void APIENTRY mglTexCoord4fv (const GLfloat* v);
+#undef dglTexCoord4i
+#define dglTexCoord4i(s, t, r, q) mglTexCoord4i(s, t, r, q)
+void APIENTRY mglTexCoord4i (GLint s, GLint t, GLint r, GLint q);
+#undef dglTexCoord4iv
+#define dglTexCoord4iv(v) mglTexCoord4iv(v)
+void APIENTRY mglTexCoord4iv (const GLint* v);
+#undef dglTexCoord4s
+#define dglTexCoord4s(s, t, r, q) mglTexCoord4s(s, t, r, q)
+void APIENTRY mglTexCoord4s (GLshort s, GLshort t, GLshort r, GLshort q);
+#undef dglTexCoord4sv
+#define dglTexCoord4sv(v) mglTexCoord4sv(v)
+void APIENTRY mglTexCoord4sv (const GLshort* v);
+#undef dglTexCoordPointer
+#define dglTexCoordPointer(size, type, stride, pointer) mglTexCoordPointer(size, type, stride, pointer)
+void APIENTRY mglTexCoordPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer);
+#undef dglTexEnvf
+#define dglTexEnvf(target, pname, param) mglTexEnvf(target, pname, param)
+void APIENTRY mglTexEnvf (GLenum target, GLenum pname, GLfloat param);
+#undef dglTexEnvfv
+#define dglTexEnvfv(target, pname, params) mglTexEnvfv(target, pname, params)
+void APIENTRY mglTexEnvfv (GLenum target, GLenum pname, const GLfloat* params);
+#undef dglTexEnvi
+#define dglTexEnvi(target, pname, param) mglTexEnvi(target, pname, param)
+void APIENTRY mglTexEnvi (GLenum target, GLenum pname, GLint param);
+#undef dglTexEnviv
+#define dglTexEnviv(target, pname, params) mglTexEnviv(target, pname, params)
+void APIENTRY mglTexEnviv (GLenum target, GLenum pname, const GLint* params);
+#undef dglTexGend
+#define dglTexGend(coord, pname, param) mglTexGend(coord, pname, param)
+void APIENTRY mglTexGend (GLenum coord, GLenum pname, GLdouble param);
+#undef dglTexGendv
+#define dglTexGendv(coord, pname, params) mglTexGendv(coord, pname, params)
+void APIENTRY mglTexGendv (GLenum coord, GLenum pname, const GLdouble* params);
+#undef dglTexGenf
+#define dglTexGenf(coord, pname, param) mglTexGenf(coord, pname, param)
+void APIENTRY mglTexGenf (GLenum coord, GLenum pname, GLfloat param);
+#undef dglTexGenfv
+#define dglTexGenfv(coord, pname, params) mglTexGenfv(coord, pname, params)
+void APIENTRY mglTexGenfv (GLenum coord, GLenum pname, const GLfloat* params);
+#undef dglTexGeni
+#define dglTexGeni(coord, pname, param) mglTexGeni(coord, pname, param)
+void APIENTRY mglTexGeni (GLenum coord, GLenum pname, GLint param);
+#undef dglTexGeniv
+#define dglTexGeniv(coord, pname, params) mglTexGeniv(coord, pname, params)
+void APIENTRY mglTexGeniv (GLenum coord, GLenum pname, const GLint* params);
+#undef dglTexImage1D
+#define dglTexImage1D(target, level, internalformat, width, border, format, type, pixels) mglTexImage1D(target, level, internalformat, width, border, format, type, pixels)
+void APIENTRY mglTexImage1D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+#undef dglTexImage2D
+#define dglTexImage2D(target, level, internalformat, width, height, border, format, type, pixels) mglTexImage2D(target, level, internalformat, width, height, border, format, type, pixels)
+void APIENTRY mglTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+#undef dglTexParameterf
+#define dglTexParameterf(target, pname, param) mglTexParameterf(target, pname, param)
+void APIENTRY mglTexParameterf (GLenum target, GLenum pname, GLfloat param);
+#undef dglTexParameterfv
+#define dglTexParameterfv(target, pname, params) mglTexParameterfv(target, pname, params)
+void APIENTRY mglTexParameterfv (GLenum target, GLenum pname, const GLfloat* params);
+#undef dglTexParameteri
+#define dglTexParameteri(target, pname, param) mglTexParameteri(target, pname, param)
+void APIENTRY mglTexParameteri (GLenum target, GLenum pname, GLint param);
+#undef dglTexParameteriv
+#define dglTexParameteriv(target, pname, params) mglTexParameteriv(target, pname, params)
+void APIENTRY mglTexParameteriv (GLenum target, GLenum pname, const GLint* params);
+#undef dglTexSubImage1D
+#define dglTexSubImage1D(target, level, xoffset, width, format, type, pixels) mglTexSubImage1D(target, level, xoffset, width, format, type, pixels)
+void APIENTRY mglTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid* pixels);
+#undef dglTexSubImage2D
+#define dglTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels) mglTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels)
+void APIENTRY mglTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels);
+#undef dglTranslated
+#define dglTranslated(x, y, z) mglTranslated(x, y, z)
+void APIENTRY mglTranslated (GLdouble x, GLdouble y, GLdouble z);
+#undef dglTranslatef
+#define dglTranslatef(x, y, z) mglTranslatef(x, y, z)
+void APIENTRY mglTranslatef (GLfloat x, GLfloat y, GLfloat z);
+#undef dglVertex2d
+#define dglVertex2d(x, y) mglVertex2d(x, y)
+void APIENTRY mglVertex2d (GLdouble x, GLdouble y);
+#undef dglVertex2dv
+#define dglVertex2dv(v) mglVertex2dv(v)
+void APIENTRY mglVertex2dv (const GLdouble* v);
+#undef dglVertex2f
+#define dglVertex2f(x, y) mglVertex2f(x, y)
+void APIENTRY mglVertex2f (GLfloat x, GLfloat y);
+#undef dglVertex2fv
+#define dglVertex2fv(v) mglVertex2fv(v)
+void APIENTRY mglVertex2fv (const GLfloat* v);
+#undef dglVertex2i
+#define dglVertex2i(x, y) mglVertex2i(x, y)
+void APIENTRY mglVertex2i (GLint x, GLint y);
+#undef dglVertex2iv
+#define dglVertex2iv(v) mglVertex2iv(v)
+void APIENTRY mglVertex2iv (const GLint* v);
+#undef dglVertex2s
+#define dglVertex2s(x, y) mglVertex2s(x, y)
+void APIENTRY mglVertex2s (GLshort x, GLshort y);
+#undef dglVertex2sv
+#define dglVertex2sv(v) mglVertex2sv(v)
+void APIENTRY mglVertex2sv (const GLshort* v);
+#undef dglVertex3d
+#define dglVertex3d(x, y, z) mglVertex3d(x, y, z)
+void APIENTRY mglVertex3d (GLdouble x, GLdouble y, GLdouble z);
+#undef dglVertex3dv
+#define dglVertex3dv(v) mglVertex3dv(v)
+void APIENTRY mglVertex3dv (const GLdouble* v);
+#undef dglVertex3f
+#define dglVertex3f(x, y, z) mglVertex3f(x, y, z)
+void APIENTRY mglVertex3f (GLfloat x, GLfloat y, GLfloat z);
+#undef dglVertex3fv
+#define dglVertex3fv(v) mglVertex3fv(v)
+void APIENTRY mglVertex3fv (const GLfloat* v);
+#undef dglVertex3i
+#define dglVertex3i(x, y, z) mglVertex3i(x, y, z)
+void APIENTRY mglVertex3i (GLint x, GLint y, GLint z);
+#undef dglVertex3iv
+#define dglVertex3iv(v) mglVertex3iv(v)
+void APIENTRY mglVertex3iv (const GLint* v);
+#undef dglVertex3s
+#define dglVertex3s(x, y, z) mglVertex3s(x, y, z)
+void APIENTRY mglVertex3s (GLshort x, GLshort y, GLshort z);
+#undef dglVertex3sv
+#define dglVertex3sv(v) mglVertex3sv(v)
+void APIENTRY mglVertex3sv (const GLshort* v);
+#undef dglVertex4d
+#define dglVertex4d(x, y, z, w) mglVertex4d(x, y, z, w)
+void APIENTRY mglVertex4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w);
+#undef dglVertex4dv
+#define dglVertex4dv(v) mglVertex4dv(v)
+void APIENTRY mglVertex4dv (const GLdouble* v);
+#undef dglVertex4f
+#define dglVertex4f(x, y, z, w) mglVertex4f(x, y, z, w)
+void APIENTRY mglVertex4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+#undef dglVertex4fv
+#define dglVertex4fv(v) mglVertex4fv(v)
+void APIENTRY mglVertex4fv (const GLfloat* v);
+#undef dglVertex4i
+#define dglVertex4i(x, y, z, w) mglVertex4i(x, y, z, w)
+void APIENTRY mglVertex4i (GLint x, GLint y, GLint z, GLint w);
+#undef dglVertex4iv
+#define dglVertex4iv(v) mglVertex4iv(v)
+void APIENTRY mglVertex4iv (const GLint* v);
+#undef dglVertex4s
+#define dglVertex4s(x, y, z, w) mglVertex4s(x, y, z, w)
+void APIENTRY mglVertex4s (GLshort x, GLshort y, GLshort z, GLshort w);
+#undef dglVertex4sv
+#define dglVertex4sv(v) mglVertex4sv(v)
+void APIENTRY mglVertex4sv (const GLshort* v);
+#undef dglVertexPointer
+#define dglVertexPointer(size, type, stride, pointer) mglVertexPointer(size, type, stride, pointer)
+void APIENTRY mglVertexPointer (GLint size, GLenum type, GLsizei stride, const GLvoid* pointer);
+#undef dglViewport
+#define dglViewport(x, y, width, height) mglViewport(x, y, width, height)
+void APIENTRY mglViewport (GLint x, GLint y, GLsizei width, GLsizei height);
+
+#endif // __DGLMOCK_H__
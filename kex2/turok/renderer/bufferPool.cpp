@@ -0,0 +1,177 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Static vertex/index buffer pools
+//
+// Geometry that never changes after it's loaded is copied into a
+// few large buffer objects instead of one per surface. Space is
+// handed out from the end of each block; a block is only reused
+// once everything in it has been freed, which is what happens
+// when a map's models are evicted together
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "renderBackend.h"
+#include "bufferPool.h"
+
+#define BUFFERPOOL_ALIGN    16
+
+kexCvar cvarRenderStaticBuffers("r_staticbuffers", CVF_BOOL|CVF_CONFIG, "1",
+                                "Keep static geometry in buffer objects (takes effect on load)");
+
+kexBufferPool vertexBufferPool(GL_ARRAY_BUFFER_ARB, 4 * 1024 * 1024);
+kexBufferPool indexBufferPool(GL_ELEMENT_ARRAY_BUFFER_ARB, 1024 * 1024);
+
+//
+// kexBufferPool::kexBufferPool
+//
+
+kexBufferPool::kexBufferPool(const int target, const unsigned int blockSize) {
+    this->target    = target;
+    this->blockSize = blockSize;
+    this->bytesLive = 0;
+}
+
+//
+// kexBufferPool::~kexBufferPool
+//
+
+kexBufferPool::~kexBufferPool(void) {
+}
+
+//
+// kexBufferPool::Available
+//
+
+bool kexBufferPool::Available(void) {
+    return cvarRenderStaticBuffers.GetBool() &&
+        renderBackend.IsInitialized() &&
+        has_GL_ARB_vertex_buffer_object;
+}
+
+//
+// kexBufferPool::Bind
+//
+
+void kexBufferPool::Bind(const dtexture buffer) {
+    if(target == GL_ELEMENT_ARRAY_BUFFER_ARB) {
+        renderBackend.BindIndexBuffer(buffer);
+    }
+    else {
+        renderBackend.BindVertexBuffer(buffer);
+    }
+}
+
+//
+// kexBufferPool::Alloc
+//
+// Copies data into the first block with room for it, creating
+// a new block if none has any. Anything bigger than a block gets
+// a block of its own
+//
+
+bool kexBufferPool::Alloc(const void *data, const unsigned int size,
+                          dtexture &buffer, unsigned int &offset) {
+    bufferBlock_t *block = NULL;
+    unsigned int aligned = (size + (BUFFERPOOL_ALIGN-1)) & ~(BUFFERPOOL_ALIGN-1);
+
+    if(size == 0 || !Available()) {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < blocks.Length(); i++) {
+        if(blocks[i].size - blocks[i].used >= aligned) {
+            block = &blocks[i];
+            break;
+        }
+    }
+
+    if(block == NULL) {
+        bufferBlock_t newBlock;
+
+        newBlock.size = MAX(aligned, blockSize);
+        newBlock.used = 0;
+        newBlock.live = 0;
+
+        dglGenBuffersARB(1, &newBlock.buffer);
+        Bind(newBlock.buffer);
+        dglBufferDataARB(target, newBlock.size, NULL, GL_STATIC_DRAW_ARB);
+
+        blocks.Push(newBlock);
+        block = &blocks[blocks.Length()-1];
+    }
+
+    Bind(block->buffer);
+    dglBufferSubDataARB(target, block->used, size, data);
+
+    buffer = block->buffer;
+    offset = block->used;
+
+    block->used += aligned;
+    block->live += aligned;
+    bytesLive += aligned;
+
+    // client arrays are read through whatever's bound, so nothing
+    // stays bound outside of drawing a surface
+    Bind(0);
+    return true;
+}
+
+//
+// kexBufferPool::Free
+//
+
+void kexBufferPool::Free(const dtexture buffer, const unsigned int size) {
+    unsigned int aligned = (size + (BUFFERPOOL_ALIGN-1)) & ~(BUFFERPOOL_ALIGN-1);
+
+    for(unsigned int i = 0; i < blocks.Length(); i++) {
+        bufferBlock_t *block = &blocks[i];
+
+        if(block->buffer != buffer) {
+            continue;
+        }
+
+        block->live -= MIN(aligned, block->live);
+        bytesLive -= MIN(aligned, bytesLive);
+
+        // start filling it from the beginning again
+        if(block->live == 0) {
+            block->used = 0;
+        }
+        return;
+    }
+}
+
+//
+// kexBufferPool::Shutdown
+//
+
+void kexBufferPool::Shutdown(void) {
+    for(unsigned int i = 0; i < blocks.Length(); i++) {
+        renderBackend.ForgetBuffer(blocks[i].buffer);
+        dglDeleteBuffersARB(1, &blocks[i].buffer);
+    }
+
+    blocks.Empty();
+    bytesLive = 0;
+}
@@ -0,0 +1,59 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __BUFFERPOOL_H__
+#define __BUFFERPOOL_H__
+
+typedef struct {
+    dtexture                buffer;
+    unsigned int            size;
+    unsigned int            used;
+    unsigned int            live;           // bytes still owned by something
+} bufferBlock_t;
+
+class kexBufferPool {
+public:
+                            kexBufferPool(const int target, const unsigned int blockSize);
+                            ~kexBufferPool(void);
+
+    bool                    Alloc(const void *data, const unsigned int size,
+                                  dtexture &buffer, unsigned int &offset);
+    void                    Free(const dtexture buffer, const unsigned int size);
+    void                    Bind(const dtexture buffer);
+    void                    Shutdown(void);
+
+    const unsigned int      NumBlocks(void) const { return blocks.Length(); }
+    const unsigned int      BytesLive(void) const { return bytesLive; }
+
+    static bool             Available(void);
+
+private:
+    int                     target;
+    unsigned int            blockSize;
+    unsigned int            bytesLive;
+    kexArray<bufferBlock_t> blocks;
+};
+
+extern kexBufferPool vertexBufferPool;
+extern kexBufferPool indexBufferPool;
+
+#endif
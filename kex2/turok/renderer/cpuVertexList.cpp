@@ -20,13 +20,23 @@
 //
 //-----------------------------------------------------------------------------
 //
-// DESCRIPTION:
+// DESCRIPTION: Scratch vertices for everything drawn from client memory
+//
+// Callers still build and draw their own little batches, but the draws
+// are held back and merged with the next one when nothing changed in
+// between. Every state change that goes through renderBackend flushes
+// first, anything that touches gl directly has to call Flush itself.
+// The ring rewinds whenever it's been drawn out and grows as needed up
+// to what word indices can reach, after which it flushes and starts over
 //
 //-----------------------------------------------------------------------------
 
 #include "common.h"
 #include "renderBackend.h"
+#include "renderMain.h"
 #include "cpuVertexList.h"
+#include "glMock.h"
+#include "canvas.h"
 
 kexCpuVertList cpuVertList;
 
@@ -35,6 +45,24 @@ kexCpuVertList cpuVertList;
 //
 
 kexCpuVertList::kexCpuVertList(void) {
+    maxVertices     = 0;
+    maxIndices      = 0;
+    vertexCount     = 0;
+    indiceCount     = 0;
+    firstVertex     = 0;
+    firstIndex      = 0;
+    pendingMode     = GL_TRIANGLES;
+    pendingStart    = 0;
+    pendingCount    = 0;
+    bFlushing       = false;
+    drawIndices     = NULL;
+    drawVertices    = NULL;
+    drawTexCoords   = NULL;
+    drawNormals     = NULL;
+    drawRGB         = NULL;
+
+    memset(&frameStats, 0, sizeof(cpuVertStats_t));
+    memset(&lastFrameStats, 0, sizeof(cpuVertStats_t));
 }
 
 //
@@ -44,46 +72,193 @@ kexCpuVertList::kexCpuVertList(void) {
 kexCpuVertList::~kexCpuVertList(void) {
 }
 
+//
+// kexCpuVertList::Shutdown
+//
+
+void kexCpuVertList::Shutdown(void) {
+    if(drawIndices == NULL) {
+        return;
+    }
+
+    Mem_Free(drawIndices);
+    Mem_Free(drawVertices);
+    Mem_Free(drawTexCoords);
+    Mem_Free(drawNormals);
+    Mem_Free(drawRGB);
+
+    drawIndices     = NULL;
+    drawVertices    = NULL;
+    drawTexCoords   = NULL;
+    drawNormals     = NULL;
+    drawRGB         = NULL;
+    maxVertices     = 0;
+    maxIndices      = 0;
+    vertexCount     = 0;
+    indiceCount     = 0;
+    firstVertex     = 0;
+    firstIndex      = 0;
+    pendingCount    = 0;
+}
+
 //
 // kexCpuVertList::Reset
 //
+// Starts a new submission. Anything that was submitted but not
+// drawn yet stays where it is
+//
 
 void kexCpuVertList::Reset(void) {
-    indiceCount = 0;
-    vertexCount = 0;
-    roverIndices = drawIndices;
-    roverVertices = drawVertices;
-    roverTexCoords = drawTexCoords;
-    roverRGB = drawRGB;
+    if(pendingCount == 0) {
+        vertexCount = 0;
+        indiceCount = 0;
+    }
+
+    firstVertex = vertexCount;
+    firstIndex = indiceCount;
 }
 
 //
 // kexCpuVertList::BindDrawPointers
 //
+// The pointers are set when the merged draw is flushed
+//
 
 void kexCpuVertList::BindDrawPointers(void) {
-    dglNormalPointer(GL_FLOAT, sizeof(float)*3, drawNormals);
-    dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, drawTexCoords);
-    dglVertexPointer(3, GL_FLOAT, sizeof(float)*3, drawVertices);
-    dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, drawRGB);
-    
     Reset();
 }
 
+//
+// kexCpuVertList::Grow
+//
+
+void kexCpuVertList::Grow(const unsigned int numVerts, const unsigned int numIndices) {
+    unsigned int size;
+
+    if(numVerts > maxVertices) {
+        for(size = MAX(maxVertices, CPU_VERT_INITSIZE); size < numVerts; size <<= 1);
+
+        if(size > CPU_VERT_MAXSIZE) {
+            size = CPU_VERT_MAXSIZE;
+        }
+
+        drawVertices = (float*)Mem_Realloc(drawVertices, sizeof(float) * 3 * size, hb_static);
+        drawTexCoords = (float*)Mem_Realloc(drawTexCoords, sizeof(float) * 2 * size, hb_static);
+        drawRGB = (byte*)Mem_Realloc(drawRGB, sizeof(byte) * 4 * size, hb_static);
+        drawNormals = (float*)Mem_Realloc(drawNormals, sizeof(float) * 3 * size, hb_static);
+
+        // nothing writes the normals, they only have to be there
+        memset(drawNormals + maxVertices * 3, 0, sizeof(float) * 3 * (size - maxVertices));
+        maxVertices = size;
+    }
+
+    if(numIndices > maxIndices) {
+        for(size = MAX(maxIndices, CPU_VERT_INITSIZE * 3); size < numIndices; size <<= 1);
+
+        drawIndices = (word*)Mem_Realloc(drawIndices, sizeof(word) * size, hb_static);
+        maxIndices = size;
+    }
+}
+
+//
+// kexCpuVertList::Wrap
+//
+// Draws what's pending and moves the submission being built to the
+// front of the ring
+//
+
+void kexCpuVertList::Wrap(void) {
+    unsigned int numVerts;
+    unsigned int numIndices;
+
+    Flush();
+
+    numVerts = vertexCount - firstVertex;
+    numIndices = indiceCount - firstIndex;
+
+    if(firstVertex != 0) {
+        memmove(drawVertices, drawVertices + firstVertex * 3, sizeof(float) * 3 * numVerts);
+        memmove(drawTexCoords, drawTexCoords + firstVertex * 2, sizeof(float) * 2 * numVerts);
+        memmove(drawRGB, drawRGB + firstVertex * 4, sizeof(byte) * 4 * numVerts);
+    }
+
+    for(unsigned int i = 0; i < numIndices; i++) {
+        drawIndices[i] = drawIndices[firstIndex + i] - firstVertex;
+    }
+
+    vertexCount = numVerts;
+    indiceCount = numIndices;
+    firstVertex = 0;
+    firstIndex = 0;
+
+    frameStats.numWraps++;
+}
+
+//
+// kexCpuVertList::CheckVertices
+//
+// Makes room for more vertices. Returns false if a single submission
+// is asking for more than a draw can index, which gets dropped
+//
+
+bool kexCpuVertList::CheckVertices(const unsigned int count) {
+    if(vertexCount + count > CPU_VERT_MAXSIZE) {
+        if(firstVertex == 0) {
+            return false;
+        }
+
+        Wrap();
+
+        if(vertexCount + count > CPU_VERT_MAXSIZE) {
+            return false;
+        }
+    }
+
+    if(vertexCount + count > maxVertices) {
+        Grow(vertexCount + count, 0);
+    }
+
+    if(vertexCount + count > frameStats.peakVertices) {
+        frameStats.peakVertices = vertexCount + count;
+    }
+
+    return true;
+}
+
+//
+// kexCpuVertList::CheckIndices
+//
+
+bool kexCpuVertList::CheckIndices(const unsigned int count) {
+    if(indiceCount + count > maxIndices) {
+        Grow(0, indiceCount + count);
+    }
+
+    if(indiceCount + count > frameStats.peakIndices) {
+        frameStats.peakIndices = indiceCount + count;
+    }
+
+    return true;
+}
+
 //
 // kexCpuVertList::AddTriangle
 //
 
 void kexCpuVertList::AddTriangle(int v0, int v1, int v2) {
-    if((vertexCount * 3) >= CPU_VERT_NUM_XYZ) {
+    int maxVert = MAX(v0, MAX(v1, v2));
+
+    if(v0 < 0 || v1 < 0 || v2 < 0 || firstVertex + maxVert >= CPU_VERT_MAXSIZE) {
         return;
     }
 
-    *(roverIndices++) = v0;
-    *(roverIndices++) = v1;
-    *(roverIndices++) = v2;
-    
-    indiceCount += 3;
+    if(!CheckIndices(3)) {
+        return;
+    }
+
+    drawIndices[indiceCount++] = (word)(firstVertex + v0);
+    drawIndices[indiceCount++] = (word)(firstVertex + v1);
+    drawIndices[indiceCount++] = (word)(firstVertex + v2);
 }
 
 //
@@ -92,19 +267,19 @@ void kexCpuVertList::AddTriangle(int v0, int v1, int v2) {
 
 void kexCpuVertList::AddVertex(float x, float y, float z, float s, float t,
                                 byte r, byte g, byte b, byte a) {
-    if((vertexCount * 3) >= CPU_VERT_NUM_XYZ) {
+    if(!CheckVertices(1)) {
         return;
     }
 
-    *(roverVertices++)   = x;
-    *(roverVertices++)   = y;
-    *(roverVertices++)   = z;
-    *(roverTexCoords++)  = s;
-    *(roverTexCoords++)  = t;
-    *(roverRGB++)        = r;
-    *(roverRGB++)        = g;
-    *(roverRGB++)        = b;
-    *(roverRGB++)        = a;
+    drawVertices[vertexCount * 3 + 0]   = x;
+    drawVertices[vertexCount * 3 + 1]   = y;
+    drawVertices[vertexCount * 3 + 2]   = z;
+    drawTexCoords[vertexCount * 2 + 0]  = s;
+    drawTexCoords[vertexCount * 2 + 1]  = t;
+    drawRGB[vertexCount * 4 + 0]        = r;
+    drawRGB[vertexCount * 4 + 1]        = g;
+    drawRGB[vertexCount * 4 + 2]        = b;
+    drawRGB[vertexCount * 4 + 3]        = a;
 
     vertexCount++;
 }
@@ -124,11 +299,7 @@ void kexCpuVertList::AddVertex(float x, float y, float z, float s, float t, byte
 void kexCpuVertList::AddLine(float x1, float y1, float z1,
                           float x2, float y2, float z2,
                           byte r, byte g, byte b, byte a) {
-    
-    *(roverIndices++) = vertexCount; indiceCount++;
-    AddVertex(x1, y1, z1, 0, 0, r, g, b, a);
-    *(roverIndices++) = vertexCount; indiceCount++;
-    AddVertex(x2, y2, z2, 0, 0, r, g, b, a);
+    AddLine(x1, y1, z1, x2, y2, z2, r, g, b, a, r, g, b, a);
 }
 
 //
@@ -139,25 +310,103 @@ void kexCpuVertList::AddLine(float x1, float y1, float z1,
                           float x2, float y2, float z2,
                           byte r1, byte g1, byte b1, byte a1,
                           byte r2, byte g2, byte b2, byte a2) {
-    
-    *(roverIndices++) = vertexCount; indiceCount++;
+    if(!CheckVertices(2) || !CheckIndices(2)) {
+        return;
+    }
+
+    drawIndices[indiceCount++] = vertexCount;
     AddVertex(x1, y1, z1, 0, 0, r1, g1, b1, a1);
-    *(roverIndices++) = vertexCount; indiceCount++;
+    drawIndices[indiceCount++] = vertexCount;
     AddVertex(x2, y2, z2, 0, 0, r2, g2, b2, a2);
 }
 
 //
-// kexCpuVertList::DrawElements
+// kexCpuVertList::Submit
+//
+// Adds the submission to the pending draw if it picks up right where
+// the pending draw left off. Callers have already set up their state,
+// so if it changed the pending draw has been flushed by now
 //
 
-void kexCpuVertList::DrawElements(const bool bClearCount) {
-    dglDrawElements(GL_TRIANGLES, indiceCount, GL_UNSIGNED_SHORT, drawIndices);
+void kexCpuVertList::Submit(const int mode, const bool bClearCount) {
+    unsigned int count = indiceCount - firstIndex;
+
+    frameStats.numSubmits++;
+
+    if(count != 0) {
+        if(pendingCount != 0 && (pendingMode != mode ||
+            pendingStart + pendingCount != firstIndex)) {
+            DrawPending();
+        }
+
+        if(pendingCount == 0) {
+            pendingMode = mode;
+            pendingStart = firstIndex;
+        }
+
+        pendingCount += count;
+    }
 
     if(bClearCount) {
         Reset();
     }
 }
 
+//
+// kexCpuVertList::DrawPending
+//
+
+void kexCpuVertList::DrawPending(void) {
+    if(bFlushing) {
+        return;
+    }
+
+    bFlushing = true;
+
+    // the buffer binds would try to flush again
+    renderBackend.BindVertexBuffer(0);
+    renderBackend.BindIndexBuffer(0);
+    renderer.currentSurface = NULL;
+
+    dglNormalPointer(GL_FLOAT, sizeof(float)*3, drawNormals);
+    dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, drawTexCoords);
+    dglVertexPointer(3, GL_FLOAT, sizeof(float)*3, drawVertices);
+    dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, drawRGB);
+
+    dglDrawElements(pendingMode, pendingCount, GL_UNSIGNED_SHORT, drawIndices + pendingStart);
+
+    frameStats.numDraws++;
+    pendingCount = 0;
+    bFlushing = false;
+
+    // rewind if the submission being built is still empty
+    if(firstVertex == vertexCount && firstIndex == indiceCount) {
+        vertexCount = 0;
+        indiceCount = 0;
+        firstVertex = 0;
+        firstIndex = 0;
+    }
+}
+
+//
+// kexCpuVertList::EndFrame
+//
+
+void kexCpuVertList::EndFrame(void) {
+    Flush();
+
+    lastFrameStats = frameStats;
+    memset(&frameStats, 0, sizeof(cpuVertStats_t));
+}
+
+//
+// kexCpuVertList::DrawElements
+//
+
+void kexCpuVertList::DrawElements(const bool bClearCount) {
+    Submit(GL_TRIANGLES, bClearCount);
+}
+
 //
 // kexCpuVertList::DrawElements
 //
@@ -177,11 +426,7 @@ void kexCpuVertList::DrawElements(const kexMaterial *material, const bool bClear
     
     material->BindImages();
     
-    dglDrawElements(GL_TRIANGLES, indiceCount, GL_UNSIGNED_SHORT, drawIndices);
-    
-    if(bClearCount) {
-        Reset();
-    }
+    Submit(GL_TRIANGLES, bClearCount);
 }
 
 //
@@ -190,11 +435,7 @@ void kexCpuVertList::DrawElements(const kexMaterial *material, const bool bClear
 
 void kexCpuVertList::DrawElementsNoShader(const bool bClearCount) {
     renderBackend.DisableShaders();
-    dglDrawElements(GL_TRIANGLES, indiceCount, GL_UNSIGNED_SHORT, drawIndices);
-
-    if(bClearCount) {
-        Reset();
-    }
+    Submit(GL_TRIANGLES, bClearCount);
 }
 
 //
@@ -203,7 +444,124 @@ void kexCpuVertList::DrawElementsNoShader(const bool bClearCount) {
 
 void kexCpuVertList::DrawLineElements(void) {
     renderBackend.DisableShaders();
-    dglDrawElements(GL_LINES, indiceCount, GL_UNSIGNED_SHORT, drawIndices);
-    
-    Reset();
+    Submit(GL_LINES, true);
 }
+
+#ifdef USE_MOCK_GLFUNCS
+
+//
+// VertListTest_Draws
+//
+// Counts the draws logged since the mock was reset and how many
+// indices went out with them
+//
+
+static int VertListTest_Draws(int *numIndices) {
+    int count = 0;
+
+    *numIndices = 0;
+
+    for(int i = 0; i < glMock.NumLogged(); i++) {
+        const glMockCall_t &call = glMock.Call(i);
+
+        if(strcmp(glMock.FuncName(call.func), "glDrawElements")) {
+            continue;
+        }
+
+        *numIndices += (int)call.args[1].i;
+        count++;
+    }
+
+    return count;
+}
+
+//
+// testvertlist
+//
+// Draws a 10k character string and a thousand canvas images through
+// the mock backend and checks how many draws came out of them
+//
+
+COMMAND(testvertlist) {
+    static char string[10001];
+    kexCanvasImage *images;
+    kexMatrix matrix;
+    rcolor c = 0xffffffff;
+    int numIndices;
+    bool bOk = true;
+
+    for(int i = 0; i < 10000; i++) {
+        string[i] = 'a' + (i % 26);
+    }
+
+    string[10000] = 0;
+
+    renderBackend.SetOrtho();
+    renderBackend.SetTextureUnit(0);
+    cpuVertList.Flush();
+    glMock.Reset();
+
+    // a short string right after the long one goes in the same draw
+    renderBackend.consoleFont.DrawString(string, 0, 0, 1, false, (byte*)&c, (byte*)&c);
+    renderBackend.consoleFont.DrawString("merged", 0, 16, 1, false, (byte*)&c, (byte*)&c);
+    cpuVertList.Flush();
+
+    if(VertListTest_Draws(&numIndices) != 1 || numIndices != 10006 * 6) {
+        bOk = false;
+    }
+
+    // two long ones can't be reached by word indices, so the ring
+    // wraps in the middle of the second
+    glMock.Reset();
+    renderBackend.consoleFont.DrawString(string, 0, 0, 1, false, (byte*)&c, (byte*)&c);
+    renderBackend.consoleFont.DrawString(string, 0, 16, 1, false, (byte*)&c, (byte*)&c);
+    cpuVertList.Flush();
+
+    if(VertListTest_Draws(&numIndices) != 2 || numIndices != 20000 * 6) {
+        bOk = false;
+    }
+
+    images = new kexCanvasImage[1000];
+
+    for(int i = 0; i < 1000; i++) {
+        memset(images[i].rgba, 0xff, sizeof(images[i].rgba));
+        images[i].texture = (i < 500) ? &renderBackend.whiteTexture : &renderBackend.blackTexture;
+        images[i].width = 8;
+        images[i].height = 8;
+        images[i].x = (float)((i % 40) * 8);
+        images[i].y = (float)((i / 40) * 8);
+    }
+
+    // only the change of texture splits them up
+    glMock.Reset();
+
+    for(int i = 0; i < 1000; i++) {
+        images[i].Draw(matrix, 1.0f);
+    }
+
+    cpuVertList.Flush();
+
+    if(VertListTest_Draws(&numIndices) != 2 || numIndices != 1000 * 6) {
+        bOk = false;
+    }
+
+    // flipping between textures every image can't be merged
+    glMock.Reset();
+
+    for(int i = 0; i < 8; i++) {
+        images[(i & 1) ? 999 - i : i].Draw(matrix, 1.0f);
+    }
+
+    cpuVertList.Flush();
+
+    if(VertListTest_Draws(&numIndices) != 8 || numIndices != 8 * 6) {
+        bOk = false;
+    }
+
+    delete[] images;
+
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testvertlist %s\n",
+        bOk ? "passed" : "failed");
+}
+
+#endif // USE_MOCK_GLFUNCS
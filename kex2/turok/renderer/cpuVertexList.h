@@ -23,13 +23,18 @@
 #ifndef __CPUVERTEXLIST_H__
 #define __CPUVERTEXLIST_H__
 
-#define CPU_VERT_MAXSIZE        512
+// the ring starts small and doubles as needed. indices are words,
+// so a single draw can never reach past CPU_VERT_MAXSIZE vertices
+#define CPU_VERT_INITSIZE       1024
+#define CPU_VERT_MAXSIZE        0x10000
 
-#define CPU_VERT_NUM_XYZ        CPU_VERT_MAXSIZE * 3
-#define CPU_VERT_NUM_COORDS     CPU_VERT_MAXSIZE * 2
-#define CPU_VERT_NUM_NORMALS    CPU_VERT_MAXSIZE * 3
-#define CPU_VERT_NUM_COLOR      CPU_VERT_MAXSIZE * 4
-#define CPU_VERT_NUM_INDICES    CPU_VERT_MAXSIZE * 3
+typedef struct {
+    int                     numSubmits;         // Draw* calls made by the callers
+    int                     numDraws;           // glDrawElements calls that came out of them
+    int                     numWraps;           // times the ring filled up mid-frame
+    unsigned int            peakVertices;
+    unsigned int            peakIndices;
+} cpuVertStats_t;
 
 class kexMaterial;
 
@@ -55,20 +60,43 @@ public:
     void                    DrawElements(const kexMaterial *material, const bool bClearCount = true);
     void                    DrawElementsNoShader(const bool bClearCount = true);
     void                    DrawLineElements(void);
+    void                    EndFrame(void);
+    void                    Shutdown(void);
+
+    // draws whatever has been merged so far. must be called before
+    // any gl state is changed without going through renderBackend
+    void                    Flush(void) { if(pendingCount) DrawPending(); }
+
+    const cpuVertStats_t    &FrameStats(void) const { return lastFrameStats; }
+    const unsigned int      Capacity(void) const { return maxVertices; }
 
 private:
-    word                    indiceCount;
-    word                    vertexCount;
-    word                    drawIndices[CPU_VERT_NUM_INDICES];
-    float                   drawVertices[CPU_VERT_NUM_XYZ];
-    float                   drawTexCoords[CPU_VERT_NUM_COORDS];
-    float                   drawNormals[CPU_VERT_NUM_NORMALS];
-    byte                    drawRGB[CPU_VERT_NUM_COLOR];
-    
-    word                    *roverIndices;
-    float                   *roverVertices;
-    float                   *roverTexCoords;
-    byte                    *roverRGB;
+    bool                    CheckVertices(const unsigned int count);
+    bool                    CheckIndices(const unsigned int count);
+    void                    Grow(const unsigned int numVerts, const unsigned int numIndices);
+    void                    Wrap(void);
+    void                    Submit(const int mode, const bool bClearCount);
+    void                    DrawPending(void);
+
+    unsigned int            maxVertices;
+    unsigned int            maxIndices;
+    unsigned int            vertexCount;
+    unsigned int            indiceCount;
+    unsigned int            firstVertex;        // start of the submission being built
+    unsigned int            firstIndex;
+    int                     pendingMode;
+    unsigned int            pendingStart;       // merged submissions not drawn yet
+    unsigned int            pendingCount;
+    bool                    bFlushing;
+
+    word                    *drawIndices;
+    float                   *drawVertices;
+    float                   *drawTexCoords;
+    float                   *drawNormals;
+    byte                    *drawRGB;
+
+    cpuVertStats_t          frameStats;
+    cpuVertStats_t          lastFrameStats;
 };
 
 extern kexCpuVertList cpuVertList;
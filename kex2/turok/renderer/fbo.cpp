@@ -58,25 +58,25 @@ void kexFBO::CheckStatus(void) {
     if(status != GL_FRAMEBUFFER_COMPLETE_EXT) {
         switch(status) {
             case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT_EXT:
-                common.Warning("kexFBO::Init: bad attachment\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: bad attachment\n");
                 break;
             case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT_EXT:
-                common.Warning("kexFBO::Init: attachment is missing\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: attachment is missing\n");
                 break;
             case GL_FRAMEBUFFER_INCOMPLETE_DIMENSIONS_EXT:
-                common.Warning("kexFBO::Init: bad dimentions\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: bad dimentions\n");
                 break;
             case GL_FRAMEBUFFER_INCOMPLETE_FORMATS_EXT:
-                common.Warning("kexFBO::Init: bad format\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: bad format\n");
                 break;
             case GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER_EXT:
-                common.Warning("kexFBO::Init: error with draw buffer\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: error with draw buffer\n");
                 break;
             case GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER_EXT:
-                common.Warning("kexFBO::Init: error with read buffer\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: error with read buffer\n");
                 break;
             default:
-                common.Warning("kexFBO::Init: frame buffer creation didn't complete\n");
+                common.Warning(LC_RENDER, "kexFBO::Init: frame buffer creation didn't complete\n");
                 break;
         }
         
@@ -107,7 +107,7 @@ void kexFBO::InitColorAttachment(const int attachment, const int width, const in
     
     // texture
     dglGenTextures(1, &fboTexId);
-    dglBindTexture(GL_TEXTURE_2D, fboTexId);
+    renderBackend.BindTexture(fboTexId);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -148,7 +148,7 @@ void kexFBO::InitColorAttachment(const int attachment, const int width, const in
     
     CheckStatus();
     
-    dglBindTexture(GL_TEXTURE_2D, 0);
+    renderBackend.BindTexture(0);
     renderBackend.RestoreFrameBuffer();
 }
 
@@ -179,7 +179,7 @@ void kexFBO::InitDepthAttachment(const int width, const int height) {
     
     // texture
     dglGenTextures(1, &fboTexId);
-    dglBindTexture(GL_TEXTURE_2D, fboTexId);
+    renderBackend.BindTexture(fboTexId);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -207,7 +207,7 @@ void kexFBO::InitDepthAttachment(const int width, const int height) {
     
     CheckStatus();
     
-    dglBindTexture(GL_TEXTURE_2D, 0);
+    renderBackend.BindTexture(0);
     renderBackend.RestoreFrameBuffer();
 }
 
@@ -221,6 +221,7 @@ void kexFBO::Delete(void) {
     }
     
     if(fboTexId != 0) {
+        renderBackend.ForgetTexture(fboTexId);
         dglDeleteTextures(1, &fboTexId);
         fboTexId = 0;
     }
@@ -245,6 +246,7 @@ void kexFBO::CopyBackBuffer(void) {
     int viewHeight = kexMath::RoundPowerOfTwo(sysMain.VideoHeight());
     
     // copy over the main framebuffer
+    cpuVertList.Flush();
     dglBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
     dglReadBuffer(GL_BACK);
     dglBindFramebuffer(GL_DRAW_FRAMEBUFFER, fboId);
@@ -281,6 +283,7 @@ void kexFBO::CopyFrameBuffer(const kexFBO &fbo) {
         h = fbo.fboHeight;
     }
 
+    cpuVertList.Flush();
     dglBindFramebuffer(GL_READ_FRAMEBUFFER, fbo.fboId);
     dglReadBuffer(fbo.fboAttachment);
     dglBindFramebuffer(GL_DRAW_FRAMEBUFFER, fboId);
@@ -319,6 +322,7 @@ void kexFBO::Bind(void) {
         return;
     }
     
+    cpuVertList.Flush();
     dglBindFramebuffer(GL_FRAMEBUFFER_EXT, fboId);
     dglReadBuffer(fboAttachment);
     dglDrawBuffer(fboAttachment);
@@ -342,15 +346,7 @@ void kexFBO::UnBind(void) {
 //
 
 void kexFBO::BindImage(void) {
-    int unit = renderBackend.glState.currentUnit;
-    dtexture currentTexture = renderBackend.glState.textureUnits[unit].currentTexture;
-    
-    if(fboTexId == currentTexture) {
-        return;
-    }
-    
-    dglBindTexture(GL_TEXTURE_2D, fboTexId);
-    renderBackend.glState.textureUnits[unit].currentTexture = fboTexId;
+    renderBackend.BindTexture(fboTexId);
 }
 
 //
@@ -358,12 +354,5 @@ void kexFBO::BindImage(void) {
 //
 
 void kexFBO::UnBindImage(void) {
-    int unit = renderBackend.glState.currentUnit;
-    
-    if(renderBackend.glState.textureUnits[unit].currentTexture == 0) {
-        return;
-    }
-    
-    dglBindTexture(GL_TEXTURE_2D, 0);
-    renderBackend.glState.textureUnits[unit].currentTexture = 0;
+    renderBackend.BindTexture(0);
 }
@@ -0,0 +1,700 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Recording stand-in for the GL driver
+//
+// Built with USE_MOCK_GLFUNCS defined, every dgl call lands in the
+// entry points dglmake writes to dglmock.cpp instead of the driver.
+// No context is created, so the renderer runs headless and what it
+// would have sent can be counted and checked.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "renderBackend.h"
+#include "renderMain.h"
+#include "glMock.h"
+
+#ifdef USE_MOCK_GLFUNCS
+
+kexGLMock glMock;
+
+static const char *glMockStateFuncs[] = {
+    "glEnable",
+    "glDisable",
+    "glAlphaFunc",
+    "glDepthFunc",
+    "glBlendFunc",
+    "glCullFace",
+    "glPolygonMode",
+    "glDepthMask",
+    "glColorMask",
+    "glActiveTextureARB",
+    NULL
+};
+
+//
+// GLMock_IsPerUnit
+//
+// Texture targets are bound and enabled separately on every unit
+//
+
+static bool GLMock_IsPerUnit(const GLenum target) {
+    switch(target) {
+    case GL_TEXTURE_1D:
+    case GL_TEXTURE_2D:
+    case GL_TEXTURE_CUBE_MAP_ARB:
+    case GL_TEXTURE_2D_ARRAY_EXT:
+    case GL_TEXTURE_GEN_S:
+    case GL_TEXTURE_GEN_T:
+    case GL_TEXTURE_GEN_R:
+    case GL_TEXTURE_GEN_Q:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+//
+// kexGLMock::kexGLMock
+//
+
+kexGLMock::kexGLMock(void) {
+    this->numBindings   = 0;
+    this->numCaps       = 0;
+    this->nextName      = 1;
+    this->activeUnit    = 0;
+
+    for(int i = 0; i < 4; i++) {
+        viewport[i] = 0;
+    }
+
+    Reset();
+}
+
+//
+// kexGLMock::Reset
+//
+// Clears the log and the counts. What's bound stays bound, like
+// it would on a real context
+//
+
+void kexGLMock::Reset(void) {
+    numLogged = 0;
+    numCalls = 0;
+    memset(counts, 0, sizeof(counts));
+}
+
+//
+// kexGLMock::Record
+//
+
+glMockCall_t *kexGLMock::Record(const int func) {
+    glMockCall_t *call;
+
+    numCalls++;
+
+    if(func >= 0 && func < GLMOCK_MAX_FUNCS) {
+        counts[func]++;
+    }
+
+    if(numLogged >= GLMOCK_MAX_CALLS) {
+        return NULL;
+    }
+
+    call = &calls[numLogged++];
+    call->func = func;
+    call->numArgs = 0;
+    call->texture = Bound(GL_TEXTURE_2D, 0);
+    call->program = Bound(GL_PROGRAM_OBJECT_ARB, 0);
+
+    return call;
+}
+
+//
+// kexGLMock::ArgInt
+//
+
+void kexGLMock::ArgInt(glMockCall_t *call, const int64_t val) {
+    if(call == NULL || call->numArgs >= GLMOCK_MAX_ARGS) {
+        return;
+    }
+
+    call->types[call->numArgs] = 'i';
+    call->args[call->numArgs++].i = val;
+}
+
+//
+// kexGLMock::ArgFloat
+//
+
+void kexGLMock::ArgFloat(glMockCall_t *call, const double val) {
+    if(call == NULL || call->numArgs >= GLMOCK_MAX_ARGS) {
+        return;
+    }
+
+    call->types[call->numArgs] = 'f';
+    call->args[call->numArgs++].f = val;
+}
+
+//
+// kexGLMock::ArgPtr
+//
+
+void kexGLMock::ArgPtr(glMockCall_t *call, const void *val) {
+    if(call == NULL || call->numArgs >= GLMOCK_MAX_ARGS) {
+        return;
+    }
+
+    call->types[call->numArgs] = 'p';
+    call->args[call->numArgs++].p = val;
+}
+
+//
+// kexGLMock::NewName
+//
+// Returns the first of count new names
+//
+
+GLuint kexGLMock::NewName(const int count) {
+    GLuint name = nextName;
+
+    nextName += (count > 0) ? count : 1;
+    return name;
+}
+
+//
+// kexGLMock::GenNames
+//
+
+void kexGLMock::GenNames(const GLsizei count, GLuint *names) {
+    for(int i = 0; i < count; i++) {
+        names[i] = NewName(1);
+    }
+}
+
+//
+// kexGLMock::DeleteNames
+//
+// Deleting a bound object leaves zero bound in its place
+//
+
+void kexGLMock::DeleteNames(const GLsizei count, const GLuint *names) {
+    for(int i = 0; i < count; i++) {
+        for(int j = 0; j < numBindings; j++) {
+            if(names[i] != 0 && bindings[j].name == names[i]) {
+                bindings[j].name = 0;
+            }
+        }
+    }
+}
+
+//
+// kexGLMock::Find
+//
+
+glMockBinding_t *kexGLMock::Find(glMockBinding_t *list, int &count, const GLenum target,
+                                 const int unit, const bool bCreate) {
+    for(int i = 0; i < count; i++) {
+        if(list[i].target == target && list[i].unit == unit) {
+            return &list[i];
+        }
+    }
+
+    if(!bCreate) {
+        return NULL;
+    }
+
+    if(count >= GLMOCK_MAX_BINDINGS) {
+        common.Warning(LC_RENDER, "kexGLMock::Find: too many targets (%i)\n", count);
+        return NULL;
+    }
+
+    list[count].target = target;
+    list[count].unit = unit;
+    list[count].name = 0;
+
+    return &list[count++];
+}
+
+//
+// kexGLMock::Bind
+//
+
+void kexGLMock::Bind(const GLenum target, const GLuint name) {
+    glMockBinding_t *binding;
+    int unit = GLMock_IsPerUnit(target) ? activeUnit : 0;
+
+    if((binding = Find(bindings, numBindings, target, unit, true))) {
+        binding->name = name;
+    }
+}
+
+//
+// kexGLMock::ActiveTexture
+//
+
+void kexGLMock::ActiveTexture(const GLenum unit) {
+    activeUnit = unit - GL_TEXTURE0_ARB;
+}
+
+//
+// kexGLMock::SetCap
+//
+
+void kexGLMock::SetCap(const GLenum cap, const bool bEnable) {
+    glMockBinding_t *state;
+    int unit = GLMock_IsPerUnit(cap) ? activeUnit : 0;
+
+    if((state = Find(caps, numCaps, cap, unit, true))) {
+        state->name = bEnable;
+    }
+}
+
+//
+// kexGLMock::IsEnabled
+//
+
+GLboolean kexGLMock::IsEnabled(const GLenum cap) {
+    glMockBinding_t *state;
+    int unit = GLMock_IsPerUnit(cap) ? activeUnit : 0;
+
+    if((state = Find(caps, numCaps, cap, unit, false))) {
+        return (GLboolean)state->name;
+    }
+
+    // the only things on by default
+    return (cap == GL_DITHER || cap == GL_MULTISAMPLE_ARB);
+}
+
+//
+// kexGLMock::Viewport
+//
+
+void kexGLMock::Viewport(const GLint x, const GLint y, const GLsizei w, const GLsizei h) {
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = w;
+    viewport[3] = h;
+}
+
+//
+// kexGLMock::GetIntegerv
+//
+// Answers what the renderer asks for. Anything else comes back zero
+//
+
+void kexGLMock::GetIntegerv(const GLenum pname, GLint *params) {
+    switch(pname) {
+    case GL_VIEWPORT:
+        // until it's set the viewport covers the window
+        if(viewport[2] == 0 && viewport[3] == 0) {
+            Viewport(0, 0, sysMain.VideoWidth(), sysMain.VideoHeight());
+        }
+        memcpy(params, viewport, sizeof(viewport));
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *params = 4096;
+        break;
+    case GL_MAX_TEXTURE_UNITS_ARB:
+    case GL_MAX_COLOR_ATTACHMENTS_EXT:
+        *params = 4;
+        break;
+    case GL_PACK_ALIGNMENT:
+    case GL_UNPACK_ALIGNMENT:
+        *params = 4;
+        break;
+    case GL_ACTIVE_TEXTURE_ARB:
+        *params = GL_TEXTURE0_ARB + activeUnit;
+        break;
+    case GL_TEXTURE_BINDING_2D:
+        *params = Bound(GL_TEXTURE_2D, activeUnit);
+        break;
+    case GL_ARRAY_BUFFER_BINDING_ARB:
+        *params = Bound(GL_ARRAY_BUFFER_ARB);
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB:
+        *params = Bound(GL_ELEMENT_ARRAY_BUFFER_ARB);
+        break;
+    case GL_FRAMEBUFFER_BINDING_EXT:
+        *params = Bound(GL_FRAMEBUFFER_EXT);
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+//
+// kexGLMock::GetFloatv
+//
+
+void kexGLMock::GetFloatv(const GLenum pname, GLfloat *params) {
+    switch(pname) {
+    case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+        *params = 16;
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+//
+// kexGLMock::GetObjectParameteriv
+//
+// Every shader compiles and links, and none of them say anything
+// about it or have any active uniforms
+//
+
+void kexGLMock::GetObjectParameteriv(const GLenum pname, GLint *params) {
+    switch(pname) {
+    case GL_OBJECT_COMPILE_STATUS_ARB:
+    case GL_OBJECT_LINK_STATUS_ARB:
+    case GL_OBJECT_VALIDATE_STATUS_ARB:
+        *params = 1;
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+//
+// kexGLMock::GetName
+//
+
+void kexGLMock::GetName(const GLsizei maxLength, GLsizei *length, GLcharARB *name) {
+    if(length) {
+        *length = 0;
+    }
+
+    if(name && maxLength > 0) {
+        name[0] = 0;
+    }
+}
+
+//
+// kexGLMock::GetString
+//
+
+const GLubyte *kexGLMock::GetString(const GLenum name) {
+    switch(name) {
+    case GL_VENDOR:
+        return (const GLubyte*)"kex";
+    case GL_RENDERER:
+        return (const GLubyte*)"mock";
+    case GL_VERSION:
+        return (const GLubyte*)"2.1";
+    case GL_EXTENSIONS:
+        return (const GLubyte*)dglMockExtensions;
+    default:
+        break;
+    }
+
+    return (const GLubyte*)"";
+}
+
+//
+// kexGLMock::Count
+//
+// Number of calls made to a function since the last reset. A name
+// ending in '*' counts every function that starts with it
+//
+
+int kexGLMock::Count(const char *func) const {
+    int len = strlen(func);
+    int count = 0;
+    bool bPrefix = false;
+
+    if(len > 0 && func[len-1] == '*') {
+        bPrefix = true;
+        len--;
+    }
+
+    for(int i = 0; i < dglMockNumFuncs && i < GLMOCK_MAX_FUNCS; i++) {
+        if(bPrefix ? !strncmp(dglMockNames[i], func, len) : !strcmp(dglMockNames[i], func)) {
+            count += counts[i];
+        }
+    }
+
+    return count;
+}
+
+//
+// kexGLMock::DrawCalls
+//
+
+int kexGLMock::DrawCalls(void) const {
+    return Count("glDrawElements") + Count("glDrawArrays") + Count("glMultiDraw*") + Count("glBegin");
+}
+
+//
+// kexGLMock::StateChanges
+//
+
+int kexGLMock::StateChanges(void) const {
+    int count = 0;
+
+    for(int i = 0; glMockStateFuncs[i]; i++) {
+        count += Count(glMockStateFuncs[i]);
+    }
+
+    return count;
+}
+
+//
+// kexGLMock::Bound
+//
+
+GLuint kexGLMock::Bound(const GLenum target, const int unit) const {
+    for(int i = 0; i < numBindings; i++) {
+        if(bindings[i].target == target && bindings[i].unit == unit) {
+            return bindings[i].name;
+        }
+    }
+
+    return 0;
+}
+
+//
+// kexGLMock::FuncName
+//
+
+const char *kexGLMock::FuncName(const int func) const {
+    if(func < 0 || func >= dglMockNumFuncs) {
+        return "?";
+    }
+
+    return dglMockNames[func];
+}
+
+//
+// kexGLMock::PrintCall
+//
+
+void kexGLMock::PrintCall(const int index) const {
+    const glMockCall_t *call = &calls[index];
+    kexStr str(kva("%i: %s(", index, FuncName(call->func)));
+
+    for(int i = 0; i < call->numArgs; i++) {
+        if(i > 0) {
+            str += ", ";
+        }
+
+        switch(call->types[i]) {
+        case 'f':
+            str += kva("%f", call->args[i].f);
+            break;
+        case 'p':
+            str += kva("%p", call->args[i].p);
+            break;
+        default:
+            str += kva("%i", (int)call->args[i].i);
+            break;
+        }
+    }
+
+    common.Printf(LC_RENDER, "%s)\n", str.c_str());
+}
+
+//
+// glmockreset
+//
+
+COMMAND(glmockreset) {
+    glMock.Reset();
+}
+
+//
+// glmocklog
+//
+// Prints the calls made since the last reset
+//
+
+COMMAND(glmocklog) {
+    int count = glMock.NumLogged();
+
+    if(command.GetArgc() >= 2) {
+        count = MIN(atoi(command.GetArgv(1)), count);
+    }
+
+    for(int i = 0; i < count; i++) {
+        glMock.PrintCall(i);
+    }
+
+    if(glMock.NumCalls() > glMock.NumLogged()) {
+        common.Printf(LC_RENDER, "%i calls past the end of the log\n",
+            glMock.NumCalls() - glMock.NumLogged());
+    }
+}
+
+//
+// glmockframe
+//
+// Renders a frame and reports what reached the driver. The draws
+// are grouped by the texture and program they were made with
+//
+
+COMMAND(glmockframe) {
+    typedef struct {
+        GLuint  texture;
+        GLuint  program;
+        int     count;
+    } drawGroup_t;
+
+    drawGroup_t groups[64];
+    int numGroups = 0;
+    int elements;
+
+    glMock.Reset();
+    renderer.Draw();
+
+    for(int i = 0; i < glMock.NumLogged(); i++) {
+        const glMockCall_t &call = glMock.Call(i);
+        int j;
+
+        if(strcmp(glMock.FuncName(call.func), "glDrawElements")) {
+            continue;
+        }
+
+        for(j = 0; j < numGroups; j++) {
+            if(groups[j].texture == call.texture && groups[j].program == call.program) {
+                break;
+            }
+        }
+
+        if(j == numGroups) {
+            if(numGroups >= 64) {
+                continue;
+            }
+
+            groups[numGroups].texture = call.texture;
+            groups[numGroups].program = call.program;
+            groups[numGroups++].count = 0;
+        }
+
+        groups[j].count++;
+    }
+
+    elements = glMock.Count("glDrawElements");
+
+    common.Printf(LC_RENDER, "gl calls: %i\n", glMock.NumCalls());
+    common.Printf(LC_RENDER, "draw calls: %i (%i indexed)\n", glMock.DrawCalls(), elements);
+    common.Printf(LC_RENDER, "state changes: %i\n", glMock.StateChanges());
+    common.Printf(LC_RENDER, "texture binds: %i\n", glMock.Count("glBindTexture"));
+    common.Printf(LC_RENDER, "program binds: %i\n", glMock.Count("glUseProgramObjectARB"));
+    common.Printf(LC_RENDER, "uniform uploads: %i\n", glMock.Count("glUniform*"));
+
+    for(int i = 0; i < numGroups; i++) {
+        common.Printf(LC_RENDER, "texture %4i program %4i: %i draws\n",
+            groups[i].texture, groups[i].program, groups[i].count);
+    }
+}
+
+//
+// testglmock
+//
+// Checks the mock against the backend's state filtering
+//
+
+COMMAND(testglmock) {
+    GLuint textures[2];
+    GLuint program;
+    bool bBlend = (glMock.IsEnabled(GL_BLEND) != 0);
+    word indices[3] = { 0, 1, 2 };
+    bool bOk = true;
+
+    glMock.Reset();
+
+    // names are never zero or handed out twice
+    dglGenTextures(2, textures);
+    program = (GLuint)(size_t)dglCreateProgramObjectARB();
+
+    if(textures[0] == 0 || textures[0] == textures[1] ||
+        program == textures[0] || program == textures[1]) {
+        bOk = false;
+    }
+
+    // the same texture twice on a unit only reaches the driver once,
+    // and each unit keeps its own
+    renderBackend.SetTextureUnit(1);
+    renderBackend.BindTexture(textures[0]);
+    renderBackend.BindTexture(textures[0]);
+    renderBackend.SetTextureUnit(0);
+    renderBackend.BindTexture(textures[1]);
+
+    if(glMock.Count("glBindTexture") != 2 || glMock.ActiveUnit() != 0 ||
+        glMock.Bound(GL_TEXTURE_2D, 1) != textures[0] ||
+        glMock.Bound(GL_TEXTURE_2D, 0) != textures[1]) {
+        bOk = false;
+    }
+
+    // filtered state ends up where it was last set
+    renderBackend.SetState(GLSTATE_BLEND, true);
+    renderBackend.SetState(GLSTATE_BLEND, true);
+    renderBackend.SetState(GLSTATE_BLEND, false);
+    renderBackend.SetState(GLSTATE_BLEND, false);
+
+    if(glMock.IsEnabled(GL_BLEND) || glMock.Count("glEnable") + glMock.Count("glDisable") > 2) {
+        bOk = false;
+    }
+
+    // a draw knows what it was drawn with
+    dglDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, indices);
+
+    if(glMock.DrawCalls() != 1 || glMock.NumLogged() != glMock.NumCalls()) {
+        bOk = false;
+    }
+    else {
+        const glMockCall_t &call = glMock.Call(glMock.NumLogged()-1);
+
+        if(strcmp(glMock.FuncName(call.func), "glDrawElements") ||
+            call.numArgs != 4 || call.args[1].i != 3 || call.texture != textures[1]) {
+            bOk = false;
+        }
+    }
+
+    // extensions come from the mock as well
+    if(dglMockProc("glBindBufferARB") == NULL || dglMockProc("glNotAFunction") != NULL) {
+        bOk = false;
+    }
+
+    // deleting what's bound leaves nothing bound
+    renderBackend.ForgetTexture(textures[0]);
+    renderBackend.ForgetTexture(textures[1]);
+    dglDeleteTextures(2, textures);
+
+    if(glMock.Bound(GL_TEXTURE_2D, 0) != 0 || glMock.Bound(GL_TEXTURE_2D, 1) != 0) {
+        bOk = false;
+    }
+
+    dglDeleteObjectARB((GLhandleARB)(size_t)program);
+    renderBackend.SetState(GLSTATE_BLEND, bBlend);
+
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testglmock %s\n",
+        bOk ? "passed" : "failed");
+}
+
+#endif // USE_MOCK_GLFUNCS
@@ -0,0 +1,131 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __GLMOCK_H__
+#define __GLMOCK_H__
+
+#include "dgl.h"
+
+#ifdef USE_MOCK_GLFUNCS
+
+#define GLMOCK_MAX_CALLS        16384
+#define GLMOCK_MAX_ARGS         12
+#define GLMOCK_MAX_FUNCS        512
+#define GLMOCK_MAX_BINDINGS     64
+
+typedef union {
+    int64_t                   i;
+    double                  f;
+    const void              *p;
+} glMockArg_t;
+
+//
+// glMockCall_t - one entry in the command log. the texture on the
+// first unit and the program are what was bound when the call was
+// made, so a draw call says what it drew with
+//
+typedef struct {
+    int                     func;
+    int                     numArgs;
+    char                    types[GLMOCK_MAX_ARGS];     // 'i', 'f' or 'p'
+    glMockArg_t             args[GLMOCK_MAX_ARGS];
+    GLuint                  texture;
+    GLuint                  program;
+} glMockCall_t;
+
+typedef struct {
+    GLenum                  target;
+    int                     unit;
+    GLuint                  name;
+} glMockBinding_t;
+
+//
+// kexGLMock - stands in for the driver when the game is built with
+// USE_MOCK_GLFUNCS. the entry points generated by dglmake log every
+// call here and the few that have to answer something ask it what
+// to say. names are handed out from a single counter, so no two
+// objects of any kind share one
+//
+
+class kexGLMock {
+public:
+                            kexGLMock(void);
+
+    void                    Reset(void);
+    glMockCall_t            *Record(const int func);
+    void                    ArgInt(glMockCall_t *call, const int64_t val);
+    void                    ArgFloat(glMockCall_t *call, const double val);
+    void                    ArgPtr(glMockCall_t *call, const void *val);
+
+    GLuint                  NewName(const int count);
+    void                    GenNames(const GLsizei count, GLuint *names);
+    void                    DeleteNames(const GLsizei count, const GLuint *names);
+    void                    Bind(const GLenum target, const GLuint name);
+    void                    ActiveTexture(const GLenum unit);
+    void                    SetCap(const GLenum cap, const bool bEnable);
+    GLboolean               IsEnabled(const GLenum cap);
+    void                    Viewport(const GLint x, const GLint y, const GLsizei w, const GLsizei h);
+    void                    GetIntegerv(const GLenum pname, GLint *params);
+    void                    GetFloatv(const GLenum pname, GLfloat *params);
+    void                    GetObjectParameteriv(const GLenum pname, GLint *params);
+    void                    GetName(const GLsizei maxLength, GLsizei *length, GLcharARB *name);
+    const GLubyte           *GetString(const GLenum name);
+
+    int                     Count(const char *func) const;
+    int                     DrawCalls(void) const;
+    int                     StateChanges(void) const;
+    GLuint                  Bound(const GLenum target, const int unit = 0) const;
+    const char              *FuncName(const int func) const;
+    void                    PrintCall(const int index) const;
+
+    const int               NumCalls(void) const { return numCalls; }
+    const int               NumLogged(void) const { return numLogged; }
+    const glMockCall_t      &Call(const int index) const { return calls[index]; }
+    const int               ActiveUnit(void) const { return activeUnit; }
+
+private:
+    glMockBinding_t         *Find(glMockBinding_t *list, int &count, const GLenum target,
+                                  const int unit, const bool bCreate);
+
+    glMockCall_t            calls[GLMOCK_MAX_CALLS];
+    int                     numLogged;
+    int                     numCalls;           // keeps counting once the log is full
+    int                     counts[GLMOCK_MAX_FUNCS];
+    glMockBinding_t         bindings[GLMOCK_MAX_BINDINGS];
+    int                     numBindings;
+    glMockBinding_t         caps[GLMOCK_MAX_BINDINGS];
+    int                     numCaps;
+    GLuint                  nextName;
+    int                     activeUnit;
+    GLint                   viewport[4];
+};
+
+extern kexGLMock glMock;
+
+// from dglmock.cpp
+extern const int dglMockNumFuncs;
+extern const char *dglMockNames[];
+extern const char *dglMockExtensions;
+
+#endif // USE_MOCK_GLFUNCS
+
+#endif
@@ -31,6 +31,7 @@
 #include "image.h"
 #include "binFile.h"
 #include "fbo.h"
+#include "textureBuild.h"
 
 kexCvar cvarGamma("gl_gamma", CVF_FLOAT|CVF_CONFIG, "1", "TODO");
 
@@ -117,7 +118,13 @@ kexImageManager::kexImageManager(void) {
     this->height = 0;
     this->origwidth = 0;
     this->origheight = 0;
+    this->numLevels = 0;
     this->colorMode = TCR_RGBA;
+    this->compressMode = TCM_NONE;
+    this->bSourceColors = false;
+
+    memset(this->mips, 0, sizeof(this->mips));
+    memset(this->levelSize, 0, sizeof(this->levelSize));
 }
 
 //
@@ -125,9 +132,67 @@ kexImageManager::kexImageManager(void) {
 //
 
 kexImageManager::~kexImageManager(void) {
+    Free();
+}
+
+//
+// kexImageManager::Free
+//
+
+void kexImageManager::Free(void) {
     if(data) {
         delete[] data;
+        data = NULL;
+    }
+
+    for(int i = 0; i < IMG_MAX_LEVELS-1; i++) {
+        if(mips[i]) {
+            delete[] mips[i];
+            mips[i] = NULL;
+        }
+    }
+
+    numLevels = 0;
+    compressMode = TCM_NONE;
+}
+
+//
+// kexImageManager::TotalSize
+//
+
+const int kexImageManager::TotalSize(void) const {
+    int size = 0;
+
+    for(int i = 0; i < numLevels; i++) {
+        size += levelSize[i];
     }
+
+    return size;
+}
+
+//
+// kexImageManager::BakedName
+//
+// Name of the .ktex that stands in for a tga or bmp
+//
+
+bool kexImageManager::BakedName(const char *file, char *bakedFile) {
+    const char *ext = strrchr(file, '.');
+    int len;
+
+    if(ext == NULL || (strcmp(ext, ".tga") && strcmp(ext, ".bmp"))) {
+        return false;
+    }
+
+    len = (int)(ext - file);
+
+    if(len + 6 > MAX_FILEPATH) {
+        return false;
+    }
+
+    strncpy(bakedFile, file, len);
+    strcpy(bakedFile + len, ".ktex");
+    return true;
 }
 
 //
@@ -137,7 +202,7 @@ kexImageManager::~kexImageManager(void) {
 byte kexImageManager::GetRGBGamma(int c) {
     float f = cvarGamma.GetFloat();
     
-    if(f == 1.0f) {
+    if(f == 1.0f || bSourceColors) {
         return c;
     }
     
@@ -152,6 +217,9 @@ void kexImageManager::Alloc(void) {
     int size = width * height * (colorMode == TCR_RGBA ? 4 : 3);
 
     data = new byte[size];
+    levelSize[0] = size;
+    numLevels = 1;
+    compressMode = TCM_NONE;
 
     if(width != origwidth || height != origheight) {
         memset(data, 0, size);
@@ -161,28 +229,63 @@ void kexImageManager::Alloc(void) {
 //
 // kexImageManager::LoadFromFile
 //
+// A baked .ktex of the same name is loaded in place of the file if
+// there is one. bSource skips it and leaves the colors as they are
+// in the file, which is what the texture builder wants
+//
 
-void kexImageManager::LoadFromFile(const char *file) {
+void kexImageManager::LoadFromFile(const char *file, const bool bSource) {
+    filepath_t bakedFile;
     byte *fileData;
+    int size;
     
+    bSourceColors = bSource;
+
+    if(!bSource && BakedName(file, bakedFile) &&
+        (size = fileSystem.OpenFile(bakedFile, &fileData, hb_static)) > 0) {
+        LoadFromMemory(bakedFile, fileData, size);
+        Mem_Free(fileData);
+
+        if(data) {
+            strcpy(filePath, file);
+            return;
+        }
+    }
+
     strcpy(filePath, file);
     
-    if(fileSystem.OpenFile(file, &fileData, hb_static) == 0) {
+    if((size = fileSystem.OpenFile(file, &fileData, hb_static)) <= 0) {
         return;
     }
 
-    if(strstr(file, ".tga")) {
-        LoadFromTGA(fileData);
+    LoadFromMemory(file, fileData, size);
+    Mem_Free(fileData);
+}
+
+//
+// kexImageManager::LoadFromMemory
+//
+// Decodes a file that's already been read in. Doesn't touch the zone
+// or the GL so the texture loader can call it from the job threads
+//
+
+void kexImageManager::LoadFromMemory(const char *file, byte *input, const int size) {
+    strcpy(filePath, file);
+    Free();
+
+    if(strstr(file, ".ktex")) {
+        LoadFromKTEX(input, size);
+    }
+    else if(strstr(file, ".tga")) {
+        LoadFromTGA(input);
     }
     else if(strstr(file, ".bmp")) {
-        LoadFromBMP(fileData);
+        LoadFromBMP(input);
     }
     else {
         data = NULL;
-        common.Warning("kexImageManager::LoadFromFile(%s) - Unknown file format\n", file);
+        common.Warning(LC_RENDER, "kexImageManager::LoadFromFile(%s) - Unknown file format\n", file);
     }
-
-    Mem_Free(fileData);
 }
 
 //
@@ -208,6 +311,7 @@ void kexImageManager::LoadFromScreenBuffer(void) {
     
     dglGetIntegerv(GL_PACK_ALIGNMENT, &pack);
     dglPixelStorei(GL_PACK_ALIGNMENT, 1);
+    cpuVertList.Flush();
     dglFlush();
     dglReadPixels(x, y, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
     dglPixelStorei(GL_PACK_ALIGNMENT, pack);
@@ -234,6 +338,7 @@ void kexImageManager::LoadFromFrameBuffer(kexFBO &fbo) {
     
     dglGetIntegerv(GL_PACK_ALIGNMENT, &pack);
     dglPixelStorei(GL_PACK_ALIGNMENT, 1);
+    cpuVertList.Flush();
     dglFlush();
     dglReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
     dglPixelStorei(GL_PACK_ALIGNMENT, pack);
@@ -400,6 +505,149 @@ void kexImageManager::LoadFromTGA(byte *input) {
     }
 }
 
+//
+// kexImageManager::LoadFromKTEX
+//
+// Levels are kept as they were baked. Block compressed levels are
+// unpacked if the card can't take them, and gamma can only be applied
+// to levels that aren't compressed
+//
+
+void kexImageManager::LoadFromKTEX(byte *input, const int size) {
+    byte *rover = input;
+    byte *end = input + size;
+    byte *level;
+    byte *unpacked;
+    ktexHeader_t ktex;
+    int channels;
+    int expected;
+    int w, h;
+
+    data = NULL;
+
+    if(size < (int)sizeof(ktexHeader_t) || memcmp(input, "KTEX", 4)) {
+        common.Warning(LC_RENDER, "%s is not a baked texture\n", filePath);
+        return;
+    }
+
+    rover += 4;
+    ktex.version    = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.width      = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.height     = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.origwidth  = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.origheight = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.format     = sysMain.SwapLE32(*(int*)rover); rover += 4;
+    ktex.numLevels  = sysMain.SwapLE32(*(int*)rover); rover += 4;
+
+    if(ktex.version != KTEX_VERSION) {
+        common.Warning(LC_RENDER, "%s has version %i (%i supported)\n", filePath, ktex.version, KTEX_VERSION);
+        return;
+    }
+
+    if(ktex.width <= 0 || ktex.height <= 0 || ktex.numLevels <= 0 || ktex.numLevels > IMG_MAX_LEVELS) {
+        common.Warning(LC_RENDER, "%s has a bad header\n", filePath);
+        return;
+    }
+
+    switch(ktex.format) {
+    case KTEX_RGB8:
+        colorMode = TCR_RGB;
+        compressMode = TCM_NONE;
+        break;
+    case KTEX_RGBA8:
+        colorMode = TCR_RGBA;
+        compressMode = TCM_NONE;
+        break;
+    case KTEX_BC1:
+        colorMode = TCR_RGB;
+        compressMode = TCM_BC1;
+        break;
+    case KTEX_BC3:
+        colorMode = TCR_RGBA;
+        compressMode = TCM_BC3;
+        break;
+    default:
+        common.Warning(LC_RENDER, "%s has unknown format %i\n", filePath, ktex.format);
+        return;
+    }
+
+    width = ktex.width;
+    height = ktex.height;
+    origwidth = ktex.origwidth;
+    origheight = ktex.origheight;
+    channels = (colorMode == TCR_RGBA) ? 4 : 3;
+
+    for(int i = 0; i < ktex.numLevels; i++) {
+        w = MAX(width >> i, 1);
+        h = MAX(height >> i, 1);
+
+        if(compressMode != TCM_NONE) {
+            expected = kexTextureBuilder::CompressedSize(w, h, compressMode);
+        }
+        else {
+            expected = w * h * channels;
+        }
+
+        if(end - rover < 4 || sysMain.SwapLE32(*(int*)rover) != expected ||
+            end - (rover + 4) < expected) {
+            common.Warning(LC_RENDER, "%s is truncated\n", filePath);
+            Free();
+            return;
+        }
+
+        rover += 4;
+
+        level = new byte[expected];
+        memcpy(level, rover, expected);
+        rover += expected;
+
+        if(i == 0) {
+            data = level;
+        }
+        else {
+            mips[i-1] = level;
+        }
+
+        levelSize[i] = expected;
+        numLevels = i + 1;
+    }
+
+    if(compressMode != TCM_NONE && !renderBackend.SupportsTextureCompression()) {
+        for(int i = 0; i < numLevels; i++) {
+            w = MAX(width >> i, 1);
+            h = MAX(height >> i, 1);
+            level = (i == 0) ? data : mips[i-1];
+            unpacked = new byte[w * h * channels];
+
+            kexTextureBuilder::Decompress(level, w, h, channels, compressMode, unpacked);
+            delete[] level;
+
+            if(i == 0) {
+                data = unpacked;
+            }
+            else {
+                mips[i-1] = unpacked;
+            }
+
+            levelSize[i] = w * h * channels;
+        }
+
+        compressMode = TCM_NONE;
+    }
+
+    if(compressMode == TCM_NONE && !bSourceColors && cvarGamma.GetFloat() != 1.0f) {
+        for(int i = 0; i < numLevels; i++) {
+            level = (i == 0) ? data : mips[i-1];
+
+            for(int j = 0; j < levelSize[i]; j += channels) {
+                level[j + 0] = GetRGBGamma(level[j + 0]);
+                level[j + 1] = GetRGBGamma(level[j + 1]);
+                level[j + 2] = GetRGBGamma(level[j + 2]);
+            }
+        }
+    }
+}
+
 //
 // kexImageManager::WriteTGA
 //
@@ -28,6 +28,14 @@ typedef enum {
     TCR_RGBA    = 1
 } texColorMode_t;
 
+typedef enum {
+    TCM_NONE    = 0,
+    TCM_BC1,
+    TCM_BC3
+} texCompressMode_t;
+
+#define IMG_MAX_LEVELS  16
+
 class kexFBO;
 
 class kexImageManager {
@@ -35,7 +43,8 @@ public:
                             kexImageManager(void);
                             ~kexImageManager(void);
 
-    void                    LoadFromFile(const char *file);
+    void                    LoadFromFile(const char *file, const bool bSource = false);
+    void                    LoadFromMemory(const char *file, byte *input, const int size);
     void                    LoadFromScreenBuffer(void);
     void                    LoadFromFrameBuffer(kexFBO &fbo);
     void                    FlipVertical(void);
@@ -47,19 +56,33 @@ public:
     const int               OriginalWidth(void) const { return origwidth; }
     const int               OriginalHeight(void) const { return origheight; }
     const texColorMode_t    ColorMode(void) const { return colorMode; }
+    const texCompressMode_t CompressMode(void) const { return compressMode; }
+    const int               NumLevels(void) const { return numLevels; }
+    const byte              *Level(const int level) const { return level == 0 ? data : mips[level-1]; }
+    const int               LevelSize(const int level) const { return levelSize[level]; }
+    const int               TotalSize(void) const;
+
+    static bool             BakedName(const char *file, char *bakedFile);
 
 private:
     void                    LoadFromTGA(byte *input);
     void                    LoadFromBMP(byte *input);
+    void                    LoadFromKTEX(byte *input, const int size);
     byte                    GetRGBGamma(int c);
     void                    Alloc(void);
+    void                    Free(void);
     
     byte                    *data;
+    byte                    *mips[IMG_MAX_LEVELS-1];
+    int                     levelSize[IMG_MAX_LEVELS];
+    int                     numLevels;
     int                     width;
     int                     height;
     int                     origwidth;
     int                     origheight;
     texColorMode_t          colorMode;
+    texCompressMode_t       compressMode;
+    bool                    bSourceColors;
     filepath_t              filePath;
 };
 
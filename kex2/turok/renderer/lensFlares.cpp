@@ -74,7 +74,7 @@ void kexLensFlares::LoadKLF(const char *file) {
     filepath_t fileName;
 
     if(!(lexer = parser.Open(file))) {
-        common.Warning("kexLensFlares::LoadKLF: %s not found\n", file);
+        common.Warning(LC_RENDER, "kexLensFlares::LoadKLF: %s not found\n", file);
         return;
     }
 
@@ -233,7 +233,8 @@ void kexMaterial::ParseSampler(kexLexer *lexer) {
     stateBits |= BIT(GLSTATE_TEXTURE0 + unit);
     sampler->texture = renderBackend.CacheTexture(texFile.c_str(),
                                                  sampler->clamp,
-                                                 sampler->filter);
+                                                 sampler->filter,
+                                                 true);
 }
 
 //
@@ -377,6 +378,20 @@ void kexMaterial::Parse(kexLexer *lexer) {
     renderBackend.DisableShaders();
 }
 
+//
+// kexMaterial::Touch
+//
+// Marks the material's textures as used by the current map
+//
+
+void kexMaterial::Touch(void) {
+    for(int i = 0; i < MAX_SAMPLER_UNITS; i++) {
+        if(samplers[i].texture) {
+            samplers[i].texture->Touch();
+        }
+    }
+}
+
 //
 // kexMaterialManager::OnLoad
 //
@@ -400,7 +415,7 @@ kexMaterial *kexMaterialManager::OnLoad(const char *file) {
     tStr[pos] = 0;
     
     if(!(lexer = parser.Open(tStr))) {
-        common.Warning("kexMaterialManager::Load: %s not found\n", tStr);
+        common.Warning(LC_RENDER, "kexMaterialManager::Load: %s not found\n", tStr);
         return NULL;
     }
 
@@ -422,7 +437,7 @@ kexMaterial *kexMaterialManager::OnLoad(const char *file) {
     }
 
     if(bFoundMaterial == false) {
-        common.Warning("kexMaterialManager::Load: %s not found\n", tStr);
+        common.Warning(LC_RENDER, "kexMaterialManager::Load: %s not found\n", tStr);
         parser.Close();
         return NULL;
     }
@@ -432,3 +447,11 @@ kexMaterial *kexMaterialManager::OnLoad(const char *file) {
 
     return material;
 }
+
+//
+// kexMaterialManager::OnReuse
+//
+
+void kexMaterialManager::OnReuse(kexMaterial *material) {
+    material->Touch();
+}
@@ -72,6 +72,7 @@ public:
     void                                SetDiffuseColor(const rcolor color);
     void                                SetRenderState(void) const;
     void                                BindImages(void) const;
+    void                                Touch(void);
     
     const glCullType_t                  CullType(void) const { return cullType; }
     const glFunctions_t                 AlphaFunction(void) const { return alphaFunction; }
@@ -113,6 +114,7 @@ private:
 class kexMaterialManager : public kexResourceManager<kexMaterial> {
 public:
     kexMaterial     *OnLoad(const char *file);
+    void            OnReuse(kexMaterial *material);
 };
 
 #endif
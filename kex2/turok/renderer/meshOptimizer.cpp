@@ -0,0 +1,411 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Load time mesh processing
+//
+// Surfaces come out of the kmesh files with every triangle owning
+// its own corners. They're welded back together, the triangles are
+// reordered so each vertex gets used while it's still in the post
+// transform cache (Tipsify, Sander et al. 2007) and the vertices are
+// then laid out in the order the triangles first fetch them
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "meshOptimizer.h"
+
+//
+// MeshOpt_HashVertex
+//
+
+static unsigned int MeshOpt_HashVertex(const surfaceVertex_t *vertex) {
+    const byte *data = reinterpret_cast<const byte*>(vertex);
+    unsigned int hash = 2166136261U;
+
+    for(unsigned int i = 0; i < sizeof(surfaceVertex_t); i++) {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+
+    return hash;
+}
+
+//
+// MeshOpt_SkipDeadEnd
+//
+// Picks up where the fan ran out of triangles, first from the
+// vertices emitted most recently and then from the lowest vertex
+// that still has something left to draw
+//
+
+static int MeshOpt_SkipDeadEnd(const int *live, const int *deadEnd, int &numDead,
+                               unsigned int &cursor, const unsigned int numVerts) {
+    while(numDead > 0) {
+        int v = deadEnd[--numDead];
+
+        if(live[v] > 0) {
+            return v;
+        }
+    }
+
+    for(; cursor < numVerts; cursor++) {
+        if(live[cursor] > 0) {
+            return cursor;
+        }
+    }
+
+    return -1;
+}
+
+//
+// kexMeshOptimizer::Optimize
+//
+
+void kexMeshOptimizer::Optimize(surface_t *surface, meshOptStats_t *stats) {
+    unsigned int numVerts = surface->numVerts;
+    unsigned int before;
+
+    if(surface->verts == NULL || surface->indices == NULL ||
+        numVerts == 0 || surface->numIndices < 3) {
+        ComputeBounds(surface->verts, numVerts, surface->bounds);
+        return;
+    }
+
+    // leave broken meshes the way they were loaded
+    for(unsigned int i = 0; i < surface->numIndices; i++) {
+        if(surface->indices[i] >= numVerts) {
+            ComputeBounds(surface->verts, numVerts, surface->bounds);
+            return;
+        }
+    }
+
+    before = CacheMisses(surface->indices, surface->numIndices, numVerts);
+
+    surface->numVerts = WeldVertices(surface->verts, numVerts,
+                                     surface->indices, surface->numIndices);
+
+    OrderTriangles(surface->indices, surface->numIndices, surface->numVerts);
+    OrderVertices(surface->verts, surface->numVerts, surface->indices, surface->numIndices);
+    ComputeBounds(surface->verts, surface->numVerts, surface->bounds);
+
+    if(stats) {
+        stats->numSurfaces++;
+        stats->numTriangles += surface->numIndices / 3;
+        stats->numVertsIn += numVerts;
+        stats->numVertsOut += surface->numVerts;
+        stats->missesBefore += before;
+        stats->missesAfter += CacheMisses(surface->indices, surface->numIndices,
+                                          surface->numVerts);
+    }
+}
+
+//
+// kexMeshOptimizer::WeldVertices
+//
+// Merges vertices that match in every attribute and points the
+// indices at what's left. Returns the new vertex count
+//
+
+unsigned int kexMeshOptimizer::WeldVertices(surfaceVertex_t *verts, const unsigned int numVerts,
+                                            word *indices, const unsigned int numIndices) {
+    unsigned int numBuckets = 1;
+    unsigned int numUnique = 0;
+    unsigned int hash;
+    int *buckets;
+    int *chain;
+    word *remap;
+    int j;
+
+    if(numVerts == 0) {
+        return 0;
+    }
+
+    while(numBuckets < numVerts * 2) {
+        numBuckets <<= 1;
+    }
+
+    buckets = (int*)Mem_Malloc(sizeof(int) * numBuckets, hb_static);
+    chain   = (int*)Mem_Malloc(sizeof(int) * numVerts, hb_static);
+    remap   = (word*)Mem_Malloc(sizeof(word) * numVerts, hb_static);
+
+    memset(buckets, 0xff, sizeof(int) * numBuckets);
+
+    for(unsigned int i = 0; i < numVerts; i++) {
+        hash = MeshOpt_HashVertex(&verts[i]) & (numBuckets - 1);
+
+        for(j = buckets[hash]; j != -1; j = chain[j]) {
+            if(!memcmp(&verts[j], &verts[i], sizeof(surfaceVertex_t))) {
+                break;
+            }
+        }
+
+        if(j != -1) {
+            remap[i] = j;
+            continue;
+        }
+
+        // never ahead of i, so nothing unread gets overwritten
+        if(numUnique != i) {
+            verts[numUnique] = verts[i];
+        }
+
+        chain[numUnique] = buckets[hash];
+        buckets[hash] = numUnique;
+        remap[i] = numUnique++;
+    }
+
+    for(unsigned int i = 0; i < numIndices; i++) {
+        indices[i] = remap[indices[i]];
+    }
+
+    Mem_Free(buckets);
+    Mem_Free(chain);
+    Mem_Free(remap);
+
+    return numUnique;
+}
+
+//
+// kexMeshOptimizer::OrderTriangles
+//
+// Fans out around one vertex at a time, moving on to whichever
+// neighbor will still be in the cache after its remaining triangles
+// are drawn. Winding is kept as is
+//
+
+void kexMeshOptimizer::OrderTriangles(word *indices, const unsigned int numIndices,
+                                      const unsigned int numVerts, const int cacheSize) {
+    unsigned int numTris = numIndices / 3;
+    unsigned int numOut = 0;
+    unsigned int cursor = 0;
+    int numDead = 0;
+    int numCandidates;
+    int stamp = cacheSize + 1;
+    int fanning = 0;
+    int *offsets;
+    int *adjacency;
+    int *live;
+    int *stamps;
+    int *deadEnd;
+    int *candidates;
+    byte *emitted;
+    word *output;
+
+    if(numTris == 0 || numVerts == 0) {
+        return;
+    }
+
+    offsets     = (int*)Mem_Calloc(sizeof(int) * (numVerts + 1), hb_static);
+    adjacency   = (int*)Mem_Malloc(sizeof(int) * numTris * 3, hb_static);
+    live        = (int*)Mem_Calloc(sizeof(int) * numVerts, hb_static);
+    stamps      = (int*)Mem_Calloc(sizeof(int) * numVerts, hb_static);
+    deadEnd     = (int*)Mem_Malloc(sizeof(int) * numTris * 3, hb_static);
+    candidates  = (int*)Mem_Malloc(sizeof(int) * numTris * 3, hb_static);
+    emitted     = (byte*)Mem_Calloc(numTris, hb_static);
+    output      = (word*)Mem_Malloc(sizeof(word) * numTris * 3, hb_static);
+
+    // triangles using each vertex
+    for(unsigned int i = 0; i < numTris * 3; i++) {
+        live[indices[i]]++;
+    }
+
+    for(unsigned int i = 0; i < numVerts; i++) {
+        offsets[i + 1] = offsets[i] + live[i];
+    }
+
+    // stamps are borrowed as fill counts until the walk starts
+    for(unsigned int i = 0; i < numTris * 3; i++) {
+        int v = indices[i];
+        adjacency[offsets[v] + stamps[v]++] = i / 3;
+    }
+
+    memset(stamps, 0, sizeof(int) * numVerts);
+
+    while(fanning >= 0) {
+        int best = -1;
+        int bestPriority = -1;
+
+        numCandidates = 0;
+
+        for(int a = offsets[fanning]; a < offsets[fanning + 1]; a++) {
+            int tri = adjacency[a];
+
+            if(emitted[tri]) {
+                continue;
+            }
+
+            for(int k = 0; k < 3; k++) {
+                int v = indices[tri * 3 + k];
+
+                output[numOut++] = v;
+                deadEnd[numDead++] = v;
+                candidates[numCandidates++] = v;
+                live[v]--;
+
+                if(stamp - stamps[v] > cacheSize) {
+                    stamps[v] = stamp++;
+                }
+            }
+
+            emitted[tri] = 1;
+        }
+
+        // prefer the oldest vertex that won't be pushed out by its own triangles
+        for(int c = 0; c < numCandidates; c++) {
+            int v = candidates[c];
+            int priority = 0;
+
+            if(live[v] <= 0) {
+                continue;
+            }
+
+            if(stamp - stamps[v] + 2 * live[v] <= cacheSize) {
+                priority = stamp - stamps[v];
+            }
+
+            if(priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+
+        if(best == -1) {
+            best = MeshOpt_SkipDeadEnd(live, deadEnd, numDead, cursor, numVerts);
+        }
+
+        fanning = best;
+    }
+
+    memcpy(indices, output, sizeof(word) * numOut);
+
+    Mem_Free(offsets);
+    Mem_Free(adjacency);
+    Mem_Free(live);
+    Mem_Free(stamps);
+    Mem_Free(deadEnd);
+    Mem_Free(candidates);
+    Mem_Free(emitted);
+    Mem_Free(output);
+}
+
+//
+// kexMeshOptimizer::OrderVertices
+//
+// Lays the vertices out in the order the indices first use them.
+// Anything no triangle uses is kept at the end
+//
+
+void kexMeshOptimizer::OrderVertices(surfaceVertex_t *verts, const unsigned int numVerts,
+                                     word *indices, const unsigned int numIndices) {
+    surfaceVertex_t *sorted;
+    int *remap;
+    int next = 0;
+
+    if(numVerts == 0) {
+        return;
+    }
+
+    sorted  = (surfaceVertex_t*)Mem_Malloc(sizeof(surfaceVertex_t) * numVerts, hb_static);
+    remap   = (int*)Mem_Malloc(sizeof(int) * numVerts, hb_static);
+
+    memset(remap, 0xff, sizeof(int) * numVerts);
+
+    for(unsigned int i = 0; i < numIndices; i++) {
+        int v = indices[i];
+
+        if(remap[v] == -1) {
+            remap[v] = next;
+            sorted[next++] = verts[v];
+        }
+
+        indices[i] = remap[v];
+    }
+
+    for(unsigned int i = 0; i < numVerts; i++) {
+        if(remap[i] == -1) {
+            sorted[next++] = verts[i];
+        }
+    }
+
+    for(unsigned int i = 0; i < numVerts; i++) {
+        verts[i] = sorted[i];
+    }
+
+    Mem_Free(sorted);
+    Mem_Free(remap);
+}
+
+//
+// kexMeshOptimizer::ComputeBounds
+//
+
+void kexMeshOptimizer::ComputeBounds(const surfaceVertex_t *verts, const unsigned int numVerts,
+                                     kexBBox &bounds) {
+    if(verts == NULL || numVerts == 0) {
+        bounds.Clear();
+        return;
+    }
+
+    bounds.min = verts[0].xyz;
+    bounds.max = verts[0].xyz;
+
+    for(unsigned int i = 1; i < numVerts; i++) {
+        const kexVec3 &xyz = verts[i].xyz;
+
+        for(int j = 0; j < 3; j++) {
+            if(xyz[j] < bounds.min[j]) bounds.min[j] = xyz[j];
+            if(xyz[j] > bounds.max[j]) bounds.max[j] = xyz[j];
+        }
+    }
+}
+
+//
+// kexMeshOptimizer::CacheMisses
+//
+// Counts the vertices a FIFO post transform cache would have to
+// run through the vertex program again. Divided by the number of
+// triangles that's the average cache miss ratio (ACMR)
+//
+
+unsigned int kexMeshOptimizer::CacheMisses(const word *indices, const unsigned int numIndices,
+                                           const unsigned int numVerts, const int cacheSize) {
+    unsigned int misses = 0;
+    int stamp = cacheSize + 1;
+    int *stamps;
+
+    if(numVerts == 0) {
+        return 0;
+    }
+
+    stamps = (int*)Mem_Calloc(sizeof(int) * numVerts, hb_static);
+
+    for(unsigned int i = 0; i < numIndices; i++) {
+        int v = indices[i];
+
+        if(stamp - stamps[v] > cacheSize) {
+            stamps[v] = stamp++;
+            misses++;
+        }
+    }
+
+    Mem_Free(stamps);
+    return misses;
+}
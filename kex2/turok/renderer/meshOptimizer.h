@@ -0,0 +1,58 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __MESHOPTIMIZER_H__
+#define __MESHOPTIMIZER_H__
+
+#include "renderMain.h"
+
+// entries in the post transform cache the index order is tuned for.
+// older hardware had anywhere from 10 to 24, 16 is a fair middle
+#define MESHOPT_CACHE_SIZE      16
+
+typedef struct {
+    unsigned int            numSurfaces;
+    unsigned int            numTriangles;
+    unsigned int            numVertsIn;
+    unsigned int            numVertsOut;
+    unsigned int            missesBefore;
+    unsigned int            missesAfter;
+} meshOptStats_t;
+
+class kexMeshOptimizer {
+public:
+    static void             Optimize(surface_t *surface, meshOptStats_t *stats = NULL);
+    static unsigned int     WeldVertices(surfaceVertex_t *verts, const unsigned int numVerts,
+                                         word *indices, const unsigned int numIndices);
+    static void             OrderTriangles(word *indices, const unsigned int numIndices,
+                                           const unsigned int numVerts,
+                                           const int cacheSize = MESHOPT_CACHE_SIZE);
+    static void             OrderVertices(surfaceVertex_t *verts, const unsigned int numVerts,
+                                          word *indices, const unsigned int numIndices);
+    static void             ComputeBounds(const surfaceVertex_t *verts, const unsigned int numVerts,
+                                          kexBBox &bounds);
+    static unsigned int     CacheMisses(const word *indices, const unsigned int numIndices,
+                                        const unsigned int numVerts,
+                                        const int cacheSize = MESHOPT_CACHE_SIZE);
+};
+
+#endif
@@ -51,6 +51,7 @@ GL_ARB_shader_objects_Define();
 GL_ARB_framebuffer_object_Define();
 GL_ARB_occlusion_query_Define();
 GL_EXT_texture_array_Define();
+GL_ARB_texture_compression_Define();
 
 //
 // statglbackend
@@ -117,11 +118,11 @@ static bool FindExtension(const char *ext) {
 
 bool GL_CheckExtension(const char *ext) {
     if(FindExtension(ext)) {
-        common.Printf("GL Extension: %s = true\n", ext);
+        common.Printf(LC_RENDER, "GL Extension: %s = true\n", ext);
         return true;
     }
     else {
-        common.Warning("GL Extension: %s = false\n", ext);
+        common.Warning(LC_RENDER, "GL Extension: %s = false\n", ext);
     }
     
     return false;
@@ -132,10 +133,14 @@ bool GL_CheckExtension(const char *ext) {
 //
 
 void* GL_RegisterProc(const char *address) {
+#ifdef USE_MOCK_GLFUNCS
+    void *proc = dglMockProc(address);
+#else
     void *proc = sysMain.GetProcAddress(address);
+#endif
     
     if(!proc) {
-        common.Warning("GL_RegisterProc: Failed to get proc address: %s", address);
+        common.Warning(LC_RENDER, "GL_RegisterProc: Failed to get proc address: %s", address);
         return NULL;
     }
     
@@ -158,6 +163,7 @@ kexRenderBackend::kexRenderBackend(void) {
     this->bWideScreen               = false;
     this->bFullScreen               = false;
     this->bIsInit                   = false;
+    this->bTextureCompression       = false;
     this->glState.glStateBits       = 0;
     this->glState.alphaFunction     = -1;
     this->glState.blendDest         = -1;
@@ -168,6 +174,10 @@ kexRenderBackend::kexRenderBackend(void) {
     this->glState.currentUnit       = -1;
     this->glState.currentProgram    = 0;
     this->glState.currentFBO        = 0;
+    this->glState.currentVertexBuffer = 0;
+    this->glState.currentIndexBuffer  = 0;
+    this->glState.depthFunction     = -1;
+    this->glState.polyMode          = -1;
     this->frameBuffer               = NULL;
     this->depthBuffer               = NULL;
     this->validFrameNum             = 0;
@@ -262,6 +272,10 @@ void kexRenderBackend::SetDefaultState(void) {
     glState.currentUnit     = -1;
     glState.currentProgram  = 0;
     glState.currentFBO      = 0;
+    glState.currentVertexBuffer = 0;
+    glState.currentIndexBuffer  = 0;
+    glState.depthFunction   = -1;
+    glState.polyMode        = -1;
     
     validFrameNum           = 0;
     
@@ -308,12 +322,12 @@ void kexRenderBackend::Init(void) {
     dglGetIntegerv(GL_MAX_TEXTURE_UNITS_ARB, &maxTextureUnits);
     dglGetIntegerv(GL_MAX_COLOR_ATTACHMENTS_EXT, &maxColorAttachments);
     
-    common.Printf("GL_VENDOR: %s\n", gl_vendor);
-    common.Printf("GL_RENDERER: %s\n", gl_renderer);
-    common.Printf("GL_VERSION: %s\n", gl_version);
-    common.Printf("GL_MAX_TEXTURE_SIZE: %i\n", maxTextureSize);
-    common.Printf("GL_MAX_TEXTURE_UNITS_ARB: %i\n", maxTextureUnits);
-    common.Printf("GL_MAX_COLOR_ATTACHMENTS_EXT: %i\n", maxColorAttachments);
+    common.Printf(LC_RENDER, "GL_VENDOR: %s\n", gl_vendor);
+    common.Printf(LC_RENDER, "GL_RENDERER: %s\n", gl_renderer);
+    common.Printf(LC_RENDER, "GL_VERSION: %s\n", gl_version);
+    common.Printf(LC_RENDER, "GL_MAX_TEXTURE_SIZE: %i\n", maxTextureSize);
+    common.Printf(LC_RENDER, "GL_MAX_TEXTURE_UNITS_ARB: %i\n", maxTextureUnits);
+    common.Printf(LC_RENDER, "GL_MAX_COLOR_ATTACHMENTS_EXT: %i\n", maxColorAttachments);
 
     GL_ARB_multitexture_Init();
     GL_EXT_compiled_vertex_array_Init();
@@ -327,6 +341,10 @@ void kexRenderBackend::Init(void) {
     GL_ARB_framebuffer_object_Init();
     GL_ARB_occlusion_query_Init();
     GL_EXT_texture_array_Init();
+    GL_ARB_texture_compression_Init();
+
+    bTextureCompression = (has_GL_ARB_texture_compression &&
+                           GL_CheckExtension("GL_EXT_texture_compression_s3tc"));
 
     SetDefaultState();
 
@@ -352,7 +370,7 @@ void kexRenderBackend::Init(void) {
 
     bIsInit = true;
 
-    common.Printf("Backend Renderer Initialized\n");
+    common.Printf(LC_RENDER, "Backend Renderer Initialized\n");
 }
 
 //
@@ -362,7 +380,9 @@ void kexRenderBackend::Init(void) {
 void kexRenderBackend::Shutdown(void) {
     kexTexture *texture;
 
-    common.Printf("Shutting down render system\n");
+    common.Printf(LC_RENDER, "Shutting down render system\n");
+
+    textureLoader.Shutdown();
 
     defaultTexture.Delete();
     whiteTexture.Delete();
@@ -374,10 +394,12 @@ void kexRenderBackend::Shutdown(void) {
     kexFont::manager.Shutdown();
     kexLensFlares::manager.Shutdown();
 
-    for(int i = 0; i < MAX_HASH; i++) {
-        for(texture = textureList.GetData(i); texture; texture = textureList.Next()) {
-            texture->Delete();
-        }
+    vertexBufferPool.Shutdown();
+    indexBufferPool.Shutdown();
+    cpuVertList.Shutdown();
+
+    for(texture = textureList.First(); texture; texture = textureList.Next()) {
+        texture->Delete();
     }
 
     // do last round of texture flushing to make sure we freed everything
@@ -391,6 +413,7 @@ void kexRenderBackend::Shutdown(void) {
 void kexRenderBackend::SetOrtho(void) {
     kexMatrix mtx;
 
+    cpuVertList.Flush();
     dglMatrixMode(GL_PROJECTION);
     dglLoadIdentity();
 
@@ -406,6 +429,8 @@ void kexRenderBackend::SetOrtho(void) {
 //
 
 void kexRenderBackend::SwapBuffers(void) {
+    cpuVertList.EndFrame();
+
     if(cvarRenderFinish.GetBool()) {
         dglFinish();
     }
@@ -413,8 +438,13 @@ void kexRenderBackend::SwapBuffers(void) {
     sysMain.SwapBuffers();
     validFrameNum++;
 
-    glState.numStateChanges = 0;
-    glState.numTextureBinds = 0;
+    textureLoader.Pump();
+
+    glState.numStateChanges     = 0;
+    glState.numTextureBinds     = 0;
+    glState.numProgramBinds     = 0;
+    glState.numUniformUploads   = 0;
+    glState.numSkippedCalls     = 0;
 }
 
 //
@@ -439,6 +469,7 @@ void kexRenderBackend::ClearBuffer(const glClearBit_t bit) {
         }
     }
     
+    cpuVertList.Flush();
     dglClear(clearBit);
 }
 
@@ -451,6 +482,7 @@ void kexRenderBackend::SetScissorRect(const int x, const int y, const int w, con
         return;
     }
 
+    cpuVertList.Flush();
     dglScissor(x, y, w, h);
 }
 
@@ -506,20 +538,25 @@ void kexRenderBackend::SetState(const int bits, bool bEnable) {
             stateFlag = GL_SCISSOR_TEST;
             break;
         default:
-            common.Warning("kexRenderBackend::SetState: unknown bit flag: %i\n", bits);
+            common.Warning(LC_RENDER, "kexRenderBackend::SetState: unknown bit flag: %i\n", bits);
             return;
     }
     
     if(bEnable && !(glState.glStateBits & (1 << bits))) {
+        cpuVertList.Flush();
         dglEnable(stateFlag);
         glState.glStateBits |= (1 << bits);
         glState.numStateChanges++;
     }
     else if(!bEnable && (glState.glStateBits & (1 << bits))) {
+        cpuVertList.Flush();
         dglDisable(stateFlag);
         glState.glStateBits &= ~(1 << bits);
         glState.numStateChanges++;
     }
+    else {
+        glState.numSkippedCalls++;
+    }
 }
 
 //
@@ -546,6 +583,7 @@ void kexRenderBackend::SetAlphaFunc(int func, float val) {
         (glState.alphaFuncThreshold != val);
         
     if(pFunc == 0) {
+        glState.numSkippedCalls++;
         return;
     }
     
@@ -569,7 +607,9 @@ void kexRenderBackend::SetAlphaFunc(int func, float val) {
             break;
     }
     
-    dglAlphaFunc(glFunc, val);   
+    cpuVertList.Flush();
+    dglAlphaFunc(glFunc, val);
+    glState.numStateChanges++;
     glState.alphaFunction = func;
     glState.alphaFuncThreshold = val;
 }
@@ -582,6 +622,7 @@ void kexRenderBackend::SetDepth(int func) {
     int pFunc = glState.depthFunction ^ func;
     
     if(pFunc == 0) {
+        glState.numSkippedCalls++;
         return;
     }
     
@@ -605,7 +646,9 @@ void kexRenderBackend::SetDepth(int func) {
             break;
     }
     
+    cpuVertList.Flush();
     dglDepthFunc(glFunc);
+    glState.numStateChanges++;
     glState.depthFunction = func;
 }
 
@@ -617,6 +660,7 @@ void kexRenderBackend::SetBlend(int src, int dest) {
     int pBlend = (glState.blendSrc ^ src) | (glState.blendDest ^ dest);
     
     if(pBlend == 0) {
+        glState.numSkippedCalls++;
         return;
     }
     
@@ -680,7 +724,9 @@ void kexRenderBackend::SetBlend(int src, int dest) {
             break;
     }
     
+    cpuVertList.Flush();
     dglBlendFunc(glSrc, glDst);
+    glState.numStateChanges++;
     glState.blendSrc = src;
     glState.blendDest = dest;
 }
@@ -700,6 +746,7 @@ void kexRenderBackend::SetCull(int type) {
     int pCullType = glState.cullType ^ type;
     
     if(pCullType == 0) {
+        glState.numSkippedCalls++;
         return;
     }
         
@@ -716,7 +763,9 @@ void kexRenderBackend::SetCull(int type) {
             return;
     }
     
+    cpuVertList.Flush();
     dglCullFace(cullType);
+    glState.numStateChanges++;
     glState.cullType = type;
 }
 
@@ -728,6 +777,7 @@ void kexRenderBackend::SetPolyMode(int type) {
     int pPolyMode = glState.polyMode ^ type;
     
     if(pPolyMode == 0) {
+        glState.numSkippedCalls++;
         return;
     }
         
@@ -744,7 +794,9 @@ void kexRenderBackend::SetPolyMode(int type) {
             return;
     }
     
+    cpuVertList.Flush();
     dglPolygonMode(GL_FRONT_AND_BACK, polyMode);
+    glState.numStateChanges++;
     glState.polyMode = type;
 }
 
@@ -756,6 +808,7 @@ void kexRenderBackend::SetDepthMask(int enable) {
     int pEnable = glState.depthMask ^ enable;
     
     if(pEnable == 0) {
+        glState.numSkippedCalls++;
         return;
     }
     
@@ -772,7 +825,9 @@ void kexRenderBackend::SetDepthMask(int enable) {
             return;
     }
     
+    cpuVertList.Flush();
     dglDepthMask(flag);
+    glState.numStateChanges++;
     glState.depthMask = enable;
 }
 
@@ -784,6 +839,7 @@ void kexRenderBackend::SetColorMask(int enable) {
     int pEnable = glState.colormask ^ enable;
     
     if(pEnable == 0) {
+        glState.numSkippedCalls++;
         return;
     }
     
@@ -800,7 +856,9 @@ void kexRenderBackend::SetColorMask(int enable) {
             return;
     }
     
+    cpuVertList.Flush();
     dglColorMask(flag, flag, flag, flag);
+    glState.numStateChanges++;
     glState.colormask = enable;
 }
 
@@ -814,20 +872,121 @@ void kexRenderBackend::SetTextureUnit(int unit) {
     }
     
     if(unit == glState.currentUnit) {
+        glState.numSkippedCalls++;
         return;
     }
         
+    cpuVertList.Flush();
     dglActiveTextureARB(GL_TEXTURE0_ARB + unit);
     dglClientActiveTextureARB(GL_TEXTURE0_ARB + unit);
     glState.currentUnit = unit;
+    glState.numStateChanges++;
+}
+
+//
+// kexRenderBackend::BindTexture
+//
+// Binds to the current unit. Everything that binds a texture
+// goes through here, even just to upload it, so what's recorded
+// as bound is always what actually is
+//
+
+void kexRenderBackend::BindTexture(const dtexture tid) {
+    int unit = glState.currentUnit;
+
+    // nothing has picked a unit since the state was reset
+    if(unit < 0 || unit >= MAX_TEXTURE_UNITS) {
+        cpuVertList.Flush();
+        dglBindTexture(GL_TEXTURE_2D, tid);
+        glState.numTextureBinds++;
+        return;
+    }
+
+    if(glState.textureUnits[unit].currentTexture == tid) {
+        glState.numSkippedCalls++;
+        return;
+    }
+
+    cpuVertList.Flush();
+    dglBindTexture(GL_TEXTURE_2D, tid);
+    glState.textureUnits[unit].currentTexture = tid;
+    glState.numTextureBinds++;
+}
+
+//
+// kexRenderBackend::ForgetTexture
+//
+// Called before a texture is deleted. The driver may hand its id
+// out again for the next texture, which must not look bound
+//
+
+void kexRenderBackend::ForgetTexture(const dtexture tid) {
+    // a held back draw may still be using it
+    cpuVertList.Flush();
+
+    for(int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        if(glState.textureUnits[i].currentTexture == tid) {
+            glState.textureUnits[i].currentTexture = 0;
+        }
+    }
+}
+
+//
+// kexRenderBackend::BindVertexBuffer
+//
+
+void kexRenderBackend::BindVertexBuffer(const dtexture buffer) {
+    if(glState.currentVertexBuffer == buffer) {
+        glState.numSkippedCalls++;
+        return;
+    }
+
+    cpuVertList.Flush();
+    dglBindBufferARB(GL_ARRAY_BUFFER_ARB, buffer);
+    glState.currentVertexBuffer = buffer;
+    glState.numStateChanges++;
+}
+
+//
+// kexRenderBackend::BindIndexBuffer
+//
+
+void kexRenderBackend::BindIndexBuffer(const dtexture buffer) {
+    if(glState.currentIndexBuffer == buffer) {
+        glState.numSkippedCalls++;
+        return;
+    }
+
+    cpuVertList.Flush();
+    dglBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buffer);
+    glState.currentIndexBuffer = buffer;
+    glState.numStateChanges++;
+}
+
+//
+// kexRenderBackend::ForgetBuffer
+//
+// Same as ForgetTexture, for buffer objects
+//
+
+void kexRenderBackend::ForgetBuffer(const dtexture buffer) {
+    if(glState.currentVertexBuffer == buffer) {
+        glState.currentVertexBuffer = 0;
+    }
+    if(glState.currentIndexBuffer == buffer) {
+        glState.currentIndexBuffer = 0;
+    }
 }
 
 //
 // kexRenderBackend::CacheTexture
 //
+// bAsync leaves the decoding to the texture loader. Only for callers
+// that don't need the texture's size right away
+//
 
 kexTexture *kexRenderBackend::CacheTexture(const char *name, texClampMode_t clampMode,
-                                          texFilterMode_t filterMode) {
+                                          texFilterMode_t filterMode, const bool bAsync) {
     kexTexture *texture = NULL;
 
     if(name == NULL || name[0] == 0) {
@@ -837,7 +996,21 @@ kexTexture *kexRenderBackend::CacheTexture(const char *name, texClampMode_t clam
     if(!(texture = textureList.Find(name))) {
         texture = textureList.Add(name, kexTexture::hb_texture);
         texture->SetMasked(true);
-        texture->LoadFromFile(name, clampMode, filterMode);
+        texture->SetCached(true);
+
+        if(bAsync) {
+            texture->LoadAsync(name, clampMode, filterMode);
+        }
+        else {
+            texture->LoadFromFile(name, clampMode, filterMode);
+        }
+    }
+    else {
+        if(!bAsync && texture->IsPending()) {
+            textureLoader.Finish();
+        }
+
+        texture->Touch();
     }
 
     return texture;
@@ -849,8 +1022,10 @@ kexTexture *kexRenderBackend::CacheTexture(const char *name, texClampMode_t clam
 
 void kexRenderBackend::DisableShaders(void) {
     if(glState.currentProgram != 0) {
+        cpuVertList.Flush();
         dglUseProgramObjectARB(0);
         glState.currentProgram = 0;
+        glState.numProgramBinds++;
     }
 
     renderer.currentSurface = NULL;
@@ -871,7 +1046,7 @@ const int kexRenderBackend::GetDepthSizeComponent(void) {
         case 32:
             return GL_DEPTH_COMPONENT32_ARB;
         default:
-            common.Warning("GetDepthSizeComponent: unknown depth size (%i)", depthSize);
+            common.Warning(LC_RENDER, "GetDepthSizeComponent: unknown depth size (%i)", depthSize);
             break;
     }
     
@@ -883,6 +1058,7 @@ const int kexRenderBackend::GetDepthSizeComponent(void) {
 //
 
 void kexRenderBackend::RestoreFrameBuffer(void) {
+    cpuVertList.Flush();
     dglBindFramebuffer(GL_FRAMEBUFFER_EXT, 0);
     dglDrawBuffer(GL_BACK);
     dglReadBuffer(GL_BACK);
@@ -923,7 +1099,7 @@ void kexRenderBackend::ScreenShot(void) {
 
     file.Close();
 
-    common.Printf("Saved Screenshot %s\n", filePath.c_str());
+    common.Printf(LC_RENDER, "Saved Screenshot %s\n", filePath.c_str());
 }
 
 //
@@ -960,5 +1136,15 @@ void kexRenderBackend::PrintStats(void) {
 
     kexRenderUtils::PrintStatsText("state changes", ": %i", glState.numStateChanges);
     kexRenderUtils::PrintStatsText("texture binds", ": %i", glState.numTextureBinds);
+    kexRenderUtils::PrintStatsText("program binds", ": %i", glState.numProgramBinds);
+    kexRenderUtils::PrintStatsText("uniform uploads", ": %i", glState.numUniformUploads);
+    kexRenderUtils::PrintStatsText("gl calls issued", ": %i", glState.numStateChanges +
+        glState.numTextureBinds + glState.numProgramBinds + glState.numUniformUploads);
+    kexRenderUtils::PrintStatsText("gl calls skipped", ": %i", glState.numSkippedCalls);
+    kexRenderUtils::PrintStatsText("client draws", ": %i -> %i",
+        cpuVertList.FrameStats().numSubmits, cpuVertList.FrameStats().numDraws);
+    kexRenderUtils::PrintStatsText("client verts", ": %i / %i",
+        cpuVertList.FrameStats().peakVertices, cpuVertList.Capacity());
+    kexRenderUtils::PrintStatsText("client wraps", ": %i", cpuVertList.FrameStats().numWraps);
     kexRenderUtils::AddDebugLineSpacing();
 }
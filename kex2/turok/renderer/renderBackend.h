@@ -99,6 +99,7 @@ typedef enum {
 #include "canvas.h"
 #include "lensFlares.h"
 #include "fbo.h"
+#include "bufferPool.h"
 
 class kexRenderBackend {
 public:
@@ -122,6 +123,11 @@ public:
     void                            SetDepthMask(int enable);
     void                            SetColorMask(int enable);
     void                            SetTextureUnit(int unit);
+    void                            BindTexture(const dtexture tid);
+    void                            ForgetTexture(const dtexture tid);
+    void                            BindVertexBuffer(const dtexture buffer);
+    void                            BindIndexBuffer(const dtexture buffer);
+    void                            ForgetBuffer(const dtexture buffer);
     void                            SetViewDimensions(void);
     void                            SetScissorRect(const int x, const int y, const int w, const int h);
     void                            DisableShaders(void);
@@ -131,7 +137,8 @@ public:
     void                            DrawLoadingScreen(const char *text);
     void                            PrintStats(void);
     kexTexture                      *CacheTexture(const char *name, texClampMode_t clampMode,
-                                                  texFilterMode_t filterMode = TF_LINEAR);
+                                                  texFilterMode_t filterMode = TF_LINEAR,
+                                                  const bool bAsync = false);
 
     const int                       ViewWidth(void) const { return viewWidth; }
     const int                       ViewHeight(void) const { return viewHeight; }
@@ -145,6 +152,7 @@ public:
     const bool                      IsFullScreen(void) const { return bFullScreen; }
     kexCanvas                       &Canvas(void) { return canvas; }
     const bool                      IsInitialized(void) { return bIsInit; }
+    const bool                      SupportsTextureCompression(void) const { return bTextureCompression; }
     const int                       ValidFrameNum(void) const { return validFrameNum; }
 
     static const int                SCREEN_WIDTH        = 320;
@@ -182,9 +190,14 @@ public:
         int                         currentUnit;
         rhandle                     currentProgram;
         dtexture                    currentFBO;
+        dtexture                    currentVertexBuffer;
+        dtexture                    currentIndexBuffer;
         texUnit_t                   textureUnits[MAX_TEXTURE_UNITS];
         int                         numStateChanges;
         int                         numTextureBinds;
+        int                         numProgramBinds;
+        int                         numUniformUploads;
+        int                         numSkippedCalls;    // already set to what was asked for
     } glState_t;
 
     glState_t                       glState;
@@ -203,6 +216,7 @@ private:
     bool                            bWideScreen;
     bool                            bFullScreen;
     bool                            bIsInit;
+    bool                            bTextureCompression;
 
     kexHashList<kexTexture>         textureList;
 
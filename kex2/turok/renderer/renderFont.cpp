@@ -64,7 +64,7 @@ void kexFont::LoadKFont(const char *file) {
     filepath_t fileName;
     
     if(!(lexer = parser.Open(file))) {
-        common.Warning("kexFont::LoadKFont: %s not found\n", file);
+        common.Warning(LC_RENDER, "kexFont::LoadKFont: %s not found\n", file);
         return;
     }
     
@@ -136,7 +136,7 @@ void kexRenderer::Init(void) {
     kexShaderObj::RegisterParam<kexWorld>("uFogFar", &localWorld, &kexWorld::GetFogFar);
     kexShaderObj::RegisterParam<kexWorld>("uFogColor", &localWorld, &kexWorld::GetCurrentFogRGB);
 
-    common.Printf("Renderer Initialized\n");
+    common.Printf(LC_RENDER, "Renderer Initialized\n");
 }
 
 //
@@ -188,6 +188,7 @@ void kexRenderer::PrepareOcclusionQuery(void) {
     
     renderBackend.DisableShaders();
     
+    cpuVertList.Flush();
     dglDisableClientState(GL_NORMAL_ARRAY);
     dglDisableClientState(GL_TEXTURE_COORD_ARRAY);
     dglDisableClientState(GL_COLOR_ARRAY);
@@ -246,6 +247,45 @@ bool kexRenderer::GetOcclusionSampleResult(const unsigned int &query, const kexB
     return false;
 }
 
+//
+// kexRenderer::UploadSurface
+//
+// Copies a surface's geometry into the static buffer pools. The
+// surface keeps drawing from client memory if there's no room
+//
+
+void kexRenderer::UploadSurface(surface_t *surface) {
+    if(surface->verts == NULL || surface->indices == NULL) {
+        return;
+    }
+
+    if(!vertexBufferPool.Alloc(surface->verts, sizeof(surfaceVertex_t) * surface->numVerts,
+        surface->vertexBuffer, surface->vertexOffset)) {
+        return;
+    }
+
+    if(!indexBufferPool.Alloc(surface->indices, sizeof(word) * surface->numIndices,
+        surface->indexBuffer, surface->indexOffset)) {
+        vertexBufferPool.Free(surface->vertexBuffer, sizeof(surfaceVertex_t) * surface->numVerts);
+        surface->vertexBuffer = 0;
+    }
+}
+
+//
+// kexRenderer::ReleaseSurface
+//
+
+void kexRenderer::ReleaseSurface(surface_t *surface) {
+    if(surface->vertexBuffer) {
+        vertexBufferPool.Free(surface->vertexBuffer, sizeof(surfaceVertex_t) * surface->numVerts);
+        surface->vertexBuffer = 0;
+    }
+    if(surface->indexBuffer) {
+        indexBufferPool.Free(surface->indexBuffer, sizeof(word) * surface->numIndices);
+        surface->indexBuffer = 0;
+    }
+}
+
 //
 // kexRenderer::AddSurface
 //
@@ -292,6 +332,7 @@ void kexRenderer::DrawSurfaceList(drawSurfFunc_t function, const int start, cons
         for(int j = 0; j < numDrawList[i]; j++) {
             drawSurf = &drawSurfaces[i][j];
             
+            cpuVertList.Flush();
             dglPushMatrix();
             dglMultMatrixf(drawSurf->matrix.ToFloatPtr());
             
@@ -308,6 +349,11 @@ void kexRenderer::DrawSurfaceList(drawSurfFunc_t function, const int start, cons
             dglPopMatrix();
         }
     }
+
+    // everything else draws from client memory
+    renderBackend.BindVertexBuffer(0);
+    renderBackend.BindIndexBuffer(0);
+    currentSurface = NULL;
 }
 
 //
@@ -339,6 +385,56 @@ void kexRenderer::ClearSurfaceList(void) {
     ClearSurfaceList(0, NUMSORTORDERS);
 }
 
+//
+// kexRenderer::BindSurface
+//
+
+void kexRenderer::BindSurface(const surface_t *surface) {
+    const byte *base;
+    int stride = sizeof(surfaceVertex_t);
+
+    cpuVertList.Flush();
+
+    if(currentSurface == surface) {
+        return;
+    }
+
+    // pointers become offsets into whatever buffer is bound
+    if(surface->vertexBuffer) {
+        renderBackend.BindVertexBuffer(surface->vertexBuffer);
+        base = (const byte*)(size_t)surface->vertexOffset;
+    }
+    else {
+        renderBackend.BindVertexBuffer(0);
+        base = (const byte*)surface->verts;
+    }
+
+    renderBackend.BindIndexBuffer(surface->indexBuffer);
+
+    dglNormalPointer(GL_FLOAT, stride, base + SURFVERT_NORMAL);
+    dglTexCoordPointer(2, GL_FLOAT, stride, base + SURFVERT_ST);
+    dglVertexPointer(3, GL_FLOAT, stride, base + SURFVERT_XYZ);
+    dglColorPointer(4, GL_UNSIGNED_BYTE, stride, base + SURFVERT_RGBA);
+
+    currentSurface = surface;
+}
+
+//
+// kexRenderer::DrawSurfaceElements
+//
+
+void kexRenderer::DrawSurfaceElements(const surface_t *surface) {
+    BindSurface(surface);
+
+    if(surface->indexBuffer) {
+        dglDrawElements(GL_TRIANGLES, surface->numIndices, GL_UNSIGNED_SHORT,
+            (const GLvoid*)(size_t)surface->indexOffset);
+    }
+    else {
+        dglDrawElements(GL_TRIANGLES, surface->numIndices, GL_UNSIGNED_SHORT, surface->indices);
+    }
+}
+
 //
 // kexRenderer::DrawSurface
 //
@@ -378,16 +474,7 @@ void kexRenderer::DrawSurface(const drawSurface_t *drawSurf, kexMaterial *materi
     
     material->BindImages();
 
-    if(currentSurface != surface) {
-        dglNormalPointer(GL_FLOAT, sizeof(float)*3, surface->normals);
-        dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, surface->coords);
-        dglVertexPointer(3, GL_FLOAT, sizeof(kexVec3), surface->vertices);
-        dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, surface->rgb);
-        
-        currentSurface = surface;
-    }
-    
-    dglDrawElements(GL_TRIANGLES, surface->numIndices, GL_UNSIGNED_SHORT, surface->indices);
+    DrawSurfaceElements(surface);
 }
 
 //
@@ -423,16 +510,7 @@ void kexRenderer::DrawWireFrameSurface(const drawSurface_t *drawSurf, kexMateria
     
     material->BindImages();
 
-    if(currentSurface != surface) {
-        dglNormalPointer(GL_FLOAT, sizeof(float)*3, surface->normals);
-        dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, surface->coords);
-        dglVertexPointer(3, GL_FLOAT, sizeof(kexVec3), surface->vertices);
-        dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, surface->rgb);
-        
-        currentSurface = surface;
-    }
-    
-    dglDrawElements(GL_TRIANGLES, surface->numIndices, GL_UNSIGNED_SHORT, surface->indices);
+    DrawSurfaceElements(surface);
 }
 
 //
@@ -479,16 +557,7 @@ void kexRenderer::DrawBlackSurface(const drawSurface_t *drawSurf, kexMaterial *m
         renderBackend.blackTexture.Bind();
     }
     
-    if(currentSurface != surface) {
-        dglNormalPointer(GL_FLOAT, sizeof(float)*3, surface->normals);
-        dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, surface->coords);
-        dglVertexPointer(3, GL_FLOAT, sizeof(kexVec3), surface->vertices);
-        dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, surface->rgb);
-        
-        currentSurface = surface;
-    }
-    
-    dglDrawElements(GL_TRIANGLES, surface->numIndices, GL_UNSIGNED_SHORT, surface->indices);
+    DrawSurfaceElements(surface);
 }
 
 //
@@ -524,6 +593,9 @@ void kexRenderer::DrawFX(const fxDisplay_t *fxList, const int count) {
     renderBackend.SetAlphaFunc(GLFUNC_GEQUAL, 0.01f);
     renderBackend.SetDepthMask(0);
 
+    // a pending merged draw rebinds the client pointers when it flushes
+    cpuVertList.Flush();
+
     dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, spriteTexCoords);
     dglVertexPointer(3, GL_FLOAT, sizeof(float)*3, spriteVertices);
     dglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(byte)*4, spriteColors);
@@ -682,6 +754,8 @@ void kexRenderer::DrawScreenQuad(const kexFBO *fbo) {
         }
     }
     
+    cpuVertList.Flush();
+
     dglTexCoordPointer(2, GL_FLOAT, sizeof(float)*2, tcoords);
     dglVertexPointer(3, GL_FLOAT, sizeof(float)*3, verts);
     
@@ -894,6 +968,7 @@ void kexRenderer::ProcessBloom(void) {
     dglGetIntegerv(GL_VIEWPORT, vp);
 
     // resize viewport to account for FBO dimentions
+    cpuVertList.Flush();
     dglPushAttrib(GL_VIEWPORT_BIT);
     dglViewport(0, 0, fboBloom.Width(), fboBloom.Height());
     
@@ -912,6 +987,7 @@ void kexRenderer::ProcessBloom(void) {
     cpuVertList.DrawElementsNoShader();
 
     renderBackend.SetBlend(GLSRC_SRC_ALPHA, GLDST_ONE_MINUS_SRC_ALPHA);
+    cpuVertList.Flush();
     dglPopAttrib();
 }
 
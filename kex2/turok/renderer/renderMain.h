@@ -32,16 +32,31 @@ class kexTri;
 class kexShaderObj;
 class kexWorldObject;
 
+typedef struct {
+    kexVec3                 xyz;
+    float                   st[2];
+    float                   normal[3];
+    byte                    rgba[4];
+} surfaceVertex_t;
+
+// byte offsets of each attribute in a surfaceVertex_t
+#define SURFVERT_XYZ        0
+#define SURFVERT_ST         12
+#define SURFVERT_NORMAL     20
+#define SURFVERT_RGBA       32
+
 typedef struct {
     unsigned int            flags;
     unsigned int            numVerts;
     unsigned int            numIndices;
-    kexVec3                 *vertices;
-    float                   *coords;
-    float                   *normals;
-    byte                    *rgb;
+    surfaceVertex_t         *verts;
     word                    *indices;
     kexMaterial             *material;
+    kexBBox                 bounds;
+    dtexture                vertexBuffer;   // 0 if drawn from client memory
+    dtexture                indexBuffer;
+    unsigned int            vertexOffset;
+    unsigned int            indexOffset;
 } surface_t;
 
 typedef struct {
@@ -89,6 +104,8 @@ public:
     void                    TestBoundsForOcclusionQuery(const unsigned int &query, const kexBBox &bounds);
     void                    EndOcclusionQueryTest(void);
     bool                    GetOcclusionSampleResult(const unsigned int &query, const kexBBox &bounds);
+    void                    UploadSurface(surface_t *surface);
+    void                    ReleaseSurface(surface_t *surface);
 
     kexFBO                  &FBOLightScatter(void) { return fboLightScatter; }
     void                    ToggleLightScatter(const bool bEnable) { bRenderLightScatter = bEnable; }
@@ -103,6 +120,8 @@ private:
     void                    ProcessFXAA(void);
     void                    ProcessBloom(void);
     void                    DrawStats(void);
+    void                    BindSurface(const surface_t *surface);
+    void                    DrawSurfaceElements(const surface_t *surface);
 
     int                     postProcessMS;
     kexMaterial             *motionBlurMaterial;
@@ -32,6 +32,7 @@
 #include "script.h"
 #include "renderBackend.h"
 #include "renderModel.h"
+#include "filesystem.h"
 #ifndef EDITOR
 #include "animation.h"
 #endif
@@ -152,19 +153,62 @@ kexModelManager::~kexModelManager(void) {
 //
 
 void kexModelManager::Shutdown(void) {
-    common.Printf("Freeing model resources\n");
+    common.Printf(LC_RENDER, "Freeing model resources\n");
     Mem_Purge(hb_model);
     Mem_Purge(hb_animation);
 }
 
+//
+// Model_InterleaveVertices
+//
+
+static void Model_InterleaveVertices(surface_t *surface, const kexVec3 *xyz,
+                                     const float *coords, const float *normals) {
+    if(surface->numVerts == 0) {
+        surface->verts = NULL;
+        return;
+    }
+
+    surface->verts = (surfaceVertex_t*)Mem_Calloc(sizeof(surfaceVertex_t) *
+        surface->numVerts, hb_model);
+
+    for(unsigned int i = 0; i < surface->numVerts; i++) {
+        surfaceVertex_t *vertex = &surface->verts[i];
+
+        if(xyz) {
+            vertex->xyz = xyz[i];
+        }
+        if(coords) {
+            vertex->st[0] = coords[i * 2 + 0];
+            vertex->st[1] = coords[i * 2 + 1];
+        }
+        if(normals) {
+            vertex->normal[0] = normals[i * 3 + 0];
+            vertex->normal[1] = normals[i * 3 + 1];
+            vertex->normal[2] = normals[i * 3 + 2];
+        }
+
+        vertex->rgba[0] = 255;
+        vertex->rgba[1] = 255;
+        vertex->rgba[2] = 255;
+        vertex->rgba[3] = 255;
+    }
+}
+
 //
 // kexModelManager::ParseKMesh
 //
+// Materials are skipped when bMaterials is false, leaving every
+// surface's material NULL
+//
 
-void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
+void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer, const bool bMaterials) {
     unsigned int i;
     unsigned int k;
     unsigned int l;
+    kexVec3 *xyz;
+    float *coords;
+    float *normals;
     bool bNested = false;
 
     while(lexer->CheckState()) {
@@ -190,7 +234,7 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                 // begin reading into the node block
                 lexer->ExpectTokenListID(mdltokens, scmdl_nodes);
                 lexer->ExpectNextToken(TK_LBRACK);
-                model->nodes = (modelNode_t*)Mem_Malloc(sizeof(modelNode_t) *
+                model->nodes = (modelNode_t*)Mem_Calloc(sizeof(modelNode_t) *
                     model->numNodes, hb_model);
 
                 for(i = 0; i < model->numNodes; i++) {
@@ -233,10 +277,13 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                             surface->numIndices = 0;
                             surface->numVerts = 0;
                             surface->indices = NULL;
-                            surface->normals = NULL;
-                            surface->vertices = NULL;
-                            surface->rgb = NULL;
+                            surface->verts = NULL;
                             surface->material = NULL;
+                            surface->vertexBuffer = 0;
+                            surface->indexBuffer = 0;
+                            surface->vertexOffset = 0;
+                            surface->indexOffset = 0;
+                            surface->bounds.Clear();
 
                             // read into the nested surface block
                             lexer->ExpectNextToken(TK_LBRACK);
@@ -255,7 +302,10 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                                 case scmdl_material:
                                     lexer->ExpectNextToken(TK_EQUAL);
                                     lexer->GetString();
-                                    surface->material = kexMaterial::manager.Load(lexer->StringToken());
+
+                                    if(bMaterials) {
+                                        surface->material = kexMaterial::manager.Load(lexer->StringToken());
+                                    }
                                     break;
                                 case scmdl_numtriangles:
                                     lexer->AssignFromTokenList(mdltokens, &surface->numIndices,
@@ -277,20 +327,25 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                                     lexer->ExpectNextToken(TK_EQUAL);
                                     lexer->ExpectNextToken(TK_LBRACK);
                                     lexer->AssignFromTokenList(mdltokens, AT_VECTOR,
-                                        (void**)&surface->vertices, surface->numVerts,
+                                        (void**)&xyz, surface->numVerts,
                                         scmdl_xyz, true, hb_model);
                                     lexer->AssignFromTokenList(mdltokens, AT_FLOAT,
-                                        (void**)&surface->coords, surface->numVerts * 2,
+                                        (void**)&coords, surface->numVerts * 2,
                                         scmdl_coords, true, hb_model);
                                     lexer->AssignFromTokenList(mdltokens, AT_FLOAT,
-                                        (void**)&surface->normals, surface->numVerts * 3,
+                                        (void**)&normals, surface->numVerts * 3,
                                         scmdl_normals, true, hb_model);
-                                    surface->rgb = (byte*)Mem_Malloc(surface->numVerts * 4, hb_model);
-                                    for(l = 0; l < surface->numVerts; l++) {
-                                        surface->rgb[l * 4 + 0] = 255;
-                                        surface->rgb[l * 4 + 1] = 255;
-                                        surface->rgb[l * 4 + 2] = 255;
-                                        surface->rgb[l * 4 + 3] = 255;
+
+                                    Model_InterleaveVertices(surface, xyz, coords, normals);
+
+                                    if(xyz) {
+                                        Mem_Free(xyz);
+                                    }
+                                    if(coords) {
+                                        Mem_Free(coords);
+                                    }
+                                    if(normals) {
+                                        Mem_Free(normals);
                                     }
                                     lexer->ExpectNextToken(TK_RBRACK);
                                     break;
@@ -334,7 +389,7 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                 lexer->ExpectNextToken(TK_LBRACK);
 #ifndef EDITOR
                 if(model->numAnimations > 0) {
-                    model->anims = (kexAnim_t*)Mem_Malloc(sizeof(kexAnim_t) *
+                    model->anims = (kexAnim_t*)Mem_Calloc(sizeof(kexAnim_t) *
                         model->numAnimations, hb_model);
 
                     for(i = 0; i < model->numAnimations; i++) {
@@ -342,6 +397,7 @@ void kexModelManager::ParseKMesh(kexModel_t *model, kexLexer *lexer) {
                         model->anims[i].animID = lexer->GetNumber();
                         lexer->GetString();
                         model->anims[i].alias = Mem_Strdup(lexer->StringToken(), hb_model);
+                        model->anims[i].aliasName = kexName(model->anims[i].alias);
                         lexer->GetString();
                         memcpy(model->anims[i].animFile, lexer->StringToken(), MAX_FILEPATH);
                         lexer->ExpectNextToken(TK_RBRACK);
@@ -541,14 +597,8 @@ void kexModelManager::ParseWavefrontObj(kexModel_t *model, kexLexer *lexer) {
                 surface->numIndices, hb_model);
 
             surface->numVerts = points.Length() / 3;
-            surface->vertices = (kexVec3*)Mem_Calloc(sizeof(kexVec3) *
+            surface->verts = (surfaceVertex_t*)Mem_Calloc(sizeof(surfaceVertex_t) *
                 surface->numVerts, hb_model);
-            surface->coords = (float*)Mem_Calloc(sizeof(float) *
-                surface->numVerts * 2, hb_model);
-            surface->normals = (float*)Mem_Calloc(sizeof(float) *
-                surface->numVerts * 3, hb_model);
-            surface->rgb = (byte*)Mem_Calloc(sizeof(byte) *
-                surface->numVerts * 4, hb_model);
 
             for(unsigned int ind = 0; ind < surface->numIndices; ind++) {
                 surface->indices[ind] = faces[ind].vert - 1;
@@ -556,25 +606,26 @@ void kexModelManager::ParseWavefrontObj(kexModel_t *model, kexLexer *lexer) {
                 if(bHasCoords && faces[ind].coord > 0) {
                     int t = faces[ind].coord - 1;
                     int v = faces[ind].vert - 1;
-                    surface->coords[v * 2 + 0] = 1.0f - coords[t * 2 + 0];
-                    surface->coords[v * 2 + 1] = coords[t * 2 + 1];
+                    surface->verts[v].st[0] = 1.0f - coords[t * 2 + 0];
+                    surface->verts[v].st[1] = coords[t * 2 + 1];
                 }
                 if(bHasNormals && faces[ind].normal > 0) {
                     int t = faces[ind].normal - 1;
                     int v = faces[ind].vert - 1;
-                    surface->coords[v * 3 + 0] = normals[t * 3 + 0];
-                    surface->coords[v * 3 + 1] = normals[t * 3 + 1];
+                    surface->verts[v].normal[0] = normals[t * 3 + 0];
+                    surface->verts[v].normal[1] = normals[t * 3 + 1];
+                    surface->verts[v].normal[2] = normals[t * 3 + 2];
                 }
             }
 
             for(unsigned int v = 0; v < surface->numVerts; v++) {
-                surface->vertices[v].x = points[v * 3 + 0];
-                surface->vertices[v].y = points[v * 3 + 1];
-                surface->vertices[v].z = points[v * 3 + 2];
-                surface->rgb[v * 4 + 0] = 0xff;
-                surface->rgb[v * 4 + 1] = 0xff;
-                surface->rgb[v * 4 + 2] = 0xff;
-                surface->rgb[v * 4 + 3] = 0xff;
+                surface->verts[v].xyz.x = points[v * 3 + 0];
+                surface->verts[v].xyz.y = points[v * 3 + 1];
+                surface->verts[v].xyz.z = points[v * 3 + 2];
+                surface->verts[v].rgba[0] = 0xff;
+                surface->verts[v].rgba[1] = 0xff;
+                surface->verts[v].rgba[2] = 0xff;
+                surface->verts[v].rgba[3] = 0xff;
             }
 
             surface->material = kexMaterial::manager.Load("materials/default.kmat@default");
@@ -583,52 +634,293 @@ void kexModelManager::ParseWavefrontObj(kexModel_t *model, kexLexer *lexer) {
 }
 
 //
-// kexModelManager::LoadModel
+// Model_Evict
 //
 
-kexModel_t *kexModelManager::LoadModel(const char *file) {
+static void Model_Evict(void *data) {
+    modelManager.FreeModel(static_cast<kexModel_t*>(data));
+}
+
+//
+// Model_Size
+//
+
+static unsigned int Model_Size(const kexModel_t *model) {
+    unsigned int size = sizeof(modelNode_t) * model->numNodes;
+
+    for(unsigned int i = 0; i < model->numNodes; i++) {
+        modelNode_t *node = &model->nodes[i];
+
+        size += sizeof(word) * (node->numChildren + node->numVariants);
+        size += sizeof(surface_t) * node->numSurfaces;
+
+        for(unsigned int j = 0; j < node->numSurfaces; j++) {
+            surface_t *surface = &node->surfaces[j];
+
+            size += sizeof(word) * surface->numIndices;
+            size += sizeof(surfaceVertex_t) * surface->numVerts;
+        }
+    }
+
+#ifndef EDITOR
+    if(model->anims) {
+        size += sizeof(kexAnim_t) * model->numAnimations;
+
+        for(unsigned int i = 0; i < model->numAnimations; i++) {
+            size += kexAnimState::KAnimSize(model, &model->anims[i]);
+        }
+    }
+#endif
+
+    return size;
+}
+
+//
+// kexModelManager::ParseModel
+//
+
+bool kexModelManager::ParseModel(kexModel_t *model, const char *file) {
     bool bUsingDefault = false;
+    kexLexer *lexer;
 
-    if(file == NULL) {
-        return NULL;
+    if(!(lexer = parser.Open(file))) {
+        if(!(lexer = parser.Open("models/default.kmesh"))) {
+            return false;
+        }
+
+        common.Warning(LC_RENDER, "kexModelManager::LoadModel: %s not found\n", file);
+        bUsingDefault = true;
     }
-    else if(file[0] == 0) {
-        return NULL;
+
+    // begin parsing
+    if(strstr(file, ".kmesh") || bUsingDefault) {
+        ParseKMesh(model, lexer);
+    }
+    else if(strstr(file, ".obj")) {
+        ParseWavefrontObj(model, lexer);
     }
 
-    kexModel_t *model = NULL;
+    // we're done with the file
+    parser.Close();
 
-    // is the model already parsed/allocated?
-    if(!(model = modelList.Find(file))) {
-        kexLexer *lexer;
+    OptimizeModel(model);
 
-        if(!(lexer = parser.Open(file))) {
-            if(!(lexer = parser.Open("models/default.kmesh"))) {
-                return NULL;
+#ifndef EDITOR
+    kexAnimState::LoadKAnim(model);
+#endif
+
+    residency.Register(&model->resident, RT_MODEL, model, Model_Size(model), Model_Evict);
+    return true;
+}
+
+//
+// kexModelManager::OptimizeModel
+//
+// Runs every surface through the mesh optimizer and copies it
+// into the static buffers. The vertices stay in memory for the
+// clip meshes and for when buffers aren't available
+//
+
+void kexModelManager::OptimizeModel(kexModel_t *model) {
+    for(unsigned int i = 0; i < model->numNodes; i++) {
+        modelNode_t *node = &model->nodes[i];
+
+        for(unsigned int j = 0; j < node->numSurfaces; j++) {
+            surface_t *surface = &node->surfaces[j];
+            unsigned int numVerts = surface->numVerts;
+
+            kexMeshOptimizer::Optimize(surface);
+
+            // give back what welding saved
+            if(surface->numVerts != 0 && surface->numVerts < numVerts) {
+                surface->verts = (surfaceVertex_t*)Mem_Realloc(surface->verts,
+                    sizeof(surfaceVertex_t) * surface->numVerts, hb_model);
             }
 
-            common.Warning("kexModelManager::LoadModel: %s not found\n", file);
-            bUsingDefault = true;
+            renderer.UploadSurface(surface);
         }
+    }
+}
 
-        model = modelList.Add(file);
-        strncpy(model->filePath, file, MAX_FILEPATH);
+//
+// kexModelManager::MeasureModel
+//
+// Parses a kmesh without keeping it and adds what the optimizer
+// does to its surfaces to stats. Nothing the mesh refers to is loaded
+//
+
+bool kexModelManager::MeasureModel(const char *file, meshOptStats_t &stats) {
+    kexModel_t *model;
+    kexLexer *lexer;
+
+    if(!strstr(file, ".kmesh") || !(lexer = parser.Open(file))) {
+        return false;
+    }
 
-        // begin parsing
-        if(strstr(file, ".kmesh") || bUsingDefault) {
-            ParseKMesh(model, lexer);
+    model = (kexModel_t*)Mem_Calloc(sizeof(kexModel_t), hb_model);
+    ParseKMesh(model, lexer, false);
+    parser.Close();
+
+    for(unsigned int i = 0; i < model->numNodes; i++) {
+        modelNode_t *node = &model->nodes[i];
+
+        for(unsigned int j = 0; j < node->numSurfaces; j++) {
+            kexMeshOptimizer::Optimize(&node->surfaces[j], &stats);
         }
-        else if(strstr(file, ".obj")) {
-            ParseWavefrontObj(model, lexer);
+    }
+
+    FreeModel(model);
+    Mem_Free(model);
+    return true;
+}
+
+//
+// kexModelManager::TouchModel
+//
+// Marks a cached model, and the textures its surfaces use, as
+// referenced by the current map
+//
+
+void kexModelManager::TouchModel(kexModel_t *model) {
+    residency.Touch(&model->resident);
+
+    for(unsigned int i = 0; i < model->numNodes; i++) {
+        modelNode_t *node = &model->nodes[i];
+
+        for(unsigned int j = 0; j < node->numSurfaces; j++) {
+            if(node->surfaces[j].material) {
+                node->surfaces[j].material->Touch();
+            }
         }
+    }
+}
 
-        // we're done with the file
-        parser.Close();
+//
+// kexModelManager::FreeModel
+//
+// Frees everything the model loaded. The model itself stays in the
+// list so it can be parsed again
+//
+
+void kexModelManager::FreeModel(kexModel_t *model) {
+    for(unsigned int i = 0; i < model->numNodes; i++) {
+        modelNode_t *node = &model->nodes[i];
+
+        for(unsigned int j = 0; j < node->numSurfaces; j++) {
+            surface_t *surface = &node->surfaces[j];
+
+            renderer.ReleaseSurface(surface);
+
+            if(surface->indices) {
+                Mem_Free(surface->indices);
+            }
+            if(surface->verts) {
+                Mem_Free(surface->verts);
+            }
+        }
+
+        if(node->surfaces) {
+            Mem_Free(node->surfaces);
+        }
+        if(node->children) {
+            Mem_Free(node->children);
+        }
+        if(node->variants) {
+            Mem_Free(node->variants);
+        }
+    }
+
+    if(model->nodes) {
+        Mem_Free(model->nodes);
+    }
 
 #ifndef EDITOR
-        kexAnimState::LoadKAnim(model);
+    if(model->anims) {
+        for(unsigned int i = 0; i < model->numAnimations; i++) {
+            kexAnimState::FreeKAnim(&model->anims[i]);
+        }
+
+        Mem_Free(model->anims);
+        model->anims = NULL;
+    }
 #endif
+
+    model->nodes = NULL;
+    model->numNodes = 0;
+    model->numAnimations = 0;
+}
+
+//
+// kexModelManager::LoadModel
+//
+
+kexModel_t *kexModelManager::LoadModel(const char *file) {
+    kexModel_t *model = NULL;
+
+    if(file == NULL) {
+        return NULL;
+    }
+    else if(file[0] == 0) {
+        return NULL;
+    }
+
+    // is the model already parsed/allocated?
+    if(!(model = modelList.Find(file))) {
+        model = modelList.Add(file);
+        strncpy(model->filePath, file, MAX_FILEPATH);
+    }
+
+    // parse it again if it was evicted
+    if(model->resident.bResident) {
+        TouchModel(model);
+    }
+    else if(!ParseModel(model, file)) {
+        return NULL;
     }
 
     return model;
 }
+
+//
+// testmeshopt
+//
+// Runs the mesh optimizer over every shipped model and compares the
+// average cache miss ratio of the indices before and after
+//
+
+COMMAND(testmeshopt) {
+    kexStrList list;
+    meshOptStats_t stats;
+    unsigned int numModels = 0;
+    float before;
+    float after;
+    bool bOk;
+
+    memset(&stats, 0, sizeof(meshOptStats_t));
+    fileSystem.GetMatchingFiles(list, ".kmesh");
+
+    for(unsigned int i = 0; i < list.Length(); i++) {
+        if(modelManager.MeasureModel(list[i].c_str(), stats)) {
+            numModels++;
+        }
+    }
+
+    if(stats.numTriangles == 0) {
+        common.Warning(LC_RENDER, "testmeshopt: no models found\n");
+        return;
+    }
+
+    before = (float)stats.missesBefore / (float)stats.numTriangles;
+    after = (float)stats.missesAfter / (float)stats.numTriangles;
+
+    common.Printf(LC_RENDER, "%i models, %i surfaces, %i triangles\n",
+        numModels, stats.numSurfaces, stats.numTriangles);
+    common.Printf(LC_RENDER, "vertices: %i -> %i\n", stats.numVertsIn, stats.numVertsOut);
+    common.Printf(LC_RENDER, "ACMR (%i entry FIFO): %.3f -> %.3f\n", MESHOPT_CACHE_SIZE, before, after);
+
+    // welding can't add vertices and a fresh ordering shouldn't be worse
+    bOk = (stats.numVertsOut <= stats.numVertsIn && after <= before);
+
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testmeshopt %s\n",
+        bOk ? "passed" : "failed");
+}
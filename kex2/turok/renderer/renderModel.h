@@ -24,7 +24,9 @@
 #define __RENDER_MODEL_H__
 
 #include "cachefilelist.h"
+#include "residency.h"
 #include "renderMain.h"
+#include "meshOptimizer.h"
 
 #define MDF_UNKNOWN1                1
 #define MDF_FULLBRIGHT              2
@@ -62,6 +64,7 @@ typedef struct kexModel_s {
 #ifndef EDITOR
     struct kexAnim_s                *anims;
 #endif
+    resident_t                      resident;
 } kexModel_t;
 
 class kexModelManager {
@@ -70,11 +73,17 @@ public:
                                     ~kexModelManager(void);
 
     kexModel_t                      *LoadModel(const char *file);
+    void                            FreeModel(kexModel_t *model);
     void                            Shutdown(void);
+    bool                            MeasureModel(const char *file, meshOptStats_t &stats);
 
 private:
-    void                            ParseKMesh(kexModel_t *model, kexLexer *lexer);
+    bool                            ParseModel(kexModel_t *model, const char *file);
+    void                            TouchModel(kexModel_t *model);
+    void                            ParseKMesh(kexModel_t *model, kexLexer *lexer,
+                                               const bool bMaterials = true);
     void                            ParseWavefrontObj(kexModel_t *model, kexLexer *lexer);
+    void                            OptimizeModel(kexModel_t *model);
 
     kexHashList<kexModel_t>         modelList;
 };
@@ -140,6 +140,7 @@ void kexRenderUtils::DrawFilledBoundingBox(const kexBBox &bbox,
         colors[i * 4 + 3] = 255;
     }
     
+    cpuVertList.Flush();
     dglDisableClientState(GL_NORMAL_ARRAY);
     dglDisableClientState(GL_TEXTURE_COORD_ARRAY);
     
@@ -202,6 +203,7 @@ void kexRenderUtils::DrawRadius(float x, float y, float z,
 void kexRenderUtils::DrawOrigin(float x, float y, float z, float size) {
     renderBackend.SetState(GLSTATE_TEXTURE0, false);
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 0.0f);
     dglLineWidth(2.0f);
 
@@ -215,6 +217,7 @@ void kexRenderUtils::DrawOrigin(float x, float y, float z, float size) {
     
     renderBackend.SetState(GLSTATE_TEXTURE0, true);
     
+    cpuVertList.Flush();
     dglLineWidth(1.0f);
     dglDepthRange(0.0f, 1.0f);
 }
@@ -293,6 +296,7 @@ void kexRenderUtils::DrawSphere(float x, float y, float z, float radius,
 void kexRenderUtils::DrawLine(const kexVec3 &p1, const kexVec3 &p2,
                               const byte r, const byte g, const byte b) {
     
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 0.0f);
 
     renderBackend.SetState(GLSTATE_TEXTURE0, false);
@@ -305,6 +309,7 @@ void kexRenderUtils::DrawLine(const kexVec3 &p1, const kexVec3 &p2,
 
     renderBackend.SetState(GLSTATE_TEXTURE0, true);
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 1.0f);
 }
 
@@ -41,6 +41,7 @@
 extern kexCvar cvarRenderLightScatter;
 extern kexCvar cvarRenderNodeOcclusionQueries;
 extern kexCvar cvarRenderActorOcclusionQueries;
+extern kexCvar cvarRenderBatchCulling;
 
 kexRenderWorld renderWorld;
 
@@ -217,6 +218,7 @@ kexRenderWorld::kexRenderWorld(void) {
     this->numDrawnFX        = 0;
     this->showAreaNode      = -1;
     this->renderNodeStep    = -1;
+    this->lerpFraction      = 1;
 }
 
 //
@@ -236,6 +238,7 @@ void kexRenderWorld::InitSunData(void) {
 //
 
 void kexRenderWorld::Shutdown(void) {
+    staticBatches.Destroy();
     renderNodes.Destroy();
     
     for(unsigned int i = 0; i < actorQueries.Length(); i++) {
@@ -261,13 +264,40 @@ void kexRenderWorld::Shutdown(void) {
 //
 //-----------------------------------------------------------------------------
 
+//
+// LerpRotation
+//
+// Slerp renormalizes, so only blend when the rotation actually
+// changed. Objects that aren't turning draw exactly as they did
+//
+
+static bool LerpRotation(const kexQuat &prev, const kexQuat &cur,
+                         const float frac, kexQuat &out) {
+    if(prev.x == cur.x && prev.y == cur.y && prev.z == cur.z && prev.w == cur.w) {
+        return false;
+    }
+
+    out = prev.Slerp(cur, frac);
+    return true;
+}
+
 //
 // kexRenderWorld::SetCameraView
 //
 
 void kexRenderWorld::SetCameraView(kexCamera *camera) {
-    camera->SetupMatrices();
+    kexVec3 org = camera->GetOrigin();
+    kexVec3 lerpOrg = camera->PrevOrigin();
+    kexQuat view = camera->ViewRotation();
+
+    LerpRotation(camera->PrevRotation(), view, lerpFraction, view);
+
+    // build the view from the blended transform, the camera itself stays put
+    camera->SetOrigin(lerpOrg.Lerp(org, lerpFraction));
+    camera->SetupMatrices(view);
+    camera->SetOrigin(org);
     
+    cpuVertList.Flush();
     dglMatrixMode(GL_PROJECTION);
     dglLoadMatrixf(camera->Projection().ToFloatPtr());
     dglMatrixMode(GL_MODELVIEW);
@@ -310,6 +340,7 @@ void kexRenderWorld::RenderScene(void) {
 
     // force the fog clear color to be visible
     if(cvarRenderLightScatter.GetBool()) {
+        cpuVertList.Flush();
         dglClear(GL_COLOR_BUFFER_BIT);
     }
 
@@ -403,6 +434,7 @@ void kexRenderWorld::PreProcessLightScatter(void) {
     }
     
     dglGetIntegerv(GL_VIEWPORT, vp);
+    cpuVertList.Flush();
     dglPushAttrib(GL_VIEWPORT_BIT);
     dglViewport(0, 0, renderer.FBOLightScatter().Width(), renderer.FBOLightScatter().Height());
 
@@ -410,6 +442,7 @@ void kexRenderWorld::PreProcessLightScatter(void) {
     dglClearColor(world->worldLightAmbience[0],
                   world->worldLightAmbience[1],
                   world->worldLightAmbience[2], 1);
+    cpuVertList.Flush();
     dglClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     DrawSun(true);
@@ -425,6 +458,7 @@ void kexRenderWorld::PreProcessLightScatter(void) {
     DrawViewActors(&kexRenderer::DrawBlackSurface);
 
     renderer.FBOLightScatter().UnBind();
+    cpuVertList.Flush();
     dglPopAttrib();
 }
 
@@ -469,6 +503,11 @@ void kexRenderWorld::PreProcessOcclusionQueries(void) {
                         continue;
                     }
 
+                    // nothing will read the result
+                    if(wm->bBatched && !cvarRenderBatchCulling.GetBool()) {
+                        continue;
+                    }
+
                     box = wm->Bounds();
                     box += EXTENDED_BOX_SIZE;
 
@@ -480,31 +519,34 @@ void kexRenderWorld::PreProcessOcclusionQueries(void) {
         if(bActorOcclusion) {
             unsigned int queryIndex = 0;
 
-            for(kexActor *actor = world->actors.Next();
-                actor != NULL; actor = actor->worldLink.Next()) {
-                    if(actor->bStatic   ||
-                        actor->bHidden  ||
-                        actor->bCulled  ||
-                        actor->DisplayType() != ODT_NORMAL) {
-                            continue;
-                    }
+            for(unsigned int i = 0; i < world->actors.Length(); i++) {
+                const objectHot_t &hot = world->actors.HotAt(i);
+                kexActor *actor;
 
-                    // generate a new query if we need to
-                    if(actorQueries.Length() <= queryIndex) {
-                        GLuint query;
+                if(hot.flags & (OHF_STATIC|OHF_HIDDEN) || hot.displayType != ODT_NORMAL) {
+                    continue;
+                }
 
-                        dglGenQueriesARB(1, &query);
-                        actorQueries.Push(query);
-                    }
+                if(!(actor = world->actors[i]) || actor->bCulled) {
+                    continue;
+                }
 
-                    // keep reference for next frame
-                    actor->queryIndex = queryIndex++;
+                // generate a new query if we need to
+                if(actorQueries.Length() <= queryIndex) {
+                    GLuint query;
 
-                    box = actor->Bounds();
-                    box += EXTENDED_BOX_SIZE;
+                    dglGenQueriesARB(1, &query);
+                    actorQueries.Push(query);
+                }
+
+                // keep reference for next frame
+                actor->queryIndex = queryIndex++;
 
-                    // query the result based on the bounding box
-                    renderer.TestBoundsForOcclusionQuery(actorQueries[actor->queryIndex], box);
+                box = actor->Bounds();
+                box += EXTENDED_BOX_SIZE;
+
+                // query the result based on the bounding box
+                renderer.TestBoundsForOcclusionQuery(actorQueries[actor->queryIndex], box);
             }
         }
 
@@ -532,9 +574,10 @@ void kexRenderWorld::BuildNodes(void) {
     
     renderNodes.Init(8);
     
-    for(wm = world->staticActors.Next(); wm != NULL; wm = wm->worldLink.Next()) {
+    for(unsigned int i = 0; i < world->staticActors.Length(); i++) {
         GLuint query = 0;
 
+        wm = world->staticActors[i];
         renderNodes.AddBoxToRoot(wm->Bounds());
 
         // create a new query for every world model
@@ -547,7 +590,8 @@ void kexRenderWorld::BuildNodes(void) {
     
     renderNodes.BuildNodes();
     
-    for(wm = world->staticActors.Next(); wm != NULL; wm = wm->worldLink.Next()) {
+    for(unsigned int i = 0; i < world->staticActors.Length(); i++) {
+        wm = world->staticActors[i];
         wm->renderNode.Link(renderNodes, wm->Bounds());
     }
     
@@ -556,6 +600,8 @@ void kexRenderWorld::BuildNodes(void) {
     for(unsigned int i = 0; i < nodeQueries.Length(); i++) {
         dglGenQueriesARB(1, &nodeQueries[i]);
     }
+
+    staticBatches.Build(renderNodes, idx);
 }
 
 //
@@ -774,6 +820,8 @@ void kexRenderWorld::RecursiveSDNode(int nodenum) {
     int side;
     float d;
     bool bNodeQueries;
+    bool bBatches;
+    bool bCullBatched;
 
     node = &renderNodes.nodes[nodenum];
     camera = world->Camera();
@@ -817,7 +865,13 @@ void kexRenderWorld::RecursiveSDNode(int nodenum) {
         renderNodeStepNum++;
     }
 
+    // the debug views need to see each object on its own
+    bBatches = !bShowClipMesh && !bShowCollisionMap;
+    bCullBatched = cvarRenderBatchCulling.GetBool();
+
     for(wm = node->objects.Next(); wm != NULL; wm = wm->renderNode.link.Next()) {
+        bool bBatchedDraw = (wm->bBatched && bBatches);
+
         if(wm->bHidden) {
             if(bShowClipMesh) {
                 wm->ClipMesh().DebugDraw();
@@ -828,29 +882,50 @@ void kexRenderWorld::RecursiveSDNode(int nodenum) {
         box = wm->Bounds();
 
         if(renderNodeStep >= 0) {
+            cpuVertList.Flush();
             dglDepthRange(0, 0);
             kexRenderUtils::DrawBoundingBox(box, 0, 255, 255);
+            cpuVertList.Flush();
             dglDepthRange(0, 1);
         }
 
-        wm->bCulled = !frustum.TestBoundingBox(box);
+        if(!bBatchedDraw || bCullBatched) {
+            wm->bCulled = !frustum.TestBoundingBox(box);
 
-        if(wm->bCulled) {
-            numCulledStatics++;
-            continue;
+            if(wm->bCulled) {
+                numCulledStatics++;
+                continue;
+            }
+
+            if(bNodeQueries) {
+                box += (EXTENDED_BOX_SIZE + 24.0f);
+
+                if(renderer.GetOcclusionSampleResult(staticQueries[wm->queryIndex], box)) {
+                    numOccludedStatics++;
+                    continue;
+                }
+            }
+        }
+        else {
+            // the whole batch is drawn whenever the node is
+            wm->bCulled = false;
         }
 
-        if(bNodeQueries) {
-            box += (EXTENDED_BOX_SIZE + 24.0f);
+        if(bBatchedDraw) {
+            staticBatches.MarkVisible(wm);
 
-            if(renderer.GetOcclusionSampleResult(staticQueries[wm->queryIndex], box)) {
-                numOccludedStatics++;
-                continue;
+            if(bPrintStats) {
+                numDrawnStatics++;
             }
+            continue;
         }
 
         DrawWorldModel(wm);
     }
+
+    if(bBatches) {
+        staticBatches.DrawNode(nodenum);
+    }
     
     if(bPrintStats) {
         numDrawnSDNodes++;
@@ -871,6 +946,7 @@ void kexRenderWorld::DrawStaticActors(void) {
     
     renderNodeStepNum = 0;
 
+    staticBatches.BeginFrame();
     RecursiveSDNode(0);
 
     if(bPrintStats) {
@@ -885,12 +961,23 @@ void kexRenderWorld::DrawStaticActors(void) {
 void kexRenderWorld::DrawSingleActor(kexActor *actor, kexMatrix *matrix) {
     kexBBox box;
     kexMatrix curMatrix;
+    kexVec3 org;
+    kexQuat rot;
 
     box = actor->Bounds();
 
     if(actor->Model()) {
         curMatrix = actor->Matrix();
 
+        // place the model between where it was on the last two client ticks
+        if(LerpRotation(actor->PrevRotation(), actor->GetRotation(), lerpFraction, rot)) {
+            curMatrix = kexMatrix(rot);
+            curMatrix.Scale(actor->GetScale());
+        }
+
+        org = actor->PrevOrigin();
+        curMatrix.vectors[3].ToVec3() = org.Lerp(actor->GetOrigin(), lerpFraction);
+
         if(actor->bNoFixedTransform == false && matrix) {
             curMatrix = *matrix * curMatrix;
         }
@@ -926,39 +1013,47 @@ void kexRenderWorld::DrawActors(void) {
 
     bool bUseQueries = cvarRenderActorOcclusionQueries.GetBool();
 
-    for(kexActor *actor = world->actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-            if(actor->bStatic) {
-                continue;
+    // cull against the packed copies so that actors that aren't drawn
+    // are never touched
+    for(unsigned int i = 0; i < world->actors.Length(); i++) {
+        const objectHot_t &hot = world->actors.HotAt(i);
+        kexActor *actor;
+        bool bCulled = false;
+
+        if(hot.flags & (OHF_STATIC|OHF_HIDDEN) || hot.displayType != ODT_NORMAL) {
+            continue;
+        }
+
+        if(!(hot.flags & OHF_NOCULL)) {
+            if(hot.origin.DistanceSq(camOrg) >= (hot.cullDistance * hot.cullDistance)) {
+                bCulled = true;
             }
-            if(actor->bHidden || actor->DisplayType() != ODT_NORMAL) {
-                continue;
+            else {
+                bCulled = !frustum.TestBoundingBox(hot.bounds);
             }
+        }
 
-            if(actor->bNoCull == false) {
-                if(actor->GetOrigin().DistanceSq(camOrg) >= (actor->CullDistance() * actor->CullDistance())) {
-                    actor->bCulled = true;
-                }
-                else {
-                    actor->bCulled = !frustum.TestBoundingBox(actor->Bounds());
-                }
+        if(!(actor = world->actors[i])) {
+            continue;
+        }
 
-                if(actor->bCulled) {
-                    numCulledActors++;
-                    continue;
-                }
-            }
-            
-            if(bUseQueries && actor->queryIndex != -1) {
-                box = actor->Bounds();
-                box += (EXTENDED_BOX_SIZE + 24.0f);
-                if(renderer.GetOcclusionSampleResult(actorQueries[actor->queryIndex], box)) {
-                    numOccludedActors++;
-                    continue;
-                }
+        actor->bCulled = bCulled;
+
+        if(bCulled) {
+            numCulledActors++;
+            continue;
+        }
+        
+        if(bUseQueries && actor->queryIndex != -1) {
+            box = actor->Bounds();
+            box += (EXTENDED_BOX_SIZE + 24.0f);
+            if(renderer.GetOcclusionSampleResult(actorQueries[actor->queryIndex], box)) {
+                numOccludedActors++;
+                continue;
             }
+        }
 
-            DrawSingleActor(actor, &mtx);
+        DrawSingleActor(actor, &mtx);
     }
 
     if(bPrintStats) {
@@ -975,6 +1070,7 @@ void kexRenderWorld::DrawViewActors(drawSurfFunc_t function) {
     kexMatrix curMatrix;
     kexMatrix modelMatrix(DEG2RAD(-90), 1);
 
+    cpuVertList.Flush();
     dglMatrixMode(GL_PROJECTION);
     dglLoadIdentity();
     projMatrix.Identity();
@@ -984,16 +1080,22 @@ void kexRenderWorld::DrawViewActors(drawSurfFunc_t function) {
     dglMatrixMode(GL_MODELVIEW);
     dglLoadIdentity();
 
-    for(kexActor *actor = world->actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-            if(actor->bHidden || actor->DisplayType() != ODT_CLIENTVIEW) {
-                continue;
-            }
+    for(unsigned int i = 0; i < world->actors.Length(); i++) {
+        const objectHot_t &hot = world->actors.HotAt(i);
+        kexActor *actor;
 
-            if(actor->Model()) {
-                curMatrix = modelMatrix * actor->Matrix();
-                TraverseDrawActorNode(actor, &actor->Model()->nodes[0], actor->AnimState(), curMatrix);
-            }
+        if(hot.flags & OHF_HIDDEN || hot.displayType != ODT_CLIENTVIEW) {
+            continue;
+        }
+
+        if(!(actor = world->actors[i])) {
+            continue;
+        }
+
+        if(actor->Model()) {
+            curMatrix = modelMatrix * actor->Matrix();
+            TraverseDrawActorNode(actor, &actor->Model()->nodes[0], actor->AnimState(), curMatrix);
+        }
     }
 
     renderer.DrawSurfaceList(function, MSO_RESERVED, MSO_RESERVED+1);
@@ -1029,6 +1131,7 @@ void kexRenderWorld::DrawSun(const bool bForceInfiniteProjection) {
 
     if(bForceInfiniteProjection) {
         world->Camera()->ZFar() = zfar;
+        cpuVertList.Flush();
         dglClear(GL_DEPTH_BUFFER_BIT);
     }
 }
@@ -1044,21 +1147,27 @@ void kexRenderWorld::DrawForegroundActors(void) {
     world->Camera()->ZFar() = -1;
     SetCameraView(world->Camera());
 
-    for(kexActor *actor = world->actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-            if(actor->bHidden || actor->DisplayType() != ODT_FOREGROUND) {
-                continue;
-            }
+    for(unsigned int i = 0; i < world->actors.Length(); i++) {
+        const objectHot_t &hot = world->actors.HotAt(i);
+        kexActor *actor;
 
-            if(actor->bNoCull == false) {
-                actor->bCulled = !frustum.TestBoundingBox(actor->Bounds());
+        if(hot.flags & OHF_HIDDEN || hot.displayType != ODT_FOREGROUND) {
+            continue;
+        }
 
-                if(actor->bCulled) {
-                    continue;
-                }
+        if(!(actor = world->actors[i])) {
+            continue;
+        }
+
+        if(actor->bNoCull == false) {
+            actor->bCulled = !frustum.TestBoundingBox(actor->Bounds());
+
+            if(actor->bCulled) {
+                continue;
             }
+        }
 
-            DrawSingleActor(actor, NULL);
+        DrawSingleActor(actor, NULL);
     }
 
     renderer.DrawSurfaceList(bWireframe ?
@@ -1073,6 +1182,7 @@ void kexRenderWorld::DrawForegroundActors(void) {
     }
 
     world->Camera()->ZFar() = zfar;
+    cpuVertList.Flush();
     dglClear(GL_DEPTH_BUFFER_BIT);
 }
 
@@ -1106,13 +1216,14 @@ void kexRenderWorld::DrawFX(void) {
     memset(fxDisplayList, 0, sizeof(fxDisplay_t) * MAX_FX_DISPLAYS);
     
     // gather particle fx and add to display list for sorting
-    for(world->fxRover = world->fxList.Next(), fxDisplayNum = 0;
-        world->fxRover != NULL; world->fxRover = world->fxRover->worldLink.Next()) {
+    fxDisplayNum = 0;
+
+    for(unsigned int i = 0; i < world->fxList.Length(); i++) {
         if(fxDisplayNum >= MAX_FX_DISPLAYS) {
             break;
         }
-        if(world->fxRover == NULL) {
-            break;
+        if((world->fxRover = world->fxList[i]) == NULL) {
+            continue;
         }
         if(world->fxRover->restart > 0) {
             continue;
@@ -1166,6 +1277,8 @@ void kexRenderWorld::PrintStats(void) {
     kexRenderUtils::PrintStatsText("query time", ": %ims", renderOcclusionPrePassMS);
     kexRenderUtils::AddDebugLineSpacing();
     kexRenderUtils::PrintStatsText("drawn statics", ": %i", numDrawnStatics);
+    kexRenderUtils::PrintStatsText("drawn batches", ": %i (%i partial, %i surfaces)",
+        staticBatches.NumDrawnBatches(), staticBatches.NumPartialBatches(), staticBatches.NumSurfaceDraws());
     kexRenderUtils::PrintStatsText("nodes visited", ": %i", numDrawnSDNodes);
     kexRenderUtils::PrintStatsText("drawn actors", ": %i", numDrawnActors);
     kexRenderUtils::PrintStatsText("drawn fx", ": %i", numDrawnFX);
@@ -1193,10 +1306,15 @@ void kexRenderWorld::DebugObjects(void) {
         return;
     }
 
-    for(kexWorldModel *wm = world->staticActors.Next(); wm != NULL; wm = wm->worldLink.Next()) {
-        if(!world->Camera()->Frustum().TestBoundingBox(wm->Bounds())) {
+    for(unsigned int i = 0; i < world->staticActors.Length(); i++) {
+        kexWorldModel *wm;
+
+        if(!world->Camera()->Frustum().TestBoundingBox(world->staticActors.HotAt(i).bounds)) {
             continue;
         }
+
+        wm = world->staticActors[i];
+
         if(bShowBBox) {
             if(wm->bTraced) {
                 kexRenderUtils::DrawBoundingBox(wm->Bounds(), 255, 0, 0);
@@ -1213,38 +1331,43 @@ void kexRenderWorld::DebugObjects(void) {
         }
     }
 
-    for(kexActor *actor = world->actors.Next();
-        actor != NULL; actor = actor->worldLink.Next()) {
-            if(!world->Camera()->Frustum().TestBoundingBox(actor->Bounds())) {
-                continue;
-            }
-            if(bShowOrigin) {
-                kexRenderUtils::DrawOrigin(actor->GetOrigin().x,
-                                           actor->GetOrigin().y,
-                                           actor->GetOrigin().z, 32);
-            }
+    for(unsigned int i = 0; i < world->actors.Length(); i++) {
+        kexActor *actor;
 
-            if(bShowBBox) {
-                if(actor->bTraced) {
-                    kexRenderUtils::DrawBoundingBox(actor->Bounds(), 255, 0, 0);
-                    actor->bTraced = false;
-                }
-                else {
-                    kexRenderUtils::DrawBoundingBox(actor->Bounds(),
-                        actor->bTouch ? 0 : 255,
-                        actor->bTouch ? 255 : 128,
-                        actor->bTouch ? 0 : 128);
-                }
+        if(!world->Camera()->Frustum().TestBoundingBox(world->actors.HotAt(i).bounds)) {
+            continue;
+        }
+
+        if(!(actor = world->actors[i])) {
+            continue;
+        }
+        if(bShowOrigin) {
+            kexRenderUtils::DrawOrigin(actor->GetOrigin().x,
+                                       actor->GetOrigin().y,
+                                       actor->GetOrigin().z, 32);
+        }
+
+        if(bShowBBox) {
+            if(actor->bTraced) {
+                kexRenderUtils::DrawBoundingBox(actor->Bounds(), 255, 0, 0);
+                actor->bTraced = false;
             }
-            if(bShowRadius && actor->bCollision) {
-                kexVec3 org = actor->GetOrigin();
-                kexRenderUtils::DrawRadius(org[0], org[1], org[2],
-                    actor->Radius(), actor->BaseHeight(), 255, 128, 128);
-                kexRenderUtils::DrawRadius(org[0], org[1], org[2],
-                    actor->Radius() * 0.5f, actor->Height(), 128, 128, 255);
-                kexRenderUtils::DrawRadius(org[0], org[1], org[2],
-                    actor->Radius() * 0.5f, actor->GetViewHeight(), 128, 255, 128);
+            else {
+                kexRenderUtils::DrawBoundingBox(actor->Bounds(),
+                    actor->bTouch ? 0 : 255,
+                    actor->bTouch ? 255 : 128,
+                    actor->bTouch ? 0 : 128);
             }
+        }
+        if(bShowRadius && actor->bCollision) {
+            kexVec3 org = actor->GetOrigin();
+            kexRenderUtils::DrawRadius(org[0], org[1], org[2],
+                actor->Radius(), actor->BaseHeight(), 255, 128, 128);
+            kexRenderUtils::DrawRadius(org[0], org[1], org[2],
+                actor->Radius() * 0.5f, actor->Height(), 128, 128, 255);
+            kexRenderUtils::DrawRadius(org[0], org[1], org[2],
+                actor->Radius() * 0.5f, actor->GetViewHeight(), 128, 255, 128);
+        }
     }
 }
 
@@ -1255,6 +1378,7 @@ void kexRenderWorld::DebugObjects(void) {
 void kexRenderWorld::DrawAreaNode(void) {
     kexSDNodeObj<kexWorldObject> *nodes;
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 0.0f);
 
     for(unsigned int i = 0; i < world->areaNodes.numNodes; i++) {
@@ -1267,6 +1391,7 @@ void kexRenderWorld::DrawAreaNode(void) {
         kexRenderUtils::DrawBoundingBox(nodes->bounds, 255, 0, 0);
     }
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 1.0f);
 }
 
@@ -1279,6 +1404,7 @@ void kexRenderWorld::DrawRenderNode(void) {
     kexWorldModel *wm;
     int nodenum;
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 0.0f);
 
     for(unsigned int i = 0; i < renderNodes.numNodes; i++) {
@@ -1295,6 +1421,7 @@ void kexRenderWorld::DrawRenderNode(void) {
         kexRenderUtils::DrawBoundingBox(wm->Bounds(), 0, 255, 255);
     }
 
+    cpuVertList.Flush();
     dglDepthRange(0.0f, 1.0f);
 }
 
@@ -1337,6 +1464,7 @@ void kexRenderWorld::DrawSectors(kexSector *sectors, const int count) {
     kexVec3 n;
     
     renderBackend.DisableShaders();
+    cpuVertList.BindDrawPointers();
     
     for(int i = 0; i < count; i++) {
         byte r, g, b, a;
@@ -1395,21 +1523,23 @@ void kexRenderWorld::DrawSectors(kexSector *sectors, const int count) {
         renderBackend.SetState(GLSTATE_BLEND, true);
         renderBackend.SetState(GLSTATE_ALPHATEST, true);
         
-        cpuVertList.BindDrawPointers();
         cpuVertList.DrawElementsNoShader(false);
         
         // draw wireframe outline
         renderBackend.SetPolyMode(GLPOLY_LINE);
         
+        cpuVertList.Flush();
         dglDisableClientState(GL_COLOR_ARRAY);
         dglColor4ub(0xFF, 0xFF, 0xFF, 0xFF);
         
         cpuVertList.DrawElementsNoShader();
         renderBackend.SetPolyMode(GLPOLY_FILL);
         
+        cpuVertList.Flush();
         dglEnableClientState(GL_COLOR_ARRAY);
         
         renderBackend.SetState(GLSTATE_CULL, false);
+        cpuVertList.Flush();
         dglLineWidth(2.0f);
         
         // draw plane normal vectors
@@ -1463,6 +1593,7 @@ void kexRenderWorld::DrawSectors(kexSector *sectors, const int count) {
         }
         
         cpuVertList.DrawLineElements();
+        cpuVertList.Flush();
         dglLineWidth(1.0f);
         
         renderBackend.SetState(GLSTATE_TEXTURE0, true);
@@ -27,6 +27,7 @@
 #include "sdNodes.h"
 #include "viewPortals.h"
 #include "viewBounds.h"
+#include "staticBatch.h"
 
 class kexRenderWorld {
 public:
@@ -58,9 +59,11 @@ public:
 
     int                         showAreaNode;
     kexSDNode<kexWorldModel>    renderNodes;
+    kexStaticBatches            staticBatches;
 
     kexVec3                     &WorldLightTransform(void) { return worldLightTransform; }
     kexVec3                     &ProjectedSunCoords(void) { return projectedSunCoords; }
+    void                        SetLerpFraction(const float frac) { lerpFraction = frac; }
 
 private:
     const bool                  CameraRenderSky(void) const;
@@ -88,6 +91,7 @@ private:
 
     kexWorld                    *world;
     kexVec3                     worldLightTransform;
+    float                       lerpFraction;
     int                         renderSceneMS;
     int                         renderStaticsMS;
     int                         renderActorsMS;
@@ -75,6 +75,8 @@ void kexShaderObj::Init(void) {
     this->bHasErrors            = false;
     this->bLoaded               = false;
     this->customParametersLocal = NULL;
+    this->uniforms              = NULL;
+    this->numUniforms           = 0;
 }
 
 //
@@ -104,6 +106,7 @@ void kexShaderObj::InitFromDefinition(kexKeyMap *def) {
 void kexShaderObj::InitProgram(void) {
     programObj = dglCreateProgramObjectARB();
     validCount = -1;
+    numUniforms = 0;
 
     for(int i = 0; i < RSP_TOTAL; i++) {
         globalParams[i] = -1;
@@ -116,11 +119,14 @@ void kexShaderObj::InitProgram(void) {
 
 void kexShaderObj::Enable(void) {
     if(programObj == renderBackend.glState.currentProgram) {
+        renderBackend.glState.numSkippedCalls++;
         return;
     }
     
+    cpuVertList.Flush();
     dglUseProgramObjectARB(programObj);
     renderBackend.glState.currentProgram = programObj;
+    renderBackend.glState.numProgramBinds++;
 }
 
 //
@@ -139,6 +145,13 @@ void kexShaderObj::Delete(void) {
     
     if(customParametersLocal) {
         delete[] customParametersLocal;
+        customParametersLocal = NULL;
+    }
+
+    if(uniforms) {
+        delete[] uniforms;
+        uniforms = NULL;
+        numUniforms = 0;
     }
 }
 
@@ -151,7 +164,7 @@ void kexShaderObj::Compile(const char *name, rShaderType_t type) {
     rhandle *handle;
     
     if(fileSystem.OpenFile(name, &data, hb_static) == 0) {
-        common.Warning("kexShaderObj::Compile: %s not found\n", name);
+        common.Warning(LC_RENDER, "kexShaderObj::Compile: %s not found\n", name);
         return;
     }
     
@@ -176,15 +189,156 @@ void kexShaderObj::Compile(const char *name, rShaderType_t type) {
 }
 
 //
-// kexShaderObj::SetUniform
+// kexShaderObj::FindUniform
+//
+// Every active uniform's name was interned when the program was
+// linked, so a name that was never interned can't be one of them
 //
 
-void kexShaderObj::SetUniform(const char *name, const int val) {
-    int loc = dglGetUniformLocationARB(programObj, name);
+int kexShaderObj::FindUniform(const char *name) const {
+    kexName key = kexName::Find(name);
+
+    if(key.IsEmpty()) {
+        return -1;
+    }
+
+    for(int i = 0; i < numUniforms; i++) {
+        if(uniforms[i].name == key) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+//
+// kexShaderObj::UniformChanged
+//
+// Returns false if the uniform already holds the value. Values
+// only stick to the program that's bound, so anything sent while
+// this one isn't leaves the uniform unknown
+//
+
+bool kexShaderObj::UniformChanged(const int index, const void *data, const int size) {
+    shaderUniform_t *uniform;
+
+    if(index <= -1) {
+        return false;
+    }
+
+    uniform = &uniforms[index];
+
+    if(renderBackend.glState.currentProgram != programObj) {
+        uniform->shadowSize = 0;
+        renderBackend.glState.numUniformUploads++;
+        cpuVertList.Flush();
+        return true;
+    }
+
+    if(uniform->shadowSize == size && !memcmp(uniform->shadow, data, size)) {
+        renderBackend.glState.numSkippedCalls++;
+        return false;
+    }
 
-    if(loc != -1) {
-        dglUniform1iARB(loc, val);
+    if(size <= (int)sizeof(uniform->shadow)) {
+        memcpy(uniform->shadow, data, size);
+        uniform->shadowSize = size;
     }
+    else {
+        uniform->shadowSize = 0;
+    }
+
+    // the held back draw has to go out with the old value
+    cpuVertList.Flush();
+
+    renderBackend.glState.numUniformUploads++;
+    return true;
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, const int val) {
+    if(UniformChanged(index, &val, sizeof(int))) {
+        dglUniform1iARB(uniforms[index].location, val);
+    }
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, const float val) {
+    if(UniformChanged(index, &val, sizeof(float))) {
+        dglUniform1fARB(uniforms[index].location, val);
+    }
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, kexVec2 &val) {
+    if(UniformChanged(index, val.ToFloatPtr(), sizeof(float) * 2)) {
+        dglUniform2fvARB(uniforms[index].location, 1, val.ToFloatPtr());
+    }
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, kexVec3 &val) {
+    if(UniformChanged(index, val.ToFloatPtr(), sizeof(float) * 3)) {
+        dglUniform3fvARB(uniforms[index].location, 1, val.ToFloatPtr());
+    }
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, kexVec4 &val) {
+    if(UniformChanged(index, val.ToFloatPtr(), sizeof(float) * 4)) {
+        dglUniform4fvARB(uniforms[index].location, 1, val.ToFloatPtr());
+    }
+}
+
+//
+// kexShaderObj::Upload
+//
+
+void kexShaderObj::Upload(const int index, kexMatrix &val, const bool bTranspose) {
+    if(bTranspose) {
+        // transpose here so the shadow holds what the program sees.
+        // kexMatrix::Transpose only swaps the axes, it isn't this
+        float mtx[16];
+        float *m = val.ToFloatPtr();
+
+        for(int i = 0; i < 4; i++) {
+            for(int j = 0; j < 4; j++) {
+                mtx[i * 4 + j] = m[j * 4 + i];
+            }
+        }
+
+        if(UniformChanged(index, mtx, sizeof(float) * 16)) {
+            dglUniformMatrix4fvARB(uniforms[index].location, 1, false, mtx);
+        }
+        return;
+    }
+
+    if(UniformChanged(index, val.ToFloatPtr(), sizeof(float) * 16)) {
+        dglUniformMatrix4fvARB(uniforms[index].location, 1, false, val.ToFloatPtr());
+    }
+}
+
+//
+// kexShaderObj::SetUniform
+//
+
+void kexShaderObj::SetUniform(const char *name, const int val) {
+    Upload(FindUniform(name), val);
 }
 
 //
@@ -192,10 +346,10 @@ void kexShaderObj::SetUniform(const char *name, const int val) {
 //
 
 void kexShaderObj::SetUniform(const char *name, const int *val, const int size) {
-    int loc = dglGetUniformLocationARB(programObj, name);
+    int index = FindUniform(name);
 
-    if(loc != -1) {
-        dglUniform1ivARB(loc, size, val);
+    if(UniformChanged(index, val, sizeof(int) * size)) {
+        dglUniform1ivARB(uniforms[index].location, size, val);
     }
 }
 
@@ -204,11 +358,7 @@ void kexShaderObj::SetUniform(const char *name, const int *val, const int size)
 //
 
 void kexShaderObj::SetUniform(const char *name, const float val) {
-    int loc = dglGetUniformLocationARB(programObj, name);
-
-    if(loc != -1) {
-        dglUniform1fARB(loc, val);
-    }
+    Upload(FindUniform(name), val);
 }
 
 //
@@ -216,11 +366,7 @@ void kexShaderObj::SetUniform(const char *name, const float val) {
 //
 
 void kexShaderObj::SetUniform(const char *name, kexVec2 &val) {
-    int loc = dglGetUniformLocationARB(programObj, name);
-
-    if(loc != -1) {
-        dglUniform2fvARB(loc, 1, val.ToFloatPtr());
-    }
+    Upload(FindUniform(name), val);
 }
 
 //
@@ -228,11 +374,7 @@ void kexShaderObj::SetUniform(const char *name, kexVec2 &val) {
 //
 
 void kexShaderObj::SetUniform(const char *name, kexVec3 &val) {
-    int loc = dglGetUniformLocationARB(programObj, name);
-
-    if(loc != -1) {
-        dglUniform3fvARB(loc, 1, val.ToFloatPtr());
-    }
+    Upload(FindUniform(name), val);
 }
 
 //
@@ -240,10 +382,10 @@ void kexShaderObj::SetUniform(const char *name, kexVec3 &val) {
 //
 
 void kexShaderObj::SetUniform(const char *name, kexVec3 *val, const int size) {
-    int loc = dglGetUniformLocationARB(programObj, name);
+    int index = FindUniform(name);
 
-    if(loc != -1) {
-        dglUniform3fvARB(loc, size, reinterpret_cast<float*>(&val[0].x));
+    if(UniformChanged(index, &val[0].x, sizeof(kexVec3) * size)) {
+        dglUniform3fvARB(uniforms[index].location, size, reinterpret_cast<float*>(&val[0].x));
     }
 }
 
@@ -252,11 +394,7 @@ void kexShaderObj::SetUniform(const char *name, kexVec3 *val, const int size) {
 //
 
 void kexShaderObj::SetUniform(const char *name, kexVec4 &val) {
-    int loc = dglGetUniformLocationARB(programObj, name);
-
-    if(loc != -1) {
-        dglUniform4fvARB(loc, 1, val.ToFloatPtr());
-    }
+    Upload(FindUniform(name), val);
 }
 
 //
@@ -264,11 +402,7 @@ void kexShaderObj::SetUniform(const char *name, kexVec4 &val) {
 //
 
 void kexShaderObj::SetUniform(const char *name, kexMatrix &val, bool bTranspose) {
-    int loc = dglGetUniformLocationARB(programObj, name);
-
-    if(loc != -1) {
-        dglUniformMatrix4fvARB(loc, 1, bTranspose, val.ToFloatPtr());
-    }
+    Upload(FindUniform(name), val, bTranspose);
 }
 
 //
@@ -309,10 +443,8 @@ void kexShaderObj::CommitGlobalUniforms(const kexMaterial *material) {
         customParametersLocal = new int[len];
         
         for(unsigned int i = 0; i < len; i++) {
-            customParametersLocal[i] = -1;
-            
             kexGetterBase *getter = kexShaderObj::customParameters[i];
-            customParametersLocal[i] = dglGetUniformLocationARB(programObj, getter->Name());
+            customParametersLocal[i] = FindUniform(getter->Name());
         }
     }
     
@@ -325,22 +457,22 @@ void kexShaderObj::CommitGlobalUniforms(const kexMaterial *material) {
         
         switch(getter->ReturnType()) {
             case GRT_FLOAT:
-                dglUniform1fARB(customParametersLocal[i], getter->GetFloatValue());
+                Upload(customParametersLocal[i], getter->GetFloatValue());
                 break;
             case GRT_INT:
-                dglUniform1iARB(customParametersLocal[i], getter->GetIntValue());
+                Upload(customParametersLocal[i], getter->GetIntValue());
                 break;
             case GRT_BOOL:
-                dglUniform1iARB(customParametersLocal[i], getter->GetBoolValue());
+                Upload(customParametersLocal[i], (int)getter->GetBoolValue());
                 break;
             case GRT_VEC2:
-                dglUniform2fvARB(customParametersLocal[i], 1, getter->GetVec2Value().ToFloatPtr());
+                Upload(customParametersLocal[i], getter->GetVec2Value());
                 break;
             case GRT_VEC3:
-                dglUniform3fvARB(customParametersLocal[i], 1, getter->GetVec3Value().ToFloatPtr());
+                Upload(customParametersLocal[i], getter->GetVec3Value());
                 break;
             case GRT_VEC4:
-                dglUniform4fvARB(customParametersLocal[i], 1, getter->GetVec4Value().ToFloatPtr());
+                Upload(customParametersLocal[i], getter->GetVec4Value());
                 break;
             default:
                 break;
@@ -353,11 +485,7 @@ void kexShaderObj::CommitGlobalUniforms(const kexMaterial *material) {
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, int val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniform1iARB(globalParams[param], val);
+    Upload(globalParams[param], val);
 }
 
 //
@@ -365,11 +493,7 @@ void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, int val)
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, float val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniform1fARB(globalParams[param], val);
+    Upload(globalParams[param], val);
 }
 
 //
@@ -377,11 +501,7 @@ void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, float val
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec2 &val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniform2fvARB(globalParams[param], 1, val.ToFloatPtr());
+    Upload(globalParams[param], val);
 }
 
 //
@@ -389,11 +509,7 @@ void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec2 &
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec3 &val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniform3fvARB(globalParams[param], 1, val.ToFloatPtr());
+    Upload(globalParams[param], val);
 }
 
 //
@@ -401,11 +517,7 @@ void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec3 &
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec4 &val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniform4fvARB(globalParams[param], 1, val.ToFloatPtr());
+    Upload(globalParams[param], val);
 }
 
 //
@@ -413,11 +525,7 @@ void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexVec4 &
 //
 
 void kexShaderObj::SetGlobalUniform(const rShaderGlobalParams_t param, kexMatrix &val) {
-    if(globalParams[param] <= -1) {
-        return;
-    }
-
-    dglUniformMatrix4fvARB(globalParams[param], 1, false, val.ToFloatPtr());
+    Upload(globalParams[param], val, false);
 }
 
 //
@@ -436,7 +544,7 @@ void kexShaderObj::DumpErrorLog(const rhandle handle) {
         log = (char*)Mem_Alloca(logLength);
         
         dglGetInfoLogARB(handle, logLength, &cw, log);
-        common.Warning("%s\n", log);
+        common.Warning(LC_RENDER, "%s\n", log);
     }
 }
 
@@ -458,18 +566,75 @@ bool kexShaderObj::Link(void) {
         DumpErrorLog(fragmentProgram);
     }
     else {
-        dglUseProgramObjectARB(programObj);
+        BuildUniformTable();
 
         for(int i = 0; i < RSP_TOTAL; i++) {
-            globalParams[i] = dglGetUniformLocationARB(programObj, shaderParamNames[i]);
+            globalParams[i] = FindUniform(shaderParamNames[i]);
         }
     }
     
-    dglUseProgramObjectARB(0);
     bLoaded = true;
     return (linked > 0);
 }
 
+//
+// kexShaderObj::BuildUniformTable
+//
+// Looks up every active uniform once, so setting one never has
+// to ask the driver where it is
+//
+
+void kexShaderObj::BuildUniformTable(void) {
+    char name[256];
+    int count = 0;
+
+    if(uniforms) {
+        delete[] uniforms;
+        uniforms = NULL;
+    }
+
+    if(customParametersLocal) {
+        delete[] customParametersLocal;
+        customParametersLocal = NULL;
+    }
+
+    numUniforms = 0;
+    dglGetObjectParameterivARB(programObj, GL_OBJECT_ACTIVE_UNIFORMS_ARB, &count);
+
+    if(count <= 0) {
+        return;
+    }
+
+    uniforms = new shaderUniform_t[count];
+
+    for(int i = 0; i < count; i++) {
+        shaderUniform_t *uniform = &uniforms[numUniforms];
+        GLsizei length = 0;
+        GLint size;
+        GLenum type;
+        char *bracket;
+
+        dglGetActiveUniformARB(programObj, i, sizeof(name), &length, &size, &type, name);
+        name[length < (int)sizeof(name) ? length : sizeof(name)-1] = 0;
+
+        // arrays are named after their first element
+        if((bracket = strchr(name, '['))) {
+            *bracket = 0;
+        }
+
+        uniform->location = dglGetUniformLocationARB(programObj, name);
+
+        // built in state doesn't have a location
+        if(uniform->location <= -1) {
+            continue;
+        }
+
+        uniform->name = kexName(name);
+        uniform->shadowSize = 0;
+        numUniforms++;
+    }
+}
+
 //
 // kexShaderManager::OnLoad
 //
@@ -485,7 +650,7 @@ kexShaderObj *kexShaderManager::OnLoad(const char *file) {
         sobj->InitFromDefinition(def);
 
         if(sobj->HasErrors()) {
-            common.Warning("There were some errors when compiling %s\n", file);
+            common.Warning(LC_RENDER, "There were some errors when compiling %s\n", file);
         }
         
     }
@@ -495,3 +660,173 @@ kexShaderObj *kexShaderManager::OnLoad(const char *file) {
 
     return sobj;
 }
+
+//
+// a program as the driver would report it, for testuniformcache
+//
+
+static const char *uniformTestNames[] = {
+    "uDiffuseColor",
+    "uParam1",
+    "uBones[0]",
+    "gl_ModelViewMatrix",
+    "uModel"
+};
+
+static int uniformTestLookups;
+static int uniformTestCalls;
+
+static void APIENTRY UniformTest_LinkProgram(GLhandleARB programObj) {
+}
+
+static void APIENTRY UniformTest_UseProgram(GLhandleARB programObj) {
+}
+
+static void APIENTRY UniformTest_DeleteObject(GLhandleARB obj) {
+}
+
+static void APIENTRY UniformTest_GetObjectParameteriv(GLhandleARB obj, GLenum pname, GLint *params) {
+    *params = (pname == GL_OBJECT_ACTIVE_UNIFORMS_ARB) ? 5 : 1;
+}
+
+static void APIENTRY UniformTest_GetActiveUniform(GLhandleARB programObj, GLuint index,
+                                                  GLsizei maxLength, GLsizei *length,
+                                                  GLint *size, GLenum *type, GLcharARB *name) {
+    strncpy(name, uniformTestNames[index], maxLength);
+    *length = strlen(name);
+    *size = 1;
+    *type = GL_FLOAT;
+}
+
+static GLint APIENTRY UniformTest_GetUniformLocation(GLhandleARB programObj, const GLcharARB *name) {
+    uniformTestLookups++;
+    return strncmp(name, "gl_", 3) ? 10 + uniformTestLookups : -1;
+}
+
+static void APIENTRY UniformTest_Uniform1f(GLint location, GLfloat v0) {
+    uniformTestCalls++;
+}
+
+static void APIENTRY UniformTest_Uniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    uniformTestCalls++;
+}
+
+static void APIENTRY UniformTest_Uniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    uniformTestCalls++;
+}
+
+static void APIENTRY UniformTest_UniformMatrix4fv(GLint location, GLsizei count,
+                                                  GLboolean transpose, const GLfloat *value) {
+    uniformTestCalls++;
+}
+
+//
+// testuniformcache
+//
+// Points the shader entry points at stubs that count what reaches
+// the driver, so it runs without a context
+//
+
+COMMAND(testuniformcache) {
+    PFNGLLINKPROGRAMARBPROC linkProgram = _glLinkProgramARB;
+    PFNGLUSEPROGRAMOBJECTARBPROC useProgram = _glUseProgramObjectARB;
+    PFNGLDELETEOBJECTARBPROC deleteObject = _glDeleteObjectARB;
+    PFNGLGETOBJECTPARAMETERIVARBPROC getObjectParameteriv = _glGetObjectParameterivARB;
+    PFNGLGETACTIVEUNIFORMARBPROC getActiveUniform = _glGetActiveUniformARB;
+    PFNGLGETUNIFORMLOCATIONARBPROC getUniformLocation = _glGetUniformLocationARB;
+    PFNGLUNIFORM1FARBPROC uniform1f = _glUniform1fARB;
+    PFNGLUNIFORM3FVARBPROC uniform3fv = _glUniform3fvARB;
+    PFNGLUNIFORM4FVARBPROC uniform4fv = _glUniform4fvARB;
+    PFNGLUNIFORMMATRIX4FVARBPROC uniformMatrix4fv = _glUniformMatrix4fvARB;
+    rhandle program = renderBackend.glState.currentProgram;
+    kexShaderObj shader;
+    kexVec4 color(1, 0, 0, 1);
+    kexVec3 bones[2];
+    kexMatrix mtx;
+    bool bOk = true;
+
+    _glLinkProgramARB = UniformTest_LinkProgram;
+    _glUseProgramObjectARB = UniformTest_UseProgram;
+    _glDeleteObjectARB = UniformTest_DeleteObject;
+    _glGetObjectParameterivARB = UniformTest_GetObjectParameteriv;
+    _glGetActiveUniformARB = UniformTest_GetActiveUniform;
+    _glGetUniformLocationARB = UniformTest_GetUniformLocation;
+    _glUniform1fARB = UniformTest_Uniform1f;
+    _glUniform3fvARB = UniformTest_Uniform3fv;
+    _glUniform4fvARB = UniformTest_Uniform4fv;
+    _glUniformMatrix4fvARB = UniformTest_UniformMatrix4fv;
+
+    uniformTestLookups = 0;
+    uniformTestCalls = 0;
+
+    shader.Init();
+    shader.Program() = 0x7FFF;
+    shader.Link();
+
+    // built in state is dropped and every location is looked up once
+    if(shader.NumUniforms() != 4 || uniformTestLookups != 5) {
+        bOk = false;
+    }
+
+    renderBackend.glState.currentProgram = 0;
+    shader.Enable();
+
+    // the same value twice only reaches the driver once
+    shader.SetUniform("uParam1", 0.5f);
+    shader.SetUniform("uParam1", 0.5f);
+    shader.SetGlobalUniform(RSP_DIFFUSE_COLOR, color);
+    shader.SetGlobalUniform(RSP_DIFFUSE_COLOR, color);
+    shader.SetUniform("uModel", mtx, false);
+    shader.SetUniform("uModel", mtx, false);
+    shader.SetUniform("uBones", bones, 2);
+    shader.SetUniform("uBones", bones, 2);
+
+    if(uniformTestCalls != 4) {
+        bOk = false;
+    }
+
+    // a new value goes through, transposed matrices always do
+    shader.SetUniform("uParam1", 0.25f);
+    shader.SetUniform("uModel", mtx, true);
+    shader.SetUniform("uModel", mtx, true);
+
+    if(uniformTestCalls != 7) {
+        bOk = false;
+    }
+
+    // names the program doesn't have never reach the driver
+    shader.SetUniform("uNotInThisProgram", 1.0f);
+    shader.SetUniform("uParam", 1.0f);
+
+    if(uniformTestCalls != 7 || uniformTestLookups != 5) {
+        bOk = false;
+    }
+
+    // setting while another program is bound leaves the value unknown
+    renderBackend.glState.currentProgram = 0;
+    shader.SetUniform("uParam1", 0.25f);
+    shader.Enable();
+    shader.SetUniform("uParam1", 0.25f);
+    shader.SetUniform("uParam1", 0.25f);
+
+    if(uniformTestCalls != 9) {
+        bOk = false;
+    }
+
+    shader.Delete();
+
+    _glLinkProgramARB = linkProgram;
+    _glUseProgramObjectARB = useProgram;
+    _glDeleteObjectARB = deleteObject;
+    _glGetObjectParameterivARB = getObjectParameteriv;
+    _glGetActiveUniformARB = getActiveUniform;
+    _glGetUniformLocationARB = getUniformLocation;
+    _glUniform1fARB = uniform1f;
+    _glUniform3fvARB = uniform3fv;
+    _glUniform4fvARB = uniform4fv;
+    _glUniformMatrix4fvARB = uniformMatrix4fv;
+    renderBackend.glState.currentProgram = program;
+
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testuniformcache %s\n",
+        bOk ? "passed" : "failed");
+}
@@ -45,6 +45,20 @@ typedef enum {
 
 typedef GLhandleARB	rhandle;
 
+#define SHADER_UNIFORM_SHADOW   16      // words of a value kept to skip re-sending it, a matrix
+
+//
+// shaderUniform_t - an active uniform, found once when the program is
+// linked. the last value sent is kept so the same value is never sent
+// twice. a shadowSize of 0 means what the program holds isn't known
+//
+typedef struct {
+    kexName                     name;
+    int                         location;
+    int                         shadowSize;
+    int                         shadow[SHADER_UNIFORM_SHADOW];
+} shaderUniform_t;
+
 class kexMaterial;
 class kexShaderManager;
 
@@ -98,6 +112,7 @@ public:
     const bool                  IsLoaded(void) const { return bLoaded; }
     
     void                        ResetValidCount(void) { validCount = 0; }
+    const int                   NumUniforms(void) const { return numUniforms; }
 
     static kexShaderManager     manager;
     
@@ -105,6 +120,15 @@ public:
 
 private:
     void                        DumpErrorLog(const rhandle handle);
+    void                        BuildUniformTable(void);
+    int                         FindUniform(const char *name) const;
+    bool                        UniformChanged(const int index, const void *data, const int size);
+    void                        Upload(const int index, const int val);
+    void                        Upload(const int index, const float val);
+    void                        Upload(const int index, kexVec2 &val);
+    void                        Upload(const int index, kexVec3 &val);
+    void                        Upload(const int index, kexVec4 &val);
+    void                        Upload(const int index, kexMatrix &val, const bool bTranspose);
     
     static kexArray<kexGetterBase*> customParameters;
     
@@ -113,8 +137,10 @@ private:
     rhandle                     fragmentProgram;
     bool                        bHasErrors;
     bool                        bLoaded;
-    int                         globalParams[RSP_TOTAL];
-    int                         *customParametersLocal;
+    shaderUniform_t             *uniforms;
+    int                         numUniforms;
+    int                         globalParams[RSP_TOTAL];    // into uniforms
+    int                         *customParametersLocal;     // into uniforms
     int                         validCount;
 };
 
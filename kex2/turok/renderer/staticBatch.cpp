@@ -0,0 +1,616 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Static geometry batching
+//
+// World models never move once a map is loaded, so the surfaces in
+// each render node that share a material are transformed into world
+// space and merged into one surface, drawn with a single call. Each
+// object keeps its own range of the merged indices; when only some
+// of a batch's objects are visible, their ranges are gathered into
+// a smaller index list for that frame instead
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "renderBackend.h"
+#include "renderMain.h"
+#include "worldModel.h"
+#include "meshOptimizer.h"
+#include "renderWorld.h"
+#include "staticBatch.h"
+
+kexCvar cvarRenderStaticBatching("r_staticbatching", CVF_BOOL|CVF_CONFIG, "1",
+                                 "Merge static surfaces by material in each render node (takes effect on load)");
+kexCvar cvarRenderBatchCulling("r_batchculling", CVF_BOOL|CVF_CONFIG, "1",
+                               "Cull the objects in a static batch individually");
+
+kexHeapBlock kexStaticBatches::hb_staticBatch("static batch", false, NULL, NULL);
+
+//
+// StaticBatch_SameBatch
+//
+
+static bool StaticBatch_SameBatch(const batchSource_t *a, const batchSource_t *b) {
+    if(a->material != b->material) {
+        return false;
+    }
+    if(a->wm->WireFrameColor() != b->wm->WireFrameColor()) {
+        return false;
+    }
+
+    return !memcmp(a->wm->ShaderParams(), b->wm->ShaderParams(), sizeof(float) * 4);
+}
+
+//
+// kexStaticBatches::kexStaticBatches
+//
+
+kexStaticBatches::kexStaticBatches(void) {
+    this->frame             = 0;
+    this->numSurfaceDraws   = 0;
+    this->numDrawnBatches   = 0;
+    this->numPartialBatches = 0;
+}
+
+//
+// kexStaticBatches::~kexStaticBatches
+//
+
+kexStaticBatches::~kexStaticBatches(void) {
+}
+
+//
+// kexStaticBatches::SurfaceMaterial
+//
+// The material a world model draws a surface with
+//
+
+kexMaterial *kexStaticBatches::SurfaceMaterial(const kexWorldModel *wm, const unsigned int index) {
+    kexMaterial *material = wm->Model()->nodes[0].surfaces[index].material;
+
+    if(wm->materials != NULL && wm->materials[index] != NULL) {
+        material = wm->materials[index];
+    }
+
+    if(material == NULL) {
+        material = renderBackend.defaultMaterial;
+    }
+
+    return material;
+}
+
+//
+// kexStaticBatches::TransformVertices
+//
+// Normals go through the inverse transpose, built from the
+// cofactors of the rotation and scale so that non-uniform
+// scaling doesn't bend them
+//
+
+void kexStaticBatches::TransformVertices(surfaceVertex_t *out, const surfaceVertex_t *in,
+                                         const unsigned int numVerts, const kexMatrix &mtx) {
+    kexVec3 c0 = mtx.vectors[0].ToVec3();
+    kexVec3 c1 = mtx.vectors[1].ToVec3();
+    kexVec3 c2 = mtx.vectors[2].ToVec3();
+    kexVec3 n0 = c1.Cross(c2);
+    kexVec3 n1 = c2.Cross(c0);
+    kexVec3 n2 = c0.Cross(c1);
+
+    // mirrored objects would have their normals flipped inside out
+    if(c0.Dot(n0) < 0) {
+        n0 = -n0;
+        n1 = -n1;
+        n2 = -n2;
+    }
+
+    for(unsigned int i = 0; i < numVerts; i++) {
+        kexVec3 xyz = in[i].xyz;
+        kexVec3 normal = n0 * in[i].normal[0] + n1 * in[i].normal[1] + n2 * in[i].normal[2];
+        float len = normal.UnitSq();
+
+        if(len > 0) {
+            normal *= (1.0f / sqrtf(len));
+        }
+
+        out[i] = in[i];
+        out[i].xyz = xyz * mtx;
+        out[i].normal[0] = normal.x;
+        out[i].normal[1] = normal.y;
+        out[i].normal[2] = normal.z;
+    }
+}
+
+//
+// kexStaticBatches::Build
+//
+// Called once the render nodes have been built and every static
+// object has been linked into them
+//
+
+void kexStaticBatches::Build(kexSDNode<kexWorldModel> &renderNodes, const unsigned int numObjects) {
+    kexWorldModel *wm;
+    int numMerged = 0;
+
+    Destroy();
+
+    for(unsigned int i = 0; i < renderNodes.numNodes; i++) {
+        kexSDNodeObj<kexWorldModel> *node = &renderNodes.nodes[i];
+
+        for(wm = node->objects.Next(); wm != NULL; wm = wm->renderNode.link.Next()) {
+            wm->bBatched = false;
+        }
+    }
+
+    if(!cvarRenderStaticBatching.GetBool() || renderNodes.numNodes == 0) {
+        return;
+    }
+
+    nodeBatches.Resize(renderNodes.numNodes + 1);
+    visibleFrame.Resize(numObjects);
+
+    for(unsigned int i = 0; i < numObjects; i++) {
+        visibleFrame[i] = 0;
+    }
+
+    for(unsigned int i = 0; i < renderNodes.numNodes; i++) {
+        nodeBatches[i] = batches.Length();
+        BuildNode(&renderNodes.nodes[i]);
+    }
+
+    nodeBatches[renderNodes.numNodes] = batches.Length();
+
+    for(unsigned int i = 0; i < batches.Length(); i++) {
+        numMerged += batches[i].numInstances;
+    }
+
+    common.Printf(LC_RENDER, "static batching: %i surface draws -> %i batches\n",
+        numMerged, batches.Length());
+}
+
+//
+// kexStaticBatches::BuildNode
+//
+
+void kexStaticBatches::BuildNode(kexSDNodeObj<kexWorldModel> *node) {
+    kexArray<batchSource_t> sources;
+    const kexModel_t *model;
+    kexWorldModel *wm;
+
+    for(wm = node->objects.Next(); wm != NULL; wm = wm->renderNode.link.Next()) {
+        const modelNode_t *mnode;
+        unsigned int i;
+
+        if(!(model = wm->Model()) || wm->queryIndex >= visibleFrame.Length()) {
+            continue;
+        }
+
+        mnode = &model->nodes[0];
+
+        // everything the object draws has to go in, otherwise it
+        // would need to be drawn both ways
+        for(i = 0; i < mnode->numSurfaces; i++) {
+            const surface_t *surface = &mnode->surfaces[i];
+
+            if(!surface->verts || !surface->indices || !surface->numIndices ||
+                surface->numVerts > STATICBATCH_MAX_VERTS) {
+                break;
+            }
+        }
+
+        if(i != mnode->numSurfaces || mnode->numSurfaces == 0) {
+            continue;
+        }
+
+        for(i = 0; i < mnode->numSurfaces; i++) {
+            batchSource_t source;
+
+            source.wm       = wm;
+            source.surface  = &mnode->surfaces[i];
+            source.material = SurfaceMaterial(wm, i);
+            source.batch    = -1;
+
+            sources.Push(source);
+        }
+
+        wm->bBatched = true;
+    }
+
+    for(unsigned int i = 0; i < sources.Length(); i++) {
+        staticBatch_t batch;
+        unsigned int numVerts = 0;
+        int key = (int)batches.Length();
+
+        if(sources[i].batch != -1) {
+            continue;
+        }
+
+        for(unsigned int j = i; j < sources.Length(); j++) {
+            if(sources[j].batch != -1 || !StaticBatch_SameBatch(&sources[i], &sources[j])) {
+                continue;
+            }
+
+            // the rest start a batch of their own
+            if(numVerts + sources[j].surface->numVerts > STATICBATCH_MAX_VERTS) {
+                continue;
+            }
+
+            numVerts += sources[j].surface->numVerts;
+            sources[j].batch = key;
+        }
+
+        MergeBatch(batch, sources, key);
+        batches.Push(batch);
+    }
+}
+
+//
+// kexStaticBatches::MergeBatch
+//
+
+void kexStaticBatches::MergeBatch(staticBatch_t &batch, kexArray<batchSource_t> &sources,
+                                  const int key) {
+    surface_t *surface = &batch.surface;
+    unsigned int numVerts = 0;
+    unsigned int numIndices = 0;
+    unsigned int numInstances = 0;
+    word *indices;
+
+    for(unsigned int i = 0; i < sources.Length(); i++) {
+        if(sources[i].batch == key) {
+            numVerts += sources[i].surface->numVerts;
+            numIndices += sources[i].surface->numIndices;
+            numInstances++;
+        }
+    }
+
+    surface->flags          = 0;
+    surface->material       = NULL;
+    surface->vertexBuffer   = 0;
+    surface->indexBuffer    = 0;
+    surface->vertexOffset   = 0;
+    surface->indexOffset    = 0;
+    surface->bounds.Clear();
+
+    surface->numVerts       = numVerts;
+    surface->numIndices     = numIndices;
+    surface->verts          = (surfaceVertex_t*)Mem_Malloc(sizeof(surfaceVertex_t) * numVerts, hb_staticBatch);
+    surface->indices        = (word*)Mem_Malloc(sizeof(word) * numIndices, hb_staticBatch);
+
+    batch.instances         = (batchInstance_t*)Mem_Malloc(sizeof(batchInstance_t) * numInstances, hb_staticBatch);
+    batch.numInstances      = numInstances;
+    batch.material          = NULL;
+
+    numVerts = numIndices = numInstances = 0;
+
+    for(unsigned int i = 0; i < sources.Length(); i++) {
+        const batchSource_t *source = &sources[i];
+        batchInstance_t *instance;
+
+        if(source->batch != key) {
+            continue;
+        }
+
+        if(batch.material == NULL) {
+            batch.material = source->material;
+            surface->material = source->material;
+        }
+
+        instance = &batch.instances[numInstances++];
+        instance->wm            = source->wm;
+        instance->source        = source->surface;
+        instance->firstVertex   = numVerts;
+        instance->firstIndex    = numIndices;
+        instance->numIndices    = source->surface->numIndices;
+
+        TransformVertices(surface->verts + numVerts, source->surface->verts,
+            source->surface->numVerts, source->wm->Matrix());
+
+        indices = surface->indices + numIndices;
+
+        for(unsigned int j = 0; j < source->surface->numIndices; j++) {
+            indices[j] = (word)(source->surface->indices[j] + numVerts);
+        }
+
+        numVerts += source->surface->numVerts;
+        numIndices += source->surface->numIndices;
+    }
+
+    kexMeshOptimizer::ComputeBounds(surface->verts, surface->numVerts, surface->bounds);
+    renderer.UploadSurface(surface);
+
+    // same vertices, but its indices come from client memory
+    batch.partial = *surface;
+    batch.partial.indices = (word*)Mem_Malloc(sizeof(word) * numIndices, hb_staticBatch);
+    batch.partial.indexBuffer = 0;
+    batch.partial.indexOffset = 0;
+}
+
+//
+// kexStaticBatches::Destroy
+//
+// The objects the batches were built from may already be gone,
+// so only the batches themselves are touched here
+//
+
+void kexStaticBatches::Destroy(void) {
+    for(unsigned int i = 0; i < batches.Length(); i++) {
+        staticBatch_t *batch = &batches[i];
+
+        renderer.ReleaseSurface(&batch->surface);
+
+        Mem_Free(batch->surface.verts);
+        Mem_Free(batch->surface.indices);
+        Mem_Free(batch->partial.indices);
+        Mem_Free(batch->instances);
+    }
+
+    batches.Empty();
+    nodeBatches.Empty();
+    visibleFrame.Empty();
+}
+
+//
+// kexStaticBatches::BeginFrame
+//
+
+void kexStaticBatches::BeginFrame(void) {
+    frame++;
+    numDrawnBatches = 0;
+    numPartialBatches = 0;
+    numSurfaceDraws = 0;
+}
+
+//
+// kexStaticBatches::MarkVisible
+//
+
+void kexStaticBatches::MarkVisible(const kexWorldModel *wm) {
+    if(wm->queryIndex < visibleFrame.Length()) {
+        visibleFrame[wm->queryIndex] = frame;
+    }
+}
+
+//
+// kexStaticBatches::DrawNode
+//
+// Adds the node's batches to the draw list. Objects that weren't
+// marked visible this frame are left out of the index list, which
+// includes any that dropped out of their batch and draw on their own
+//
+
+void kexStaticBatches::DrawNode(const int nodenum) {
+    static kexMatrix identity;
+
+    if((unsigned int)nodenum + 1 >= nodeBatches.Length()) {
+        return;
+    }
+
+    for(unsigned int i = nodeBatches[nodenum]; i < nodeBatches[nodenum+1]; i++) {
+        staticBatch_t *batch = &batches[i];
+        const surface_t *surface = &batch->surface;
+        kexWorldModel *refObj = NULL;
+        unsigned int numIndices = 0;
+        unsigned int numVisible = 0;
+
+        for(unsigned int j = 0; j < batch->numInstances; j++) {
+            if(visibleFrame[batch->instances[j].wm->queryIndex] == frame) {
+                numIndices += batch->instances[j].numIndices;
+                numVisible++;
+
+                // everything still in the batch has the shader params
+                // it was built with
+                if(refObj == NULL) {
+                    refObj = batch->instances[j].wm;
+                }
+            }
+        }
+
+        if(numVisible == 0) {
+            continue;
+        }
+
+        if(numVisible != batch->numInstances) {
+            word *indices = batch->partial.indices;
+
+            for(unsigned int j = 0; j < batch->numInstances; j++) {
+                const batchInstance_t *instance = &batch->instances[j];
+
+                if(visibleFrame[instance->wm->queryIndex] != frame) {
+                    continue;
+                }
+
+                memcpy(indices, surface->indices + instance->firstIndex,
+                    sizeof(word) * instance->numIndices);
+                indices += instance->numIndices;
+            }
+
+            batch->partial.numIndices = numIndices;
+            surface = &batch->partial;
+            numPartialBatches++;
+        }
+
+        renderer.AddSurface(surface,
+                            batch->material,
+                            identity,
+                            refObj,
+                            batch->material->SortOrder());
+
+        numDrawnBatches++;
+        numSurfaceDraws += numVisible;
+    }
+}
+
+//
+// StaticBatch_CheckInstance
+//
+// Compares an object's part of a batch against its own surface
+// pushed through its matrix
+//
+
+static bool StaticBatch_CheckInstance(const staticBatch_t &batch, const batchInstance_t &instance) {
+    const surface_t *source = instance.source;
+    const surfaceVertex_t *verts = batch.surface.verts + instance.firstVertex;
+    const word *indices = batch.surface.indices + instance.firstIndex;
+
+    if(instance.numIndices != source->numIndices ||
+        instance.firstVertex + source->numVerts > batch.surface.numVerts ||
+        instance.firstIndex + instance.numIndices > batch.surface.numIndices) {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < source->numVerts; i++) {
+        kexVec3 xyz = source->verts[i].xyz;
+
+        xyz = xyz * instance.wm->Matrix();
+
+        if(xyz.DistanceSq(verts[i].xyz) > 0.0001f ||
+            !batch.surface.bounds.PointInside(verts[i].xyz) ||
+            memcmp(verts[i].st, source->verts[i].st, sizeof(float) * 2) ||
+            memcmp(verts[i].rgba, source->verts[i].rgba, 4)) {
+            return false;
+        }
+    }
+
+    for(unsigned int i = 0; i < instance.numIndices; i++) {
+        if(indices[i] != source->indices[i] + instance.firstVertex) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// StaticBatch_CheckNormals
+//
+// A transformed normal has to stay at right angles to anything
+// that was tangent to it, even when the scale isn't uniform
+//
+
+static bool StaticBatch_CheckNormals(const kexMatrix &mtx) {
+    surfaceVertex_t in[64];
+    surfaceVertex_t out[64];
+    kexVec3 zero(0, 0, 0);
+    kexVec3 origin = zero * mtx;
+
+    for(int i = 0; i < 64; i++) {
+        kexVec3 n(kexRand::CFloat(), kexRand::CFloat(), kexRand::CFloat() + 2);
+
+        n.Normalize();
+        in[i].xyz.Set(kexRand::CFloat() * 256, kexRand::CFloat() * 256, kexRand::CFloat() * 256);
+        in[i].st[0] = in[i].st[1] = 0;
+        in[i].normal[0] = n.x;
+        in[i].normal[1] = n.y;
+        in[i].normal[2] = n.z;
+        in[i].rgba[0] = in[i].rgba[1] = in[i].rgba[2] = in[i].rgba[3] = 0;
+    }
+
+    kexStaticBatches::TransformVertices(out, in, 64, mtx);
+
+    for(int i = 0; i < 64; i++) {
+        kexVec3 n(in[i].normal[0], in[i].normal[1], in[i].normal[2]);
+        kexVec3 nout(out[i].normal[0], out[i].normal[1], out[i].normal[2]);
+        kexVec3 t = n.Cross(kexVec3(1, 0, 0));
+        kexVec3 tout = (t * mtx) - origin;
+        kexVec3 ndir = (n * mtx) - origin;
+
+        if(kexMath::Fabs(nout.UnitSq() - 1) > 0.001f ||
+            kexMath::Fabs(nout.Dot(tout)) > 0.001f * sqrtf(tout.UnitSq()) ||
+            nout.Dot(ndir) <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// testbatching
+//
+
+COMMAND(testbatching) {
+    kexStaticBatches &batches = renderWorld.staticBatches;
+    kexMatrix mtx(kexMath::Deg2Rad(30), 2);
+    int numInstances = 0;
+    int numUnbatched = 0;
+    int numBad = 0;
+    bool bOk = true;
+
+    mtx.Scale(1, 3, 0.5f);
+    mtx.AddTranslation(100, -50, 20);
+
+    if(!StaticBatch_CheckNormals(mtx)) {
+        common.Warning(LC_RENDER, "testbatching: normals wrong with non-uniform scale\n");
+        bOk = false;
+    }
+
+    mtx.Scale(-1, 1, 1);
+
+    if(!StaticBatch_CheckNormals(mtx)) {
+        common.Warning(LC_RENDER, "testbatching: normals wrong on a mirrored matrix\n");
+        bOk = false;
+    }
+
+    for(unsigned int i = 0; i < batches.NumBatches(); i++) {
+        staticBatch_t &batch = batches.Batch(i);
+        const kexWorldModel *refObj = NULL;
+
+        for(unsigned int j = 0; j < batch.numInstances; j++) {
+            const kexWorldModel *wm = batch.instances[j].wm;
+
+            if(!StaticBatch_CheckInstance(batch, batch.instances[j])) {
+                numBad++;
+            }
+
+            numInstances++;
+
+            if(!wm->bBatched) {
+                numUnbatched++;
+                continue;
+            }
+
+            // a shader param change has to take the object out
+            if(refObj == NULL) {
+                refObj = wm;
+            }
+            else if(memcmp(refObj->ShaderParams(), wm->ShaderParams(), sizeof(float) * 4)) {
+                numBad++;
+            }
+        }
+    }
+
+    if(numInstances) {
+        common.Printf(LC_RENDER, "%i surface draws -> %i batches, %i since taken out, %i mismatched\n",
+            numInstances, batches.NumBatches(), numUnbatched, numBad);
+    }
+    else {
+        common.Printf(LC_RENDER, "no batches built, load a map to check merged geometry\n");
+    }
+
+    if(numBad) {
+        bOk = false;
+    }
+
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testbatching %s\n",
+        bOk ? "passed" : "failed");
+}
@@ -0,0 +1,94 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __STATICBATCH_H__
+#define __STATICBATCH_H__
+
+#include "renderMain.h"
+#include "sdNodes.h"
+
+class kexWorldModel;
+
+// indices are words so a batch can't address more than this
+#define STATICBATCH_MAX_VERTS   0x10000
+
+typedef struct {
+    kexWorldModel           *wm;
+    const surface_t         *source;
+    unsigned int            firstVertex;
+    unsigned int            firstIndex;
+    unsigned int            numIndices;
+} batchInstance_t;
+
+typedef struct {
+    kexWorldModel           *wm;
+    const surface_t         *surface;
+    kexMaterial             *material;
+    int                     batch;
+} batchSource_t;
+
+typedef struct {
+    surface_t               surface;
+    surface_t               partial;        // visible instances only, refilled every frame
+    kexMaterial             *material;
+    batchInstance_t         *instances;
+    unsigned int            numInstances;
+} staticBatch_t;
+
+class kexStaticBatches {
+public:
+                            kexStaticBatches(void);
+                            ~kexStaticBatches(void);
+
+    void                    Build(kexSDNode<kexWorldModel> &renderNodes, const unsigned int numObjects);
+    void                    Destroy(void);
+    void                    BeginFrame(void);
+    void                    MarkVisible(const kexWorldModel *wm);
+    void                    DrawNode(const int nodenum);
+
+    static kexMaterial      *SurfaceMaterial(const kexWorldModel *wm, const unsigned int index);
+    static void             TransformVertices(surfaceVertex_t *out, const surfaceVertex_t *in,
+                                              const unsigned int numVerts, const kexMatrix &mtx);
+
+    const unsigned int      NumBatches(void) const { return batches.Length(); }
+    staticBatch_t           &Batch(const unsigned int index) { return batches[index]; }
+    const int               NumSurfaceDraws(void) const { return numSurfaceDraws; }
+    const int               NumDrawnBatches(void) const { return numDrawnBatches; }
+    const int               NumPartialBatches(void) const { return numPartialBatches; }
+
+    static kexHeapBlock     hb_staticBatch;
+
+private:
+    void                    BuildNode(kexSDNodeObj<kexWorldModel> *node);
+    void                    MergeBatch(staticBatch_t &batch, kexArray<batchSource_t> &sources,
+                                       const int key);
+
+    kexArray<staticBatch_t> batches;
+    kexArray<unsigned int>  nodeBatches;    // first batch of each node, plus one past the last
+    kexArray<int>           visibleFrame;   // indexed by queryIndex
+    int                     frame;
+    int                     numSurfaceDraws;
+    int                     numDrawnBatches;
+    int                     numPartialBatches;
+};
+
+#endif
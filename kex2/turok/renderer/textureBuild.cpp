@@ -0,0 +1,1094 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Offline texture baking. Builds the mip chain in linear
+//              light, optionally packs every level into BC1/BC3 blocks
+//              and writes the result out as a .ktex for the loader
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "memHeap.h"
+#include "mathlib.h"
+#include "binFile.h"
+#include "textureBuild.h"
+
+extern kexCvar cvarBasePath;
+
+static float srgbToLinear[256];
+static byte singleColor5[256][2];
+static byte singleColor6[256][2];
+static bool bTablesInit = false;
+
+//
+// TextureBuild_InitSingleColor
+//
+// Endpoint pairs whose first interpolated color lands closest to each
+// value, so flat blocks don't lose the bits that 565 can't hold
+//
+
+static void TextureBuild_InitSingleColor(byte table[256][2], const int bits) {
+    int max = (1 << bits) - 1;
+    int best, error, ea, eb;
+
+    for(int v = 0; v < 256; v++) {
+        best = 0x7fffffff;
+
+        for(int a = 0; a <= max; a++) {
+            for(int b = 0; b <= max; b++) {
+                ea = (a << (8 - bits)) | (a >> (2 * bits - 8));
+                eb = (b << (8 - bits)) | (b >> (2 * bits - 8));
+
+                // prefer close endpoints, decoders round differently
+                error = kexMath::Abs((2 * ea + eb) / 3 - v) * 256 + kexMath::Abs(ea - eb);
+
+                if(error < best) {
+                    best = error;
+                    table[v][0] = a;
+                    table[v][1] = b;
+                }
+            }
+        }
+    }
+}
+
+//
+// TextureBuild_InitTables
+//
+
+static void TextureBuild_InitTables(void) {
+    float c;
+
+    if(bTablesInit) {
+        return;
+    }
+
+    for(int i = 0; i < 256; i++) {
+        c = (float)i / 255.0f;
+
+        if(c <= 0.04045f) {
+            srgbToLinear[i] = c / 12.92f;
+        }
+        else {
+            srgbToLinear[i] = kexMath::Pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+    }
+
+    TextureBuild_InitSingleColor(singleColor5, 5);
+    TextureBuild_InitSingleColor(singleColor6, 6);
+
+    bTablesInit = true;
+}
+
+//
+// TextureBuild_LinearToSRGB
+//
+
+static byte TextureBuild_LinearToSRGB(const float f) {
+    float c;
+
+    if(f <= 0.0031308f) {
+        c = f * 12.92f;
+    }
+    else {
+        c = 1.055f * kexMath::Pow(f, 1.0f / 2.4f) - 0.055f;
+    }
+
+    c = c * 255.0f + 0.5f;
+    kexMath::Clamp(c, 0, 255);
+
+    return (byte)c;
+}
+
+//
+// TextureBuild_Write32
+//
+
+static void TextureBuild_Write32(byte **rover, const int val) {
+    (*rover)[0] = val & 0xff;
+    (*rover)[1] = (val >> 8) & 0xff;
+    (*rover)[2] = (val >> 16) & 0xff;
+    (*rover)[3] = (val >> 24) & 0xff;
+    *rover += 4;
+}
+
+//
+// TextureBuild_To565
+//
+
+static word TextureBuild_To565(const float *color) {
+    int r = (int)(color[0] * (31.0f / 255.0f) + 0.5f);
+    int g = (int)(color[1] * (63.0f / 255.0f) + 0.5f);
+    int b = (int)(color[2] * (31.0f / 255.0f) + 0.5f);
+
+    kexMath::Clamp(r, 0, 31);
+    kexMath::Clamp(g, 0, 63);
+    kexMath::Clamp(b, 0, 31);
+
+    return (r << 11) | (g << 5) | b;
+}
+
+//
+// TextureBuild_ColorPalette
+//
+// Expands the two endpoints of a color block the way the hardware does
+//
+
+static void TextureBuild_ColorPalette(const word c0, const word c1, const bool bFourColor,
+                                      int palette[4][3]) {
+    int r0 = (c0 >> 11) & 31, g0 = (c0 >> 5) & 63, b0 = c0 & 31;
+    int r1 = (c1 >> 11) & 31, g1 = (c1 >> 5) & 63, b1 = c1 & 31;
+
+    palette[0][0] = (r0 << 3) | (r0 >> 2);
+    palette[0][1] = (g0 << 2) | (g0 >> 4);
+    palette[0][2] = (b0 << 3) | (b0 >> 2);
+    palette[1][0] = (r1 << 3) | (r1 >> 2);
+    palette[1][1] = (g1 << 2) | (g1 >> 4);
+    palette[1][2] = (b1 << 3) | (b1 >> 2);
+
+    for(int i = 0; i < 3; i++) {
+        if(bFourColor) {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+        else {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+            palette[3][i] = 0;
+        }
+    }
+}
+
+//
+// TextureBuild_FitColors
+//
+// Picks the closest palette entry for every pixel and returns the
+// total squared error
+//
+
+static int TextureBuild_FitColors(const byte *rgba, const word c0, const word c1,
+                                  unsigned int *indices) {
+    int palette[4][3];
+    int error = 0;
+    int best;
+    int bestError;
+    int d;
+
+    TextureBuild_ColorPalette(c0, c1, true, palette);
+    *indices = 0;
+
+    for(int i = 0; i < 16; i++) {
+        best = 0;
+        bestError = 0x7fffffff;
+
+        for(int j = 0; j < 4; j++) {
+            int e = 0;
+
+            for(int k = 0; k < 3; k++) {
+                d = rgba[i * 4 + k] - palette[j][k];
+                e += d * d;
+            }
+
+            if(e < bestError) {
+                bestError = e;
+                best = j;
+            }
+        }
+
+        *indices |= (best << (i * 2));
+        error += bestError;
+    }
+
+    return error;
+}
+
+//
+// TextureBuild_RefineColors
+//
+// Least squares fit of the two endpoints to the pixels, keeping the
+// palette entry each pixel was given
+//
+
+static bool TextureBuild_RefineColors(const byte *rgba, const unsigned int indices,
+                                      float *e0, float *e1) {
+    static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0, ab = 0, bb = 0;
+    float ap[3] = { 0, 0, 0 };
+    float bp[3] = { 0, 0, 0 };
+    float a, b, det;
+
+    for(int i = 0; i < 16; i++) {
+        a = weights[(indices >> (i * 2)) & 3];
+        b = 1.0f - a;
+
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+
+        for(int k = 0; k < 3; k++) {
+            ap[k] += a * rgba[i * 4 + k];
+            bp[k] += b * rgba[i * 4 + k];
+        }
+    }
+
+    det = aa * bb - ab * ab;
+
+    if(kexMath::Fabs(det) < 0.0001f) {
+        // every pixel picked the same end
+        return false;
+    }
+
+    for(int k = 0; k < 3; k++) {
+        e0[k] = (ap[k] * bb - bp[k] * ab) / det;
+        e1[k] = (bp[k] * aa - ap[k] * ab) / det;
+
+        kexMath::Clamp(e0[k], 0, 255);
+        kexMath::Clamp(e1[k], 0, 255);
+    }
+
+    return true;
+}
+
+//
+// TextureBuild_FitEndpoints
+//
+// Endpoints start at the ends of the block's principal axis and are
+// then refit to the pixels until the error stops going down
+//
+
+static void TextureBuild_FitEndpoints(const byte *rgba, word *c0, word *c1, unsigned int *bestIndices) {
+    float mean[3] = { 0, 0, 0 };
+    float cov[6] = { 0, 0, 0, 0, 0, 0 };
+    float axis[3];
+    float v[3];
+    float e0[3];
+    float e1[3];
+    float t, tmin, tmax, len;
+    unsigned int indices;
+    int error, bestError;
+
+    for(int i = 0; i < 16; i++) {
+        for(int k = 0; k < 3; k++) {
+            mean[k] += rgba[i * 4 + k];
+        }
+    }
+
+    for(int k = 0; k < 3; k++) {
+        mean[k] *= (1.0f / 16.0f);
+    }
+
+    for(int i = 0; i < 16; i++) {
+        float r = rgba[i * 4 + 0] - mean[0];
+        float g = rgba[i * 4 + 1] - mean[1];
+        float b = rgba[i * 4 + 2] - mean[2];
+
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+    }
+
+    // power iteration, starting from the channel that varies the most
+    if(cov[0] >= cov[3] && cov[0] >= cov[5]) {
+        axis[0] = cov[0]; axis[1] = cov[1]; axis[2] = cov[2];
+    }
+    else if(cov[3] >= cov[5]) {
+        axis[0] = cov[1]; axis[1] = cov[3]; axis[2] = cov[4];
+    }
+    else {
+        axis[0] = cov[2]; axis[1] = cov[4]; axis[2] = cov[5];
+    }
+
+    len = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+    if(len < 0.0001f) {
+        // no spread to follow
+        for(int k = 0; k < 3; k++) {
+            e0[k] = e1[k] = mean[k];
+        }
+    }
+    else {
+        for(int iter = 0; iter < 8; iter++) {
+            v[0] = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            v[1] = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            v[2] = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+
+            len = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+
+            if(len < 0.0001f) {
+                break;
+            }
+
+            len = kexMath::InvSqrt(len);
+            axis[0] = v[0] * len;
+            axis[1] = v[1] * len;
+            axis[2] = v[2] * len;
+        }
+
+        tmin = tmax = 0;
+
+        for(int i = 0; i < 16; i++) {
+            t = (rgba[i * 4 + 0] - mean[0]) * axis[0] +
+                (rgba[i * 4 + 1] - mean[1]) * axis[1] +
+                (rgba[i * 4 + 2] - mean[2]) * axis[2];
+
+            if(t < tmin) tmin = t;
+            if(t > tmax) tmax = t;
+        }
+
+        for(int k = 0; k < 3; k++) {
+            e0[k] = mean[k] + axis[k] * tmax;
+            e1[k] = mean[k] + axis[k] * tmin;
+
+            kexMath::Clamp(e0[k], 0, 255);
+            kexMath::Clamp(e1[k], 0, 255);
+        }
+    }
+
+    *c0 = TextureBuild_To565(e0);
+    *c1 = TextureBuild_To565(e1);
+    bestError = TextureBuild_FitColors(rgba, *c0, *c1, bestIndices);
+
+    for(int iter = 0; iter < 2 && bestError > 0; iter++) {
+        word n0, n1;
+
+        if(!TextureBuild_RefineColors(rgba, *bestIndices, e0, e1)) {
+            break;
+        }
+
+        n0 = TextureBuild_To565(e0);
+        n1 = TextureBuild_To565(e1);
+        error = TextureBuild_FitColors(rgba, n0, n1, &indices);
+
+        if(error >= bestError) {
+            break;
+        }
+
+        *c0 = n0;
+        *c1 = n1;
+        *bestIndices = indices;
+        bestError = error;
+    }
+}
+
+//
+// TextureBuild_EncodeColor
+//
+
+static void TextureBuild_EncodeColor(const byte *rgba, byte *block) {
+    unsigned int indices;
+    word c0, c1, tmp;
+    bool bFlat = true;
+
+    TextureBuild_InitTables();
+
+    for(int i = 1; i < 16 && bFlat; i++) {
+        for(int k = 0; k < 3; k++) {
+            if(rgba[i * 4 + k] != rgba[k]) {
+                bFlat = false;
+            }
+        }
+    }
+
+    if(bFlat) {
+        // every pixel uses the first interpolated color
+        c0 = (singleColor5[rgba[0]][0] << 11) | (singleColor6[rgba[1]][0] << 5) | singleColor5[rgba[2]][0];
+        c1 = (singleColor5[rgba[0]][1] << 11) | (singleColor6[rgba[1]][1] << 5) | singleColor5[rgba[2]][1];
+        indices = 0xaaaaaaaa;
+    }
+    else {
+        TextureBuild_FitEndpoints(rgba, &c0, &c1, &indices);
+    }
+
+    // the first endpoint has to be the larger one for four colors.
+    // swapping them swaps entries 0/1 and 2/3, which is the low bit
+    if(c0 < c1) {
+        tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+        indices ^= 0x55555555;
+    }
+    else if(c0 == c1) {
+        // three color block, entry 3 would be black
+        indices = 0;
+    }
+
+    block[0] = c0 & 0xff;
+    block[1] = (c0 >> 8) & 0xff;
+    block[2] = c1 & 0xff;
+    block[3] = (c1 >> 8) & 0xff;
+    block[4] = indices & 0xff;
+    block[5] = (indices >> 8) & 0xff;
+    block[6] = (indices >> 16) & 0xff;
+    block[7] = (indices >> 24) & 0xff;
+}
+
+//
+// TextureBuild_DecodeColor
+//
+
+static void TextureBuild_DecodeColor(const byte *block, byte *rgba, const bool bAlwaysFour) {
+    word c0 = block[0] | (block[1] << 8);
+    word c1 = block[2] | (block[3] << 8);
+    unsigned int indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((unsigned int)block[7] << 24);
+    bool bFourColor = (bAlwaysFour || c0 > c1);
+    int palette[4][3];
+    int index;
+
+    TextureBuild_ColorPalette(c0, c1, bFourColor, palette);
+
+    for(int i = 0; i < 16; i++) {
+        index = (indices >> (i * 2)) & 3;
+
+        rgba[i * 4 + 0] = palette[index][0];
+        rgba[i * 4 + 1] = palette[index][1];
+        rgba[i * 4 + 2] = palette[index][2];
+        rgba[i * 4 + 3] = (!bFourColor && index == 3) ? 0 : 255;
+    }
+}
+
+//
+// TextureBuild_AlphaPalette
+//
+
+static void TextureBuild_AlphaPalette(const int a0, const int a1, int palette[8]) {
+    palette[0] = a0;
+    palette[1] = a1;
+
+    if(a0 > a1) {
+        for(int i = 2; i < 8; i++) {
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        }
+    }
+    else {
+        for(int i = 2; i < 6; i++) {
+            palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        }
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+//
+// kexTextureBuilder::EncodeBC1
+//
+// Packs 16 RGBA pixels into an 8 byte block. Alpha is ignored
+//
+
+void kexTextureBuilder::EncodeBC1(const byte *rgba, byte *block) {
+    TextureBuild_EncodeColor(rgba, block);
+}
+
+//
+// kexTextureBuilder::EncodeBC3
+//
+// Packs 16 RGBA pixels into a 16 byte block, an alpha block spanning
+// the lowest and highest alpha followed by a BC1 color block
+//
+
+void kexTextureBuilder::EncodeBC3(const byte *rgba, byte *block) {
+    int a0 = 0;
+    int a1 = 255;
+    int palette[8];
+    int best, bestError, d;
+    uint64_t bits = 0;
+
+    for(int i = 0; i < 16; i++) {
+        a0 = MAX(a0, rgba[i * 4 + 3]);
+        a1 = MIN(a1, rgba[i * 4 + 3]);
+    }
+
+    TextureBuild_AlphaPalette(a0, a1, palette);
+
+    if(a0 != a1) {
+        for(int i = 0; i < 16; i++) {
+            best = 0;
+            bestError = 256;
+
+            for(int j = 0; j < 8; j++) {
+                d = kexMath::Abs(rgba[i * 4 + 3] - palette[j]);
+
+                if(d < bestError) {
+                    bestError = d;
+                    best = j;
+                }
+            }
+
+            bits |= ((uint64_t)best << (i * 3));
+        }
+    }
+
+    block[0] = a0;
+    block[1] = a1;
+
+    for(int i = 0; i < 6; i++) {
+        block[2 + i] = (byte)((bits >> (i * 8)) & 0xff);
+    }
+
+    TextureBuild_EncodeColor(rgba, block + 8);
+}
+
+//
+// kexTextureBuilder::DecodeBC1
+//
+
+void kexTextureBuilder::DecodeBC1(const byte *block, byte *rgba) {
+    TextureBuild_DecodeColor(block, rgba, false);
+}
+
+//
+// kexTextureBuilder::DecodeBC3
+//
+
+void kexTextureBuilder::DecodeBC3(const byte *block, byte *rgba) {
+    int palette[8];
+    uint64_t bits = 0;
+
+    TextureBuild_DecodeColor(block + 8, rgba, true);
+    TextureBuild_AlphaPalette(block[0], block[1], palette);
+
+    for(int i = 0; i < 6; i++) {
+        bits |= ((uint64_t)block[2 + i] << (i * 8));
+    }
+
+    for(int i = 0; i < 16; i++) {
+        rgba[i * 4 + 3] = palette[(bits >> (i * 3)) & 7];
+    }
+}
+
+//
+// kexTextureBuilder::CompressedSize
+//
+
+int kexTextureBuilder::CompressedSize(const int width, const int height,
+                                      const texCompressMode_t mode) {
+    int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (mode == TCM_BC3 ? 16 : 8);
+}
+
+//
+// kexTextureBuilder::Compress
+//
+// Blocks that hang off the edge of levels smaller than 4x4 repeat
+// the last row and column
+//
+
+void kexTextureBuilder::Compress(const byte *src, const int width, const int height,
+                                 const int channels, const texCompressMode_t mode, byte *dst) {
+    byte rgba[16 * 4];
+    const byte *pixel;
+    int x, y;
+
+    for(int by = 0; by < height; by += 4) {
+        for(int bx = 0; bx < width; bx += 4) {
+            for(int i = 0; i < 16; i++) {
+                x = MIN(bx + (i & 3), width - 1);
+                y = MIN(by + (i >> 2), height - 1);
+                pixel = src + (y * width + x) * channels;
+
+                rgba[i * 4 + 0] = pixel[0];
+                rgba[i * 4 + 1] = pixel[1];
+                rgba[i * 4 + 2] = pixel[2];
+                rgba[i * 4 + 3] = (channels == 4) ? pixel[3] : 255;
+            }
+
+            if(mode == TCM_BC3) {
+                EncodeBC3(rgba, dst);
+                dst += 16;
+            }
+            else {
+                EncodeBC1(rgba, dst);
+                dst += 8;
+            }
+        }
+    }
+}
+
+//
+// kexTextureBuilder::Decompress
+//
+
+void kexTextureBuilder::Decompress(const byte *src, const int width, const int height,
+                                   const int channels, const texCompressMode_t mode, byte *dst) {
+    byte rgba[16 * 4];
+    byte *pixel;
+    int x, y;
+
+    for(int by = 0; by < height; by += 4) {
+        for(int bx = 0; bx < width; bx += 4) {
+            if(mode == TCM_BC3) {
+                DecodeBC3(src, rgba);
+                src += 16;
+            }
+            else {
+                DecodeBC1(src, rgba);
+                src += 8;
+            }
+
+            for(int i = 0; i < 16; i++) {
+                x = bx + (i & 3);
+                y = by + (i >> 2);
+
+                if(x >= width || y >= height) {
+                    continue;
+                }
+
+                pixel = dst + (y * width + x) * channels;
+
+                for(int k = 0; k < channels; k++) {
+                    pixel[k] = rgba[i * 4 + k];
+                }
+            }
+        }
+    }
+}
+
+//
+// kexTextureBuilder::BuildMip
+//
+// Halves the image with a 2x2 box. Color is averaged in linear light
+// so fine detail doesn't darken as it shrinks, alpha is averaged as is
+//
+
+void kexTextureBuilder::BuildMip(const byte *src, const int width, const int height,
+                                 const int channels, byte *dst) {
+    int mipWidth = MAX(width >> 1, 1);
+    int mipHeight = MAX(height >> 1, 1);
+    const byte *s[4];
+    int x0, x1, y0, y1;
+
+    TextureBuild_InitTables();
+
+    for(int y = 0; y < mipHeight; y++) {
+        y0 = MIN(y * 2, height - 1);
+        y1 = MIN(y * 2 + 1, height - 1);
+
+        for(int x = 0; x < mipWidth; x++) {
+            x0 = MIN(x * 2, width - 1);
+            x1 = MIN(x * 2 + 1, width - 1);
+
+            s[0] = src + (y0 * width + x0) * channels;
+            s[1] = src + (y0 * width + x1) * channels;
+            s[2] = src + (y1 * width + x0) * channels;
+            s[3] = src + (y1 * width + x1) * channels;
+
+            for(int c = 0; c < channels; c++) {
+                if(c == 3) {
+                    *dst++ = (s[0][c] + s[1][c] + s[2][c] + s[3][c] + 2) >> 2;
+                    continue;
+                }
+
+                *dst++ = TextureBuild_LinearToSRGB((srgbToLinear[s[0][c]] +
+                                                    srgbToLinear[s[1][c]] +
+                                                    srgbToLinear[s[2][c]] +
+                                                    srgbToLinear[s[3][c]]) * 0.25f);
+            }
+        }
+    }
+}
+
+//
+// kexTextureBuilder::Build
+//
+// Bakes the image and its whole mip chain into a buffer from hb_static.
+// Compression uses BC1 for images without alpha and BC3 for the rest.
+// Returns the size of the buffer, or zero if there was nothing to bake
+//
+
+int kexTextureBuilder::Build(kexImageManager &image, const bool bCompress, byte **output) {
+    int channels = (image.ColorMode() == TCR_RGBA) ? 4 : 3;
+    texCompressMode_t mode = TCM_NONE;
+    int width = image.Width();
+    int height = image.Height();
+    int numLevels = 0;
+    int format;
+    int levelSize;
+    int size;
+    int w, h;
+    byte *level;
+    byte *mip;
+    byte *rover;
+
+    *output = NULL;
+
+    if(image.Data() == NULL || image.CompressMode() != TCM_NONE) {
+        return 0;
+    }
+
+    if(bCompress) {
+        mode = (channels == 4) ? TCM_BC3 : TCM_BC1;
+        format = (channels == 4) ? KTEX_BC3 : KTEX_BC1;
+    }
+    else {
+        format = (channels == 4) ? KTEX_RGBA8 : KTEX_RGB8;
+    }
+
+    size = sizeof(ktexHeader_t);
+
+    for(w = width, h = height;; w = MAX(w >> 1, 1), h = MAX(h >> 1, 1)) {
+        if(mode != TCM_NONE) {
+            size += 4 + CompressedSize(w, h, mode);
+        }
+        else {
+            size += 4 + w * h * channels;
+        }
+
+        numLevels++;
+
+        if(w == 1 && h == 1) {
+            break;
+        }
+    }
+
+    if(numLevels > IMG_MAX_LEVELS) {
+        return 0;
+    }
+
+    *output = (byte*)Mem_Malloc(size, hb_static);
+    rover = *output;
+
+    memcpy(rover, "KTEX", 4);
+    rover += 4;
+
+    TextureBuild_Write32(&rover, KTEX_VERSION);
+    TextureBuild_Write32(&rover, width);
+    TextureBuild_Write32(&rover, height);
+    TextureBuild_Write32(&rover, image.OriginalWidth());
+    TextureBuild_Write32(&rover, image.OriginalHeight());
+    TextureBuild_Write32(&rover, format);
+    TextureBuild_Write32(&rover, numLevels);
+
+    level = new byte[width * height * channels];
+    memcpy(level, image.Data(), width * height * channels);
+
+    w = width;
+    h = height;
+
+    for(int i = 0; i < numLevels; i++) {
+        if(mode != TCM_NONE) {
+            levelSize = CompressedSize(w, h, mode);
+            TextureBuild_Write32(&rover, levelSize);
+            Compress(level, w, h, channels, mode, rover);
+        }
+        else {
+            levelSize = w * h * channels;
+            TextureBuild_Write32(&rover, levelSize);
+            memcpy(rover, level, levelSize);
+        }
+
+        rover += levelSize;
+
+        if(i == numLevels - 1) {
+            break;
+        }
+
+        mip = new byte[MAX(w >> 1, 1) * MAX(h >> 1, 1) * channels];
+        BuildMip(level, w, h, channels, mip);
+
+        delete[] level;
+        level = mip;
+
+        w = MAX(w >> 1, 1);
+        h = MAX(h >> 1, 1);
+    }
+
+    delete[] level;
+    return size;
+}
+
+//
+// kexTextureBuilder::BuildFile
+//
+// Bakes a tga or bmp into a .ktex of the same name under the base path
+//
+
+bool kexTextureBuilder::BuildFile(const char *file, const bool bCompress) {
+    kexImageManager image;
+    kexBinFile binFile;
+    filepath_t bakedFile;
+    kexStr filePath;
+    byte *buffer;
+    int size;
+
+    if(!kexImageManager::BakedName(file, bakedFile)) {
+        common.Warning(LC_RENDER, "kexTextureBuilder::BuildFile: %s isn't a tga or bmp\n", file);
+        return false;
+    }
+
+    image.LoadFromFile(file, true);
+
+    if(!(size = Build(image, bCompress, &buffer))) {
+        common.Warning(LC_RENDER, "kexTextureBuilder::BuildFile: couldn't load %s\n", file);
+        return false;
+    }
+
+    filePath = kexStr(kva("%s\\%s", cvarBasePath.GetValue(), bakedFile));
+    filePath.NormalizeSlashes();
+
+    if(!binFile.Create(filePath.c_str())) {
+        common.Warning(LC_RENDER, "kexTextureBuilder::BuildFile: couldn't create %s\n", filePath.c_str());
+        Mem_Free(buffer);
+        return false;
+    }
+
+    fwrite(buffer, 1, size, binFile.Handle());
+    binFile.Close();
+    Mem_Free(buffer);
+
+    common.Printf(LC_RENDER, "Baked %s (%ikb)\n", filePath.c_str(), size >> 10);
+    return true;
+}
+
+//
+// kexTextureBuilder::PSNR
+//
+// Peak signal to noise ratio in dB over the first channels of each
+// pixel. Identical images come out at 99
+//
+
+float kexTextureBuilder::PSNR(const byte *a, const byte *b, const int numPixels,
+                              const int stride, const int channels) {
+    double sum = 0;
+    double mse;
+    int d;
+
+    for(int i = 0; i < numPixels; i++) {
+        for(int c = 0; c < channels; c++) {
+            d = a[i * stride + c] - b[i * stride + c];
+            sum += d * d;
+        }
+    }
+
+    if(sum == 0) {
+        return 99.0f;
+    }
+
+    mse = sum / (numPixels * channels);
+    return (float)(10.0 * log10(255.0 * 255.0 / mse));
+}
+
+//
+// buildtexture
+//
+
+COMMAND(buildtexture) {
+    if(command.GetArgc() < 2) {
+        common.Printf(LC_RENDER, "buildtexture <file> <compress>\n");
+        return;
+    }
+
+    kexTextureBuilder::BuildFile(command.GetArgv(1),
+        command.GetArgc() >= 3 && atoi(command.GetArgv(2)) != 0);
+}
+
+//
+// TextureBuild_TestLinear
+//
+// Test pattern in linear light: a wave, a ramp and stripes near the
+// sampling limit, which is where averaging in sRGB goes most wrong
+//
+
+static float TextureBuild_TestLinear(const float x, const float y, const int channel, const int size) {
+    switch(channel) {
+    case 0:
+        return 0.5f + 0.45f * kexMath::Sin(x * 0.7f) * kexMath::Cos(y * 0.3f);
+    case 1:
+        return 0.05f + 0.9f * (x / (float)size);
+    case 2:
+        return 0.5f + 0.45f * kexMath::Sin((x + y) * 1.9f);
+    default:
+        return 0.5f + 0.45f * kexMath::Cos(y * 0.9f);
+    }
+}
+
+//
+// TextureBuild_TestImage
+//
+// The pattern is stretched by 1/scale, as it would be on a texture
+// painted at a lower resolution than it's stored at
+//
+
+static void TextureBuild_TestImage(byte *rgba, const int size, const float scale) {
+    float f;
+
+    for(int y = 0; y < size; y++) {
+        for(int x = 0; x < size; x++) {
+            for(int c = 0; c < 4; c++) {
+                f = TextureBuild_TestLinear((x + 0.5f) * scale, (y + 0.5f) * scale, c,
+                                            (int)(size * scale));
+
+                if(c == 3) {
+                    rgba[(y * size + x) * 4 + c] = (byte)(f * 255.0f + 0.5f);
+                }
+                else {
+                    rgba[(y * size + x) * 4 + c] = TextureBuild_LinearToSRGB(f);
+                }
+            }
+        }
+    }
+}
+
+//
+// testtexfilter
+//
+// Checks the mip filter against the pattern averaged before it was
+// quantized, and that a black and white checkerboard shrinks to the
+// sRGB value of half intensity rather than to 128
+//
+
+COMMAND(testtexfilter) {
+    const int size = 64;
+    byte *fine = new byte[size * size * 16];
+    byte *mip = new byte[size * size * 4];
+    byte *reference = new byte[size * size * 4];
+    byte checker[8 * 8 * 3];
+    byte checkerMip[4 * 4 * 3];
+    float colorPSNR, alphaPSNR;
+    bool bChecker = true;
+    bool bOk;
+    float f;
+
+    TextureBuild_InitTables();
+    TextureBuild_TestImage(fine, size * 2, 1);
+
+    for(int y = 0; y < size; y++) {
+        for(int x = 0; x < size; x++) {
+            for(int c = 0; c < 4; c++) {
+                f = 0;
+
+                for(int i = 0; i < 4; i++) {
+                    f += TextureBuild_TestLinear(x * 2 + (i & 1) + 0.5f,
+                                                 y * 2 + (i >> 1) + 0.5f, c, size * 2);
+                }
+
+                f *= 0.25f;
+
+                if(c == 3) {
+                    reference[(y * size + x) * 4 + c] = (byte)(f * 255.0f + 0.5f);
+                }
+                else {
+                    reference[(y * size + x) * 4 + c] = TextureBuild_LinearToSRGB(f);
+                }
+            }
+        }
+    }
+
+    kexTextureBuilder::BuildMip(fine, size * 2, size * 2, 4, mip);
+
+    colorPSNR = kexTextureBuilder::PSNR(mip, reference, size * size, 4, 3);
+    alphaPSNR = kexTextureBuilder::PSNR(mip + 3, reference + 3, size * size, 4, 1);
+
+    for(int i = 0; i < 8 * 8; i++) {
+        byte c = (((i & 7) + (i >> 3)) & 1) ? 255 : 0;
+        checker[i * 3 + 0] = checker[i * 3 + 1] = checker[i * 3 + 2] = c;
+    }
+
+    kexTextureBuilder::BuildMip(checker, 8, 8, 3, checkerMip);
+
+    for(int i = 0; i < 4 * 4 * 3; i++) {
+        if(kexMath::Abs(checkerMip[i] - 188) > 1) {
+            bChecker = false;
+        }
+    }
+
+    bOk = (colorPSNR >= 45.0f && alphaPSNR >= 45.0f && bChecker);
+
+    common.Printf(LC_RENDER, "mip psnr: color %.2fdB alpha %.2fdB, checkerboard %i\n",
+        colorPSNR, alphaPSNR, checkerMip[0]);
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testtexfilter %s\n", bOk ? "passed" : "failed");
+
+    delete[] fine;
+    delete[] mip;
+    delete[] reference;
+}
+
+//
+// testbcencode
+//
+// Round trips the test pattern through both block formats and a
+// baked mip chain
+//
+
+COMMAND(testbcencode) {
+    const int size = 64;
+    byte *source = new byte[size * size * 4];
+    byte *blocks = new byte[kexTextureBuilder::CompressedSize(size, size, TCM_BC3)];
+    byte *decoded = new byte[size * size * 4];
+    byte *tga = new byte[18 + size * size * 4];
+    byte *baked;
+    kexImageManager image;
+    kexImageManager bakedImage;
+    float bc1PSNR, bc3PSNR, bc3AlphaPSNR;
+    bool bBaked;
+    bool bOk;
+    int bakedSize;
+
+    TextureBuild_TestImage(source, size, 0.25f);
+
+    kexTextureBuilder::Compress(source, size, size, 4, TCM_BC1, blocks);
+    kexTextureBuilder::Decompress(blocks, size, size, 4, TCM_BC1, decoded);
+    bc1PSNR = kexTextureBuilder::PSNR(source, decoded, size * size, 4, 3);
+
+    kexTextureBuilder::Compress(source, size, size, 4, TCM_BC3, blocks);
+    kexTextureBuilder::Decompress(blocks, size, size, 4, TCM_BC3, decoded);
+    bc3PSNR = kexTextureBuilder::PSNR(source, decoded, size * size, 4, 3);
+    bc3AlphaPSNR = kexTextureBuilder::PSNR(source + 3, decoded + 3, size * size, 4, 1);
+
+    // 32 bit uncompressed tga, stored bgra
+    memset(tga, 0, 18);
+    tga[2] = 2;
+    tga[12] = size;
+    tga[14] = size;
+    tga[16] = 32;
+
+    for(int i = 0; i < size * size; i++) {
+        tga[18 + i * 4 + 0] = source[i * 4 + 2];
+        tga[18 + i * 4 + 1] = source[i * 4 + 1];
+        tga[18 + i * 4 + 2] = source[i * 4 + 0];
+        tga[18 + i * 4 + 3] = source[i * 4 + 3];
+    }
+
+    image.LoadFromMemory("testbcencode.tga", tga, 18 + size * size * 4);
+    bakedSize = kexTextureBuilder::Build(image, true, &baked);
+    bBaked = false;
+
+    if(bakedSize) {
+        bakedImage.LoadFromMemory("testbcencode.ktex", baked, bakedSize);
+        Mem_Free(baked);
+
+        bBaked = (bakedImage.NumLevels() == 7 && bakedImage.Width() == size &&
+                  bakedImage.ColorMode() == TCR_RGBA);
+    }
+
+    bOk = (bc1PSNR >= 28.0f && bc3PSNR >= 28.0f && bc3AlphaPSNR >= 40.0f && bBaked);
+
+    common.Printf(LC_RENDER, "bc1 psnr: %.2fdB, bc3 psnr: color %.2fdB alpha %.2fdB, baked levels %i\n",
+        bc1PSNR, bc3PSNR, bc3AlphaPSNR, bakedImage.NumLevels());
+    common.CPrintf(LC_RENDER, bOk ? COLOR_GREEN : COLOR_RED, "testbcencode %s\n", bOk ? "passed" : "failed");
+
+    delete[] source;
+    delete[] blocks;
+    delete[] decoded;
+    delete[] tga;
+}
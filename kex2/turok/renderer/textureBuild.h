@@ -0,0 +1,73 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __TEXTURE_BUILD_H__
+#define __TEXTURE_BUILD_H__
+
+#include "image.h"
+
+#define KTEX_VERSION    1
+
+//
+// baked texture. the header is followed by numLevels mip levels, each
+// a 32 bit size and then the level. level zero is the power of two
+// padded image that the loader would have made from the source
+//
+typedef struct {
+    char                    id[4];      // KTEX
+    int                     version;
+    int                     width;
+    int                     height;
+    int                     origwidth;
+    int                     origheight;
+    int                     format;
+    int                     numLevels;
+} ktexHeader_t;
+
+typedef enum {
+    KTEX_RGB8   = 0,
+    KTEX_RGBA8,
+    KTEX_BC1,
+    KTEX_BC3
+} ktexFormat_t;
+
+class kexTextureBuilder {
+public:
+    static int              Build(kexImageManager &image, const bool bCompress, byte **output);
+    static bool             BuildFile(const char *file, const bool bCompress);
+    static void             BuildMip(const byte *src, const int width, const int height,
+                                     const int channels, byte *dst);
+    static void             Compress(const byte *src, const int width, const int height,
+                                     const int channels, const texCompressMode_t mode, byte *dst);
+    static void             Decompress(const byte *src, const int width, const int height,
+                                       const int channels, const texCompressMode_t mode, byte *dst);
+    static int              CompressedSize(const int width, const int height,
+                                           const texCompressMode_t mode);
+    static void             EncodeBC1(const byte *rgba, byte *block);
+    static void             EncodeBC3(const byte *rgba, byte *block);
+    static void             DecodeBC1(const byte *block, byte *rgba);
+    static void             DecodeBC3(const byte *block, byte *rgba);
+    static float            PSNR(const byte *a, const byte *b, const int numPixels,
+                                 const int stride, const int channels);
+};
+
+#endif
@@ -34,12 +34,26 @@
 #include "renderBackend.h"
 #include "textureObject.h"
 #include "image.h"
+#include "jobs.h"
 
 kexCvar cvarGLFilter("gl_filter", CVF_INT|CVF_CONFIG, "0", "Texture filter mode");
 kexCvar cvarGLAnisotropic("gl_anisotropic", CVF_INT|CVF_CONFIG, "0", "TODO");
+kexCvar cvarAsyncTextures("r_asynctextures", CVF_BOOL|CVF_CONFIG, "1", "Read and decode textures on the job threads");
+kexCvar cvarTextureUploads("r_textureuploads", CVF_INT|CVF_CONFIG, "8", 1, 256, "Most decoded textures uploaded each frame");
 
 kexHeapBlock kexTexture::hb_texture("texture", false, NULL, NULL);
 
+kexTextureLoader textureLoader;
+
+//
+// Texture_Evict
+//
+
+static void Texture_Evict(void *data) {
+    kexTexture *texture = static_cast<kexTexture*>(data);
+    texture->Delete();
+}
+
 //
 // kexTexture::kexTexture
 //
@@ -52,10 +66,15 @@ kexTexture::kexTexture(void) {
     this->clampMode = TC_CLAMP;
     this->filterMode = TF_LINEAR;
     this->colorMode = TCR_RGBA;
+    this->numLevels = 1;
     this->texid = 0;
     this->bLoaded = false;
     this->bMasked = false;
+    this->bCached = false;
+    this->bPending = false;
     this->next = NULL;
+
+    memset(&this->resident, 0, sizeof(resident_t));
 }
 
 //
@@ -73,6 +92,7 @@ kexTexture::~kexTexture(void) {
 void kexTexture::SetParameters(void) {
     unsigned int clamp;
     unsigned int filter;
+    unsigned int minFilter;
 
     switch(clampMode) {
     case TC_CLAMP:
@@ -91,18 +111,21 @@ void kexTexture::SetParameters(void) {
     switch(filterMode) {
     case TF_LINEAR:
         filter = GL_LINEAR;
+        minFilter = (numLevels > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
         break;
     case TF_NEAREST:
         filter = GL_NEAREST;
+        minFilter = (numLevels > 1) ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
         break;
     default:
         return;
     }
 
+    cpuVertList.Flush();
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, clamp);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, clamp);
     dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
-    dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
 
     if(has_GL_EXT_texture_filter_anisotropic) {
         if(cvarGLAnisotropic.GetInt()) {
@@ -139,6 +162,14 @@ void kexTexture::LoadFromFile(const char *file, const texClampMode_t clamp, cons
     strcpy(filePath, file);
     image.LoadFromFile(file);
     
+    LoadFromImage(image, clamp, filter);
+}
+
+//
+// kexTexture::LoadFromImage
+//
+
+void kexTexture::LoadFromImage(kexImageManager &image, const texClampMode_t clamp, const texFilterMode_t filter) {
     origwidth = image.OriginalWidth();
     origheight = image.OriginalHeight();
     width = image.Width();
@@ -146,6 +177,35 @@ void kexTexture::LoadFromFile(const char *file, const texClampMode_t clamp, cons
     colorMode = image.ColorMode();
     
     Upload(image, clamp, filter);
+
+    if(bCached && bLoaded) {
+        residency.Register(&resident, RT_TEXTURE, this, image.TotalSize(), Texture_Evict);
+    }
+}
+
+//
+// kexTexture::LoadAsync
+//
+// Hands the texture to the loader, which binds the default texture
+// in its place until it's been uploaded. Loads it right away if the
+// job system has no workers to give it to
+//
+
+void kexTexture::LoadAsync(const char *file, const texClampMode_t clamp, const texFilterMode_t filter) {
+    if(bPending) {
+        return;
+    }
+
+    strcpy(filePath, file);
+    clampMode = clamp;
+    filterMode = filter;
+
+    if(!cvarAsyncTextures.GetBool() || jobSystem.IsSerial() || !renderBackend.IsInitialized()) {
+        LoadFromFile(file, clamp, filter);
+        return;
+    }
+
+    textureLoader.Queue(this);
 }
 
 //
@@ -171,23 +231,43 @@ void kexTexture::Upload(kexImageManager &image, texClampMode_t clamp, texFilterM
         return;
     }
 
-    dglBindTexture(GL_TEXTURE_2D, texid);
-
-    dglTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        (colorMode == TCR_RGBA) ? GL_RGBA8 : GL_RGB8,
-        width,
-        height,
-        0,
-        (colorMode == TCR_RGBA) ? GL_RGBA : GL_RGB,
-        GL_UNSIGNED_BYTE,
-        image.Data());
+    renderBackend.BindTexture(texid);
+
+    numLevels = image.NumLevels();
+
+    for(int i = 0; i < numLevels; i++) {
+        int w = MAX(width >> i, 1);
+        int h = MAX(height >> i, 1);
+
+        switch(image.CompressMode()) {
+        case TCM_BC1:
+            dglCompressedTexImage2DARB(GL_TEXTURE_2D, i, GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+                                       w, h, 0, image.LevelSize(i), image.Level(i));
+            break;
+        case TCM_BC3:
+            dglCompressedTexImage2DARB(GL_TEXTURE_2D, i, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+                                       w, h, 0, image.LevelSize(i), image.Level(i));
+            break;
+        default:
+            dglTexImage2D(
+                GL_TEXTURE_2D,
+                i,
+                (colorMode == TCR_RGBA) ? GL_RGBA8 : GL_RGB8,
+                w,
+                h,
+                0,
+                (colorMode == TCR_RGBA) ? GL_RGBA : GL_RGB,
+                GL_UNSIGNED_BYTE,
+                image.Level(i));
+            break;
+        }
+    }
 
+    dglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, numLevels - 1);
     SetParameters();
 
     bLoaded = true;
-    dglBindTexture(GL_TEXTURE_2D, 0);
+    renderBackend.BindTexture(0);
 }
 
 //
@@ -199,8 +279,11 @@ void kexTexture::Bind(void) {
 
     if(bLoaded == false) {
         // we may have attempted to cache this texture before the renderer was
-        // initialized so try reloading it
-        LoadFromFile(filePath, clampMode, filterMode);
+        // initialized so try reloading it. if it's still being decoded then
+        // just wait for the loader to get to it
+        if(!bPending) {
+            LoadFromFile(filePath, clampMode, filterMode);
+        }
 
         if(bLoaded == false || texid == 0) {
             // fall back to default texture
@@ -211,17 +294,11 @@ void kexTexture::Bind(void) {
         }
     }
 
-    int unit = renderBackend.glState.currentUnit;
-    dtexture currentTexture = renderBackend.glState.textureUnits[unit].currentTexture;
-
-    if(tid == currentTexture) {
-        return;
+    if(resident.bResident) {
+        residency.Touch(&resident);
     }
 
-    dglBindTexture(GL_TEXTURE_2D, tid);
-
-    renderBackend.glState.textureUnits[unit].currentTexture = tid;
-    renderBackend.glState.numTextureBinds++;
+    renderBackend.BindTexture(tid);
 }
 
 //
@@ -242,18 +319,13 @@ void kexTexture::BindFrameBuffer(const bool bReadBuffer) {
         }
     }
     
-    int unit = renderBackend.glState.currentUnit;
-    dtexture currentTexture = renderBackend.glState.textureUnits[unit].currentTexture;
-    
-    if(texid != currentTexture) {
-        dglBindTexture(GL_TEXTURE_2D, texid);
-        renderBackend.glState.textureUnits[unit].currentTexture = texid;
-    }
+    renderBackend.BindTexture(texid);
     
     if(bReadBuffer == false) {
         return;
     }
     
+    cpuVertList.Flush();
     dglReadBuffer(GL_BACK);
     
     origwidth   = sysMain.VideoWidth();
@@ -290,18 +362,14 @@ void kexTexture::BindDepthBuffer(const bool bReadDepth) {
         }
     }
     
-    int unit = renderBackend.glState.currentUnit;
-    dtexture currentTexture = renderBackend.glState.textureUnits[unit].currentTexture;
-    
-    if(texid != currentTexture) {
-        dglBindTexture(GL_TEXTURE_2D, texid);
-        renderBackend.glState.textureUnits[unit].currentTexture = texid;
-    }
+    renderBackend.BindTexture(texid);
     
     if(bReadDepth == false) {
         return;
     }
     
+    cpuVertList.Flush();
+    
     origwidth   = sysMain.VideoWidth();
     origheight  = sysMain.VideoHeight();
     width       = origwidth;
@@ -328,7 +396,196 @@ void kexTexture::Delete(void) {
         return;
     }
 
+    renderBackend.ForgetTexture(texid);
     dglDeleteTextures(1, &texid);
     texid = 0;
     bLoaded = false;
 }
+
+//
+// kexTexture::Touch
+//
+// Marks the texture as used by the current map, uploading it
+// again if it was evicted
+//
+
+void kexTexture::Touch(void) {
+    if(!resident.bTracked) {
+        return;
+    }
+
+    if(!resident.bResident) {
+        LoadAsync(filePath, clampMode, filterMode);
+        return;
+    }
+
+    residency.Touch(&resident);
+}
+
+//
+// kexTextureLoader::kexTextureLoader
+//
+
+kexTextureLoader::kexTextureLoader(void) {
+    this->head = 0;
+    this->tail = 0;
+
+    memset(this->loads, 0, sizeof(this->loads));
+    SDL_AtomicSet(&this->counter.pending, 0);
+}
+
+//
+// kexTextureLoader::DecodeJob
+//
+// Runs on a job thread. Reads the same files the main thread would,
+// loose ones included in developer mode. Anything the worker can't
+// find or doesn't know the format of comes back without data and is
+// loaded on the main thread instead
+//
+
+void kexTextureLoader::DecodeJob(void *data, const int start, const int end, const int thread) {
+    texLoad_t *load = static_cast<texLoad_t*>(data);
+    filepath_t bakedFile;
+    byte *fileData = NULL;
+    int size;
+
+    if(!kexImageManager::BakedName(load->file, bakedFile)) {
+        SDL_AtomicSet(&load->bDone, 1);
+        return;
+    }
+
+    if((size = fileSystem.ReadFile(bakedFile, &fileData, kexTexture::hb_texture)) > 0) {
+        load->image->LoadFromMemory(bakedFile, fileData, size);
+    }
+
+    if(fileData) {
+        Mem_Free(fileData);
+        fileData = NULL;
+    }
+
+    if(load->image->Data() == NULL) {
+        if((size = fileSystem.ReadFile(load->file, &fileData, kexTexture::hb_texture)) > 0) {
+            load->image->LoadFromMemory(load->file, fileData, size);
+        }
+
+        if(fileData) {
+            Mem_Free(fileData);
+        }
+    }
+
+    // publishes the image to the main thread
+    SDL_AtomicSet(&load->bDone, 1);
+}
+
+//
+// kexTextureLoader::Queue
+//
+
+void kexTextureLoader::Queue(kexTexture *texture) {
+    texLoad_t *load;
+
+    if(head - tail >= TEXLOAD_MAX_PENDING) {
+        // make room
+        UploadNext(true);
+    }
+
+    load = &loads[head & (TEXLOAD_MAX_PENDING-1)];
+    load->texture = texture;
+    load->image = new kexImageManager;
+    strcpy(load->file, texture->filePath);
+    SDL_AtomicSet(&load->bDone, 0);
+
+    head++;
+    texture->SetPending(true);
+
+    jobSystem.Submit(DecodeJob, load, &counter);
+}
+
+//
+// kexTextureLoader::UploadNext
+//
+// Uploads the oldest queued texture. Returns false if there's nothing
+// queued, or it's still being decoded and bWait isn't set
+//
+
+bool kexTextureLoader::UploadNext(const bool bWait) {
+    texLoad_t *load;
+    kexTexture *texture;
+
+    if(head == tail) {
+        return false;
+    }
+
+    load = &loads[tail & (TEXLOAD_MAX_PENDING-1)];
+
+    if(!SDL_AtomicGet(&load->bDone)) {
+        if(!bWait) {
+            return false;
+        }
+
+        // the job may still be sitting in a queue, so help out
+        // rather than spin
+        jobSystem.Wait(&counter);
+    }
+
+    texture = load->texture;
+    texture->SetPending(false);
+
+    if(load->image->Data()) {
+        texture->LoadFromImage(*load->image, texture->GetClampMode(), texture->GetFilterMode());
+    }
+    else {
+        texture->LoadFromFile(load->file, texture->GetClampMode(), texture->GetFilterMode());
+    }
+
+    delete load->image;
+    load->image = NULL;
+    load->texture = NULL;
+
+    tail++;
+    return true;
+}
+
+//
+// kexTextureLoader::Pump
+//
+// Called once a frame
+//
+
+void kexTextureLoader::Pump(void) {
+    for(int i = 0; i < cvarTextureUploads.GetInt(); i++) {
+        if(!UploadNext(false)) {
+            break;
+        }
+    }
+}
+
+//
+// kexTextureLoader::Finish
+//
+// Waits for and uploads everything that's queued
+//
+
+void kexTextureLoader::Finish(void) {
+    while(UploadNext(true));
+}
+
+//
+// kexTextureLoader::Shutdown
+//
+// Drops whatever is queued without uploading it
+//
+
+void kexTextureLoader::Shutdown(void) {
+    jobSystem.Wait(&counter);
+
+    for(; tail != head; tail++) {
+        texLoad_t *load = &loads[tail & (TEXLOAD_MAX_PENDING-1)];
+
+        load->texture->SetPending(false);
+        delete load->image;
+
+        load->image = NULL;
+        load->texture = NULL;
+    }
+}
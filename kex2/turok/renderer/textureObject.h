@@ -24,6 +24,8 @@
 #define __TEXTURE_OBJ_H__
 
 #include "image.h"
+#include "residency.h"
+#include "jobs.h"
 
 typedef struct {
     int x;
@@ -52,10 +54,13 @@ public:
     void                    SetParameters(void);
     void                    ChangeParameters(const texClampMode_t clamp, const texFilterMode_t filter);
     void                    LoadFromFile(const char *file, const texClampMode_t clamp, const texFilterMode_t filter);
+    void                    LoadFromImage(kexImageManager &image, const texClampMode_t clamp, const texFilterMode_t filter);
+    void                    LoadAsync(const char *file, const texClampMode_t clamp, const texFilterMode_t filter);
     void                    Bind(void);
     void                    BindFrameBuffer(const bool bReadBuffer = true);
     void                    BindDepthBuffer(const bool bReadDepth = true);
     void                    Delete(void);
+    void                    Touch(void);
 
     const int               Width(void) const { return width; }
     const int               Height(void) const { return height; }
@@ -69,6 +74,9 @@ public:
     void                    SetFilterMode(texFilterMode_t fm) { filterMode = fm; }
     bool                    GetMasked(void) { return bMasked; }
     void                    SetMasked(bool b) { bMasked = b; }
+    void                    SetCached(bool b) { bCached = b; }
+    bool                    IsPending(void) const { return bPending; }
+    void                    SetPending(bool b) { bPending = b; }
 
     filepath_t              filePath;
     kexTexture              *next;
@@ -83,9 +91,52 @@ private:
     texClampMode_t          clampMode;
     texFilterMode_t         filterMode;
     texColorMode_t          colorMode;
+    int                     numLevels;
     dtexture                texid;
     bool                    bLoaded;
     bool                    bMasked;
+    bool                    bCached;
+    bool                    bPending;
+    resident_t              resident;
 };
 
+#define TEXLOAD_MAX_PENDING 256     // must be a power of two
+
+//
+// kexTextureLoader - reads and decodes textures on the job threads.
+// finished images are uploaded on the main thread, in the order they
+// were queued, a few each frame
+//
+
+class kexTextureLoader {
+public:
+                            kexTextureLoader(void);
+
+    void                    Queue(kexTexture *texture);
+    void                    Pump(void);
+    void                    Finish(void);
+    void                    Shutdown(void);
+
+    const int               NumPending(void) const { return head - tail; }
+
+private:
+    typedef struct {
+        kexTexture          *texture;
+        kexImageManager     *image;
+        filepath_t          file;
+        SDL_atomic_t        bDone;
+    } texLoad_t;
+
+    static void             DecodeJob(void *data, const int start, const int end, const int thread);
+
+    bool                    UploadNext(const bool bWait);
+
+    texLoad_t               loads[TEXLOAD_MAX_PENDING];
+    unsigned int            head;
+    unsigned int            tail;
+    jobCounter_t            counter;
+};
+
+extern kexTextureLoader textureLoader;
+
 #endif
@@ -0,0 +1,962 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Software sound mixer and its output sinks
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "sound.h"
+
+#define MIX_SQRT2       1.41421356f
+
+//
+// Mixer_Sample
+//
+// Reads a sample as 16 bit
+//
+
+static d_inline int Mixer_Sample(const byte *data, const int bits, const int index) {
+    if(bits == 8) {
+        return ((int)data[index] - 128) << 8;
+    }
+
+    return ((const short*)data)[index];
+}
+
+//
+// kexSoundMixer::kexSoundMixer
+//
+
+kexSoundMixer::kexSoundMixer(void) {
+    sink        = NULL;
+    rate        = 44100;
+    baseTime    = 0;
+    numMixed    = 0;
+    bStarted    = false;
+
+    memset(channels, 0, sizeof(channels));
+    listenOrigin.Clear();
+    listenRight.Set(1, 0, 0);
+}
+
+//
+// kexSoundMixer::SetOutput
+//
+
+void kexSoundMixer::SetOutput(kexSoundSink *outSink, const int outRate) {
+    sink = outSink;
+    rate = outRate;
+}
+
+//
+// kexSoundMixer::Init
+//
+
+bool kexSoundMixer::Init(void) {
+    if(sink == NULL || rate <= 0 || !sink->Open(rate)) {
+        return false;
+    }
+
+    memset(channels, 0, sizeof(channels));
+
+    baseTime = 0;
+    numMixed = 0;
+    bStarted = false;
+    return true;
+}
+
+//
+// kexSoundMixer::Shutdown
+//
+
+void kexSoundMixer::Shutdown(void) {
+    for(int i = 0; i < SND_MAX_SOURCES; i++) {
+        channels[i].bActive = false;
+    }
+
+    if(sink) {
+        sink->Close();
+    }
+}
+
+//
+// kexSoundMixer::GetDeviceName
+//
+
+const char *kexSoundMixer::GetDeviceName(void) {
+    return sink ? sink->GetName() : "none";
+}
+
+//
+// kexSoundMixer::SetListener
+//
+
+void kexSoundMixer::SetListener(const kexVec3 &origin, const kexVec3 &forward, const kexVec3 &up) {
+    listenOrigin = origin;
+    listenRight = forward.Cross(up);
+
+    if(listenRight.UnitSq() <= 0.0001f) {
+        listenRight.Set(1, 0, 0);
+        return;
+    }
+
+    listenRight.Normalize();
+}
+
+//
+// kexSoundMixer::Spatialize
+//
+// Works out the step through the wave and the gain for each
+// speaker. Mono sounds are attenuated the way OpenAL would and
+// panned by how far they are to the listener's side. Stereo
+// sounds play as they are
+//
+
+void kexSoundMixer::Spatialize(mixChannel_t *chan, const sndParams_t &params) {
+    float gain = params.gain;
+    float pitch = params.pitch > 0.01f ? params.pitch : 0.01f;
+
+    chan->step = (unsigned int)((float)params.wave->Rate() * pitch / (float)rate * 65536.0f);
+
+    if(chan->step == 0) {
+        chan->step = 1;
+    }
+
+    if(!params.bLocal && params.wave->Channels() == 1) {
+        kexVec3 dir = params.origin - listenOrigin;
+        float dist = dir.Unit();
+
+        gain *= kexSoundSystem::Attenuation(dist * SND_METRICS, params.rolloffFactor);
+
+        if(dist > 0.0001f) {
+            // equal power, scaled so a sound straight ahead plays at full gain
+            float angle = (listenRight.Dot(dir) / dist + 1) * (M_PI / 4);
+            float left = MIX_SQRT2 * kexMath::Cos(angle);
+            float right = MIX_SQRT2 * kexMath::Sin(angle);
+
+            chan->left = gain * (left > 1 ? 1 : left);
+            chan->right = gain * (right > 1 ? 1 : right);
+            return;
+        }
+    }
+
+    chan->left = gain;
+    chan->right = gain;
+}
+
+//
+// kexSoundMixer::StartChannel
+//
+
+bool kexSoundMixer::StartChannel(const int channel, const sndParams_t &params, const float offset) {
+    mixChannel_t *chan = &channels[channel];
+
+    chan->wave = params.wave;
+    chan->stream = params.stream;
+    chan->frac = 0;
+
+    Spatialize(chan, params);
+
+    if(chan->stream) {
+        // the stream was opened where it should start
+        chan->window = NULL;
+        chan->windowFrames = 0;
+        chan->pos = 0;
+        chan->bActive = true;
+        return true;
+    }
+
+    if(params.wave->Data() == NULL) {
+        return false;
+    }
+
+    chan->window = params.wave->Data();
+    chan->windowFrames = params.wave->NumFrames();
+    chan->pos = offset > 0 ? (unsigned int)(offset * (float)params.wave->Rate()) : 0;
+
+    chan->bActive = (chan->pos < chan->windowFrames);
+    return chan->bActive;
+}
+
+//
+// kexSoundMixer::StopChannel
+//
+
+void kexSoundMixer::StopChannel(const int channel) {
+    channels[channel].bActive = false;
+    channels[channel].stream = NULL;
+    channels[channel].window = NULL;
+}
+
+//
+// kexSoundMixer::UpdateChannel
+//
+
+bool kexSoundMixer::UpdateChannel(const int channel, const sndParams_t &params) {
+    mixChannel_t *chan = &channels[channel];
+
+    if(!chan->bActive) {
+        return false;
+    }
+
+    Spatialize(chan, params);
+    return true;
+}
+
+//
+// kexSoundMixer::Update
+//
+// Mixes however many frames the sound time has moved on by
+//
+
+void kexSoundMixer::Update(const int time) {
+    int target;
+
+    if(!bStarted || time < baseTime) {
+        baseTime = time;
+        numMixed = 0;
+        bStarted = true;
+        return;
+    }
+
+    target = (int)(((int64_t)(time - baseTime) * rate) / 1000);
+
+    if(numMixed < target) {
+        Mix(target - numMixed);
+        numMixed = target;
+    }
+
+    // keep the counts from running away during long sessions
+    if(numMixed >= rate * 60) {
+        baseTime += 60000;
+        numMixed -= rate * 60;
+    }
+}
+
+//
+// kexSoundMixer::NextWindow
+//
+// Moves a streamed channel on to its next chunk. False if
+// the stream hasn't caught up or has run out
+//
+
+bool kexSoundMixer::NextWindow(mixChannel_t *chan) {
+    int size;
+
+    if(!(chan->window = chan->stream->Chunk(&size))) {
+        return false;
+    }
+
+    chan->windowFrames = size / chan->wave->BlockAlign();
+    return true;
+}
+
+//
+// kexSoundMixer::MixWindow
+//
+// Linear interpolated resampling into the mix buffer until either
+// the frames are done or the window runs out. Gains are 8 bit
+// fixed point so a wave at its own rate and full gain comes out
+// untouched. Returns the number of frames mixed
+//
+
+int kexSoundMixer::MixWindow(mixChannel_t *chan, int *out, const int frames) {
+    const byte *data = chan->window;
+    const unsigned int numFrames = chan->windowFrames;
+    const int numChannels = chan->wave->Channels();
+    const int bits = chan->wave->Bits();
+    int left = (int)(chan->left * 256.0f);
+    int right = (int)(chan->right * 256.0f);
+    int i;
+
+    for(i = 0; i < frames && chan->pos < numFrames; i++, out += 2) {
+        int index = chan->pos * numChannels;
+        int next = (chan->pos + 1 < numFrames) ? index + numChannels : index;
+        int f = (int)(chan->frac >> 1);
+        int s0, s1;
+
+        s0 = Mixer_Sample(data, bits, index);
+        s1 = Mixer_Sample(data, bits, next);
+        s0 += ((s1 - s0) * f) >> 15;
+
+        if(numChannels == 2) {
+            out[0] += (s0 * left) >> 8;
+
+            s0 = Mixer_Sample(data, bits, index + 1);
+            s1 = Mixer_Sample(data, bits, next + 1);
+            s0 += ((s1 - s0) * f) >> 15;
+
+            out[1] += (s0 * right) >> 8;
+        }
+        else {
+            out[0] += (s0 * left) >> 8;
+            out[1] += (s0 * right) >> 8;
+        }
+
+        chan->frac += chan->step;
+        chan->pos += chan->frac >> 16;
+        chan->frac &= 0xffff;
+    }
+
+    return i;
+}
+
+//
+// kexSoundMixer::MixChannel
+//
+
+void kexSoundMixer::MixChannel(mixChannel_t *chan, const int frames) {
+    int *out = mixBuffer;
+    int count = frames;
+
+    while(count > 0) {
+        int mixed;
+
+        if(chan->window == NULL && (chan->stream == NULL || !NextWindow(chan))) {
+            // an underrun just leaves a gap
+            if(chan->stream == NULL || chan->stream->Finished()) {
+                chan->bActive = false;
+            }
+
+            return;
+        }
+
+        mixed = MixWindow(chan, out, count);
+        out += mixed * 2;
+        count -= mixed;
+
+        if(chan->pos < chan->windowFrames) {
+            continue;
+        }
+
+        if(chan->stream == NULL) {
+            chan->bActive = false;
+            return;
+        }
+
+        // carry whatever was stepped over into the next chunk
+        chan->pos -= chan->windowFrames;
+        chan->window = NULL;
+        chan->stream->Release();
+    }
+}
+
+//
+// kexSoundMixer::Mix
+//
+// Mixes and sends out the given number of frames, a
+// buffer's worth at a time
+//
+
+void kexSoundMixer::Mix(const int frames) {
+    for(int done = 0; done < frames; done += SND_MIX_FRAMES) {
+        int count = frames - done;
+
+        if(count > SND_MIX_FRAMES) {
+            count = SND_MIX_FRAMES;
+        }
+
+        memset(mixBuffer, 0, sizeof(int) * count * 2);
+
+        for(int i = 0; i < SND_MAX_SOURCES; i++) {
+            if(channels[i].bActive) {
+                MixChannel(&channels[i], count);
+            }
+        }
+
+        for(int i = 0; i < count * 2; i++) {
+            int s = mixBuffer[i];
+
+            if(s > 32767) {
+                s = 32767;
+            }
+            else if(s < -32768) {
+                s = -32768;
+            }
+
+            outBuffer[i] = (short)s;
+        }
+
+        sink->Write(outBuffer, count);
+    }
+}
+
+//
+// WavSink_WriteTag
+//
+
+static void WavSink_WriteTag(kexBinFile &file, const char *tag) {
+    for(int i = 0; i < 4; i++) {
+        file.Write8(tag[i]);
+    }
+}
+
+//
+// kexWavSoundSink::kexWavSoundSink
+//
+
+kexWavSoundSink::kexWavSoundSink(void) {
+    strcpy(filePath, "sound.wav");
+    numFrames = 0;
+}
+
+//
+// kexWavSoundSink::SetFile
+//
+
+void kexWavSoundSink::SetFile(const char *name) {
+    strncpy(filePath, name, MAX_FILEPATH-1);
+    filePath[MAX_FILEPATH-1] = 0;
+}
+
+//
+// kexWavSoundSink::Open
+//
+// Sizes are left at zero until the file is closed
+//
+
+bool kexWavSoundSink::Open(const int rate) {
+    if(!file.Create(filePath)) {
+        common.Warning(LC_SOUND, "kexWavSoundSink::Open: couldn't create %s\n", filePath);
+        return false;
+    }
+
+    numFrames = 0;
+
+    WavSink_WriteTag(file, "RIFF");
+    file.Write32(36);
+    WavSink_WriteTag(file, "WAVE");
+    WavSink_WriteTag(file, "fmt ");
+    file.Write32(16);
+    file.Write16(1);            // pcm
+    file.Write16(2);
+    file.Write32(rate);
+    file.Write32(rate * 4);
+    file.Write16(4);
+    file.Write16(16);
+    WavSink_WriteTag(file, "data");
+    file.Write32(0);
+    return true;
+}
+
+//
+// kexWavSoundSink::Write
+//
+
+void kexWavSoundSink::Write(const short *samples, const int frames) {
+    if(!file.IsOpened()) {
+        return;
+    }
+
+    for(int i = 0; i < frames * 2; i++) {
+        file.Write16(samples[i]);
+    }
+
+    numFrames += frames;
+}
+
+//
+// kexWavSoundSink::Close
+//
+
+void kexWavSoundSink::Close(void) {
+    if(!file.IsOpened()) {
+        return;
+    }
+
+    fseek(file.Handle(), 4, SEEK_SET);
+    file.Write32(36 + numFrames * 4);
+    fseek(file.Handle(), 40, SEEK_SET);
+    file.Write32(numFrames * 4);
+
+    file.Close();
+}
+
+//-----------------------------------------------------------------------------
+//
+// tests
+//
+//-----------------------------------------------------------------------------
+
+#define MIXTEST_FRAMES  4096
+
+//
+// kexMemorySoundSink - keeps what's mixed so the tests can look at it
+//
+
+class kexMemorySoundSink : public kexSoundSink {
+public:
+    bool                                Open(const int rate) { numFrames = 0; return true; }
+    void                                Close(void) {}
+    const char                          *GetName(void) { return "memory"; }
+
+    void                                Write(const short *samples, const int frames) {
+        for(int i = 0; i < frames * 2 && numFrames * 2 + i < MIXTEST_FRAMES * 2; i++) {
+            buffer[numFrames * 2 + i] = samples[i];
+        }
+
+        numFrames += frames;
+    }
+
+    short                               buffer[MIXTEST_FRAMES * 2];
+    int                                 numFrames;
+};
+
+//
+// MixTest_BuildWave
+//
+// Writes a RIFF file holding frames of a ramp. The second
+// channel of a stereo wave is the first flipped
+//
+
+static byte *MixTest_BuildWave(const int numChannels, const int bits, const int rate, const int frames) {
+    int size = frames * numChannels * (bits / 8);
+    byte *data = (byte*)Mem_Calloc(44 + size, hb_static);
+    byte *pcm = data + 44;
+
+    memcpy(data, "RIFF", 4);
+    *(int*)(data + 4) = 36 + size;
+    memcpy(data + 8, "WAVE", 4);
+    memcpy(data + 12, "fmt ", 4);
+    *(int*)(data + 16) = 16;
+    *(short*)(data + 20) = 1;
+    *(short*)(data + 22) = numChannels;
+    *(int*)(data + 24) = rate;
+    *(int*)(data + 28) = rate * numChannels * (bits / 8);
+    *(short*)(data + 32) = numChannels * (bits / 8);
+    *(short*)(data + 34) = bits;
+    memcpy(data + 36, "data", 4);
+    *(int*)(data + 40) = size;
+
+    for(int i = 0; i < frames; i++) {
+        int s = ((i * 37) % 512 - 256) * 100;
+
+        for(int c = 0; c < numChannels; c++) {
+            int v = c ? -s : s;
+
+            if(bits == 8) {
+                pcm[i * numChannels + c] = (byte)((v >> 8) + 128);
+            }
+            else {
+                ((short*)pcm)[i * numChannels + c] = (short)v;
+            }
+        }
+    }
+
+    return data;
+}
+
+//
+// MixTest_Params
+//
+
+static void MixTest_Params(sndParams_t *params, kexWavFile *wave, const float gain, const float pitch) {
+    params->wave = wave;
+    params->origin.Clear();
+    params->bLocal = true;
+    params->gain = gain;
+    params->pitch = pitch;
+    params->rolloffFactor = 8;
+    params->stream = NULL;
+}
+
+//
+// MixTest_Energy
+//
+
+static double MixTest_Energy(const kexMemorySoundSink *sink, const int c) {
+    double energy = 0;
+
+    for(int i = 0; i < sink->numFrames && i < MIXTEST_FRAMES; i++) {
+        double s = (double)sink->buffer[i * 2 + c];
+        energy += s * s;
+    }
+
+    return energy;
+}
+
+//
+// testsoundmix
+//
+// Runs the software mixer against waves built in memory
+//
+
+COMMAND(testsoundmix) {
+    kexSoundMixer *mixer = new kexSoundMixer;
+    kexMemorySoundSink *sink = new kexMemorySoundSink;
+    kexWavFile mono16;
+    kexWavFile mono8;
+    kexWavFile stereo16;
+    kexWavFile slow;
+    byte *mono16Data = MixTest_BuildWave(1, 16, 22050, 1000);
+    byte *mono8Data = MixTest_BuildWave(1, 8, 22050, 1000);
+    byte *stereoData = MixTest_BuildWave(2, 16, 22050, 1000);
+    byte *slowData = MixTest_BuildWave(1, 16, 11025, 1000);
+    const short *in;
+    sndParams_t params;
+    kexVec3 forward(0, 0, -1);
+    kexVec3 up(0, 1, 0);
+    double left, right;
+    double center = 0;
+    bool bOk = true;
+
+    mono16.Parse("mono16", mono16Data, 44 + 2000);
+    mono8.Parse("mono8", mono8Data, 44 + 1000);
+    stereo16.Parse("stereo16", stereoData, 44 + 4000);
+    slow.Parse("slow", slowData, 44 + 2000);
+
+    in = (const short*)mono16.Data();
+
+    mixer->SetOutput(sink, 22050);
+    mixer->Init();
+    mixer->SetListener(kexVec3(0, 0, 0), forward, up);
+
+    // nothing playing is silence
+    mixer->Mix(256);
+
+    for(int i = 0; i < 512; i++) {
+        if(sink->buffer[i] != 0) {
+            bOk = false;
+        }
+    }
+
+    // a local wave at the mixer's rate comes through untouched
+    // in both speakers and ends with the wave
+    sink->Open(0);
+    MixTest_Params(&params, &mono16, 1, 1);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(999);
+
+    for(int i = 0; i < 999; i++) {
+        if(sink->buffer[i * 2 + 0] != in[i] || sink->buffer[i * 2 + 1] != in[i]) {
+            bOk = false;
+        }
+    }
+
+    if(!mixer->UpdateChannel(0, params)) {
+        bOk = false;
+    }
+
+    mixer->Mix(1);
+
+    if(mixer->UpdateChannel(0, params)) {
+        bOk = false;
+    }
+
+    // half gain
+    sink->Open(0);
+    MixTest_Params(&params, &mono16, 0.5f, 1);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(500);
+
+    for(int i = 0; i < 500; i++) {
+        if(kexMath::Abs(sink->buffer[i * 2] - in[i] / 2) > 1) {
+            bOk = false;
+        }
+    }
+
+    mixer->StopChannel(0);
+
+    // double pitch plays out in half the frames
+    MixTest_Params(&params, &mono16, 1, 2);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(499);
+
+    if(!mixer->UpdateChannel(0, params)) {
+        bOk = false;
+    }
+
+    mixer->Mix(1);
+
+    if(mixer->UpdateChannel(0, params)) {
+        bOk = false;
+    }
+
+    // half rate waves are stretched, in between frames are interpolated
+    sink->Open(0);
+    MixTest_Params(&params, &slow, 1, 1);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(1999);
+
+    in = (const short*)slow.Data();
+
+    for(int i = 0; i < 999; i++) {
+        if(sink->buffer[i * 4] != in[i] ||
+            kexMath::Abs(sink->buffer[i * 4 + 2] - (in[i] + in[i + 1]) / 2) > 1) {
+            bOk = false;
+        }
+    }
+
+    if(!mixer->UpdateChannel(0, params)) {
+        bOk = false;
+    }
+
+    mixer->StopChannel(0);
+
+    // 8 bit waves are widened to 16
+    sink->Open(0);
+    MixTest_Params(&params, &mono8, 1, 1);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(1000);
+
+    for(int i = 0; i < 1000; i++) {
+        if(sink->buffer[i * 2] != (((int)mono8.Data()[i] - 128) << 8)) {
+            bOk = false;
+        }
+    }
+
+    // stereo waves keep their channels apart
+    sink->Open(0);
+    MixTest_Params(&params, &stereo16, 1, 1);
+    params.bLocal = false;
+    params.origin.Set(1000, 0, 0);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(1000);
+
+    in = (const short*)stereo16.Data();
+
+    for(int i = 0; i < 1000; i++) {
+        if(sink->buffer[i * 2] != in[i * 2] || sink->buffer[i * 2 + 1] != in[i * 2 + 1]) {
+            bOk = false;
+        }
+    }
+
+    // mono sounds pan to the side they're on
+    for(int side = -1; side <= 1; side++) {
+        sink->Open(0);
+        MixTest_Params(&params, &mono16, 1, 1);
+        params.bLocal = false;
+        params.origin.Set(side * 200.0f, 0, side ? 0 : -200.0f);
+        mixer->StartChannel(0, params, 0);
+        mixer->Mix(1000);
+
+        left = MixTest_Energy(sink, 0);
+        right = MixTest_Energy(sink, 1);
+
+        if((side == -1 && left <= right * 4) ||
+            (side == 1 && right <= left * 4) ||
+            (side == 0 && kexMath::Fabs((float)(left - right)) > left * 0.01)) {
+            bOk = false;
+        }
+
+        if(side == 0) {
+            center = left;
+        }
+    }
+
+    // and drop off with distance
+    sink->Open(0);
+    params.origin.Set(0, 0, -2000);
+    mixer->StartChannel(0, params, 0);
+    mixer->Mix(1000);
+
+    if(MixTest_Energy(sink, 0) >= center * 0.5) {
+        bOk = false;
+    }
+
+    // loud sounds clip instead of wrapping
+    sink->Open(0);
+    MixTest_Params(&params, &mono16, 4, 1);
+    mixer->StartChannel(0, params, 0);
+    mixer->StartChannel(1, params, 0);
+    mixer->Mix(1000);
+
+    in = (const short*)mono16.Data();
+
+    for(int i = 0; i < 1000; i++) {
+        int s = sink->buffer[i * 2];
+
+        if((in[i] > 4096 && s != 32767) || (in[i] < -4096 && s != -32768)) {
+            bOk = false;
+        }
+    }
+
+    // the sound clock drives how much gets mixed
+    sink->Open(0);
+    mixer->StopChannel(0);
+    mixer->StopChannel(1);
+    mixer->Update(1000);
+    mixer->Update(1500);
+
+    if(sink->numFrames != 11025) {
+        bOk = false;
+    }
+
+    mixer->Shutdown();
+
+    Mem_Free(mono16Data);
+    Mem_Free(mono8Data);
+    Mem_Free(stereoData);
+    Mem_Free(slowData);
+
+    delete mixer;
+    delete sink;
+
+    common.CPrintf(LC_SOUND, bOk ? COLOR_GREEN : COLOR_RED, "testsoundmix %s\n",
+        bOk ? "passed" : "failed");
+}
+
+//
+// mixsounds
+//
+// Plays a scripted run of sound shaders through the software
+// mixer into a wave file, without touching the real output:
+// mixsounds <file.wav> <length ms> [<start ms> <shader>]...
+//
+
+COMMAND(mixsounds) {
+    kexSoundMixer *mixer;
+    kexWavSoundSink *sink;
+    kexSoundBackend *prevBackend;
+    kexVec3 origin(0, 0, 0);
+    kexVec3 forward(0, 0, -1);
+    kexVec3 up(0, 1, 0);
+    int prevTime;
+    int length;
+    int numEvents;
+    int next;
+
+    if(command.GetArgc() < 3 || (command.GetArgc() & 1) == 0) {
+        common.Printf(LC_SOUND, "mixsounds <file.wav> <length ms> [<start ms> <shader>]...\n");
+        return;
+    }
+
+    length = atoi(command.GetArgv(2));
+    numEvents = (command.GetArgc() - 3) / 2;
+
+    sink = new kexWavSoundSink;
+    sink->SetFile(command.GetArgv(1));
+
+    mixer = new kexSoundMixer;
+    mixer->SetOutput(sink, 44100);
+
+    if(!mixer->Init()) {
+        delete mixer;
+        delete sink;
+        return;
+    }
+
+    prevTime = kexSoundSystem::time;
+    prevBackend = soundSystem.SetBackend(mixer);
+    next = 0;
+
+    kexSoundSystem::time = 0;
+
+    // steps like the game would at 60hz, the clock the shaders are written for
+    for(int frame = 0; kexSoundSystem::time <= length; frame++) {
+        while(next < numEvents && atoi(command.GetArgv(3 + next * 2)) <= kexSoundSystem::time) {
+            soundSystem.StartSound(command.GetArgv(4 + next * 2), NULL);
+            next++;
+        }
+
+        soundSystem.Update(origin, forward, up);
+        kexSoundSystem::time = (frame + 1) * 1000 / 60;
+    }
+
+    soundSystem.SetBackend(prevBackend);
+    kexSoundSystem::time = prevTime;
+
+    mixer->Shutdown();
+
+    common.Printf(LC_SOUND, "mixed %i sound(s) into %s\n", next, command.GetArgv(1));
+
+    delete mixer;
+    delete sink;
+}
+
+//
+// comparesoundwav
+//
+// Diffs two mixed waves sample by sample, e.g. mixsounds output
+// from before and after a mixer change
+//
+
+COMMAND(comparesoundwav) {
+    kexWavFile waveA;
+    kexWavFile waveB;
+    byte *dataA;
+    byte *dataB;
+    int sizeA;
+    int sizeB;
+    const short *a;
+    const short *b;
+    int tolerance = 0;
+    int maxDiff = 0;
+    int worst = 0;
+    int count;
+    bool bOk;
+
+    if(command.GetArgc() < 3) {
+        common.Printf(LC_SOUND, "comparesoundwav <a.wav> <b.wav> (tolerance)\n");
+        return;
+    }
+
+    if(command.GetArgc() >= 4) {
+        tolerance = atoi(command.GetArgv(3));
+    }
+
+    if((sizeA = fileSystem.OpenFile(command.GetArgv(1), &dataA, hb_static)) <= 0) {
+        common.Warning(LC_SOUND, "comparesoundwav: couldn't open %s\n", command.GetArgv(1));
+        return;
+    }
+
+    if((sizeB = fileSystem.OpenFile(command.GetArgv(2), &dataB, hb_static)) <= 0) {
+        common.Warning(LC_SOUND, "comparesoundwav: couldn't open %s\n", command.GetArgv(2));
+        Mem_Free(dataA);
+        return;
+    }
+
+    bOk = (waveA.Parse(command.GetArgv(1), dataA, sizeA) &&
+           waveB.Parse(command.GetArgv(2), dataB, sizeB) &&
+           waveA.Rate() == waveB.Rate() &&
+           waveA.Channels() == waveB.Channels() &&
+           waveA.Bits() == 16 && waveB.Bits() == 16 &&
+           waveA.NumFrames() == waveB.NumFrames());
+
+    if(bOk) {
+        a = (const short*)waveA.Data();
+        b = (const short*)waveB.Data();
+        count = waveA.NumFrames() * waveA.Channels();
+
+        for(int i = 0; i < count; i++) {
+            int diff = kexMath::Abs(a[i] - b[i]);
+
+            if(diff > maxDiff) {
+                maxDiff = diff;
+                worst = i / waveA.Channels();
+            }
+        }
+
+        bOk = (maxDiff <= tolerance);
+        common.Printf(LC_SOUND, "largest difference %i at frame %i\n", maxDiff, worst);
+    }
+    else {
+        common.Printf(LC_SOUND, "formats or lengths don't match\n");
+    }
+
+    Mem_Free(dataA);
+    Mem_Free(dataB);
+
+    common.CPrintf(LC_SOUND, bOk ? COLOR_GREEN : COLOR_RED, "comparesoundwav %s\n",
+        bOk ? "passed" : "failed");
+}
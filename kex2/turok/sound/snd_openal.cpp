@@ -0,0 +1,397 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: OpenAL sound backend
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "sound.h"
+#include "snd_openal.h"
+
+// OpenAL 1.1, missing from the bundled headers
+#ifndef AL_SEC_OFFSET
+#define AL_SEC_OFFSET 0x1024
+#endif
+
+//
+// SndAL_GetFormat
+//
+
+static ALenum SndAL_GetFormat(const kexWavFile *wave) {
+    if(wave->Channels() == 2) {
+        return wave->Bits() == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
+    }
+
+    return wave->Bits() == 8 ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
+}
+
+//
+// kexSoundOpenAL::kexSoundOpenAL
+//
+
+kexSoundOpenAL::kexSoundOpenAL(void) {
+    alDevice = NULL;
+    alContext = NULL;
+    numChannels = 0;
+}
+
+//
+// kexSoundOpenAL::Init
+//
+
+bool kexSoundOpenAL::Init(void) {
+    if(!(alDevice = alcOpenDevice(NULL))) {
+        common.Warning(LC_SOUND, "kexSoundOpenAL::Init: Failed to create OpenAL device\n");
+        return false;
+    }
+
+    if(!(alContext = alcCreateContext(alDevice, NULL))) {
+        common.Warning(LC_SOUND, "kexSoundOpenAL::Init: Failed to create OpenAL context\n");
+        alcCloseDevice(alDevice);
+        alDevice = NULL;
+        return false;
+    }
+
+    if(!alcMakeContextCurrent(alContext)) {
+        common.Warning(LC_SOUND, "kexSoundOpenAL::Init: Failed to set current context\n");
+        alcDestroyContext(alContext);
+        alcCloseDevice(alDevice);
+        alContext = NULL;
+        alDevice = NULL;
+        return false;
+    }
+
+    for(numChannels = 0; numChannels < SND_MAX_SOURCES; numChannels++) {
+        alChannel_t *chan = &channels[numChannels];
+
+        alGetError();
+        alGenSources(1, &chan->handle);
+
+        if(alGetError() != AL_NO_ERROR) {
+            break;
+        }
+
+        chan->bActive = false;
+        chan->numFree = 0;
+        memset(chan->streamBuffers, 0, sizeof(chan->streamBuffers));
+
+        alSourcei(chan->handle, AL_LOOPING, AL_FALSE);
+        alSourcei(chan->handle, AL_SOURCE_RELATIVE, AL_TRUE);
+        alSourcef(chan->handle, AL_GAIN, 1.0f);
+        alSourcef(chan->handle, AL_PITCH, 1.0f);
+    }
+
+    alListener3f(AL_POSITION, 0, 0, 0);
+    return true;
+}
+
+//
+// kexSoundOpenAL::Shutdown
+//
+
+void kexSoundOpenAL::Shutdown(void) {
+    for(int i = 0; i < numChannels; i++) {
+        StopChannel(i);
+        alDeleteSources(1, &channels[i].handle);
+        channels[i].handle = 0;
+
+        if(channels[i].streamBuffers[0] != 0) {
+            alDeleteBuffers(SND_STREAM_CHUNKS, channels[i].streamBuffers);
+            memset(channels[i].streamBuffers, 0, sizeof(channels[i].streamBuffers));
+        }
+    }
+
+    numChannels = 0;
+
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(alContext);
+    alcCloseDevice(alDevice);
+
+    alContext = NULL;
+    alDevice = NULL;
+}
+
+//
+// kexSoundOpenAL::GetDeviceName
+//
+
+const char *kexSoundOpenAL::GetDeviceName(void) {
+    return (const char*)alcGetString(alDevice, ALC_DEVICE_SPECIFIER);
+}
+
+//
+// kexSoundOpenAL::UploadWave
+//
+
+void kexSoundOpenAL::UploadWave(kexWavFile *wave) {
+    if(*wave->GetBuffer() != 0) {
+        return;
+    }
+
+    alGetError();
+    alGenBuffers(1, wave->GetBuffer());
+
+    if(alGetError() != AL_NO_ERROR) {
+        common.Error("kexSoundOpenAL::UploadWave: failed to create buffer for %s", wave->filePath);
+    }
+
+    alBufferData(*wave->GetBuffer(), SndAL_GetFormat(wave), wave->Data(), wave->Size(), wave->Rate());
+}
+
+//
+// kexSoundOpenAL::DeleteWave
+//
+
+void kexSoundOpenAL::DeleteWave(kexWavFile *wave) {
+    if(*wave->GetBuffer() == 0) {
+        return;
+    }
+
+    alDeleteBuffers(1, wave->GetBuffer());
+    *wave->GetBuffer() = 0;
+}
+
+//
+// kexSoundOpenAL::SetListener
+//
+
+void kexSoundOpenAL::SetListener(const kexVec3 &origin, const kexVec3 &forward, const kexVec3 &up) {
+    ALfloat orientation[6];
+
+    orientation[0] = forward.x;
+    orientation[1] = forward.y;
+    orientation[2] = forward.z;
+    orientation[3] = up.x;
+    orientation[4] = up.y;
+    orientation[5] = up.z;
+
+    alListenerfv(AL_ORIENTATION, orientation);
+    alListener3f(AL_POSITION, SND_VECTOR2METRICS(origin));
+}
+
+//
+// kexSoundOpenAL::StartChannel
+//
+
+bool kexSoundOpenAL::StartChannel(const int channel, const sndParams_t &params, const float offset) {
+    alChannel_t *chan = &channels[channel];
+    ALuint handle = chan->handle;
+    float remaining;
+
+    if(params.stream) {
+        alSourcei(handle, AL_BUFFER, 0);
+
+        if(!QueueStream(chan, params.stream) && chan->streamBuffers[0] == 0) {
+            return false;
+        }
+    }
+    else {
+        if(*params.wave->GetBuffer() == 0) {
+            // cached while another backend was up
+            UploadWave(params.wave);
+        }
+
+        alSourcei(handle, AL_BUFFER, *params.wave->GetBuffer());
+    }
+
+    alSourcef(handle, AL_PITCH, params.pitch);
+
+    if(!params.bLocal) {
+        alSourcef(handle, AL_ROLLOFF_FACTOR, params.rolloffFactor);
+        alSourcei(handle, AL_SOURCE_RELATIVE, AL_FALSE);
+        alSource3f(handle, AL_POSITION, SND_VECTOR2METRICS(params.origin));
+    }
+    else {
+        alSourcei(handle, AL_SOURCE_RELATIVE, AL_TRUE);
+        alSource3f(handle, AL_POSITION, 0, 0, 0);
+    }
+
+    if(offset > 0) {
+        alSourcef(handle, AL_SEC_OFFSET, offset);
+    }
+
+    alSourcef(handle, AL_GAIN, params.gain);
+
+    // a stream the thread hasn't got to yet is started by UpdateStream
+    if(!params.stream || chan->numFree < SND_STREAM_CHUNKS) {
+        alSourcePlay(handle);
+    }
+
+    remaining = (float)params.wave->Duration() - offset * 1000.0f;
+
+    if(params.pitch > 0) {
+        remaining /= params.pitch;
+    }
+
+    chan->bActive = true;
+    chan->params = params;
+    chan->startPitch = params.pitch;
+    chan->pollTime = kexSoundSystem::time + (int)remaining;
+    return true;
+}
+
+//
+// kexSoundOpenAL::StopChannel
+//
+
+void kexSoundOpenAL::StopChannel(const int channel) {
+    alChannel_t *chan = &channels[channel];
+
+    if(!chan->bActive) {
+        return;
+    }
+
+    alSourceStop(chan->handle);
+    alSourcei(chan->handle, AL_BUFFER, 0);
+    chan->bActive = false;
+
+    // clearing the buffer unqueues everything
+    if(chan->streamBuffers[0] != 0) {
+        memcpy(chan->freeBuffers, chan->streamBuffers, sizeof(chan->freeBuffers));
+        chan->numFree = SND_STREAM_CHUNKS;
+    }
+}
+
+//
+// kexSoundOpenAL::UpdateChannel
+//
+
+bool kexSoundOpenAL::UpdateChannel(const int channel, const sndParams_t &params) {
+    alChannel_t *chan = &channels[channel];
+    ALint state;
+
+    if(!chan->bActive) {
+        return false;
+    }
+
+    // the envelopes and moving objects nudge these every frame,
+    // but there's no point calling into the driver for nothing
+    if(!params.bLocal &&
+        (kexMath::Fabs(params.origin.x - chan->params.origin.x) > SND_ORIGIN_EPSILON ||
+         kexMath::Fabs(params.origin.y - chan->params.origin.y) > SND_ORIGIN_EPSILON ||
+         kexMath::Fabs(params.origin.z - chan->params.origin.z) > SND_ORIGIN_EPSILON)) {
+        alSource3f(chan->handle, AL_POSITION, SND_VECTOR2METRICS(params.origin));
+        chan->params.origin = params.origin;
+    }
+
+    if(kexMath::Fabs(params.gain - chan->params.gain) > SND_GAIN_EPSILON ||
+        (params.gain == 0 && chan->params.gain != 0)) {
+        alSourcef(chan->handle, AL_GAIN, params.gain);
+        chan->params.gain = params.gain;
+    }
+
+    if(kexMath::Fabs(params.pitch - chan->params.pitch) > SND_PITCH_EPSILON) {
+        alSourcef(chan->handle, AL_PITCH, params.pitch);
+        chan->params.pitch = params.pitch;
+    }
+
+    if(params.stream) {
+        return UpdateStream(chan, params.stream);
+    }
+
+    // a change in pitch throws off when it should end
+    if(chan->params.pitch == chan->startPitch && kexSoundSystem::time < chan->pollTime) {
+        return true;
+    }
+
+    alGetSourcei(chan->handle, AL_SOURCE_STATE, &state);
+    return (state == AL_PLAYING);
+}
+
+//
+// kexSoundOpenAL::QueueStream
+//
+// Queues every chunk the stream has ready that there's a free buffer
+// for. The buffers are made the first time the channel streams.
+// Returns false if nothing is queued on the source
+//
+
+bool kexSoundOpenAL::QueueStream(alChannel_t *chan, kexSoundStream *stream) {
+    kexWavFile *wave = stream->Wave();
+    const byte *data;
+    ALuint buffer;
+    int size;
+
+    if(chan->streamBuffers[0] == 0) {
+        alGetError();
+        alGenBuffers(SND_STREAM_CHUNKS, chan->streamBuffers);
+
+        if(alGetError() != AL_NO_ERROR) {
+            common.Warning(LC_SOUND, "kexSoundOpenAL::QueueStream: failed to create stream buffers\n");
+            memset(chan->streamBuffers, 0, sizeof(chan->streamBuffers));
+            return false;
+        }
+
+        memcpy(chan->freeBuffers, chan->streamBuffers, sizeof(chan->freeBuffers));
+        chan->numFree = SND_STREAM_CHUNKS;
+    }
+
+    while(chan->numFree > 0 && (data = stream->Chunk(&size)) != NULL) {
+        if(size > 0) {
+            buffer = chan->freeBuffers[--chan->numFree];
+
+            alBufferData(buffer, SndAL_GetFormat(wave), data, size, wave->Rate());
+            alSourceQueueBuffers(chan->handle, 1, &buffer);
+        }
+
+        stream->Release();
+    }
+
+    return (chan->numFree < SND_STREAM_CHUNKS);
+}
+
+//
+// kexSoundOpenAL::UpdateStream
+//
+// Swaps played buffers for new chunks. If the source ran dry
+// before the stream thread caught up it's started again once
+// there's something queued. Returns false once it's played out
+//
+
+bool kexSoundOpenAL::UpdateStream(alChannel_t *chan, kexSoundStream *stream) {
+    ALint processed = 0;
+    ALint state;
+    ALuint buffer;
+
+    alGetSourcei(chan->handle, AL_BUFFERS_PROCESSED, &processed);
+
+    while(processed-- > 0) {
+        alSourceUnqueueBuffers(chan->handle, 1, &buffer);
+        chan->freeBuffers[chan->numFree++] = buffer;
+    }
+
+    QueueStream(chan, stream);
+
+    alGetSourcei(chan->handle, AL_SOURCE_STATE, &state);
+
+    if(state == AL_PLAYING) {
+        return true;
+    }
+
+    if(chan->numFree < SND_STREAM_CHUNKS) {
+        alSourcePlay(chan->handle);
+        return true;
+    }
+
+    return !stream->Finished();
+}
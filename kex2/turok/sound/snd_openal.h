@@ -0,0 +1,80 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef __SND_OPENAL_H__
+#define __SND_OPENAL_H__
+
+#if defined(_WIN32) && defined(_MSC_VER)
+#include "al.h"
+#include "alc.h"
+#else
+#include <OpenAL/al.h>
+#include <OpenAL/alc.h>
+#endif
+
+//
+// kexSoundOpenAL - hands each channel to an OpenAL source. sources are
+// only asked if they're done once they could have played out, and
+// parameters are only pushed when they change. streamed waves are
+// queued onto the source a chunk at a time
+//
+
+class kexSoundOpenAL : public kexSoundBackend {
+public:
+                                        kexSoundOpenAL(void);
+
+    bool                                Init(void);
+    void                                Shutdown(void);
+    const char                          *GetDeviceName(void);
+    int                                 NumChannels(void) { return numChannels; }
+    void                                UploadWave(kexWavFile *wave);
+    void                                DeleteWave(kexWavFile *wave);
+    void                                SetListener(const kexVec3 &origin, const kexVec3 &forward,
+                                                    const kexVec3 &up);
+    bool                                StartChannel(const int channel, const sndParams_t &params,
+                                                     const float offset);
+    void                                StopChannel(const int channel);
+    bool                                UpdateChannel(const int channel, const sndParams_t &params);
+    void                                Update(const int time) {}
+
+private:
+    typedef struct {
+        ALuint                          handle;
+        bool                            bActive;
+        int                             pollTime;   // sound time it can't have finished before
+        float                           startPitch;
+        sndParams_t                     params;     // as last pushed
+        ALuint                          streamBuffers[SND_STREAM_CHUNKS];
+        ALuint                          freeBuffers[SND_STREAM_CHUNKS];
+        int                             numFree;
+    } alChannel_t;
+
+    bool                                QueueStream(alChannel_t *chan, kexSoundStream *stream);
+    bool                                UpdateStream(alChannel_t *chan, kexSoundStream *stream);
+
+    ALCdevice                           *alDevice;
+    ALCcontext                          *alContext;
+    alChannel_t                         channels[SND_MAX_SOURCES];
+    int                                 numChannels;
+};
+
+#endif
@@ -45,6 +45,12 @@ enum {
     scsfx_freqfactorend,
     scsfx_freqfactortime,
     scsfx_freqfactordelay,
+    scsfx_gainattack,
+    scsfx_gaindecay,
+    scsfx_gainpeak,
+    scsfx_freqattack,
+    scsfx_freqdecay,
+    scsfx_freqpeak,
     scsfx_end
 };
 
@@ -64,14 +70,58 @@ static const sctokens_t sfxtokens[scsfx_end+1] = {
     { scsfx_freqfactorend,      "freqFactorEnd"     },
     { scsfx_freqfactortime,     "freqInterpTime"    },
     { scsfx_freqfactordelay,    "freqInterpDelay"   },
+    { scsfx_gainattack,         "gainAttack"        },
+    { scsfx_gaindecay,          "gainDecay"         },
+    { scsfx_gainpeak,           "gainPeak"          },
+    { scsfx_freqattack,         "freqAttack"        },
+    { scsfx_freqdecay,          "freqDecay"         },
+    { scsfx_freqpeak,           "freqPeak"          },
     { -1,                       NULL                }
 };
 
+enum {
+    scshader_priority = 0,
+    scshader_maxinstances,
+    scshader_cooldown,
+    scshader_end
+};
+
+static const sctokens_t shadertokens[scshader_end+1] = {
+    { scshader_priority,        "priority"          },
+    { scshader_maxinstances,    "maxInstances"      },
+    { scshader_cooldown,        "cooldown"          },
+    { -1,                       NULL                }
+};
+
+//
+// Shader_SetupEnvelopes
+//
+// Attack and decay are in 60ths like the delays. Without either, the
+// interp time is how much of the way to the end is covered each 60th
+//
+
+static void Shader_SetupEnvelopes(sfx_t *sfx) {
+    sfx->gainEnvelope.Set(sfx->gainLerpStart, sfx->gainPeak, sfx->gainLerpEnd,
+        SND_INT2TIME(sfx->gainLerpDelay), SND_INT2TIME(sfx->gainAttack),
+        SND_INT2TIME(sfx->gainDecay), (float)sfx->gainLerpTime / 60.0f);
+
+    sfx->freqEnvelope.Set(sfx->freqLerpStart, sfx->freqPeak, sfx->freqLerpEnd,
+        SND_INT2TIME(sfx->freqLerpDelay), SND_INT2TIME(sfx->freqAttack),
+        SND_INT2TIME(sfx->freqDecay), (float)sfx->freqLerpTime / 60.0f);
+}
+
 //
 // kexSoundShader::kexSoundShader
 //
 
 kexSoundShader::kexSoundShader(void) {
+    this->priority      = 0;
+    this->maxInstances  = 0;
+    this->cooldown      = 0;
+    this->numsfx        = 0;
+    this->sfxList       = NULL;
+    this->nextPlayTime  = 0;
+    this->numVoices     = 0;
 }
 
 //
@@ -90,6 +140,32 @@ void kexSoundShader::Load(kexLexer *lexer) {
 
     lexer->Find();
 
+    // optional settings for the whole shader
+    while(!lexer->Matches("sounds") && lexer->TokenType() == TK_IDENIFIER) {
+        switch(lexer->GetIDForTokenList(shadertokens, lexer->Token())) {
+        case scshader_priority:
+            lexer->AssignFromTokenList(shadertokens, (unsigned int*)&priority,
+                scshader_priority, false);
+            break;
+
+        case scshader_maxinstances:
+            lexer->AssignFromTokenList(shadertokens, (unsigned int*)&maxInstances,
+                scshader_maxinstances, false);
+            break;
+
+        case scshader_cooldown:
+            lexer->AssignFromTokenList(shadertokens, (unsigned int*)&cooldown,
+                scshader_cooldown, false);
+            break;
+
+        default:
+            common.Error("Snd_ParseShaderScript: Expected 'sound', found %s", lexer->Token());
+            break;
+        }
+
+        lexer->Find();
+    }
+
     if(!lexer->Matches("sounds")) {
         common.Error("Snd_ParseShaderScript: Expected 'sound', found %s", lexer->Token());
     }
@@ -116,6 +192,8 @@ void kexSoundShader::Load(kexLexer *lexer) {
     for(i = 0; i < numsfx; i++) {
         sfx_t *sfx = &sfxList[i];
         sfx->rolloffFactor = 8.0f;
+        sfx->gainPeak = 1.0f;
+        sfx->freqPeak = 1.0f;
 
         lexer->ExpectNextToken(TK_LBRACK);
         lexer->Find();
@@ -198,6 +276,36 @@ void kexSoundShader::Load(kexLexer *lexer) {
                     scsfx_freqfactordelay, false);
                 break;
 
+            case scsfx_gainattack:
+                lexer->AssignFromTokenList(sfxtokens, (unsigned int*)&sfx->gainAttack,
+                    scsfx_gainattack, false);
+                break;
+
+            case scsfx_gaindecay:
+                lexer->AssignFromTokenList(sfxtokens, (unsigned int*)&sfx->gainDecay,
+                    scsfx_gaindecay, false);
+                break;
+
+            case scsfx_gainpeak:
+                lexer->AssignFromTokenList(sfxtokens, &sfx->gainPeak,
+                    scsfx_gainpeak, false);
+                break;
+
+            case scsfx_freqattack:
+                lexer->AssignFromTokenList(sfxtokens, (unsigned int*)&sfx->freqAttack,
+                    scsfx_freqattack, false);
+                break;
+
+            case scsfx_freqdecay:
+                lexer->AssignFromTokenList(sfxtokens, (unsigned int*)&sfx->freqDecay,
+                    scsfx_freqdecay, false);
+                break;
+
+            case scsfx_freqpeak:
+                lexer->AssignFromTokenList(sfxtokens, &sfx->freqPeak,
+                    scsfx_freqpeak, false);
+                break;
+
             default:
                 if(lexer->TokenType() == TK_IDENIFIER) {
                     parser.Error("kexSoundShader::Load: Unknown token: %s\n",
@@ -208,17 +316,56 @@ void kexSoundShader::Load(kexLexer *lexer) {
 
             lexer->Find();
         }
+
+        Shader_SetupEnvelopes(sfx);
     }
 
     lexer->ExpectNextToken(TK_RBRACK);
 }
 
+//
+// kexSoundShader::CheckCooldown
+//
+// Returns false if the shader played too recently to play again
+//
+
+bool kexSoundShader::CheckCooldown(const int time) {
+    if(cooldown <= 0) {
+        return true;
+    }
+
+    // sound time starts over when the sound system is restarted
+    if(time < nextPlayTime && time >= nextPlayTime - cooldown) {
+        return false;
+    }
+
+    nextPlayTime = time + cooldown;
+    return true;
+}
+
+//
+// kexSoundShader::Touch
+//
+// Marks every wave the shader can play as used by the current map,
+// reading back any that were evicted
+//
+
+void kexSoundShader::Touch(void) {
+    for(int i = 0; i < numsfx; i++) {
+        if(sfxList[i].wavFile) {
+            sfxList[i].wavFile->Touch();
+        }
+    }
+}
+
 //
 // kexSoundShader::Play
 //
 
 void kexSoundShader::Play(kexGameObject *obj) {
-    kexSoundSource *src;
+    if(!CheckCooldown(kexSoundSystem::time)) {
+        return;
+    }
 
     for(int i = 0; i < numsfx; i++) {
 
@@ -227,10 +374,17 @@ void kexSoundShader::Play(kexGameObject *obj) {
             continue;
         }
 
-        if(!(src = soundSystem.GetAvailableSource())) {
-            return;
+        if(!sfxList[i].wavFile) {
+            continue;
+        }
+
+        // reads the wave back in if it was evicted
+        sfxList[i].wavFile->Touch();
+
+        if(!sfxList[i].wavFile->IsResident()) {
+            continue;
         }
 
-        src->Set(&sfxList[i], obj);
+        soundSystem.StartVoice(this, &sfxList[i], obj);
     }
 }
@@ -0,0 +1,322 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Streamed waves
+//
+// Each stream keeps its own handle on the file, so the stream thread
+// can read it without holding up anything else touching the packs.
+// The handle is opened by the first fill rather than by whoever
+// started the sound, since opening a packed file means reading the
+// pack's directory again.
+// The chunk ring is single producer, single consumer: the thread only
+// fills empty chunks and the player only reads filled ones. Anything
+// that moves the file or resets the ring takes the stream's lock.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "sound.h"
+
+//
+// kexSoundStream::Open
+//
+// Offset is in bytes into the samples. Nothing is read here,
+// the file is opened and primed by the next fill
+//
+
+void kexSoundStream::Open(kexWavFile *wavFile, const int offset) {
+    SDL_LockMutex(lock);
+
+    wave = wavFile;
+    bOpened = false;
+    readChunk = 0;
+    writeChunk = 0;
+    remaining = wave->Size() - offset;
+    seekOffset = offset;
+
+    for(int i = 0; i < SND_STREAM_CHUNKS; i++) {
+        chunks[i].size = 0;
+        SDL_AtomicSet(&chunks[i].bFilled, 0);
+    }
+
+    SDL_AtomicSet(&bEOF, 0);
+    SDL_AtomicSet(&bActive, 1);
+    SDL_UnlockMutex(lock);
+}
+
+//
+// kexSoundStream::Close
+//
+
+void kexSoundStream::Close(void) {
+    SDL_LockMutex(lock);
+
+    if(SDL_AtomicGet(&bActive)) {
+        if(bOpened) {
+            fileSystem.CloseStream(&file);
+            bOpened = false;
+        }
+
+        SDL_AtomicSet(&bActive, 0);
+    }
+
+    wave = NULL;
+    SDL_UnlockMutex(lock);
+}
+
+//
+// kexSoundStream::Fill
+//
+// Reads into every empty chunk it can
+//
+
+void kexSoundStream::Fill(void) {
+    streamChunk_t *chunk;
+    int size;
+
+    SDL_LockMutex(lock);
+
+    if(!SDL_AtomicGet(&bActive) || SDL_AtomicGet(&bEOF)) {
+        SDL_UnlockMutex(lock);
+        return;
+    }
+
+    if(!bOpened) {
+        if(!fileSystem.OpenStream(wave->filePath, &file)) {
+            common.Warning(LC_SOUND, "kexSoundStream::Fill: couldn't open %s\n", wave->filePath);
+            remaining = 0;
+            SDL_AtomicSet(&bEOF, 1);
+            SDL_UnlockMutex(lock);
+            return;
+        }
+
+        bOpened = true;
+    }
+
+    if(seekOffset >= 0) {
+        if(!fileSystem.SeekStream(&file, wave->DataOffset() + seekOffset)) {
+            remaining = 0;
+        }
+
+        seekOffset = -1;
+    }
+
+    while(remaining > 0) {
+        chunk = &chunks[writeChunk];
+
+        if(SDL_AtomicGet(&chunk->bFilled)) {
+            break;
+        }
+
+        size = remaining < SND_STREAM_CHUNK_SIZE ? remaining : SND_STREAM_CHUNK_SIZE;
+        size = fileSystem.ReadStream(&file, chunk->data, size);
+
+        // the file came up short of what the header said
+        if(size <= 0) {
+            remaining = 0;
+            break;
+        }
+
+        remaining -= size;
+
+        chunk->size = size - (size % wave->BlockAlign());
+        SDL_AtomicSet(&chunk->bFilled, 1);
+
+        writeChunk = (writeChunk + 1) % SND_STREAM_CHUNKS;
+    }
+
+    // set after the last chunk is published so the
+    // player never sees the end before the data
+    if(remaining <= 0) {
+        SDL_AtomicSet(&bEOF, 1);
+    }
+
+    SDL_UnlockMutex(lock);
+}
+
+//
+// kexSoundStream::Chunk
+//
+// The next chunk to play, or NULL if the thread hasn't filled it yet
+//
+
+const byte *kexSoundStream::Chunk(int *size) {
+    streamChunk_t *chunk = &chunks[readChunk];
+
+    if(!SDL_AtomicGet(&chunk->bFilled)) {
+        return NULL;
+    }
+
+    *size = chunk->size;
+    return chunk->data;
+}
+
+//
+// kexSoundStream::Release
+//
+// Hands the chunk from the last Chunk call back to the thread
+//
+
+void kexSoundStream::Release(void) {
+    SDL_AtomicSet(&chunks[readChunk].bFilled, 0);
+    readChunk = (readChunk + 1) % SND_STREAM_CHUNKS;
+
+    soundSystem.Streamer().Wake();
+}
+
+//
+// kexSoundStream::Finished
+//
+
+bool kexSoundStream::Finished(void) {
+    return SDL_AtomicGet(&bEOF) && !SDL_AtomicGet(&chunks[readChunk].bFilled);
+}
+
+//
+// kexSoundStreamer::kexSoundStreamer
+//
+
+kexSoundStreamer::kexSoundStreamer(void) {
+    thread = NULL;
+    wake = NULL;
+}
+
+//
+// kexSoundStreamer::Init
+//
+
+void kexSoundStreamer::Init(void) {
+    for(int i = 0; i < SND_MAX_STREAMS; i++) {
+        kexSoundStream *stream = &streams[i];
+
+        stream->wave = NULL;
+        stream->bOpened = false;
+        stream->lock = SDL_CreateMutex();
+        SDL_AtomicSet(&stream->bActive, 0);
+        SDL_AtomicSet(&stream->bEOF, 0);
+
+        for(int j = 0; j < SND_STREAM_CHUNKS; j++) {
+            stream->chunks[j].data = (byte*)Mem_Malloc(SND_STREAM_CHUNK_SIZE, kexSoundSystem::hb_sound);
+            stream->chunks[j].size = 0;
+            SDL_AtomicSet(&stream->chunks[j].bFilled, 0);
+        }
+    }
+
+    SDL_AtomicSet(&bQuit, 0);
+
+    wake = SDL_CreateSemaphore(0);
+    thread = SDL_CreateThread(StreamThread, "soundStream", this);
+
+    if(thread == NULL) {
+        common.Warning(LC_SOUND, "kexSoundStreamer::Init: couldn't start the stream thread\n");
+    }
+}
+
+//
+// kexSoundStreamer::Shutdown
+//
+
+void kexSoundStreamer::Shutdown(void) {
+    if(thread) {
+        SDL_AtomicSet(&bQuit, 1);
+        SDL_SemPost(wake);
+        SDL_WaitThread(thread, NULL);
+        thread = NULL;
+    }
+
+    for(int i = 0; i < SND_MAX_STREAMS; i++) {
+        streams[i].Close();
+        SDL_DestroyMutex(streams[i].lock);
+        streams[i].lock = NULL;
+    }
+
+    if(wake) {
+        SDL_DestroySemaphore(wake);
+        wake = NULL;
+    }
+}
+
+//
+// kexSoundStreamer::Open
+//
+// Returns NULL if every stream is busy. Without a stream thread
+// the first chunks are read here instead
+//
+
+kexSoundStream *kexSoundStreamer::Open(kexWavFile *wave, const int offset) {
+    for(int i = 0; i < SND_MAX_STREAMS; i++) {
+        kexSoundStream *stream = &streams[i];
+
+        if(SDL_AtomicGet(&stream->bActive)) {
+            continue;
+        }
+
+        stream->Open(wave, offset);
+
+        if(thread == NULL) {
+            stream->Fill();
+        }
+
+        Wake();
+        return stream;
+    }
+
+    return NULL;
+}
+
+//
+// kexSoundStreamer::Wake
+//
+
+void kexSoundStreamer::Wake(void) {
+    if(thread) {
+        SDL_SemPost(wake);
+    }
+}
+
+//
+// kexSoundStreamer::StreamThread
+//
+
+int kexSoundStreamer::StreamThread(void *data) {
+    static_cast<kexSoundStreamer*>(data)->Run();
+    return 0;
+}
+
+//
+// kexSoundStreamer::Run
+//
+// Wakes whenever a chunk is handed back or a stream is opened, and
+// every so often regardless in case a wake was missed
+//
+
+void kexSoundStreamer::Run(void) {
+    while(!SDL_AtomicGet(&bQuit)) {
+        for(int i = 0; i < SND_MAX_STREAMS; i++) {
+            if(SDL_AtomicGet(&streams[i].bActive)) {
+                streams[i].Fill();
+            }
+        }
+
+        SDL_SemWaitTimeout(wake, 50);
+    }
+}
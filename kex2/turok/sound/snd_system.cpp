@@ -31,29 +31,40 @@
 #include "filesystem.h"
 #include "world.h"
 #include "gameManager.h"
+#include "snd_openal.h"
 
 kexCvar cvarPitchShift("s_pitchshift", CVF_BOOL|CVF_CONFIG, "1", "TODO");
 kexCvar cvarSoundVolume("s_sndvolume", CVF_FLOAT|CVF_CONFIG, "0.5", 0, 1, "TODO");
-
-#define SND_METRICS 0.0035f
-#define SND_VECTOR2METRICS(vec) \
-    vec[0] * SND_METRICS,       \
-    vec[1] * SND_METRICS,       \
-    vec[2] * SND_METRICS
-
-#define SND_INT2TIME(t) ((float)t * ((1.0f / 60.0f) * 1000.0f))
+kexCvar cvarSoundDriver("s_driver", CVF_STRING|CVF_CONFIG, "openal",
+                        "Sound output: openal, null or wav. Read at startup");
+kexCvar cvarSoundMixRate("s_mixrate", CVF_INT|CVF_CONFIG, "44100", 8000, 96000,
+                         "Output rate of the software mixer");
+kexCvar cvarSoundWavFile("s_wavfile", CVF_STRING|CVF_CONFIG, "sound.wav",
+                         "File the wav driver writes to");
+kexCvar cvarSoundStreamSize("s_streamsize", CVF_INT|CVF_CONFIG, "524288", 0, 67108864,
+                            "Waves bigger than this many bytes are streamed, 0 to load everything");
 
 kexSoundSystem soundSystem;
 kexHeapBlock kexSoundSystem::hb_sound("sound", false, NULL, NULL);
 
+#define WAVE_FORMAT_PCM         0x0001
+#define WAVE_FORMAT_EXTENSIBLE  0xFFFE
+
+static kexSoundOpenAL soundOpenAL;
+static kexSoundMixer soundMixer;
+static kexNullSoundSink nullSink;
+static kexWavSoundSink wavSink;
+
 //
 // printsoundinfo
 //
 
 COMMAND(printsoundinfo) {
-    common.CPrintf(COLOR_CYAN, "------------- Sound Info -------------\n");
-    common.CPrintf(COLOR_GREEN, "Device: %s\n", soundSystem.GetDeviceName());
-    common.CPrintf(COLOR_GREEN, "Available Sources: %i\n", soundSystem.GetNumActiveSources());
+    common.CPrintf(LC_SOUND, COLOR_CYAN, "------------- Sound Info -------------\n");
+    common.CPrintf(LC_SOUND, COLOR_GREEN, "Device: %s\n", soundSystem.GetDeviceName());
+    common.CPrintf(LC_SOUND, COLOR_GREEN, "Available Sources: %i\n", soundSystem.GetNumActiveSources());
+    common.CPrintf(LC_SOUND, COLOR_GREEN, "Voices: %i (%i virtual)\n",
+        soundSystem.Voices().NumActive(), soundSystem.Voices().NumVirtual());
 }
 
 //
@@ -80,11 +91,23 @@ COMMAND(stopsounds) {
     soundSystem.StopAll();
 }
 
+//
+// Wav_Evict
+//
+
+static void Wav_Evict(void *data) {
+    static_cast<kexWavFile*>(data)->Free();
+}
+
 //
 // kexWavFile::kexWavFile
 //
 
 kexWavFile::kexWavFile(void) {
+    this->data      = NULL;
+    this->waveFile  = NULL;
+    this->buffer    = 0;
+    this->bStreamed = false;
 }
 
 //
@@ -109,307 +132,604 @@ bool kexWavFile::CompareTag(const char *tag, int offset) {
 }
 
 //
-// kexWavFile::GetFormat
+// Wav_Read16
 //
 
-int kexWavFile::GetFormat(void) {
-    switch(channels) {
-    case 1:
-        switch(bits) {
-        case 8:
-            return AL_FORMAT_MONO8;
-        case 16:
-            return AL_FORMAT_MONO16;
-        }
-        break;
-    case 2:
-        switch(bits) {
-        case 8:
-            return AL_FORMAT_STEREO8;
-        case 16:
-            return AL_FORMAT_STEREO16;
-        }
-        break;
-    default:
-        common.Error("Snd_GetWaveFormat: Unsupported number of channels - %i", channels);
-        return -1;
-    }
+static d_inline int Wav_Read16(const byte *data) {
+    return data[0] | (data[1] << 8);
+}
 
-    common.Error("Snd_GetWaveFormat: Unknown bits format - %i", bits);
-    return -1;
+//
+// Wav_Read32
+//
+
+static d_inline int Wav_Read32(const byte *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
 }
 
 //
-// kexWavFile::Allocate
+// kexWavFile::Parse
+//
+// Walks the RIFF chunks for the format and the samples, skipping
+// anything else. Only PCM is supported, plain or extensible. The
+// wave is pointed at its samples, which aren't copied. fileSize
+// is the size of the whole file when only its start was read, in
+// which case the samples are left where they are. Warns and returns
+// false if the wave can't be played. A NULL name keeps it quiet
 //
 
-void kexWavFile::Allocate(const char *name, byte *data) {
-    strcpy(filePath, name);
-    waveFile = data;
+bool kexWavFile::Parse(const char *name, byte *buffer, const int size, const int fileSize) {
+    const char *error = NULL;
+    const int end = fileSize > size ? fileSize : size;
+    bool bFormat = false;
+    bool bData = false;
+    int offset;
 
-    if(!CompareTag("RIFF", 0)) {
-        common.Error("kexWavFile::Allocate: RIFF header not found in %s", name);
+    waveFile    = buffer;
+    data        = NULL;
+    waveSize    = 0;
+    dataOffset  = 0;
+    channels    = 0;
+    bits        = 0;
+    samples     = 0;
+    bytes       = 0;
+    blockAlign  = 1;
+
+    if(size < 12 || !CompareTag("RIFF", 0) || !CompareTag("WAVE", 8)) {
+        error = "not a RIFF WAVE file";
     }
-    if(!CompareTag("WAVE", 8)) {
-        common.Error("kexWavFile::Allocate: WAVE header not found in %s", name);
+
+    for(offset = 12; error == NULL && offset + 8 <= size;) {
+        unsigned int chunkSize = (unsigned int)Wav_Read32(buffer + offset + 4);
+        const byte *chunk = buffer + offset + 8;
+
+        if(CompareTag("fmt ", offset)) {
+            int format;
+
+            if(chunkSize < 16 || offset + 8 + 16 > size) {
+                error = "fmt chunk is too short";
+                break;
+            }
+
+            format      = Wav_Read16(chunk);
+            channels    = Wav_Read16(chunk + 2);
+            samples     = Wav_Read32(chunk + 4);
+            bits        = Wav_Read16(chunk + 14);
+
+            if(format == WAVE_FORMAT_EXTENSIBLE) {
+                if(chunkSize < 40 || offset + 8 + 40 > size) {
+                    error = "extensible fmt chunk is too short";
+                    break;
+                }
+
+                // the sub format guid starts with the real format code
+                format = Wav_Read16(chunk + 24);
+            }
+
+            formatCode = format;
+            bFormat = true;
+        }
+        else if(CompareTag("data", offset)) {
+            dataOffset = offset + 8;
+            waveSize = (chunkSize > (unsigned int)(end - dataOffset)) ?
+                end - dataOffset : (int)chunkSize;
+            bData = true;
+        }
+
+        if(chunkSize > (unsigned int)(end - offset - 8)) {
+            break;
+        }
+
+        // chunks are padded to even sizes
+        offset += 8 + chunkSize + (chunkSize & 1);
     }
-    if(!CompareTag("fmt ", 12)) {
-        common.Error("kexWavFile::Allocate: fmt header not found in %s", name);
+
+    if(error == NULL) {
+        if(!bFormat) {
+            error = "no fmt chunk";
+        }
+        else if(!bData) {
+            error = "no data chunk";
+        }
+        else if(formatCode != WAVE_FORMAT_PCM) {
+            error = "not PCM";
+        }
+        else if(channels != 1 && channels != 2) {
+            error = "only mono and stereo are supported";
+        }
+        else if(bits != 8 && bits != 16) {
+            error = "only 8 and 16 bit samples are supported";
+        }
+        else if(samples <= 0) {
+            error = "bad sample rate";
+        }
     }
-    if(!CompareTag("data", 36)) {
-        common.Error("kexWavFile::Allocate: data header not found in %s", name);
+
+    if(error) {
+        if(name) {
+            common.Warning(LC_SOUND, "kexWavFile::Parse: %s (%s)\n", error, name);
+        }
+
+        return false;
     }
 
-    if(*(data + 16) != 16) {
-        common.Error("kexWavFile::Allocate: WAV chunk size must be 16 (%s)", name);
+    // worked out rather than trusted
+    blockAlign  = channels * (bits / 8);
+    bytes       = samples * blockAlign;
+    waveSize   -= waveSize % blockAlign;
+
+    if(dataOffset + waveSize <= size) {
+        data = buffer + dataOffset;
     }
 
-    formatCode  = *(short*)(data + 20);
-    channels    = *(short*)(data + 22);
-    samples     = *(int*)(data + 24);
-    bytes       = *(int*)(data + 28);
-    blockAlign  = *(short*)(data + 32);
-    bits        = *(short*)(data + 34);
-    waveSize    = *(int*)(data + 40);
-    data        = data + 44;
+    return true;
+}
+
+//
+// WavTest_Put16
+//
 
-    alGetError();
-    alGenBuffers(1, &buffer);
+static void WavTest_Put16(byte *data, const int value) {
+    data[0] = value & 0xff;
+    data[1] = (value >> 8) & 0xff;
+}
 
-    if(alGetError() != AL_NO_ERROR) {
-        common.Error("kexWavFile::Allocate: failed to create buffer for %s", name);
-    }
+//
+// WavTest_Put32
+//
 
-    alBufferData(buffer, GetFormat(), data, waveSize, samples);
+static void WavTest_Put32(byte *data, const int value) {
+    WavTest_Put16(data, value & 0xffff);
+    WavTest_Put16(data + 2, (value >> 16) & 0xffff);
 }
 
 //
-// kexWavFile::Delete
+// WavTest_Chunk
+//
+// Writes a chunk header and returns where its contents go
 //
 
-void kexWavFile::Delete(void) {
-    alDeleteBuffers(1, &buffer);
-    buffer = 0;
+static int WavTest_Chunk(byte *data, const int offset, const char *tag, const int size) {
+    memcpy(data + offset, tag, 4);
+    WavTest_Put32(data + offset + 4, size);
+    return offset + 8;
 }
 
 //
-// kexSoundSource::kexSoundSource
+// WavTest_Fmt
+//
+// Writes a fmt chunk 16, 18 or 40 bytes long. The extensible
+// form gets the format in its sub format instead
 //
 
-kexSoundSource::kexSoundSource(void) {
+static int WavTest_Fmt(byte *data, int offset, const int format, const int channels,
+                       const int rate, const int bits, const int size) {
+    offset = WavTest_Chunk(data, offset, "fmt ", size);
+    memset(data + offset, 0, size);
+
+    WavTest_Put16(data + offset, size == 40 ? WAVE_FORMAT_EXTENSIBLE : format);
+    WavTest_Put16(data + offset + 2, channels);
+    WavTest_Put32(data + offset + 4, rate);
+    WavTest_Put32(data + offset + 8, rate * channels * (bits / 8));
+    WavTest_Put16(data + offset + 12, channels * (bits / 8));
+    WavTest_Put16(data + offset + 14, bits);
+
+    if(size == 40) {
+        WavTest_Put16(data + offset + 16, 22);
+        WavTest_Put16(data + offset + 24, format);
+    }
+
+    return offset + size;
 }
 
 //
-// kexSoundSource::~kexSoundSource
+// WavTest_Riff
 //
 
-kexSoundSource::~kexSoundSource(void) {
+static int WavTest_Riff(byte *data) {
+    memcpy(data, "RIFF", 4);
+    memcpy(data + 8, "WAVE", 4);
+    return 12;
 }
 
 //
-// kexSoundSource::Generate
+// WavTest_Check
+//
+// Parses the file and compares what came out. A size of -1
+// expects it to be rejected
 //
 
-bool kexSoundSource::Generate(void) {
-    alGetError();
-    alGenSources(1, &handle);
+static bool WavTest_Check(const char *test, byte *data, const int size, const int fileSize,
+                          const int channels, const int bits, const int waveSize,
+                          const int dataOffset) {
+    kexWavFile wave;
+    bool bOk;
 
-    if(alGetError() != AL_NO_ERROR) {
-        return false;
+    WavTest_Put32(data + 4, (fileSize ? fileSize : size) - 8);
+
+    if(!wave.Parse(NULL, data, size, fileSize)) {
+        bOk = (waveSize == -1);
+    }
+    else {
+        bOk = (waveSize != -1 &&
+               wave.Channels() == channels &&
+               wave.Bits() == bits &&
+               wave.Rate() == 22050 &&
+               wave.Size() == waveSize &&
+               wave.DataOffset() == dataOffset &&
+               wave.BlockAlign() == channels * (bits / 8) &&
+               wave.Data() == (dataOffset + waveSize <= size ? data + dataOffset : NULL));
     }
 
-    startTime   = 0;
-    bInUse      = false;
-    bLooping    = false;
-    bPlaying    = false;
-    sfx         = NULL;
-    obj         = NULL;
-    volume      = 1.0f;
-
-    alSourcei(handle, AL_LOOPING, AL_FALSE);
-    alSourcei(handle, AL_SOURCE_RELATIVE, AL_TRUE);
-    alSourcef(handle, AL_GAIN, 1.0f);
-    alSourcef(handle, AL_PITCH, 1.0f);
-    return true;
+    if(!bOk) {
+        common.Printf(LC_SOUND, "%s: failed\n", test);
+    }
+
+    return bOk;
 }
 
 //
-// kexSoundSource::Set
+// testwavparse
+//
+// Feeds the parser hand built headers
 //
 
-void kexSoundSource::Set(sfx_t *sfxRef, kexGameObject *refObj) {
-    if(sfxRef == NULL) {
-        return;
+COMMAND(testwavparse) {
+    byte data[512];
+    bool bOk = true;
+    int offset;
+
+    memset(data, 0, sizeof(data));
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 100);
+    bOk &= WavTest_Check("16 bit mono", data, offset + 100, 0, 1, 16, 100, 44);
+
+    // chunks the parser doesn't care about, one of them odd sized
+    offset = WavTest_Chunk(data, WavTest_Riff(data), "LIST", 11);
+    offset = WavTest_Chunk(data, offset + 12, "fact", 4);
+    offset = WavTest_Fmt(data, offset + 4, WAVE_FORMAT_PCM, 2, 22050, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("extra chunks", data, offset + 64, 0, 2, 16, 64, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 2, 22050, 16, 40);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("extensible", data, offset + 64, 0, 2, 16, 64, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), 3, 2, 22050, 32, 40);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("extensible float", data, offset + 64, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), 3, 1, 22050, 32, 16);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("float", data, offset + 64, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), 2, 1, 22050, 4, 16);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("adpcm", data, offset + 64, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 24, 16);
+    offset = WavTest_Chunk(data, offset, "data", 60);
+    bOk &= WavTest_Check("24 bit", data, offset + 60, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 2, 22050, 8, 16);
+    offset = WavTest_Chunk(data, offset, "data", 63);
+    bOk &= WavTest_Check("8 bit stereo", data, offset + 64, 0, 2, 8, 62, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 16, 16);
+    bOk &= WavTest_Check("no data", data, offset, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Chunk(data, WavTest_Riff(data), "data", 64);
+    bOk &= WavTest_Check("no fmt", data, offset + 64, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Chunk(data, WavTest_Riff(data), "data", 64);
+    WavTest_Fmt(data, offset + 64, WAVE_FORMAT_PCM, 1, 22050, 16, 16);
+    bOk &= WavTest_Check("data first", data, offset + 64 + 24, 0, 1, 16, 64, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 4000);
+    bOk &= WavTest_Check("truncated", data, offset + 101, 0, 1, 16, 100, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 16, 16);
+    memcpy(data, "RIFX", 4);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("not riff", data, offset + 64, 0, 0, 0, -1, 0);
+    bOk &= WavTest_Check("too short", data, 8, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 22050, 16, 18);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("fmt size 18", data, offset + 64, 0, 1, 16, 64, offset);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 0, 22050, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("no channels", data, offset + 64, 0, 0, 0, -1, 0);
+
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 1, 0, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 64);
+    bOk &= WavTest_Check("no rate", data, offset + 64, 0, 0, 0, -1, 0);
+
+    // only the header was read, as it is for streamed waves
+    offset = WavTest_Fmt(data, WavTest_Riff(data), WAVE_FORMAT_PCM, 2, 22050, 16, 16);
+    offset = WavTest_Chunk(data, offset, "data", 1000000);
+    bOk &= WavTest_Check("header only", data, offset, offset + 1000000, 2, 16, 1000000, offset);
+
+    common.CPrintf(LC_SOUND, bOk ? COLOR_GREEN : COLOR_RED, "testwavparse %s\n", bOk ? "passed" : "failed");
+}
+
+//
+// kexWavFile::Allocate
+//
+
+void kexWavFile::Allocate(const char *name, byte *data, const int size) {
+    if(name != filePath) {
+        strcpy(filePath, name);
+    }
+
+    if(!Parse(name, data, size)) {
+        common.Error("kexWavFile::Allocate: couldn't load %s", name);
     }
 
-    sfx = sfxRef;
+    bStreamed = false;
 
-    if(refObj) {
-        refObj->AddRef();
+    soundSystem.Backend()->UploadWave(this);
+    residency.Register(&resident, RT_SOUND, this, size, Wav_Evict);
+}
+
+//
+// kexWavFile::AllocateStreamed
+//
+// Only reads far enough into the file to find the samples.
+// Streamed waves stay out of the residency lists since there's
+// nothing to evict
+//
+
+void kexWavFile::AllocateStreamed(const char *name) {
+    fileStream_t stream;
+    byte *header;
+    int size;
+
+    if(name != filePath) {
+        strcpy(filePath, name);
     }
 
-    if(sfx->bLerpVol) {
-        volume = sfx->gainLerpStart;
+    if(!fileSystem.OpenStream(name, &stream)) {
+        common.Error("kexWavFile::AllocateStreamed: couldn't open %s", name);
     }
 
-    if(sfx->bLerpFreq) {
-        pitch = sfx->freqLerpStart;
+    size = stream.size < SND_STREAM_HEADER_SIZE ? stream.size : SND_STREAM_HEADER_SIZE;
+    header = (byte*)Mem_Malloc(size, kexSoundSystem::hb_sound);
+    size = fileSystem.ReadStream(&stream, header, size);
+
+    if(!Parse(name, header, size, stream.size)) {
+        common.Error("kexWavFile::AllocateStreamed: couldn't load %s", name);
     }
 
-    obj = refObj;
+    fileSystem.CloseStream(&stream);
+
+    // only the samples are read from here on
+    data = NULL;
+    bStreamed = true;
 }
 
 //
-// kexSoundSource::Stop
+// kexWavFile::Delete
 //
 
-void kexSoundSource::Stop(void) {
-    alSourceStop(handle);
+void kexWavFile::Delete(void) {
+    soundSystem.Backend()->DeleteWave(this);
+}
+
+//
+// kexWavFile::Free
+//
+
+void kexWavFile::Free(void) {
+    Delete();
 
-    if(sfx && sfx->wavFile) {
-        alSourceUnqueueBuffers(handle, 1, sfx->wavFile->GetBuffer());
+    if(waveFile) {
+        Mem_Free(waveFile);
+        waveFile = NULL;
+        data = NULL;
     }
 }
 
 //
-// kexSoundSource::Free
+// kexWavFile::Touch
+//
+// Marks the wave as used by the current map, reading it back
+// in if it was evicted
 //
 
-void kexSoundSource::Free(void) {
-    bInUse      = false;
-    bPlaying    = false;
-    sfx         = NULL;
-    volume      = 1.0f;
-    pitch       = 1.0f;
-    startTime   = 0;
+void kexWavFile::Touch(void) {
+    byte *data;
+    int size;
+
+    if(!resident.bTracked) {
+        return;
+    }
 
-    if(obj) {
-        obj->RemoveRef();
-        obj = NULL;
+    if(resident.bResident) {
+        residency.Touch(&resident);
+        return;
+    }
+
+    if((size = fileSystem.OpenFile(filePath, &data, kexSoundSystem::hb_sound)) == 0) {
+        common.Warning(LC_SOUND, "kexWavFile::Touch: couldn't reload %s\n", filePath);
+        return;
     }
 
-    alSource3f(handle, AL_POSITION, 0, 0, 0);
+    Allocate(filePath, data, size);
 }
 
 //
-// kexSoundSource::Delete
+// kexWavFile::Duration
+//
+// Length in ms at normal pitch
 //
 
-void kexSoundSource::Delete(void) {
-    if(bPlaying) {
-        Free();
+const int kexWavFile::Duration(void) const {
+    if(bytes <= 0) {
+        return 0;
     }
 
-    Stop();
+    return (int)(((int64_t)waveSize * 1000) / bytes);
+}
+
+//
+// kexSoundSource::kexSoundSource
+//
 
-    alSourcei(handle, AL_BUFFER, 0);
-    alDeleteSources(1, &handle);
+kexSoundSource::kexSoundSource(void) {
+    this->channel   = 0;
+    this->bInUse    = false;
+    this->bPlaying  = false;
+    this->voice     = NULL;
+    this->stream    = NULL;
+    this->serial    = 0;
+}
 
-    handle = 0;
+//
+// kexSoundSource::~kexSoundSource
+//
+
+kexSoundSource::~kexSoundSource(void) {
+}
+
+//
+// kexSoundSource::SetChannel
+//
+
+void kexSoundSource::SetChannel(const int index) {
+    channel     = index;
+    bInUse      = false;
+    bPlaying    = false;
+    voice       = NULL;
+    stream      = NULL;
+    serial      = 0;
 }
 
 //
-// kexSoundSource::Reset
+// kexSoundSource::Bind
 //
 
-void kexSoundSource::Reset(void) {
-    startTime   = kexSoundSystem::time;
+void kexSoundSource::Bind(sndVoice_t *sndVoice) {
+    voice       = sndVoice;
+    serial      = sndVoice->serial;
     bInUse      = true;
     bPlaying    = false;
-    volume      = 1.0f;
-    pitch       = 1.0f;
+}
+
+//
+// kexSoundSource::Stop
+//
+
+void kexSoundSource::Stop(void) {
+    soundSystem.Backend()->StopChannel(channel);
+
+    if(stream) {
+        stream->Close();
+        stream = NULL;
+    }
+}
+
+//
+// kexSoundSource::Free
+//
+
+void kexSoundSource::Free(void) {
+    bInUse      = false;
+    bPlaying    = false;
+    voice       = NULL;
+    serial      = 0;
+}
+
+//
+// kexSoundSource::GetParams
+//
+
+void kexSoundSource::GetParams(sndParams_t *params) {
+    sfx_t *sfx = voice->sfx;
+
+    params->wave            = sfx->wavFile;
+    params->stream          = stream;
+    params->origin          = voice->origin;
+    params->bLocal          = voice->bLocal;
+    params->gain            = sfx->gain * voice->volume * cvarSoundVolume.GetFloat();
+    params->pitch           = 1.0f;
+    params->rolloffFactor   = sfx->rolloffFactor;
+
+    if(cvarPitchShift.GetBool()) {
+        params->pitch = sfx->bLerpFreq ? voice->pitch : sfx->dbFreq;
+    }
 }
 
 //
 // kexSoundSource::Play
 //
+// Starts the bound voice from wherever it would have been
+// if it had been heard all along. Returns false if there's
+// nothing left of it to play
+//
 
-void kexSoundSource::Play(void) {
-    float time;
+bool kexSoundSource::Play(void) {
+    sfx_t *sfx = voice->sfx;
     kexWavFile *wave = sfx->wavFile;
+    sndParams_t params;
+    float offset;
 
-    time = (float)startTime + SND_INT2TIME(sfx->delay);
+    // reads the wave back in if it was evicted while the voice was virtual
+    wave->Touch();
 
-    if(time > kexSoundSystem::time) {
-        return;
+    if(!wave->IsResident()) {
+        return false;
     }
 
-    alSourceQueueBuffers(handle, 1, wave->GetBuffer());
+    offset = (float)(kexSoundSystem::time - voice->startTime) / 1000.0f;
 
-    if(cvarPitchShift.GetBool()) {
-        alSourcef(handle, AL_PITCH, sfx->dbFreq);
+    if(offset > 0 && cvarPitchShift.GetBool() && sfx->dbFreq > 0) {
+        offset *= sfx->dbFreq;
     }
 
-    if(obj && obj != gameManager.localPlayer.Puppet()) {
-        kexVec3 org = obj->GetOrigin();
-        alSourcef(handle, AL_ROLLOFF_FACTOR, sfx->rolloffFactor);
-        alSourcei(handle, AL_SOURCE_RELATIVE, AL_FALSE);
-        alSource3f(handle, AL_POSITION, SND_VECTOR2METRICS(org));
+    if(offset * 1000.0f >= (float)wave->Duration()) {
+        return false;
     }
-    else {
-        alSourcei(handle, AL_SOURCE_RELATIVE, AL_TRUE);
+
+    if(wave->IsStreamed()) {
+        int frame = offset > 0 ? (int)(offset * (float)wave->Rate()) : 0;
+
+        // the stream starts where the voice is
+        if(!(stream = soundSystem.Streamer().Open(wave, frame * wave->BlockAlign()))) {
+            return false;
+        }
+
+        offset = 0;
     }
 
-    alSourcef(handle, AL_GAIN, sfx->gain * volume * cvarSoundVolume.GetFloat());
-    alSourcePlay(handle);
+    GetParams(&params);
 
-    bPlaying = true;
-    startTime = kexSoundSystem::time;
+    bPlaying = soundSystem.Backend()->StartChannel(channel, params, offset);
+    return bPlaying;
 }
 
 //
 // kexSoundSource::Update
 //
+// Returns false once the voice has played out
+//
+
+bool kexSoundSource::Update(void) {
+    sndParams_t params;
 
-void kexSoundSource::Update(void) {
     if(!bInUse) {
-        return;
+        return true;
     }
 
-    if(sfx != NULL) {
-        if(!bPlaying) {
-            Play();
-        }
-        else {
-            ALint state;
-
-            alGetSourcei(handle, AL_SOURCE_STATE, &state);
-            if(state != AL_PLAYING) {
-                Stop();
-                Free();
-            }
-            else {
-                if(sfx->bLerpVol && bPlaying) {
-                    float time = (float)startTime + SND_INT2TIME(sfx->gainLerpDelay);
-
-                    if(time <= kexSoundSystem::time) {
-                        float volLerp = (float)sfx->gainLerpTime / 60.0f;
-                        volume = (sfx->gainLerpEnd - volume) * volLerp + volume;
-
-                        if(volume > 1) volume = 1;
-                        if(volume < 0.01f) {
-                            Stop();
-                            Free();
-                            return;
-                        }
-
-                        alSourcef(handle, AL_GAIN, sfx->gain * volume * cvarSoundVolume.GetFloat());
-                    }
-                }
-
-                if(sfx->bLerpFreq && bPlaying && cvarPitchShift.GetBool()) {
-                    float time = (float)startTime + SND_INT2TIME(sfx->freqLerpDelay);
-
-                    if(time <= kexSoundSystem::time) {
-                        float freqLerp = (float)sfx->freqLerpTime / 60.0f;
-                        pitch = (sfx->freqLerpEnd - pitch) * freqLerp + pitch;
-
-                        alSourcef(handle, AL_PITCH, pitch);
-                    }
-                }
-            }
-        }
+    if(!bPlaying) {
+        return Play();
     }
+
+    GetParams(&params);
+    return soundSystem.Backend()->UpdateChannel(channel, params);
 }
 
 int kexSoundSystem::time = 0;
@@ -419,6 +739,8 @@ int kexSoundSystem::time = 0;
 //
 
 kexSoundSystem::kexSoundSystem(void) {
+    this->backend       = NULL;
+    this->activeSources = 0;
 }
 
 //
@@ -433,35 +755,36 @@ kexSoundSystem::~kexSoundSystem(void) {
 //
 
 void kexSoundSystem::Init(void) {
-    int i;
+    const char *driver = cvarSoundDriver.GetValue();
 
-    alDevice = alcOpenDevice(NULL);
-    if(!alDevice) {
-        common.Error("kexSoundSystem::Init: Failed to create OpenAL device");
-    }
+    backend = NULL;
 
-    alContext = alcCreateContext(alDevice, NULL);
-    if(!alContext) {
-        common.Error("kexSoundSystem::Init: Failed to create OpenAL context");
-    }
+    if(!strcmp(driver, "wav")) {
+        wavSink.SetFile(cvarSoundWavFile.GetValue());
+        soundMixer.SetOutput(&wavSink, cvarSoundMixRate.GetInt());
 
-    if(!alcMakeContextCurrent(alContext)) {
-        common.Error("kexSoundSystem::Init: Failed to set current context");
+        if(soundMixer.Init()) {
+            backend = &soundMixer;
+        }
+    }
+    else if(strcmp(driver, "null") && soundOpenAL.Init()) {
+        backend = &soundOpenAL;
     }
 
-    for(i = 0; i < SND_MAX_SOURCES; i++) {
-        kexSoundSource *sndSrc = &sources[activeSources];
-
-        if(sndSrc->Generate() == false) {
-            break;
+    if(backend == NULL) {
+        if(strcmp(driver, "null")) {
+            common.Warning(LC_SOUND, "kexSoundSystem::Init: No sound output, mixing to nothing\n");
         }
 
-        activeSources++;
+        soundMixer.SetOutput(&nullSink, cvarSoundMixRate.GetInt());
+        soundMixer.Init();
+        backend = &soundMixer;
     }
 
-    alListener3f(AL_POSITION, 0, 0, 0);
+    SetBackend(backend);
+    streamer.Init();
 
-    common.Printf("Sound System Initialized (%s)\n", GetDeviceName());
+    common.Printf(LC_SOUND, "Sound System Initialized (%s)\n", GetDeviceName());
 }
 
 //
@@ -469,34 +792,56 @@ void kexSoundSystem::Init(void) {
 //
 
 void kexSoundSystem::Shutdown(void) {
-    int i;
     kexWavFile *wavFile;
 
-    common.Printf("Shutting down audio\n");
+    common.Printf(LC_SOUND, "Shutting down audio\n");
 
-    for(i = 0; i < activeSources; i++) {
-        sources[i].Delete();
-    }
+    StopAll();
+    streamer.Shutdown();
 
-    for(i = 0; i < MAX_HASH; i++) {
-        for(wavFile = wavList.GetData(i); wavFile; wavFile = wavList.Next()) {
-            wavFile->Delete();
-        }
+    for(wavFile = wavList.First(); wavFile; wavFile = wavList.Next()) {
+        wavFile->Delete();
     }
 
-    alcMakeContextCurrent(NULL);
-    alcDestroyContext(alContext);
-    alcCloseDevice(alDevice);
+    backend->Shutdown();
 
     Mem_Purge(kexSoundSystem::hb_sound);
 }
 
+//
+// kexSoundSystem::SetBackend
+//
+// Moves the sources over to another backend, which must already
+// be up. Everything playing is stopped. Returns the old backend
+//
+
+kexSoundBackend *kexSoundSystem::SetBackend(kexSoundBackend *newBackend) {
+    kexSoundBackend *oldBackend = backend;
+
+    if(activeSources > 0) {
+        StopAll();
+    }
+
+    backend = newBackend;
+    activeSources = backend->NumChannels();
+
+    if(activeSources > SND_MAX_SOURCES) {
+        activeSources = SND_MAX_SOURCES;
+    }
+
+    for(int i = 0; i < activeSources; i++) {
+        sources[i].SetChannel(i);
+    }
+
+    return oldBackend;
+}
+
 //
 // kexSoundSystem::GetDeviceName
 //
 
-char *kexSoundSystem::GetDeviceName(void) {
-    return (char*)alcGetString(alDevice, ALC_DEVICE_SPECIFIER);
+const char *kexSoundSystem::GetDeviceName(void) {
+    return backend->GetDeviceName();
 }
 
 //
@@ -508,6 +853,34 @@ void kexSoundSystem::StopAll(void) {
         sources[i].Stop();
         sources[i].Free();
     }
+
+    voices.StopAll();
+}
+
+//
+// kexSoundSystem::Attenuation
+//
+// Inverse distance clamped with a reference distance of one,
+// the model OpenAL uses by default. Distance is in meters
+//
+
+float kexSoundSystem::Attenuation(const float dist, const float rolloff) {
+    if(dist <= 1) {
+        return 1;
+    }
+
+    return 1 / (1 + rolloff * (dist - 1));
+}
+
+//
+// kexSoundSystem::ShouldStream
+//
+// Safe to call from any thread
+//
+
+bool kexSoundSystem::ShouldStream(const int size) {
+    int streamSize = cvarSoundStreamSize.GetInt();
+    return (streamSize > 0 && size > streamSize);
 }
 
 //
@@ -515,8 +888,9 @@ void kexSoundSystem::StopAll(void) {
 //
 
 void kexSoundSystem::UpdateListener(void) {
-    ALfloat orientation[6];
     kexVec3 org;
+    kexVec3 forward;
+    kexVec3 up;
 
     if(localWorld.IsLoaded() == false) {
         return;
@@ -524,24 +898,113 @@ void kexSoundSystem::UpdateListener(void) {
 
     kexCamera *camera = localWorld.Camera();
     kexMatrix matrix = camera->ModelView();
-    
-    orientation[0] = -matrix.vectors[0].z;
-    orientation[1] = -matrix.vectors[1].z;
-    orientation[2] = -matrix.vectors[2].z;
-    orientation[3] =  matrix.vectors[0].y;
-    orientation[4] =  matrix.vectors[1].y;
-    orientation[5] =  matrix.vectors[2].y;
+
+    forward.Set(-matrix.vectors[0].z, -matrix.vectors[1].z, -matrix.vectors[2].z);
+    up.Set(matrix.vectors[0].y, matrix.vectors[1].y, matrix.vectors[2].y);
 
     org = camera->GetOrigin();
 
-    alListenerfv(AL_ORIENTATION, orientation);
-    alListener3f(AL_POSITION, SND_VECTOR2METRICS(org));
+    Update(org, forward, up);
+
+    kexSoundSystem::time = client.GetTime();
+}
+
+//
+// kexSoundSystem::Update
+//
+
+void kexSoundSystem::Update(const kexVec3 &origin, const kexVec3 &forward, const kexVec3 &up) {
+    backend->SetListener(origin, forward, up);
+
+    voices.Update(origin, kexSoundSystem::time, activeSources);
+    UpdateSources();
+
+    backend->Update(kexSoundSystem::time);
+}
+
+//
+// kexSoundSystem::UpdateSources
+//
+// Hands the sources over to whichever voices the scheduler
+// picked. Voices that lose their source carry on virtually
+//
+
+void kexSoundSystem::UpdateSources(void) {
+    kexSoundSource *src;
+    sndVoice_t *voice;
+    int i;
+
+    // let go of the voices that ranked out first so their
+    // sources are free for the ones that ranked in
+    for(i = 0; i < activeSources; i++) {
+        src = &sources[i];
+
+        if(!src->InUse()) {
+            continue;
+        }
+
+        voice = src->GetVoice();
+
+        if(!voice->bActive || voice->serial != src->Serial()) {
+            // stopped or stolen
+            src->Stop();
+            src->Free();
+            continue;
+        }
 
-    for(int i = 0; i < soundSystem.GetNumActiveSources(); i++) {
-        soundSystem.GetSources()[i].Update();
+        if(!voice->bWantSource) {
+            voice->source = -1;
+            src->Stop();
+            src->Free();
+        }
     }
 
-    kexSoundSystem::time = client.GetTime();
+    for(i = 0; i < SND_MAX_VOICES; i++) {
+        voice = &voices.GetVoices()[i];
+
+        if(!voice->bActive || !voice->bWantSource || voice->source != -1) {
+            continue;
+        }
+
+        if(!(src = GetAvailableSource())) {
+            break;
+        }
+
+        src->Bind(voice);
+        voice->source = (int)(src - sources);
+    }
+
+    for(i = 0; i < activeSources; i++) {
+        src = &sources[i];
+
+        if(!src->InUse()) {
+            continue;
+        }
+
+        if(!src->Update()) {
+            voice = src->GetVoice();
+
+            src->Stop();
+            src->Free();
+            voices.Stop(voice);
+            voice->source = -1;
+        }
+    }
+}
+
+//
+// kexSoundSystem::StartVoice
+//
+
+void kexSoundSystem::StartVoice(kexSoundShader *shader, sfx_t *sfx, kexGameObject *obj) {
+    bool bLocal = (obj == NULL || obj == gameManager.localPlayer.Puppet());
+    int duration = sfx->wavFile->Duration();
+
+    if(cvarPitchShift.GetBool() && sfx->dbFreq > 0) {
+        duration = (int)((float)duration / sfx->dbFreq);
+    }
+
+    voices.Start(shader, sfx, obj, bLocal, kexSoundSystem::time, duration);
 }
 
 //
@@ -560,7 +1023,6 @@ kexSoundSource *kexSoundSystem::GetAvailableSource(void) {
         }
 
         src = sndSrc;
-        src->Reset();
         break;
     }
 
@@ -572,15 +1034,7 @@ kexSoundSource *kexSoundSystem::GetAvailableSource(void) {
 //
 
 bool kexSoundSystem::HasSource(const kexGameObject *obj) {
-    for(int i = 0; i < activeSources; i++) {
-        kexSoundSource *sndSrc = &sources[i];
-
-        if(sndSrc->obj == obj) {
-            return true;
-        }
-    }
-
-    return false;
+    return voices.HasVoice(obj);
 }
 
 //
@@ -592,13 +1046,23 @@ kexWavFile *kexSoundSystem::CacheWavFile(const char *name) {
 
     if(!(wavFile = wavList.Find(name))) {
         byte *data;
+        int size;
+
+        if(ShouldStream(fileSystem.GetFileSize(name))) {
+            wavFile = wavList.Add(name, kexSoundSystem::hb_sound);
+            wavFile->AllocateStreamed(name);
+            return wavFile;
+        }
 
-        if(fileSystem.OpenFile(name, &data, kexSoundSystem::hb_sound) == 0) {
+        if((size = fileSystem.OpenFile(name, &data, kexSoundSystem::hb_sound)) == 0) {
             return NULL;
         }
 
         wavFile = wavList.Add(name, kexSoundSystem::hb_sound);
-        wavFile->Allocate(name, data);
+        wavFile->Allocate(name, data, size);
+    }
+    else {
+        wavFile->Touch();
     }
 
     return wavFile;
@@ -626,6 +1090,11 @@ kexSoundShader *kexSoundSystem::CacheShaderFile(const char *name) {
         snd->Load(lexer);
         parser.Close();
     }
+    else {
+        // the waves are only touched when they play otherwise, so a
+        // shader looked up during a map load would lose them
+        snd->Touch();
+    }
 
     return snd;
 }
@@ -0,0 +1,672 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright(C) 2014 Samuel Villarreal
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION: Virtual voices
+//
+// Every started sound gets a voice. Each update the voices are ranked by
+// their shader's priority and then by how loud they'd be at the listener,
+// and only as many as there are sources are asked to be heard. Voices
+// that drop out keep running silently until they finish or rank back in.
+//
+//-----------------------------------------------------------------------------
+
+#include "common.h"
+#include "sound.h"
+
+#define SND_MIN_AUDIBILITY  0.001f
+#define SND_KEEP_BONUS      1.25f   // voices already heard hold on to their sources
+
+//
+// kexSoundEnvelope::Set
+//
+// A decay of zero has the attack go straight to end
+//
+
+void kexSoundEnvelope::Set(const float start, const float peak, const float end,
+                           const float delay, const float attack, const float decay,
+                           const float rate) {
+    this->start     = start;
+    this->peak      = decay > 0 ? peak : end;
+    this->end       = end;
+    this->delay     = delay > 0 ? delay : 0;
+    this->attack    = attack > 0 ? attack : 0;
+    this->decay     = decay > 0 ? decay : 0;
+    this->rate      = rate < 0 ? 0 : (rate > 1 ? 1 : rate);
+}
+
+//
+// kexSoundEnvelope::Evaluate
+//
+
+float kexSoundEnvelope::Evaluate(const float elapsed) const {
+    float t = elapsed - delay;
+
+    if(t <= 0) {
+        return start;
+    }
+
+    if(attack <= 0 && decay <= 0) {
+        if(rate >= 1) {
+            return end;
+        }
+
+        // what the old lerp reached after this many 60ths
+        return end + (start - end) * kexMath::Pow(1.0f - rate, t * (60.0f / 1000.0f));
+    }
+
+    if(t < attack) {
+        return start + (peak - start) * (t / attack);
+    }
+
+    t -= attack;
+
+    if(t < decay) {
+        return peak + (end - peak) * (t / decay);
+    }
+
+    return end;
+}
+
+//
+// kexSoundEnvelope::Finished
+//
+// True once the envelope has settled on its end value
+//
+
+bool kexSoundEnvelope::Finished(const float elapsed) const {
+    if(attack <= 0 && decay <= 0) {
+        return elapsed > delay && kexMath::Fabs(Evaluate(elapsed) - end) < SND_ENVELOPE_EPSILON;
+    }
+
+    return elapsed >= delay + attack + decay;
+}
+
+//
+// kexVoiceScheduler::kexVoiceScheduler
+//
+
+kexVoiceScheduler::kexVoiceScheduler(void) {
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        sndVoice_t *voice = &voices[i];
+
+        voice->shader       = NULL;
+        voice->sfx          = NULL;
+        voice->obj          = NULL;
+        voice->bActive      = false;
+        voice->bLocal       = false;
+        voice->bWantSource  = false;
+        voice->source       = -1;
+        voice->priority     = 0;
+        voice->startTime    = 0;
+        voice->endTime      = 0;
+        voice->volume       = 0;
+        voice->pitch        = 0;
+        voice->audibility   = 0;
+        voice->serial       = 0;
+
+        voice->origin.Clear();
+    }
+
+    numActive = 0;
+    serial = 0;
+}
+
+//
+// kexVoiceScheduler::AllocVoice
+//
+// Takes a free voice, or steals the weakest one if the new voice
+// outranks it. Returns NULL if everything playing is more important
+//
+
+sndVoice_t *kexVoiceScheduler::AllocVoice(const int priority) {
+    sndVoice_t *weakest = NULL;
+
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        sndVoice_t *voice = &voices[i];
+
+        if(!voice->bActive) {
+            return voice;
+        }
+
+        if(weakest == NULL ||
+            voice->priority < weakest->priority ||
+            (voice->priority == weakest->priority && voice->audibility < weakest->audibility)) {
+            weakest = voice;
+        }
+    }
+
+    if(weakest->priority > priority) {
+        return NULL;
+    }
+
+    Stop(weakest);
+    return weakest;
+}
+
+//
+// kexVoiceScheduler::Start
+//
+// Duration is in ms, zero if the voice should only end when
+// its source does
+//
+
+sndVoice_t *kexVoiceScheduler::Start(kexSoundShader *shader, sfx_t *sfx, kexGameObject *obj,
+                                     const bool bLocal, const int time, const int duration) {
+    sndVoice_t *voice;
+    int priority = shader ? shader->priority : 0;
+
+    if(shader && shader->maxInstances > 0 && shader->numVoices >= shader->maxInstances) {
+        sndVoice_t *oldest = NULL;
+
+        // the oldest instance makes way for the new one
+        for(int i = 0; i < SND_MAX_VOICES; i++) {
+            if(voices[i].bActive && voices[i].shader == shader &&
+                (oldest == NULL || voices[i].serial < oldest->serial)) {
+                oldest = &voices[i];
+            }
+        }
+
+        if(oldest) {
+            Stop(oldest);
+        }
+    }
+
+    if(!(voice = AllocVoice(priority))) {
+        return NULL;
+    }
+
+    voice->shader       = shader;
+    voice->sfx          = sfx;
+    voice->obj          = obj;
+    voice->bActive      = true;
+    voice->bLocal       = bLocal;
+    voice->bWantSource  = false;
+    voice->source       = -1;
+    voice->priority     = priority;
+    voice->startTime    = time + (int)SND_INT2TIME(sfx->delay);
+    voice->endTime      = duration > 0 ? voice->startTime + duration : 0;
+    voice->volume       = sfx->bLerpVol ? sfx->gainEnvelope.Start() : 1.0f;
+    voice->pitch        = sfx->bLerpFreq ? sfx->freqEnvelope.Start() : 1.0f;
+    voice->audibility   = 0;
+    voice->serial       = ++serial;
+
+    if(obj) {
+        obj->AddRef();
+        voice->origin = obj->GetOrigin();
+    }
+    else {
+        voice->origin.Clear();
+    }
+
+    if(shader) {
+        shader->numVoices++;
+    }
+
+    numActive++;
+    return voice;
+}
+
+//
+// kexVoiceScheduler::Stop
+//
+
+void kexVoiceScheduler::Stop(sndVoice_t *voice) {
+    if(!voice->bActive) {
+        return;
+    }
+
+    if(voice->shader) {
+        voice->shader->numVoices--;
+    }
+
+    if(voice->obj) {
+        voice->obj->RemoveRef();
+        voice->obj = NULL;
+    }
+
+    voice->bActive = false;
+    voice->bWantSource = false;
+    numActive--;
+}
+
+//
+// kexVoiceScheduler::StopAll
+//
+
+void kexVoiceScheduler::StopAll(void) {
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        Stop(&voices[i]);
+        voices[i].source = -1;
+    }
+}
+
+//
+// kexVoiceScheduler::HasVoice
+//
+
+bool kexVoiceScheduler::HasVoice(const kexGameObject *obj) const {
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        if(voices[i].bActive && voices[i].obj == obj) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// kexVoiceScheduler::NumVirtual
+//
+
+int kexVoiceScheduler::NumVirtual(void) const {
+    int count = 0;
+
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        if(voices[i].bActive && voices[i].source == -1) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//
+// kexVoiceScheduler::UpdateEnvelopes
+//
+
+void kexVoiceScheduler::UpdateEnvelopes(sndVoice_t *voice, const int time) {
+    sfx_t *sfx = voice->sfx;
+    float elapsed = (float)(time - voice->startTime);
+
+    if(sfx->bLerpVol) {
+        voice->volume = sfx->gainEnvelope.Evaluate(elapsed);
+
+        if(voice->volume > 1) {
+            voice->volume = 1;
+        }
+    }
+
+    if(sfx->bLerpFreq) {
+        voice->pitch = sfx->freqEnvelope.Evaluate(elapsed);
+    }
+}
+
+//
+// kexVoiceScheduler::Audibility
+//
+// Gain at the listener, using the same inverse distance
+// rolloff the sources are played with
+//
+
+float kexVoiceScheduler::Audibility(sndVoice_t *voice, const kexVec3 &listener) {
+    float gain = voice->sfx->gain * voice->volume;
+
+    if(voice->bLocal) {
+        return gain;
+    }
+
+    return gain * kexSoundSystem::Attenuation(voice->origin.Distance(listener) * SND_METRICS,
+                                              voice->sfx->rolloffFactor);
+}
+
+//
+// kexVoiceScheduler::SortVoices
+//
+
+int kexVoiceScheduler::SortVoices(const void *a, const void *b) {
+    const sndVoice_t *va = *(const sndVoice_t**)a;
+    const sndVoice_t *vb = *(const sndVoice_t**)b;
+    float aa, ab;
+
+    if(va->priority != vb->priority) {
+        return vb->priority - va->priority;
+    }
+
+    aa = va->audibility * (va->source != -1 ? SND_KEEP_BONUS : 1);
+    ab = vb->audibility * (vb->source != -1 ? SND_KEEP_BONUS : 1);
+
+    if(aa != ab) {
+        return aa < ab ? 1 : -1;
+    }
+
+    // newest first
+    return va->serial < vb->serial ? 1 : -1;
+}
+
+//
+// kexVoiceScheduler::Update
+//
+// Ends voices that have run out, then flags the numSources best
+// voices that have started as wanting a source
+//
+
+void kexVoiceScheduler::Update(const kexVec3 &listener, const int time, const int numSources) {
+    int numRanked = 0;
+
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        sndVoice_t *voice = &voices[i];
+
+        if(!voice->bActive) {
+            continue;
+        }
+
+        voice->bWantSource = false;
+
+        // voices with a source end when the source does
+        if(voice->source == -1 && voice->endTime && time >= voice->endTime) {
+            Stop(voice);
+            continue;
+        }
+
+        if(voice->startTime > time) {
+            continue;
+        }
+
+        UpdateEnvelopes(voice, time);
+
+        // faded out for good
+        if(voice->sfx->bLerpVol && voice->volume < SND_ENVELOPE_EPSILON &&
+            voice->sfx->gainEnvelope.Finished((float)(time - voice->startTime))) {
+            Stop(voice);
+            continue;
+        }
+
+        if(voice->obj && !voice->bLocal) {
+            voice->origin = voice->obj->GetOrigin();
+        }
+
+        voice->audibility = Audibility(voice, listener);
+
+        if(voice->audibility > SND_MIN_AUDIBILITY) {
+            ranked[numRanked++] = voice;
+        }
+    }
+
+    qsort(ranked, numRanked, sizeof(sndVoice_t*), kexVoiceScheduler::SortVoices);
+
+    for(int i = 0; i < numRanked && i < numSources; i++) {
+        ranked[i]->bWantSource = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+// tests
+//
+//-----------------------------------------------------------------------------
+
+//
+// Voice_Bind
+//
+// Stands in for the sound system, binding voices to make
+// believe sources as the scheduler asks
+//
+
+static void Voice_Bind(kexVoiceScheduler &scheduler) {
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        sndVoice_t *voice = &scheduler.GetVoices()[i];
+        voice->source = (voice->bActive && voice->bWantSource) ? 0 : -1;
+    }
+}
+
+//
+// Voice_StartAt
+//
+
+static sndVoice_t *Voice_StartAt(kexVoiceScheduler &scheduler, kexSoundShader *shader,
+                                 sfx_t *sfx, const float x, const int time, const int duration) {
+    sndVoice_t *voice = scheduler.Start(shader, sfx, NULL, false, time, duration);
+
+    if(voice) {
+        voice->origin.Set(x, 0, 0);
+    }
+
+    return voice;
+}
+
+//
+// testsoundvoices
+//
+// Runs the scheduler without a sound device
+//
+
+COMMAND(testsoundvoices) {
+    kexVoiceScheduler *scheduler = new kexVoiceScheduler;
+    kexSoundShader impact;
+    kexSoundShader boss;
+    kexSoundShader shots;
+    sfx_t sfx;
+    sndVoice_t *near[6];
+    sndVoice_t *cue;
+    sndVoice_t *v[3];
+    kexVec3 listener(0, 0, 0);
+    bool bOk = true;
+    int count;
+
+    memset(&sfx, 0, sizeof(sfx_t));
+    sfx.gain = 1;
+    sfx.rolloffFactor = 8;
+
+    boss.priority = 5;
+    shots.maxInstances = 2;
+    shots.cooldown = 100;
+
+    // the closest voices get the four sources
+    for(int i = 0; i < 6; i++) {
+        near[i] = Voice_StartAt(*scheduler, &impact, &sfx, 100.0f * (i + 1), 0, 0);
+    }
+
+    scheduler->Update(listener, 0, 4);
+    Voice_Bind(*scheduler);
+
+    for(int i = 0; i < 6; i++) {
+        if(near[i]->bWantSource != (i < 4)) {
+            bOk = false;
+        }
+    }
+
+    // a far away cue outranks all of them and takes the farthest's source
+    cue = Voice_StartAt(*scheduler, &boss, &sfx, 4000, 0, 0);
+    scheduler->Update(listener, 16, 4);
+    Voice_Bind(*scheduler);
+
+    if(!cue->bWantSource || near[3]->bWantSource || !near[2]->bWantSource) {
+        bOk = false;
+    }
+
+    // which gets it back once the cue is done
+    scheduler->Stop(cue);
+    scheduler->Update(listener, 32, 4);
+    Voice_Bind(*scheduler);
+
+    if(!near[3]->bWantSource || near[4]->bWantSource) {
+        bOk = false;
+    }
+
+    // virtual voices run out on their own
+    v[0] = Voice_StartAt(*scheduler, &impact, &sfx, 10000, 32, 500);
+    scheduler->Update(listener, 100, 4);
+    Voice_Bind(*scheduler);
+
+    if(!v[0]->bActive || v[0]->source != -1) {
+        bOk = false;
+    }
+
+    scheduler->Update(listener, 600, 4);
+
+    if(v[0]->bActive) {
+        bOk = false;
+    }
+
+    scheduler->StopAll();
+
+    // instance limit keeps the newest
+    for(int i = 0; i < 3; i++) {
+        v[i] = Voice_StartAt(*scheduler, &shots, &sfx, 0, 0, 0);
+    }
+
+    count = 0;
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        if(scheduler->GetVoices()[i].bActive && scheduler->GetVoices()[i].shader == &shots) {
+            count++;
+        }
+    }
+
+    if(count != 2 || !v[1]->bActive || !v[2]->bActive) {
+        bOk = false;
+    }
+
+    // cooldown
+    if(!shots.CheckCooldown(1000) || shots.CheckCooldown(1050) || !shots.CheckCooldown(1100)) {
+        bOk = false;
+    }
+
+    scheduler->StopAll();
+
+    // a full pool drops less important voices and steals for more important ones
+    for(int i = 0; i < SND_MAX_VOICES; i++) {
+        Voice_StartAt(*scheduler, &boss, &sfx, 100, 0, 0);
+    }
+
+    if(Voice_StartAt(*scheduler, &impact, &sfx, 0, 0, 0) != NULL ||
+        Voice_StartAt(*scheduler, &boss, &sfx, 0, 0, 0) == NULL ||
+        scheduler->NumActive() != SND_MAX_VOICES) {
+        bOk = false;
+    }
+
+    scheduler->StopAll();
+
+    if(scheduler->NumActive() != 0 || scheduler->HasVoice(NULL)) {
+        bOk = false;
+    }
+
+    delete scheduler;
+
+    common.CPrintf(LC_SOUND, bOk ? COLOR_GREEN : COLOR_RED, "testsoundvoices %s\n",
+        bOk ? "passed" : "failed");
+}
+
+//
+// Envelope_Run
+//
+// Updates a voice from start to finish at the given rate, taking
+// its volume and pitch every 100ms. Returns how many were taken
+// before the voice ended
+//
+
+static int Envelope_Run(sfx_t *sfx, const int hz, float *volume, float *pitch, const int count) {
+    kexVoiceScheduler *scheduler = new kexVoiceScheduler;
+    kexSoundShader shader;
+    kexVec3 listener(0, 0, 0);
+    sndVoice_t *voice;
+    int next = 0;
+    int time;
+
+    voice = scheduler->Start(&shader, sfx, NULL, true, 0, 0);
+
+    for(int i = 0; next < count; i++) {
+        time = (i * 1000) / hz;
+        scheduler->Update(listener, time, 1);
+
+        if(!voice->bActive) {
+            break;
+        }
+
+        if(time >= next * 100) {
+            volume[next] = voice->volume;
+            pitch[next] = voice->pitch;
+            next++;
+        }
+    }
+
+    delete scheduler;
+    return next;
+}
+
+//
+// testsoundenvelopes
+//
+
+COMMAND(testsoundenvelopes) {
+    float volumeA[40], pitchA[40];
+    float volumeB[40], pitchB[40];
+    float lerped;
+    sfx_t sfx;
+    bool bOk = true;
+    int countA, countB;
+
+    memset(&sfx, 0, sizeof(sfx_t));
+    sfx.gain = 1;
+
+    // half a second in, fade up over a quarter second, then out over one
+    // and a half to a fifth. the pitch eases up to double the old way
+    sfx.bLerpVol = true;
+    sfx.bLerpFreq = true;
+    sfx.gainEnvelope.Set(0, 1, 0.2f, 500, 250, 1500, 0);
+    sfx.freqEnvelope.Set(1, 1, 2, 200, 0, 0, 3.0f / 60.0f);
+
+    countA = Envelope_Run(&sfx, 30, volumeA, pitchA, 40);
+    countB = Envelope_Run(&sfx, 240, volumeB, pitchB, 40);
+
+    if(countA != 40 || countB != 40) {
+        bOk = false;
+    }
+
+    for(int i = 0; i < 40; i++) {
+        if(kexMath::Fabs(volumeA[i] - volumeB[i]) > 0.0001f ||
+            kexMath::Fabs(pitchA[i] - pitchB[i]) > 0.0001f) {
+            common.Printf(LC_SOUND, "%ims: %f %f at 30hz, %f %f at 240hz\n", i * 100,
+                volumeA[i], pitchA[i], volumeB[i], pitchB[i]);
+            bOk = false;
+        }
+    }
+
+    // the stages land where they should
+    if(volumeA[5] != 0 || kexMath::Fabs(volumeA[7] - 0.8f) > 0.0001f ||
+        kexMath::Fabs(volumeA[15] - 0.6f) > 0.0001f || kexMath::Fabs(volumeA[35] - 0.2f) > 0.0001f) {
+        bOk = false;
+    }
+
+    // eased the same as the old lerp stepped at 60hz
+    lerped = 1;
+    for(int i = 0; i < 60; i++) {
+        lerped = (2 - lerped) * (3.0f / 60.0f) + lerped;
+    }
+
+    if(kexMath::Fabs(sfx.freqEnvelope.Evaluate(1200) - lerped) > 0.001f) {
+        bOk = false;
+    }
+
+    // a fade out ends the voice at the same time whatever the rate
+    sfx.bLerpFreq = false;
+    sfx.gainEnvelope.Set(1, 1, 0, 0, 0, 0, 6.0f / 60.0f);
+
+    countA = Envelope_Run(&sfx, 30, volumeA, pitchA, 40);
+    countB = Envelope_Run(&sfx, 240, volumeB, pitchB, 40);
+
+    if(countA == 40 || countA != countB) {
+        bOk = false;
+    }
+
+    common.CPrintf(LC_SOUND, bOk ? COLOR_GREEN : COLOR_RED, "testsoundenvelopes %s\n",
+        bOk ? "passed" : "failed");
+}
@@ -23,20 +23,47 @@
 #ifndef _SND_H_
 #define _SND_H_
 
-#if defined(_WIN32) && defined(_MSC_VER)
-#include "al.h"
-#include "alc.h"
-#else
-#include <OpenAL/al.h>
-#include <OpenAL/alc.h>
-#endif
-
 #include "gameObject.h"
 #include "script.h"
 #include "cachefilelist.h"
+#include "residency.h"
+#include "binFile.h"
+#include "filesystem.h"
 
 class kexWavFile;
 
+#define SND_ENVELOPE_EPSILON    0.01f
+
+//
+// kexSoundEnvelope - a gain or pitch curve over the life of a voice.
+// it's worked out from how long the voice has been playing, never
+// stepped, so it comes out the same however often it's updated. it
+// holds at start for the delay, attacks to peak and then decays to
+// end. with neither an attack nor a decay it eases from start to end,
+// covering rate of what's left every 60th of a second, the way the
+// old per frame interpolation did at 60hz. times are in ms
+//
+
+class kexSoundEnvelope {
+public:
+    void                                Set(const float start, const float peak, const float end,
+                                            const float delay, const float attack, const float decay,
+                                            const float rate);
+    float                               Evaluate(const float elapsed) const;
+    bool                                Finished(const float elapsed) const;
+
+    const float                         Start(void) const { return start; }
+
+private:
+    float                               start;
+    float                               peak;
+    float                               end;
+    float                               delay;
+    float                               attack;
+    float                               decay;
+    float                               rate;
+};
+
 typedef struct {
     kexWavFile      *wavFile;
     int             delay;
@@ -53,25 +80,109 @@ typedef struct {
     float           freqLerpEnd;
     int             freqLerpTime;
     int             freqLerpDelay;
+    int             gainAttack;
+    int             gainDecay;
+    float           gainPeak;
+    int             freqAttack;
+    int             freqDecay;
+    float           freqPeak;
     float           rolloffFactor;
+    kexSoundEnvelope gainEnvelope;
+    kexSoundEnvelope freqEnvelope;
 } sfx_t;
 
 #define SND_MAX_SOURCES 64
+#define SND_MAX_VOICES  256
+
+#define SND_METRICS 0.0035f
+#define SND_VECTOR2METRICS(vec) \
+    vec[0] * SND_METRICS,       \
+    vec[1] * SND_METRICS,       \
+    vec[2] * SND_METRICS
+
+#define SND_INT2TIME(t) ((float)t * ((1.0f / 60.0f) * 1000.0f))
 
 class kexSoundShader {
+    friend class kexVoiceScheduler;
 public:
                                         kexSoundShader(void);
                                         ~kexSoundShader(void);
 
     void                                Play(kexGameObject *obj);
     void                                Load(kexLexer *lexer);
+    void                                Touch(void);
+    bool                                CheckCooldown(const int time);
 
     filepath_t                          filePath;
     kexSoundShader                      *next;
+    int                                 priority;       // higher keeps its voice over lower
+    int                                 maxInstances;   // 0 for no limit
+    int                                 cooldown;       // ms before the shader can play again
 
 private:
     int                                 numsfx;
     sfx_t                               *sfxList;
+    int                                 nextPlayTime;
+    int                                 numVoices;
+};
+
+//
+// sndVoice_t - a started sound. every sound gets one whether it can be
+// heard or not. only the best ranked voices are handed a real source,
+// the rest keep time silently and pick up where they would have been
+// if they rank back in before they run out
+//
+typedef struct {
+    kexSoundShader                      *shader;
+    sfx_t                               *sfx;
+    kexGameObject                       *obj;
+    kexVec3                             origin;
+    bool                                bActive;
+    bool                                bLocal;         // played at the listener, never attenuated
+    bool                                bWantSource;    // ranked into the top voices by the last update
+    int                                 source;         // index of the bound source, -1 while virtual
+    int                                 priority;
+    int                                 startTime;      // sound time the voice starts at, after its delay
+    int                                 endTime;        // when the voice runs out, 0 if unknown
+    float                               volume;
+    float                               pitch;
+    float                               audibility;
+    unsigned int                        serial;
+} sndVoice_t;
+
+//
+// kexVoiceScheduler - decides which voices get to be heard. knows
+// nothing about the sources themselves, the sound system binds and
+// unbinds those to match what the last update asked for
+//
+
+class kexVoiceScheduler {
+public:
+                                        kexVoiceScheduler(void);
+
+    sndVoice_t                          *Start(kexSoundShader *shader, sfx_t *sfx, kexGameObject *obj,
+                                               const bool bLocal, const int time, const int duration);
+    void                                Stop(sndVoice_t *voice);
+    void                                StopAll(void);
+    void                                Update(const kexVec3 &listener, const int time,
+                                               const int numSources);
+    bool                                HasVoice(const kexGameObject *obj) const;
+    int                                 NumVirtual(void) const;
+
+    sndVoice_t                          *GetVoices(void) { return voices; }
+    const int                           NumActive(void) const { return numActive; }
+
+private:
+    static int                          SortVoices(const void *a, const void *b);
+
+    sndVoice_t                          *AllocVoice(const int priority);
+    void                                UpdateEnvelopes(sndVoice_t *voice, const int time);
+    float                               Audibility(sndVoice_t *voice, const kexVec3 &listener);
+
+    sndVoice_t                          voices[SND_MAX_VOICES];
+    sndVoice_t                          *ranked[SND_MAX_VOICES];
+    int                                 numActive;
+    unsigned int                        serial;
 };
 
 class kexWavFile {
@@ -79,11 +190,27 @@ public:
                                         kexWavFile(void);
                                         ~kexWavFile(void);
 
-    int                                 GetFormat(void);
     bool                                CompareTag(const char *tag, int offset);
-    void                                Allocate(const char *name, byte *data);
+    bool                                Parse(const char *name, byte *buffer, const int size,
+                                              const int fileSize = 0);
+    void                                Allocate(const char *name, byte *data, const int size);
+    void                                AllocateStreamed(const char *name);
     void                                Delete(void);
-    ALuint                              *GetBuffer(void) { return &buffer; }
+    void                                Free(void);
+    void                                Touch(void);
+    const bool                          IsResident(void) const { return bStreamed || resident.bResident; }
+    const bool                          IsStreamed(void) const { return bStreamed; }
+    const int                           Duration(void) const;
+    unsigned int                        *GetBuffer(void) { return &buffer; }
+
+    const short                         Channels(void) const { return channels; }
+    const short                         Bits(void) const { return bits; }
+    const short                         BlockAlign(void) const { return blockAlign; }
+    const int                           Rate(void) const { return samples; }
+    const int                           Size(void) const { return waveSize; }
+    const int                           NumFrames(void) const { return waveSize / blockAlign; }
+    const int                           DataOffset(void) const { return dataOffset; }
+    const byte                          *Data(void) const { return data; }
 
     filepath_t                          filePath;
     kexWavFile                          *next;
@@ -96,38 +223,250 @@ private:
     short                               blockAlign;
     short                               bits;
     int                                 waveSize;
-    byte                                *data;
-    byte                                *waveFile;
-    ALuint                              buffer;
+    int                                 dataOffset;     // of the samples from the start of the file
+    byte                                *data;          // NULL when streamed
+    byte                                *waveFile;      // just the header when streamed
+    unsigned int                        buffer;         // owned by the backend, 0 if it doesn't keep one
+    bool                                bStreamed;
+    resident_t                          resident;
+};
+
+#define SND_MAX_STREAMS         8
+#define SND_STREAM_CHUNKS       4
+#define SND_STREAM_CHUNK_SIZE   32768
+#define SND_STREAM_HEADER_SIZE  65536   // how much of a streamed file is read looking for its chunks
+
+//
+// kexSoundStream - plays a long wave out of its file instead of memory.
+// the stream thread decodes the samples into a ring of chunks, and the
+// backend playing it takes filled chunks off the other end and hands
+// them back once it's done with them
+//
+
+class kexSoundStream {
+    friend class kexSoundStreamer;
+public:
+    const byte                          *Chunk(int *size);
+    void                                Release(void);
+    bool                                Finished(void);
+    void                                Close(void);
+
+    kexWavFile                          *Wave(void) { return wave; }
+
+private:
+    typedef struct {
+        byte                            *data;
+        int                             size;
+        SDL_atomic_t                    bFilled;
+    } streamChunk_t;
+
+    void                                Open(kexWavFile *wavFile, const int offset);
+    void                                Fill(void);
+
+    kexWavFile                          *wave;
+    fileStream_t                        file;
+    bool                                bOpened;        // file is opened by the first fill
+    SDL_mutex                           *lock;          // held by whoever is touching the file
+    streamChunk_t                       chunks[SND_STREAM_CHUNKS];
+    int                                 readChunk;      // only touched by the player
+    int                                 writeChunk;     // only touched under the lock
+    int                                 remaining;      // bytes of samples left to read
+    int                                 seekOffset;     // into the samples, -1 once it's been done
+    SDL_atomic_t                        bActive;
+    SDL_atomic_t                        bEOF;
+};
+
+class kexSoundStreamer {
+public:
+                                        kexSoundStreamer(void);
+
+    void                                Init(void);
+    void                                Shutdown(void);
+    kexSoundStream                      *Open(kexWavFile *wave, const int offset);
+    void                                Wake(void);
+
+private:
+    static int                          StreamThread(void *data);
+
+    void                                Run(void);
+
+    kexSoundStream                      streams[SND_MAX_STREAMS];
+    SDL_Thread                          *thread;
+    SDL_sem                             *wake;
+    SDL_atomic_t                        bQuit;
+};
+
+//
+// sndParams_t - what a source asks its channel to sound like
+//
+typedef struct {
+    kexWavFile                          *wave;
+    kexSoundStream                      *stream;    // set if the wave is streamed
+    kexVec3                             origin;
+    bool                                bLocal;
+    float                               gain;       // master volume included
+    float                               pitch;
+    float                               rolloffFactor;
+} sndParams_t;
+
+// smallest changes worth telling a backend about
+#define SND_GAIN_EPSILON    0.002f
+#define SND_PITCH_EPSILON   0.002f
+#define SND_ORIGIN_EPSILON  1.0f
+
+//
+// kexSoundBackend - plays the sources. channel n belongs to the sound
+// system's source n for as long as the backend is up
+//
+
+class kexSoundBackend {
+public:
+    virtual                             ~kexSoundBackend(void) {}
+
+    virtual bool                        Init(void) = 0;
+    virtual void                        Shutdown(void) = 0;
+    virtual const char                  *GetDeviceName(void) = 0;
+    virtual int                         NumChannels(void) = 0;
+    virtual void                        UploadWave(kexWavFile *wave) = 0;
+    virtual void                        DeleteWave(kexWavFile *wave) = 0;
+    virtual void                        SetListener(const kexVec3 &origin, const kexVec3 &forward,
+                                                    const kexVec3 &up) = 0;
+    virtual bool                        StartChannel(const int channel, const sndParams_t &params,
+                                                     const float offset) = 0;
+    virtual void                        StopChannel(const int channel) = 0;
+    // returns false once the channel has played out
+    virtual bool                        UpdateChannel(const int channel, const sndParams_t &params) = 0;
+    // called once the channels are up to date for the frame
+    virtual void                        Update(const int time) = 0;
+};
+
+//
+// kexSoundSink - where the software mixer sends its output. samples
+// are interleaved 16 bit stereo
+//
+
+class kexSoundSink {
+public:
+    virtual                             ~kexSoundSink(void) {}
+
+    virtual bool                        Open(const int rate) = 0;
+    virtual void                        Write(const short *samples, const int frames) = 0;
+    virtual void                        Close(void) = 0;
+    virtual const char                  *GetName(void) = 0;
+};
+
+class kexNullSoundSink : public kexSoundSink {
+public:
+    bool                                Open(const int rate) { return true; }
+    void                                Write(const short *samples, const int frames) {}
+    void                                Close(void) {}
+    const char                          *GetName(void) { return "null"; }
+};
+
+class kexWavSoundSink : public kexSoundSink {
+public:
+                                        kexWavSoundSink(void);
+
+    bool                                Open(const int rate);
+    void                                Write(const short *samples, const int frames);
+    void                                Close(void);
+    const char                          *GetName(void) { return filePath; }
+
+    void                                SetFile(const char *name);
+
+private:
+    filepath_t                          filePath;
+    kexBinFile                          file;
+    int                                 numFrames;
+};
+
+#define SND_MIX_FRAMES  512
+
+//
+// kexSoundMixer - mixes the channels itself and hands the result to a
+// sink, so sound works without a device. wave data is read straight
+// out of the wave files, nothing is uploaded
+//
+
+class kexSoundMixer : public kexSoundBackend {
+public:
+                                        kexSoundMixer(void);
+
+    bool                                Init(void);
+    void                                Shutdown(void);
+    const char                          *GetDeviceName(void);
+    int                                 NumChannels(void) { return SND_MAX_SOURCES; }
+    void                                UploadWave(kexWavFile *wave) {}
+    void                                DeleteWave(kexWavFile *wave) {}
+    void                                SetListener(const kexVec3 &origin, const kexVec3 &forward,
+                                                    const kexVec3 &up);
+    bool                                StartChannel(const int channel, const sndParams_t &params,
+                                                     const float offset);
+    void                                StopChannel(const int channel);
+    bool                                UpdateChannel(const int channel, const sndParams_t &params);
+    void                                Update(const int time);
+
+    void                                SetOutput(kexSoundSink *outSink, const int outRate);
+    void                                Mix(const int frames);
+
+    const int                           Rate(void) const { return rate; }
+
+private:
+    typedef struct {
+        const kexWavFile                *wave;
+        kexSoundStream                  *stream;
+        const byte                      *window;    // the whole wave, or the stream chunk being played
+        unsigned int                    windowFrames;
+        bool                            bActive;
+        unsigned int                    pos;        // whole frames into the window
+        unsigned int                    frac;       // 16.16 fraction of a frame
+        unsigned int                    step;       // 16.16 frames per output frame
+        float                           left;
+        float                           right;
+    } mixChannel_t;
+
+    void                                Spatialize(mixChannel_t *chan, const sndParams_t &params);
+    bool                                NextWindow(mixChannel_t *chan);
+    int                                 MixWindow(mixChannel_t *chan, int *out, const int frames);
+    void                                MixChannel(mixChannel_t *chan, const int frames);
+
+    kexSoundSink                        *sink;
+    int                                 rate;
+    mixChannel_t                        channels[SND_MAX_SOURCES];
+    int                                 mixBuffer[SND_MIX_FRAMES*2];
+    short                               outBuffer[SND_MIX_FRAMES*2];
+    kexVec3                             listenOrigin;
+    kexVec3                             listenRight;
+    int                                 baseTime;
+    int                                 numMixed;
+    bool                                bStarted;
 };
 
 class kexSoundSource {
-    friend class kexSoundSystem;
 public:
                                         kexSoundSource(void);
                                         ~kexSoundSource(void);
 
-    bool                                Generate(void);
-    void                                Set(sfx_t *sfxRef, kexGameObject *refObj);
-    void                                Play(void);
+    void                                SetChannel(const int index);
+    void                                Bind(sndVoice_t *sndVoice);
+    bool                                Play(void);
     void                                Stop(void);
-    void                                Reset(void);
     void                                Free(void);
-    void                                Delete(void);
-    void                                Update(void);
+    bool                                Update(void);
 
     bool                                InUse(void) const { return bInUse; }
+    sndVoice_t                          *GetVoice(void) { return voice; }
+    const unsigned int                  Serial(void) const { return serial; }
 
 private:
-    ALuint                              handle;
-    int                                 startTime;
+    void                                GetParams(sndParams_t *params);
+
+    int                                 channel;
     bool                                bInUse;
     bool                                bPlaying;
-    bool                                bLooping;
-    float                               volume;
-    float                               pitch;
-    sfx_t                               *sfx;
-    kexGameObject                       *obj;
+    sndVoice_t                          *voice;
+    kexSoundStream                      *stream;
+    unsigned int                        serial;     // of the voice when it was bound
 };
 
 class kexSoundSystem {
@@ -137,25 +476,38 @@ public:
 
     void                                Init(void);
     void                                Shutdown(void);
-    char                                *GetDeviceName(void);
+    const char                          *GetDeviceName(void);
     void                                UpdateListener(void);
+    void                                Update(const kexVec3 &origin, const kexVec3 &forward,
+                                               const kexVec3 &up);
     void                                StopAll(void);
     kexWavFile                          *CacheWavFile(const char *name);
     kexSoundShader                      *CacheShaderFile(const char *name);
     kexSoundSource                      *GetAvailableSource(void);
     bool                                HasSource(const kexGameObject *obj);
     void                                StartSound(const char *name, kexGameObject *obj);
+    void                                StartVoice(kexSoundShader *shader, sfx_t *sfx, kexGameObject *obj);
+    kexSoundBackend                     *SetBackend(kexSoundBackend *newBackend);
 
     const int                           GetNumActiveSources(void) const { return activeSources; }
     kexSoundSource                      *GetSources(void) { return sources; }
+    kexVoiceScheduler                   &Voices(void) { return voices; }
+    kexSoundBackend                     *Backend(void) { return backend; }
+    kexSoundStreamer                    &Streamer(void) { return streamer; }
+
+    static float                        Attenuation(const float dist, const float rolloff);
+    static bool                         ShouldStream(const int size);
 
     static int                          time;
     static kexHeapBlock                 hb_sound;
 
 private:
-    ALCdevice                           *alDevice;
-    ALCcontext                          *alContext;
+    void                                UpdateSources(void);
+
+    kexSoundBackend                     *backend;
     kexSoundSource                      sources[SND_MAX_SOURCES];
+    kexVoiceScheduler                   voices;
+    kexSoundStreamer                    streamer;
     kexHashList<kexWavFile>             wavList;
     kexHashList<kexSoundShader>         shaderList;
     int                                 activeSources;
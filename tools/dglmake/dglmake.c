@@ -414,6 +414,275 @@ char* ReturnGLType(glinfo_t* info)
     return NULL;
 }
 
+//
+// mockhook_t
+//
+// Anything a mock entry point does besides logging the call. The
+// code is pasted in after the call is recorded, using the argument
+// names from the headers
+//
+
+typedef struct
+{
+    char* name;
+    char* code;
+} mockhook_t;
+
+static mockhook_t mockhooks[] =
+{
+    { "glGenTextures",              "glMock.GenNames(n, textures)" },
+    { "glGenBuffersARB",            "glMock.GenNames(n, buffers)" },
+    { "glGenFramebuffers",          "glMock.GenNames(n, framebuffers)" },
+    { "glGenRenderbuffers",         "glMock.GenNames(n, renderbuffers)" },
+    { "glGenQueriesARB",            "glMock.GenNames(n, ids)" },
+    { "glGenLists",                 "return glMock.NewName(range)" },
+    { "glDeleteTextures",           "glMock.DeleteNames(n, textures)" },
+    { "glDeleteBuffersARB",         "glMock.DeleteNames(n, buffers)" },
+    { "glDeleteFramebuffers",       "glMock.DeleteNames(n, framebuffers)" },
+    { "glDeleteRenderbuffers",      "glMock.DeleteNames(n, renderbuffers)" },
+    { "glCreateProgramObjectARB",   "return (GLhandleARB)(size_t)glMock.NewName(1)" },
+    { "glCreateShaderObjectARB",    "return (GLhandleARB)(size_t)glMock.NewName(1)" },
+    { "glGetUniformLocationARB",    "return (GLint)glMock.NewName(1)" },
+    { "glBindTexture",              "glMock.Bind(target, texture)" },
+    { "glBindBufferARB",            "glMock.Bind(target, buffer)" },
+    { "glBindFramebuffer",          "glMock.Bind(target, framebuffer)" },
+    { "glBindRenderbuffer",         "glMock.Bind(target, renderbuffer)" },
+    { "glUseProgramObjectARB",      "glMock.Bind(GL_PROGRAM_OBJECT_ARB, (GLuint)(size_t)programObj)" },
+    { "glActiveTextureARB",         "glMock.ActiveTexture(texture)" },
+    { "glEnable",                   "glMock.SetCap(cap, true)" },
+    { "glDisable",                  "glMock.SetCap(cap, false)" },
+    { "glIsEnabled",                "return glMock.IsEnabled(cap)" },
+    { "glViewport",                 "glMock.Viewport(x, y, width, height)" },
+    { "glGetIntegerv",              "glMock.GetIntegerv(pname, params)" },
+    { "glGetFloatv",                "glMock.GetFloatv(pname, params)" },
+    { "glGetObjectParameterivARB",  "glMock.GetObjectParameteriv(pname, params)" },
+    { "glGetQueryObjectivARB",      "*params = 1" },
+    { "glGetQueryObjectuivARB",     "*params = 1" },
+    { "glGetInfoLogARB",            "glMock.GetName(maxLength, length, infoLog)" },
+    { "glGetActiveUniformARB",      "glMock.GetName(maxLength, length, name)" },
+    { "glCheckFramebufferStatus",   "return GL_FRAMEBUFFER_COMPLETE" },
+    { NULL,                         NULL }
+};
+
+static FILE* mockheader;
+static FILE* mocksource;
+static char mocknames[1024][64];
+static int mockcount = 0;
+static char mockextensions[1024];
+
+//
+// GetMockHook
+//
+
+static char* GetMockHook(char* name)
+{
+    int i;
+
+    for(i = 0; mockhooks[i].name; i++)
+    {
+        if(!strcmp(mockhooks[i].name, name))
+            return mockhooks[i].code;
+    }
+
+    return NULL;
+}
+
+//
+// SlapGLArgsToFile
+//
+
+static void SlapGLArgsToFile(FILE* f, gldata_t* data)
+{
+    int a = 0;
+
+    fprintf(f, "(");
+
+    if(data->args[a].name[0] == 0)
+        fprintf(f, "void");
+
+    while(data->args[a].name[0] != 0)
+    {
+        if(a > 0)
+            fprintf(f, ", ");
+
+        if(data->args[a].isconst)
+            fprintf(f, "const ");
+
+        fprintf(f, "%s", ReturnGLType(&data->args[a]));
+        if(data->args[a].pointer)
+            fprintf(f, "*");
+
+        fprintf(f, " %s", data->args[a++].name);
+    }
+
+    fprintf(f, ")");
+}
+
+//
+// SlapGLMockToFile
+//
+// Writes an entry point for the recording mock for each function.
+// Core functions are swapped in by redefining their dgl macros,
+// extensions are handed out by GL_RegisterProc instead
+//
+
+void SlapGLMockToFile(int count, dboolean extension)
+{
+    int i;
+
+    for(i = 0; i < count; i++)
+    {
+        int a = 0;
+        char* hook;
+
+        if(!extension)
+        {
+            fprintf(mockheader, "#undef d%s\n", gldata[i].name);
+            fprintf(mockheader, "#define d%s(", gldata[i].name);
+
+            while(gldata[i].args[a].name[0] != 0)
+            {
+                fprintf(mockheader, "%s", gldata[i].args[a++].name);
+                if(gldata[i].args[a].name[0] != 0)
+                    fprintf(mockheader, ", ");
+            }
+
+            fprintf(mockheader, ") m%s(", gldata[i].name);
+
+            a = 0;
+            while(gldata[i].args[a].name[0] != 0)
+            {
+                fprintf(mockheader, "%s", gldata[i].args[a++].name);
+                if(gldata[i].args[a].name[0] != 0)
+                    fprintf(mockheader, ", ");
+            }
+
+            fprintf(mockheader, ")\n");
+
+            fprintf(mockheader, "%s", ReturnGLType(&gldata[i].header));
+            if(gldata[i].header.pointer)
+                fprintf(mockheader, "*");
+
+            fprintf(mockheader, " APIENTRY m%s ", gldata[i].name);
+            SlapGLArgsToFile(mockheader, &gldata[i]);
+            fprintf(mockheader, ";\n");
+        }
+
+        if(extension)
+            fprintf(mocksource, "static ");
+
+        fprintf(mocksource, "%s", ReturnGLType(&gldata[i].header));
+        if(gldata[i].header.pointer)
+            fprintf(mocksource, "*");
+
+        fprintf(mocksource, " APIENTRY m%s ", gldata[i].name);
+        SlapGLArgsToFile(mocksource, &gldata[i]);
+        fprintf(mocksource, "\n{\n");
+        fprintf(mocksource, "    glMockCall_t* call = glMock.Record(%i);\n", mockcount);
+
+        if(gldata[i].args[0].name[0] != 0)
+            fprintf(mocksource, "\n");
+
+        a = 0;
+        while(gldata[i].args[a].name[0] != 0)
+        {
+            glinfo_t* arg = &gldata[i].args[a++];
+
+            if(arg->pointer)
+                fprintf(mocksource, "    glMock.ArgPtr(call, %s);\n", arg->name);
+            else if(arg->type >= 11 && arg->type <= 14)
+                fprintf(mocksource, "    glMock.ArgFloat(call, (double)%s);\n", arg->name);
+            else if(arg->type == 20)
+                fprintf(mocksource, "    glMock.ArgInt(call, (int64_t)(size_t)%s);\n", arg->name);
+            else
+                fprintf(mocksource, "    glMock.ArgInt(call, (int64_t)%s);\n", arg->name);
+        }
+
+        hook = GetMockHook(gldata[i].name);
+
+        if(hook)
+            fprintf(mocksource, "    %s;\n", hook);
+
+        if(!hook || strncmp(hook, "return", 6))
+        {
+            if(gldata[i].header.pointer)
+                fprintf(mocksource, "    return NULL;\n");
+            else if(gldata[i].header.type != 0)
+                fprintf(mocksource, "    return (%s)0;\n", ReturnGLType(&gldata[i].header));
+        }
+
+        fprintf(mocksource, "}\n\n");
+
+        strcpy(mocknames[mockcount++], gldata[i].name);
+    }
+}
+
+//
+// OpenMockFiles
+//
+
+static void OpenMockFiles(void)
+{
+    mockheader = fopen("dglmock.h", "w");
+    mocksource = fopen("dglmock.cpp", "w");
+
+    fprintf(mockheader, "//\n// Generated by dglmake\n//\n");
+    fprintf(mockheader, "#ifndef __DGLMOCK_H__\n");
+    fprintf(mockheader, "#define __DGLMOCK_H__\n\n");
+    fprintf(mockheader, "void* dglMockProc(const char* name);\n\n");
+    fprintf(mockheader, "#undef dglGetString\n");
+    fprintf(mockheader, "#define dglGetString(name) mglGetString(name)\n");
+    fprintf(mockheader, "const GLubyte* APIENTRY mglGetString (GLenum name);\n\n");
+
+    fprintf(mocksource, "//\n// Generated by dglmake\n//\n");
+    fprintf(mocksource, "#include \"common.h\"\n");
+    fprintf(mocksource, "#include \"glMock.h\"\n\n");
+    fprintf(mocksource, "#ifdef USE_MOCK_GLFUNCS\n\n");
+    fprintf(mocksource, "const GLubyte* APIENTRY mglGetString (GLenum name)\n{\n");
+    fprintf(mocksource, "    return glMock.GetString(name);\n}\n\n");
+
+    mockextensions[0] = 0;
+}
+
+//
+// CloseMockFiles
+//
+
+static void CloseMockFiles(void)
+{
+    int i;
+
+    fprintf(mocksource, "const int dglMockNumFuncs = %i;\n\n", mockcount);
+    fprintf(mocksource, "const char* dglMockNames[%i] =\n{\n", mockcount);
+
+    for(i = 0; i < mockcount; i++)
+        fprintf(mocksource, "    \"%s\",\n", mocknames[i]);
+
+    fprintf(mocksource, "};\n\n");
+
+    fprintf(mocksource, "static void* dglMockProcs[%i] =\n{\n", mockcount);
+
+    for(i = 0; i < mockcount; i++)
+        fprintf(mocksource, "    (void*)m%s,\n", mocknames[i]);
+
+    fprintf(mocksource, "};\n\n");
+
+    fprintf(mocksource, "const char* dglMockExtensions = \"%s\";\n\n", mockextensions);
+
+    fprintf(mocksource, "void* dglMockProc(const char* name)\n{\n");
+    fprintf(mocksource, "    int i;\n\n");
+    fprintf(mocksource, "    for(i = 0; i < dglMockNumFuncs; i++)\n    {\n");
+    fprintf(mocksource, "        if(!strcmp(dglMockNames[i], name))\n");
+    fprintf(mocksource, "            return dglMockProcs[i];\n    }\n\n");
+    fprintf(mocksource, "    return NULL;\n}\n\n");
+    fprintf(mocksource, "#endif // USE_MOCK_GLFUNCS\n");
+
+    fprintf(mockheader, "\n#endif // __DGLMOCK_H__\n");
+
+    fclose(mockheader);
+    fclose(mocksource);
+}
+
 //
 // SlapGLStuffToFile
 //
@@ -629,6 +898,11 @@ void SlapGLExtensionsToFile(FILE* f, char* arbstring)
 
     fprintf(f, "//\n// %s\n//\n", arbstring);
 
+    if(mockextensions[0] != 0)
+        strcat(mockextensions, " ");
+
+    strcat(mockextensions, arbstring);
+
     while(SC_ReadTokens())
     {
         SC_Find(false);
@@ -806,6 +1080,8 @@ void SlapGLExtensionsToFile(FILE* f, char* arbstring)
 
         SlapGLStuffToFile(f, i, true);
         fprintf(f, "\n#endif // USE_DEBUG_GLFUNCS\n\n");
+
+        SlapGLMockToFile(i, true);
     }
 
     SC_Close();
@@ -820,6 +1096,8 @@ int main(int argc, char** argv)
     FILE *f = fopen("dgl.h", "w");
     int i = 0;
 
+    OpenMockFiles();
+
     SC_Open("GL.H");
 
     while(SC_ReadTokens())
@@ -859,6 +1137,8 @@ int main(int argc, char** argv)
     SlapGLStuffToFile(f, i, false);
     fprintf(f, "\n#endif // USE_DEBUG_GLFUNCS\n\n");
 
+    SlapGLMockToFile(i, false);
+
     SC_Close();
 
     SlapGLExtensionsToFile(f, "GL_ARB_multitexture");
@@ -874,8 +1154,10 @@ int main(int argc, char** argv)
     SlapGLExtensionsToFile(f, "GL_ARB_framebuffer_object");
     SlapGLExtensionsToFile(f, "GL_ARB_occlusion_query");
     SlapGLExtensionsToFile(f, "GL_EXT_texture_array");
+    SlapGLExtensionsToFile(f, "GL_ARB_texture_compression");
 
     fclose(f);
+    CloseMockFiles();
 
     return 1;
 }